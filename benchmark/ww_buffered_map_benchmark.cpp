@@ -0,0 +1,85 @@
+#include <benchmark/benchmark.h>
+#include <cstdint>
+#include <ww_map.h>
+#include <ww_buffered_map.h>
+
+// 突发写入：range(0)个随机键的insert_or_assign
+
+static unsigned int next_seed(unsigned int seed)
+{
+    return seed * 1103515245 + 12345;
+}
+
+static void BM_ww_buffered_map_insert_or_assign(benchmark::State & state)
+{
+    const int n = static_cast<int>(state.range(0));
+    for (auto _ : state) {
+        wwstl::buffered_map<int, int> map;
+        unsigned int seed = 1;
+        for (int i = 0; i < n; ++i) {
+            seed = next_seed(seed);
+            map.insert_or_assign(static_cast<int>(seed >> 4), i);
+        }
+        map.flush();
+        benchmark::DoNotOptimize(map._levels.data());
+    }
+    state.SetItemsProcessed(state.iterations() * n);
+}
+BENCHMARK(BM_ww_buffered_map_insert_or_assign)->Arg(1 << 16)->Arg(1 << 20)->Unit(benchmark::kMillisecond);
+
+static void BM_ww_map_insert_or_assign_burst(benchmark::State & state)
+{
+    const int n = static_cast<int>(state.range(0));
+    for (auto _ : state) {
+        wwstl::map<int, int> map;
+        unsigned int seed = 1;
+        for (int i = 0; i < n; ++i) {
+            seed = next_seed(seed);
+            map.insert_or_assign(static_cast<int>(seed >> 4), i);
+        }
+        benchmark::DoNotOptimize(map.size());
+    }
+    state.SetItemsProcessed(state.iterations() * n);
+}
+BENCHMARK(BM_ww_map_insert_or_assign_burst)->Arg(1 << 16)->Arg(1 << 20)->Unit(benchmark::kMillisecond);
+
+// 写后读：在range(0)个元素的表上交替写入一个随机键并查找一个随机键
+
+static void BM_ww_buffered_map_read_after_write(benchmark::State & state)
+{
+    const int n = static_cast<int>(state.range(0));
+    wwstl::buffered_map<int, int> map;
+    unsigned int seed = 1;
+    for (int i = 0; i < n; ++i) {
+        seed = next_seed(seed);
+        map.insert_or_assign(static_cast<int>((seed >> 4) % (n * 2)), i);
+    }
+    int value = 0;
+    for (auto _ : state) {
+        seed = next_seed(seed);
+        map.insert_or_assign(static_cast<int>((seed >> 4) % (n * 2)), 0);
+        seed = next_seed(seed);
+        benchmark::DoNotOptimize(map.find(static_cast<int>((seed >> 4) % (n * 2)), value));
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_ww_buffered_map_read_after_write)->Arg(1 << 20);
+
+static void BM_ww_map_read_after_write(benchmark::State & state)
+{
+    const int n = static_cast<int>(state.range(0));
+    wwstl::map<int, int> map;
+    unsigned int seed = 1;
+    for (int i = 0; i < n; ++i) {
+        seed = next_seed(seed);
+        map.insert_or_assign(static_cast<int>((seed >> 4) % (n * 2)), i);
+    }
+    for (auto _ : state) {
+        seed = next_seed(seed);
+        map.insert_or_assign(static_cast<int>((seed >> 4) % (n * 2)), 0);
+        seed = next_seed(seed);
+        benchmark::DoNotOptimize(map.find(static_cast<int>((seed >> 4) % (n * 2))));
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_ww_map_read_after_write)->Arg(1 << 20);
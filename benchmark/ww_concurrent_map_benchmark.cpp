@@ -0,0 +1,84 @@
+#include <benchmark/benchmark.h>
+#include <mutex>
+#include <ww_map.h>
+#include <ww_concurrent_map.h>
+
+// 混合读写：range(0)为元素数，range(1)为写操作的百分比，写操作一半插入一半擦除
+
+static unsigned int next_seed(unsigned int seed)
+{
+    return seed * 1103515245 + 12345;
+}
+
+static wwstl::concurrent_map<int, int> * g_concurrent_map = nullptr;
+
+static void BM_ww_concurrent_map_mixed(benchmark::State & state)
+{
+    const int n = static_cast<int>(state.range(0));
+    const unsigned int write_percent = static_cast<unsigned int>(state.range(1));
+    if (state.thread_index() == 0) {
+        g_concurrent_map = new wwstl::concurrent_map<int, int>();
+        for (int i = 0; i < n; i += 2) {
+            g_concurrent_map->emplace(i, i);
+        }
+    }
+    unsigned int seed = static_cast<unsigned int>(state.thread_index()) + 1;
+    for (auto _ : state) {
+        seed = next_seed(seed);
+        int key = static_cast<int>((seed >> 8) % n);
+        unsigned int op = (seed >> 24) % 100;
+        if (op >= write_percent) {
+            int value;
+            benchmark::DoNotOptimize(g_concurrent_map->find(key, value));
+        } else if (op & 1) {
+            g_concurrent_map->emplace(key, key);
+        } else {
+            g_concurrent_map->erase(key);
+        }
+    }
+    state.SetItemsProcessed(state.iterations());
+    if (state.thread_index() == 0) {
+        delete g_concurrent_map;
+        g_concurrent_map = nullptr;
+    }
+}
+BENCHMARK(BM_ww_concurrent_map_mixed)->Args({1 << 16, 10})->ThreadRange(1, 8)->UseRealTime();
+BENCHMARK(BM_ww_concurrent_map_mixed)->Args({1 << 16, 50})->ThreadRange(1, 8)->UseRealTime();
+
+// 对照：一把互斥锁保护的wwstl::map
+
+static wwstl::map<int, int> * g_locked_map = nullptr;
+static std::mutex g_locked_map_mutex;
+
+static void BM_ww_map_mutex_mixed(benchmark::State & state)
+{
+    const int n = static_cast<int>(state.range(0));
+    const unsigned int write_percent = static_cast<unsigned int>(state.range(1));
+    if (state.thread_index() == 0) {
+        g_locked_map = new wwstl::map<int, int>();
+        for (int i = 0; i < n; i += 2) {
+            g_locked_map->emplace(i, i);
+        }
+    }
+    unsigned int seed = static_cast<unsigned int>(state.thread_index()) + 1;
+    for (auto _ : state) {
+        seed = next_seed(seed);
+        int key = static_cast<int>((seed >> 8) % n);
+        unsigned int op = (seed >> 24) % 100;
+        std::lock_guard<std::mutex> lock(g_locked_map_mutex);
+        if (op >= write_percent) {
+            benchmark::DoNotOptimize(g_locked_map->find(key));
+        } else if (op & 1) {
+            g_locked_map->emplace(key, key);
+        } else {
+            g_locked_map->erase(key);
+        }
+    }
+    state.SetItemsProcessed(state.iterations());
+    if (state.thread_index() == 0) {
+        delete g_locked_map;
+        g_locked_map = nullptr;
+    }
+}
+BENCHMARK(BM_ww_map_mutex_mixed)->Args({1 << 16, 10})->ThreadRange(1, 8)->UseRealTime();
+BENCHMARK(BM_ww_map_mutex_mixed)->Args({1 << 16, 50})->ThreadRange(1, 8)->UseRealTime();
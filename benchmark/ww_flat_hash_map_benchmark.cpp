@@ -0,0 +1,142 @@
+#include <benchmark/benchmark.h>
+#include <cstdint>
+#include <random>
+#include <unordered_map>
+#include <vector>
+#include <ww_flat_hash_map.h>
+#include <ww_unordered_map.h>
+
+// 开放寻址与链式哈希表对照：range(0)为元素数，键为[0, 2n)中的随机偶数，奇数用于未命中的查找
+// 10 ^ 8个元素时std::unordered_map超出测试机内存，规模取到10 ^ 7
+
+using flat_map = wwstl::flat_hash_map<std::uint64_t, std::uint64_t>;
+using node_map = wwstl::node_hash_map<std::uint64_t, std::uint64_t>;
+using chain_map = wwstl::unordered_map<std::uint64_t, std::uint64_t>;
+using std_map = std::unordered_map<std::uint64_t, std::uint64_t>;
+
+static std::vector<std::uint64_t> even_keys(std::size_t n)
+{
+    std::vector<std::uint64_t> keys(n);
+    std::mt19937_64 gen(42);
+    for (auto & key : keys) {
+        key = (gen() % n) * 2;
+    }
+    return keys;
+}
+
+template <class Map>
+static void fill(Map & map, const std::vector<std::uint64_t> & keys)
+{
+    for (std::size_t i = 0; i < keys.size(); ++i) {
+        map.emplace(keys[i], i);
+    }
+}
+
+template <class Map>
+static void BM_hash_map_insert(benchmark::State & state)
+{
+    const auto keys = even_keys(static_cast<std::size_t>(state.range(0)));
+    for (auto _ : state) {
+        Map map;
+        fill(map, keys);
+        benchmark::DoNotOptimize(map.size());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+/**
+ * @brief 查找的键为随机顺序，表大于末级缓存时每次查找都会缺失
+ */
+template <class Map>
+static void find_keys(benchmark::State & state, std::uint64_t offset)
+{
+    const auto keys = even_keys(static_cast<std::size_t>(state.range(0)));
+    Map map;
+    fill(map, keys);
+    std::vector<std::uint64_t> probes(1 << 16);
+    std::mt19937_64 gen(7);
+    for (auto & probe : probes) {
+        probe = keys[gen() % keys.size()] + offset;
+    }
+    std::size_t i = 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(map.find(probes[i]));
+        i = (i + 1) & (probes.size() - 1);
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+template <class Map>
+static void BM_hash_map_find_hit(benchmark::State & state)
+{
+    find_keys<Map>(state, 0);
+}
+
+template <class Map>
+static void BM_hash_map_find_miss(benchmark::State & state)
+{
+    find_keys<Map>(state, 1);
+}
+
+/**
+ * @brief 擦除一个键再插入另一个，元素数不变，开放寻址表中墓碑与空槽交替出现
+ */
+template <class Map>
+static void BM_hash_map_erase_insert(benchmark::State & state)
+{
+    const auto keys = even_keys(static_cast<std::size_t>(state.range(0)));
+    Map map;
+    fill(map, keys);
+    std::size_t i = 0;
+    for (auto _ : state) {
+        map.erase(keys[i]);
+        map.emplace(keys[i], i);
+        i = i + 1 == keys.size() ? 0 : i + 1;
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+template <class Map>
+static void BM_hash_map_iterate(benchmark::State & state)
+{
+    Map map;
+    fill(map, even_keys(static_cast<std::size_t>(state.range(0))));
+    for (auto _ : state) {
+        std::uint64_t sum = 0;
+        for (auto it = map.begin(); it != map.end(); ++it) {
+            sum += it->second;
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(map.size()));
+}
+
+static void sizes(benchmark::internal::Benchmark * b)
+{
+    b->RangeMultiplier(10)->Range(1000, 10000000);
+}
+
+BENCHMARK_TEMPLATE(BM_hash_map_insert, flat_map)->Apply(sizes);
+BENCHMARK_TEMPLATE(BM_hash_map_insert, node_map)->Apply(sizes);
+BENCHMARK_TEMPLATE(BM_hash_map_insert, chain_map)->Apply(sizes);
+BENCHMARK_TEMPLATE(BM_hash_map_insert, std_map)->Apply(sizes);
+
+BENCHMARK_TEMPLATE(BM_hash_map_find_hit, flat_map)->Apply(sizes);
+BENCHMARK_TEMPLATE(BM_hash_map_find_hit, node_map)->Apply(sizes);
+BENCHMARK_TEMPLATE(BM_hash_map_find_hit, chain_map)->Apply(sizes);
+BENCHMARK_TEMPLATE(BM_hash_map_find_hit, std_map)->Apply(sizes);
+
+BENCHMARK_TEMPLATE(BM_hash_map_find_miss, flat_map)->Apply(sizes);
+BENCHMARK_TEMPLATE(BM_hash_map_find_miss, node_map)->Apply(sizes);
+BENCHMARK_TEMPLATE(BM_hash_map_find_miss, chain_map)->Apply(sizes);
+BENCHMARK_TEMPLATE(BM_hash_map_find_miss, std_map)->Apply(sizes);
+
+BENCHMARK_TEMPLATE(BM_hash_map_erase_insert, flat_map)->Apply(sizes);
+BENCHMARK_TEMPLATE(BM_hash_map_erase_insert, node_map)->Apply(sizes);
+BENCHMARK_TEMPLATE(BM_hash_map_erase_insert, chain_map)->Apply(sizes);
+BENCHMARK_TEMPLATE(BM_hash_map_erase_insert, std_map)->Apply(sizes);
+
+BENCHMARK_TEMPLATE(BM_hash_map_iterate, flat_map)->Apply(sizes);
+BENCHMARK_TEMPLATE(BM_hash_map_iterate, node_map)->Apply(sizes);
+BENCHMARK_TEMPLATE(BM_hash_map_iterate, chain_map)->Apply(sizes);
+BENCHMARK_TEMPLATE(BM_hash_map_iterate, std_map)->Apply(sizes);
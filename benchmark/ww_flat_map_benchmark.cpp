@@ -0,0 +1,142 @@
+#include <benchmark/benchmark.h>
+#include <cstdint>
+#include <map>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include <ww_flat_map.h>
+#include <ww_map.h>
+#include <ww_unordered_map.h>
+
+// 随机键和随机查找序列
+
+static std::vector<int> make_random_keys(std::size_t n, unsigned int seed)
+{
+    std::vector<int> keys(n);
+    for (std::size_t i = 0; i < n; ++i) {
+        seed = seed * 1103515245 + 12345;
+        keys[i] = static_cast<int>(seed >> 1);
+    }
+    return keys;
+}
+
+template <class Container>
+static void lookup(benchmark::State & state)
+{
+    const std::size_t n = static_cast<std::size_t>(state.range(0));
+    std::vector<int> keys = make_random_keys(n, 1);
+    Container c;
+    for (std::size_t i = 0; i < n; ++i) {
+        c.insert(std::make_pair(keys[i], static_cast<int>(i)));
+    }
+    // 一半命中，一半不命中
+    std::vector<int> probes = make_random_keys(4096, 2);
+    for (std::size_t i = 0; i < probes.size(); i += 2) {
+        probes[i] = keys[static_cast<std::size_t>(probes[i]) % n];
+    }
+    std::size_t i = 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(c.find(probes[i]) == c.end());
+        i = (i + 1) & (probes.size() - 1);
+    }
+}
+
+// find
+
+static void BM_ww_flat_map_find(benchmark::State & state)
+{
+    lookup<wwstl::flat_map<int, int>>(state);
+}
+BENCHMARK(BM_ww_flat_map_find)->Arg(1 << 6)->Arg(1 << 12)->Arg(1 << 18);
+
+static void BM_ww_map_find_vs_flat(benchmark::State & state)
+{
+    lookup<wwstl::map<int, int>>(state);
+}
+BENCHMARK(BM_ww_map_find_vs_flat)->Arg(1 << 6)->Arg(1 << 12)->Arg(1 << 18);
+
+static void BM_ww_unordered_map_find_vs_flat(benchmark::State & state)
+{
+    lookup<wwstl::unordered_map<int, int>>(state);
+}
+BENCHMARK(BM_ww_unordered_map_find_vs_flat)->Arg(1 << 6)->Arg(1 << 12)->Arg(1 << 18);
+
+static void BM_std_map_find_vs_flat(benchmark::State & state)
+{
+    lookup<std::map<int, int>>(state);
+}
+BENCHMARK(BM_std_map_find_vs_flat)->Arg(1 << 6)->Arg(1 << 12)->Arg(1 << 18);
+
+static void BM_std_unordered_map_find_vs_flat(benchmark::State & state)
+{
+    lookup<std::unordered_map<int, int>>(state);
+}
+BENCHMARK(BM_std_unordered_map_find_vs_flat)->Arg(1 << 6)->Arg(1 << 12)->Arg(1 << 18);
+
+// iterator
+
+template <class Container>
+static void iterate(benchmark::State & state)
+{
+    const std::size_t n = static_cast<std::size_t>(state.range(0));
+    std::vector<int> keys = make_random_keys(n, 1);
+    Container c;
+    for (std::size_t i = 0; i < n; ++i) {
+        c.insert(std::make_pair(keys[i], static_cast<int>(i)));
+    }
+    for (auto _ : state) {
+        std::int64_t sum = 0;
+        for (auto it = c.begin(); it != c.end(); ++it) {
+            sum += it->second;
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+}
+
+static void BM_ww_flat_map_iterator(benchmark::State & state)
+{
+    iterate<wwstl::flat_map<int, int>>(state);
+}
+BENCHMARK(BM_ww_flat_map_iterator)->Arg(1 << 16);
+
+static void BM_ww_map_iterator_vs_flat(benchmark::State & state)
+{
+    iterate<wwstl::map<int, int>>(state);
+}
+BENCHMARK(BM_ww_map_iterator_vs_flat)->Arg(1 << 16);
+
+// 批量插入
+
+static void BM_ww_flat_map_insert_range(benchmark::State & state)
+{
+    const std::size_t n = static_cast<std::size_t>(state.range(0));
+    std::vector<int> keys = make_random_keys(n, 1);
+    std::vector<std::pair<int, int>> values;
+    for (std::size_t i = 0; i < n; ++i) {
+        values.push_back(std::make_pair(keys[i], static_cast<int>(i)));
+    }
+    for (auto _ : state) {
+        wwstl::flat_map<int, int> m;
+        m.insert(values.begin(), values.begin() + n / 2);
+        m.insert(values.begin() + n / 2, values.end());
+        benchmark::DoNotOptimize(m);
+    }
+}
+BENCHMARK(BM_ww_flat_map_insert_range)->Arg(1 << 16);
+
+static void BM_ww_map_insert_range_vs_flat(benchmark::State & state)
+{
+    const std::size_t n = static_cast<std::size_t>(state.range(0));
+    std::vector<int> keys = make_random_keys(n, 1);
+    std::vector<std::pair<int, int>> values;
+    for (std::size_t i = 0; i < n; ++i) {
+        values.push_back(std::make_pair(keys[i], static_cast<int>(i)));
+    }
+    for (auto _ : state) {
+        wwstl::map<int, int> m;
+        m.insert(values.begin(), values.begin() + n / 2);
+        m.insert(values.begin() + n / 2, values.end());
+        benchmark::DoNotOptimize(m);
+    }
+}
+BENCHMARK(BM_ww_map_insert_range_vs_flat)->Arg(1 << 16);
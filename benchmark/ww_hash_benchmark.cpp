@@ -0,0 +1,206 @@
+#include <benchmark/benchmark.h>
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+#include <ww_hash.h>
+
+// 哈希函数的吞吐量与碰撞率
+// 对照组：std::hash，以及逐字节h * 31 + c的字符串哈希和恒等映射的整数哈希
+
+struct multiply31_hash
+{
+    std::size_t operator()(const std::string & key) const
+    {
+        std::size_t hash = 0;
+        for (char c : key) {
+            hash = hash * 31 + static_cast<unsigned char>(c);
+        }
+        return hash;
+    }
+};
+
+struct identity_hash
+{
+    std::size_t operator()(std::uint64_t key) const
+    {
+        return static_cast<std::size_t>(key);
+    }
+};
+
+using ww_string_hash = wwstl::hash<std::string>;
+using std_string_hash = std::hash<std::string>;
+using ww_int_hash = wwstl::hash<std::uint64_t>;
+using std_int_hash = std::hash<std::uint64_t>;
+
+/**
+ * @brief range(0)字节的字符串，每次迭代对一组64个字符串求hash
+ */
+template <class Hasher>
+static void BM_hash_string_throughput(benchmark::State & state)
+{
+    const std::size_t size = static_cast<std::size_t>(state.range(0));
+    std::vector<std::string> keys(64);
+    for (std::size_t i = 0; i < keys.size(); ++i) {
+        keys[i].assign(size, static_cast<char>('a' + i % 26));
+    }
+    Hasher hasher;
+    for (auto _ : state) {
+        for (const auto & key : keys) {
+            benchmark::DoNotOptimize(hasher(key));
+        }
+    }
+    state.SetBytesProcessed(state.iterations() * static_cast<std::int64_t>(keys.size() * size));
+}
+
+template <class Hasher>
+static void BM_hash_int_throughput(benchmark::State & state)
+{
+    Hasher hasher;
+    std::uint64_t key = 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(hasher(key++));
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+static std::vector<std::string> url_keys(std::size_t n)
+{
+    std::vector<std::string> keys;
+    for (std::size_t i = 0; i < n; ++i) {
+        keys.push_back("https://example.com/api/v1/users/" + std::to_string(i) + "/profile");
+    }
+    return keys;
+}
+
+static std::vector<std::string> decimal_keys(std::size_t n)
+{
+    std::vector<std::string> keys;
+    for (std::size_t i = 0; i < n; ++i) {
+        keys.push_back(std::to_string(i));
+    }
+    return keys;
+}
+
+static std::vector<std::uint64_t> sequential_keys(std::size_t n)
+{
+    std::vector<std::uint64_t> keys(n);
+    for (std::size_t i = 0; i < n; ++i) {
+        keys[i] = i;
+    }
+    return keys;
+}
+
+/**
+ * @brief 按页对齐的地址，低12位全为0
+ */
+static std::vector<std::uint64_t> aligned_keys(std::size_t n)
+{
+    std::vector<std::uint64_t> keys(n);
+    for (std::size_t i = 0; i < n; ++i) {
+        keys[i] = i << 12;
+    }
+    return keys;
+}
+
+/**
+ * @brief 对一组键求hash并报告分布
+ * @details collisions为完整hash值相同的键数，max_bucket为按低位取到键数四分之一个桶时最大的桶，
+ *          理想的随机分布下max_bucket约为10
+ */
+template <class Hasher, class Key>
+static void hash_keys(benchmark::State & state, const std::vector<Key> & keys)
+{
+    Hasher hasher;
+    for (auto _ : state) {
+        for (const auto & key : keys) {
+            benchmark::DoNotOptimize(hasher(key));
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(keys.size()));
+
+    std::unordered_set<std::size_t> codes;
+    std::size_t bucket_count = 1;
+    while (bucket_count * 4 < keys.size()) {
+        bucket_count <<= 1;
+    }
+    std::vector<std::size_t> buckets(bucket_count);
+    for (const auto & key : keys) {
+        const std::size_t code = hasher(key);
+        codes.insert(code);
+        ++buckets[code & (bucket_count - 1)];
+    }
+    state.counters["collisions"] = static_cast<double>(keys.size() - codes.size());
+    state.counters["max_bucket"] = static_cast<double>(*std::max_element(buckets.begin(), buckets.end()));
+}
+
+template <class Hasher>
+static void BM_hash_url_keys(benchmark::State & state)
+{
+    hash_keys<Hasher>(state, url_keys(static_cast<std::size_t>(state.range(0))));
+}
+
+template <class Hasher>
+static void BM_hash_decimal_keys(benchmark::State & state)
+{
+    hash_keys<Hasher>(state, decimal_keys(static_cast<std::size_t>(state.range(0))));
+}
+
+template <class Hasher>
+static void BM_hash_sequential_keys(benchmark::State & state)
+{
+    hash_keys<Hasher>(state, sequential_keys(static_cast<std::size_t>(state.range(0))));
+}
+
+template <class Hasher>
+static void BM_hash_aligned_keys(benchmark::State & state)
+{
+    hash_keys<Hasher>(state, aligned_keys(static_cast<std::size_t>(state.range(0))));
+}
+
+static void BM_hash_grid_keys(benchmark::State & state)
+{
+    std::vector<std::pair<int, int>> keys;
+    for (int x = 0; x < state.range(0); ++x) {
+        for (int y = 0; y < state.range(0); ++y) {
+            keys.emplace_back(x, y);
+        }
+    }
+    hash_keys<wwstl::hash<std::pair<int, int>>>(state, keys);
+}
+
+static void BM_hash_double_keys(benchmark::State & state)
+{
+    std::vector<double> keys;
+    for (int i = 0; i < state.range(0); ++i) {
+        keys.push_back(i * 0.25);
+    }
+    hash_keys<wwstl::hash<double>>(state, keys);
+}
+
+BENCHMARK_TEMPLATE(BM_hash_string_throughput, ww_string_hash)->RangeMultiplier(4)->Range(4, 4096);
+BENCHMARK_TEMPLATE(BM_hash_string_throughput, std_string_hash)->RangeMultiplier(4)->Range(4, 4096);
+BENCHMARK_TEMPLATE(BM_hash_string_throughput, multiply31_hash)->RangeMultiplier(4)->Range(4, 4096);
+
+BENCHMARK_TEMPLATE(BM_hash_int_throughput, ww_int_hash);
+BENCHMARK_TEMPLATE(BM_hash_int_throughput, std_int_hash);
+
+BENCHMARK_TEMPLATE(BM_hash_url_keys, ww_string_hash)->Arg(1 << 16);
+BENCHMARK_TEMPLATE(BM_hash_url_keys, std_string_hash)->Arg(1 << 16);
+BENCHMARK_TEMPLATE(BM_hash_url_keys, multiply31_hash)->Arg(1 << 16);
+
+BENCHMARK_TEMPLATE(BM_hash_decimal_keys, ww_string_hash)->Arg(1 << 16);
+BENCHMARK_TEMPLATE(BM_hash_decimal_keys, std_string_hash)->Arg(1 << 16);
+BENCHMARK_TEMPLATE(BM_hash_decimal_keys, multiply31_hash)->Arg(1 << 16);
+
+BENCHMARK_TEMPLATE(BM_hash_sequential_keys, ww_int_hash)->Arg(1 << 16);
+BENCHMARK_TEMPLATE(BM_hash_sequential_keys, identity_hash)->Arg(1 << 16);
+
+BENCHMARK_TEMPLATE(BM_hash_aligned_keys, ww_int_hash)->Arg(1 << 16);
+BENCHMARK_TEMPLATE(BM_hash_aligned_keys, identity_hash)->Arg(1 << 16);
+
+BENCHMARK(BM_hash_grid_keys)->Arg(256);
+BENCHMARK(BM_hash_double_keys)->Arg(1 << 16);
@@ -0,0 +1,108 @@
+#include <benchmark/benchmark.h>
+#include <cstdint>
+#include <random>
+#include <unordered_map>
+#include <vector>
+#include <ww_unordered_map.h>
+
+// 桶数策略 × 键分布：range(0)为元素数，哈希函数取恒等映射，键的分布直接决定桶的分布
+
+struct identity_hash
+{
+    std::size_t operator()(std::uint64_t key) const
+    {
+        return static_cast<std::size_t>(key);
+    }
+};
+
+template <class Policy>
+using policy_map = wwstl::unordered_map<std::uint64_t, std::uint64_t, identity_hash, std::equal_to<std::uint64_t>,
+                                        wwstl::allocator<std::pair<const std::uint64_t, std::uint64_t>>, false, Policy>;
+
+using pow2_map = policy_map<wwstl::power_of_two_rehash_policy>;
+using prime_map = policy_map<wwstl::prime_rehash_policy>;
+using std_map = std::unordered_map<std::uint64_t, std::uint64_t>;
+
+static std::vector<std::uint64_t> sequential_keys(std::size_t n)
+{
+    std::vector<std::uint64_t> keys(n);
+    for (std::size_t i = 0; i < n; ++i) {
+        keys[i] = i;
+    }
+    return keys;
+}
+
+/**
+ * @brief 步长为4096的键，低12位全为0，只取低位的映射会把它们集中到少数桶
+ */
+static std::vector<std::uint64_t> strided_keys(std::size_t n)
+{
+    std::vector<std::uint64_t> keys(n);
+    for (std::size_t i = 0; i < n; ++i) {
+        keys[i] = i << 12;
+    }
+    return keys;
+}
+
+static std::vector<std::uint64_t> random_keys(std::size_t n)
+{
+    std::vector<std::uint64_t> keys(n);
+    std::mt19937_64 gen(42);
+    for (auto & key : keys) {
+        key = gen();
+    }
+    return keys;
+}
+
+/**
+ * @brief 插入全部键后按随机顺序查找
+ */
+template <class Map>
+static void find_keys(benchmark::State & state, const std::vector<std::uint64_t> & keys)
+{
+    Map map;
+    for (std::size_t i = 0; i < keys.size(); ++i) {
+        map.emplace(keys[i], i);
+    }
+    std::vector<std::uint64_t> probes(1 << 16);
+    std::mt19937_64 gen(7);
+    for (auto & probe : probes) {
+        probe = keys[gen() % keys.size()];
+    }
+    std::size_t i = 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(map.find(probes[i]));
+        i = (i + 1) & (probes.size() - 1);
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+template <class Map>
+static void BM_hash_policy_find_sequential(benchmark::State & state)
+{
+    find_keys<Map>(state, sequential_keys(static_cast<std::size_t>(state.range(0))));
+}
+
+template <class Map>
+static void BM_hash_policy_find_strided(benchmark::State & state)
+{
+    find_keys<Map>(state, strided_keys(static_cast<std::size_t>(state.range(0))));
+}
+
+template <class Map>
+static void BM_hash_policy_find_random(benchmark::State & state)
+{
+    find_keys<Map>(state, random_keys(static_cast<std::size_t>(state.range(0))));
+}
+
+BENCHMARK_TEMPLATE(BM_hash_policy_find_sequential, pow2_map)->Arg(1 << 16)->Arg(1 << 20);
+BENCHMARK_TEMPLATE(BM_hash_policy_find_sequential, prime_map)->Arg(1 << 16)->Arg(1 << 20);
+BENCHMARK_TEMPLATE(BM_hash_policy_find_sequential, std_map)->Arg(1 << 16)->Arg(1 << 20);
+
+BENCHMARK_TEMPLATE(BM_hash_policy_find_strided, pow2_map)->Arg(1 << 16)->Arg(1 << 20);
+BENCHMARK_TEMPLATE(BM_hash_policy_find_strided, prime_map)->Arg(1 << 16)->Arg(1 << 20);
+BENCHMARK_TEMPLATE(BM_hash_policy_find_strided, std_map)->Arg(1 << 16)->Arg(1 << 20);
+
+BENCHMARK_TEMPLATE(BM_hash_policy_find_random, pow2_map)->Arg(1 << 16)->Arg(1 << 20);
+BENCHMARK_TEMPLATE(BM_hash_policy_find_random, prime_map)->Arg(1 << 16)->Arg(1 << 20);
+BENCHMARK_TEMPLATE(BM_hash_policy_find_random, std_map)->Arg(1 << 16)->Arg(1 << 20);
@@ -0,0 +1,135 @@
+#include <benchmark/benchmark.h>
+#include <vector>
+#include <iterator>
+#include <ww_map.h>
+#include <ww_interval_map.h>
+
+// range(0)个时间窗口，起点均匀分布在[0, 1 << 24)，长度不超过4096
+
+static unsigned int next_seed(unsigned int seed)
+{
+    return seed * 1103515245 + 12345;
+}
+
+template <class F>
+static void fill_windows(int n, F f)
+{
+    unsigned int seed = 1;
+    for (int i = 0; i < n; ++i) {
+        seed = next_seed(seed);
+        int lo = static_cast<int>(seed >> 8);
+        seed = next_seed(seed);
+        f(lo, lo + static_cast<int>((seed >> 16) % 4096), i);
+    }
+}
+
+// 重叠查询
+
+static void BM_ww_interval_multimap_find_overlapping(benchmark::State & state)
+{
+    wwstl::interval_multimap<int, int> map;
+    fill_windows(static_cast<int>(state.range(0)), [&map](int lo, int hi, int i) {
+        map.emplace(std::make_pair(lo, hi), i);
+    });
+    std::vector<wwstl::interval_multimap<int, int>::iterator> result;
+    unsigned int seed = 2;
+    for (auto _ : state) {
+        seed = next_seed(seed);
+        int lo = static_cast<int>(seed >> 8);
+        result.clear();
+        map.find_overlapping(lo, lo + 1000, std::back_inserter(result));
+        benchmark::DoNotOptimize(result.data());
+    }
+}
+BENCHMARK(BM_ww_interval_multimap_find_overlapping)->Arg(1 << 16)->Arg(1 << 20);
+
+static void BM_ww_multimap_scan_overlapping(benchmark::State & state)
+{
+    // 对照：按起点排序的multimap，从头扫描到起点超出查询区间为止
+    wwstl::multimap<int, int> map;
+    fill_windows(static_cast<int>(state.range(0)), [&map](int lo, int hi, int) {
+        map.emplace(lo, hi);
+    });
+    std::vector<wwstl::multimap<int, int>::iterator> result;
+    unsigned int seed = 2;
+    for (auto _ : state) {
+        seed = next_seed(seed);
+        int lo = static_cast<int>(seed >> 8);
+        int hi = lo + 1000;
+        result.clear();
+        for (auto it = map.begin(); it != map.end() && it->first < hi; ++it) {
+            if (lo < it->second) {
+                result.push_back(it);
+            }
+        }
+        benchmark::DoNotOptimize(result.data());
+    }
+}
+BENCHMARK(BM_ww_multimap_scan_overlapping)->Arg(1 << 16)->Arg(1 << 20);
+
+// 点查询
+
+static void BM_ww_interval_multimap_find_containing(benchmark::State & state)
+{
+    wwstl::interval_multimap<int, int> map;
+    fill_windows(static_cast<int>(state.range(0)), [&map](int lo, int hi, int i) {
+        map.emplace(std::make_pair(lo, hi), i);
+    });
+    std::vector<wwstl::interval_multimap<int, int>::iterator> result;
+    unsigned int seed = 3;
+    for (auto _ : state) {
+        seed = next_seed(seed);
+        result.clear();
+        map.find_containing(static_cast<int>(seed >> 8), std::back_inserter(result));
+        benchmark::DoNotOptimize(result.data());
+    }
+}
+BENCHMARK(BM_ww_interval_multimap_find_containing)->Arg(1 << 16)->Arg(1 << 20);
+
+static void BM_ww_multimap_scan_containing(benchmark::State & state)
+{
+    wwstl::multimap<int, int> map;
+    fill_windows(static_cast<int>(state.range(0)), [&map](int lo, int hi, int) {
+        map.emplace(lo, hi);
+    });
+    std::vector<wwstl::multimap<int, int>::iterator> result;
+    unsigned int seed = 3;
+    for (auto _ : state) {
+        seed = next_seed(seed);
+        int point = static_cast<int>(seed >> 8);
+        result.clear();
+        for (auto it = map.begin(); it != map.end() && !(point < it->first); ++it) {
+            if (point < it->second) {
+                result.push_back(it);
+            }
+        }
+        benchmark::DoNotOptimize(result.data());
+    }
+}
+BENCHMARK(BM_ww_multimap_scan_containing)->Arg(1 << 16)->Arg(1 << 20);
+
+// 插入，比较维护最大上界的开销
+
+static void BM_ww_interval_multimap_insert(benchmark::State & state)
+{
+    for (auto _ : state) {
+        wwstl::interval_multimap<int, int> map;
+        fill_windows(static_cast<int>(state.range(0)), [&map](int lo, int hi, int i) {
+            map.emplace(std::make_pair(lo, hi), i);
+        });
+        benchmark::DoNotOptimize(map.size());
+    }
+}
+BENCHMARK(BM_ww_interval_multimap_insert)->Arg(1 << 16);
+
+static void BM_ww_multimap_insert_windows(benchmark::State & state)
+{
+    for (auto _ : state) {
+        wwstl::multimap<std::pair<int, int>, int> map;
+        fill_windows(static_cast<int>(state.range(0)), [&map](int lo, int hi, int i) {
+            map.emplace(std::make_pair(lo, hi), i);
+        });
+        benchmark::DoNotOptimize(map.size());
+    }
+}
+BENCHMARK(BM_ww_multimap_insert_windows)->Arg(1 << 16);
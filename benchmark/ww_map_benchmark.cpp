@@ -1,5 +1,11 @@
 #include <benchmark/benchmark.h>
+#include <cstdint>
+#include <cstring>
 #include <map>
+#include <random>
+#include <string>
+#include <tuple>
+#include <vector>
 #include <ww_map.h>
 
 // access
@@ -275,3 +281,509 @@ static void BM_std_map_upper_bound(benchmark::State & state)
     }
 }
 BENCHMARK(BM_std_map_upper_bound);
+
+// copy
+
+static void BM_ww_map_copy(benchmark::State & state)
+{
+    wwstl::map<int, int> m;
+    for (int i = 0; i < state.range(0); ++i) {
+        m.insert({i, i});
+    }
+    for (auto _ : state) {
+        wwstl::map<int, int> snapshot(m);
+        benchmark::DoNotOptimize(snapshot);
+    }
+}
+BENCHMARK(BM_ww_map_copy)->Arg(1000000)->Arg(10000000)->Unit(benchmark::kMillisecond);
+
+static void BM_std_map_copy(benchmark::State & state)
+{
+    std::map<int, int> m;
+    for (int i = 0; i < state.range(0); ++i) {
+        m.insert({i, i});
+    }
+    for (auto _ : state) {
+        std::map<int, int> snapshot(m);
+        benchmark::DoNotOptimize(snapshot);
+    }
+}
+BENCHMARK(BM_std_map_copy)->Arg(1000000)->Arg(10000000)->Unit(benchmark::kMillisecond);
+
+// sorted range constructor
+
+static void BM_ww_map_sorted_range(benchmark::State & state)
+{
+    std::vector<std::pair<int, int>> v;
+    for (int i = 0; i < state.range(0); ++i) {
+        v.emplace_back(i, i);
+    }
+    for (auto _ : state) {
+        wwstl::map<int, int> m(v.begin(), v.end());
+        benchmark::DoNotOptimize(m);
+    }
+}
+BENCHMARK(BM_ww_map_sorted_range)->Arg(1000000)->Unit(benchmark::kMillisecond);
+
+static void BM_std_map_sorted_range(benchmark::State & state)
+{
+    std::vector<std::pair<int, int>> v;
+    for (int i = 0; i < state.range(0); ++i) {
+        v.emplace_back(i, i);
+    }
+    for (auto _ : state) {
+        std::map<int, int> m(v.begin(), v.end());
+        benchmark::DoNotOptimize(m);
+    }
+}
+BENCHMARK(BM_std_map_sorted_range)->Arg(1000000)->Unit(benchmark::kMillisecond);
+
+// sorted append
+
+static void BM_ww_map_append(benchmark::State & state)
+{
+    for (auto _ : state) {
+        wwstl::map<int, int> m;
+        for (int i = 0; i < state.range(0); ++i) {
+            m.insert({i, i});
+        }
+        benchmark::DoNotOptimize(m);
+    }
+}
+BENCHMARK(BM_ww_map_append)->Arg(100000)->Unit(benchmark::kMicrosecond);
+
+static void BM_ww_map_append_hint(benchmark::State & state)
+{
+    for (auto _ : state) {
+        wwstl::map<int, int> m;
+        for (int i = 0; i < state.range(0); ++i) {
+            m.insert(m.end(), {i, i});
+        }
+        benchmark::DoNotOptimize(m);
+    }
+}
+BENCHMARK(BM_ww_map_append_hint)->Arg(100000)->Unit(benchmark::kMicrosecond);
+
+static void BM_std_map_append(benchmark::State & state)
+{
+    for (auto _ : state) {
+        std::map<int, int> m;
+        for (int i = 0; i < state.range(0); ++i) {
+            m.insert({i, i});
+        }
+        benchmark::DoNotOptimize(m);
+    }
+}
+BENCHMARK(BM_std_map_append)->Arg(100000)->Unit(benchmark::kMicrosecond);
+
+static void BM_std_map_append_hint(benchmark::State & state)
+{
+    for (auto _ : state) {
+        std::map<int, int> m;
+        for (int i = 0; i < state.range(0); ++i) {
+            m.insert(m.end(), {i, i});
+        }
+        benchmark::DoNotOptimize(m);
+    }
+}
+BENCHMARK(BM_std_map_append_hint)->Arg(100000)->Unit(benchmark::kMicrosecond);
+
+// 以const char*查找string键，键长度超过短字符串优化的范围
+
+static std::vector<std::string> make_long_keys(int n)
+{
+    std::vector<std::string> keys;
+    for (int i = 0; i < n; ++i) {
+        keys.push_back("/service/config/entry/" + std::to_string(i * 7919));
+    }
+    return keys;
+}
+
+template <class Map>
+static void find_by_c_str(benchmark::State & state)
+{
+    const std::vector<std::string> keys = make_long_keys(static_cast<int>(state.range(0)));
+    Map m;
+    for (std::size_t i = 0; i < keys.size(); ++i) {
+        m.insert({keys[i], static_cast<int>(i)});
+    }
+    std::size_t i = 0;
+    for (auto _ : state) {
+        const char * key = keys[i].c_str();
+        auto it = m.find(key);
+        benchmark::DoNotOptimize(it);
+        i = i + 1 == keys.size() ? 0 : i + 1;
+    }
+}
+
+// 带长度的字符串视图，比较时不需要重新计算const char*的长度
+
+class key_view
+{
+public:
+    const char * _data;
+    std::size_t _size;
+};
+
+static int compare_key(const char * lhs, std::size_t lhs_size, const char * rhs, std::size_t rhs_size)
+{
+    int result = std::memcmp(lhs, rhs, lhs_size < rhs_size ? lhs_size : rhs_size);
+    if (result != 0) {
+        return result;
+    }
+    return lhs_size < rhs_size ? -1 : (lhs_size > rhs_size ? 1 : 0);
+}
+
+class key_view_less
+{
+public:
+    using is_transparent = void;
+
+public:
+    bool operator()(const std::string & lhs, const std::string & rhs) const
+    {
+        return lhs < rhs;
+    }
+
+    bool operator()(const std::string & lhs, const key_view & rhs) const
+    {
+        return compare_key(lhs.data(), lhs.size(), rhs._data, rhs._size) < 0;
+    }
+
+    bool operator()(const key_view & lhs, const std::string & rhs) const
+    {
+        return compare_key(lhs._data, lhs._size, rhs.data(), rhs.size()) < 0;
+    }
+};
+
+template <class Map>
+static void find_by_view(benchmark::State & state)
+{
+    const std::vector<std::string> keys = make_long_keys(static_cast<int>(state.range(0)));
+    Map m;
+    for (std::size_t i = 0; i < keys.size(); ++i) {
+        m.insert({keys[i], static_cast<int>(i)});
+    }
+    std::size_t i = 0;
+    for (auto _ : state) {
+        // 长度只在进入查找前计算一次
+        const char * key = keys[i].c_str();
+        auto it = m.find(key_view{key, std::strlen(key)});
+        benchmark::DoNotOptimize(it);
+        i = i + 1 == keys.size() ? 0 : i + 1;
+    }
+}
+
+static void BM_ww_map_find_c_str(benchmark::State & state)
+{
+    find_by_c_str<wwstl::map<std::string, int>>(state);
+}
+BENCHMARK(BM_ww_map_find_c_str)->Arg(10000);
+
+static void BM_ww_map_find_c_str_transparent(benchmark::State & state)
+{
+    find_by_c_str<wwstl::map<std::string, int, std::less<>>>(state);
+}
+BENCHMARK(BM_ww_map_find_c_str_transparent)->Arg(10000);
+
+static void BM_std_map_find_c_str(benchmark::State & state)
+{
+    find_by_c_str<std::map<std::string, int>>(state);
+}
+BENCHMARK(BM_std_map_find_c_str)->Arg(10000);
+
+static void BM_std_map_find_c_str_transparent(benchmark::State & state)
+{
+    find_by_c_str<std::map<std::string, int, std::less<>>>(state);
+}
+BENCHMARK(BM_std_map_find_c_str_transparent)->Arg(10000);
+
+static void BM_ww_map_find_view_transparent(benchmark::State & state)
+{
+    find_by_view<wwstl::map<std::string, int, key_view_less>>(state);
+}
+BENCHMARK(BM_ww_map_find_view_transparent)->Arg(10000);
+
+static void BM_std_map_find_view_transparent(benchmark::State & state)
+{
+    find_by_view<std::map<std::string, int, key_view_less>>(state);
+}
+BENCHMARK(BM_std_map_find_view_transparent)->Arg(10000);
+
+// 在两个map之间来回移动元素
+
+template <class Map>
+static void transfer_by_value(benchmark::State & state)
+{
+    // 插入新元素再擦除旧元素，每次移动都有一次分配和一次释放
+    const int n = static_cast<int>(state.range(0));
+    Map a;
+    Map b;
+    for (int i = 0; i < n; ++i) {
+        a.insert(std::make_pair(i, std::string(32, 'x')));
+    }
+    Map * from = &a;
+    Map * to = &b;
+    int i = 0;
+    for (auto _ : state) {
+        auto it = from->find(i);
+        to->insert(std::make_pair(i, std::move(it->second)));
+        from->erase(it);
+        if (++i == n) {
+            i = 0;
+            std::swap(from, to);
+        }
+    }
+}
+
+static void BM_ww_map_transfer_by_value(benchmark::State & state)
+{
+    transfer_by_value<wwstl::map<int, std::string>>(state);
+}
+BENCHMARK(BM_ww_map_transfer_by_value)->Arg(1 << 12);
+
+static void BM_std_map_transfer_by_value(benchmark::State & state)
+{
+    transfer_by_value<std::map<int, std::string>>(state);
+}
+BENCHMARK(BM_std_map_transfer_by_value)->Arg(1 << 12);
+
+static void BM_ww_map_transfer_by_node(benchmark::State & state)
+{
+    // 直接移动节点，不分配也不释放
+    const int n = static_cast<int>(state.range(0));
+    wwstl::map<int, std::string> a;
+    wwstl::map<int, std::string> b;
+    for (int i = 0; i < n; ++i) {
+        a.insert(std::make_pair(i, std::string(32, 'x')));
+    }
+    wwstl::map<int, std::string> * from = &a;
+    wwstl::map<int, std::string> * to = &b;
+    int i = 0;
+    for (auto _ : state) {
+        to->insert(from->extract(i));
+        if (++i == n) {
+            i = 0;
+            std::swap(from, to);
+        }
+    }
+}
+BENCHMARK(BM_ww_map_transfer_by_node)->Arg(1 << 12);
+
+// 更新已存在的键，统计每次操作的节点分配次数
+
+static std::size_t upsert_allocations = 0;
+
+template <class T>
+class counting_allocator
+    : public wwstl::allocator<T>
+{
+public:
+    template <class U>
+    class rebind
+    {
+    public:
+        using other = counting_allocator<U>;
+    };
+
+public:
+    counting_allocator() noexcept = default;
+
+    template <class U>
+    counting_allocator(const counting_allocator<U> &) noexcept
+    {
+    }
+
+public:
+    T * allocate(std::size_t n, const void * hint = nullptr)
+    {
+        ++upsert_allocations;
+        return wwstl::allocator<T>::allocate(n, hint);
+    }
+};
+
+template <class Map, class Upsert>
+static void upsert(benchmark::State & state, Upsert op)
+{
+    const int n = static_cast<int>(state.range(0));
+    Map map;
+    for (int i = 0; i < n; ++i) {
+        map.emplace(i, i);
+    }
+    const std::size_t before = upsert_allocations;
+    int i = 0;
+    for (auto _ : state) {
+        op(map, i);
+        if (++i == n) {
+            i = 0;
+        }
+    }
+    state.counters["allocs_per_op"] = static_cast<double>(upsert_allocations - before) / static_cast<double>(state.iterations());
+}
+
+using WW = wwstl::map<int, int, std::less<int>, counting_allocator<std::pair<const int, int>>>;
+using STD = std::map<int, int, std::less<int>, counting_allocator<std::pair<const int, int>>>;
+
+static void BM_ww_map_upsert_emplace(benchmark::State & state)
+{
+    // 可以直接取得键，先查找，不分配节点
+    upsert<WW>(state, [](WW & map, int i) { benchmark::DoNotOptimize(map.emplace(i, i + 1)); });
+}
+BENCHMARK(BM_ww_map_upsert_emplace)->Arg(1 << 12);
+
+static void BM_ww_map_upsert_emplace_piecewise(benchmark::State & state)
+{
+    // 无法直接取得键，先构造节点再查找
+    upsert<WW>(state, [](WW & map, int i) {
+        benchmark::DoNotOptimize(map.emplace(std::piecewise_construct, std::forward_as_tuple(i), std::forward_as_tuple(i + 1)));
+    });
+}
+BENCHMARK(BM_ww_map_upsert_emplace_piecewise)->Arg(1 << 12);
+
+static void BM_ww_map_upsert_try_emplace(benchmark::State & state)
+{
+    upsert<WW>(state, [](WW & map, int i) { benchmark::DoNotOptimize(map.try_emplace(i, i + 1)); });
+}
+BENCHMARK(BM_ww_map_upsert_try_emplace)->Arg(1 << 12);
+
+static void BM_ww_map_upsert_insert_or_assign(benchmark::State & state)
+{
+    upsert<WW>(state, [](WW & map, int i) { benchmark::DoNotOptimize(map.insert_or_assign(i, i + 1)); });
+}
+BENCHMARK(BM_ww_map_upsert_insert_or_assign)->Arg(1 << 12);
+
+static void BM_std_map_upsert_emplace(benchmark::State & state)
+{
+    upsert<STD>(state, [](STD & map, int i) { benchmark::DoNotOptimize(map.emplace(i, i + 1)); });
+}
+BENCHMARK(BM_std_map_upsert_emplace)->Arg(1 << 12);
+
+static void BM_std_map_upsert_operator_access(benchmark::State & state)
+{
+    upsert<STD>(state, [](STD & map, int i) { benchmark::DoNotOptimize(map[i] = i + 1); });
+}
+BENCHMARK(BM_std_map_upsert_operator_access)->Arg(1 << 12);
+
+// 在远大于末级缓存的表中批量查找
+
+template <class Map>
+static void batch_setup(Map & map, std::vector<std::uint64_t> & keys, std::size_t n)
+{
+    std::mt19937_64 gen(42);
+    for (std::size_t i = 0; i < n; ++i) {
+        map.emplace(gen() % (n * 2), i);
+    }
+    keys.resize(256);
+    for (auto & key : keys) {
+        key = gen() % (n * 2);
+    }
+}
+
+template <class Map>
+static void batch_find_loop(benchmark::State & state)
+{
+    Map map;
+    std::vector<std::uint64_t> keys;
+    batch_setup(map, keys, static_cast<std::size_t>(state.range(0)));
+    std::vector<typename Map::iterator> found(keys.size());
+    std::uint64_t salt = 0;
+    for (auto _ : state) {
+        // 每轮换一批键，避免重复访问同一批节点
+        for (auto & key : keys) {
+            key = (key + salt) % (static_cast<std::uint64_t>(state.range(0)) * 2);
+        }
+        salt = 7919;
+        for (std::size_t i = 0; i < keys.size(); ++i) {
+            found[i] = map.find(keys[i]);
+        }
+        benchmark::DoNotOptimize(found.data());
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(keys.size()));
+}
+
+static void BM_ww_map_find_loop_batch(benchmark::State & state)
+{
+    batch_find_loop<wwstl::map<std::uint64_t, std::size_t>>(state);
+}
+BENCHMARK(BM_ww_map_find_loop_batch)->Arg(1 << 22)->Unit(benchmark::kMicrosecond);
+
+static void BM_ww_map_find_many_batch(benchmark::State & state)
+{
+    wwstl::map<std::uint64_t, std::size_t> map;
+    std::vector<std::uint64_t> keys;
+    batch_setup(map, keys, static_cast<std::size_t>(state.range(0)));
+    std::vector<wwstl::map<std::uint64_t, std::size_t>::iterator> found(keys.size());
+    std::uint64_t salt = 0;
+    for (auto _ : state) {
+        for (auto & key : keys) {
+            key = (key + salt) % (static_cast<std::uint64_t>(state.range(0)) * 2);
+        }
+        salt = 7919;
+        map.find_many(keys.begin(), keys.end(), found.begin());
+        benchmark::DoNotOptimize(found.data());
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(keys.size()));
+}
+BENCHMARK(BM_ww_map_find_many_batch)->Arg(1 << 22)->Unit(benchmark::kMicrosecond);
+
+static void BM_std_map_find_loop_batch(benchmark::State & state)
+{
+    batch_find_loop<std::map<std::uint64_t, std::size_t>>(state);
+}
+BENCHMARK(BM_std_map_find_loop_batch)->Arg(1 << 22)->Unit(benchmark::kMicrosecond);
+
+// 归并连接：按顺序查找有序的键流，range(0)为表的大小，range(1)为相邻两个查找键的间距
+
+template <class Map, class Seek>
+static void merge_join(benchmark::State & state, Seek seek)
+{
+    const int n = static_cast<int>(state.range(0));
+    const int stride = static_cast<int>(state.range(1));
+    Map map;
+    for (int i = 0; i < n; ++i) {
+        map.emplace(i * 2, i);
+    }
+    std::vector<int> keys;
+    for (int key = 1; key < n * 2; key += stride) {
+        keys.push_back(key);
+    }
+    for (auto _ : state) {
+        std::size_t matched = 0;
+        auto it = map.begin();
+        for (int key : keys) {
+            it = seek(map, it, key);
+            if (it != map.end() && it->first == key) {
+                ++matched;
+            }
+        }
+        benchmark::DoNotOptimize(matched);
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(keys.size()));
+}
+
+static void BM_ww_map_merge_join_seek_forward(benchmark::State & state)
+{
+    using map_type = wwstl::map<int, int>;
+    merge_join<map_type>(state, [](map_type & map, map_type::iterator it, int key) {
+        return map.seek_forward(it, key);
+    });
+}
+BENCHMARK(BM_ww_map_merge_join_seek_forward)->Args({1 << 20, 3})->Args({1 << 20, 64})->Args({1 << 20, 4096})->Unit(benchmark::kMicrosecond);
+
+static void BM_ww_map_merge_join_lower_bound(benchmark::State & state)
+{
+    using map_type = wwstl::map<int, int>;
+    merge_join<map_type>(state, [](map_type & map, map_type::iterator, int key) {
+        return map.lower_bound(key);
+    });
+}
+BENCHMARK(BM_ww_map_merge_join_lower_bound)->Args({1 << 20, 3})->Args({1 << 20, 64})->Args({1 << 20, 4096})->Unit(benchmark::kMicrosecond);
+
+static void BM_std_map_merge_join_lower_bound(benchmark::State & state)
+{
+    using map_type = std::map<int, int>;
+    merge_join<map_type>(state, [](map_type & map, map_type::iterator, int key) {
+        return map.lower_bound(key);
+    });
+}
+BENCHMARK(BM_std_map_merge_join_lower_bound)->Args({1 << 20, 3})->Args({1 << 20, 64})->Args({1 << 20, 4096})->Unit(benchmark::kMicrosecond);
@@ -1,6 +1,7 @@
 #include <benchmark/benchmark.h>
 #include <set>
 #include <ww_set.h>
+#include <ww_counted_multiset.h>
 
 // iterator
 
@@ -193,3 +194,39 @@ static void BM_std_multiset_upper_bound(benchmark::State & state)
     }
 }
 BENCHMARK(BM_std_multiset_upper_bound);
+
+// 大量重复：range(0)个元素，只有4096个不同的键
+
+template <class Set>
+static void count_levels(benchmark::State & state)
+{
+    const int n = static_cast<int>(state.range(0));
+    Set set;
+    for (int i = 0; i < n; ++i) {
+        set.insert((i * 2654435761u) % 4096);
+    }
+    int key = 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(set.count(key));
+        key = (key + 97) % 4096;
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+static void BM_ww_multiset_count_duplicates(benchmark::State & state)
+{
+    count_levels<wwstl::multiset<int>>(state);
+}
+BENCHMARK(BM_ww_multiset_count_duplicates)->Arg(1 << 20);
+
+static void BM_ww_counted_multiset_count_duplicates(benchmark::State & state)
+{
+    count_levels<wwstl::counted_multiset<int>>(state);
+}
+BENCHMARK(BM_ww_counted_multiset_count_duplicates)->Arg(1 << 20);
+
+static void BM_std_multiset_count_duplicates(benchmark::State & state)
+{
+    count_levels<std::multiset<int>>(state);
+}
+BENCHMARK(BM_std_multiset_count_duplicates)->Arg(1 << 20);
@@ -0,0 +1,132 @@
+#include <benchmark/benchmark.h>
+#include <atomic>
+#include <map>
+#include <mutex>
+#include <thread>
+#include <ww_map.h>
+#include <ww_persistent_map.h>
+
+// snapshot
+
+static void BM_ww_persistent_map_snapshot(benchmark::State & state)
+{
+    const int n = static_cast<int>(state.range(0));
+    wwstl::persistent_map<int, int> map;
+    for (int i = 0; i < n; ++i) {
+        map = map.insert_or_assign(i, i);
+    }
+    for (auto _ : state) {
+        wwstl::persistent_map<int, int> snapshot(map);
+        benchmark::DoNotOptimize(snapshot);
+    }
+}
+BENCHMARK(BM_ww_persistent_map_snapshot)->Arg(1 << 16);
+
+static void BM_ww_map_snapshot(benchmark::State & state)
+{
+    const int n = static_cast<int>(state.range(0));
+    wwstl::map<int, int> map;
+    for (int i = 0; i < n; ++i) {
+        map.emplace(i, i);
+    }
+    for (auto _ : state) {
+        wwstl::map<int, int> snapshot(map);
+        benchmark::DoNotOptimize(snapshot);
+    }
+}
+BENCHMARK(BM_ww_map_snapshot)->Arg(1 << 16);
+
+static void BM_std_map_snapshot(benchmark::State & state)
+{
+    const int n = static_cast<int>(state.range(0));
+    std::map<int, int> map;
+    for (int i = 0; i < n; ++i) {
+        map.emplace(i, i);
+    }
+    for (auto _ : state) {
+        std::map<int, int> snapshot(map);
+        benchmark::DoNotOptimize(snapshot);
+    }
+}
+BENCHMARK(BM_std_map_snapshot)->Arg(1 << 16);
+
+// update
+
+static void BM_ww_persistent_map_update(benchmark::State & state)
+{
+    const int n = static_cast<int>(state.range(0));
+    wwstl::persistent_map<int, int> map;
+    for (int i = 0; i < n; ++i) {
+        map = map.insert_or_assign(i, i);
+    }
+    int i = 0;
+    for (auto _ : state) {
+        map = map.insert_or_assign(i, -i);
+        i = (i + 7919) % n;
+    }
+}
+BENCHMARK(BM_ww_persistent_map_update)->Arg(1 << 16);
+
+// 一个写者不断更新并发布，读者每次取快照后查找
+
+static void BM_ww_persistent_map_read_with_writer(benchmark::State & state)
+{
+    const int n = static_cast<int>(state.range(0));
+    wwstl::persistent_map<int, int> initial;
+    for (int i = 0; i < n; ++i) {
+        initial = initial.insert_or_assign(i, i);
+    }
+    wwstl::atomic_persistent_map<int, int> cell(initial);
+    std::atomic<bool> done(false);
+    std::thread writer([&]() {
+        wwstl::persistent_map<int, int> current = initial;
+        int i = 0;
+        while (!done.load()) {
+            current = current.insert_or_assign(i, -i);
+            cell.store(current);
+            i = (i + 7919) % n;
+        }
+    });
+    int key = 0;
+    for (auto _ : state) {
+        wwstl::persistent_map<int, int> snapshot = cell.load();
+        benchmark::DoNotOptimize(snapshot.find(key));
+        key = (key + 104729) % n;
+    }
+    done.store(true);
+    writer.join();
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_ww_persistent_map_read_with_writer)->Arg(1 << 16)->UseRealTime();
+
+static void BM_std_map_mutex_read_with_writer(benchmark::State & state)
+{
+    // 对照：读写共用一把互斥锁
+    const int n = static_cast<int>(state.range(0));
+    std::map<int, int> map;
+    for (int i = 0; i < n; ++i) {
+        map.emplace(i, i);
+    }
+    std::mutex mutex;
+    std::atomic<bool> done(false);
+    std::thread writer([&]() {
+        int i = 0;
+        while (!done.load()) {
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                map[i] = -i;
+            }
+            i = (i + 7919) % n;
+        }
+    });
+    int key = 0;
+    for (auto _ : state) {
+        std::lock_guard<std::mutex> lock(mutex);
+        benchmark::DoNotOptimize(map.find(key));
+        key = (key + 104729) % n;
+    }
+    done.store(true);
+    writer.join();
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_std_map_mutex_read_with_writer)->Arg(1 << 16)->UseRealTime();
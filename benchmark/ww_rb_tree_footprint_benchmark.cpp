@@ -0,0 +1,160 @@
+#include <benchmark/benchmark.h>
+#include <cstdint>
+#include <map>
+#include <set>
+#include <ww_map.h>
+#include <ww_set.h>
+#include <ww_counted_multiset.h>
+
+// 统计节点分配字节数的分配器
+
+static std::size_t footprint_bytes = 0;
+
+template <class T>
+class footprint_allocator
+    : public wwstl::allocator<T>
+{
+public:
+    template <class U>
+    class rebind
+    {
+    public:
+        using other = footprint_allocator<U>;
+    };
+
+public:
+    footprint_allocator() noexcept = default;
+
+    template <class U>
+    footprint_allocator(const footprint_allocator<U> &) noexcept
+    {
+    }
+
+public:
+    T * allocate(std::size_t n, const void * hint = nullptr)
+    {
+        footprint_bytes += n * sizeof(T);
+        return wwstl::allocator<T>::allocate(n, hint);
+    }
+
+    void deallocate(T * ptr, std::size_t n = 1)
+    {
+        footprint_bytes -= n * sizeof(T);
+        wwstl::allocator<T>::deallocate(ptr, n);
+    }
+};
+
+template <class Container>
+static void footprint(benchmark::State & state, std::size_t plain_node_bytes)
+{
+    const std::size_t n = static_cast<std::size_t>(state.range(0));
+    std::size_t bytes = 0;
+    for (auto _ : state) {
+        std::size_t before = footprint_bytes;
+        Container c;
+        for (std::size_t i = 0; i < n; ++i) {
+            c.insert(typename Container::value_type(static_cast<typename Container::key_type>(i), {}));
+        }
+        bytes = footprint_bytes - before;
+        benchmark::DoNotOptimize(c);
+    }
+    state.counters["bytes_per_element"] = static_cast<double>(bytes) / static_cast<double>(n);
+    if (plain_node_bytes != 0) {
+        // 与颜色单独存储的布局对比
+        state.counters["plain_bytes_per_element"] = static_cast<double>(plain_node_bytes);
+    }
+}
+
+template <class Container>
+static void footprint_set(benchmark::State & state, std::size_t plain_node_bytes)
+{
+    const std::size_t n = static_cast<std::size_t>(state.range(0));
+    std::size_t bytes = 0;
+    for (auto _ : state) {
+        std::size_t before = footprint_bytes;
+        Container c;
+        for (std::size_t i = 0; i < n; ++i) {
+            c.insert(static_cast<typename Container::key_type>(i));
+        }
+        bytes = footprint_bytes - before;
+        benchmark::DoNotOptimize(c);
+    }
+    state.counters["bytes_per_element"] = static_cast<double>(bytes) / static_cast<double>(n);
+    if (plain_node_bytes != 0) {
+        state.counters["plain_bytes_per_element"] = static_cast<double>(plain_node_bytes);
+    }
+}
+
+// map<int, int>
+
+static void BM_ww_map_footprint(benchmark::State & state)
+{
+    footprint<wwstl::map<int, int, std::less<int>, footprint_allocator<std::pair<const int, int>>>>(
+        state, sizeof(wwstl::_rb_tree_node<std::pair<const int, int>, false>));
+}
+BENCHMARK(BM_ww_map_footprint)->Arg(1 << 16);
+
+static void BM_std_map_footprint(benchmark::State & state)
+{
+    footprint<std::map<int, int, std::less<int>, footprint_allocator<std::pair<const int, int>>>>(state, 0);
+}
+BENCHMARK(BM_std_map_footprint)->Arg(1 << 16);
+
+// set<uint64_t>
+
+static void BM_ww_set_footprint(benchmark::State & state)
+{
+    footprint_set<wwstl::set<std::uint64_t, std::less<std::uint64_t>, footprint_allocator<std::uint64_t>>>(
+        state, sizeof(wwstl::_rb_tree_node<std::uint64_t, false>));
+}
+BENCHMARK(BM_ww_set_footprint)->Arg(1 << 16);
+
+static void BM_ww_ranked_set_footprint(benchmark::State & state)
+{
+    // 顺序统计额外记录子树大小
+    footprint_set<wwstl::ranked_set<std::uint64_t, std::less<std::uint64_t>, footprint_allocator<std::uint64_t>>>(state, 0);
+}
+BENCHMARK(BM_ww_ranked_set_footprint)->Arg(1 << 16);
+
+static void BM_std_set_footprint(benchmark::State & state)
+{
+    footprint_set<std::set<std::uint64_t, std::less<std::uint64_t>, footprint_allocator<std::uint64_t>>>(state, 0);
+}
+BENCHMARK(BM_std_set_footprint)->Arg(1 << 16);
+
+// 大量重复的multiset<int>：只有4096个不同的键
+
+template <class Container>
+static void footprint_duplicates(benchmark::State & state)
+{
+    const std::size_t n = static_cast<std::size_t>(state.range(0));
+    std::size_t bytes = 0;
+    for (auto _ : state) {
+        std::size_t before = footprint_bytes;
+        Container c;
+        for (std::size_t i = 0; i < n; ++i) {
+            c.insert(static_cast<int>((i * 2654435761u) % 4096));
+        }
+        bytes = footprint_bytes - before;
+        benchmark::DoNotOptimize(c);
+    }
+    state.counters["bytes_per_element"] = static_cast<double>(bytes) / static_cast<double>(n);
+}
+
+static void BM_ww_multiset_duplicates_footprint(benchmark::State & state)
+{
+    footprint_duplicates<wwstl::multiset<int, std::less<int>, footprint_allocator<int>>>(state);
+}
+BENCHMARK(BM_ww_multiset_duplicates_footprint)->Arg(1 << 20);
+
+static void BM_ww_counted_multiset_duplicates_footprint(benchmark::State & state)
+{
+    footprint_duplicates<wwstl::counted_multiset<int, std::less<int>, footprint_allocator<int>>>(state);
+}
+BENCHMARK(BM_ww_counted_multiset_duplicates_footprint)->Arg(1 << 20);
+
+static void BM_std_multiset_duplicates_footprint(benchmark::State & state)
+{
+    footprint_duplicates<std::multiset<int, std::less<int>, footprint_allocator<int>>>(state);
+}
+BENCHMARK(BM_std_multiset_duplicates_footprint)->Arg(1 << 20);
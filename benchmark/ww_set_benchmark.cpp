@@ -193,3 +193,149 @@ static void BM_std_set_upper_bound(benchmark::State & state)
     }
 }
 BENCHMARK(BM_std_set_upper_bound);
+
+// union，小集合并入大集合
+
+static void BM_ww_set_union(benchmark::State & state)
+{
+    const int n = static_cast<int>(state.range(0));
+    wwstl::set<int> big;
+    wwstl::set<int> small;
+    for (auto _ : state) {
+        state.PauseTiming();
+        big.clear();
+        small.clear();
+        for (int i = 0; i < n; ++i) {
+            big.insert(big.end(), i * 2);
+        }
+        for (int i = 0; i < n / state.range(1); ++i) {
+            small.insert(small.end(), i * 2 * static_cast<int>(state.range(1)) + 1);
+        }
+        state.ResumeTiming();
+        big.unite(small);
+        benchmark::DoNotOptimize(big);
+    }
+}
+BENCHMARK(BM_ww_set_union)->Args({1000000, 100})->Args({1000000, 10})->Args({1000000, 1});
+
+static void BM_std_set_union(benchmark::State & state)
+{
+    const int n = static_cast<int>(state.range(0));
+    std::set<int> big;
+    std::set<int> small;
+    for (auto _ : state) {
+        state.PauseTiming();
+        big.clear();
+        small.clear();
+        for (int i = 0; i < n; ++i) {
+            big.insert(big.end(), i * 2);
+        }
+        for (int i = 0; i < n / state.range(1); ++i) {
+            small.insert(small.end(), i * 2 * static_cast<int>(state.range(1)) + 1);
+        }
+        state.ResumeTiming();
+        big.insert(small.begin(), small.end());
+        benchmark::DoNotOptimize(big);
+    }
+}
+BENCHMARK(BM_std_set_union)->Args({1000000, 100})->Args({1000000, 10})->Args({1000000, 1});
+
+// split
+
+static void BM_ww_set_split(benchmark::State & state)
+{
+    const int n = static_cast<int>(state.range(0));
+    wwstl::set<int> set;
+    for (int i = 0; i < n; ++i) {
+        set.insert(set.end(), i);
+    }
+    for (auto _ : state) {
+        wwstl::set<int> right = set.split(n - n / 100);
+        set.join(right);
+        benchmark::DoNotOptimize(set);
+    }
+}
+BENCHMARK(BM_ww_set_split)->Arg(1000000);
+
+static void BM_std_set_split(benchmark::State & state)
+{
+    const int n = static_cast<int>(state.range(0));
+    std::set<int> set;
+    for (int i = 0; i < n; ++i) {
+        set.insert(set.end(), i);
+    }
+    for (auto _ : state) {
+        auto first = set.lower_bound(n - n / 100);
+        std::set<int> right(first, set.end());
+        set.erase(first, set.end());
+        set.insert(right.begin(), right.end());
+        benchmark::DoNotOptimize(set);
+    }
+}
+BENCHMARK(BM_std_set_split)->Arg(1000000);
+
+// 顺序统计，随机插入的维护开销
+
+static void BM_ww_set_random_insert(benchmark::State & state)
+{
+    const int n = static_cast<int>(state.range(0));
+    for (auto _ : state) {
+        wwstl::set<int> set;
+        unsigned int seed = 1;
+        for (int i = 0; i < n; ++i) {
+            seed = seed * 1103515245 + 12345;
+            set.insert(static_cast<int>(seed >> 8));
+        }
+        benchmark::DoNotOptimize(set);
+    }
+}
+BENCHMARK(BM_ww_set_random_insert)->Arg(100000);
+
+static void BM_ww_ranked_set_random_insert(benchmark::State & state)
+{
+    const int n = static_cast<int>(state.range(0));
+    for (auto _ : state) {
+        wwstl::ranked_set<int> set;
+        unsigned int seed = 1;
+        for (int i = 0; i < n; ++i) {
+            seed = seed * 1103515245 + 12345;
+            set.insert(static_cast<int>(seed >> 8));
+        }
+        benchmark::DoNotOptimize(set);
+    }
+}
+BENCHMARK(BM_ww_ranked_set_random_insert)->Arg(100000);
+
+// 顺序统计，查询元素的下标
+
+static void BM_ww_ranked_set_rank(benchmark::State & state)
+{
+    const int n = static_cast<int>(state.range(0));
+    wwstl::ranked_set<int> set;
+    for (int i = 0; i < n; ++i) {
+        set.insert(set.end(), i);
+    }
+    int key = 0;
+    for (auto _ : state) {
+        std::size_t r = set.rank(key);
+        benchmark::DoNotOptimize(r);
+        key = (key + 7919) % n;
+    }
+}
+BENCHMARK(BM_ww_ranked_set_rank)->Arg(100000);
+
+static void BM_std_set_rank(benchmark::State & state)
+{
+    const int n = static_cast<int>(state.range(0));
+    std::set<int> set;
+    for (int i = 0; i < n; ++i) {
+        set.insert(set.end(), i);
+    }
+    int key = 0;
+    for (auto _ : state) {
+        std::ptrdiff_t r = std::distance(set.begin(), set.lower_bound(key));
+        benchmark::DoNotOptimize(r);
+        key = (key + 7919) % n;
+    }
+}
+BENCHMARK(BM_std_set_rank)->Arg(100000);
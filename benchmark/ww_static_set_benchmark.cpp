@@ -0,0 +1,78 @@
+#include <benchmark/benchmark.h>
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+#include <ww_set.h>
+#include <ww_static_set.h>
+
+// lower_bound：range(0)个偶数键，查找[0, 2 * range(0))中的随机键，大小从L1覆盖到超出末级缓存
+
+static std::vector<int> sorted_keys(int n)
+{
+    std::vector<int> keys(n);
+    for (int i = 0; i < n; ++i) {
+        keys[i] = i * 2;
+    }
+    return keys;
+}
+
+static std::vector<int> query_keys(int n)
+{
+    std::vector<int> queries(1 << 16);
+    std::uint64_t seed = 1;
+    for (auto & query : queries) {
+        seed = seed * 6364136223846793005ull + 1442695040888963407ull;
+        query = static_cast<int>((seed >> 33) % (static_cast<std::uint64_t>(n) * 2));
+    }
+    return queries;
+}
+
+template <class Table>
+static void lower_bound_loop(benchmark::State & state, const Table & table)
+{
+    std::vector<int> queries = query_keys(static_cast<int>(state.range(0)));
+    std::size_t i = 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(table.lower_bound(queries[i]));
+        i = (i + 1) & (queries.size() - 1);
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+static void BM_ww_static_set_eytzinger_lower_bound(benchmark::State & state)
+{
+    std::vector<int> keys = sorted_keys(static_cast<int>(state.range(0)));
+    wwstl::static_set<int> table(keys.begin(), keys.end());
+    lower_bound_loop(state, table);
+}
+BENCHMARK(BM_ww_static_set_eytzinger_lower_bound)->RangeMultiplier(16)->Range(1 << 10, 1 << 26);
+
+static void BM_ww_static_set_btree_lower_bound(benchmark::State & state)
+{
+    std::vector<int> keys = sorted_keys(static_cast<int>(state.range(0)));
+    wwstl::static_set<int, std::less<int>, wwstl::btree_layout> table(keys.begin(), keys.end());
+    lower_bound_loop(state, table);
+}
+BENCHMARK(BM_ww_static_set_btree_lower_bound)->RangeMultiplier(16)->Range(1 << 10, 1 << 26);
+
+static void BM_ww_set_lower_bound(benchmark::State & state)
+{
+    std::vector<int> keys = sorted_keys(static_cast<int>(state.range(0)));
+    wwstl::set<int> table(keys.begin(), keys.end());
+    lower_bound_loop(state, table);
+}
+BENCHMARK(BM_ww_set_lower_bound)->RangeMultiplier(16)->Range(1 << 10, 1 << 22);
+
+static void BM_std_vector_lower_bound(benchmark::State & state)
+{
+    // 对照：有序数组上的二分查找
+    std::vector<int> keys = sorted_keys(static_cast<int>(state.range(0)));
+    std::vector<int> queries = query_keys(static_cast<int>(state.range(0)));
+    std::size_t i = 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(std::lower_bound(keys.begin(), keys.end(), queries[i]));
+        i = (i + 1) & (queries.size() - 1);
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_std_vector_lower_bound)->RangeMultiplier(16)->Range(1 << 10, 1 << 26);
@@ -0,0 +1,123 @@
+#include <benchmark/benchmark.h>
+#include <algorithm>
+#include <vector>
+#include <ww_map.h>
+
+// 平衡策略 × 访问分布：range(0)为元素数，键为[0, n)，先顺序插入再查找
+
+template <class Balance>
+using balance_map = wwstl::map<int, int, std::less<int>, wwstl::allocator<std::pair<const int, int>>, false, Balance>;
+
+static unsigned int next_seed(unsigned int seed)
+{
+    return seed * 1103515245 + 12345;
+}
+
+static std::vector<int> uniform_keys(int n)
+{
+    std::vector<int> keys(1 << 16);
+    unsigned int seed = 1;
+    for (auto & key : keys) {
+        seed = next_seed(seed);
+        key = static_cast<int>((seed >> 4) % n);
+    }
+    return keys;
+}
+
+static std::vector<int> zipf_keys(int n)
+{
+    // 指数为1的Zipf分布，按累积分布逆变换采样，再把排名打散到键空间
+    std::vector<double> cdf(n);
+    double sum = 0;
+    for (int i = 0; i < n; ++i) {
+        sum += 1.0 / (i + 1);
+        cdf[i] = sum;
+    }
+    std::vector<int> keys(1 << 16);
+    unsigned int seed = 1;
+    for (auto & key : keys) {
+        seed = next_seed(seed);
+        double u = (seed >> 8) / double(1 << 24) * sum;
+        int rank = static_cast<int>(std::lower_bound(cdf.begin(), cdf.end(), u) - cdf.begin());
+        key = static_cast<int>((static_cast<unsigned int>(rank) * 2654435761u) % n);
+    }
+    return keys;
+}
+
+static std::vector<int> sequential_keys(int n)
+{
+    std::vector<int> keys(1 << 16);
+    for (std::size_t i = 0; i < keys.size(); ++i) {
+        keys[i] = static_cast<int>(i % n);
+    }
+    return keys;
+}
+
+template <class Balance>
+static void find_keys(benchmark::State & state, const std::vector<int> & keys)
+{
+    const int n = static_cast<int>(state.range(0));
+    balance_map<Balance> map;
+    for (int i = 0; i < n; ++i) {
+        map.emplace(i, i);
+    }
+    std::size_t i = 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(map.find(keys[i]));
+        i = (i + 1) & (keys.size() - 1);
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+template <class Balance>
+static void BM_ww_map_balance_find_uniform(benchmark::State & state)
+{
+    find_keys<Balance>(state, uniform_keys(static_cast<int>(state.range(0))));
+}
+
+template <class Balance>
+static void BM_ww_map_balance_find_zipf(benchmark::State & state)
+{
+    find_keys<Balance>(state, zipf_keys(static_cast<int>(state.range(0))));
+}
+
+template <class Balance>
+static void BM_ww_map_balance_find_sequential(benchmark::State & state)
+{
+    find_keys<Balance>(state, sequential_keys(static_cast<int>(state.range(0))));
+}
+
+template <class Balance>
+static void BM_ww_map_balance_insert_random(benchmark::State & state)
+{
+    const int n = static_cast<int>(state.range(0));
+    std::vector<int> keys = uniform_keys(n);
+    for (auto _ : state) {
+        balance_map<Balance> map;
+        for (int i = 0; i < n; ++i) {
+            map.emplace(keys[i & (keys.size() - 1)] ^ i, i);
+        }
+        benchmark::DoNotOptimize(map.size());
+    }
+    state.SetItemsProcessed(state.iterations() * n);
+}
+
+BENCHMARK_TEMPLATE(BM_ww_map_balance_find_uniform, wwstl::red_black_balance)->Arg(1 << 20);
+BENCHMARK_TEMPLATE(BM_ww_map_balance_find_uniform, wwstl::avl_balance)->Arg(1 << 20);
+BENCHMARK_TEMPLATE(BM_ww_map_balance_find_uniform, wwstl::treap_balance)->Arg(1 << 20);
+BENCHMARK_TEMPLATE(BM_ww_map_balance_find_uniform, wwstl::splay_balance)->Arg(1 << 20);
+
+BENCHMARK_TEMPLATE(BM_ww_map_balance_find_zipf, wwstl::red_black_balance)->Arg(1 << 20);
+BENCHMARK_TEMPLATE(BM_ww_map_balance_find_zipf, wwstl::avl_balance)->Arg(1 << 20);
+BENCHMARK_TEMPLATE(BM_ww_map_balance_find_zipf, wwstl::treap_balance)->Arg(1 << 20);
+BENCHMARK_TEMPLATE(BM_ww_map_balance_find_zipf, wwstl::splay_balance)->Arg(1 << 20);
+
+BENCHMARK_TEMPLATE(BM_ww_map_balance_find_sequential, wwstl::red_black_balance)->Arg(1 << 20);
+BENCHMARK_TEMPLATE(BM_ww_map_balance_find_sequential, wwstl::avl_balance)->Arg(1 << 20);
+BENCHMARK_TEMPLATE(BM_ww_map_balance_find_sequential, wwstl::treap_balance)->Arg(1 << 20);
+BENCHMARK_TEMPLATE(BM_ww_map_balance_find_sequential, wwstl::splay_balance)->Arg(1 << 20);
+
+BENCHMARK_TEMPLATE(BM_ww_map_balance_insert_random, wwstl::red_black_balance)->Arg(1 << 16);
+BENCHMARK_TEMPLATE(BM_ww_map_balance_insert_random, wwstl::avl_balance)->Arg(1 << 16);
+BENCHMARK_TEMPLATE(BM_ww_map_balance_insert_random, wwstl::treap_balance)->Arg(1 << 16);
+BENCHMARK_TEMPLATE(BM_ww_map_balance_insert_random, wwstl::splay_balance)->Arg(1 << 16);
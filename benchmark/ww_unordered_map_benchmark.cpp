@@ -1,5 +1,12 @@
 #include <benchmark/benchmark.h>
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <random>
+#include <string>
+#include <tuple>
 #include <unordered_map>
+#include <vector>
 #include <ww_unordered_map.h>
 
 // iterator
@@ -281,3 +288,436 @@ static void BM_std_unordered_map_rehash(benchmark::State & state)
     }
 }
 BENCHMARK(BM_std_unordered_map_rehash);
+
+// 以const char*查找string键，键长度超过短字符串优化的范围
+
+template <class Map>
+static void find_by_c_str(benchmark::State & state)
+{
+    std::vector<std::string> keys;
+    for (int i = 0; i < state.range(0); ++i) {
+        keys.push_back("/service/config/entry/" + std::to_string(i * 7919));
+    }
+    Map m;
+    for (std::size_t i = 0; i < keys.size(); ++i) {
+        m.insert({keys[i], static_cast<int>(i)});
+    }
+    std::size_t i = 0;
+    for (auto _ : state) {
+        const char * key = keys[i].c_str();
+        auto it = m.find(key);
+        benchmark::DoNotOptimize(it);
+        i = i + 1 == keys.size() ? 0 : i + 1;
+    }
+}
+
+static void BM_ww_unordered_map_find_c_str(benchmark::State & state)
+{
+    find_by_c_str<wwstl::unordered_map<std::string, int>>(state);
+}
+BENCHMARK(BM_ww_unordered_map_find_c_str)->Arg(10000);
+
+static void BM_ww_unordered_map_find_c_str_transparent(benchmark::State & state)
+{
+    find_by_c_str<wwstl::unordered_map<std::string, int, wwstl::hash<std::string>, std::equal_to<>>>(state);
+}
+BENCHMARK(BM_ww_unordered_map_find_c_str_transparent)->Arg(10000);
+
+static void BM_std_unordered_map_find_c_str(benchmark::State & state)
+{
+    find_by_c_str<std::unordered_map<std::string, int>>(state);
+}
+BENCHMARK(BM_std_unordered_map_find_c_str)->Arg(10000);
+
+// string键的遍历与重建：缓存哈希值时遍历和重建都不再对键求哈希
+
+using ww_string_map_cached = wwstl::unordered_map<std::string, int>;
+using ww_string_map_uncached = wwstl::unordered_map<std::string, int, wwstl::hash<std::string>, std::equal_to<std::string>,
+                                                    wwstl::allocator<std::pair<const std::string, int>>, false>;
+
+template <class Map>
+static void fill_string_keys(Map & map, std::int64_t n)
+{
+    for (std::int64_t i = 0; i < n; ++i) {
+        map.insert({"/service/config/entry/" + std::to_string(i * 7919), static_cast<int>(i)});
+    }
+}
+
+template <class Map>
+static void BM_unordered_map_string_iterate(benchmark::State & state)
+{
+    Map map;
+    fill_string_keys(map, state.range(0));
+    for (auto _ : state) {
+        int sum = 0;
+        for (auto it = map.begin(); it != map.end(); ++it) {
+            sum += it->second;
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK_TEMPLATE(BM_unordered_map_string_iterate, ww_string_map_cached)->Arg(1 << 16);
+BENCHMARK_TEMPLATE(BM_unordered_map_string_iterate, ww_string_map_uncached)->Arg(1 << 16);
+BENCHMARK_TEMPLATE(BM_unordered_map_string_iterate, std::unordered_map<std::string, int>)->Arg(1 << 16);
+
+template <class Map>
+static void BM_unordered_map_string_rehash(benchmark::State & state)
+{
+    Map map;
+    fill_string_keys(map, state.range(0));
+    const std::size_t buckets = static_cast<std::size_t>(state.range(0)) * 2;
+    bool grow = true;
+    for (auto _ : state) {
+        // 在两个桶数之间交替，每次都真正重建
+        map.rehash(grow ? buckets * 2 : buckets);
+        grow = !grow;
+        benchmark::DoNotOptimize(map.bucket_count());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK_TEMPLATE(BM_unordered_map_string_rehash, ww_string_map_cached)->Arg(1 << 16);
+BENCHMARK_TEMPLATE(BM_unordered_map_string_rehash, ww_string_map_uncached)->Arg(1 << 16);
+BENCHMARK_TEMPLATE(BM_unordered_map_string_rehash, std::unordered_map<std::string, int>)->Arg(1 << 16);
+
+// 稀疏的表：reserve大量桶后只有少数元素，遍历和begin()的代价不应随桶数增长
+
+template <class Map>
+static void BM_unordered_map_sparse_iterate(benchmark::State & state)
+{
+    Map map;
+    map.reserve(1 << 20);
+    for (int i = 0; i < state.range(0); ++i) {
+        map.insert({i * 7919, i});
+    }
+    for (auto _ : state) {
+        int sum = 0;
+        for (auto it = map.begin(); it != map.end(); ++it) {
+            sum += it->second;
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK_TEMPLATE(BM_unordered_map_sparse_iterate, wwstl::unordered_map<int, int>)->Arg(1000);
+BENCHMARK_TEMPLATE(BM_unordered_map_sparse_iterate, std::unordered_map<int, int>)->Arg(1000);
+
+template <class Map>
+static void BM_unordered_map_sparse_erase_while_iterating(benchmark::State & state)
+{
+    Map map;
+    map.reserve(1 << 20);
+    for (auto _ : state) {
+        state.PauseTiming();
+        for (int i = 0; i < state.range(0); ++i) {
+            map.insert({i * 7919, i});
+        }
+        state.ResumeTiming();
+        // 每次都从begin()开始擦除，模拟反复取出任意一个元素的用法
+        while (!map.empty()) {
+            map.erase(map.begin());
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK_TEMPLATE(BM_unordered_map_sparse_erase_while_iterating, wwstl::unordered_map<int, int>)->Arg(1000);
+BENCHMARK_TEMPLATE(BM_unordered_map_sparse_erase_while_iterating, std::unordered_map<int, int>)->Arg(1000);
+
+// 在两个unordered_map之间来回移动元素
+
+static void BM_ww_unordered_map_transfer_by_value(benchmark::State & state)
+{
+    const int n = static_cast<int>(state.range(0));
+    wwstl::unordered_map<int, std::string> a;
+    wwstl::unordered_map<int, std::string> b;
+    for (int i = 0; i < n; ++i) {
+        a.insert(std::make_pair(i, std::string(32, 'x')));
+    }
+    wwstl::unordered_map<int, std::string> * from = &a;
+    wwstl::unordered_map<int, std::string> * to = &b;
+    int i = 0;
+    for (auto _ : state) {
+        auto it = from->find(i);
+        to->insert(std::make_pair(i, std::move(it->second)));
+        from->erase(it);
+        if (++i == n) {
+            i = 0;
+            std::swap(from, to);
+        }
+    }
+}
+BENCHMARK(BM_ww_unordered_map_transfer_by_value)->Arg(1 << 12);
+
+static void BM_ww_unordered_map_transfer_by_node(benchmark::State & state)
+{
+    const int n = static_cast<int>(state.range(0));
+    wwstl::unordered_map<int, std::string> a;
+    wwstl::unordered_map<int, std::string> b;
+    for (int i = 0; i < n; ++i) {
+        a.insert(std::make_pair(i, std::string(32, 'x')));
+    }
+    wwstl::unordered_map<int, std::string> * from = &a;
+    wwstl::unordered_map<int, std::string> * to = &b;
+    int i = 0;
+    for (auto _ : state) {
+        to->insert(from->extract(i));
+        if (++i == n) {
+            i = 0;
+            std::swap(from, to);
+        }
+    }
+}
+BENCHMARK(BM_ww_unordered_map_transfer_by_node)->Arg(1 << 12);
+
+// 更新已存在的键，统计每次操作的节点分配次数
+
+static std::size_t upsert_allocations = 0;
+
+template <class T>
+class counting_allocator
+    : public wwstl::allocator<T>
+{
+public:
+    template <class U>
+    class rebind
+    {
+    public:
+        using other = counting_allocator<U>;
+    };
+
+public:
+    counting_allocator() noexcept = default;
+
+    template <class U>
+    counting_allocator(const counting_allocator<U> &) noexcept
+    {
+    }
+
+public:
+    T * allocate(std::size_t n, const void * hint = nullptr)
+    {
+        ++upsert_allocations;
+        return wwstl::allocator<T>::allocate(n, hint);
+    }
+};
+
+template <class Map, class Upsert>
+static void upsert(benchmark::State & state, Upsert op)
+{
+    const int n = static_cast<int>(state.range(0));
+    Map map;
+    for (int i = 0; i < n; ++i) {
+        map.emplace(i, i);
+    }
+    const std::size_t before = upsert_allocations;
+    int i = 0;
+    for (auto _ : state) {
+        op(map, i);
+        if (++i == n) {
+            i = 0;
+        }
+    }
+    state.counters["allocs_per_op"] = static_cast<double>(upsert_allocations - before) / static_cast<double>(state.iterations());
+}
+
+using WW = wwstl::unordered_map<int, int, std::hash<int>, std::equal_to<int>, counting_allocator<std::pair<const int, int>>>;
+using STD = std::unordered_map<int, int, std::hash<int>, std::equal_to<int>, counting_allocator<std::pair<const int, int>>>;
+
+static void BM_ww_unordered_map_upsert_emplace(benchmark::State & state)
+{
+    // 可以直接取得键，先查找，不分配节点
+    upsert<WW>(state, [](WW & map, int i) { benchmark::DoNotOptimize(map.emplace(i, i + 1)); });
+}
+BENCHMARK(BM_ww_unordered_map_upsert_emplace)->Arg(1 << 12);
+
+static void BM_ww_unordered_map_upsert_emplace_piecewise(benchmark::State & state)
+{
+    // 无法直接取得键，先构造节点再查找
+    upsert<WW>(state, [](WW & map, int i) {
+        benchmark::DoNotOptimize(map.emplace(std::piecewise_construct, std::forward_as_tuple(i), std::forward_as_tuple(i + 1)));
+    });
+}
+BENCHMARK(BM_ww_unordered_map_upsert_emplace_piecewise)->Arg(1 << 12);
+
+static void BM_ww_unordered_map_upsert_try_emplace(benchmark::State & state)
+{
+    upsert<WW>(state, [](WW & map, int i) { benchmark::DoNotOptimize(map.try_emplace(i, i + 1)); });
+}
+BENCHMARK(BM_ww_unordered_map_upsert_try_emplace)->Arg(1 << 12);
+
+static void BM_ww_unordered_map_upsert_insert_or_assign(benchmark::State & state)
+{
+    upsert<WW>(state, [](WW & map, int i) { benchmark::DoNotOptimize(map.insert_or_assign(i, i + 1)); });
+}
+BENCHMARK(BM_ww_unordered_map_upsert_insert_or_assign)->Arg(1 << 12);
+
+static void BM_std_unordered_map_upsert_emplace(benchmark::State & state)
+{
+    upsert<STD>(state, [](STD & map, int i) { benchmark::DoNotOptimize(map.emplace(i, i + 1)); });
+}
+BENCHMARK(BM_std_unordered_map_upsert_emplace)->Arg(1 << 12);
+
+static void BM_std_unordered_map_upsert_operator_access(benchmark::State & state)
+{
+    upsert<STD>(state, [](STD & map, int i) { benchmark::DoNotOptimize(map[i] = i + 1); });
+}
+BENCHMARK(BM_std_unordered_map_upsert_operator_access)->Arg(1 << 12);
+
+// 在远大于末级缓存的表中批量查找
+
+template <class Map>
+static void batch_setup(Map & map, std::vector<std::uint64_t> & keys, std::size_t n)
+{
+    std::mt19937_64 gen(42);
+    for (std::size_t i = 0; i < n; ++i) {
+        map.emplace(gen() % (n * 2), i);
+    }
+    keys.resize(256);
+    for (auto & key : keys) {
+        key = gen() % (n * 2);
+    }
+}
+
+template <class Map>
+static void batch_find_loop(benchmark::State & state)
+{
+    Map map;
+    std::vector<std::uint64_t> keys;
+    batch_setup(map, keys, static_cast<std::size_t>(state.range(0)));
+    std::vector<typename Map::iterator> found(keys.size());
+    std::uint64_t salt = 0;
+    for (auto _ : state) {
+        // 每轮换一批键，避免重复访问同一批节点
+        for (auto & key : keys) {
+            key = (key + salt) % (static_cast<std::uint64_t>(state.range(0)) * 2);
+        }
+        salt = 7919;
+        for (std::size_t i = 0; i < keys.size(); ++i) {
+            found[i] = map.find(keys[i]);
+        }
+        benchmark::DoNotOptimize(found.data());
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(keys.size()));
+}
+
+static void BM_ww_unordered_map_find_loop_batch(benchmark::State & state)
+{
+    batch_find_loop<wwstl::unordered_map<std::uint64_t, std::size_t>>(state);
+}
+BENCHMARK(BM_ww_unordered_map_find_loop_batch)->Arg(1 << 22)->Unit(benchmark::kMicrosecond);
+
+static void BM_ww_unordered_map_find_many_batch(benchmark::State & state)
+{
+    wwstl::unordered_map<std::uint64_t, std::size_t> map;
+    std::vector<std::uint64_t> keys;
+    batch_setup(map, keys, static_cast<std::size_t>(state.range(0)));
+    std::vector<wwstl::unordered_map<std::uint64_t, std::size_t>::iterator> found(keys.size());
+    std::uint64_t salt = 0;
+    for (auto _ : state) {
+        for (auto & key : keys) {
+            key = (key + salt) % (static_cast<std::uint64_t>(state.range(0)) * 2);
+        }
+        salt = 7919;
+        map.find_many(keys.begin(), keys.end(), found.begin());
+        benchmark::DoNotOptimize(found.data());
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(keys.size()));
+}
+BENCHMARK(BM_ww_unordered_map_find_many_batch)->Arg(1 << 22)->Unit(benchmark::kMicrosecond);
+
+static void BM_std_unordered_map_find_loop_batch(benchmark::State & state)
+{
+    batch_find_loop<std::unordered_map<std::uint64_t, std::size_t>>(state);
+}
+BENCHMARK(BM_std_unordered_map_find_loop_batch)->Arg(1 << 22)->Unit(benchmark::kMicrosecond);
+
+// 插入延迟分布：逐个计时插入，整表重建出现在尾部延迟中，增量重建把它分摊到之后的插入
+
+using ww_u64_map = wwstl::unordered_map<std::uint64_t, std::uint64_t>;
+using std_u64_map = std::unordered_map<std::uint64_t, std::uint64_t>;
+
+static void set_incremental(ww_u64_map & map, bool enable)
+{
+    map.incremental_rehash(enable);
+}
+
+static void set_incremental(std_u64_map &, bool)
+{
+}
+
+template <class Map, bool Incremental>
+static void BM_unordered_map_insert_latency(benchmark::State & state)
+{
+    const std::size_t n = static_cast<std::size_t>(state.range(0));
+    std::vector<std::uint64_t> keys(n);
+    std::mt19937_64 gen(42);
+    for (auto & key : keys) {
+        key = gen();
+    }
+    std::vector<double> latency(n);
+    for (auto _ : state) {
+        Map map;
+        set_incremental(map, Incremental);
+        for (std::size_t i = 0; i < n; ++i) {
+            const auto start = std::chrono::steady_clock::now();
+            map.emplace(keys[i], i);
+            latency[i] = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+        }
+        benchmark::DoNotOptimize(map.size());
+    }
+    std::sort(latency.begin(), latency.end());
+    state.counters["p50_ns"] = latency[n / 2];
+    state.counters["p99_ns"] = latency[n - n / 100];
+    state.counters["p999_ns"] = latency[n - n / 1000];
+    state.counters["max_ns"] = latency[n - 1];
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK_TEMPLATE(BM_unordered_map_insert_latency, ww_u64_map, false)->Arg(1 << 20)->Arg(1 << 22)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_unordered_map_insert_latency, ww_u64_map, true)->Arg(1 << 20)->Arg(1 << 22)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_unordered_map_insert_latency, std_u64_map, false)->Arg(1 << 20)->Arg(1 << 22)->Unit(benchmark::kMillisecond);
+
+// 并行构造与并行重建：range(0)为元素数，range(1)为线程数，1表示逐个插入和串行重建
+
+static std::vector<std::pair<std::uint64_t, std::uint64_t>> random_pairs(std::size_t n)
+{
+    std::vector<std::pair<std::uint64_t, std::uint64_t>> values(n);
+    std::mt19937_64 gen(42);
+    for (std::size_t i = 0; i < n; ++i) {
+        values[i] = std::make_pair(gen(), i);
+    }
+    return values;
+}
+
+static void BM_unordered_map_parallel_build(benchmark::State & state)
+{
+    const auto values = random_pairs(static_cast<std::size_t>(state.range(0)));
+    const std::size_t threads = static_cast<std::size_t>(state.range(1));
+    for (auto _ : state) {
+        ww_u64_map map;
+        map.insert(values.begin(), values.end(), threads);
+        benchmark::DoNotOptimize(map.size());
+        state.PauseTiming();
+        map.clear();
+        state.ResumeTiming();
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_unordered_map_parallel_build)->ArgsProduct({{1 << 22}, {1, 2, 4, 8}})->Unit(benchmark::kMillisecond)->UseRealTime();
+
+static void BM_unordered_map_parallel_rehash(benchmark::State & state)
+{
+    const auto values = random_pairs(static_cast<std::size_t>(state.range(0)));
+    const std::size_t threads = static_cast<std::size_t>(state.range(1));
+    ww_u64_map map;
+    map.insert(values.begin(), values.end());
+    const std::size_t buckets = map.bucket_count();
+    bool grow = true;
+    for (auto _ : state) {
+        // 在两个桶数之间交替，每次都真正重建
+        map.rehash(grow ? buckets * 2 : buckets, threads);
+        grow = !grow;
+        benchmark::DoNotOptimize(map.bucket_count());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_unordered_map_parallel_rehash)->ArgsProduct({{1 << 22}, {1, 2, 4, 8}})->Unit(benchmark::kMillisecond)->UseRealTime();
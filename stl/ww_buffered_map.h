@@ -0,0 +1,527 @@
+#ifndef __WW_BUFFERED_MAP_H__
+#define __WW_BUFFERED_MAP_H__
+
+#include <algorithm>
+#include <initializer_list>
+#include <utility>
+#include "ww_flat_table.h"
+#include "ww_memory.h"
+#include "ww_vector.h"
+
+namespace wwstl
+{
+
+/**
+ * @brief buffered_map的条目
+ * @details 写入操作以条目的形式保存，_erased为true时是擦除留下的墓碑
+ */
+template <class Key, class T>
+class _buffered_entry
+{
+public:
+    std::pair<Key, T> _value;   // 键值对，墓碑的值为T()
+    bool _erased;               // 是否为墓碑
+
+public:
+    template <class... Args>
+    _buffered_entry(bool erased, Args&&... args)
+        : _value(std::forward<Args>(args)...)
+        , _erased(erased)
+    {
+    }
+};
+
+/**
+ * @brief 写优化的有序映射
+ * @details 写入先追加到一个未排序的缓冲区，缓冲区满时排序成一个有序段，再像二进制计数器一样逐层归并：
+ *          第i层至多容纳buffer_capacity << i个条目，超出时整层并入下一层。
+ *          层号越小数据越新，每个条目均摊被顺序复制O(log(n / buffer_capacity))次，
+ *          没有逐个节点的分配、查找和旋转
+ * @details insert_or_assign和erase是不读取旧值的盲写；insert和emplace需要先查找键是否存在
+ * @details 查找从新到旧依次检查缓冲区和每一层，遇到的第一个条目决定结果，复杂度O(buffer_capacity + log²n)
+ * @details 不提供迭代器，条目的位置在归并时会改变；按顺序访问使用scan和for_each
+ * @details erase需要T可以默认构造
+ */
+template <
+    class Key,
+    class T,
+    class Compare = std::less<Key>,
+    class Allocator = wwstl::allocator<std::pair<Key, T>>
+> class buffered_map
+{
+public:
+    using key_type = Key;
+    using mapped_type = T;
+    using value_type = std::pair<Key, T>;
+    using size_type = std::size_t;
+    using key_compare = Compare;
+    using allocator_type = Allocator;
+    using entry_type = _buffered_entry<Key, T>;
+    using run_type = wwstl::vector<entry_type, typename allocator_type::template rebind<entry_type>::other>;
+
+public:
+    static constexpr size_type _default_capacity = 1024;    // 默认的缓冲区容量
+
+public:
+    run_type _buffer;                   // 未排序的写缓冲区，按写入顺序排列
+    wwstl::vector<run_type> _levels;    // 按键有序且不重复的各层，层号越小越新
+    size_type _capacity;                // 缓冲区容量
+    Compare _comp;                      // 比较器
+
+public:
+    buffered_map()
+        : buffered_map(Compare())
+    {
+    }
+
+    explicit buffered_map(const Compare & comp, const Allocator & alloc = Allocator())
+        : buffered_map(_default_capacity, comp, alloc)
+    {
+    }
+
+    explicit buffered_map(size_type buffer_capacity, const Compare & comp = Compare(), const Allocator & alloc = Allocator())
+        : _buffer(alloc)
+        , _levels()
+        , _capacity(buffer_capacity == 0 ? 1 : buffer_capacity)
+        , _comp(comp)
+    {
+        _buffer.reserve(_capacity);
+    }
+
+    template <class InputIt>
+    buffered_map(InputIt first, InputIt last, const Compare & comp = Compare(), const Allocator & alloc = Allocator())
+        : buffered_map(comp, alloc)
+    {
+        insert(first, last);
+    }
+
+    buffered_map(std::initializer_list<value_type> init, const Compare & comp = Compare(), const Allocator & alloc = Allocator())
+        : buffered_map(comp, alloc)
+    {
+        insert(init.begin(), init.end());
+    }
+
+    buffered_map(const buffered_map & other) = default;
+
+    buffered_map(buffered_map && other) = default;
+
+public:
+    buffered_map & operator=(const buffered_map & other) = default;
+
+    buffered_map & operator=(buffered_map && other) = default;
+
+    /**
+     * @brief 返回关联的分配器
+     */
+    allocator_type get_allocator() const
+    {
+        return allocator_type(_buffer.get_allocator());
+    }
+
+    // 容量
+
+    /**
+     * @brief 检查容器是否为空
+     * @details 需要合并各层，复杂度O(n)
+     */
+    bool empty() const
+    {
+        return size() == 0;
+    }
+
+    /**
+     * @brief 返回元素数
+     * @details 需要合并各层，复杂度O(n)
+     */
+    size_type size() const
+    {
+        size_type count = 0;
+        for_each([&count](const value_type &) {
+            ++count;
+        });
+        return count;
+    }
+
+    /**
+     * @brief 返回缓冲区容量
+     */
+    size_type buffer_capacity() const noexcept
+    {
+        return _capacity;
+    }
+
+    // 修改器
+
+    /**
+     * @brief 清除内容
+     */
+    void clear() noexcept
+    {
+        _buffer.clear();
+        _levels.clear();
+    }
+
+    /**
+     * @brief 插入元素
+     * @return 是否插入成功，键已存在时返回false
+     */
+    bool insert(const value_type & value)
+    {
+        if (contains(value.first)) {
+            return false;
+        }
+        _append(false, value);
+        return true;
+    }
+
+    /**
+     * @brief 插入元素
+     */
+    bool insert(value_type && value)
+    {
+        if (contains(value.first)) {
+            return false;
+        }
+        _append(false, std::move(value));
+        return true;
+    }
+
+    /**
+     * @brief 插入范围内的元素
+     */
+    template <class InputIt>
+    void insert(InputIt first, InputIt last)
+    {
+        for (; first != last; ++first) {
+            insert(value_type(*first));
+        }
+    }
+
+    /**
+     * @brief 原位构造元素
+     * @return 是否插入成功，键已存在时返回false
+     */
+    template <class... Args>
+    bool emplace(Args&&... args)
+    {
+        return insert(value_type(std::forward<Args>(args)...));
+    }
+
+    /**
+     * @brief 插入元素，键已存在时赋值
+     * @details 盲写，不查找旧值，均摊复杂度O(log(n / buffer_capacity))
+     */
+    template <class M>
+    void insert_or_assign(const key_type & key, M && obj)
+    {
+        _append(false, key, std::forward<M>(obj));
+    }
+
+    /**
+     * @brief 插入元素，键已存在时赋值
+     */
+    template <class M>
+    void insert_or_assign(key_type && key, M && obj)
+    {
+        _append(false, std::move(key), std::forward<M>(obj));
+    }
+
+    /**
+     * @brief 擦除元素
+     * @details 盲写，写入一个墓碑，归并到最底层时和被它覆盖的旧条目一起丢弃
+     */
+    void erase(const key_type & key)
+    {
+        _append(true, key, T());
+    }
+
+    /**
+     * @brief 交换内容
+     */
+    void swap(buffered_map & other) noexcept
+    {
+        std::swap(_buffer, other._buffer);
+        std::swap(_levels, other._levels);
+        std::swap(_capacity, other._capacity);
+        std::swap(_comp, other._comp);
+    }
+
+    /**
+     * @brief 将缓冲区排序并归并到各层
+     */
+    void flush()
+    {
+        if (_buffer.empty()) {
+            return;
+        }
+        run_type run = _sorted_buffer();
+        _buffer.clear();
+        _push_run(std::move(run));
+    }
+
+    /**
+     * @brief 将所有层归并为一层并丢弃墓碑
+     * @details 此后查找只需要一次二分
+     */
+    void compact()
+    {
+        flush();
+        if (_levels.empty()) {
+            return;
+        }
+        run_type result(_buffer.get_allocator());
+        for (size_type i = 0; i < _levels.size(); ++i) {
+            result = _merge(result, _levels[i], i + 1 == _levels.size());
+        }
+        _levels.clear();
+        if (!result.empty()) {
+            _levels.push_back(std::move(result));
+        }
+    }
+
+    // 查找
+
+    /**
+     * @brief 返回匹配特定键的元素数量
+     */
+    size_type count(const key_type & key) const
+    {
+        return contains(key) ? 1 : 0;
+    }
+
+    /**
+     * @brief 检查容器是否含有带特定键的元素
+     */
+    bool contains(const key_type & key) const
+    {
+        const entry_type * entry = _find_entry(key);
+        return entry != nullptr && !entry->_erased;
+    }
+
+    /**
+     * @brief 寻找带有特定键的元素，找到时将值复制到value
+     * @return 是否找到
+     */
+    bool find(const key_type & key, mapped_type & value) const
+    {
+        const entry_type * entry = _find_entry(key);
+        if (entry == nullptr || entry->_erased) {
+            return false;
+        }
+        value = entry->_value.second;
+        return true;
+    }
+
+    /**
+     * @brief 按键的顺序以[first_key, last_key)中的每个元素调用f
+     */
+    template <class F>
+    void scan(const key_type & first_key, const key_type & last_key, F && f) const
+    {
+        _merge_visit(&first_key, &last_key, f);
+    }
+
+    /**
+     * @brief 按键的顺序以每个元素调用f
+     */
+    template <class F>
+    void for_each(F && f) const
+    {
+        _merge_visit(nullptr, nullptr, f);
+    }
+
+    // 观察器
+
+    /**
+     * @brief 返回用于比较键的函数
+     */
+    key_compare key_comp() const
+    {
+        return _comp;
+    }
+
+public:
+    /**
+     * @brief 追加一个条目，缓冲区满时归并
+     */
+    template <class... Args>
+    void _append(bool erased, Args&&... args)
+    {
+        _buffer.emplace_back(erased, std::forward<Args>(args)...);
+        if (_buffer.size() >= _capacity) {
+            flush();
+        }
+    }
+
+    /**
+     * @brief 返回按键排序的缓冲区副本，相同的键只保留最后写入的条目
+     */
+    run_type _sorted_buffer() const
+    {
+        run_type run(_buffer);
+        auto key_less = [this](const entry_type & lhs, const entry_type & rhs) {
+            return _comp(lhs._value.first, rhs._value.first);
+        };
+        std::stable_sort(run.begin(), run.end(), key_less);
+        auto out = run.begin();
+        for (auto it = run.begin(); it != run.end(); ++it) {
+            auto next = it + 1;
+            if (next != run.end() && !key_less(*it, *next)) {
+                continue;   // 后面还有更新的相同键
+            }
+            if (out != it) {
+                *out = std::move(*it);
+            }
+            ++out;
+        }
+        run.erase(out, run.end());
+        return run;
+    }
+
+    /**
+     * @brief 将一个有序段并入第0层，超出容量的层逐层向下归并
+     */
+    void _push_run(run_type && run)
+    {
+        if (_levels.empty()) {
+            _levels.push_back(std::move(run));
+        } else {
+            _levels[0] = _merge(run, _levels[0], _levels.size() == 1);
+        }
+        for (size_type i = 0; _levels[i].size() > (_capacity << i); ++i) {
+            if (i + 1 == _levels.size()) {
+                _levels.push_back(run_type(_buffer.get_allocator()));
+            }
+            _levels[i + 1] = _merge(_levels[i], _levels[i + 1], i + 2 == _levels.size());
+            _levels[i].clear();
+        }
+    }
+
+    /**
+     * @brief 归并两个有序段，键相同时保留较新的条目
+     * @param drop_erased 结果之下没有更旧的数据时丢弃墓碑
+     */
+    run_type _merge(run_type & newer, run_type & older, bool drop_erased) const
+    {
+        run_type result(_buffer.get_allocator());
+        result.reserve(newer.size() + older.size());
+        auto emit = [&result, drop_erased](entry_type & entry) {
+            if (!drop_erased || !entry._erased) {
+                result.push_back(std::move(entry));
+            }
+        };
+        auto a = newer.begin();
+        auto b = older.begin();
+        while (a != newer.end() && b != older.end()) {
+            if (_comp(a->_value.first, b->_value.first)) {
+                emit(*a++);
+            } else if (_comp(b->_value.first, a->_value.first)) {
+                emit(*b++);
+            } else {
+                emit(*a++);
+                ++b;
+            }
+        }
+        for (; a != newer.end(); ++a) {
+            emit(*a);
+        }
+        for (; b != older.end(); ++b) {
+            emit(*b);
+        }
+        return result;
+    }
+
+    /**
+     * @brief 从新到旧查找键的条目，可能是墓碑，不存在时返回nullptr
+     */
+    const entry_type * _find_entry(const key_type & key) const
+    {
+        for (size_type i = _buffer.size(); i-- > 0; ) {
+            const key_type & k = _buffer[i]._value.first;
+            if (!_comp(k, key) && !_comp(key, k)) {
+                return &_buffer[i];
+            }
+        }
+        auto entry_less = [this](const entry_type & entry, const key_type & k) {
+            return _comp(entry._value.first, k);
+        };
+        for (const run_type & level : _levels) {
+            auto it = _branchless_lower_bound(level.begin(), level.size(), key, entry_less);
+            if (it != level.end() && !_comp(key, it->_value.first)) {
+                return &*it;
+            }
+        }
+        return nullptr;
+    }
+
+    /**
+     * @brief 多路归并缓冲区和各层，按键的顺序以[*first_key, *last_key)中的元素调用f
+     * @details 键相同时取最新的条目，墓碑不访问；first_key或last_key为空指针时不限制
+     */
+    template <class F>
+    void _merge_visit(const key_type * first_key, const key_type * last_key, F & f) const
+    {
+        run_type buffer = _sorted_buffer();
+        wwstl::vector<const run_type *> sources;
+        sources.push_back(&buffer);
+        for (const run_type & level : _levels) {
+            sources.push_back(&level);
+        }
+        auto entry_less = [this](const entry_type & entry, const key_type & k) {
+            return _comp(entry._value.first, k);
+        };
+        wwstl::vector<const entry_type *> cur;
+        wwstl::vector<const entry_type *> last;
+        for (const run_type * source : sources) {
+            const entry_type * begin = source->data();
+            const entry_type * end = begin + source->size();
+            if (first_key != nullptr) {
+                begin = _branchless_lower_bound(begin, source->size(), *first_key, entry_less);
+            }
+            cur.push_back(begin);
+            last.push_back(end);
+        }
+        while (true) {
+            // 越新的来源越靠前，键相同时保留第一个找到的
+            const entry_type * winner = nullptr;
+            for (size_type i = 0; i < cur.size(); ++i) {
+                if (cur[i] != last[i] && (winner == nullptr || _comp(cur[i]->_value.first, winner->_value.first))) {
+                    winner = cur[i];
+                }
+            }
+            if (winner == nullptr || (last_key != nullptr && !_comp(winner->_value.first, *last_key))) {
+                return;
+            }
+            const key_type & key = winner->_value.first;
+            if (!winner->_erased) {
+                f(winner->_value);
+            }
+            for (size_type i = 0; i < cur.size(); ++i) {
+                if (cur[i] != last[i] && cur[i] != winner && !_comp(key, cur[i]->_value.first)) {
+                    ++cur[i];
+                }
+            }
+            for (size_type i = 0; i < cur.size(); ++i) {
+                if (cur[i] == winner) {
+                    ++cur[i];
+                    break;
+                }
+            }
+        }
+    }
+};
+
+template <class Key, class T, class Compare, class Allocator>
+constexpr std::size_t buffered_map<Key, T, Compare, Allocator>::_default_capacity;
+
+// 非成员函数
+
+template <class Key, class T, class Compare, class Allocator>
+void swap(buffered_map<Key, T, Compare, Allocator> & lhs, buffered_map<Key, T, Compare, Allocator> & rhs) noexcept
+{
+    lhs.swap(rhs);
+}
+
+} // namespace wwstl
+
+#endif // __WW_BUFFERED_MAP_H__
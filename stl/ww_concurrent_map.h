@@ -0,0 +1,212 @@
+#ifndef __WW_CONCURRENT_MAP_H__
+#define __WW_CONCURRENT_MAP_H__
+
+#include "ww_skip_list.h"
+#include "ww_functional.h"
+
+namespace wwstl
+{
+
+/**
+ * @brief 并发有序映射
+ * @details 基于无锁跳表，insert、emplace、erase、find、count和scan可以在多个线程中同时调用
+ * @details 不提供迭代器和返回元素引用的接口，因为元素可能随时被其他线程擦除；
+ *          find复制出值，visit、scan和for_each在安全的区间内把元素交给回调
+ * @details 元素插入后不可修改，需要修改时擦除后重新插入
+ */
+template <
+    class Key,
+    class T,
+    class Compare = std::less<Key>,
+    class Allocator = wwstl::allocator<std::pair<const Key, T>>
+> class concurrent_map
+{
+public:
+    using key_type = Key;
+    using mapped_type = T;
+    using value_type = std::pair<const Key, T>;
+    using size_type = std::size_t;
+    using key_compare = Compare;
+    using allocator_type = Allocator;
+
+public:
+    wwstl::skip_list<key_type, mapped_type, value_type, keyExtractor<value_type>, key_compare, Allocator> _list;   // 跳表
+
+public:
+    concurrent_map()
+        : concurrent_map(Compare())
+    {
+    }
+
+    explicit concurrent_map(const Compare & comp, const Allocator & alloc = Allocator())
+        : _list(comp, alloc)
+    {
+    }
+
+    template <class InputIt>
+    concurrent_map(InputIt first, InputIt last, const Compare & comp = Compare(), const Allocator & alloc = Allocator())
+        : _list(comp, alloc)
+    {
+        insert(first, last);
+    }
+
+    concurrent_map(std::initializer_list<value_type> init, const Compare & comp = Compare(), const Allocator & alloc = Allocator())
+        : _list(comp, alloc)
+    {
+        insert(init.begin(), init.end());
+    }
+
+    concurrent_map(const concurrent_map &) = delete;
+
+public:
+    concurrent_map & operator=(const concurrent_map &) = delete;
+
+    // 容量
+
+    /**
+     * @brief 检查容器是否为空
+     */
+    bool empty() const noexcept
+    {
+        return _list.empty();
+    }
+
+    /**
+     * @brief 返回元素数
+     * @details 并发修改时只是近似值
+     */
+    size_type size() const noexcept
+    {
+        return _list.size();
+    }
+
+    // 修改器
+
+    /**
+     * @brief 擦除所有元素，不能与其他操作并发
+     */
+    void clear()
+    {
+        _list.clear();
+    }
+
+    /**
+     * @brief 插入元素
+     * @return 是否插入成功，键已存在时返回false
+     */
+    bool insert(const value_type & value)
+    {
+        return _list.emplace_unique(value);
+    }
+
+    /**
+     * @brief 插入元素
+     */
+    template <class P, typename = typename std::enable_if<std::is_constructible<value_type, P &&>::value>::type>
+    bool insert(P && value)
+    {
+        return _list.emplace_unique(std::forward<P>(value));
+    }
+
+    /**
+     * @brief 插入范围内的元素
+     */
+    template <class InputIt>
+    void insert(InputIt first, InputIt last)
+    {
+        for (; first != last; ++first) {
+            _list.emplace_unique(*first);
+        }
+    }
+
+    /**
+     * @brief 原位构造元素
+     * @return 是否插入成功，键已存在时返回false
+     */
+    template <class... Args>
+    bool emplace(Args&&... args)
+    {
+        return _list.emplace_unique(std::forward<Args>(args)...);
+    }
+
+    /**
+     * @brief 擦除元素
+     * @return 擦除的元素个数
+     */
+    size_type erase(const key_type & key)
+    {
+        return _list.erase_unique(key);
+    }
+
+    // 查找
+
+    /**
+     * @brief 返回匹配特定键的元素数量
+     */
+    size_type count(const key_type & key) const
+    {
+        return _list.count(key);
+    }
+
+    /**
+     * @brief 检查容器是否含有带特定键的元素
+     */
+    bool contains(const key_type & key) const
+    {
+        return _list.count(key) != 0;
+    }
+
+    /**
+     * @brief 寻找带有特定键的元素，找到时将值复制到value
+     * @return 是否找到
+     */
+    bool find(const key_type & key, mapped_type & value) const
+    {
+        return _list.visit(key, [&value](const value_type & v) {
+            value = v.second;
+        });
+    }
+
+    /**
+     * @brief 寻找带有特定键的元素，找到时以元素调用f
+     * @details f返回前元素不会被释放
+     */
+    template <class F>
+    bool visit(const key_type & key, F && f) const
+    {
+        return _list.visit(key, std::forward<F>(f));
+    }
+
+    /**
+     * @brief 按键的顺序以[first_key, last_key)中的每个元素调用f
+     * @details 弱一致，扫描期间并发插入或擦除的元素可能被访问到，也可能访问不到
+     */
+    template <class F>
+    void scan(const key_type & first_key, const key_type & last_key, F && f) const
+    {
+        _list.scan(first_key, last_key, std::forward<F>(f));
+    }
+
+    /**
+     * @brief 按键的顺序以每个元素调用f
+     */
+    template <class F>
+    void for_each(F && f) const
+    {
+        _list.for_each(std::forward<F>(f));
+    }
+
+    // 观察器
+
+    /**
+     * @brief 返回用于比较键的函数
+     */
+    key_compare key_comp() const
+    {
+        return _list.key_comp();
+    }
+};
+
+} // namespace wwstl
+
+#endif // __WW_CONCURRENT_MAP_H__
@@ -0,0 +1,194 @@
+#ifndef __WW_CONCURRENT_SET_H__
+#define __WW_CONCURRENT_SET_H__
+
+#include "ww_skip_list.h"
+#include "ww_functional.h"
+
+namespace wwstl
+{
+
+/**
+ * @brief 并发有序集合
+ * @details 基于无锁跳表，insert、emplace、erase、count和scan可以在多个线程中同时调用
+ * @details 不提供迭代器，scan和for_each在安全的区间内把元素交给回调
+ */
+template <
+    class Key,
+    class Compare = std::less<Key>,
+    class Allocator = wwstl::allocator<Key>
+> class concurrent_set
+{
+public:
+    using key_type = Key;
+    using value_type = Key;
+    using size_type = std::size_t;
+    using key_compare = Compare;
+    using value_compare = Compare;
+    using allocator_type = Allocator;
+
+public:
+    wwstl::skip_list<key_type, void, value_type, keyExtractor<value_type>, key_compare, Allocator> _list;  // 跳表
+
+public:
+    concurrent_set()
+        : concurrent_set(Compare())
+    {
+    }
+
+    explicit concurrent_set(const Compare & comp, const Allocator & alloc = Allocator())
+        : _list(comp, alloc)
+    {
+    }
+
+    template <class InputIt>
+    concurrent_set(InputIt first, InputIt last, const Compare & comp = Compare(), const Allocator & alloc = Allocator())
+        : _list(comp, alloc)
+    {
+        insert(first, last);
+    }
+
+    concurrent_set(std::initializer_list<value_type> init, const Compare & comp = Compare(), const Allocator & alloc = Allocator())
+        : _list(comp, alloc)
+    {
+        insert(init.begin(), init.end());
+    }
+
+    concurrent_set(const concurrent_set &) = delete;
+
+public:
+    concurrent_set & operator=(const concurrent_set &) = delete;
+
+    // 容量
+
+    /**
+     * @brief 检查容器是否为空
+     */
+    bool empty() const noexcept
+    {
+        return _list.empty();
+    }
+
+    /**
+     * @brief 返回元素数
+     * @details 并发修改时只是近似值
+     */
+    size_type size() const noexcept
+    {
+        return _list.size();
+    }
+
+    // 修改器
+
+    /**
+     * @brief 擦除所有元素，不能与其他操作并发
+     */
+    void clear()
+    {
+        _list.clear();
+    }
+
+    /**
+     * @brief 插入元素
+     * @return 是否插入成功，元素已存在时返回false
+     */
+    bool insert(const value_type & value)
+    {
+        return _list.emplace_unique(value);
+    }
+
+    /**
+     * @brief 插入元素
+     */
+    bool insert(value_type && value)
+    {
+        return _list.emplace_unique(std::move(value));
+    }
+
+    /**
+     * @brief 插入范围内的元素
+     */
+    template <class InputIt>
+    void insert(InputIt first, InputIt last)
+    {
+        for (; first != last; ++first) {
+            _list.emplace_unique(*first);
+        }
+    }
+
+    /**
+     * @brief 原位构造元素
+     */
+    template <class... Args>
+    bool emplace(Args&&... args)
+    {
+        return _list.emplace_unique(std::forward<Args>(args)...);
+    }
+
+    /**
+     * @brief 擦除元素
+     * @return 擦除的元素个数
+     */
+    size_type erase(const key_type & key)
+    {
+        return _list.erase_unique(key);
+    }
+
+    // 查找
+
+    /**
+     * @brief 返回匹配特定键的元素数量
+     */
+    size_type count(const key_type & key) const
+    {
+        return _list.count(key);
+    }
+
+    /**
+     * @brief 检查容器是否含有特定元素
+     */
+    bool contains(const key_type & key) const
+    {
+        return _list.count(key) != 0;
+    }
+
+    /**
+     * @brief 按顺序以[first_key, last_key)中的每个元素调用f
+     * @details 弱一致，扫描期间并发插入或擦除的元素可能被访问到，也可能访问不到
+     */
+    template <class F>
+    void scan(const key_type & first_key, const key_type & last_key, F && f) const
+    {
+        _list.scan(first_key, last_key, std::forward<F>(f));
+    }
+
+    /**
+     * @brief 按顺序以每个元素调用f
+     */
+    template <class F>
+    void for_each(F && f) const
+    {
+        _list.for_each(std::forward<F>(f));
+    }
+
+    // 观察器
+
+    /**
+     * @brief 返回用于比较键的函数
+     */
+    key_compare key_comp() const
+    {
+        return _list.key_comp();
+    }
+
+    /**
+     * @brief 返回用于比较值的函数
+     */
+    value_compare value_comp() const
+    {
+        return _list.key_comp();
+    }
+};
+
+} // namespace wwstl
+
+#endif // __WW_CONCURRENT_SET_H__
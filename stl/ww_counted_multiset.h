@@ -0,0 +1,490 @@
+#ifndef __WW_COUNTED_MULTISET_H__
+#define __WW_COUNTED_MULTISET_H__
+
+#include <algorithm>
+#include <initializer_list>
+#include <type_traits>
+#include "ww_rb_tree.h"
+
+namespace wwstl
+{
+
+/**
+ * @brief counted_multiset迭代器
+ * @details 指向树中的一个(键, 个数)节点和其中的第_index个副本，遍历时每个键重复个数次
+ */
+template <class TreeIter>
+class _counted_multiset_iterator
+{
+public:
+    using iterator_category = std::bidirectional_iterator_tag;
+    using value_type = typename std::remove_const<typename TreeIter::value_type::first_type>::type;
+    using difference_type = std::ptrdiff_t;
+    using pointer = const value_type *;
+    using reference = const value_type &;
+    using size_type = std::size_t;
+
+    using self = _counted_multiset_iterator<TreeIter>;
+
+public:
+    TreeIter _it;           // 所在的节点
+    size_type _index;       // 节点中的第几个副本
+
+public:
+    _counted_multiset_iterator()
+        : _it()
+        , _index(0)
+    { // 空迭代器
+    }
+
+    _counted_multiset_iterator(TreeIter it, size_type index)
+        : _it(it)
+        , _index(index)
+    {
+    }
+
+public:
+    reference operator*() const
+    {
+        return _it->first;
+    }
+
+    pointer operator->() const
+    {
+        return &_it->first;
+    }
+
+    self & operator++()
+    {
+        if (++_index == _it->second) {
+            ++_it;
+            _index = 0;
+        }
+        return *this;
+    }
+
+    self operator++(int)
+    {
+        self tmp = *this;
+        ++*this;
+        return tmp;
+    }
+
+    self & operator--()
+    {
+        if (_index == 0) {
+            --_it;
+            _index = _it->second - 1;
+        } else {
+            --_index;
+        }
+        return *this;
+    }
+
+    self operator--(int)
+    {
+        self tmp = *this;
+        --*this;
+        return tmp;
+    }
+
+    bool operator==(const self & other) const
+    {
+        return _it == other._it && _index == other._index;
+    }
+
+    bool operator!=(const self & other) const
+    {
+        return !(*this == other);
+    }
+};
+
+/**
+ * @brief 计数存储的多重集合
+ * @details 每个不同的键只存一个节点并记录副本个数，大量重复时节点数只与不同键的个数有关，
+ *          count和按键擦除为O(log n)，n为不同键的个数
+ * @details 遍历时每个键重复出现个数次，与multiset相同；
+ *          等价的副本共用第一次插入的键，只适合等价即相同的键
+ */
+template <
+    class Key,
+    class Compare = std::less<Key>,
+    class Allocator = wwstl::allocator<Key>
+> class counted_multiset
+{
+public:
+    using key_type = Key;
+    using value_type = Key;
+    using size_type = std::size_t;
+    using difference_type = std::ptrdiff_t;
+    using key_compare = Compare;
+    using value_compare = Compare;
+    using allocator_type = Allocator;
+    using reference = const value_type &;
+    using const_reference = const value_type &;
+    using node_value_type = std::pair<const Key, size_type>;
+    using tree_type = wwstl::rb_tree<key_type, size_type, node_value_type, keyExtractor<node_value_type>, key_compare,
+                                     typename Allocator::template rebind<node_value_type>::other>;
+    using iterator = _counted_multiset_iterator<typename tree_type::const_iterator>;
+    using const_iterator = iterator;
+    using reverse_iterator = typename wwstl::reverse_iterator<iterator>;
+    using const_reverse_iterator = typename wwstl::reverse_iterator<const_iterator>;
+
+public:
+    tree_type _tree;        // 键到副本个数的红黑树
+    size_type _size;        // 副本总数
+
+public:
+    counted_multiset()
+        : counted_multiset(Compare())
+    {
+    }
+
+    explicit counted_multiset(const Compare & comp, const Allocator & alloc = Allocator())
+        : _tree(comp, typename tree_type::allocator_type(alloc))
+        , _size(0)
+    {
+    }
+
+    template <class InputIt>
+    counted_multiset(InputIt first, InputIt last, const Compare & comp = Compare(), const Allocator & alloc = Allocator())
+        : counted_multiset(comp, alloc)
+    {
+        insert(first, last);
+    }
+
+    counted_multiset(const counted_multiset & other)
+        : _tree(other._tree)
+        , _size(other._size)
+    {
+    }
+
+    counted_multiset(counted_multiset && other)
+        : _tree(std::move(other._tree))
+        , _size(other._size)
+    {
+        other._size = 0;
+    }
+
+    counted_multiset(std::initializer_list<value_type> init, const Compare & comp = Compare(), const Allocator & alloc = Allocator())
+        : counted_multiset(comp, alloc)
+    {
+        insert(init);
+    }
+
+public:
+    /**
+     * @brief 将值赋给容器
+     */
+    counted_multiset & operator=(const counted_multiset & other)
+    {
+        if (this != &other) {
+            _tree = other._tree;
+            _size = other._size;
+        }
+        return *this;
+    }
+
+    /**
+     * @brief 将值赋给容器
+     */
+    counted_multiset & operator=(counted_multiset && other)
+    {
+        if (this != &other) {
+            _tree = std::move(other._tree);
+            _size = other._size;
+            other._size = 0;
+        }
+        return *this;
+    }
+
+    // 迭代器
+
+    /**
+     * @brief 返回指向起始的迭代器
+     */
+    iterator begin() const noexcept
+    {
+        return iterator(_tree.begin(), 0);
+    }
+
+    /**
+     * @brief 返回指向末尾的迭代器
+     */
+    iterator end() const noexcept
+    {
+        return iterator(_tree.end(), 0);
+    }
+
+    /**
+     * @brief 返回指向起始的逆向迭代器
+     */
+    reverse_iterator rbegin() const noexcept
+    {
+        return reverse_iterator(end());
+    }
+
+    /**
+     * @brief 返回指向末尾的逆向迭代器
+     */
+    reverse_iterator rend() const noexcept
+    {
+        return reverse_iterator(begin());
+    }
+
+    // 容量
+
+    /**
+     * @brief 检查容器是否为空
+     */
+    bool empty() const noexcept
+    {
+        return _size == 0;
+    }
+
+    /**
+     * @brief 返回元素数，每个副本都计算在内
+     */
+    size_type size() const noexcept
+    {
+        return _size;
+    }
+
+    /**
+     * @brief 返回不同键的个数，即树的节点数
+     */
+    size_type distinct_size() const noexcept
+    {
+        return _tree.size();
+    }
+
+    // 修改器
+
+    /**
+     * @brief 清除内容
+     */
+    void clear() noexcept
+    {
+        _tree.clear();
+        _size = 0;
+    }
+
+    /**
+     * @brief 插入元素
+     * @return 指向新副本的迭代器，位于相同键的最后
+     */
+    iterator insert(const value_type & value)
+    {
+        return insert(value, 1);
+    }
+
+    /**
+     * @brief 插入count个副本
+     * @details 复杂度O(log n)，与count无关；count为0时不插入，返回lower_bound(value)
+     */
+    iterator insert(const value_type & value, size_type count)
+    {
+        if (count == 0) {
+            return lower_bound(value);
+        }
+        auto it = _tree.try_emplace_unique(value, 0).first;
+        it->second += count;
+        _size += count;
+        return iterator(it, it->second - 1);
+    }
+
+    /**
+     * @brief 插入范围内的元素
+     */
+    template <
+        class InputIt,
+        class = typename std::enable_if<wwstl::is_iterator<InputIt>::value>::type
+    > void insert(InputIt first, InputIt last)
+    {
+        for (; first != last; ++first) {
+            insert(*first);
+        }
+    }
+
+    /**
+     * @brief 插入初始化列表中的元素
+     */
+    void insert(std::initializer_list<value_type> ilist)
+    {
+        insert(ilist.begin(), ilist.end());
+    }
+
+    /**
+     * @brief 原位构造元素
+     */
+    template <class... Args>
+    iterator emplace(Args&&... args)
+    {
+        return insert(value_type(std::forward<Args>(args)...));
+    }
+
+    /**
+     * @brief 擦除pos指向的一个副本
+     * @return 指向下一个元素的迭代器
+     */
+    iterator erase(const_iterator pos)
+    {
+        auto it = _mutable(pos._it);
+        --_size;
+        if (--it->second == 0) {
+            return iterator(_tree.erase(pos._it), 0);
+        }
+        // 副本没有区别，后面的副本前移一位
+        return pos._index == it->second ? iterator(++pos._it, 0) : pos;
+    }
+
+    /**
+     * @brief 擦除[first, last)中的副本
+     */
+    iterator erase(const_iterator first, const_iterator last)
+    {
+        if (first._it == last._it) {
+            // 同一个节点中的一段副本
+            for (size_type n = last._index - first._index; n > 0; --n) {
+                first = erase(first);
+            }
+            return first;
+        }
+        if (first._index != 0) {
+            // 第一个节点只擦除尾部的副本
+            auto it = _mutable(first._it);
+            _size -= it->second - first._index;
+            it->second = first._index;
+            first = iterator(++first._it, 0);
+        }
+        while (first._it != last._it) {
+            _size -= first._it->second;
+            first = iterator(_tree.erase(first._it), 0);
+        }
+        for (size_type n = last._index; n > 0; --n) {
+            first = erase(first);
+        }
+        return first;
+    }
+
+    /**
+     * @brief 擦除与key等价的所有副本
+     * @return 擦除的副本个数，复杂度O(log n)
+     */
+    size_type erase(const key_type & key)
+    {
+        auto it = _tree.find(key);
+        if (it == _tree.end()) {
+            return 0;
+        }
+        size_type count = it->second;
+        _tree.erase(it);
+        _size -= count;
+        return count;
+    }
+
+    /**
+     * @brief 交换内容
+     */
+    void swap(counted_multiset & other) noexcept
+    {
+        _tree.swap(other._tree);
+        std::swap(_size, other._size);
+    }
+
+    // 查找
+
+    /**
+     * @brief 返回匹配特定键的元素数量
+     * @details 复杂度O(log n)，与副本个数无关
+     */
+    size_type count(const key_type & key) const
+    {
+        auto it = _tree.find(key);
+        return it == _tree.end() ? 0 : it->second;
+    }
+
+    /**
+     * @brief 寻找带有特定键的元素，返回第一个副本
+     */
+    iterator find(const key_type & key) const
+    {
+        return iterator(_tree.find(key), 0);
+    }
+
+    /**
+     * @brief 返回匹配特定键的元素范围
+     */
+    std::pair<iterator, iterator> equal_range(const key_type & key) const
+    {
+        return std::pair<iterator, iterator>(lower_bound(key), upper_bound(key));
+    }
+
+    /**
+     * @brief 返回指向首个不小于给定键的元素的迭代器
+     */
+    iterator lower_bound(const key_type & key) const
+    {
+        return iterator(_tree.lower_bound(key), 0);
+    }
+
+    /**
+     * @brief 返回指向首个大于给定键的元素的迭代器
+     */
+    iterator upper_bound(const key_type & key) const
+    {
+        return iterator(_tree.upper_bound(key), 0);
+    }
+
+    // 观察器
+
+    /**
+     * @brief 返回用于比较键的函数
+     */
+    key_compare key_comp() const
+    {
+        return _tree._comp;
+    }
+
+    /**
+     * @brief 返回用于比较值的函数
+     */
+    value_compare value_comp() const
+    {
+        return _tree._comp;
+    }
+
+public:
+    /**
+     * @brief 将树的常量迭代器转换为可以修改个数的迭代器
+     */
+    static typename tree_type::iterator _mutable(typename tree_type::const_iterator it)
+    {
+        return typename tree_type::iterator(it._node);
+    }
+};
+
+// 非成员函数
+
+template <class Key, class Compare, class Allocator>
+bool operator==(const counted_multiset<Key, Compare, Allocator> & lhs, const counted_multiset<Key, Compare, Allocator> & rhs)
+{
+    return lhs.size() == rhs.size() && lhs.distinct_size() == rhs.distinct_size()
+        && std::equal(lhs._tree.begin(), lhs._tree.end(), rhs._tree.begin());
+}
+
+template <class Key, class Compare, class Allocator>
+bool operator!=(const counted_multiset<Key, Compare, Allocator> & lhs, const counted_multiset<Key, Compare, Allocator> & rhs)
+{
+    return !(lhs == rhs);
+}
+
+template <class Key, class Compare, class Allocator>
+void swap(counted_multiset<Key, Compare, Allocator> & lhs, counted_multiset<Key, Compare, Allocator> & rhs) noexcept
+{
+    lhs.swap(rhs);
+}
+
+} // namespace wwstl
+
+#endif // __WW_COUNTED_MULTISET_H__
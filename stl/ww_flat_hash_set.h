@@ -0,0 +1,518 @@
+#ifndef __WW_FLAT_HASH_SET_H__
+#define __WW_FLAT_HASH_SET_H__
+
+#include "ww_flat_hash_table.h"
+
+namespace wwstl
+{
+
+/**
+ * @brief 开放寻址的无序集合
+ * @details 接口与unordered_set相同，但不提供桶接口和节点句柄，bucket_count()返回槽数
+ * @details Storage为flat_storage（默认）时元素存放在槽中，为node_storage时元素单独分配，扩容时地址不变
+ */
+template <
+    class Key,
+    class Hash = wwstl::hash<Key>,
+    class KeyEqual = std::equal_to<Key>,
+    class Allocator = wwstl::allocator<Key>,
+    class Storage = flat_storage
+> class flat_hash_set
+{
+public:
+    using key_type = Key;
+    using value_type = Key;
+    using size_type = std::size_t;
+    using difference_type = std::ptrdiff_t;
+    using hasher = Hash;
+    using key_equal = KeyEqual;
+    using allocator_type = Allocator;
+    using storage_type = Storage;
+    using reference = value_type&;
+    using const_reference = const value_type&;
+    using pointer = value_type*;
+    using const_pointer = const value_type*;
+    using table_type = wwstl::flat_hash_table<key_type, void, value_type, hasher, key_equal, wwstl::keyExtractor<value_type>, allocator_type, storage_type>;
+    using iterator = typename table_type::iterator;
+    using const_iterator = typename table_type::const_iterator;
+
+public:
+    table_type _ht;     // 哈希表
+
+public:
+    flat_hash_set()
+        : _ht()
+    {
+    }
+
+    explicit flat_hash_set(size_type bucket_count, const hasher & hash = hasher(), const key_equal & equals = key_equal(), const allocator_type & alloc = allocator_type())
+        : _ht(bucket_count, hash, equals, alloc)
+    {
+    }
+
+    explicit flat_hash_set(const allocator_type & alloc)
+        : _ht(alloc)
+    {
+    }
+
+    template <class InputIt>
+    flat_hash_set(InputIt first, InputIt last, size_type bucket_count = 0, const hasher & hash = hasher(), const key_equal & equals = key_equal(), const allocator_type & alloc = allocator_type())
+        : _ht(bucket_count, hash, equals, alloc)
+    {
+        insert(first, last);
+    }
+
+    flat_hash_set(const flat_hash_set & other)
+        : _ht(other._ht)
+    {
+    }
+
+    flat_hash_set(const flat_hash_set & other, const allocator_type & alloc)
+        : _ht(other._ht, alloc)
+    {
+    }
+
+    flat_hash_set(flat_hash_set && other)
+        : _ht(std::move(other._ht))
+    {
+    }
+
+    flat_hash_set(flat_hash_set && other, const allocator_type & alloc)
+        : _ht(std::move(other._ht), alloc)
+    {
+    }
+
+    flat_hash_set(std::initializer_list<value_type> ilist, size_type bucket_count = 0, const hasher & hash = hasher(), const key_equal & equals = key_equal(), const allocator_type & alloc = allocator_type())
+        : _ht(bucket_count, hash, equals, alloc)
+    {
+        insert(ilist);
+    }
+
+    ~flat_hash_set() = default;
+
+public:
+    /**
+     * @brief 将值赋给容器
+     */
+    flat_hash_set & operator=(const flat_hash_set & other)
+    {
+        _ht = other._ht;
+        return *this;
+    }
+
+    /**
+     * @brief 将值赋给容器
+     */
+    flat_hash_set & operator=(flat_hash_set && other)
+    {
+        _ht = std::move(other._ht);
+        return *this;
+    }
+
+    /**
+     * @brief 将值赋给容器
+     */
+    flat_hash_set & operator=(std::initializer_list<value_type> ilist)
+    {
+        clear();
+        insert(ilist);
+        return *this;
+    }
+
+    /**
+     * @brief 返回关联的分配器
+     */
+    allocator_type get_allocator() const noexcept
+    {
+        return _ht.get_allocator();
+    }
+
+    // 迭代器
+
+    /**
+     * @brief 返回指向起始的迭代器
+     */
+    iterator begin() noexcept
+    {
+        return _ht.begin();
+    }
+
+    /**
+     * @brief 返回指向起始的迭代器
+     */
+    const_iterator begin() const noexcept
+    {
+        return _ht.begin();
+    }
+
+    /**
+     * @brief 返回指向起始的迭代器
+     */
+    const_iterator cbegin() const noexcept
+    {
+        return _ht.begin();
+    }
+
+    /**
+     * @brief 返回指向末尾的迭代器
+     */
+    iterator end() noexcept
+    {
+        return _ht.end();
+    }
+
+    /**
+     * @brief 返回指向末尾的迭代器
+     */
+    const_iterator end() const noexcept
+    {
+        return _ht.end();
+    }
+
+    /**
+     * @brief 返回指向末尾的迭代器
+     */
+    const_iterator cend() const noexcept
+    {
+        return _ht.end();
+    }
+
+    // 容量
+
+    /**
+     * @brief 检查容器是否为空
+     */
+    bool empty() const noexcept
+    {
+        return _ht.empty();
+    }
+
+    /**
+     * @brief 返回元素数
+     */
+    size_type size() const noexcept
+    {
+        return _ht.size();
+    }
+
+    /**
+     * @brief 返回可容纳的最大元素数
+     */
+    size_type max_size() const noexcept
+    {
+        return _ht.max_size();
+    }
+
+    // 修改器
+
+    /**
+     * @brief 清除元素，保留槽
+     */
+    void clear() noexcept
+    {
+        _ht.clear();
+    }
+
+    /**
+     * @brief 插入元素
+     */
+    std::pair<iterator, bool> insert(const value_type & value)
+    {
+        return _ht.emplace_unique(value);
+    }
+
+    /**
+     * @brief 插入元素
+     */
+    std::pair<iterator, bool> insert(value_type && value)
+    {
+        return _ht.emplace_unique(std::move(value));
+    }
+
+    /**
+     * @brief 插入元素，忽略hint
+     */
+    iterator insert(const_iterator, const value_type & value)
+    {
+        return _ht.emplace_unique(value).first;
+    }
+
+    /**
+     * @brief 插入元素，忽略hint
+     */
+    iterator insert(const_iterator, value_type && value)
+    {
+        return _ht.emplace_unique(std::move(value)).first;
+    }
+
+    /**
+     * @brief 插入元素
+     */
+    template <class InputIt>
+    void insert(InputIt first, InputIt last)
+    {
+        for (; first != last; ++first) {
+            _ht.emplace_unique(*first);
+        }
+    }
+
+    /**
+     * @brief 插入元素
+     */
+    void insert(std::initializer_list<value_type> ilist)
+    {
+        insert(ilist.begin(), ilist.end());
+    }
+
+    /**
+     * @brief 原位构造元素
+     */
+    template <class... Args>
+    std::pair<iterator, bool> emplace(Args&&... args)
+    {
+        return _ht.emplace_unique(std::forward<Args>(args)...);
+    }
+
+    /**
+     * @brief 使用提示原位构造元素，忽略hint
+     */
+    template <class... Args>
+    iterator emplace_hint(const_iterator, Args&&... args)
+    {
+        return _ht.emplace_unique(std::forward<Args>(args)...).first;
+    }
+
+    /**
+     * @brief 擦除元素
+     */
+    iterator erase(const_iterator pos)
+    {
+        return _ht.erase(pos);
+    }
+
+    /**
+     * @brief 擦除元素
+     */
+    iterator erase(const_iterator first, const_iterator last)
+    {
+        return _ht.erase(first, last);
+    }
+
+    /**
+     * @brief 擦除元素
+     */
+    size_type erase(const key_type & key)
+    {
+        return _ht.erase(key);
+    }
+
+    /**
+     * @brief 交换内容
+     */
+    void swap(flat_hash_set & other) noexcept
+    {
+        _ht.swap(other._ht);
+    }
+
+    // 查找
+
+    /**
+     * @brief 返回匹配特定键的元素数量
+     */
+    size_type count(const key_type & key) const
+    {
+        return find(key) == end() ? 0 : 1;
+    }
+
+    /**
+     * @brief 返回匹配特定键的元素数量
+     * @details 异构查找，要求哈希函数和键比较函数都定义is_transparent
+     */
+    template <class K, class H = hasher, class E = key_equal, class = typename H::is_transparent, class = typename E::is_transparent>
+    size_type count(const K & key) const
+    {
+        return find(key) == end() ? 0 : 1;
+    }
+
+    /**
+     * @brief 寻找带有特定键的元素
+     */
+    iterator find(const key_type & key)
+    {
+        return _ht.find(key);
+    }
+
+    /**
+     * @brief 寻找带有特定键的元素
+     */
+    const_iterator find(const key_type & key) const
+    {
+        return _ht.find(key);
+    }
+
+    /**
+     * @brief 寻找带有特定键的元素
+     * @details 异构查找，要求哈希函数和键比较函数都定义is_transparent
+     */
+    template <class K, class H = hasher, class E = key_equal, class = typename H::is_transparent, class = typename E::is_transparent>
+    iterator find(const K & key)
+    {
+        return _ht.find(key);
+    }
+
+    /**
+     * @brief 寻找带有特定键的元素
+     * @details 异构查找，要求哈希函数和键比较函数都定义is_transparent
+     */
+    template <class K, class H = hasher, class E = key_equal, class = typename H::is_transparent, class = typename E::is_transparent>
+    const_iterator find(const K & key) const
+    {
+        return _ht.find(key);
+    }
+
+    /**
+     * @brief 返回匹配特定键的元素范围
+     */
+    std::pair<iterator, iterator> equal_range(const key_type & key)
+    {
+        iterator it = find(key);
+        return std::make_pair(it, it == end() ? it : std::next(it));
+    }
+
+    /**
+     * @brief 返回匹配特定键的元素范围
+     */
+    std::pair<const_iterator, const_iterator> equal_range(const key_type & key) const
+    {
+        const_iterator it = find(key);
+        return std::make_pair(it, it == end() ? it : std::next(it));
+    }
+
+    // 散列策略
+
+    /**
+     * @brief 返回槽数
+     */
+    size_type bucket_count() const
+    {
+        return _ht.bucket_count();
+    }
+
+    /**
+     * @brief 返回负载因子
+     */
+    float load_factor() const
+    {
+        return _ht.load_factor();
+    }
+
+    /**
+     * @brief 返回最大负载因子，固定为7/8
+     */
+    float max_load_factor() const
+    {
+        return _ht.max_load_factor();
+    }
+
+    /**
+     * @brief 设置最大负载因子
+     * @details 负载因子由探测方式决定，设置被忽略
+     */
+    void max_load_factor(float)
+    {
+    }
+
+    /**
+     * @brief 预留至少count个槽并重新生成散列表
+     */
+    void rehash(size_type count)
+    {
+        _ht.rehash(count);
+    }
+
+    /**
+     * @brief 为至少count个元素预留空间
+     */
+    void reserve(size_type count)
+    {
+        _ht.reserve(count);
+    }
+
+    // 观察器
+
+    /**
+     * @brief 返回用于对键求散列的函数
+     */
+    hasher hash_function() const
+    {
+        return _ht.hash_function();
+    }
+
+    /**
+     * @brief 返回用于比较键的相等性的函数
+     */
+    key_equal key_eq() const
+    {
+        return _ht.key_eq();
+    }
+};
+
+/**
+ * @brief 元素单独分配的flat_hash_set，扩容时元素地址不变
+ */
+template <
+    class Key,
+    class Hash = wwstl::hash<Key>,
+    class KeyEqual = std::equal_to<Key>,
+    class Allocator = wwstl::allocator<Key>
+> using node_hash_set = flat_hash_set<Key, Hash, KeyEqual, Allocator, node_storage>;
+
+// 非成员函数
+
+template <
+    class Key,
+    class Hash,
+    class KeyEqual,
+    class Allocator,
+    class Storage
+> bool operator==(const flat_hash_set<Key, Hash, KeyEqual, Allocator, Storage> & lhs,
+                  const flat_hash_set<Key, Hash, KeyEqual, Allocator, Storage> & rhs)
+{
+    if (lhs.size() != rhs.size())
+        return false;
+
+    for (auto it = lhs.begin(); it != lhs.end(); ++it) {
+        if (rhs.find(*it) == rhs.end())
+            return false;
+    }
+
+    return true;
+}
+
+template <
+    class Key,
+    class Hash,
+    class KeyEqual,
+    class Allocator,
+    class Storage
+> bool operator!=(const flat_hash_set<Key, Hash, KeyEqual, Allocator, Storage> & lhs,
+                  const flat_hash_set<Key, Hash, KeyEqual, Allocator, Storage> & rhs)
+{
+    return !(lhs == rhs);
+}
+
+template <
+    class Key,
+    class Hash,
+    class KeyEqual,
+    class Allocator,
+    class Storage
+> void swap(flat_hash_set<Key, Hash, KeyEqual, Allocator, Storage> & lhs,
+            flat_hash_set<Key, Hash, KeyEqual, Allocator, Storage> & rhs)
+{
+    lhs.swap(rhs);
+}
+
+} // namespace wwstl
+
+#endif // __WW_FLAT_HASH_SET_H__
@@ -0,0 +1,1133 @@
+#ifndef __WW_FLAT_HASH_TABLE_H__
+#define __WW_FLAT_HASH_TABLE_H__
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <tuple>
+#include "ww_functional.h"
+#include "ww_hash.h"
+#include "ww_memory.h"
+#include "ww_type_traits.h"
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define WW_FLAT_HASH_SSE2 1
+#endif
+
+namespace wwstl
+{
+
+/**
+ * 开放寻址哈希表（Swiss table）
+ *
+ * 元素直接存放在槽数组中，另有一个与槽一一对应的控制字节数组：
+ *   _ctrl_empty      空槽，查找遇到它即可停止
+ *   _ctrl_deleted    删除留下的墓碑，查找需要越过它继续
+ *   _ctrl_sentinel   位于_ctrl[capacity]，遍历在此停止
+ *   0 ~ 127          满槽，保存哈希值的低7位(h2)
+ * 哈希值的其余位(h1)决定探测的起点，每次取16个控制字节为一组，
+ * 一条SSE2指令比较出组内h2相同的槽，只有这些槽才需要比较键，通常一次缓存缺失即可命中
+ *
+ * 容量总是2 ^ k - 1，控制字节数组在哨兵之后重复前15个字节，从任意位置读取一组都不越界
+ */
+
+using _ctrl_t = signed char;
+
+constexpr _ctrl_t _ctrl_empty = -128;
+constexpr _ctrl_t _ctrl_deleted = -2;
+constexpr _ctrl_t _ctrl_sentinel = -1;
+
+/**
+ * @brief 返回非0的mask的二进制末尾0的个数
+ */
+inline std::size_t _ctrl_trailing_zeros(std::uint32_t mask) noexcept
+{
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_ctz(mask);
+#else
+    std::size_t result = 0;
+    while ((mask & 1) == 0) {
+        mask >>= 1;
+        ++result;
+    }
+    return result;
+#endif
+}
+
+/**
+ * @brief 一组16个控制字节
+ * @details 各match函数返回16位的掩码，第i位对应组内第i个控制字节；没有SSE2时逐字节比较
+ */
+class _ctrl_group
+{
+public:
+    static constexpr std::size_t _width = 16;
+
+public:
+#if defined(WW_FLAT_HASH_SSE2)
+    __m128i _ctrl;
+#else
+    _ctrl_t _ctrl[_width];
+#endif
+
+public:
+    explicit _ctrl_group(const _ctrl_t * pos) noexcept
+    {
+#if defined(WW_FLAT_HASH_SSE2)
+        _ctrl = _mm_loadu_si128(reinterpret_cast<const __m128i *>(pos));
+#else
+        std::memcpy(_ctrl, pos, _width);
+#endif
+    }
+
+    /**
+     * @brief 值等于h2的满槽
+     */
+    std::uint32_t match(_ctrl_t h2) const noexcept
+    {
+#if defined(WW_FLAT_HASH_SSE2)
+        return static_cast<std::uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_set1_epi8(h2), _ctrl)));
+#else
+        std::uint32_t mask = 0;
+        for (std::size_t i = 0; i < _width; ++i) {
+            mask |= static_cast<std::uint32_t>(_ctrl[i] == h2) << i;
+        }
+        return mask;
+#endif
+    }
+
+    /**
+     * @brief 空槽
+     */
+    std::uint32_t match_empty() const noexcept
+    {
+        return match(_ctrl_empty);
+    }
+
+    /**
+     * @brief 空槽或墓碑，即控制字节小于哨兵
+     */
+    std::uint32_t match_empty_or_deleted() const noexcept
+    {
+#if defined(WW_FLAT_HASH_SSE2)
+        return static_cast<std::uint32_t>(_mm_movemask_epi8(_mm_cmpgt_epi8(_mm_set1_epi8(_ctrl_sentinel), _ctrl)));
+#else
+        std::uint32_t mask = 0;
+        for (std::size_t i = 0; i < _width; ++i) {
+            mask |= static_cast<std::uint32_t>(_ctrl[i] < _ctrl_sentinel) << i;
+        }
+        return mask;
+#endif
+    }
+
+    /**
+     * @brief 组首连续的空槽和墓碑的个数，用于遍历时跳过
+     */
+    std::size_t count_leading_empty_or_deleted() const noexcept
+    {
+        return _ctrl_trailing_zeros(match_empty_or_deleted() + 1);
+    }
+};
+
+/**
+ * @brief 元素直接存放在槽中
+ * @details 扩容时元素被移动，指向元素的指针和引用随之失效；map的键为const，移动时键被拷贝
+ */
+template <class Value>
+class _flat_slot_policy
+{
+public:
+    using value_type = Value;
+    using slot_type = Value;
+
+public:
+    static value_type & element(slot_type * slot) noexcept
+    {
+        return *slot;
+    }
+
+    template <class Alloc, class... Args>
+    static void construct(Alloc & alloc, slot_type * slot, Args&&... args)
+    {
+        allocator_traits<Alloc>::construct(alloc, slot, std::forward<Args>(args)...);
+    }
+
+    template <class Alloc>
+    static void destroy(Alloc & alloc, slot_type * slot)
+    {
+        allocator_traits<Alloc>::destroy(alloc, slot);
+    }
+
+    template <class Alloc>
+    static void transfer(Alloc & alloc, slot_type * dst, slot_type * src)
+    {
+        construct(alloc, dst, std::move(*src));
+        destroy(alloc, src);
+    }
+};
+
+/**
+ * @brief 槽中只存放指向元素的指针，元素单独分配
+ * @details 扩容只移动指针，指向元素的指针和引用在擦除前一直有效
+ */
+template <class Value>
+class _node_slot_policy
+{
+public:
+    using value_type = Value;
+    using slot_type = Value *;
+
+public:
+    static value_type & element(slot_type * slot) noexcept
+    {
+        return **slot;
+    }
+
+    template <class Alloc, class... Args>
+    static void construct(Alloc & alloc, slot_type * slot, Args&&... args)
+    {
+        *slot = allocator_traits<Alloc>::allocate(alloc, 1);
+        allocator_traits<Alloc>::construct(alloc, *slot, std::forward<Args>(args)...);
+    }
+
+    template <class Alloc>
+    static void destroy(Alloc & alloc, slot_type * slot)
+    {
+        allocator_traits<Alloc>::destroy(alloc, *slot);
+        allocator_traits<Alloc>::deallocate(alloc, *slot, 1);
+    }
+
+    template <class Alloc>
+    static void transfer(Alloc &, slot_type * dst, slot_type * src)
+    {
+        *dst = *src;
+    }
+};
+
+/**
+ * @brief 元素直接存放在槽中，flat_hash_map和flat_hash_set的默认存储方式
+ */
+class flat_storage
+{
+public:
+    template <class Value>
+    using policy = _flat_slot_policy<Value>;
+};
+
+/**
+ * @brief 元素单独分配，槽中存放指针，扩容时元素地址不变
+ */
+class node_storage
+{
+public:
+    template <class Value>
+    using policy = _node_slot_policy<Value>;
+};
+
+/**
+ * @brief flat_hash_table常量迭代器
+ * @details 指向一个满槽的控制字节和槽，末尾为哨兵
+ */
+template <class Policy>
+class _flat_hash_const_iterator
+{
+public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = typename Policy::value_type;
+    using reference = const value_type&;
+    using pointer = const value_type*;
+    using size_type = std::size_t;
+    using difference_type = std::ptrdiff_t;
+
+    using self = _flat_hash_const_iterator<Policy>;
+    using slot_type = typename Policy::slot_type;
+
+public:
+    _ctrl_t * _ctrl;        // 控制字节
+    slot_type * _slot;      // 对应的槽
+
+public:
+    _flat_hash_const_iterator()
+        : _ctrl(nullptr)
+        , _slot(nullptr)
+    { // 构造不指向任何槽的迭代器
+    }
+
+    _flat_hash_const_iterator(_ctrl_t * ctrl, slot_type * slot)
+        : _ctrl(ctrl)
+        , _slot(slot)
+    {
+    }
+
+public:
+    reference operator*() const
+    {
+        return Policy::element(_slot);
+    }
+
+    pointer operator->() const
+    {
+        return &(operator*());
+    }
+
+    self & operator++()
+    {
+        ++_ctrl;
+        ++_slot;
+        _skip_empty_or_deleted();
+        return *this;
+    }
+
+    self operator++(int)
+    {
+        self tmp = *this;
+        ++*this;
+        return tmp;
+    }
+
+    bool operator==(const self & rhs) const
+    {
+        return _ctrl == rhs._ctrl;
+    }
+
+    bool operator!=(const self & rhs) const
+    {
+        return _ctrl != rhs._ctrl;
+    }
+
+public:
+    /**
+     * @brief 移动到下一个满槽或哨兵，一次跳过一组中连续的空槽和墓碑
+     */
+    void _skip_empty_or_deleted()
+    {
+        while (*_ctrl < _ctrl_sentinel) {
+            const size_type shift = _ctrl_group(_ctrl).count_leading_empty_or_deleted();
+            _ctrl += shift;
+            _slot += shift;
+        }
+    }
+};
+
+/**
+ * @brief flat_hash_table迭代器
+ */
+template <class Policy>
+class _flat_hash_iterator
+    : public _flat_hash_const_iterator<Policy>
+{
+public:
+    using base = _flat_hash_const_iterator<Policy>;
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = typename Policy::value_type;
+    using reference = value_type&;
+    using pointer = value_type*;
+    using size_type = std::size_t;
+    using difference_type = std::ptrdiff_t;
+
+    using self = _flat_hash_iterator<Policy>;
+    using slot_type = typename Policy::slot_type;
+
+public:
+    _flat_hash_iterator()
+        : base()
+    {
+    }
+
+    _flat_hash_iterator(_ctrl_t * ctrl, slot_type * slot)
+        : base(ctrl, slot)
+    {
+    }
+
+public:
+    reference operator*() const
+    {
+        return const_cast<reference>(base::operator*());
+    }
+
+    pointer operator->() const
+    {
+        return const_cast<pointer>(base::operator->());
+    }
+
+    self & operator++()
+    {
+        base::operator++();
+        return *this;
+    }
+
+    self operator++(int)
+    {
+        self tmp = *this;
+        ++*this;
+        return tmp;
+    }
+};
+
+/**
+ * @brief 容量为0的表使用的控制字节，哨兵之后全部为空，查找读取一组后立即停止
+ */
+inline _ctrl_t * _flat_hash_empty_group() noexcept
+{
+    alignas(16) static const _ctrl_t group[_ctrl_group::_width] = {
+        _ctrl_sentinel, _ctrl_empty, _ctrl_empty, _ctrl_empty,
+        _ctrl_empty, _ctrl_empty, _ctrl_empty, _ctrl_empty,
+        _ctrl_empty, _ctrl_empty, _ctrl_empty, _ctrl_empty,
+        _ctrl_empty, _ctrl_empty, _ctrl_empty, _ctrl_empty
+    };
+    return const_cast<_ctrl_t *>(group);
+}
+
+/**
+ * @brief 开放寻址哈希表
+ * @details 模板参数与hashtable相同，另加Storage决定元素存放在槽中(flat_storage)还是单独分配(node_storage)
+ * @details 最大负载因子固定为7/8；擦除时若相邻的控制字节表明没有探测序列越过该槽，直接标记为空槽，否则留下墓碑
+ * @details 不提供桶接口和节点句柄，每个"桶"即一个槽
+ */
+template <
+    class Key,
+    class T,
+    class Value,
+    class Hash,
+    class KeyEqual,
+    class ExtractKey,
+    class Allocator,
+    class Storage
+> class flat_hash_table
+{
+public:
+    using key_type = Key;
+    using mapped_type = T;
+    using value_type = Value;
+    using hasher = Hash;
+    using key_equal = KeyEqual;
+    using key_extractor = ExtractKey;
+    using allocator_type = Allocator;
+    using size_type = std::size_t;
+    using difference_type = std::ptrdiff_t;
+
+    using policy = typename Storage::template policy<value_type>;
+    using slot_type = typename policy::slot_type;
+    using iterator = _flat_hash_iterator<policy>;
+    using const_iterator = _flat_hash_const_iterator<policy>;
+
+    using value_allocator_type = typename allocator_type::template rebind<value_type>::other;
+    using slot_allocator_type = typename allocator_type::template rebind<slot_type>::other;
+    using ctrl_allocator_type = typename allocator_type::template rebind<_ctrl_t>::other;
+
+    static constexpr size_type _group_width = _ctrl_group::_width;
+    static constexpr size_type _min_capacity = _group_width - 1;
+
+public:
+    _ctrl_t * _ctrl;                        // 控制字节，长度为_capacity + _group_width
+    slot_type * _slots;                     // 槽
+    size_type _capacity;                    // 槽数，0或2 ^ k - 1
+    size_type _size;                        // 元素个数
+    size_type _growth_left;                 // 还能占用的空槽数，墓碑不会被计回
+    hasher _hash;                           // 哈希函数
+    key_equal _equals;                      // 判断键值是否相等
+    key_extractor _get_key;                 // 获取键值
+    value_allocator_type _allocator;        // 元素分配器
+
+public:
+    flat_hash_table()
+        : flat_hash_table(size_type(0))
+    {
+    }
+
+    explicit flat_hash_table(size_type bucket_count, const hasher & hash = hasher(), const key_equal & equals = key_equal(), const allocator_type & alloc = allocator_type())
+        : _ctrl(_flat_hash_empty_group())
+        , _slots(nullptr)
+        , _capacity(0)
+        , _size(0)
+        , _growth_left(0)
+        , _hash(hash)
+        , _equals(equals)
+        , _get_key()
+        , _allocator(alloc)
+    {
+        if (bucket_count > 0) {
+            _resize(_normalize_capacity(bucket_count));
+        }
+    }
+
+    explicit flat_hash_table(const allocator_type & alloc)
+        : flat_hash_table(0, hasher(), key_equal(), alloc)
+    {
+    }
+
+    flat_hash_table(const flat_hash_table & other)
+        : flat_hash_table(other, other.get_allocator())
+    {
+    }
+
+    flat_hash_table(const flat_hash_table & other, const allocator_type & alloc)
+        : flat_hash_table(0, other._hash, other._equals, alloc)
+    {
+        _copy_from(other);
+    }
+
+    flat_hash_table(flat_hash_table && other)
+        : flat_hash_table(std::move(other), other.get_allocator())
+    {
+    }
+
+    flat_hash_table(flat_hash_table && other, const allocator_type & alloc)
+        : _ctrl(other._ctrl)
+        , _slots(other._slots)
+        , _capacity(other._capacity)
+        , _size(other._size)
+        , _growth_left(other._growth_left)
+        , _hash(other._hash)
+        , _equals(other._equals)
+        , _get_key(other._get_key)
+        , _allocator(alloc)
+    {
+        other._reset();
+    }
+
+    ~flat_hash_table()
+    {
+        _destroy_slots();
+    }
+
+public:
+    /**
+     * @brief 将值赋给容器
+     */
+    flat_hash_table & operator=(const flat_hash_table & other)
+    {
+        if (this != &other) {
+            clear();
+            _hash = other._hash;
+            _equals = other._equals;
+            _get_key = other._get_key;
+            if (allocator_traits<allocator_type>::propagate_on_container_copy_assignment::value) {
+                _destroy_slots();
+                _reset();
+                _allocator = other._allocator;
+            }
+            _copy_from(other);
+        }
+        return *this;
+    }
+
+    /**
+     * @brief 将值赋给容器
+     */
+    flat_hash_table & operator=(flat_hash_table && other)
+    {
+        if (this != &other) {
+            _destroy_slots();
+            _ctrl = other._ctrl;
+            _slots = other._slots;
+            _capacity = other._capacity;
+            _size = other._size;
+            _growth_left = other._growth_left;
+            _hash = other._hash;
+            _equals = other._equals;
+            _get_key = other._get_key;
+            if (allocator_traits<allocator_type>::propagate_on_container_move_assignment::value) {
+                _allocator = std::move(other._allocator);
+            }
+            other._reset();
+        }
+        return *this;
+    }
+
+    /**
+     * @brief 返回关联的分配器
+     */
+    allocator_type get_allocator() const
+    {
+        return allocator_type(_allocator);
+    }
+
+    // 迭代器
+
+    /**
+     * @brief 返回指向起始的迭代器
+     */
+    iterator begin() noexcept
+    {
+        iterator it(_ctrl, _slots);
+        it._skip_empty_or_deleted();
+        return it;
+    }
+
+    /**
+     * @brief 返回指向起始的迭代器
+     */
+    const_iterator begin() const noexcept
+    {
+        return const_cast<flat_hash_table *>(this)->begin();
+    }
+
+    /**
+     * @brief 返回指向末尾的迭代器
+     */
+    iterator end() noexcept
+    {
+        return iterator(_ctrl + _capacity, _slots + _capacity);
+    }
+
+    /**
+     * @brief 返回指向末尾的迭代器
+     */
+    const_iterator end() const noexcept
+    {
+        return const_cast<flat_hash_table *>(this)->end();
+    }
+
+    // 容量
+
+    /**
+     * @brief 检查容器是否为空
+     */
+    bool empty() const noexcept
+    {
+        return _size == 0;
+    }
+
+    /**
+     * @brief 返回元素数
+     */
+    size_type size() const noexcept
+    {
+        return _size;
+    }
+
+    /**
+     * @brief 返回可容纳的最大元素数
+     */
+    size_type max_size() const noexcept
+    {
+        return std::numeric_limits<difference_type>::max() / (sizeof(slot_type) + 1);
+    }
+
+    // 修改器
+
+    /**
+     * @brief 清除内容，保留容量
+     */
+    void clear()
+    {
+        if (_capacity == 0) {
+            return;
+        }
+        for (size_type i = 0; i < _capacity; ++i) {
+            if (_is_full(_ctrl[i])) {
+                policy::destroy(_allocator, _slots + i);
+            }
+        }
+        _reset_ctrl();
+        _size = 0;
+        _growth_left = _capacity_to_growth(_capacity);
+    }
+
+    /**
+     * @brief 原位构造元素，不允许重复
+     * @details 能从参数直接取得键时先查找再构造，否则先构造一个临时元素
+     */
+    template <class... Args>
+    std::pair<iterator, bool> emplace_unique(Args&&... args)
+    {
+        return _emplace_unique(_emplace_key_extractable<key_type, mapped_type, Args...>(), std::forward<Args>(args)...);
+    }
+
+    /**
+     * @brief 键不存在时以key和args原位构造元素，键已存在时不做任何事
+     * @details 用于flat_hash_map
+     */
+    template <class K, class... Args>
+    std::pair<iterator, bool> try_emplace_unique(K && key, Args&&... args)
+    {
+        return _emplace_unique_key(key,
+            std::piecewise_construct,
+            std::forward_as_tuple(std::forward<K>(key)),
+            std::forward_as_tuple(std::forward<Args>(args)...));
+    }
+
+    /**
+     * @brief 键不存在时插入元素，键已存在时将obj赋值给对应的值
+     * @details 用于flat_hash_map
+     */
+    template <class K, class M>
+    std::pair<iterator, bool> insert_or_assign_unique(K && key, M && obj)
+    {
+        const size_type hash = _hash_of(key);
+        const size_type index = _find_index(key, hash);
+        if (index != _capacity) {
+            policy::element(_slots + index).second = std::forward<M>(obj);
+            return std::make_pair(_make_iterator(index), false);
+        }
+        return std::make_pair(_make_iterator(_insert_at(_prepare_insert(hash), hash, std::forward<K>(key), std::forward<M>(obj))), true);
+    }
+
+    /**
+     * @brief 擦除元素
+     * @return 指向下一个元素的迭代器；擦除不移动其他元素
+     */
+    iterator erase(const_iterator pos)
+    {
+        iterator next(pos._ctrl, pos._slot);
+        _erase_index(static_cast<size_type>(pos._ctrl - _ctrl));
+        ++next;
+        return next;
+    }
+
+    /**
+     * @brief 擦除元素
+     */
+    iterator erase(const_iterator first, const_iterator last)
+    {
+        while (first != last) {
+            first = erase(first);
+        }
+        return iterator(last._ctrl, last._slot);
+    }
+
+    /**
+     * @brief 擦除元素
+     */
+    size_type erase(const key_type & key)
+    {
+        const size_type index = _find_index(key, _hash_of(key));
+        if (index == _capacity) {
+            return 0;
+        }
+        _erase_index(index);
+        return 1;
+    }
+
+    /**
+     * @brief 交换内容
+     */
+    void swap(flat_hash_table & other)
+    {
+        std::swap(_ctrl, other._ctrl);
+        std::swap(_slots, other._slots);
+        std::swap(_capacity, other._capacity);
+        std::swap(_size, other._size);
+        std::swap(_growth_left, other._growth_left);
+        std::swap(_hash, other._hash);
+        std::swap(_equals, other._equals);
+        std::swap(_get_key, other._get_key);
+        if (allocator_traits<allocator_type>::propagate_on_container_swap::value) {
+            std::swap(_allocator, other._allocator);
+        }
+    }
+
+    // 查找
+
+    /**
+     * @brief 查找特定键的元素
+     */
+    template <class K>
+    iterator find(const K & key)
+    {
+        return _make_iterator(_find_index(key, _hash_of(key)));
+    }
+
+    /**
+     * @brief 查找特定键的元素
+     */
+    template <class K>
+    const_iterator find(const K & key) const
+    {
+        return const_cast<flat_hash_table *>(this)->find(key);
+    }
+
+    // 散列策略
+
+    /**
+     * @brief 返回槽数
+     */
+    size_type bucket_count() const noexcept
+    {
+        return _capacity;
+    }
+
+    /**
+     * @brief 返回负载因子
+     */
+    float load_factor() const noexcept
+    {
+        return _capacity == 0 ? 0.0f : static_cast<float>(_size) / static_cast<float>(_capacity);
+    }
+
+    /**
+     * @brief 返回最大负载因子，固定为7/8
+     */
+    float max_load_factor() const noexcept
+    {
+        return 0.875f;
+    }
+
+    /**
+     * @brief 预留至少count个槽并重新生成散列表，同时清除墓碑
+     * @details 槽数不会少于容纳现有元素所需的数量，count为0且表为空时释放内存
+     */
+    void rehash(size_type count)
+    {
+        if (count == 0 && _size == 0) {
+            _destroy_slots();
+            _reset();
+            return;
+        }
+        const size_type needed = _normalize_capacity((std::max)(count, _growth_to_capacity(_size)));
+        if (count == 0 || needed > _capacity) {
+            _resize(needed);
+        }
+    }
+
+    /**
+     * @brief 为至少count个元素预留空间
+     */
+    void reserve(size_type count)
+    {
+        if (count > _size + _growth_left) {
+            _resize(_normalize_capacity(_growth_to_capacity(count)));
+        }
+    }
+
+    /**
+     * @brief 返回用于对键求散列的函数
+     */
+    hasher hash_function() const
+    {
+        return _hash;
+    }
+
+    /**
+     * @brief 返回用于比较键的相等性的函数
+     */
+    key_equal key_eq() const
+    {
+        return _equals;
+    }
+
+public:
+    static bool _is_full(_ctrl_t ctrl) noexcept
+    {
+        return ctrl >= 0;
+    }
+
+    /**
+     * @brief 不小于n且不小于一组的2 ^ k - 1
+     */
+    static size_type _normalize_capacity(size_type n) noexcept
+    {
+        size_type capacity = _min_capacity;
+        while (capacity < n) {
+            capacity = capacity * 2 + 1;
+        }
+        return capacity;
+    }
+
+    /**
+     * @brief 容量为capacity时最多容纳的元素数，负载因子7/8，至少保留一个空槽保证探测终止
+     */
+    static size_type _capacity_to_growth(size_type capacity) noexcept
+    {
+        return capacity - capacity / 8;
+    }
+
+    /**
+     * @brief 容纳growth个元素所需的最小容量，_capacity_to_growth的逆
+     */
+    static size_type _growth_to_capacity(size_type growth) noexcept
+    {
+        return growth == 0 ? 0 : growth + (growth - 1) / 7;
+    }
+
+    /**
+     * @brief 键的哈希值，哈希函数没有声明is_mixed时先打散，低7位和其余位分别用于控制字节和探测起点
+     */
+    template <class K>
+    size_type _hash_of(const K & key) const
+    {
+        return _mix_code(_hash(key), hash_is_mixed<hasher>());
+    }
+
+    static size_type _mix_code(size_type code, std::true_type) noexcept
+    {
+        return code;
+    }
+
+    static size_type _mix_code(size_type code, std::false_type) noexcept
+    {
+        return _hash_mix(code);
+    }
+
+    static _ctrl_t _h2(size_type hash) noexcept
+    {
+        return static_cast<_ctrl_t>(hash & 0x7F);
+    }
+
+    /**
+     * @brief 探测起点，容量为2 ^ k - 1时与容量按位与即可取模
+     */
+    size_type _probe_start(size_type hash) const noexcept
+    {
+        return (hash >> 7) & _capacity;
+    }
+
+    iterator _make_iterator(size_type index) const noexcept
+    {
+        return iterator(_ctrl + index, _slots + index);
+    }
+
+    /**
+     * @brief 设置控制字节，前_group_width - 1个同时写入哨兵之后的副本
+     */
+    void _set_ctrl(size_type index, _ctrl_t value) noexcept
+    {
+        _ctrl[index] = value;
+        _ctrl[((index - (_group_width - 1)) & _capacity) + ((_group_width - 1) & _capacity)] = value;
+    }
+
+    /**
+     * @brief 查找特定键的槽，不存在时返回_capacity
+     * @details 以组为单位按三角数步长探测，遍历全部组；组内有空槽说明键不可能在更后面
+     */
+    template <class K>
+    size_type _find_index(const K & key, size_type hash) const
+    {
+        const _ctrl_t h2 = _h2(hash);
+        size_type offset = _probe_start(hash);
+        for (size_type step = _group_width; ; step += _group_width) {
+            const _ctrl_group group(_ctrl + offset);
+            for (std::uint32_t mask = group.match(h2); mask != 0; mask &= mask - 1) {
+                const size_type index = (offset + _ctrl_trailing_zeros(mask)) & _capacity;
+                if (_equals(_get_key(policy::element(_slots + index)), key)) {
+                    return index;
+                }
+            }
+            if (group.match_empty() != 0) {
+                return _capacity;
+            }
+            offset = (offset + step) & _capacity;
+        }
+    }
+
+    /**
+     * @brief 沿探测序列找到第一个空槽或墓碑
+     */
+    size_type _find_first_non_full(size_type hash) const noexcept
+    {
+        size_type offset = _probe_start(hash);
+        for (size_type step = _group_width; ; step += _group_width) {
+            const std::uint32_t mask = _ctrl_group(_ctrl + offset).match_empty_or_deleted();
+            if (mask != 0) {
+                return (offset + _ctrl_trailing_zeros(mask)) & _capacity;
+            }
+            offset = (offset + step) & _capacity;
+        }
+    }
+
+    /**
+     * @brief 为哈希值为hash的新元素选择槽，空槽用尽时先扩容或清除墓碑
+     * @details 复用墓碑不消耗_growth_left
+     */
+    size_type _prepare_insert(size_type hash)
+    {
+        size_type index = _find_first_non_full(hash);
+        if (_growth_left == 0 && _ctrl[index] != _ctrl_deleted) {
+            _rehash_and_grow();
+            index = _find_first_non_full(hash);
+        }
+        return index;
+    }
+
+    /**
+     * @brief 在_prepare_insert选出的槽中构造元素
+     * @details 先构造再设置控制字节，构造抛出异常时表保持不变
+     */
+    template <class... Args>
+    size_type _insert_at(size_type index, size_type hash, Args&&... args)
+    {
+        policy::construct(_allocator, _slots + index, std::forward<Args>(args)...);
+        _growth_left -= static_cast<size_type>(_ctrl[index] == _ctrl_empty);
+        _set_ctrl(index, _h2(hash));
+        ++_size;
+        return index;
+    }
+
+    /**
+     * @brief 从参数中可以直接取得键，先查找再构造
+     */
+    template <class... Args>
+    std::pair<iterator, bool> _emplace_unique(std::true_type, Args&&... args)
+    {
+        return _emplace_unique_key(_emplace_key_of<key_type>(std::is_void<mapped_type>(), args...), std::forward<Args>(args)...);
+    }
+
+    /**
+     * @brief 无法直接取得键，先构造临时元素取得键，再移动到槽中
+     */
+    template <class... Args>
+    std::pair<iterator, bool> _emplace_unique(std::false_type, Args&&... args)
+    {
+        value_type tmp(std::forward<Args>(args)...);
+        return _emplace_unique_key(_get_key(tmp), std::move(tmp));
+    }
+
+    /**
+     * @brief 以键查找，不存在时才以args构造元素
+     * @details 哈希值只计算一次；key可能引用args中的对象，构造之后不能再使用key
+     */
+    template <class K, class... Args>
+    std::pair<iterator, bool> _emplace_unique_key(const K & key, Args&&... args)
+    {
+        const size_type hash = _hash_of(key);
+        const size_type index = _find_index(key, hash);
+        if (index != _capacity) {
+            return std::make_pair(_make_iterator(index), false);
+        }
+        return std::make_pair(_make_iterator(_insert_at(_prepare_insert(hash), hash, std::forward<Args>(args)...)), true);
+    }
+
+    /**
+     * @brief 擦除index处的元素
+     * @details 以index为中心，若左右连续的非空槽不足一组，则没有任何一次探测因为这一组已满而越过它，
+     *          可以直接置为空槽并归还_growth_left；否则留下墓碑
+     */
+    void _erase_index(size_type index)
+    {
+        policy::destroy(_allocator, _slots + index);
+        --_size;
+        const size_type index_before = (index - _group_width) & _capacity;
+        const std::uint32_t empty_after = _ctrl_group(_ctrl + index).match_empty();
+        const std::uint32_t empty_before = _ctrl_group(_ctrl + index_before).match_empty();
+        const bool was_never_full = empty_before != 0 && empty_after != 0
+            && _ctrl_trailing_zeros(empty_after) + _leading_zeros(empty_before) < _group_width;
+        _set_ctrl(index, was_never_full ? _ctrl_empty : _ctrl_deleted);
+        _growth_left += static_cast<size_type>(was_never_full);
+    }
+
+    /**
+     * @brief 16位掩码的二进制开头0的个数，mask不为0
+     */
+    static size_type _leading_zeros(std::uint32_t mask) noexcept
+    {
+        size_type result = 0;
+        for (std::uint32_t bit = 1u << (_group_width - 1); (mask & bit) == 0; bit >>= 1) {
+            ++result;
+        }
+        return result;
+    }
+
+    /**
+     * @brief 空槽用尽时调用，墓碑较多时以原容量重建，否则容量翻倍
+     */
+    void _rehash_and_grow()
+    {
+        if (_capacity > _group_width && _size * 32 <= _capacity * 25) {
+            _resize(_capacity);
+        } else {
+            _resize(_capacity == 0 ? _min_capacity : _capacity * 2 + 1);
+        }
+    }
+
+    /**
+     * @brief 以new_capacity个槽重建，元素按哈希值重新放置，墓碑被清除
+     */
+    void _resize(size_type new_capacity)
+    {
+        _ctrl_t * old_ctrl = _ctrl;
+        slot_type * old_slots = _slots;
+        const size_type old_capacity = _capacity;
+
+        _allocate(new_capacity);
+        for (size_type i = 0; i < old_capacity; ++i) {
+            if (_is_full(old_ctrl[i])) {
+                const size_type hash = _hash_of(_get_key(policy::element(old_slots + i)));
+                const size_type index = _find_first_non_full(hash);
+                _set_ctrl(index, _h2(hash));
+                policy::transfer(_allocator, _slots + index, old_slots + i);
+            }
+        }
+        _growth_left = _capacity_to_growth(_capacity) - _size;
+        _deallocate(old_ctrl, old_slots, old_capacity);
+    }
+
+    /**
+     * @brief 分配capacity个槽和控制字节，全部置为空
+     */
+    void _allocate(size_type capacity)
+    {
+        ctrl_allocator_type ctrl_allocator(_allocator);
+        slot_allocator_type slot_allocator(_allocator);
+        _ctrl = allocator_traits<ctrl_allocator_type>::allocate(ctrl_allocator, capacity + _group_width);
+        _slots = allocator_traits<slot_allocator_type>::allocate(slot_allocator, capacity);
+        _capacity = capacity;
+        _reset_ctrl();
+    }
+
+    void _deallocate(_ctrl_t * ctrl, slot_type * slots, size_type capacity)
+    {
+        if (capacity == 0) {
+            return;
+        }
+        ctrl_allocator_type ctrl_allocator(_allocator);
+        slot_allocator_type slot_allocator(_allocator);
+        allocator_traits<ctrl_allocator_type>::deallocate(ctrl_allocator, ctrl, capacity + _group_width);
+        allocator_traits<slot_allocator_type>::deallocate(slot_allocator, slots, capacity);
+    }
+
+    void _reset_ctrl() noexcept
+    {
+        std::memset(_ctrl, static_cast<unsigned char>(_ctrl_empty), _capacity + _group_width);
+        _ctrl[_capacity] = _ctrl_sentinel;
+    }
+
+    /**
+     * @brief 销毁全部元素并释放槽，不修改成员
+     */
+    void _destroy_slots()
+    {
+        for (size_type i = 0; i < _capacity; ++i) {
+            if (_is_full(_ctrl[i])) {
+                policy::destroy(_allocator, _slots + i);
+            }
+        }
+        _deallocate(_ctrl, _slots, _capacity);
+    }
+
+    /**
+     * @brief 置为不占用内存的空表
+     */
+    void _reset() noexcept
+    {
+        _ctrl = _flat_hash_empty_group();
+        _slots = nullptr;
+        _capacity = 0;
+        _size = 0;
+        _growth_left = 0;
+    }
+
+    /**
+     * @brief 一次分配到位后逐个插入other的元素，other中没有重复的键，不需要查找
+     */
+    void _copy_from(const flat_hash_table & other)
+    {
+        reserve(other._size);
+        for (auto it = other.begin(); it != other.end(); ++it) {
+            const size_type hash = _hash_of(_get_key(*it));
+            _insert_at(_prepare_insert(hash), hash, *it);
+        }
+    }
+};
+
+template <class Key, class T, class Value, class Hash, class KeyEqual, class ExtractKey, class Allocator, class Storage>
+constexpr std::size_t flat_hash_table<Key, T, Value, Hash, KeyEqual, ExtractKey, Allocator, Storage>::_group_width;
+
+template <class Key, class T, class Value, class Hash, class KeyEqual, class ExtractKey, class Allocator, class Storage>
+constexpr std::size_t flat_hash_table<Key, T, Value, Hash, KeyEqual, ExtractKey, Allocator, Storage>::_min_capacity;
+
+} // namespace wwstl
+
+#endif // __WW_FLAT_HASH_TABLE_H__
@@ -0,0 +1,1282 @@
+#ifndef __WW_FLAT_MAP_H__
+#define __WW_FLAT_MAP_H__
+
+#include <initializer_list>
+#include "ww_flat_table.h"
+
+namespace wwstl
+{
+
+/**
+ * @brief flat_map
+ * @link https://zh.cppreference.com/w/cpp/container/flat_map
+ * @details 键和值分别存放在两个有序数组中，接口与map相同
+ * @details 迭代器解引用得到std::pair<const Key &, T &>，遍历时使用auto &&或const auto &
+ * @details 插入和删除会使所有迭代器失效
+ */
+template <
+    class Key,
+    class T,
+    class Compare = std::less<Key>,
+    class KeyContainer = wwstl::vector<Key>,
+    class MappedContainer = wwstl::vector<T>
+> class flat_map
+{
+public:
+    using key_type = Key;
+    using mapped_type = T;
+    using value_type = std::pair<Key, T>;
+    using key_compare = Compare;
+    using reference = std::pair<const Key &, T &>;
+    using const_reference = std::pair<const Key &, const T &>;
+    using size_type = std::size_t;
+    using difference_type = std::ptrdiff_t;
+    using key_container_type = KeyContainer;
+    using mapped_container_type = MappedContainer;
+    using iterator = typename wwstl::flat_table<Key, T, Compare, KeyContainer, MappedContainer>::iterator;
+    using const_iterator = typename wwstl::flat_table<Key, T, Compare, KeyContainer, MappedContainer>::const_iterator;
+    using reverse_iterator = typename wwstl::reverse_iterator<iterator>;
+    using const_reverse_iterator = typename wwstl::reverse_iterator<const_iterator>;
+
+public:
+    wwstl::flat_table<Key, T, Compare, KeyContainer, MappedContainer> _table;  // 有序数组
+
+public:
+    flat_map()
+        : flat_map(Compare())
+    {
+    }
+
+    explicit flat_map(const Compare & comp)
+        : _table(comp)
+    {
+    }
+
+    template <class InputIt>
+    flat_map(InputIt first, InputIt last, const Compare & comp = Compare())
+        : _table(comp)
+    {
+        _table.insert_range_unique(first, last);
+    }
+
+    flat_map(const flat_map & other)
+        : _table(other._table)
+    {
+    }
+
+    flat_map(flat_map && other)
+        : _table(std::move(other._table))
+    {
+    }
+
+    flat_map(std::initializer_list<value_type> init, const Compare & comp = Compare())
+        : _table(comp)
+    {
+        insert(init);
+    }
+
+public:
+    /**
+     * @brief 将值赋给容器
+     */
+    flat_map & operator=(const flat_map & other)
+    {
+        if (this != &other) {
+            _table = other._table;
+        }
+        return *this;
+    }
+
+    /**
+     * @brief 将值赋给容器
+     */
+    flat_map & operator=(flat_map && other)
+    {
+        if (this != &other) {
+            _table = std::move(other._table);
+        }
+        return *this;
+    }
+
+    /**
+     * @brief 将值赋给容器
+     */
+    flat_map & operator=(std::initializer_list<value_type> ilist)
+    {
+        clear();
+        insert(ilist);
+        return *this;
+    }
+
+    // 元素访问
+
+    /**
+     * @brief 带越界检查访问指定的元素
+     */
+    mapped_type & at(const key_type & key)
+    {
+        return _table.at(key);
+    }
+
+    /**
+     * @brief 带越界检查访问指定的元素
+     */
+    const mapped_type & at(const key_type & key) const
+    {
+        return _table.at(key);
+    }
+
+    /**
+     * @brief 访问或插入指定的元素
+     */
+    mapped_type & operator[](const key_type & key)
+    {
+        return _table[key];
+    }
+
+    /**
+     * @brief 访问或插入指定的元素
+     */
+    mapped_type & operator[](key_type && key)
+    {
+        return _table[std::move(key)];
+    }
+
+    // 迭代器
+
+    /**
+     * @brief 返回指向起始的迭代器
+     */
+    iterator begin() noexcept
+    {
+        return _table.begin();
+    }
+
+    /**
+     * @brief 返回指向起始的迭代器
+     */
+    const_iterator begin() const noexcept
+    {
+        return _table.begin();
+    }
+
+    /**
+     * @brief 返回指向起始的迭代器
+     */
+    const_iterator cbegin() const noexcept
+    {
+        return _table.cbegin();
+    }
+
+    /**
+     * @brief 返回指向末尾的迭代器
+     */
+    iterator end() noexcept
+    {
+        return _table.end();
+    }
+
+    /**
+     * @brief 返回指向末尾的迭代器
+     */
+    const_iterator end() const noexcept
+    {
+        return _table.end();
+    }
+
+    /**
+     * @brief 返回指向末尾的迭代器
+     */
+    const_iterator cend() const noexcept
+    {
+        return _table.cend();
+    }
+
+    /**
+     * @brief 返回指向起始的逆向迭代器
+     */
+    reverse_iterator rbegin() noexcept
+    {
+        return reverse_iterator(end());
+    }
+
+    /**
+     * @brief 返回指向起始的逆向迭代器
+     */
+    const_reverse_iterator rbegin() const noexcept
+    {
+        return const_reverse_iterator(end());
+    }
+
+    /**
+     * @brief 返回指向起始的逆向迭代器
+     */
+    const_reverse_iterator crbegin() const noexcept
+    {
+        return const_reverse_iterator(cend());
+    }
+
+    /**
+     * @brief 返回指向末尾的逆向迭代器
+     */
+    reverse_iterator rend() noexcept
+    {
+        return reverse_iterator(begin());
+    }
+
+    /**
+     * @brief 返回指向末尾的逆向迭代器
+     */
+    const_reverse_iterator rend() const noexcept
+    {
+        return const_reverse_iterator(begin());
+    }
+
+    /**
+     * @brief 返回指向末尾的逆向迭代器
+     */
+    const_reverse_iterator crend() const noexcept
+    {
+        return const_reverse_iterator(cbegin());
+    }
+
+    // 容量
+
+    /**
+     * @brief 检查容器是否为空
+     */
+    bool empty() const noexcept
+    {
+        return _table.empty();
+    }
+
+    /**
+     * @brief 返回元素数
+     */
+    size_type size() const noexcept
+    {
+        return _table.size();
+    }
+
+    /**
+     * @brief 返回可容纳的最大元素数
+     */
+    size_type max_size() const noexcept
+    {
+        return _table.max_size();
+    }
+
+    /**
+     * @brief 为count个元素预留空间
+     */
+    void reserve(size_type count)
+    {
+        _table.reserve(count);
+    }
+
+    // 修改器
+
+    /**
+     * @brief 清除内容
+     */
+    void clear() noexcept
+    {
+        _table.clear();
+    }
+
+    /**
+     * @brief 插入元素
+     */
+    std::pair<iterator, bool> insert(const value_type & value)
+    {
+        return _table.emplace_unique(value);
+    }
+
+    /**
+     * @brief 插入元素
+     * @details 通用插入函数，支持所有能够转换为value_type的参数
+     */
+    template <class P>
+    std::pair<iterator, bool> insert(P && value)
+    {
+        return _table.emplace_unique(std::forward<P>(value));
+    }
+
+    /**
+     * @brief 插入元素
+     */
+    iterator insert(const_iterator hint, const value_type & value)
+    {
+        return _table.emplace_hint_unique(hint, value);
+    }
+
+    /**
+     * @brief 插入元素
+     */
+    template <class P>
+    iterator insert(const_iterator hint, P && value)
+    {
+        return _table.emplace_hint_unique(hint, std::forward<P>(value));
+    }
+
+    /**
+     * @brief 插入元素
+     * @details 新元素排序后与已有元素一次归并，复杂度O(n + m log m)
+     */
+    template <class InputIt>
+    void insert(InputIt first, InputIt last)
+    {
+        _table.insert_range_unique(first, last);
+    }
+
+    /**
+     * @brief 插入元素
+     */
+    void insert(std::initializer_list<value_type> ilist)
+    {
+        insert(ilist.begin(), ilist.end());
+    }
+
+    /**
+     * @brief 原位构造元素
+     */
+    template <class... Args>
+    std::pair<iterator, bool> emplace(Args&&... args)
+    {
+        return _table.emplace_unique(std::forward<Args>(args)...);
+    }
+
+    /**
+     * @brief 使用提示原位构造元素
+     */
+    template <class... Args>
+    iterator emplace_hint(const_iterator hint, Args&&... args)
+    {
+        return _table.emplace_hint_unique(hint, std::forward<Args>(args)...);
+    }
+
+    /**
+     * @brief 擦除元素
+     */
+    iterator erase(const_iterator pos)
+    {
+        return _table.erase(pos);
+    }
+
+    /**
+     * @brief 擦除元素
+     */
+    iterator erase(const_iterator first, const_iterator last)
+    {
+        return _table.erase(first, last);
+    }
+
+    /**
+     * @brief 擦除元素
+     */
+    size_type erase(const key_type & key)
+    {
+        return _table.erase(key);
+    }
+
+    /**
+     * @brief 交换内容
+     */
+    void swap(flat_map & other) noexcept
+    {
+        _table.swap(other._table);
+    }
+
+    // 查找
+
+    /**
+     * @brief 返回匹配特定键的元素数量
+     */
+    size_type count(const key_type & key) const
+    {
+        return _table.count(key);
+    }
+
+    /**
+     * @brief 返回匹配特定键的元素数量
+     * @details 异构查找，要求比较器定义is_transparent
+     */
+    template <class K, class C = key_compare, class = typename C::is_transparent>
+    size_type count(const K & key) const
+    {
+        return _table.count(key);
+    }
+
+    /**
+     * @brief 寻找带有特定键的元素
+     */
+    iterator find(const key_type & key)
+    {
+        return _table.find(key);
+    }
+
+    /**
+     * @brief 寻找带有特定键的元素
+     * @details 异构查找，要求比较器定义is_transparent
+     */
+    template <class K, class C = key_compare, class = typename C::is_transparent>
+    iterator find(const K & key)
+    {
+        return _table.find(key);
+    }
+
+    /**
+     * @brief 寻找带有特定键的元素
+     */
+    const_iterator find(const key_type & key) const
+    {
+        return _table.find(key);
+    }
+
+    /**
+     * @brief 寻找带有特定键的元素
+     * @details 异构查找，要求比较器定义is_transparent
+     */
+    template <class K, class C = key_compare, class = typename C::is_transparent>
+    const_iterator find(const K & key) const
+    {
+        return _table.find(key);
+    }
+
+    /**
+     * @brief 返回匹配特定键的元素范围
+     */
+    std::pair<iterator, iterator> equal_range(const key_type & key)
+    {
+        return _table.equal_range(key);
+    }
+
+    /**
+     * @brief 返回匹配特定键的元素范围
+     * @details 异构查找，要求比较器定义is_transparent
+     */
+    template <class K, class C = key_compare, class = typename C::is_transparent>
+    std::pair<iterator, iterator> equal_range(const K & key)
+    {
+        return _table.equal_range(key);
+    }
+
+    /**
+     * @brief 返回匹配特定键的元素范围
+     */
+    std::pair<const_iterator, const_iterator> equal_range(const key_type & key) const
+    {
+        return _table.equal_range(key);
+    }
+
+    /**
+     * @brief 返回匹配特定键的元素范围
+     * @details 异构查找，要求比较器定义is_transparent
+     */
+    template <class K, class C = key_compare, class = typename C::is_transparent>
+    std::pair<const_iterator, const_iterator> equal_range(const K & key) const
+    {
+        return _table.equal_range(key);
+    }
+
+    /**
+     * @brief 返回指向首个不小于给定键的元素的迭代器
+     */
+    iterator lower_bound(const key_type & key)
+    {
+        return _table.lower_bound(key);
+    }
+
+    /**
+     * @brief 返回指向首个不小于给定键的元素的迭代器
+     * @details 异构查找，要求比较器定义is_transparent
+     */
+    template <class K, class C = key_compare, class = typename C::is_transparent>
+    iterator lower_bound(const K & key)
+    {
+        return _table.lower_bound(key);
+    }
+
+    /**
+     * @brief 返回指向首个不小于给定键的元素的迭代器
+     */
+    const_iterator lower_bound(const key_type & key) const
+    {
+        return _table.lower_bound(key);
+    }
+
+    /**
+     * @brief 返回指向首个不小于给定键的元素的迭代器
+     * @details 异构查找，要求比较器定义is_transparent
+     */
+    template <class K, class C = key_compare, class = typename C::is_transparent>
+    const_iterator lower_bound(const K & key) const
+    {
+        return _table.lower_bound(key);
+    }
+
+    /**
+     * @brief 返回指向首个大于给定键的元素的迭代器
+     */
+    iterator upper_bound(const key_type & key)
+    {
+        return _table.upper_bound(key);
+    }
+
+    /**
+     * @brief 返回指向首个大于给定键的元素的迭代器
+     * @details 异构查找，要求比较器定义is_transparent
+     */
+    template <class K, class C = key_compare, class = typename C::is_transparent>
+    iterator upper_bound(const K & key)
+    {
+        return _table.upper_bound(key);
+    }
+
+    /**
+     * @brief 返回指向首个大于给定键的元素的迭代器
+     */
+    const_iterator upper_bound(const key_type & key) const
+    {
+        return _table.upper_bound(key);
+    }
+
+    /**
+     * @brief 返回指向首个大于给定键的元素的迭代器
+     * @details 异构查找，要求比较器定义is_transparent
+     */
+    template <class K, class C = key_compare, class = typename C::is_transparent>
+    const_iterator upper_bound(const K & key) const
+    {
+        return _table.upper_bound(key);
+    }
+
+    // 观察器
+
+    /**
+     * @brief 返回用于比较键的函数
+     */
+    key_compare key_comp() const
+    {
+        return _table._comp;
+    }
+
+    /**
+     * @brief 返回有序的键数组
+     */
+    const key_container_type & keys() const noexcept
+    {
+        return _table._keys;
+    }
+
+    /**
+     * @brief 返回与键对应的值数组
+     */
+    const mapped_container_type & values() const noexcept
+    {
+        return _table._values;
+    }
+};
+
+// 非成员函数
+
+template <
+    class Key,
+    class T,
+    class Compare,
+    class KeyContainer,
+    class MappedContainer
+> bool operator==(const flat_map<Key, T, Compare, KeyContainer, MappedContainer> & lhs, const flat_map<Key, T, Compare, KeyContainer, MappedContainer> & rhs)
+{
+    return lhs.size() == rhs.size()
+        && std::equal(lhs.keys().begin(), lhs.keys().end(), rhs.keys().begin())
+        && std::equal(lhs.values().begin(), lhs.values().end(), rhs.values().begin());
+}
+
+template <
+    class Key,
+    class T,
+    class Compare,
+    class KeyContainer,
+    class MappedContainer
+> bool operator!=(const flat_map<Key, T, Compare, KeyContainer, MappedContainer> & lhs, const flat_map<Key, T, Compare, KeyContainer, MappedContainer> & rhs)
+{
+    return !(lhs == rhs);
+}
+
+template <
+    class Key,
+    class T,
+    class Compare,
+    class KeyContainer,
+    class MappedContainer
+> bool operator<(const flat_map<Key, T, Compare, KeyContainer, MappedContainer> & lhs, const flat_map<Key, T, Compare, KeyContainer, MappedContainer> & rhs)
+{
+    return std::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
+}
+
+template <
+    class Key,
+    class T,
+    class Compare,
+    class KeyContainer,
+    class MappedContainer
+> bool operator>(const flat_map<Key, T, Compare, KeyContainer, MappedContainer> & lhs, const flat_map<Key, T, Compare, KeyContainer, MappedContainer> & rhs)
+{
+    return rhs < lhs;
+}
+
+template <
+    class Key,
+    class T,
+    class Compare,
+    class KeyContainer,
+    class MappedContainer
+> bool operator<=(const flat_map<Key, T, Compare, KeyContainer, MappedContainer> & lhs, const flat_map<Key, T, Compare, KeyContainer, MappedContainer> & rhs)
+{
+    return !(rhs < lhs);
+}
+
+template <
+    class Key,
+    class T,
+    class Compare,
+    class KeyContainer,
+    class MappedContainer
+> bool operator>=(const flat_map<Key, T, Compare, KeyContainer, MappedContainer> & lhs, const flat_map<Key, T, Compare, KeyContainer, MappedContainer> & rhs)
+{
+    return !(lhs < rhs);
+}
+
+template <
+    class Key,
+    class T,
+    class Compare,
+    class KeyContainer,
+    class MappedContainer
+> void swap(flat_map<Key, T, Compare, KeyContainer, MappedContainer> & lhs, flat_map<Key, T, Compare, KeyContainer, MappedContainer> & rhs)
+{
+    lhs.swap(rhs);
+}
+
+/**
+ * @brief flat_multimap
+ * @link https://zh.cppreference.com/w/cpp/container/flat_multimap
+ * @details 键和值分别存放在两个有序数组中，接口与multimap相同
+ * @details 迭代器解引用得到std::pair<const Key &, T &>，遍历时使用auto &&或const auto &
+ * @details 插入和删除会使所有迭代器失效
+ */
+template <
+    class Key,
+    class T,
+    class Compare = std::less<Key>,
+    class KeyContainer = wwstl::vector<Key>,
+    class MappedContainer = wwstl::vector<T>
+> class flat_multimap
+{
+public:
+    using key_type = Key;
+    using mapped_type = T;
+    using value_type = std::pair<Key, T>;
+    using key_compare = Compare;
+    using reference = std::pair<const Key &, T &>;
+    using const_reference = std::pair<const Key &, const T &>;
+    using size_type = std::size_t;
+    using difference_type = std::ptrdiff_t;
+    using key_container_type = KeyContainer;
+    using mapped_container_type = MappedContainer;
+    using iterator = typename wwstl::flat_table<Key, T, Compare, KeyContainer, MappedContainer>::iterator;
+    using const_iterator = typename wwstl::flat_table<Key, T, Compare, KeyContainer, MappedContainer>::const_iterator;
+    using reverse_iterator = typename wwstl::reverse_iterator<iterator>;
+    using const_reverse_iterator = typename wwstl::reverse_iterator<const_iterator>;
+
+public:
+    wwstl::flat_table<Key, T, Compare, KeyContainer, MappedContainer> _table;  // 有序数组
+
+public:
+    flat_multimap()
+        : flat_multimap(Compare())
+    {
+    }
+
+    explicit flat_multimap(const Compare & comp)
+        : _table(comp)
+    {
+    }
+
+    template <class InputIt>
+    flat_multimap(InputIt first, InputIt last, const Compare & comp = Compare())
+        : _table(comp)
+    {
+        _table.insert_range_equal(first, last);
+    }
+
+    flat_multimap(const flat_multimap & other)
+        : _table(other._table)
+    {
+    }
+
+    flat_multimap(flat_multimap && other)
+        : _table(std::move(other._table))
+    {
+    }
+
+    flat_multimap(std::initializer_list<value_type> init, const Compare & comp = Compare())
+        : _table(comp)
+    {
+        insert(init);
+    }
+
+public:
+    /**
+     * @brief 将值赋给容器
+     */
+    flat_multimap & operator=(const flat_multimap & other)
+    {
+        if (this != &other) {
+            _table = other._table;
+        }
+        return *this;
+    }
+
+    /**
+     * @brief 将值赋给容器
+     */
+    flat_multimap & operator=(flat_multimap && other)
+    {
+        if (this != &other) {
+            _table = std::move(other._table);
+        }
+        return *this;
+    }
+
+    /**
+     * @brief 将值赋给容器
+     */
+    flat_multimap & operator=(std::initializer_list<value_type> ilist)
+    {
+        clear();
+        insert(ilist);
+        return *this;
+    }
+
+    // 迭代器
+
+    /**
+     * @brief 返回指向起始的迭代器
+     */
+    iterator begin() noexcept
+    {
+        return _table.begin();
+    }
+
+    /**
+     * @brief 返回指向起始的迭代器
+     */
+    const_iterator begin() const noexcept
+    {
+        return _table.begin();
+    }
+
+    /**
+     * @brief 返回指向起始的迭代器
+     */
+    const_iterator cbegin() const noexcept
+    {
+        return _table.cbegin();
+    }
+
+    /**
+     * @brief 返回指向末尾的迭代器
+     */
+    iterator end() noexcept
+    {
+        return _table.end();
+    }
+
+    /**
+     * @brief 返回指向末尾的迭代器
+     */
+    const_iterator end() const noexcept
+    {
+        return _table.end();
+    }
+
+    /**
+     * @brief 返回指向末尾的迭代器
+     */
+    const_iterator cend() const noexcept
+    {
+        return _table.cend();
+    }
+
+    /**
+     * @brief 返回指向起始的逆向迭代器
+     */
+    reverse_iterator rbegin() noexcept
+    {
+        return reverse_iterator(end());
+    }
+
+    /**
+     * @brief 返回指向起始的逆向迭代器
+     */
+    const_reverse_iterator rbegin() const noexcept
+    {
+        return const_reverse_iterator(end());
+    }
+
+    /**
+     * @brief 返回指向起始的逆向迭代器
+     */
+    const_reverse_iterator crbegin() const noexcept
+    {
+        return const_reverse_iterator(cend());
+    }
+
+    /**
+     * @brief 返回指向末尾的逆向迭代器
+     */
+    reverse_iterator rend() noexcept
+    {
+        return reverse_iterator(begin());
+    }
+
+    /**
+     * @brief 返回指向末尾的逆向迭代器
+     */
+    const_reverse_iterator rend() const noexcept
+    {
+        return const_reverse_iterator(begin());
+    }
+
+    /**
+     * @brief 返回指向末尾的逆向迭代器
+     */
+    const_reverse_iterator crend() const noexcept
+    {
+        return const_reverse_iterator(cbegin());
+    }
+
+    // 容量
+
+    /**
+     * @brief 检查容器是否为空
+     */
+    bool empty() const noexcept
+    {
+        return _table.empty();
+    }
+
+    /**
+     * @brief 返回元素数
+     */
+    size_type size() const noexcept
+    {
+        return _table.size();
+    }
+
+    /**
+     * @brief 返回可容纳的最大元素数
+     */
+    size_type max_size() const noexcept
+    {
+        return _table.max_size();
+    }
+
+    /**
+     * @brief 为count个元素预留空间
+     */
+    void reserve(size_type count)
+    {
+        _table.reserve(count);
+    }
+
+    // 修改器
+
+    /**
+     * @brief 清除内容
+     */
+    void clear() noexcept
+    {
+        _table.clear();
+    }
+
+    /**
+     * @brief 插入元素
+     */
+    iterator insert(const value_type & value)
+    {
+        return _table.emplace_equal(value);
+    }
+
+    /**
+     * @brief 插入元素
+     * @details 通用插入函数，支持所有能够转换为value_type的参数
+     */
+    template <class P>
+    iterator insert(P && value)
+    {
+        return _table.emplace_equal(std::forward<P>(value));
+    }
+
+    /**
+     * @brief 插入元素
+     */
+    iterator insert(const_iterator hint, const value_type & value)
+    {
+        return _table.emplace_hint_equal(hint, value);
+    }
+
+    /**
+     * @brief 插入元素
+     */
+    template <class P>
+    iterator insert(const_iterator hint, P && value)
+    {
+        return _table.emplace_hint_equal(hint, std::forward<P>(value));
+    }
+
+    /**
+     * @brief 插入元素
+     * @details 新元素排序后与已有元素一次归并，复杂度O(n + m log m)
+     */
+    template <class InputIt>
+    void insert(InputIt first, InputIt last)
+    {
+        _table.insert_range_equal(first, last);
+    }
+
+    /**
+     * @brief 插入元素
+     */
+    void insert(std::initializer_list<value_type> ilist)
+    {
+        insert(ilist.begin(), ilist.end());
+    }
+
+    /**
+     * @brief 原位构造元素
+     */
+    template <class... Args>
+    iterator emplace(Args&&... args)
+    {
+        return _table.emplace_equal(std::forward<Args>(args)...);
+    }
+
+    /**
+     * @brief 使用提示原位构造元素
+     */
+    template <class... Args>
+    iterator emplace_hint(const_iterator hint, Args&&... args)
+    {
+        return _table.emplace_hint_equal(hint, std::forward<Args>(args)...);
+    }
+
+    /**
+     * @brief 擦除元素
+     */
+    iterator erase(const_iterator pos)
+    {
+        return _table.erase(pos);
+    }
+
+    /**
+     * @brief 擦除元素
+     */
+    iterator erase(const_iterator first, const_iterator last)
+    {
+        return _table.erase(first, last);
+    }
+
+    /**
+     * @brief 擦除元素
+     */
+    size_type erase(const key_type & key)
+    {
+        return _table.erase(key);
+    }
+
+    /**
+     * @brief 交换内容
+     */
+    void swap(flat_multimap & other) noexcept
+    {
+        _table.swap(other._table);
+    }
+
+    // 查找
+
+    /**
+     * @brief 返回匹配特定键的元素数量
+     */
+    size_type count(const key_type & key) const
+    {
+        return _table.count(key);
+    }
+
+    /**
+     * @brief 返回匹配特定键的元素数量
+     * @details 异构查找，要求比较器定义is_transparent
+     */
+    template <class K, class C = key_compare, class = typename C::is_transparent>
+    size_type count(const K & key) const
+    {
+        return _table.count(key);
+    }
+
+    /**
+     * @brief 寻找带有特定键的元素
+     */
+    iterator find(const key_type & key)
+    {
+        return _table.find(key);
+    }
+
+    /**
+     * @brief 寻找带有特定键的元素
+     * @details 异构查找，要求比较器定义is_transparent
+     */
+    template <class K, class C = key_compare, class = typename C::is_transparent>
+    iterator find(const K & key)
+    {
+        return _table.find(key);
+    }
+
+    /**
+     * @brief 寻找带有特定键的元素
+     */
+    const_iterator find(const key_type & key) const
+    {
+        return _table.find(key);
+    }
+
+    /**
+     * @brief 寻找带有特定键的元素
+     * @details 异构查找，要求比较器定义is_transparent
+     */
+    template <class K, class C = key_compare, class = typename C::is_transparent>
+    const_iterator find(const K & key) const
+    {
+        return _table.find(key);
+    }
+
+    /**
+     * @brief 返回匹配特定键的元素范围
+     */
+    std::pair<iterator, iterator> equal_range(const key_type & key)
+    {
+        return _table.equal_range(key);
+    }
+
+    /**
+     * @brief 返回匹配特定键的元素范围
+     * @details 异构查找，要求比较器定义is_transparent
+     */
+    template <class K, class C = key_compare, class = typename C::is_transparent>
+    std::pair<iterator, iterator> equal_range(const K & key)
+    {
+        return _table.equal_range(key);
+    }
+
+    /**
+     * @brief 返回匹配特定键的元素范围
+     */
+    std::pair<const_iterator, const_iterator> equal_range(const key_type & key) const
+    {
+        return _table.equal_range(key);
+    }
+
+    /**
+     * @brief 返回匹配特定键的元素范围
+     * @details 异构查找，要求比较器定义is_transparent
+     */
+    template <class K, class C = key_compare, class = typename C::is_transparent>
+    std::pair<const_iterator, const_iterator> equal_range(const K & key) const
+    {
+        return _table.equal_range(key);
+    }
+
+    /**
+     * @brief 返回指向首个不小于给定键的元素的迭代器
+     */
+    iterator lower_bound(const key_type & key)
+    {
+        return _table.lower_bound(key);
+    }
+
+    /**
+     * @brief 返回指向首个不小于给定键的元素的迭代器
+     * @details 异构查找，要求比较器定义is_transparent
+     */
+    template <class K, class C = key_compare, class = typename C::is_transparent>
+    iterator lower_bound(const K & key)
+    {
+        return _table.lower_bound(key);
+    }
+
+    /**
+     * @brief 返回指向首个不小于给定键的元素的迭代器
+     */
+    const_iterator lower_bound(const key_type & key) const
+    {
+        return _table.lower_bound(key);
+    }
+
+    /**
+     * @brief 返回指向首个不小于给定键的元素的迭代器
+     * @details 异构查找，要求比较器定义is_transparent
+     */
+    template <class K, class C = key_compare, class = typename C::is_transparent>
+    const_iterator lower_bound(const K & key) const
+    {
+        return _table.lower_bound(key);
+    }
+
+    /**
+     * @brief 返回指向首个大于给定键的元素的迭代器
+     */
+    iterator upper_bound(const key_type & key)
+    {
+        return _table.upper_bound(key);
+    }
+
+    /**
+     * @brief 返回指向首个大于给定键的元素的迭代器
+     * @details 异构查找，要求比较器定义is_transparent
+     */
+    template <class K, class C = key_compare, class = typename C::is_transparent>
+    iterator upper_bound(const K & key)
+    {
+        return _table.upper_bound(key);
+    }
+
+    /**
+     * @brief 返回指向首个大于给定键的元素的迭代器
+     */
+    const_iterator upper_bound(const key_type & key) const
+    {
+        return _table.upper_bound(key);
+    }
+
+    /**
+     * @brief 返回指向首个大于给定键的元素的迭代器
+     * @details 异构查找，要求比较器定义is_transparent
+     */
+    template <class K, class C = key_compare, class = typename C::is_transparent>
+    const_iterator upper_bound(const K & key) const
+    {
+        return _table.upper_bound(key);
+    }
+
+    // 观察器
+
+    /**
+     * @brief 返回用于比较键的函数
+     */
+    key_compare key_comp() const
+    {
+        return _table._comp;
+    }
+
+    /**
+     * @brief 返回有序的键数组
+     */
+    const key_container_type & keys() const noexcept
+    {
+        return _table._keys;
+    }
+
+    /**
+     * @brief 返回与键对应的值数组
+     */
+    const mapped_container_type & values() const noexcept
+    {
+        return _table._values;
+    }
+};
+
+// 非成员函数
+
+template <
+    class Key,
+    class T,
+    class Compare,
+    class KeyContainer,
+    class MappedContainer
+> bool operator==(const flat_multimap<Key, T, Compare, KeyContainer, MappedContainer> & lhs, const flat_multimap<Key, T, Compare, KeyContainer, MappedContainer> & rhs)
+{
+    return lhs.size() == rhs.size()
+        && std::equal(lhs.keys().begin(), lhs.keys().end(), rhs.keys().begin())
+        && std::equal(lhs.values().begin(), lhs.values().end(), rhs.values().begin());
+}
+
+template <
+    class Key,
+    class T,
+    class Compare,
+    class KeyContainer,
+    class MappedContainer
+> bool operator!=(const flat_multimap<Key, T, Compare, KeyContainer, MappedContainer> & lhs, const flat_multimap<Key, T, Compare, KeyContainer, MappedContainer> & rhs)
+{
+    return !(lhs == rhs);
+}
+
+template <
+    class Key,
+    class T,
+    class Compare,
+    class KeyContainer,
+    class MappedContainer
+> bool operator<(const flat_multimap<Key, T, Compare, KeyContainer, MappedContainer> & lhs, const flat_multimap<Key, T, Compare, KeyContainer, MappedContainer> & rhs)
+{
+    return std::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
+}
+
+template <
+    class Key,
+    class T,
+    class Compare,
+    class KeyContainer,
+    class MappedContainer
+> bool operator>(const flat_multimap<Key, T, Compare, KeyContainer, MappedContainer> & lhs, const flat_multimap<Key, T, Compare, KeyContainer, MappedContainer> & rhs)
+{
+    return rhs < lhs;
+}
+
+template <
+    class Key,
+    class T,
+    class Compare,
+    class KeyContainer,
+    class MappedContainer
+> bool operator<=(const flat_multimap<Key, T, Compare, KeyContainer, MappedContainer> & lhs, const flat_multimap<Key, T, Compare, KeyContainer, MappedContainer> & rhs)
+{
+    return !(rhs < lhs);
+}
+
+template <
+    class Key,
+    class T,
+    class Compare,
+    class KeyContainer,
+    class MappedContainer
+> bool operator>=(const flat_multimap<Key, T, Compare, KeyContainer, MappedContainer> & lhs, const flat_multimap<Key, T, Compare, KeyContainer, MappedContainer> & rhs)
+{
+    return !(lhs < rhs);
+}
+
+template <
+    class Key,
+    class T,
+    class Compare,
+    class KeyContainer,
+    class MappedContainer
+> void swap(flat_multimap<Key, T, Compare, KeyContainer, MappedContainer> & lhs, flat_multimap<Key, T, Compare, KeyContainer, MappedContainer> & rhs)
+{
+    lhs.swap(rhs);
+}
+
+} // namespace wwstl
+
+#endif // __WW_FLAT_MAP_H__
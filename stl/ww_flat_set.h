@@ -0,0 +1,980 @@
+#ifndef __WW_FLAT_SET_H__
+#define __WW_FLAT_SET_H__
+
+#include <initializer_list>
+#include "ww_flat_table.h"
+
+namespace wwstl
+{
+
+/**
+ * @brief flat_set
+ * @link https://zh.cppreference.com/w/cpp/container/flat_set
+ * @details 键存放在一个有序数组中，接口与set相同
+ * @details 插入和删除会使所有迭代器失效
+ */
+template <
+    class Key,
+    class Compare = std::less<Key>,
+    class KeyContainer = wwstl::vector<Key>
+> class flat_set
+{
+public:
+    using key_type = Key;
+    using value_type = Key;
+    using key_compare = Compare;
+    using value_compare = Compare;
+    using reference = value_type &;
+    using const_reference = const value_type &;
+    using size_type = std::size_t;
+    using difference_type = std::ptrdiff_t;
+    using container_type = KeyContainer;
+    using iterator = typename wwstl::flat_table<Key, void, Compare, KeyContainer, _flat_no_values>::iterator;
+    using const_iterator = typename wwstl::flat_table<Key, void, Compare, KeyContainer, _flat_no_values>::const_iterator;
+    using reverse_iterator = typename wwstl::reverse_iterator<iterator>;
+    using const_reverse_iterator = typename wwstl::reverse_iterator<const_iterator>;
+
+public:
+    wwstl::flat_table<Key, void, Compare, KeyContainer, _flat_no_values> _table;  // 有序数组
+
+public:
+    flat_set()
+        : flat_set(Compare())
+    {
+    }
+
+    explicit flat_set(const Compare & comp)
+        : _table(comp)
+    {
+    }
+
+    template <class InputIt>
+    flat_set(InputIt first, InputIt last, const Compare & comp = Compare())
+        : _table(comp)
+    {
+        _table.insert_range_unique(first, last);
+    }
+
+    flat_set(const flat_set & other)
+        : _table(other._table)
+    {
+    }
+
+    flat_set(flat_set && other)
+        : _table(std::move(other._table))
+    {
+    }
+
+    flat_set(std::initializer_list<value_type> init, const Compare & comp = Compare())
+        : _table(comp)
+    {
+        insert(init);
+    }
+
+public:
+    /**
+     * @brief 将值赋给容器
+     */
+    flat_set & operator=(const flat_set & other)
+    {
+        if (this != &other) {
+            _table = other._table;
+        }
+        return *this;
+    }
+
+    /**
+     * @brief 将值赋给容器
+     */
+    flat_set & operator=(flat_set && other)
+    {
+        if (this != &other) {
+            _table = std::move(other._table);
+        }
+        return *this;
+    }
+
+    /**
+     * @brief 将值赋给容器
+     */
+    flat_set & operator=(std::initializer_list<value_type> ilist)
+    {
+        clear();
+        insert(ilist);
+        return *this;
+    }
+
+    // 迭代器
+
+    /**
+     * @brief 返回指向起始的迭代器
+     */
+    iterator begin() const noexcept
+    {
+        return _table.begin();
+    }
+
+    /**
+     * @brief 返回指向起始的迭代器
+     */
+    const_iterator cbegin() const noexcept
+    {
+        return _table.cbegin();
+    }
+
+    /**
+     * @brief 返回指向末尾的迭代器
+     */
+    iterator end() const noexcept
+    {
+        return _table.end();
+    }
+
+    /**
+     * @brief 返回指向末尾的迭代器
+     */
+    const_iterator cend() const noexcept
+    {
+        return _table.cend();
+    }
+
+    /**
+     * @brief 返回指向起始的逆向迭代器
+     */
+    reverse_iterator rbegin() const noexcept
+    {
+        return reverse_iterator(end());
+    }
+
+    /**
+     * @brief 返回指向起始的逆向迭代器
+     */
+    const_reverse_iterator crbegin() const noexcept
+    {
+        return const_reverse_iterator(cend());
+    }
+
+    /**
+     * @brief 返回指向末尾的逆向迭代器
+     */
+    reverse_iterator rend() const noexcept
+    {
+        return reverse_iterator(begin());
+    }
+
+    /**
+     * @brief 返回指向末尾的逆向迭代器
+     */
+    const_reverse_iterator crend() const noexcept
+    {
+        return const_reverse_iterator(cbegin());
+    }
+
+    // 容量
+
+    /**
+     * @brief 检查容器是否为空
+     */
+    bool empty() const noexcept
+    {
+        return _table.empty();
+    }
+
+    /**
+     * @brief 返回元素数
+     */
+    size_type size() const noexcept
+    {
+        return _table.size();
+    }
+
+    /**
+     * @brief 返回可容纳的最大元素数
+     */
+    size_type max_size() const noexcept
+    {
+        return _table.max_size();
+    }
+
+    /**
+     * @brief 为count个元素预留空间
+     */
+    void reserve(size_type count)
+    {
+        _table.reserve(count);
+    }
+
+    // 修改器
+
+    /**
+     * @brief 清除内容
+     */
+    void clear() noexcept
+    {
+        _table.clear();
+    }
+
+    /**
+     * @brief 插入元素
+     */
+    std::pair<iterator, bool> insert(const value_type & value)
+    {
+        return _table.emplace_unique(value);
+    }
+
+    /**
+     * @brief 插入元素
+     */
+    std::pair<iterator, bool> insert(value_type && value)
+    {
+        return _table.emplace_unique(std::move(value));
+    }
+
+    /**
+     * @brief 插入元素
+     */
+    iterator insert(const_iterator hint, const value_type & value)
+    {
+        return _table.emplace_hint_unique(hint, value);
+    }
+
+    /**
+     * @brief 插入元素
+     */
+    iterator insert(const_iterator hint, value_type && value)
+    {
+        return _table.emplace_hint_unique(hint, std::move(value));
+    }
+
+    /**
+     * @brief 插入元素
+     * @details 新元素排序后与已有元素一次归并，复杂度O(n + m log m)
+     */
+    template <class InputIt>
+    void insert(InputIt first, InputIt last)
+    {
+        _table.insert_range_unique(first, last);
+    }
+
+    /**
+     * @brief 插入元素
+     */
+    void insert(std::initializer_list<value_type> ilist)
+    {
+        insert(ilist.begin(), ilist.end());
+    }
+
+    /**
+     * @brief 原位构造元素
+     */
+    template <class... Args>
+    std::pair<iterator, bool> emplace(Args&&... args)
+    {
+        return _table.emplace_unique(std::forward<Args>(args)...);
+    }
+
+    /**
+     * @brief 使用提示原位构造元素
+     * @details 提示位置恰好满足顺序时不需要查找
+     */
+    template <class... Args>
+    iterator emplace_hint(const_iterator hint, Args&&... args)
+    {
+        return _table.emplace_hint_unique(hint, std::forward<Args>(args)...);
+    }
+
+    /**
+     * @brief 擦除元素
+     */
+    iterator erase(const_iterator pos)
+    {
+        return _table.erase(pos);
+    }
+
+    /**
+     * @brief 擦除元素
+     */
+    iterator erase(const_iterator first, const_iterator last)
+    {
+        return _table.erase(first, last);
+    }
+
+    /**
+     * @brief 擦除元素
+     */
+    size_type erase(const key_type & key)
+    {
+        return _table.erase(key);
+    }
+
+    /**
+     * @brief 交换内容
+     */
+    void swap(flat_set & other) noexcept
+    {
+        _table.swap(other._table);
+    }
+
+    // 查找
+
+    /**
+     * @brief 返回匹配特定键的元素数量
+     */
+    size_type count(const key_type & key) const
+    {
+        return _table.count(key);
+    }
+
+    /**
+     * @brief 返回匹配特定键的元素数量
+     * @details 异构查找，要求比较器定义is_transparent
+     */
+    template <class K, class C = key_compare, class = typename C::is_transparent>
+    size_type count(const K & key) const
+    {
+        return _table.count(key);
+    }
+
+    /**
+     * @brief 寻找带有特定键的元素
+     */
+    iterator find(const key_type & key) const
+    {
+        return _table.find(key);
+    }
+
+    /**
+     * @brief 寻找带有特定键的元素
+     * @details 异构查找，要求比较器定义is_transparent
+     */
+    template <class K, class C = key_compare, class = typename C::is_transparent>
+    iterator find(const K & key) const
+    {
+        return _table.find(key);
+    }
+
+    /**
+     * @brief 返回匹配特定键的元素范围
+     */
+    std::pair<iterator, iterator> equal_range(const key_type & key) const
+    {
+        return _table.equal_range(key);
+    }
+
+    /**
+     * @brief 返回匹配特定键的元素范围
+     * @details 异构查找，要求比较器定义is_transparent
+     */
+    template <class K, class C = key_compare, class = typename C::is_transparent>
+    std::pair<iterator, iterator> equal_range(const K & key) const
+    {
+        return _table.equal_range(key);
+    }
+
+    /**
+     * @brief 返回指向首个不小于给定键的元素的迭代器
+     */
+    iterator lower_bound(const key_type & key) const
+    {
+        return _table.lower_bound(key);
+    }
+
+    /**
+     * @brief 返回指向首个不小于给定键的元素的迭代器
+     * @details 异构查找，要求比较器定义is_transparent
+     */
+    template <class K, class C = key_compare, class = typename C::is_transparent>
+    iterator lower_bound(const K & key) const
+    {
+        return _table.lower_bound(key);
+    }
+
+    /**
+     * @brief 返回指向首个大于给定键的元素的迭代器
+     */
+    iterator upper_bound(const key_type & key) const
+    {
+        return _table.upper_bound(key);
+    }
+
+    /**
+     * @brief 返回指向首个大于给定键的元素的迭代器
+     * @details 异构查找，要求比较器定义is_transparent
+     */
+    template <class K, class C = key_compare, class = typename C::is_transparent>
+    iterator upper_bound(const K & key) const
+    {
+        return _table.upper_bound(key);
+    }
+
+    // 观察器
+
+    /**
+     * @brief 返回用于比较键的函数
+     */
+    key_compare key_comp() const
+    {
+        return _table._comp;
+    }
+
+    /**
+     * @brief 返回用于比较值的函数
+     */
+    value_compare value_comp() const
+    {
+        return _table._comp;
+    }
+};
+
+// 非成员函数
+
+template <
+    class Key,
+    class Compare,
+    class KeyContainer
+> bool operator==(const flat_set<Key, Compare, KeyContainer> & lhs, const flat_set<Key, Compare, KeyContainer> & rhs)
+{
+    return lhs.size() == rhs.size() && std::equal(lhs.begin(), lhs.end(), rhs.begin());
+}
+
+template <
+    class Key,
+    class Compare,
+    class KeyContainer
+> bool operator!=(const flat_set<Key, Compare, KeyContainer> & lhs, const flat_set<Key, Compare, KeyContainer> & rhs)
+{
+    return !(lhs == rhs);
+}
+
+template <
+    class Key,
+    class Compare,
+    class KeyContainer
+> bool operator<(const flat_set<Key, Compare, KeyContainer> & lhs, const flat_set<Key, Compare, KeyContainer> & rhs)
+{
+    return std::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
+}
+
+template <
+    class Key,
+    class Compare,
+    class KeyContainer
+> bool operator>(const flat_set<Key, Compare, KeyContainer> & lhs, const flat_set<Key, Compare, KeyContainer> & rhs)
+{
+    return rhs < lhs;
+}
+
+template <
+    class Key,
+    class Compare,
+    class KeyContainer
+> bool operator<=(const flat_set<Key, Compare, KeyContainer> & lhs, const flat_set<Key, Compare, KeyContainer> & rhs)
+{
+    return !(rhs < lhs);
+}
+
+template <
+    class Key,
+    class Compare,
+    class KeyContainer
+> bool operator>=(const flat_set<Key, Compare, KeyContainer> & lhs, const flat_set<Key, Compare, KeyContainer> & rhs)
+{
+    return !(lhs < rhs);
+}
+
+template <
+    class Key,
+    class Compare,
+    class KeyContainer
+> void swap(flat_set<Key, Compare, KeyContainer> & lhs, flat_set<Key, Compare, KeyContainer> & rhs)
+{
+    lhs.swap(rhs);
+}
+
+/**
+ * @brief flat_multiset
+ * @link https://zh.cppreference.com/w/cpp/container/flat_multiset
+ * @details 键存放在一个有序数组中，接口与multiset相同
+ * @details 插入和删除会使所有迭代器失效
+ */
+template <
+    class Key,
+    class Compare = std::less<Key>,
+    class KeyContainer = wwstl::vector<Key>
+> class flat_multiset
+{
+public:
+    using key_type = Key;
+    using value_type = Key;
+    using key_compare = Compare;
+    using value_compare = Compare;
+    using reference = value_type &;
+    using const_reference = const value_type &;
+    using size_type = std::size_t;
+    using difference_type = std::ptrdiff_t;
+    using container_type = KeyContainer;
+    using iterator = typename wwstl::flat_table<Key, void, Compare, KeyContainer, _flat_no_values>::iterator;
+    using const_iterator = typename wwstl::flat_table<Key, void, Compare, KeyContainer, _flat_no_values>::const_iterator;
+    using reverse_iterator = typename wwstl::reverse_iterator<iterator>;
+    using const_reverse_iterator = typename wwstl::reverse_iterator<const_iterator>;
+
+public:
+    wwstl::flat_table<Key, void, Compare, KeyContainer, _flat_no_values> _table;  // 有序数组
+
+public:
+    flat_multiset()
+        : flat_multiset(Compare())
+    {
+    }
+
+    explicit flat_multiset(const Compare & comp)
+        : _table(comp)
+    {
+    }
+
+    template <class InputIt>
+    flat_multiset(InputIt first, InputIt last, const Compare & comp = Compare())
+        : _table(comp)
+    {
+        _table.insert_range_equal(first, last);
+    }
+
+    flat_multiset(const flat_multiset & other)
+        : _table(other._table)
+    {
+    }
+
+    flat_multiset(flat_multiset && other)
+        : _table(std::move(other._table))
+    {
+    }
+
+    flat_multiset(std::initializer_list<value_type> init, const Compare & comp = Compare())
+        : _table(comp)
+    {
+        insert(init);
+    }
+
+public:
+    /**
+     * @brief 将值赋给容器
+     */
+    flat_multiset & operator=(const flat_multiset & other)
+    {
+        if (this != &other) {
+            _table = other._table;
+        }
+        return *this;
+    }
+
+    /**
+     * @brief 将值赋给容器
+     */
+    flat_multiset & operator=(flat_multiset && other)
+    {
+        if (this != &other) {
+            _table = std::move(other._table);
+        }
+        return *this;
+    }
+
+    /**
+     * @brief 将值赋给容器
+     */
+    flat_multiset & operator=(std::initializer_list<value_type> ilist)
+    {
+        clear();
+        insert(ilist);
+        return *this;
+    }
+
+    // 迭代器
+
+    /**
+     * @brief 返回指向起始的迭代器
+     */
+    iterator begin() const noexcept
+    {
+        return _table.begin();
+    }
+
+    /**
+     * @brief 返回指向起始的迭代器
+     */
+    const_iterator cbegin() const noexcept
+    {
+        return _table.cbegin();
+    }
+
+    /**
+     * @brief 返回指向末尾的迭代器
+     */
+    iterator end() const noexcept
+    {
+        return _table.end();
+    }
+
+    /**
+     * @brief 返回指向末尾的迭代器
+     */
+    const_iterator cend() const noexcept
+    {
+        return _table.cend();
+    }
+
+    /**
+     * @brief 返回指向起始的逆向迭代器
+     */
+    reverse_iterator rbegin() const noexcept
+    {
+        return reverse_iterator(end());
+    }
+
+    /**
+     * @brief 返回指向起始的逆向迭代器
+     */
+    const_reverse_iterator crbegin() const noexcept
+    {
+        return const_reverse_iterator(cend());
+    }
+
+    /**
+     * @brief 返回指向末尾的逆向迭代器
+     */
+    reverse_iterator rend() const noexcept
+    {
+        return reverse_iterator(begin());
+    }
+
+    /**
+     * @brief 返回指向末尾的逆向迭代器
+     */
+    const_reverse_iterator crend() const noexcept
+    {
+        return const_reverse_iterator(cbegin());
+    }
+
+    // 容量
+
+    /**
+     * @brief 检查容器是否为空
+     */
+    bool empty() const noexcept
+    {
+        return _table.empty();
+    }
+
+    /**
+     * @brief 返回元素数
+     */
+    size_type size() const noexcept
+    {
+        return _table.size();
+    }
+
+    /**
+     * @brief 返回可容纳的最大元素数
+     */
+    size_type max_size() const noexcept
+    {
+        return _table.max_size();
+    }
+
+    /**
+     * @brief 为count个元素预留空间
+     */
+    void reserve(size_type count)
+    {
+        _table.reserve(count);
+    }
+
+    // 修改器
+
+    /**
+     * @brief 清除内容
+     */
+    void clear() noexcept
+    {
+        _table.clear();
+    }
+
+    /**
+     * @brief 插入元素
+     */
+    iterator insert(const value_type & value)
+    {
+        return _table.emplace_equal(value);
+    }
+
+    /**
+     * @brief 插入元素
+     */
+    iterator insert(value_type && value)
+    {
+        return _table.emplace_equal(std::move(value));
+    }
+
+    /**
+     * @brief 插入元素
+     */
+    iterator insert(const_iterator hint, const value_type & value)
+    {
+        return _table.emplace_hint_equal(hint, value);
+    }
+
+    /**
+     * @brief 插入元素
+     */
+    iterator insert(const_iterator hint, value_type && value)
+    {
+        return _table.emplace_hint_equal(hint, std::move(value));
+    }
+
+    /**
+     * @brief 插入元素
+     * @details 新元素排序后与已有元素一次归并，复杂度O(n + m log m)
+     */
+    template <class InputIt>
+    void insert(InputIt first, InputIt last)
+    {
+        _table.insert_range_equal(first, last);
+    }
+
+    /**
+     * @brief 插入元素
+     */
+    void insert(std::initializer_list<value_type> ilist)
+    {
+        insert(ilist.begin(), ilist.end());
+    }
+
+    /**
+     * @brief 原位构造元素
+     */
+    template <class... Args>
+    iterator emplace(Args&&... args)
+    {
+        return _table.emplace_equal(std::forward<Args>(args)...);
+    }
+
+    /**
+     * @brief 使用提示原位构造元素
+     * @details 提示位置恰好满足顺序时不需要查找
+     */
+    template <class... Args>
+    iterator emplace_hint(const_iterator hint, Args&&... args)
+    {
+        return _table.emplace_hint_equal(hint, std::forward<Args>(args)...);
+    }
+
+    /**
+     * @brief 擦除元素
+     */
+    iterator erase(const_iterator pos)
+    {
+        return _table.erase(pos);
+    }
+
+    /**
+     * @brief 擦除元素
+     */
+    iterator erase(const_iterator first, const_iterator last)
+    {
+        return _table.erase(first, last);
+    }
+
+    /**
+     * @brief 擦除元素
+     */
+    size_type erase(const key_type & key)
+    {
+        return _table.erase(key);
+    }
+
+    /**
+     * @brief 交换内容
+     */
+    void swap(flat_multiset & other) noexcept
+    {
+        _table.swap(other._table);
+    }
+
+    // 查找
+
+    /**
+     * @brief 返回匹配特定键的元素数量
+     */
+    size_type count(const key_type & key) const
+    {
+        return _table.count(key);
+    }
+
+    /**
+     * @brief 返回匹配特定键的元素数量
+     * @details 异构查找，要求比较器定义is_transparent
+     */
+    template <class K, class C = key_compare, class = typename C::is_transparent>
+    size_type count(const K & key) const
+    {
+        return _table.count(key);
+    }
+
+    /**
+     * @brief 寻找带有特定键的元素
+     */
+    iterator find(const key_type & key) const
+    {
+        return _table.find(key);
+    }
+
+    /**
+     * @brief 寻找带有特定键的元素
+     * @details 异构查找，要求比较器定义is_transparent
+     */
+    template <class K, class C = key_compare, class = typename C::is_transparent>
+    iterator find(const K & key) const
+    {
+        return _table.find(key);
+    }
+
+    /**
+     * @brief 返回匹配特定键的元素范围
+     */
+    std::pair<iterator, iterator> equal_range(const key_type & key) const
+    {
+        return _table.equal_range(key);
+    }
+
+    /**
+     * @brief 返回匹配特定键的元素范围
+     * @details 异构查找，要求比较器定义is_transparent
+     */
+    template <class K, class C = key_compare, class = typename C::is_transparent>
+    std::pair<iterator, iterator> equal_range(const K & key) const
+    {
+        return _table.equal_range(key);
+    }
+
+    /**
+     * @brief 返回指向首个不小于给定键的元素的迭代器
+     */
+    iterator lower_bound(const key_type & key) const
+    {
+        return _table.lower_bound(key);
+    }
+
+    /**
+     * @brief 返回指向首个不小于给定键的元素的迭代器
+     * @details 异构查找，要求比较器定义is_transparent
+     */
+    template <class K, class C = key_compare, class = typename C::is_transparent>
+    iterator lower_bound(const K & key) const
+    {
+        return _table.lower_bound(key);
+    }
+
+    /**
+     * @brief 返回指向首个大于给定键的元素的迭代器
+     */
+    iterator upper_bound(const key_type & key) const
+    {
+        return _table.upper_bound(key);
+    }
+
+    /**
+     * @brief 返回指向首个大于给定键的元素的迭代器
+     * @details 异构查找，要求比较器定义is_transparent
+     */
+    template <class K, class C = key_compare, class = typename C::is_transparent>
+    iterator upper_bound(const K & key) const
+    {
+        return _table.upper_bound(key);
+    }
+
+    // 观察器
+
+    /**
+     * @brief 返回用于比较键的函数
+     */
+    key_compare key_comp() const
+    {
+        return _table._comp;
+    }
+
+    /**
+     * @brief 返回用于比较值的函数
+     */
+    value_compare value_comp() const
+    {
+        return _table._comp;
+    }
+};
+
+// 非成员函数
+
+template <
+    class Key,
+    class Compare,
+    class KeyContainer
+> bool operator==(const flat_multiset<Key, Compare, KeyContainer> & lhs, const flat_multiset<Key, Compare, KeyContainer> & rhs)
+{
+    return lhs.size() == rhs.size() && std::equal(lhs.begin(), lhs.end(), rhs.begin());
+}
+
+template <
+    class Key,
+    class Compare,
+    class KeyContainer
+> bool operator!=(const flat_multiset<Key, Compare, KeyContainer> & lhs, const flat_multiset<Key, Compare, KeyContainer> & rhs)
+{
+    return !(lhs == rhs);
+}
+
+template <
+    class Key,
+    class Compare,
+    class KeyContainer
+> bool operator<(const flat_multiset<Key, Compare, KeyContainer> & lhs, const flat_multiset<Key, Compare, KeyContainer> & rhs)
+{
+    return std::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
+}
+
+template <
+    class Key,
+    class Compare,
+    class KeyContainer
+> bool operator>(const flat_multiset<Key, Compare, KeyContainer> & lhs, const flat_multiset<Key, Compare, KeyContainer> & rhs)
+{
+    return rhs < lhs;
+}
+
+template <
+    class Key,
+    class Compare,
+    class KeyContainer
+> bool operator<=(const flat_multiset<Key, Compare, KeyContainer> & lhs, const flat_multiset<Key, Compare, KeyContainer> & rhs)
+{
+    return !(rhs < lhs);
+}
+
+template <
+    class Key,
+    class Compare,
+    class KeyContainer
+> bool operator>=(const flat_multiset<Key, Compare, KeyContainer> & lhs, const flat_multiset<Key, Compare, KeyContainer> & rhs)
+{
+    return !(lhs < rhs);
+}
+
+template <
+    class Key,
+    class Compare,
+    class KeyContainer
+> void swap(flat_multiset<Key, Compare, KeyContainer> & lhs, flat_multiset<Key, Compare, KeyContainer> & rhs)
+{
+    lhs.swap(rhs);
+}
+
+} // namespace wwstl
+
+#endif // __WW_FLAT_SET_H__
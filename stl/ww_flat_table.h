@@ -0,0 +1,877 @@
+#ifndef __WW_FLAT_TABLE_H__
+#define __WW_FLAT_TABLE_H__
+
+#include <algorithm>
+#include <functional>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include "ww_iterator.h"
+#include "ww_vector.h"
+
+namespace wwstl
+{
+
+/**
+ * @brief 无分支的lower_bound
+ * @details 每轮只根据一次比较决定区间起点，编译器可以生成条件传送，查找过程没有难以预测的分支
+ */
+template <class RandomIt, class K, class Compare>
+RandomIt _branchless_lower_bound(RandomIt first, std::size_t n, const K & key, const Compare & comp)
+{
+    if (n == 0) {
+        return first;
+    }
+    while (n > 1) {
+        std::size_t half = n / 2;
+        first = comp(*(first + half), key) ? first + half : first;
+        n -= half;
+    }
+    return comp(*first, key) ? first + 1 : first;
+}
+
+/**
+ * @brief 无分支的upper_bound
+ */
+template <class RandomIt, class K, class Compare>
+RandomIt _branchless_upper_bound(RandomIt first, std::size_t n, const K & key, const Compare & comp)
+{
+    if (n == 0) {
+        return first;
+    }
+    while (n > 1) {
+        std::size_t half = n / 2;
+        first = comp(key, *(first + half)) ? first : first + half;
+        n -= half;
+    }
+    return comp(key, *first) ? first : first + 1;
+}
+
+/**
+ * @brief flat_table迭代器的operator->返回值
+ * @details 迭代器的引用是临时构造的pair，需要保存一份才能取地址
+ */
+template <class Reference>
+class _flat_table_arrow_proxy
+{
+public:
+    Reference _ref;
+
+public:
+    Reference * operator->()
+    {
+        return &_ref;
+    }
+};
+
+/**
+ * @brief flat_table迭代器
+ * @details 同时指向键数组和值数组的相同下标，解引用得到由两个引用组成的pair
+ */
+template <class KeyIter, class MappedIter>
+class _flat_table_iterator
+{
+public:
+    using iterator_category = std::random_access_iterator_tag;
+    using value_type = std::pair<
+        typename wwstl::iterator_traits<KeyIter>::value_type,
+        typename wwstl::iterator_traits<MappedIter>::value_type
+    >;
+    using difference_type = std::ptrdiff_t;
+    using reference = std::pair<
+        typename wwstl::iterator_traits<KeyIter>::reference,
+        typename wwstl::iterator_traits<MappedIter>::reference
+    >;
+    using pointer = _flat_table_arrow_proxy<reference>;
+
+    using self = _flat_table_iterator<KeyIter, MappedIter>;
+
+public:
+    KeyIter _key;           // 键数组中的位置
+    MappedIter _mapped;     // 值数组中的位置
+
+public:
+    _flat_table_iterator()
+        : _key()
+        , _mapped()
+    { // 空迭代器
+    }
+
+    _flat_table_iterator(KeyIter key, MappedIter mapped)
+        : _key(key)
+        , _mapped(mapped)
+    {
+    }
+
+    template <class OtherKeyIter, class OtherMappedIter>
+    _flat_table_iterator(const _flat_table_iterator<OtherKeyIter, OtherMappedIter> & other)
+        : _key(other._key)
+        , _mapped(other._mapped)
+    { // 从非常量迭代器转换
+    }
+
+public:
+    reference operator*() const
+    {
+        return reference(*_key, *_mapped);
+    }
+
+    pointer operator->() const
+    {
+        return pointer{operator*()};
+    }
+
+    reference operator[](difference_type n) const
+    {
+        return *(*this + n);
+    }
+
+    self & operator++()
+    {
+        ++_key;
+        ++_mapped;
+        return *this;
+    }
+
+    self operator++(int)
+    {
+        self tmp = *this;
+        ++*this;
+        return tmp;
+    }
+
+    self & operator--()
+    {
+        --_key;
+        --_mapped;
+        return *this;
+    }
+
+    self operator--(int)
+    {
+        self tmp = *this;
+        --*this;
+        return tmp;
+    }
+
+    self & operator+=(difference_type n)
+    {
+        _key += n;
+        _mapped += n;
+        return *this;
+    }
+
+    self & operator-=(difference_type n)
+    {
+        return *this += -n;
+    }
+
+    self operator+(difference_type n) const
+    {
+        self tmp = *this;
+        return tmp += n;
+    }
+
+    self operator-(difference_type n) const
+    {
+        self tmp = *this;
+        return tmp -= n;
+    }
+
+    /**
+     * @brief 比较操作符
+     * @details 只比较键数组的位置，常量与非常量迭代器之间也可以比较
+     */
+    template <class OtherKeyIter, class OtherMappedIter>
+    difference_type operator-(const _flat_table_iterator<OtherKeyIter, OtherMappedIter> & other) const
+    {
+        return _key - other._key;
+    }
+
+    template <class OtherKeyIter, class OtherMappedIter>
+    bool operator==(const _flat_table_iterator<OtherKeyIter, OtherMappedIter> & other) const
+    {
+        return _key == other._key;
+    }
+
+    template <class OtherKeyIter, class OtherMappedIter>
+    bool operator!=(const _flat_table_iterator<OtherKeyIter, OtherMappedIter> & other) const
+    {
+        return !(_key == other._key);
+    }
+
+    template <class OtherKeyIter, class OtherMappedIter>
+    bool operator<(const _flat_table_iterator<OtherKeyIter, OtherMappedIter> & other) const
+    {
+        return _key < other._key;
+    }
+
+    template <class OtherKeyIter, class OtherMappedIter>
+    bool operator>(const _flat_table_iterator<OtherKeyIter, OtherMappedIter> & other) const
+    {
+        return other._key < _key;
+    }
+
+    template <class OtherKeyIter, class OtherMappedIter>
+    bool operator<=(const _flat_table_iterator<OtherKeyIter, OtherMappedIter> & other) const
+    {
+        return !(other._key < _key);
+    }
+
+    template <class OtherKeyIter, class OtherMappedIter>
+    bool operator>=(const _flat_table_iterator<OtherKeyIter, OtherMappedIter> & other) const
+    {
+        return !(_key < other._key);
+    }
+};
+
+template <class KeyIter, class MappedIter>
+_flat_table_iterator<KeyIter, MappedIter> operator+(
+    typename _flat_table_iterator<KeyIter, MappedIter>::difference_type n,
+    const _flat_table_iterator<KeyIter, MappedIter> & it)
+{
+    return it + n;
+}
+
+/**
+ * @brief flat_table的类型
+ * @details 键数组与值数组，迭代器同时指向两者
+ */
+template <class Key, class T, class KeyContainer, class MappedContainer>
+class _flat_table_types
+{
+public:
+    using value_type = std::pair<Key, T>;
+    using reference = std::pair<const Key &, T &>;
+    using const_reference = std::pair<const Key &, const T &>;
+    using iterator = _flat_table_iterator<typename KeyContainer::const_iterator, typename MappedContainer::iterator>;
+    using const_iterator = _flat_table_iterator<typename KeyContainer::const_iterator, typename MappedContainer::const_iterator>;
+};
+
+/**
+ * @brief flat_table的类型
+ * @details T为void时只有键数组，迭代器就是键数组的常量迭代器
+ */
+template <class Key, class KeyContainer, class MappedContainer>
+class _flat_table_types<Key, void, KeyContainer, MappedContainer>
+{
+public:
+    using value_type = Key;
+    using reference = const Key &;
+    using const_reference = const Key &;
+    using iterator = typename KeyContainer::const_iterator;
+    using const_iterator = typename KeyContainer::const_iterator;
+};
+
+/**
+ * @brief T为void时代替值数组，不存放任何元素
+ */
+class _flat_no_values
+{
+public:
+    std::size_t max_size() const noexcept
+    {
+        return static_cast<std::size_t>(-1);
+    }
+
+    void reserve(std::size_t)
+    {
+    }
+
+    void clear() noexcept
+    {
+    }
+};
+
+/**
+ * @brief flat_table
+ * @details 有序的键数组与值数组，供flat_map和flat_multimap使用
+ * @details T为void时只有键数组，MappedContainer为_flat_no_values，供flat_set和flat_multiset使用
+ * @details 查找只访问连续存放的键，缓存命中率高；插入和删除需要移动后续元素，复杂度O(n)
+ */
+template <
+    class Key,
+    class T,
+    class Compare,
+    class KeyContainer,
+    class MappedContainer
+> class flat_table
+{
+public:
+    using key_type = Key;
+    using mapped_type = T;
+    using value_type = typename _flat_table_types<Key, T, KeyContainer, MappedContainer>::value_type;
+    using key_container_type = KeyContainer;
+    using mapped_container_type = MappedContainer;
+    using size_type = std::size_t;
+    using difference_type = std::ptrdiff_t;
+    using key_compare = Compare;
+    using reference = typename _flat_table_types<Key, T, KeyContainer, MappedContainer>::reference;
+    using const_reference = typename _flat_table_types<Key, T, KeyContainer, MappedContainer>::const_reference;
+    using iterator = typename _flat_table_types<Key, T, KeyContainer, MappedContainer>::iterator;
+    using const_iterator = typename _flat_table_types<Key, T, KeyContainer, MappedContainer>::const_iterator;
+
+public:
+    KeyContainer _keys;         // 有序的键
+    MappedContainer _values;    // 与键下标对应的值
+    Compare _comp;              // 比较器
+
+public:
+    flat_table()
+        : flat_table(Compare())
+    {
+    }
+
+    explicit flat_table(const Compare & comp)
+        : _keys()
+        , _values()
+        , _comp(comp)
+    {
+    }
+
+    flat_table(const flat_table & other) = default;
+
+    flat_table(flat_table && other) = default;
+
+    ~flat_table() = default;
+
+public:
+    flat_table & operator=(const flat_table & other) = default;
+
+    flat_table & operator=(flat_table && other) = default;
+
+    // 迭代器
+
+    iterator begin() noexcept
+    {
+        return _make_iterator(0);
+    }
+
+    const_iterator begin() const noexcept
+    {
+        return _make_iterator(0);
+    }
+
+    const_iterator cbegin() const noexcept
+    {
+        return begin();
+    }
+
+    iterator end() noexcept
+    {
+        return _make_iterator(size());
+    }
+
+    const_iterator end() const noexcept
+    {
+        return _make_iterator(size());
+    }
+
+    const_iterator cend() const noexcept
+    {
+        return end();
+    }
+
+    // 容量
+
+    bool empty() const noexcept
+    {
+        return _keys.empty();
+    }
+
+    size_type size() const noexcept
+    {
+        return _keys.size();
+    }
+
+    size_type max_size() const noexcept
+    {
+        return std::min<size_type>(_keys.max_size(), _values.max_size());
+    }
+
+    /**
+     * @brief 为count个元素预留空间
+     */
+    void reserve(size_type count)
+    {
+        _keys.reserve(count);
+        _values.reserve(count);
+    }
+
+    // 修改器
+
+    void clear() noexcept
+    {
+        _keys.clear();
+        _values.clear();
+    }
+
+    /**
+     * @brief 原位构造元素，不允许重复
+     */
+    template <class... Args>
+    std::pair<iterator, bool> emplace_unique(Args&&... args)
+    {
+        value_type value(std::forward<Args>(args)...);
+        size_type index = _lower_index(_key_of(value));
+        if (index != size() && !_comp(_key_of(value), _keys[index])) {
+            return std::pair<iterator, bool>(_make_iterator(index), false);
+        }
+        return std::pair<iterator, bool>(_insert_value(index, std::move(value)), true);
+    }
+
+    /**
+     * @brief 原位构造元素，允许重复，新元素位于相同键的最后
+     */
+    template <class... Args>
+    iterator emplace_equal(Args&&... args)
+    {
+        value_type value(std::forward<Args>(args)...);
+        size_type index = _upper_index(_key_of(value));
+        return _insert_value(index, std::move(value));
+    }
+
+    /**
+     * @brief 根据提示插入元素，不允许重复
+     * @details 提示位置恰好满足顺序时不需要查找
+     */
+    template <class... Args>
+    iterator emplace_hint_unique(const_iterator hint, Args&&... args)
+    {
+        value_type value(std::forward<Args>(args)...);
+        size_type index = hint - begin();
+        if ((index == 0 || _comp(_keys[index - 1], _key_of(value)))
+            && (index == size() || _comp(_key_of(value), _keys[index]))) {
+            return _insert_value(index, std::move(value));
+        }
+        index = _lower_index(_key_of(value));
+        if (index != size() && !_comp(_key_of(value), _keys[index])) {
+            return _make_iterator(index);
+        }
+        return _insert_value(index, std::move(value));
+    }
+
+    /**
+     * @brief 根据提示插入元素，允许重复
+     */
+    template <class... Args>
+    iterator emplace_hint_equal(const_iterator hint, Args&&... args)
+    {
+        value_type value(std::forward<Args>(args)...);
+        size_type index = hint - begin();
+        if ((index == 0 || !_comp(_key_of(value), _keys[index - 1]))
+            && (index == size() || !_comp(_keys[index], _key_of(value)))) {
+            return _insert_value(index, std::move(value));
+        }
+        return _insert_value(_upper_index(_key_of(value)), std::move(value));
+    }
+
+    /**
+     * @brief 键不存在时用args构造值并插入，键存在时不做任何事
+     */
+    template <class K, class... Args>
+    std::pair<iterator, bool> try_emplace_unique(K && key, Args&&... args)
+    {
+        size_type index = _lower_index(key);
+        if (index != size() && !_comp(key, _keys[index])) {
+            return std::pair<iterator, bool>(_make_iterator(index), false);
+        }
+        return std::pair<iterator, bool>(_insert_at(index, std::forward<K>(key), mapped_type(std::forward<Args>(args)...)), true);
+    }
+
+    /**
+     * @brief 插入范围内的元素，不允许重复
+     */
+    template <class InputIt>
+    void insert_range_unique(InputIt first, InputIt last)
+    {
+        _insert_range<true>(first, last);
+    }
+
+    /**
+     * @brief 插入范围内的元素，允许重复
+     */
+    template <class InputIt>
+    void insert_range_equal(InputIt first, InputIt last)
+    {
+        _insert_range<false>(first, last);
+    }
+
+    /**
+     * @brief 擦除元素
+     */
+    iterator erase(const_iterator pos)
+    {
+        size_type index = pos - begin();
+        _erase_at(index, 1, std::is_void<mapped_type>());
+        return _make_iterator(index);
+    }
+
+    /**
+     * @brief 擦除元素
+     */
+    iterator erase(const_iterator first, const_iterator last)
+    {
+        size_type index = first - begin();
+        _erase_at(index, last - first, std::is_void<mapped_type>());
+        return _make_iterator(index);
+    }
+
+    /**
+     * @brief 擦除键等于key的所有元素
+     */
+    size_type erase(const key_type & key)
+    {
+        std::pair<size_type, size_type> range = _equal_index(key);
+        erase(_make_iterator(range.first), _make_iterator(range.second));
+        return range.second - range.first;
+    }
+
+    void swap(flat_table & other) noexcept
+    {
+        std::swap(_keys, other._keys);
+        std::swap(_values, other._values);
+        std::swap(_comp, other._comp);
+    }
+
+    // 元素访问
+
+    /**
+     * @brief 带越界检查访问指定的元素
+     * @details 由于在flat_set中不需要mapped_type，使用了void，为了避免void &的编译错误，这里用SFINAE避免
+     */
+    template <typename U = mapped_type, typename = typename std::enable_if<!std::is_void<U>::value>::type>
+    U & at(const key_type & key)
+    {
+        size_type index = _find_index(key);
+        if (index == size()) {
+            throw std::out_of_range("flat_table at out of range");
+        }
+        return _values[index];
+    }
+
+    template <typename U = mapped_type, typename = typename std::enable_if<!std::is_void<U>::value>::type>
+    const U & at(const key_type & key) const
+    {
+        size_type index = _find_index(key);
+        if (index == size()) {
+            throw std::out_of_range("flat_table at out of range");
+        }
+        return _values[index];
+    }
+
+    template <typename U = mapped_type, typename = typename std::enable_if<!std::is_void<U>::value>::type>
+    U & operator[](const key_type & key)
+    {
+        return try_emplace_unique(key).first._mapped[0];
+    }
+
+    template <typename U = mapped_type, typename = typename std::enable_if<!std::is_void<U>::value>::type>
+    U & operator[](key_type && key)
+    {
+        return try_emplace_unique(std::move(key)).first._mapped[0];
+    }
+
+    // 查找
+
+    template <class K>
+    size_type count(const K & key) const
+    {
+        std::pair<size_type, size_type> range = _equal_index(key);
+        return range.second - range.first;
+    }
+
+    template <class K>
+    iterator find(const K & key)
+    {
+        return _make_iterator(_find_index(key));
+    }
+
+    template <class K>
+    const_iterator find(const K & key) const
+    {
+        return _make_iterator(_find_index(key));
+    }
+
+    template <class K>
+    std::pair<iterator, iterator> equal_range(const K & key)
+    {
+        std::pair<size_type, size_type> range = _equal_index(key);
+        return std::pair<iterator, iterator>(_make_iterator(range.first), _make_iterator(range.second));
+    }
+
+    template <class K>
+    std::pair<const_iterator, const_iterator> equal_range(const K & key) const
+    {
+        std::pair<size_type, size_type> range = _equal_index(key);
+        return std::pair<const_iterator, const_iterator>(_make_iterator(range.first), _make_iterator(range.second));
+    }
+
+    template <class K>
+    iterator lower_bound(const K & key)
+    {
+        return _make_iterator(_lower_index(key));
+    }
+
+    template <class K>
+    const_iterator lower_bound(const K & key) const
+    {
+        return _make_iterator(_lower_index(key));
+    }
+
+    template <class K>
+    iterator upper_bound(const K & key)
+    {
+        return _make_iterator(_upper_index(key));
+    }
+
+    template <class K>
+    const_iterator upper_bound(const K & key) const
+    {
+        return _make_iterator(_upper_index(key));
+    }
+
+public:
+    iterator _make_iterator(size_type index)
+    {
+        return _make_iterator(index, std::is_void<mapped_type>());
+    }
+
+    const_iterator _make_iterator(size_type index) const
+    {
+        return _make_iterator(index, std::is_void<mapped_type>());
+    }
+
+    iterator _make_iterator(size_type index, std::false_type)
+    {
+        return iterator(_keys.cbegin() + index, _values.begin() + index);
+    }
+
+    const_iterator _make_iterator(size_type index, std::false_type) const
+    {
+        return const_iterator(_keys.cbegin() + index, _values.cbegin() + index);
+    }
+
+    const_iterator _make_iterator(size_type index, std::true_type) const
+    {
+        return _keys.cbegin() + index;
+    }
+
+    /**
+     * @brief 元素的键
+     */
+    static const key_type & _key_of(const value_type & value)
+    {
+        return _key_of(value, std::is_void<mapped_type>());
+    }
+
+    static const key_type & _key_of(const value_type & value, std::false_type)
+    {
+        return value.first;
+    }
+
+    static const key_type & _key_of(const value_type & value, std::true_type)
+    {
+        return value;
+    }
+
+    /**
+     * @brief 首个不小于key的下标
+     */
+    template <class K>
+    size_type _lower_index(const K & key) const
+    {
+        return _branchless_lower_bound(_keys.cbegin(), _keys.size(), key, _comp) - _keys.cbegin();
+    }
+
+    /**
+     * @brief 首个大于key的下标
+     */
+    template <class K>
+    size_type _upper_index(const K & key) const
+    {
+        return _branchless_upper_bound(_keys.cbegin(), _keys.size(), key, _comp) - _keys.cbegin();
+    }
+
+    /**
+     * @brief 键等于key的下标，不存在时返回size()
+     */
+    template <class K>
+    size_type _find_index(const K & key) const
+    {
+        size_type index = _lower_index(key);
+        if (index != size() && _comp(key, _keys[index])) {
+            return size();
+        }
+        return index;
+    }
+
+    /**
+     * @brief 键等于key的下标范围，上界只在下界之后查找
+     */
+    template <class K>
+    std::pair<size_type, size_type> _equal_index(const K & key) const
+    {
+        size_type lower = _lower_index(key);
+        size_type upper = _branchless_upper_bound(_keys.cbegin() + lower, size() - lower, key, _comp) - _keys.cbegin();
+        return std::pair<size_type, size_type>(lower, upper);
+    }
+
+    /**
+     * @brief 在下标index处插入键值
+     */
+    template <class K, class M>
+    iterator _insert_at(size_type index, K && key, M && mapped)
+    {
+        _keys.emplace(_keys.cbegin() + index, std::forward<K>(key));
+        _values.emplace(_values.cbegin() + index, std::forward<M>(mapped));
+        return _make_iterator(index);
+    }
+
+    /**
+     * @brief 在下标index处插入元素
+     */
+    iterator _insert_value(size_type index, value_type && value)
+    {
+        _insert_value(index, std::move(value), std::is_void<mapped_type>());
+        return _make_iterator(index);
+    }
+
+    void _insert_value(size_type index, value_type && value, std::false_type)
+    {
+        _keys.emplace(_keys.cbegin() + index, std::move(value.first));
+        _values.emplace(_values.cbegin() + index, std::move(value.second));
+    }
+
+    void _insert_value(size_type index, value_type && value, std::true_type)
+    {
+        _keys.emplace(_keys.cbegin() + index, std::move(value));
+    }
+
+    /**
+     * @brief 擦除从下标index开始的count个元素
+     */
+    void _erase_at(size_type index, size_type count, std::false_type)
+    {
+        _keys.erase(_keys.begin() + index, _keys.begin() + index + count);
+        _values.erase(_values.begin() + index, _values.begin() + index + count);
+    }
+
+    void _erase_at(size_type index, size_type count, std::true_type)
+    {
+        _keys.erase(_keys.begin() + index, _keys.begin() + index + count);
+    }
+
+    /**
+     * @brief 把元素追加到keys和values末尾
+     */
+    static void _push_back(KeyContainer & keys, MappedContainer & values, value_type && value)
+    {
+        _push_back(keys, values, std::move(value), std::is_void<mapped_type>());
+    }
+
+    static void _push_back(KeyContainer & keys, MappedContainer & values, value_type && value, std::false_type)
+    {
+        keys.push_back(std::move(value.first));
+        values.push_back(std::move(value.second));
+    }
+
+    static void _push_back(KeyContainer & keys, MappedContainer &, value_type && value, std::true_type)
+    {
+        keys.push_back(std::move(value));
+    }
+
+    /**
+     * @brief 把下标i处的已有元素移动到keys和values末尾
+     */
+    void _move_back(KeyContainer & keys, MappedContainer & values, size_type i)
+    {
+        _move_back(keys, values, i, std::is_void<mapped_type>());
+    }
+
+    void _move_back(KeyContainer & keys, MappedContainer & values, size_type i, std::false_type)
+    {
+        keys.push_back(std::move(_keys[i]));
+        values.push_back(std::move(_values[i]));
+    }
+
+    void _move_back(KeyContainer & keys, MappedContainer &, size_type i, std::true_type)
+    {
+        keys.push_back(std::move(_keys[i]));
+    }
+
+    /**
+     * @brief 批量插入
+     * @details 新元素先整体排序，全部位于已有元素之后时直接追加，否则与已有元素做一次线性归并
+     * @details Unique为true时，相同键只保留已有的元素或新元素中最先出现的一个
+     */
+    template <bool Unique, class InputIt>
+    void _insert_range(InputIt first, InputIt last)
+    {
+        wwstl::vector<value_type> buffer(first, last);
+        if (buffer.empty()) {
+            return;
+        }
+        const Compare & comp = _comp;
+        std::stable_sort(buffer.begin(), buffer.end(), [&comp](const value_type & lhs, const value_type & rhs) {
+            return comp(_key_of(lhs), _key_of(rhs));
+        });
+
+        size_type count = buffer.size();
+        if (Unique) {
+            // 去掉新元素中重复的键，保留最先出现的
+            count = 1;
+            for (size_type i = 1; i < buffer.size(); ++i) {
+                if (_comp(_key_of(buffer[count - 1]), _key_of(buffer[i]))) {
+                    if (count != i) {
+                        buffer[count] = std::move(buffer[i]);
+                    }
+                    ++count;
+                }
+            }
+        }
+
+        size_type old_size = size();
+        if (old_size == 0 || (Unique ? _comp(_keys[old_size - 1], _key_of(buffer[0]))
+                                     : !_comp(_key_of(buffer[0]), _keys[old_size - 1]))) {
+            // 新元素全部位于末尾，直接追加
+            reserve(old_size + count);
+            for (size_type i = 0; i < count; ++i) {
+                _push_back(_keys, _values, std::move(buffer[i]));
+            }
+            return;
+        }
+
+        KeyContainer keys;
+        MappedContainer values;
+        keys.reserve(old_size + count);
+        values.reserve(old_size + count);
+        size_type i = 0;
+        size_type j = 0;
+        while (i < old_size && j < count) {
+            if (_comp(_key_of(buffer[j]), _keys[i])) {
+                _push_back(keys, values, std::move(buffer[j]));
+                ++j;
+            } else if (Unique && !_comp(_keys[i], _key_of(buffer[j]))) {
+                // 键已存在，丢弃新元素
+                ++j;
+            } else {
+                // 键相同时已有元素在前
+                _move_back(keys, values, i);
+                ++i;
+            }
+        }
+        for (; i < old_size; ++i) {
+            _move_back(keys, values, i);
+        }
+        for (; j < count; ++j) {
+            _push_back(keys, values, std::move(buffer[j]));
+        }
+        _keys.swap(keys);
+        std::swap(_values, values);
+    }
+};
+
+} // namespace wwstl
+
+#endif // __WW_FLAT_TABLE_H__
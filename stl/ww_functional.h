@@ -3,6 +3,7 @@
 
 #include <utility>
 #include <functional>
+#include <type_traits>
 
 namespace wwstl
 {
@@ -33,6 +34,77 @@ public:
     }
 };
 
+/**
+ * @brief 判断set的emplace参数能否不构造元素直接取得键
+ * @details 唯一的参数就是键
+ */
+template <class Key, class... Args>
+class _set_emplace_key
+    : public std::false_type
+{
+};
+
+template <class Key, class Arg>
+class _set_emplace_key<Key, Arg>
+    : public std::is_same<Key, Arg>
+{
+};
+
+/**
+ * @brief 判断map的emplace参数能否不构造元素直接取得键
+ * @details 唯一的参数是以键为first的pair，或者参数为键和值两个
+ */
+template <class Key, class... Args>
+class _map_emplace_key
+    : public std::false_type
+{
+};
+
+template <class Key, class First, class Second>
+class _map_emplace_key<Key, std::pair<First, Second>>
+    : public std::is_same<Key, typename std::remove_const<First>::type>
+{
+};
+
+template <class Key, class First, class Second>
+class _map_emplace_key<Key, First, Second>
+    : public std::is_same<Key, First>
+{
+};
+
+/**
+ * @brief emplace的参数能否直接取得键
+ * @details 可以取得键时，容器先查找，确定需要插入后才分配节点并构造元素
+ */
+template <class Key, class Mapped, class... Args>
+using _emplace_key_extractable = typename std::conditional<
+    std::is_void<Mapped>::value,
+    _set_emplace_key<Key, typename std::decay<Args>::type...>,
+    _map_emplace_key<Key, typename std::decay<Args>::type...>
+>::type;
+
+/**
+ * @brief 从emplace的参数中取得键
+ * @details 只在_emplace_key_extractable为true时使用，第一个参数区分集合(true_type)和映射(false_type)
+ */
+template <class Key>
+const Key & _emplace_key_of(std::true_type, const Key & key)
+{
+    return key;
+}
+
+template <class Key, class First, class Second>
+const Key & _emplace_key_of(std::false_type, const std::pair<First, Second> & p)
+{
+    return p.first;
+}
+
+template <class Key, class First, class Second>
+const Key & _emplace_key_of(std::false_type, const First & first, const Second &)
+{
+    return first;
+}
+
 } // namespace wwstl
 
 #endif // __WW_FUNCTIONAL_H__
\ No newline at end of file
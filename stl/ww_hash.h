@@ -2,10 +2,204 @@
 #define __WW_HASH_H__
 
 #include <stdexcept>
+#include <string>
+#include <cstring>
+#include <cstdint>
+#include <cmath>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include "ww_type_traits.h"
 
 namespace wwstl
 {
 
+/**
+ * 哈希原语
+ *
+ * 字符串按wyhash的方式计算：每次读入8或16字节，与常量异或后做64位×64位→128位乘法，
+ * 再把高低64位折叠，一次乘法即可让每一位依赖全部输入位
+ * 整数、浮点数和组合键都复用同一个乘法折叠
+ */
+
+/**
+ * @brief 64位×64位→128位乘法，a返回低64位，b返回高64位
+ */
+inline void _hash_multiply(std::uint64_t & a, std::uint64_t & b) noexcept
+{
+#if defined(__SIZEOF_INT128__)
+    const unsigned __int128 product = static_cast<unsigned __int128>(a) * b;
+    a = static_cast<std::uint64_t>(product);
+    b = static_cast<std::uint64_t>(product >> 64);
+#else
+    // 没有128位整数时拆成四个32位乘法
+    const std::uint64_t ha = a >> 32, hb = b >> 32, la = static_cast<std::uint32_t>(a), lb = static_cast<std::uint32_t>(b);
+    const std::uint64_t rh = ha * hb, rm0 = ha * lb, rm1 = hb * la, rl = la * lb;
+    const std::uint64_t t = rl + (rm0 << 32);
+    std::uint64_t carry = t < rl;
+    const std::uint64_t lo = t + (rm1 << 32);
+    carry += lo < t;
+    a = lo;
+    b = rh + (rm0 >> 32) + (rm1 >> 32) + carry;
+#endif
+}
+
+/**
+ * @brief 乘法后折叠高低64位
+ */
+inline std::uint64_t _hash_fold(std::uint64_t a, std::uint64_t b) noexcept
+{
+    _hash_multiply(a, b);
+    return a ^ b;
+}
+
+/**
+ * @brief 打散哈希值
+ * @details 乘法后高低位折叠使每一位都依赖全部输入位，整数的hash和按位取桶的策略都经过这一步
+ */
+inline std::size_t _hash_mix(std::size_t hash) noexcept
+{
+    return static_cast<std::size_t>(_hash_fold(hash, 0x9E3779B97F4A7C15ull));
+}
+
+/**
+ * @brief wyhash的常量，每个都是奇数且0、1位各占一半
+ */
+constexpr std::uint64_t _hash_secret0 = 0x2d358dccaa6c78a5ull;
+constexpr std::uint64_t _hash_secret1 = 0x8bb84b93962eacc9ull;
+constexpr std::uint64_t _hash_secret2 = 0x4b33a62ed433d4a3ull;
+constexpr std::uint64_t _hash_secret3 = 0x4d5a2da51de1aa47ull;
+
+/**
+ * @brief 按字节读入，memcpy避免未对齐访问，编译器会生成单条load指令
+ */
+inline std::uint64_t _hash_read8(const unsigned char * p) noexcept
+{
+    std::uint64_t v;
+    std::memcpy(&v, p, 8);
+    return v;
+}
+
+inline std::uint64_t _hash_read4(const unsigned char * p) noexcept
+{
+    std::uint32_t v;
+    std::memcpy(&v, p, 4);
+    return v;
+}
+
+/**
+ * @brief 读入1到3个字节：首、中、尾各取一个，不需要分支
+ */
+inline std::uint64_t _hash_read3(const unsigned char * p, std::size_t size) noexcept
+{
+    return (static_cast<std::uint64_t>(p[0]) << 16) | (static_cast<std::uint64_t>(p[size >> 1]) << 8) | p[size - 1];
+}
+
+/**
+ * @brief 计算字节序列的hash值
+ * @details 字符串类的hash特化共用，保证相同内容的不同字符串类型得到相同的hash值
+ * @details 不超过16字节时用两次4或8字节的重叠读入取完全部字节；更长时每轮读入16字节，
+ *          超过48字节时三路交替读入，三条乘法链互不依赖，可以并行执行
+ */
+inline std::size_t _hash_bytes(const void * data, std::size_t size, std::uint64_t seed = 0) noexcept
+{
+    const unsigned char * p = static_cast<const unsigned char *>(data);
+    seed ^= _hash_fold(seed ^ _hash_secret0, _hash_secret1);
+    std::uint64_t a, b;
+    if (size <= 16) {
+        if (size >= 4) {
+            const std::size_t shift = (size >> 3) << 2;     // 8字节及以上时第二次读入后移4字节
+            a = (_hash_read4(p) << 32) | _hash_read4(p + shift);
+            b = (_hash_read4(p + size - 4) << 32) | _hash_read4(p + size - 4 - shift);
+        } else if (size > 0) {
+            a = _hash_read3(p, size);
+            b = 0;
+        } else {
+            a = b = 0;
+        }
+    } else {
+        std::size_t i = size;
+        if (i >= 48) {
+            std::uint64_t seed1 = seed, seed2 = seed;
+            do {
+                seed = _hash_fold(_hash_read8(p) ^ _hash_secret1, _hash_read8(p + 8) ^ seed);
+                seed1 = _hash_fold(_hash_read8(p + 16) ^ _hash_secret2, _hash_read8(p + 24) ^ seed1);
+                seed2 = _hash_fold(_hash_read8(p + 32) ^ _hash_secret3, _hash_read8(p + 40) ^ seed2);
+                p += 48;
+                i -= 48;
+            } while (i >= 48);
+            seed ^= seed1 ^ seed2;
+        }
+        while (i > 16) {
+            seed = _hash_fold(_hash_read8(p) ^ _hash_secret1, _hash_read8(p + 8) ^ seed);
+            p += 16;
+            i -= 16;
+        }
+        // 最后16字节可能与已处理的部分重叠
+        a = _hash_read8(p + i - 16);
+        b = _hash_read8(p + i - 8);
+    }
+    a ^= _hash_secret1;
+    b ^= seed;
+    _hash_multiply(a, b);
+    return static_cast<std::size_t>(_hash_fold(a ^ _hash_secret0 ^ size, b ^ _hash_secret1));
+}
+
+/**
+ * @brief 整数的hash值
+ * @details 64位整数经一次乘法折叠，连续或等步长的键也得到互不相关的hash值
+ */
+inline std::size_t _hash_int(std::uint64_t key) noexcept
+{
+    return static_cast<std::size_t>(_hash_fold(key, 0x9E3779B97F4A7C15ull));
+}
+
+/**
+ * @brief 把hash值并入种子，结果依赖并入的顺序
+ */
+inline std::size_t _hash_combine(std::size_t seed, std::size_t hash) noexcept
+{
+    return static_cast<std::size_t>(_hash_fold(seed ^ _hash_secret0, hash ^ _hash_secret1));
+}
+
+/**
+ * @brief 浮点数的hash值
+ * @details +0.0与-0.0相等，必须得到相同的hash值；其余值按位表示计算，NaN与任何值都不相等，其hash值无关紧要
+ */
+template <class Float>
+inline std::size_t _hash_float(Float key) noexcept
+{
+    static_assert(sizeof(Float) <= sizeof(std::uint64_t), "use _hash_long_double");
+    if (key == Float(0)) {
+        return 0;
+    }
+    std::uint64_t bits = 0;
+    std::memcpy(&bits, &key, sizeof(Float));
+    return _hash_int(bits);
+}
+
+/**
+ * @brief long double的hash值
+ * @details long double的位表示中可能有填充字节，不能直接按位计算；拆成尾数和指数，尾数放大为64位整数
+ */
+inline std::size_t _hash_long_double(long double key) noexcept
+{
+    if (key == 0.0L) {
+        return 0;
+    }
+    if (std::isnan(key) || std::isinf(key)) {
+        return _hash_float(static_cast<double>(key));
+    }
+    int exponent = 0;
+    long double mantissa = std::frexp(key, &exponent);     // |mantissa|在[0.5, 1)中
+    const bool negative = mantissa < 0;
+    if (negative) {
+        mantissa = -mantissa;
+    }
+    const std::uint64_t bits = static_cast<std::uint64_t>(std::ldexp(mantissa, 64));
+    return _hash_combine(_hash_int(bits), _hash_int((static_cast<std::uint64_t>(exponent) << 1) | negative));
+}
+
 template <
     class Ty,
     class Key
@@ -14,15 +208,49 @@ template <
 public:
     using argument_type = Key;
     using result_type = Ty;
+    using is_mixed = void;      // 结果已充分打散，见hash_is_mixed
 };
 
 /**
- * @brief hash
- * @link https://zh.cppreference.com/w/cpp/utility/hash
- * @details 参照std::hash标准，提供两种类型声明和一个operator()重载
+ * @brief 判断哈希函数的结果是否已充分打散，即每一位都依赖全部输入位
+ * @details 与is_transparent类似，哈希函数定义成员类型is_mixed即表示已打散，按位取桶时不再重复打散
+ * @details 本文件中的hash特化都已打散；自定义的哈希函数只有在确实打散时才应定义is_mixed
+ */
+template <
+    class Hasher,
+    class = void
+> class hash_is_mixed
+    : public std::false_type
+{
+};
+
+template <class Hasher>
+class hash_is_mixed<Hasher, wwstl::void_t<typename Hasher::is_mixed>>
+    : public std::true_type
+{
+};
+
+/**
+ * @brief 未特化类型的hash
+ * @details 与std::hash一致，没有特化的类型得到一个禁用的hash：不能构造，也没有operator()，
+ *          用在无序容器中时编译失败，而不是运行时才报错
+ */
+template <
+    class Key,
+    bool = std::is_enum<Key>::value
+> class _hash_enum
+{
+public:
+    _hash_enum() = delete;
+    _hash_enum(const _hash_enum &) = delete;
+    _hash_enum & operator=(const _hash_enum &) = delete;
+};
+
+/**
+ * @brief 枚举类型的hash，按底层整数类型计算
  */
 template <class Key>
-class hash
+class _hash_enum<Key, true>
     : public _hash_base<std::size_t, Key>
 {
 public:
@@ -30,12 +258,24 @@ public:
     using typename _hash_base<std::size_t, Key>::result_type;
 
 public:
-    result_type operator()(const argument_type & key) const
+    result_type operator()(const argument_type & key) const noexcept
     {
-        throw std::runtime_error("type not implemented");
+        return _hash_int(static_cast<std::uint64_t>(static_cast<typename std::underlying_type<Key>::type>(key)));
     }
 };
 
+/**
+ * @brief hash
+ * @link https://zh.cppreference.com/w/cpp/utility/hash
+ * @details 参照std::hash标准，提供两种类型声明和一个operator()重载
+ * @details 主模板只支持枚举类型，其余类型需要特化
+ */
+template <class Key>
+class hash
+    : public _hash_enum<Key>
+{
+};
+
 /**
  * @details 以下提供必须实现的hash特化，按照C++标准定义，需要为算术类型、枚举类型和指针类型(包括nullptr_t)提供特化
  * @link https://zh.cppreference.com/w/cpp/language/types
@@ -44,16 +284,27 @@ public:
  * @link https://zh.cppreference.com/w/cpp/types/nullptr_t
  */
 
-// 可以无损转换为size_t的类型
+// 整数类型，先无损转换为64位再打散
+
+template<>
+class hash<char>
+    : public _hash_base<std::size_t, char>
+{
+public:
+    result_type operator()(const argument_type & key) const noexcept
+    {
+        return _hash_int(static_cast<std::uint64_t>(key));
+    }
+};
 
 template<>
 class hash<signed char>
     : public _hash_base<std::size_t, signed char>
 {
 public:
-    result_type operator()(const argument_type & key) const
+    result_type operator()(const argument_type & key) const noexcept
     {
-        return static_cast<result_type>(key);
+        return _hash_int(static_cast<std::uint64_t>(key));
     }
 };
 
@@ -62,9 +313,42 @@ class hash<unsigned char>
     : public _hash_base<std::size_t, unsigned char>
 {
 public:
-    result_type operator()(const argument_type & key) const
+    result_type operator()(const argument_type & key) const noexcept
     {
-        return static_cast<result_type>(key);
+        return _hash_int(static_cast<std::uint64_t>(key));
+    }
+};
+
+template<>
+class hash<wchar_t>
+    : public _hash_base<std::size_t, wchar_t>
+{
+public:
+    result_type operator()(const argument_type & key) const noexcept
+    {
+        return _hash_int(static_cast<std::uint64_t>(key));
+    }
+};
+
+template<>
+class hash<char16_t>
+    : public _hash_base<std::size_t, char16_t>
+{
+public:
+    result_type operator()(const argument_type & key) const noexcept
+    {
+        return _hash_int(static_cast<std::uint64_t>(key));
+    }
+};
+
+template<>
+class hash<char32_t>
+    : public _hash_base<std::size_t, char32_t>
+{
+public:
+    result_type operator()(const argument_type & key) const noexcept
+    {
+        return _hash_int(static_cast<std::uint64_t>(key));
     }
 };
 
@@ -73,9 +357,9 @@ class hash<short int>
     : public _hash_base<std::size_t, short int>
 {
 public:
-    result_type operator()(const argument_type & key) const
+    result_type operator()(const argument_type & key) const noexcept
     {
-        return static_cast<result_type>(key);
+        return _hash_int(static_cast<std::uint64_t>(key));
     }
 };
 
@@ -84,9 +368,9 @@ class hash<unsigned short int>
     : public _hash_base<std::size_t, unsigned short int>
 {
 public:
-    result_type operator()(const argument_type & key) const
+    result_type operator()(const argument_type & key) const noexcept
     {
-        return static_cast<result_type>(key);
+        return _hash_int(static_cast<std::uint64_t>(key));
     }
 };
 
@@ -95,9 +379,9 @@ class hash<int>
     : public _hash_base<std::size_t, int>
 {
 public:
-    result_type operator()(const argument_type & key) const
+    result_type operator()(const argument_type & key) const noexcept
     {
-        return static_cast<result_type>(key);
+        return _hash_int(static_cast<std::uint64_t>(key));
     }
 };
 
@@ -106,9 +390,9 @@ class hash<unsigned int>
     : public _hash_base<std::size_t, unsigned int>
 {
 public:
-    result_type operator()(const argument_type & key) const
+    result_type operator()(const argument_type & key) const noexcept
     {
-        return static_cast<result_type>(key);
+        return _hash_int(static_cast<std::uint64_t>(key));
     }
 };
 
@@ -117,9 +401,9 @@ class hash<long int>
     : public _hash_base<std::size_t, long int>
 {
 public:
-    result_type operator()(const argument_type & key) const
+    result_type operator()(const argument_type & key) const noexcept
     {
-        return static_cast<result_type>(key);
+        return _hash_int(static_cast<std::uint64_t>(key));
     }
 };
 
@@ -128,9 +412,9 @@ class hash<unsigned long int>
     : public _hash_base<std::size_t, unsigned long int>
 {
 public:
-    result_type operator()(const argument_type & key) const
+    result_type operator()(const argument_type & key) const noexcept
     {
-        return static_cast<result_type>(key);
+        return _hash_int(static_cast<std::uint64_t>(key));
     }
 };
 
@@ -139,9 +423,9 @@ class hash<long long int>
     : public _hash_base<std::size_t, long long int>
 {
 public:
-    result_type operator()(const argument_type & key) const
+    result_type operator()(const argument_type & key) const noexcept
     {
-        return static_cast<result_type>(key);
+        return _hash_int(static_cast<std::uint64_t>(key));
     }
 };
 
@@ -150,9 +434,9 @@ class hash<unsigned long long int>
     : public _hash_base<std::size_t, unsigned long long int>
 {
 public:
-    result_type operator()(const argument_type & key) const
+    result_type operator()(const argument_type & key) const noexcept
     {
-        return static_cast<result_type>(key);
+        return _hash_int(static_cast<std::uint64_t>(key));
     }
 };
 
@@ -164,9 +448,44 @@ class hash<bool>
     : public _hash_base<std::size_t, bool>
 {
 public:
-    result_type operator()(const argument_type & key) const
+    result_type operator()(const argument_type & key) const noexcept
+    {
+        return _hash_int(key ? 1 : 0);
+    }
+};
+
+// 浮点类型
+
+template <>
+class hash<float>
+    : public _hash_base<std::size_t, float>
+{
+public:
+    result_type operator()(const argument_type & key) const noexcept
+    {
+        return _hash_float(key);
+    }
+};
+
+template <>
+class hash<double>
+    : public _hash_base<std::size_t, double>
+{
+public:
+    result_type operator()(const argument_type & key) const noexcept
+    {
+        return _hash_float(key);
+    }
+};
+
+template <>
+class hash<long double>
+    : public _hash_base<std::size_t, long double>
+{
+public:
+    result_type operator()(const argument_type & key) const noexcept
     {
-        return key ? 1 : 0;
+        return _hash_long_double(key);
     }
 };
 
@@ -178,9 +497,9 @@ public:
     using argument_type = typename _hash_base<std::size_t, T*>::argument_type;
     using result_type = typename _hash_base<std::size_t, T*>::result_type;
 public:
-    result_type operator()(const argument_type & key) const
+    result_type operator()(const argument_type & key) const noexcept
     {
-        return reinterpret_cast<std::size_t>(key);  // 直接将指针的地址转换为size_t
+        return _hash_int(reinterpret_cast<std::uintptr_t>(key));   // 地址的低位受对齐影响总是0，需要打散
     }
 };
 
@@ -192,7 +511,7 @@ class hash<std::nullptr_t>
     : public _hash_base<std::size_t, std::nullptr_t>
 {
 public:
-    result_type operator()(const argument_type & key) const
+    result_type operator()(const argument_type & key) const noexcept
     {
         (void)key;
         return 0;   // nullptr_t的hash值为0
@@ -201,6 +520,8 @@ public:
 
 /**
  * @brief std::string类型的hash特化
+ * @details 定义了is_transparent，可以直接对const char*和提供data()、size()的字符串视图类型计算hash，
+ * 与std::equal_to<>配合即可在无序容器中进行异构查找
  */
 template <>
 class hash<std::string> : public _hash_base<std::size_t, std::string>
@@ -208,15 +529,25 @@ class hash<std::string> : public _hash_base<std::size_t, std::string>
 public:
     using typename _hash_base<std::size_t, std::string>::argument_type;
     using typename _hash_base<std::size_t, std::string>::result_type;
+    using is_transparent = void;
 
-    result_type operator()(const argument_type & key) const
+    result_type operator()(const argument_type & key) const noexcept
     {
-        result_type hash = 0;
-        for (char c : key)
-        {
-            hash = hash * 31 + static_cast<unsigned char>(c); // 常见的字符串哈希算法
-        }
-        return hash;
+        return _hash_bytes(key.data(), key.size());
+    }
+
+    result_type operator()(const char * key) const noexcept
+    {
+        return _hash_bytes(key, std::strlen(key));
+    }
+
+    template <
+        class StringView,
+        class = decltype(std::declval<const StringView &>().data()),
+        class = decltype(std::declval<const StringView &>().size())
+    > result_type operator()(const StringView & key) const
+    {
+        return _hash_bytes(key.data(), key.size());
     }
 };
 
@@ -230,19 +561,107 @@ public:
     using typename _hash_base<std::size_t, const char *>::argument_type;
     using typename _hash_base<std::size_t, const char *>::result_type;
 
+    result_type operator()(const argument_type & key) const noexcept
+    {
+        return _hash_bytes(key, std::strlen(key));
+    }
+};
+
+/**
+ * @brief 把value的hash值并入seed
+ * @details 用于自定义组合键的hash，按字段顺序依次并入；交换两个字段的值通常得到不同的hash值
+ */
+template <
+    class T,
+    class Hash = hash<T>
+> inline void hash_combine(std::size_t & seed, const T & value, const Hash & hasher = Hash())
+{
+    seed = _hash_combine(seed, hasher(value));
+}
+
+/**
+ * @brief 增量计算组合键的hash值
+ * @details update按顺序并入各字段，update_bytes并入一段原始字节，finish取得结果
+ * @details update(s)与update_bytes(s.data(), s.size())得到相同的结果，与逐个hash_combine也相同
+ */
+class hash_state
+{
+public:
+    std::size_t _seed;
+
+public:
+    explicit hash_state(std::size_t seed = 0) noexcept
+        : _seed(seed)
+    {
+    }
+
+    template <class T>
+    hash_state & update(const T & value)
+    {
+        hash_combine(_seed, value);
+        return *this;
+    }
+
+    hash_state & update_bytes(const void * data, std::size_t size) noexcept
+    {
+        _seed = _hash_combine(_seed, _hash_bytes(data, size));
+        return *this;
+    }
+
+    std::size_t finish() const noexcept
+    {
+        return _seed;
+    }
+};
+
+/**
+ * @brief std::pair类型的hash特化，依次并入first和second
+ */
+template <class T1, class T2>
+class hash<std::pair<T1, T2>>
+    : public _hash_base<std::size_t, std::pair<T1, T2>>
+{
+public:
+    using typename _hash_base<std::size_t, std::pair<T1, T2>>::argument_type;
+    using typename _hash_base<std::size_t, std::pair<T1, T2>>::result_type;
+
+public:
     result_type operator()(const argument_type & key) const
     {
-        result_type hash = 0;
-        const char *p = key;
-        while (*p)
-        {
-            hash = hash * 31 + static_cast<unsigned char>(*p);
-            ++p;
-        }
-        return hash;
+        std::size_t seed = 0;
+        hash_combine(seed, key.first);
+        hash_combine(seed, key.second);
+        return seed;
+    }
+};
+
+/**
+ * @brief std::tuple类型的hash特化，按下标顺序并入各元素，与字段相同的pair得到相同的hash值
+ */
+template <class... Types>
+class hash<std::tuple<Types...>>
+    : public _hash_base<std::size_t, std::tuple<Types...>>
+{
+public:
+    using typename _hash_base<std::size_t, std::tuple<Types...>>::argument_type;
+    using typename _hash_base<std::size_t, std::tuple<Types...>>::result_type;
+
+public:
+    result_type operator()(const argument_type & key) const
+    {
+        return _hash_elements(key, std::index_sequence_for<Types...>());
+    }
+
+    template <std::size_t... I>
+    static result_type _hash_elements(const argument_type & key, std::index_sequence<I...>)
+    {
+        std::size_t seed = 0;
+        int expand[] = {0, (hash_combine(seed, std::get<I>(key)), 0)...};
+        (void)expand;
+        return seed;
     }
 };
 
 } // namespace wwstl
 
-#endif // __WW_HASH_H__
\ No newline at end of file
+#endif // __WW_HASH_H__
@@ -0,0 +1,199 @@
+#ifndef __WW_HASH_POLICY_H__
+#define __WW_HASH_POLICY_H__
+
+#include <cstddef>
+#include <algorithm>
+#include "ww_hash.h"
+
+namespace wwstl
+{
+
+/**
+ * hashtable的桶数策略
+ *
+ * 决定桶数的取值和哈希值到桶的映射，hashtable负责何时重建，策略只负责映射
+ * 每个策略提供：
+ *   bucket_count_for(n)        不小于n的合法桶数，n为0时返回最小桶数
+ *   policy(bucket_count)       构造对应bucket_count个桶的映射，bucket_count由bucket_count_for得到
+ *   index(hash)                哈希值所在的桶
+ *   requires_mixed_hash        是否要求哈希值充分打散；为true时hashtable对没有声明is_mixed的哈希函数先打散一次
+ */
+
+/**
+ * @brief 桶数为2的幂，默认策略
+ * @details 按位与取桶，不需要除法，只用到哈希值的低位，要求哈希值充分打散
+ * @details wwstl::hash的结果已经打散，直接取桶；其他哈希函数可能只在高位有差异，
+ *          由hashtable先经_hash_mix打散，否则连续或等步长的键只落在少数桶中
+ */
+class power_of_two_rehash_policy
+{
+public:
+    static constexpr bool requires_mixed_hash = true;
+
+    std::size_t _mask;      // 桶数 - 1
+
+public:
+    power_of_two_rehash_policy()
+        : _mask(0)
+    {
+    }
+
+    explicit power_of_two_rehash_policy(std::size_t bucket_count)
+        : _mask(bucket_count == 0 ? 0 : bucket_count - 1)
+    {
+    }
+
+public:
+    static std::size_t bucket_count_for(std::size_t n)
+    {
+        std::size_t count = 1;
+        while (count < n) {
+            count <<= 1;
+        }
+        return count;
+    }
+
+    std::size_t index(std::size_t hash) const
+    {
+        return hash & _mask;
+    }
+};
+
+/**
+ * @brief 桶数为素数
+ * @details 桶数取自约按1.5倍、2倍增长的素数表，取模时按表中的位置分派到除数为常量的分支，
+ *          编译器把常量除法换成乘法和移位，避免运行时的64位除法
+ * @details 哈希值不经打散直接取模，哈希函数只在低位有差异时也能均匀分布
+ */
+class prime_rehash_policy
+{
+public:
+    static constexpr bool requires_mixed_hash = false;
+
+    enum { _prime_count = 62 };
+
+    std::size_t _prime_index;   // 桶数在素数表中的位置
+
+public:
+    prime_rehash_policy()
+        : _prime_index(0)
+    {
+    }
+
+    explicit prime_rehash_policy(std::size_t bucket_count)
+        : _prime_index(_lower_bound(bucket_count))
+    {
+    }
+
+public:
+    static const unsigned long long * _primes()
+    {
+        static const unsigned long long primes[_prime_count] = {
+            2ull, 7ull, 13ull, 29ull,
+            53ull, 97ull, 193ull, 389ull,
+            769ull, 1543ull, 3079ull, 6151ull,
+            12289ull, 24593ull, 49157ull, 98317ull,
+            196613ull, 393241ull, 786433ull, 1572869ull,
+            3145739ull, 6291469ull, 12582917ull, 25165843ull,
+            50331653ull, 100663319ull, 201326611ull, 402653189ull,
+            805306457ull, 1610612741ull, 3221225473ull, 6442450967ull,
+            12884901893ull, 25769803799ull, 51539607599ull, 103079215111ull,
+            206158430209ull, 412316860441ull, 824633720837ull, 1649267441681ull,
+            3298534883417ull, 6597069766657ull, 13194139533349ull, 26388279066671ull,
+            52776558133303ull, 105553116266509ull, 211106232533047ull, 422212465066001ull,
+            844424930132057ull, 1688849860263953ull, 3377699720527897ull, 6755399441055827ull,
+            13510798882111519ull, 27021597764223071ull, 54043195528445957ull, 108086391056891941ull,
+            216172782113783843ull, 432345564227567621ull, 864691128455135281ull, 1729382256910270481ull,
+            3458764513820540933ull, 6917529027641081903ull
+        };
+        return primes;
+    }
+
+    /**
+     * @brief 素数表中首个不小于n的位置
+     */
+    static std::size_t _lower_bound(std::size_t n)
+    {
+        const unsigned long long * primes = _primes();
+        const std::size_t pos = std::lower_bound(primes, primes + _prime_count, static_cast<unsigned long long>(n)) - primes;
+        return pos == _prime_count ? _prime_count - 1 : pos;
+    }
+
+    static std::size_t bucket_count_for(std::size_t n)
+    {
+        return static_cast<std::size_t>(_primes()[_lower_bound(n)]);
+    }
+
+    std::size_t index(std::size_t hash) const
+    {
+        switch (_prime_index) {
+        case 0: return hash % 2ull;
+        case 1: return hash % 7ull;
+        case 2: return hash % 13ull;
+        case 3: return hash % 29ull;
+        case 4: return hash % 53ull;
+        case 5: return hash % 97ull;
+        case 6: return hash % 193ull;
+        case 7: return hash % 389ull;
+        case 8: return hash % 769ull;
+        case 9: return hash % 1543ull;
+        case 10: return hash % 3079ull;
+        case 11: return hash % 6151ull;
+        case 12: return hash % 12289ull;
+        case 13: return hash % 24593ull;
+        case 14: return hash % 49157ull;
+        case 15: return hash % 98317ull;
+        case 16: return hash % 196613ull;
+        case 17: return hash % 393241ull;
+        case 18: return hash % 786433ull;
+        case 19: return hash % 1572869ull;
+        case 20: return hash % 3145739ull;
+        case 21: return hash % 6291469ull;
+        case 22: return hash % 12582917ull;
+        case 23: return hash % 25165843ull;
+        case 24: return hash % 50331653ull;
+        case 25: return hash % 100663319ull;
+        case 26: return hash % 201326611ull;
+        case 27: return hash % 402653189ull;
+        case 28: return hash % 805306457ull;
+        case 29: return hash % 1610612741ull;
+        case 30: return hash % 3221225473ull;
+        case 31: return hash % 6442450967ull;
+        case 32: return hash % 12884901893ull;
+        case 33: return hash % 25769803799ull;
+        case 34: return hash % 51539607599ull;
+        case 35: return hash % 103079215111ull;
+        case 36: return hash % 206158430209ull;
+        case 37: return hash % 412316860441ull;
+        case 38: return hash % 824633720837ull;
+        case 39: return hash % 1649267441681ull;
+        case 40: return hash % 3298534883417ull;
+        case 41: return hash % 6597069766657ull;
+        case 42: return hash % 13194139533349ull;
+        case 43: return hash % 26388279066671ull;
+        case 44: return hash % 52776558133303ull;
+        case 45: return hash % 105553116266509ull;
+        case 46: return hash % 211106232533047ull;
+        case 47: return hash % 422212465066001ull;
+        case 48: return hash % 844424930132057ull;
+        case 49: return hash % 1688849860263953ull;
+        case 50: return hash % 3377699720527897ull;
+        case 51: return hash % 6755399441055827ull;
+        case 52: return hash % 13510798882111519ull;
+        case 53: return hash % 27021597764223071ull;
+        case 54: return hash % 54043195528445957ull;
+        case 55: return hash % 108086391056891941ull;
+        case 56: return hash % 216172782113783843ull;
+        case 57: return hash % 432345564227567621ull;
+        case 58: return hash % 864691128455135281ull;
+        case 59: return hash % 1729382256910270481ull;
+        case 60: return hash % 3458764513820540933ull;
+        case 61: return hash % 6917529027641081903ull;
+        default: return hash % _primes()[_prime_index];
+        }
+    }
+};
+
+} // namespace wwstl
+
+#endif // __WW_HASH_POLICY_H__
@@ -3,11 +3,18 @@
 
 #include <initializer_list>
 #include <cmath>
+#include <exception>
+#include <iterator>
+#include <thread>
+#include <tuple>
+#include <vector>
 #include "ww_algorithm.h"
 #include "ww_vector.h"
 #include "ww_hash.h"
+#include "ww_hash_policy.h"
 #include "ww_functional.h"
 #include "ww_type_traits.h"
+#include "ww_node_handle.h"
 
 namespace wwstl
 {
@@ -19,35 +26,84 @@ template <
     class Hash,
     class KeyEqual,
     class ExtractKey,
-    class Allocator
+    class Allocator,
+    bool CacheHash,
+    class RehashPolicy
 > class hashtable;
 
+/**
+ * @brief hashtable节点缓存的哈希值
+ * @details CacheHash为false时为空基类，不占节点空间
+ */
+template <bool CacheHash>
+class _hashtable_hash_code
+{
+};
+
+template <>
+class _hashtable_hash_code<true>
+{
+public:
+    std::size_t _hash_code;     // 键的哈希值，插入时写入
+};
+
+template <class Value, bool CacheHash>
+class _hashtable_node;
+
+/**
+ * @brief hashtable节点的链接部分
+ * @details 哈希表的before_begin只有链接部分，不含值
+ */
+template <class Value, bool CacheHash>
+class _hashtable_node_base
+{
+public:
+    using node_pointer = _hashtable_node<Value, CacheHash>*;
+
+public:
+    node_pointer _next;         // 下一个节点
+
+public:
+    _hashtable_node_base()
+        : _next(nullptr)
+    {
+    }
+};
+
 /**
  * @brief hashtable节点
+ * @details 所有节点串成一条单链表，同一个桶的节点在链表中连续
+ * @details CacheHash为true时节点保存键的哈希值，遍历、擦除和重建时不再调用哈希函数，
+ *          查找时先比较哈希值，不相等的节点不必调用_equals
  */
-template <class Value>
+template <class Value, bool CacheHash>
 class _hashtable_node
+    : public _hashtable_node_base<Value, CacheHash>
+    , public _hashtable_hash_code<CacheHash>
 {
 public:
     using value_type = Value;
-    using node_pointer = _hashtable_node<value_type>*;
+    using node_pointer = _hashtable_node<value_type, CacheHash>*;
 
 public:
     value_type _data;           // 当前节点值
-    node_pointer _next;         // 下一个节点
 
 public:
     _hashtable_node()
         : _data()
-        , _next(nullptr)
     { // 构造空节点
     }
 
     explicit _hashtable_node(const value_type & data)
         : _data(data)
-        , _next(nullptr)
     { // 以值构造一个节点
     }
+
+    template <class... Args>
+    explicit _hashtable_node(Args&&... args)
+        : _data(std::forward<Args>(args)...)
+    { // 以参数原位构造节点的值
+    }
 };
 
 /**
@@ -60,7 +116,9 @@ template <
     class Hash,
     class KeyEqual,
     class ExtractKey,
-    class Allocator
+    class Allocator,
+    bool CacheHash,
+    class RehashPolicy
 > class _hashtable_const_iterator
 {
 public:
@@ -71,16 +129,22 @@ public:
     using size_type = std::size_t;
     using difference_type = std::ptrdiff_t;
 
-    using self = _hashtable_const_iterator<Key, T, Value, Hash, KeyEqual, ExtractKey, Allocator>;
-    using node_pointer = _hashtable_node<value_type>*;
-    using hashtable_pointer = hashtable<Key, T, Value, Hash, KeyEqual, ExtractKey, Allocator>*;
-    using const_hashtable_pointer = const hashtable<Key, T, Value, Hash, KeyEqual, ExtractKey, Allocator>*;
+    using self = _hashtable_const_iterator<Key, T, Value, Hash, KeyEqual, ExtractKey, Allocator, CacheHash, RehashPolicy>;
+    using node_pointer = _hashtable_node<value_type, CacheHash>*;
+    using hashtable_pointer = hashtable<Key, T, Value, Hash, KeyEqual, ExtractKey, Allocator, CacheHash, RehashPolicy>*;
+    using const_hashtable_pointer = const hashtable<Key, T, Value, Hash, KeyEqual, ExtractKey, Allocator, CacheHash, RehashPolicy>*;
 
 public:
     node_pointer _node;     // 指向哈希表节点
     hashtable_pointer _ht;  // 指向迭代器所属于的哈希表
 
 public:
+    _hashtable_const_iterator()
+        : _node(nullptr)
+        , _ht(nullptr)
+    { // 构造不指向任何节点的迭代器
+    }
+
     _hashtable_const_iterator(const node_pointer node, const_hashtable_pointer ht)
         : _node(const_cast<node_pointer>(node))
         , _ht(const_cast<hashtable_pointer>(ht))
@@ -101,16 +165,8 @@ public:
 
     self & operator++()
     {
-        const node_pointer old = _node;
-        _node = _node->_next;   // 尝试指向下一个节点
-        if (_node == nullptr) {
-            // 不存在下一个节点，需要找到下一个非空桶
-            size_type index = _ht->_hash_key(_ht->_get_key(old->_data)) + 1;  // 使用_hash_key的重载
-            for (; _node == nullptr && index < _ht->bucket_count(); ++index) {
-                _node = _ht->_buckets[index];
-            }
-        }
-        // 如果到达尾部，会返回一个iterator(nullptr, ht)，即end()
+        // 所有节点在同一条链表上，到达尾部时为nullptr，即end()
+        _node = _node->_next;
         return *this;
     }
 
@@ -146,12 +202,14 @@ template <
     class Hash,
     class KeyEqual,
     class ExtractKey,
-    class Allocator
+    class Allocator,
+    bool CacheHash,
+    class RehashPolicy
 > class _hashtable_iterator
-    : public _hashtable_const_iterator<Key, T, Value, Hash, KeyEqual, ExtractKey, Allocator>
+    : public _hashtable_const_iterator<Key, T, Value, Hash, KeyEqual, ExtractKey, Allocator, CacheHash, RehashPolicy>
 {
 public:
-    using base = _hashtable_const_iterator<Key, T, Value, Hash, KeyEqual, ExtractKey, Allocator>;
+    using base = _hashtable_const_iterator<Key, T, Value, Hash, KeyEqual, ExtractKey, Allocator, CacheHash, RehashPolicy>;
     using iterator_category = std::forward_iterator_tag;
     using value_type = Value;
     using reference = value_type&;
@@ -159,11 +217,16 @@ public:
     using size_type = std::size_t;
     using difference_type = std::ptrdiff_t;
 
-    using self = _hashtable_iterator<Key, T, Value, Hash, KeyEqual, ExtractKey, Allocator>;
-    using node_pointer = _hashtable_node<value_type>*;
-    using hashtable_pointer = hashtable<Key, T, Value, Hash, KeyEqual, ExtractKey, Allocator>*;
+    using self = _hashtable_iterator<Key, T, Value, Hash, KeyEqual, ExtractKey, Allocator, CacheHash, RehashPolicy>;
+    using node_pointer = _hashtable_node<value_type, CacheHash>*;
+    using hashtable_pointer = hashtable<Key, T, Value, Hash, KeyEqual, ExtractKey, Allocator, CacheHash, RehashPolicy>*;
 
 public:
+    _hashtable_iterator()
+        : base()
+    { // 构造不指向任何节点的迭代器
+    }
+
     _hashtable_iterator(node_pointer node, hashtable_pointer ht)
         : base(node, ht)
     { // 以节点构造迭代器
@@ -196,9 +259,19 @@ public:
 
 /**
  * @brief hashtable local常量迭代器
+ * @details 桶的节点是全局链表中的一段，离开该段时迭代器变为end(n)
  */
-template <class Value>
-class _hashtable_const_local_iterator
+template <
+    class Key,
+    class T,
+    class Value,
+    class Hash,
+    class KeyEqual,
+    class ExtractKey,
+    class Allocator,
+    bool CacheHash,
+    class RehashPolicy
+> class _hashtable_const_local_iterator
 {
 public:
     using iterator_category = std::forward_iterator_tag;
@@ -208,16 +281,21 @@ public:
     using size_type = std::size_t;
     using difference_type = std::ptrdiff_t;
     
-    using self = _hashtable_const_local_iterator<Value>;
-    using node_pointer = _hashtable_node<value_type>*;
+    using self = _hashtable_const_local_iterator<Key, T, Value, Hash, KeyEqual, ExtractKey, Allocator, CacheHash, RehashPolicy>;
+    using node_pointer = _hashtable_node<value_type, CacheHash>*;
+    using const_hashtable_pointer = const hashtable<Key, T, Value, Hash, KeyEqual, ExtractKey, Allocator, CacheHash, RehashPolicy>*;
 
 public:
-    node_pointer _node;     // 指向哈希表节点
+    node_pointer _node;             // 指向哈希表节点
+    size_type _bucket;              // 所在的桶
+    const_hashtable_pointer _ht;    // 所属的哈希表
 
 public:
-    explicit _hashtable_const_local_iterator(const node_pointer node)
+    _hashtable_const_local_iterator(const node_pointer node, size_type bucket, const_hashtable_pointer ht)
         : _node(const_cast<node_pointer>(node))
-    { // 构造空迭代器
+        , _bucket(bucket)
+        , _ht(ht)
+    { // 以节点构造迭代器
     }
 
 public:
@@ -233,7 +311,7 @@ public:
 
     self & operator++()
     {
-        _node = _node->_next;
+        _node = _ht->_bucket_next(_node, _bucket);
         return *this;
     }
 
@@ -258,12 +336,21 @@ public:
 /**
  * @brief hashtable local迭代器
  */
-template <class Value>
-class _hashtable_local_iterator
-    : public _hashtable_const_local_iterator<Value>
+template <
+    class Key,
+    class T,
+    class Value,
+    class Hash,
+    class KeyEqual,
+    class ExtractKey,
+    class Allocator,
+    bool CacheHash,
+    class RehashPolicy
+> class _hashtable_local_iterator
+    : public _hashtable_const_local_iterator<Key, T, Value, Hash, KeyEqual, ExtractKey, Allocator, CacheHash, RehashPolicy>
 {
 public:
-    using base = _hashtable_const_local_iterator<Value>;
+    using base = _hashtable_const_local_iterator<Key, T, Value, Hash, KeyEqual, ExtractKey, Allocator, CacheHash, RehashPolicy>;
     using iterator_category = std::forward_iterator_tag;
     using value_type = Value;
     using reference = value_type&;
@@ -271,12 +358,13 @@ public:
     using size_type = std::size_t;
     using difference_type = std::ptrdiff_t;
 
-    using self = _hashtable_local_iterator<Value>;
-    using node_pointer = _hashtable_node<value_type>*;
+    using self = _hashtable_local_iterator<Key, T, Value, Hash, KeyEqual, ExtractKey, Allocator, CacheHash, RehashPolicy>;
+    using node_pointer = _hashtable_node<value_type, CacheHash>*;
+    using const_hashtable_pointer = const hashtable<Key, T, Value, Hash, KeyEqual, ExtractKey, Allocator, CacheHash, RehashPolicy>*;
 
 public:
-    explicit _hashtable_local_iterator(node_pointer node)
-        : base(node)
+    _hashtable_local_iterator(node_pointer node, size_type bucket, const_hashtable_pointer ht)
+        : base(node, bucket, ht)
     { // 以节点构造迭代器
     }
 
@@ -315,7 +403,9 @@ template <
     class Hash,
     class KeyEqual,
     class ExtractKey,
-    class Allocator
+    class Allocator,
+    bool CacheHash,
+    class RehashPolicy
 > class hashtable
 {
 public:
@@ -328,23 +418,45 @@ public:
     using allocator_type = Allocator;
     using size_type = std::size_t;
     using difference_type = std::ptrdiff_t;
-    using iterator = _hashtable_iterator<key_type, mapped_type, value_type, hasher, key_equal, key_extractor, allocator_type>;
-    using const_iterator = _hashtable_const_iterator<key_type, mapped_type, value_type, hasher, key_equal, key_extractor, allocator_type>;
-    using local_iterator = _hashtable_local_iterator<value_type>;
-    using const_local_iterator = _hashtable_const_local_iterator<value_type>;
+    using iterator = _hashtable_iterator<key_type, mapped_type, value_type, hasher, key_equal, key_extractor, allocator_type, CacheHash, RehashPolicy>;
+    using const_iterator = _hashtable_const_iterator<key_type, mapped_type, value_type, hasher, key_equal, key_extractor, allocator_type, CacheHash, RehashPolicy>;
+    using local_iterator = _hashtable_local_iterator<key_type, mapped_type, value_type, hasher, key_equal, key_extractor, allocator_type, CacheHash, RehashPolicy>;
+    using const_local_iterator = _hashtable_const_local_iterator<key_type, mapped_type, value_type, hasher, key_equal, key_extractor, allocator_type, CacheHash, RehashPolicy>;
 
-    using node = _hashtable_node<value_type>;
+    using node = _hashtable_node<value_type, CacheHash>;
     using node_pointer = node*;
+    using node_base = _hashtable_node_base<value_type, CacheHash>;
+    using base_pointer = node_base*;
     using node_allocator_type = typename allocator_type::template rebind<node>::other;
 
+    using rehash_policy_type = RehashPolicy;
+
+    using node_type = _node_handle<key_type, mapped_type, value_type, node, allocator_type>;
+    using insert_return_type = _node_insert_return<iterator, node_type>;
+
 public:
-    wwstl::vector<node_pointer> _buckets;   // 桶
+    /**
+     * 所有节点串成一条单链表，_before_begin._next是第一个节点
+     * 同一个桶的节点在链表中连续，_buckets[n]指向桶n第一个节点的前一个节点，桶为空时为nullptr
+     * 因此begin()、迭代器自增和按位置擦除都是O(1)，与桶数无关
+     *
+     * 增量重建时新旧两个桶数组并存，每次插入把_rehash_batch个旧桶中的节点迁移到新桶
+     * 节点的旧桶号不小于_rehash_index时仍在旧桶中，否则在新桶中；两个桶数组共用同一条链表，
+     * 内部的桶编号[0, bucket_count())为新桶，bucket_count() + 旧桶号为尚未迁移的旧桶
+     */
+    wwstl::vector<base_pointer> _buckets;   // 桶，指向桶中首个节点的前驱
+    rehash_policy_type _policy;             // 桶数策略，把哈希值映射到桶
+    node_base _before_begin;                // 链表头，第一个节点的前驱
     size_type _num_elements;                // 元素个数
     float _max_load_factor;                 // 最大负载因子
     hasher _hash;                           // 哈希函数
     key_equal _equals;                      // 判断键值是否相等
     key_extractor _get_key;                 // 获取键值
     node_allocator_type _node_allocator;    // 节点分配器
+    wwstl::vector<base_pointer> _old_buckets;   // 增量重建中尚未迁移完的旧桶，不在重建时为空
+    rehash_policy_type _old_policy;         // 旧桶的桶数策略
+    size_type _rehash_index;                // 下一个要迁移的旧桶
+    bool _incremental;                      // 扩容时是否增量重建
 
 public:
     /**
@@ -360,52 +472,74 @@ public:
     }
 
     explicit hashtable(size_type bucket_count, const hasher & hash = hasher(), const key_equal & equals = key_equal(), const allocator_type & alloc = allocator_type())
-        : _buckets(bucket_count)
+        : _buckets(rehash_policy_type::bucket_count_for(bucket_count))
+        , _policy(_buckets.size())
+        , _before_begin()
         , _num_elements(0)
         , _max_load_factor(1.0)
         , _hash(hash)
         , _equals(equals)
         , _get_key()
         , _node_allocator()
+        , _old_buckets()
+        , _old_policy()
+        , _rehash_index(0)
+        , _incremental(false)
     {
     }
 
     explicit hashtable(const allocator_type & alloc)
-        : _buckets(8)
+        : _buckets(rehash_policy_type::bucket_count_for(8))
+        , _policy(_buckets.size())
+        , _before_begin()
         , _num_elements(0)
         , _max_load_factor(1.0)
         , _hash()
         , _equals()
         , _get_key()
         , _node_allocator(alloc)
+        , _old_buckets()
+        , _old_policy()
+        , _rehash_index(0)
+        , _incremental(false)
     {
     }
 
     hashtable(const hashtable & other)
-        : _buckets(8)
+        : _buckets(rehash_policy_type::bucket_count_for(other._buckets.size()))
+        , _policy(_buckets.size())
+        , _before_begin()
         , _num_elements(0)
         , _max_load_factor(1.0)
         , _hash(other._hash)
         , _equals(other._equals)
         , _get_key(other._get_key)
         , _node_allocator(other._node_allocator)
+        , _old_buckets()
+        , _old_policy()
+        , _rehash_index(0)
+        , _incremental(other._incremental)
     {
-        _buckets.reserve(other._buckets.size());    // 预留空间
         for (auto it = other.begin(); it != other.end(); ++it) {
             emplace_equal(*it);     // 可以信任适配器的插入行为，允许重复插入来实现拷贝
         }
     }
 
     hashtable(const hashtable & other, const allocator_type & alloc)
-        : _buckets()
+        : _buckets(rehash_policy_type::bucket_count_for(other._buckets.size()))
+        , _policy(_buckets.size())
+        , _before_begin()
         , _num_elements(0)
         , _max_load_factor(1.0)
         , _hash(other._hash)
         , _equals(other._equals)
         , _get_key(other._get_key)
         , _node_allocator(alloc)
+        , _old_buckets()
+        , _old_policy()
+        , _rehash_index(0)
+        , _incremental(other._incremental)
     {
-        _buckets.reserve(other._buckets.size());    // 预留空间
         for (auto it = other.begin(); it != other.end(); ++it) {
             emplace_equal(*it);     // 可以信任适配器的插入行为，允许重复插入来实现拷贝
         }
@@ -413,26 +547,40 @@ public:
 
     hashtable(hashtable && other)
         : _buckets(std::move(other._buckets))
+        , _policy(other._policy)
+        , _before_begin()
         , _num_elements(other._num_elements)
         , _max_load_factor(other._max_load_factor)
         , _hash(other._hash)
         , _equals(other._equals)
         , _get_key(other._get_key)
         , _node_allocator(std::move(other._node_allocator))
+        , _old_buckets(std::move(other._old_buckets))
+        , _old_policy(other._old_policy)
+        , _rehash_index(other._rehash_index)
+        , _incremental(other._incremental)
     {
+        _take_list(other);
         other._num_elements = 0;
         other._max_load_factor = 1.0;
     }
 
     hashtable(hashtable && other, const allocator_type & alloc)
         : _buckets(std::move(other._buckets))
+        , _policy(other._policy)
+        , _before_begin()
         , _num_elements(other._num_elements)
         , _max_load_factor(other._max_load_factor)
         , _hash(other._hash)
         , _equals(other._equals)
         , _get_key(other._get_key)
         , _node_allocator(alloc)
+        , _old_buckets(std::move(other._old_buckets))
+        , _old_policy(other._old_policy)
+        , _rehash_index(other._rehash_index)
+        , _incremental(other._incremental)
     {
+        _take_list(other);
         other._num_elements = 0;
         other._max_load_factor = 1.0;
     }
@@ -453,6 +601,7 @@ public:
             // 拷贝哈希表
             _buckets.reserve(other._buckets.size());    // 预留空间
             _max_load_factor = other._max_load_factor;
+            _incremental = other._incremental;
             for (auto it = other.begin(); it != other.end(); ++it) {
                 emplace_equal(*it);     // 可以信任适配器的插入行为，允许重复插入来实现拷贝
             }
@@ -475,6 +624,12 @@ public:
             clear();
             // 移动哈希表
             _buckets = std::move(other._buckets);
+            _policy = other._policy;
+            _old_buckets = std::move(other._old_buckets);
+            _old_policy = other._old_policy;
+            _rehash_index = other._rehash_index;
+            _incremental = other._incremental;
+            _take_list(other);
             _num_elements = other._num_elements;
             _max_load_factor = other._max_load_factor;
             _hash = other._hash;
@@ -510,7 +665,7 @@ public:
      */
     iterator begin() noexcept
     {
-        return iterator(_get_begin(), this);
+        return iterator(_before_begin._next, this);
     }
 
     /**
@@ -518,7 +673,7 @@ public:
      */
     const_iterator begin() const noexcept
     {
-        return const_iterator(_get_begin(), this);
+        return const_iterator(_before_begin._next, this);
     }
 
     /**
@@ -586,15 +741,13 @@ public:
      */
     void clear()
     {
-        for (size_type n = 0; n < _buckets.size(); ++n) {
-            node_pointer cur = _buckets[n];
-            while (cur != nullptr) {
-                node_pointer next = cur->_next;
-                _destroy_node(cur);
-                cur = next;
-            }
-            _buckets[n] = nullptr;
+        for (node_pointer cur = _before_begin._next; cur != nullptr; ) {
+            node_pointer next = cur->_next;
+            _destroy_node(cur);
+            cur = next;
         }
+        _before_begin._next = nullptr;
+        _reset_buckets();
         _num_elements = 0;
     }
 
@@ -612,22 +765,38 @@ public:
     template <class... Args>
     std::pair<iterator, bool> emplace_unique(Args&&... args)
     {
-        _resize(_num_elements + 1);
-        node_pointer p = _create_node(std::forward<Args>(args)...);
-        const size_type n = _hash_key(_get_key(p->_data));
-        node_pointer first = _buckets[n];
-        for (node_pointer cur = first; cur != nullptr; cur = cur->_next) {
-            if (_equals(_get_key(cur->_data), _get_key(p->_data))) {
-                // 找到相同键值的节点，插入失败，返回阻碍插入的节点迭代器
-                _destroy_node(p);
-                return std::make_pair(iterator(cur, this), false);
-            }
+        return _emplace_unique(_emplace_key_extractable<key_type, mapped_type, Args...>(), std::forward<Args>(args)...);
+    }
+
+    /**
+     * @brief 键不存在时以key和args原位构造元素，键已存在时不做任何事
+     * @details 先查找再分配节点，键已存在时不会移动key和args
+     * @details 用于unordered_map
+     */
+    template <class K, class... Args>
+    std::pair<iterator, bool> try_emplace_unique(K && key, Args&&... args)
+    {
+        return _emplace_unique_key(key,
+            std::piecewise_construct,
+            std::forward_as_tuple(std::forward<K>(key)),
+            std::forward_as_tuple(std::forward<Args>(args)...));
+    }
+
+    /**
+     * @brief 键不存在时插入元素，键已存在时将obj赋值给对应的值
+     * @details 赋值时不分配节点，哈希值只计算一次，桶只查找一次
+     * @details 用于unordered_map
+     */
+    template <class K, class M>
+    std::pair<iterator, bool> insert_or_assign_unique(K && key, M && obj)
+    {
+        const size_type code = _hash_of(key);
+        base_pointer prev = _find_before(_bucket_index(code), key, code);
+        if (prev != nullptr) {
+            prev->_next->_data.second = std::forward<M>(obj);
+            return std::make_pair(iterator(prev->_next, this), false);
         }
-        // 未找到相同键值的节点，插入到链表头部
-        p->_next = first;
-        _buckets[n] = p;
-        ++_num_elements;
-        return std::make_pair(iterator(p, this), true);
+        return std::make_pair(_insert_unique_code(code, std::forward<K>(key), std::forward<M>(obj)), true);
     }
 
     /**
@@ -637,25 +806,7 @@ public:
     template <class... Args>
     iterator emplace_equal(Args&&... args)
     {
-        _resize(_num_elements + 1);
-        node_pointer p = _create_node(std::forward<Args>(args)...);
-        const size_type n = _hash_key(_get_key(p->_data));
-        node_pointer first = _buckets[n];
-        for (node_pointer cur = first; cur != nullptr; cur = cur->_next) {
-            if (_equals(_get_key(cur->_data), _get_key(p->_data))) {
-                // 找到相同键值的节点，插入到链表中
-                p->_next = cur->_next;
-                cur->_next = p;
-                ++_num_elements;
-                // _begin一定不需要更新
-                return iterator(p, this);
-            }
-        }
-        // 未找到相同键值的节点，插入到链表头部
-        p->_next = first;
-        _buckets[n] = p;
-        ++_num_elements;
-        return iterator(p, this);
+        return _insert_node_equal(_create_node(std::forward<Args>(args)...));
     }
 
     /**
@@ -685,161 +836,202 @@ public:
         return emplace_equal(std::forward<Args>(args)...);
     }
 
+    /**
+     * insert_unique和insert_equal的并行版本，用于一次性插入大量元素
+     * threads不大于1时逐个插入；否则以threads个线程重建整个表，已有的元素和新元素一起分发到新桶
+     * 并行期间会在多个线程中同时构造、销毁节点并调用哈希函数和判等函数，它们必须是线程安全的
+     * 构造节点或哈希函数抛出异常时，已构造的新节点被销毁，异常传给调用者，表保持不变；判等函数和析构函数不能抛出异常
+     */
+
+    /**
+     * @brief 以threads个线程插入[first, last)，不允许重复
+     * @details 与逐个插入的结果相同：已有的元素优先，重复的新元素中先出现的被保留
+     */
+    template <class ForwardIt>
+    void insert_unique(ForwardIt first, ForwardIt last, size_type threads)
+    {
+        if (threads <= 1) {
+            for (; first != last; ++first) {
+                emplace_unique(*first);
+            }
+            return;
+        }
+        _insert_parallel<true>(first, last, threads);
+    }
+
+    /**
+     * @brief 以threads个线程插入[first, last)，允许重复
+     */
+    template <class ForwardIt>
+    void insert_equal(ForwardIt first, ForwardIt last, size_type threads)
+    {
+        if (threads <= 1) {
+            for (; first != last; ++first) {
+                emplace_equal(*first);
+            }
+            return;
+        }
+        _insert_parallel<false>(first, last, threads);
+    }
+
     /**
      * @brief 擦除元素
+     * @details 只需在桶内找到前驱，返回的下一个元素就是链表中的下一个节点
      */
     iterator erase(const_iterator pos)
     {
         if (pos == end()) {
-            // hashtable_iterator不可能指向桶的末尾，无需多判断
             return end();
         }
 
-        const size_type n = _hash_key(_get_key(*pos));
-        for (node_pointer cur = _buckets[n], prev = nullptr; cur != nullptr; prev = cur, cur = cur->_next) {
-            if (cur == pos._node) {
-                node_pointer next = cur->_next;
-                if (prev == nullptr) {
-                    _buckets[n] = next;
-                } else {
-                    prev->_next = next;
-                }
-                _destroy_node(cur);
-                --_num_elements;
-
-                if (next != nullptr) {
-                    return iterator(next, this);
-                }
-                
-                // 寻找下一个非空桶
-                for (size_type i = n + 1; i < bucket_count(); ++i) {
-                    if (_buckets[i] != nullptr) {
-                        return iterator(_buckets[i], this);
-                    }
-                }
-                return end();
-            }
-        }
-        return end();
+        node_pointer p = pos._node;
+        const size_type n = _bucket_of(p);
+        node_pointer next = p->_next;
+        _unlink(n, _get_previous(n, p), p);
+        _destroy_node(p);
+        return iterator(next, this);
     }
 
     /**
      * @brief 擦除元素
-     * @details 需要优化逻辑
+     * @details 沿链表销毁[first, last)，每离开一个桶时维护该桶和下一个桶的前驱
      */
     iterator erase(const_iterator first, const_iterator last)
     {
-        // 计算[first, last)的桶范围
-        size_type first_bucket = _hash_key(_get_key(*first));
-        size_type last_bucket = bucket_count();  // 用于区分last是否为end()，实际上不可访问
-        if (last != end()) {
-            last_bucket = _hash_key(_get_key(*last));
-        }
-
-        if (first_bucket == last_bucket) {
-            // 位于同一个桶，寻找first的前一个节点
-            node_pointer prev = nullptr;
-            node_pointer cur = _buckets[first_bucket];
-            while (cur != nullptr && cur != first._node) {
-                prev = cur;
-                cur = cur->_next;
-            }
-            // 逐个销毁节点
-            while (cur != nullptr && cur != last._node) {
-                node_pointer next = cur->_next;
-                _destroy_node(cur);
-                cur = next;
-                --_num_elements;
-            }
-            // 更新链表
-            if (prev == nullptr) {
-                _buckets[first_bucket] = cur;
-            } else {
-                prev->_next = cur;
-            }
-        } else {
-            // 位于不同桶，分别处理
-            if (last_bucket == -1) {
-                // 说明last是end()，需要擦除后面所有的桶
-                last_bucket = _buckets.size() - 1;
-            }
-            // first所在的桶，直接销毁first后面的节点
-            node_pointer prev = nullptr;
-            node_pointer cur = _buckets[first_bucket];
-            while (cur != nullptr && cur != first._node) {
-                prev = cur;
-                cur = cur->_next;
-            }
-            if (prev == nullptr) {
-                // 说明first是桶的第一个节点，直接销毁链表
-                _buckets[first_bucket] = nullptr;
-                while (cur != nullptr) {
-                    node_pointer next = cur->_next;
-                    _destroy_node(cur);
-                    cur = next;
-                    --_num_elements;
-                }
-            } else {
-                // 说明first不是桶的第一个节点，从prev开始销毁
-                node_pointer cur = first._node;
-                while (cur != nullptr) {
-                    node_pointer next = cur->_next;
-                    _destroy_node(cur);
-                    cur = next;
-                    --_num_elements;
-                }
-                prev->_next = nullptr;
-            }
-            // 中间的桶，直接销毁整个桶
-            for (size_type n = first_bucket + 1; n < last_bucket - 1; ++n) {
-                node_pointer cur = _buckets[n];
-                while (cur != nullptr) {
-                    node_pointer next = cur->_next;
-                    _destroy_node(cur);
-                    cur = next;
-                    --_num_elements;
-                }
-                _buckets[n] = nullptr;
-            }
-            // last所在的桶，销毁last前面的节点
-            cur = _buckets[last_bucket];
-            while (cur != last._node) {
-                node_pointer next = cur->_next;
-                _destroy_node(cur);
-                cur = next;
-                --_num_elements;
-            }
-            _buckets[last_bucket] = cur;
+        if (first == last) {
+            return iterator(last._node, this);
         }
+        const size_type n = _bucket_of(first._node);
+        _erase_range(n, _get_previous(n, first._node), first._node, last._node);
         return iterator(last._node, this);
     }
 
     /**
      * @brief 擦除元素
+     * @details 相等的节点在链表中连续，作为一段擦除
      */
     size_type erase(const key_type & key)
     {
-        const size_type n = _hash_key(key);
-        size_type erased = 0;
+        const size_type code = _hash_of(key);
+        const size_type n = _bucket_index(code);
+        base_pointer prev = _find_before(n, key, code);
+        if (prev == nullptr) {
+            return 0;
+        }
+        size_type erased = 1;
+        node_pointer last = prev->_next->_next;
+        for (; last != nullptr && _node_equals(last, key, code); last = last->_next) {
+            ++erased;
+        }
+        _erase_range(n, prev, prev->_next, last);
+        return erased;
+    }
 
-        for (node_pointer cur = _buckets[n], prev = nullptr; cur != nullptr; ) {
-            if (_equals(_get_key(cur->_data), key)) {
-                node_pointer next = cur->_next;
-                if (prev == nullptr) {
-                    _buckets[n] = next;
-                } else {
-                    prev->_next = next;
-                }
-                _destroy_node(cur);
-                cur = next;
-                ++erased;
-                --_num_elements;
+    // 节点句柄
+    /**
+     * 以下操作直接摘下或链接节点，不分配、不构造也不销毁元素
+     * 节点只能在分配器相等的哈希表之间移动
+     */
+
+    /**
+     * @brief 摘下pos指向的节点
+     */
+    node_type extract(const_iterator pos)
+    {
+        node_pointer p = pos._node;
+        const size_type n = _bucket_of(p);
+        _unlink(n, _get_previous(n, p), p);
+        p->_next = nullptr;
+        return node_type(p, _node_allocator);
+    }
+
+    /**
+     * @brief 摘下首个键等于key的节点，不存在时返回空句柄
+     */
+    node_type extract(const key_type & key)
+    {
+        node_pointer p = _find(key);
+        if (p == nullptr) {
+            return node_type();
+        }
+        return extract(const_iterator(p, this));
+    }
+
+    /**
+     * @brief 插入节点句柄，不允许重复
+     * @details 插入失败时节点仍由返回值中的node持有
+     */
+    insert_return_type insert_unique(node_type && nh)
+    {
+        if (nh.empty()) {
+            return insert_return_type{end(), false, node_type()};
+        }
+        std::pair<iterator, bool> result = _insert_node_unique(nh._node);
+        if (!result.second) {
+            return insert_return_type{result.first, false, std::move(nh)};
+        }
+        nh._release();
+        return insert_return_type{result.first, true, node_type()};
+    }
+
+    /**
+     * @brief 插入节点句柄，允许重复
+     */
+    iterator insert_equal(node_type && nh)
+    {
+        if (nh.empty()) {
+            return end();
+        }
+        return _insert_node_equal(nh._release());
+    }
+
+    /**
+     * @brief 将other中键不存在于自身的节点移动到自身，不允许重复
+     * @details 键已存在的节点留在other中，哈希函数和判等函数可以不同
+     */
+    template <class OtherHash, class OtherKeyEqual>
+    void merge_unique(hashtable<Key, T, Value, OtherHash, OtherKeyEqual, ExtractKey, Allocator, CacheHash, RehashPolicy> & other)
+    {
+        if (static_cast<void *>(&other) == static_cast<void *>(this)) {
+            return;
+        }
+        base_pointer prev = &other._before_begin;
+        node_pointer cur = other._before_begin._next;
+        while (cur != nullptr) {
+            node_pointer next = cur->_next;
+            if (_find(_get_key(cur->_data)) == nullptr) {
+                // 从other的链表中摘下，prev仍是next的前驱
+                other._unlink(other._bucket_of(cur), prev, cur);
+                _insert_node_unique(cur);
             } else {
                 prev = cur;
-                cur = cur->_next;
             }
+            cur = next;
         }
-        return erased;
+    }
+
+    /**
+     * @brief 将other的所有节点移动到自身，允许重复
+     */
+    template <class OtherHash, class OtherKeyEqual>
+    void merge_equal(hashtable<Key, T, Value, OtherHash, OtherKeyEqual, ExtractKey, Allocator, CacheHash, RehashPolicy> & other)
+    {
+        if (static_cast<void *>(&other) == static_cast<void *>(this)) {
+            return;
+        }
+        if (_num_elements + other._num_elements > bucket_count() * max_load_factor()) {
+            // 一次扩容到位，避免逐个插入时多次重建
+            reserve(_num_elements + other._num_elements);
+        }
+        node_pointer cur = other._before_begin._next;
+        while (cur != nullptr) {
+            node_pointer next = cur->_next;
+            _insert_node_equal(cur);
+            cur = next;
+        }
+        other._before_begin._next = nullptr;
+        other._reset_buckets();
+        other._num_elements = 0;
     }
 
     /**
@@ -848,6 +1040,14 @@ public:
     void swap(hashtable & other)
     {
         std::swap(_buckets, other._buckets);
+        std::swap(_policy, other._policy);
+        std::swap(_old_buckets, other._old_buckets);
+        std::swap(_old_policy, other._old_policy);
+        std::swap(_rehash_index, other._rehash_index);
+        std::swap(_incremental, other._incremental);
+        std::swap(_before_begin._next, other._before_begin._next);
+        _fix_before_begin();
+        other._fix_before_begin();
         std::swap(_num_elements, other._num_elements);
         std::swap(_max_load_factor, other._max_load_factor);
         std::swap(_hash, other._hash);
@@ -893,8 +1093,7 @@ public:
     template <typename U = mapped_type, typename = typename std::enable_if<!std::is_void<U>::value>::type>
     U & operator[](const key_type & key)
     {
-        auto it = emplace_unique(std::make_pair(key, mapped_type()));
-        return it.first->second;
+        return try_emplace_unique(key).first->second;
     }
 
     /**
@@ -903,23 +1102,76 @@ public:
     template <typename U = mapped_type, typename = typename std::enable_if<!std::is_void<U>::value>::type>
     U & operator[](key_type && key)
     {
-        auto it = emplace_unique(std::make_pair(std::move(key), mapped_type()));
-        return it.first->second;
+        return try_emplace_unique(std::move(key)).first->second;
     }
 
     /**
-     * @brief 返回匹配特定键的元素数量
+     * @brief 批量查找，依次将每个键的查找结果写入out，不存在时写入end()
+     * @details 每批先计算所有键的桶并预取桶头，再预取链表的首个节点，最后才逐个比较，使多个键的缓存缺失重叠
+     * @return 写入结束后的输出迭代器
      */
-    size_type count(const key_type & key) const
+    template <class ForwardIt, class OutputIt>
+    OutputIt find_many(ForwardIt first, ForwardIt last, OutputIt out)
     {
-        const size_type n = _hash_key(key);
-        size_type result = 0;
-        for (node_pointer cur = _buckets[n]; cur != nullptr; cur = cur->_next) {
-            if (_equals(_get_key(cur->_data), key)) {
-                ++result;
+        return _find_many<iterator>(first, last, out);
+    }
+
+    /**
+     * @brief 批量查找，依次将每个键的查找结果写入out，不存在时写入end()
+     */
+    template <class ForwardIt, class OutputIt>
+    OutputIt find_many(ForwardIt first, ForwardIt last, OutputIt out) const
+    {
+        return _find_many<const_iterator>(first, last, out);
+    }
+
+    /**
+     * @brief 批量计数，依次将匹配每个键的元素数量写入out
+     * @details 预取方式与find_many相同，相等的节点在桶内连续
+     * @return 写入结束后的输出迭代器
+     */
+    template <class ForwardIt, class OutputIt>
+    OutputIt count_many(ForwardIt first, ForwardIt last, OutputIt out) const
+    {
+        node_pointer heads[_lookup_batch];
+        size_type codes[_lookup_batch];
+        while (first != last) {
+            ForwardIt batch_first = first;
+            const size_type n = _bucket_heads_many(first, last, heads, codes);
+            for (size_type i = 0; i < n; ++i, ++batch_first) {
+                size_type result = 0;
+                const size_type bucket = _bucket_index(codes[i]);
+                node_pointer cur = heads[i];
+                while (cur != nullptr && !_node_equals(cur, *batch_first, codes[i])) {
+                    cur = _bucket_next(cur, bucket);
+                }
+                // 相等的节点在链表中连续
+                for (; cur != nullptr && _node_equals(cur, *batch_first, codes[i]); cur = cur->_next) {
+                    ++result;
+                }
+                *out = result;
+                ++out;
             }
         }
-        return result;
+        return out;
+    }
+
+    /**
+     * @brief 返回匹配特定键的元素数量
+     */
+    size_type count(const key_type & key) const
+    {
+        return _count_equal(key);
+    }
+
+    /**
+     * @brief 返回匹配特定键的元素数量
+     * @details 异构查找，要求哈希函数和键比较函数都定义is_transparent，不需要构造临时的key_type
+     */
+    template <class K, class H = hasher, class E = key_equal, class = typename H::is_transparent, class = typename E::is_transparent>
+    size_type count(const K & key) const
+    {
+        return _count_equal(key);
     }
 
     /**
@@ -938,25 +1190,32 @@ public:
         return const_iterator(_find(key), this);
     }
 
+    /**
+     * @brief 查找特定键的元素
+     * @details 异构查找，要求哈希函数和键比较函数都定义is_transparent，不需要构造临时的key_type
+     */
+    template <class K, class H = hasher, class E = key_equal, class = typename H::is_transparent, class = typename E::is_transparent>
+    iterator find(const K & key)
+    {
+        return iterator(_find(key), this);
+    }
+
+    /**
+     * @brief 查找特定键的元素
+     * @details 异构查找，要求哈希函数和键比较函数都定义is_transparent，不需要构造临时的key_type
+     */
+    template <class K, class H = hasher, class E = key_equal, class = typename H::is_transparent, class = typename E::is_transparent>
+    const_iterator find(const K & key) const
+    {
+        return const_iterator(_find(key), this);
+    }
+
     /**
      * @brief 返回匹配特定键的元素范围
      */
     std::pair<iterator, iterator> equal_range(const key_type & key)
     {
-        const size_type n = _hash_key(key);
-        for (node_pointer cur = _buckets[n]; cur != nullptr; cur = cur->_next) {
-            if (_equals(_get_key(cur->_data), key)) {
-                // 找到第一个匹配的节点
-                node_pointer first = cur;
-                while (cur->_next != nullptr && _equals(_get_key(cur->_next->_data), key)) {
-                    // 该节点还是匹配的，继续向后
-                    cur = cur->_next;
-                }
-                iterator last = iterator(cur, this);  // 因为可能是桶的末尾，所以不能直接移动指针，而应该移动迭代器，否则可能返回end()
-                return std::make_pair(iterator(first, this), std::next(last));
-            }
-        }
-        return std::make_pair(end(), end());
+        return _equal_range<iterator>(key);
     }
 
     /**
@@ -964,18 +1223,27 @@ public:
      */
     std::pair<const_iterator, const_iterator> equal_range(const key_type & key) const
     {
-        const size_type n = _hash_key(key);
-        for (node_pointer cur = _buckets[n]; cur != nullptr; cur = cur->_next) {
-            if (_equals(_get_key(cur->_data), key)) {
-                node_pointer first = cur;
-                while (cur->_next != nullptr && _equals(_get_key(cur->_next->_data), key)) {
-                    cur = cur->_next;
-                }
-                const_iterator last = const_iterator(cur, this);
-                return std::make_pair(const_iterator(first, this), std::next(last));
-            }
-        }
-        return std::make_pair(cend(), cend());
+        return _equal_range<const_iterator>(key);
+    }
+
+    /**
+     * @brief 返回匹配特定键的元素范围
+     * @details 异构查找，要求哈希函数和键比较函数都定义is_transparent，不需要构造临时的key_type
+     */
+    template <class K, class H = hasher, class E = key_equal, class = typename H::is_transparent, class = typename E::is_transparent>
+    std::pair<iterator, iterator> equal_range(const K & key)
+    {
+        return _equal_range<iterator>(key);
+    }
+
+    /**
+     * @brief 返回匹配特定键的元素范围
+     * @details 异构查找，要求哈希函数和键比较函数都定义is_transparent，不需要构造临时的key_type
+     */
+    template <class K, class H = hasher, class E = key_equal, class = typename H::is_transparent, class = typename E::is_transparent>
+    std::pair<const_iterator, const_iterator> equal_range(const K & key) const
+    {
+        return _equal_range<const_iterator>(key);
     }
 
     // 桶接口
@@ -985,7 +1253,8 @@ public:
      */
     local_iterator begin(size_type n)
     {
-        return local_iterator(_buckets[n]);
+        _complete_rehash();
+        return local_iterator(_bucket_begin(n), n, this);
     }
 
     /**
@@ -993,7 +1262,8 @@ public:
      */
     const_local_iterator begin(size_type n) const
     {
-        return const_local_iterator(_buckets[n]);
+        const_cast<hashtable *>(this)->_complete_rehash();
+        return const_local_iterator(_bucket_begin(n), n, this);
     }
 
     /**
@@ -1009,7 +1279,7 @@ public:
      */
     local_iterator end(size_type n)
     {
-        return local_iterator(nullptr);
+        return local_iterator(nullptr, n, this);
     }
 
     /**
@@ -1017,7 +1287,7 @@ public:
      */
     const_local_iterator end(size_type n) const
     {
-        return const_local_iterator(nullptr);
+        return const_local_iterator(nullptr, n, this);
     }
 
     /**
@@ -1049,8 +1319,9 @@ public:
      */
     size_type bucket_size(size_type n) const
     {
+        const_cast<hashtable *>(this)->_complete_rehash();
         size_type result = 0;
-        for (node_pointer cur = _buckets[n]; cur != nullptr; cur = cur->_next) {
+        for (node_pointer cur = _bucket_begin(n); cur != nullptr; cur = _bucket_next(cur, n)) {
             ++result;
         }
         return result;
@@ -1061,7 +1332,7 @@ public:
      */
     size_type bucket(const key_type & key) const
     {
-        return _hash_key(key);
+        return _policy.index(_hash_of(key));
     }
 
     // 散列策略
@@ -1071,7 +1342,7 @@ public:
      */
     float load_factor() const
     {
-        return static_cast<float>(size()) / static_cast<float>(bucket_count());
+        return static_cast<float>(size()) / static_cast<float>(_buckets.size());
     }
 
     /**
@@ -1091,34 +1362,87 @@ public:
     }
 
     /**
-     * @brief 预留至少指定数量的桶并重新生成散列表
+     * @brief 返回扩容时是否增量重建
      */
-    void rehash(size_type count)
+    bool incremental_rehash() const
     {
-        wwstl::vector<node_pointer> new_buckets(count, nullptr);
-        // 重新计算每个元素的位置
-        for (size_type n = 0; n < _buckets.size(); ++n) {
-            for (node_pointer cur = _buckets[n]; cur != nullptr; ) {
-                node_pointer next = cur->_next;
-                const size_type new_n = _hash_key(_get_key(cur->_data), count);
-                cur->_next = new_buckets[new_n];
-                new_buckets[new_n] = cur;
-                cur = next;
-            }
-        }
-        // 交换桶
-        _buckets.swap(new_buckets);
+        return _incremental;
     }
 
     /**
-     * @brief 为至少指定数量的元素预留空间并重新生成散列表
+     * @brief 设置扩容时是否增量重建
+     * @details 开启后扩容只分配新桶，节点在之后的插入中分批迁移，单次插入的耗时有上界
      */
-    void reserve(size_type count)
+    void incremental_rehash(bool enable)
     {
-        rehash(std::ceil(count / max_load_factor()));
+        _incremental = enable;
     }
 
-    // 观察器
+    /**
+     * @brief 预留至少指定数量的桶并重新生成散列表
+     * @details 桶数不少于size() / max_load_factor()，并由桶数策略向上取整
+     * @details 正在增量重建时先完成迁移，再一次性重建
+     */
+    void rehash(size_type count)
+    {
+        _complete_rehash();
+        count = std::max(count, static_cast<size_type>(std::ceil(_num_elements / max_load_factor())));
+        count = rehash_policy_type::bucket_count_for(count);
+        const rehash_policy_type new_policy(count);
+        wwstl::vector<base_pointer> new_buckets(count, nullptr);
+        // 沿链表逐个摘下节点，插入到新桶的开头；相等的节点在链表中相邻，重建后仍然相邻
+        node_pointer cur = _before_begin._next;
+        _before_begin._next = nullptr;
+        size_type first_bucket = 0;     // 当前链表第一个节点所在的新桶
+        while (cur != nullptr) {
+            node_pointer next = cur->_next;
+            const size_type new_n = new_policy.index(_node_hash(cur));
+            if (new_buckets[new_n] == nullptr) {
+                // 新桶为空，节点放到链表头部，原来的第一个节点所在的桶的前驱变为cur
+                cur->_next = _before_begin._next;
+                _before_begin._next = cur;
+                new_buckets[new_n] = &_before_begin;
+                if (cur->_next != nullptr) {
+                    new_buckets[first_bucket] = cur;
+                }
+                first_bucket = new_n;
+            } else {
+                cur->_next = new_buckets[new_n]->_next;
+                new_buckets[new_n]->_next = cur;
+            }
+            cur = next;
+        }
+        // 交换桶
+        _buckets.swap(new_buckets);
+        _policy = new_policy;
+    }
+
+    /**
+     * @brief 以threads个线程重新生成散列表
+     * @details 旧桶按范围分给各线程，节点按新桶所在的分片分发，每个线程再独占一个分片的新桶完成链接，全程无锁
+     * @details threads不大于1时与rehash(count)相同
+     */
+    void rehash(size_type count, size_type threads)
+    {
+        if (threads <= 1) {
+            rehash(count);
+            return;
+        }
+        _complete_rehash();
+        count = std::max(count, static_cast<size_type>(std::ceil(_num_elements / max_load_factor())));
+        count = rehash_policy_type::bucket_count_for(count);
+        _parallel_relink<false>(count, threads, static_cast<const value_type *>(nullptr), static_cast<const value_type *>(nullptr));
+    }
+
+    /**
+     * @brief 为至少指定数量的元素预留空间并重新生成散列表
+     */
+    void reserve(size_type count)
+    {
+        rehash(std::ceil(count / max_load_factor()));
+    }
+
+    // 观察器
 
     /**
      * @brief 返回用于对键求散列的函数
@@ -1138,22 +1462,274 @@ public:
 
 public:
     /**
-     * @brief 计算key所在的桶
-     * @param key 键
-     * @param n 桶的数量
+     * @brief 哈希值所在的桶，由桶数策略计算
+     * @details 增量重建期间尚未迁移的节点返回旧桶的编号
+     */
+    size_type _bucket_index(size_type code) const
+    {
+        if (!_old_buckets.empty()) {
+            const size_type old_n = _old_policy.index(code);
+            if (old_n >= _rehash_index) {
+                return _buckets.size() + old_n;
+            }
+        }
+        return _policy.index(code);
+    }
+
+    /**
+     * @brief 编号为n的桶，增量重建期间可能是旧桶
+     */
+    base_pointer & _slot(size_type n)
+    {
+        return n < _buckets.size() ? _buckets[n] : _old_buckets[n - _buckets.size()];
+    }
+
+    const base_pointer & _slot(size_type n) const
+    {
+        return n < _buckets.size() ? _buckets[n] : _old_buckets[n - _buckets.size()];
+    }
+
+    using _cache_tag = std::integral_constant<bool, CacheHash>;
+    using _mix_tag = std::integral_constant<bool, RehashPolicy::requires_mixed_hash && !hash_is_mixed<hasher>::value>;
+
+    /**
+     * @brief 键的哈希值，桶的映射和缓存的哈希值都由此得到
+     * @details 桶数策略要求哈希值充分打散而哈希函数没有声明is_mixed时，在这里打散一次
+     */
+    template <class K>
+    size_type _hash_of(const K & key) const
+    {
+        return _mix_code(_hash(key), _mix_tag());
+    }
+
+    static size_type _mix_code(size_type code, std::true_type)
+    {
+        return _hash_mix(code);
+    }
+
+    static size_type _mix_code(size_type code, std::false_type)
+    {
+        return code;
+    }
+
+    /**
+     * @brief 节点的键的哈希值，缓存时直接读取
+     */
+    size_type _node_hash(node_pointer p) const
+    {
+        return _node_hash(p, _cache_tag());
+    }
+
+    size_type _node_hash(node_pointer p, std::true_type) const
+    {
+        return p->_hash_code;
+    }
+
+    size_type _node_hash(node_pointer p, std::false_type) const
+    {
+        return _hash_of(_get_key(p->_data));
+    }
+
+    /**
+     * @brief 节点所在的桶
+     */
+    size_type _bucket_of(node_pointer p) const
+    {
+        return _bucket_index(_node_hash(p));
+    }
+
+    static void _store_hash(node_pointer p, size_type code, std::true_type)
+    {
+        p->_hash_code = code;
+    }
+
+    static void _store_hash(node_pointer, size_type, std::false_type)
+    {
+    }
+
+    /**
+     * @brief 判断节点的键是否与哈希值为code的key相等
+     * @details 缓存哈希值时先比较哈希值，同一个桶中哈希值不同的节点不会调用_equals
+     */
+    template <class K>
+    bool _node_equals(node_pointer p, const K & key, size_type code) const
+    {
+        return _node_equals(p, key, code, _cache_tag());
+    }
+
+    template <class K>
+    bool _node_equals(node_pointer p, const K & key, size_type code, std::true_type) const
+    {
+        return p->_hash_code == code && _equals(_get_key(p->_data), key);
+    }
+
+    template <class K>
+    bool _node_equals(node_pointer p, const K & key, size_type, std::false_type) const
+    {
+        return _equals(_get_key(p->_data), key);
+    }
+
+    /**
+     * @brief 桶n的首个节点，桶为空时返回nullptr
+     */
+    node_pointer _bucket_begin(size_type n) const
+    {
+        const base_pointer prev = _slot(n);
+        return prev == nullptr ? nullptr : prev->_next;
+    }
+
+    /**
+     * @brief 桶n中p的下一个节点，p是桶的最后一个节点时返回nullptr
+     */
+    node_pointer _bucket_next(node_pointer p, size_type n) const
+    {
+        node_pointer next = p->_next;
+        return next != nullptr && _bucket_of(next) == n ? next : nullptr;
+    }
+
+    /**
+     * @brief 在桶n中查找首个与key相等的节点的前驱，不存在时返回nullptr
+     */
+    template <class K>
+    base_pointer _find_before(size_type n, const K & key, size_type code) const
+    {
+        base_pointer prev = _slot(n);
+        if (prev == nullptr) {
+            return nullptr;
+        }
+        for (node_pointer cur = prev->_next; cur != nullptr; prev = cur, cur = _bucket_next(cur, n)) {
+            if (_node_equals(cur, key, code)) {
+                return prev;
+            }
+        }
+        return nullptr;
+    }
+
+    /**
+     * @brief 桶n中节点p的前驱
+     */
+    base_pointer _get_previous(size_type n, node_pointer p) const
+    {
+        base_pointer prev = _slot(n);
+        while (prev->_next != p) {
+            prev = prev->_next;
+        }
+        return prev;
+    }
+
+    /**
+     * @brief 将节点p链接为桶n的首个节点
+     * @details 桶为空时p放到链表头部，原来的第一个节点所在的桶的前驱变为p
      */
-    size_type _hash_key(const key_type & key, size_type n) const
+    void _insert_bucket_begin(size_type n, node_pointer p)
     {
-        return _hash(key) % n;
+        base_pointer & slot = _slot(n);
+        if (slot != nullptr) {
+            p->_next = slot->_next;
+            slot->_next = p;
+        } else {
+            p->_next = _before_begin._next;
+            _before_begin._next = p;
+            if (p->_next != nullptr) {
+                _slot(_bucket_of(p->_next)) = p;
+            }
+            slot = &_before_begin;
+        }
+    }
+
+    /**
+     * @brief 从链表中摘下桶n中前驱为prev的节点p，不销毁节点
+     */
+    void _unlink(size_type n, base_pointer prev, node_pointer p)
+    {
+        node_pointer next = p->_next;
+        if (prev == _slot(n)) {
+            // p是桶的首个节点
+            _remove_bucket_begin(n, next, next == nullptr ? 0 : _bucket_of(next));
+        } else if (next != nullptr) {
+            // p是桶的最后一个节点时，下一个桶的前驱变为prev
+            const size_type next_n = _bucket_of(next);
+            if (next_n != n) {
+                _slot(next_n) = prev;
+            }
+        }
+        prev->_next = next;
+        --_num_elements;
     }
 
     /**
-     * @brief 计算key所在的桶
-     * @param key 键
+     * @brief 桶n的首个节点将被摘下，next为其后继，next_n为next所在的桶
+     * @details 摘下后桶为空时，把桶n的前驱交给next所在的桶
      */
-    size_type _hash_key(const key_type & key) const
+    void _remove_bucket_begin(size_type n, node_pointer next, size_type next_n)
     {
-        return _hash_key(key, _buckets.size());
+        if (next == nullptr || next_n != n) {
+            if (next != nullptr) {
+                _slot(next_n) = _slot(n);
+            }
+            if (_slot(n) == &_before_begin) {
+                _before_begin._next = next;
+            }
+            _slot(n) = nullptr;
+        }
+    }
+
+    /**
+     * @brief 销毁从桶n中前驱为prev的节点first开始直到last之前的节点
+     */
+    void _erase_range(size_type n, base_pointer prev, node_pointer first, node_pointer last)
+    {
+        bool is_bucket_begin = prev == _slot(n);
+        node_pointer cur = first;
+        size_type cur_n = n;
+        for (;;) {
+            // 销毁当前桶中直到last或离开该桶的节点
+            do {
+                node_pointer next = cur->_next;
+                _destroy_node(cur);
+                --_num_elements;
+                cur = next;
+                if (cur == nullptr) {
+                    break;
+                }
+                cur_n = _bucket_of(cur);
+            } while (cur != last && cur_n == n);
+
+            if (is_bucket_begin) {
+                _remove_bucket_begin(n, cur, cur_n);
+            }
+            if (cur == last) {
+                break;
+            }
+            // 之后的桶都从首个节点开始擦除
+            is_bucket_begin = true;
+            n = cur_n;
+        }
+        if (cur != nullptr && (cur_n != n || is_bucket_begin)) {
+            _slot(cur_n) = prev;
+        }
+        prev->_next = cur;
+    }
+
+    /**
+     * @brief 接管other的链表，other的链表置空
+     * @details 桶已经从other移动过来，首个节点所在的桶仍指向other._before_begin，需要改为自身
+     */
+    void _take_list(hashtable & other)
+    {
+        _before_begin._next = other._before_begin._next;
+        other._before_begin._next = nullptr;
+        _fix_before_begin();
+    }
+
+    /**
+     * @brief 使首个节点所在的桶指向自身的_before_begin
+     */
+    void _fix_before_begin()
+    {
+        if (_before_begin._next != nullptr) {
+            _slot(_bucket_of(_before_begin._next)) = &_before_begin;
+        }
     }
 
     node_pointer _get_node()
@@ -1171,7 +1747,12 @@ public:
     node_pointer _create_node(Args&&... args)
     {
         node_pointer p = _get_node();
-        allocator_traits<node_allocator_type>::construct(_node_allocator, p, std::forward<Args>(args)...);
+        try {
+            allocator_traits<node_allocator_type>::construct(_node_allocator, p, std::forward<Args>(args)...);
+        } catch (...) {
+            _put_node(p);
+            throw;
+        }
         return p;
     }
 
@@ -1182,16 +1763,110 @@ public:
     }
 
     /**
-     * @brief 返回指向第一个元素节点的指针
+     * @brief 插入已创建的节点，不允许重复
+     * @details 插入失败时不销毁节点，由调用者处理
      */
-    node_pointer _get_begin() const
+    std::pair<iterator, bool> _insert_node_unique(node_pointer p)
     {
-        for (size_type n = 0; n < _buckets.size(); ++n) {
-            if (_buckets[n] != nullptr) {
-                return _buckets[n];
+        _resize(_num_elements + 1);
+        const size_type code = _hash_of(_get_key(p->_data));
+        _store_hash(p, code, _cache_tag());
+        const size_type n = _bucket_index(code);
+        base_pointer prev = _find_before(n, _get_key(p->_data), code);
+        if (prev != nullptr) {
+            // 找到相同键值的节点，插入失败，返回阻碍插入的节点迭代器
+            return std::make_pair(iterator(prev->_next, this), false);
+        }
+        // 未找到相同键值的节点，插入到桶的开头
+        _insert_bucket_begin(n, p);
+        ++_num_elements;
+        return std::make_pair(iterator(p, this), true);
+    }
+
+    /**
+     * @brief 从参数中可以直接取得键，先查找再构造
+     */
+    template <class... Args>
+    std::pair<iterator, bool> _emplace_unique(std::true_type, Args&&... args)
+    {
+        return _emplace_unique_key(_emplace_key_of<key_type>(std::is_void<mapped_type>(), args...), std::forward<Args>(args)...);
+    }
+
+    /**
+     * @brief 无法直接取得键，先构造节点再插入，重复时销毁节点
+     */
+    template <class... Args>
+    std::pair<iterator, bool> _emplace_unique(std::false_type, Args&&... args)
+    {
+        node_pointer p = _create_node(std::forward<Args>(args)...);
+        std::pair<iterator, bool> result = _insert_node_unique(p);
+        if (!result.second) {
+            // 重复，插入失败
+            _destroy_node(p);
+        }
+        return result;
+    }
+
+    /**
+     * @brief 以键查找，不存在时才以args构造节点并插入
+     * @details 哈希值只计算一次，扩容后用同一个哈希值重新定位桶
+     * @details key可能引用args中的对象，构造节点之后不能再使用key
+     */
+    template <class K, class... Args>
+    std::pair<iterator, bool> _emplace_unique_key(const K & key, Args&&... args)
+    {
+        const size_type code = _hash_of(key);
+        base_pointer prev = _find_before(_bucket_index(code), key, code);
+        if (prev != nullptr) {
+            // 键已存在，不分配节点
+            return std::make_pair(iterator(prev->_next, this), false);
+        }
+        return std::make_pair(_insert_unique_code(code, std::forward<Args>(args)...), true);
+    }
+
+    /**
+     * @brief 已确认哈希值为code的键不存在，以args构造节点并插入到桶的开头
+     * @details 扩容后用同一个哈希值重新定位桶，不再调用哈希函数
+     */
+    template <class... Args>
+    iterator _insert_unique_code(size_type code, Args&&... args)
+    {
+        _resize(_num_elements + 1);
+        node_pointer p = _create_node(std::forward<Args>(args)...);
+        _store_hash(p, code, _cache_tag());
+        _insert_bucket_begin(_bucket_index(code), p);
+        ++_num_elements;
+        return iterator(p, this);
+    }
+
+    /**
+     * @brief 插入已创建的节点，允许重复
+     */
+    iterator _insert_node_equal(node_pointer p)
+    {
+        _resize(_num_elements + 1);
+        const size_type code = _hash_of(_get_key(p->_data));
+        _store_hash(p, code, _cache_tag());
+        const size_type n = _bucket_index(code);
+        base_pointer prev = _find_before(n, _get_key(p->_data), code);
+        if (prev != nullptr) {
+            // 找到相同键值的节点，插入到它后面，使相等的节点保持相邻
+            node_pointer cur = prev->_next;
+            p->_next = cur->_next;
+            cur->_next = p;
+            if (p->_next != nullptr) {
+                // cur原本是桶的最后一个节点时，下一个桶的前驱变为p
+                const size_type next_n = _bucket_of(p->_next);
+                if (next_n != n) {
+                    _slot(next_n) = p;
+                }
             }
+        } else {
+            // 未找到相同键值的节点，插入到桶的开头
+            _insert_bucket_begin(n, p);
         }
-        return nullptr;
+        ++_num_elements;
+        return iterator(p, this);
     }
 
     /**
@@ -1199,20 +1874,488 @@ public:
      */
     void _resize(size_type new_count)
     {
+        if (!_old_buckets.empty()) {
+            _rehash_step();
+        }
         if (load_factor() > max_load_factor()) {
-            rehash(new_count * 2);
+            if (_incremental) {
+                _start_rehash(new_count * 2);
+            } else {
+                rehash(new_count * 2);
+            }
+        }
+    }
+
+    /**
+     * @brief 每次插入迁移的旧桶数
+     * @details 新桶数至少是扩容时元素数的两倍，再次扩容前至少还有旧桶数次插入，迁移必然先完成
+     */
+    enum { _rehash_batch = 8 };
+
+    /**
+     * @brief 开始增量重建
+     * @details 当前的桶成为旧桶，只分配新桶，不移动任何节点
+     */
+    void _start_rehash(size_type count)
+    {
+        _complete_rehash();
+        count = std::max(count, static_cast<size_type>(std::ceil(_num_elements / max_load_factor())));
+        count = rehash_policy_type::bucket_count_for(count);
+        _old_buckets.swap(_buckets);
+        _old_policy = _policy;
+        _buckets = wwstl::vector<base_pointer>(count, nullptr);
+        _policy = rehash_policy_type(count);
+        _rehash_index = 0;
+    }
+
+    /**
+     * @brief 迁移至多_rehash_batch个旧桶，全部迁移后释放旧桶
+     */
+    void _rehash_step()
+    {
+        const size_type last = std::min(_rehash_index + static_cast<size_type>(_rehash_batch), _old_buckets.size());
+        while (_rehash_index < last) {
+            _migrate_bucket();
+        }
+        if (_rehash_index == _old_buckets.size()) {
+            wwstl::vector<base_pointer>().swap(_old_buckets);
+            _rehash_index = 0;
         }
     }
 
-    node_pointer _find(const key_type & key) const
+    /**
+     * @brief 迁移剩余的全部旧桶
+     */
+    void _complete_rehash()
     {
-        const size_type n = _hash_key(key);
-        for (node_pointer cur = _buckets[n]; cur != nullptr; cur = cur->_next) {
-            if (_equals(_get_key(cur->_data), key)) {
-                return cur;
+        while (!_old_buckets.empty()) {
+            _rehash_step();
+        }
+    }
+
+    /**
+     * @brief 把旧桶_rehash_index中的节点迁移到新桶
+     * @details 先把整个旧桶从链表中摘下并推进_rehash_index，此时链表中每个节点的桶编号都与所在的桶数组一致，
+     *          再逐个链接到新桶的开头；相等的节点哈希值相同，迁移后仍然相邻
+     */
+    void _migrate_bucket()
+    {
+        const size_type n = _buckets.size() + _rehash_index;
+        const base_pointer prev = _old_buckets[_rehash_index];
+        if (prev == nullptr) {
+            ++_rehash_index;
+            return;
+        }
+        node_pointer first = prev->_next;
+        node_pointer last = first;
+        size_type next_n = n;
+        while (last->_next != nullptr && (next_n = _bucket_of(last->_next)) == n) {
+            last = last->_next;
+        }
+        node_pointer next = last->_next;
+        _remove_bucket_begin(n, next, next_n);
+        prev->_next = next;
+        last->_next = nullptr;
+        ++_rehash_index;
+        while (first != nullptr) {
+            node_pointer cur = first;
+            first = first->_next;
+            _insert_bucket_begin(_policy.index(_node_hash(cur)), cur);
+        }
+    }
+
+    /**
+     * @brief 并行插入的实现，桶数按插入后的元素数确定
+     */
+    template <bool Unique, class ForwardIt>
+    void _insert_parallel(ForwardIt first, ForwardIt last, size_type threads)
+    {
+        _complete_rehash();
+        const size_type total = _num_elements + static_cast<size_type>(std::distance(first, last));
+        size_type count = std::max(_buckets.size(), static_cast<size_type>(std::ceil(total / max_load_factor())));
+        count = rehash_policy_type::bucket_count_for(count);
+        _parallel_relink<Unique>(count, threads, first, last);
+    }
+
+    /**
+     * @brief 第1步为一个节点记录的条目，哈希值只在第1步计算
+     */
+    struct _relink_entry
+    {
+        node_pointer _node;
+        size_type _code;
+        size_type _next;    // 同一链表中下一个条目的下标
+    };
+
+    /**
+     * @brief 一个线程交给一个分片的条目，按加入的顺序用下标串成链表
+     */
+    struct _entry_list
+    {
+        size_type _head;
+        size_type _tail;
+    };
+
+    /**
+     * @brief 一个线程在第1步中的结果
+     */
+    struct _relink_part
+    {
+        wwstl::vector<_relink_entry> _entries;  // 先是已有的节点，再是新节点
+        size_type _olds;                        // 已有节点的条目数，即第一个新节点的下标
+        std::exception_ptr _error;              // 第1步中抛出的异常
+    };
+
+    /**
+     * @brief 条目链表的结尾
+     */
+    static size_type _entry_end() noexcept
+    {
+        return static_cast<size_type>(-1);
+    }
+
+    /**
+     * @brief 在part中追加条目并加入list
+     */
+    static void _append_entry(_relink_part & part, _entry_list & list, node_pointer p, size_type code)
+    {
+        part._entries.push_back(_relink_entry{p, code, _entry_end()});
+        const size_type i = part._entries.size() - 1;
+        if (list._tail == _entry_end()) {
+            list._head = i;
+        } else {
+            part._entries[list._tail]._next = i;
+        }
+        list._tail = i;
+    }
+
+    /**
+     * @brief 一个分片链接完成后的一段链表，_first_bucket为其中第一个节点所在的桶
+     */
+    struct _shard_chain
+    {
+        node_pointer _first;
+        size_type _first_bucket;
+        base_pointer _tail;
+        size_type _count;
+    };
+
+    /**
+     * @brief 析构时等待所有线程结束
+     */
+    struct _thread_joiner
+    {
+        std::vector<std::thread> _threads;  // std::thread只能移动，wwstl::vector的拷贝路径不适用
+
+        ~_thread_joiner()
+        {
+            for (auto & thread : _threads) {
+                if (thread.joinable()) {
+                    thread.join();
+                }
             }
         }
-        return nullptr;
+    };
+
+    /**
+     * @brief 在threads个线程中执行f(0)到f(threads - 1)，f(0)在当前线程执行
+     * @details 无法创建线程时剩下的部分在当前线程依次执行，因此f不抛出异常时本函数也不抛出异常
+     * @details 当前线程抛出异常时，已创建的线程在异常离开本函数前结束
+     */
+    template <class Function>
+    static void _parallel_for(size_type threads, Function f)
+    {
+        _thread_joiner workers;
+        size_type t = 1;
+        try {
+            workers._threads.reserve(threads - 1);
+            for (; t < threads; ++t) {
+                workers._threads.emplace_back(f, t);
+            }
+        } catch (...) {
+            // 无法再创建线程，不影响结果
+        }
+        for (size_type rest = t; rest < threads; ++rest) {
+            f(rest);
+        }
+        f(0);
+    }
+
+    /**
+     * @brief 以threads个线程把已有的节点和[first, last)中的新元素链接到count个新桶
+     * @details 新桶按范围分成threads个分片，分三步：
+     *          1. 各线程只读地遍历自己范围内的旧桶，记下节点和哈希值，并构造自己那一段输入的节点，
+     *             条目按新桶所在的分片放入threads个链表；任一线程抛出异常时销毁已构造的新节点并重新抛出，表保持不变
+     *          2. 每个线程独占一个分片，把各线程交来的节点链接到桶的链上，再把分片内的桶依次串成一段链表
+     *          3. 把各分片的链表首尾相接，修正每段第一个桶的前驱
+     *          第2步起只移动指针，不再构造节点或调用哈希函数，除判等函数和析构函数外不会抛出异常
+     *          旧节点先于新节点链接，新节点按输入顺序链接，因此不允许重复时已有的元素和先出现的元素优先
+     */
+    template <bool Unique, class ForwardIt>
+    void _parallel_relink(size_type count, size_type threads, ForwardIt first, ForwardIt last)
+    {
+        const size_type input = static_cast<size_type>(std::distance(first, last));
+        wwstl::vector<ForwardIt> starts(threads + 1, first);
+        for (size_type t = 1; t <= threads; ++t) {
+            starts[t] = starts[t - 1];
+            std::advance(starts[t], input * t / threads - input * (t - 1) / threads);
+        }
+        const rehash_policy_type new_policy(count);
+        wwstl::vector<base_pointer> new_buckets(count, nullptr);
+        const size_type old_count = _buckets.size();
+        const size_type per_shard = (count + threads - 1) / threads;
+        wwstl::vector<_entry_list> old_lists(threads * threads, _entry_list{_entry_end(), _entry_end()});
+        wwstl::vector<_entry_list> new_lists(threads * threads, _entry_list{_entry_end(), _entry_end()});
+        wwstl::vector<_relink_part> parts(threads);
+        wwstl::vector<_shard_chain> chains(threads, _shard_chain{nullptr, 0, nullptr, 0});
+
+        _parallel_for(threads, [&](size_type t) {
+            _relink_part & part = parts[t];
+            part._olds = _entry_end();  // 遍历旧桶时抛出异常，没有新节点需要销毁
+            try {
+                _entry_list * olds = &old_lists[t * threads];
+                for (size_type n = old_count * t / threads; n < old_count * (t + 1) / threads; ++n) {
+                    const base_pointer prev = _buckets[n];
+                    if (prev == nullptr) {
+                        continue;
+                    }
+                    for (node_pointer cur = prev->_next; cur != nullptr; cur = cur->_next) {
+                        const size_type code = _node_hash(cur);
+                        if (_bucket_index(code) != n) {
+                            break;      // 已到下一个桶
+                        }
+                        _append_entry(part, olds[new_policy.index(code) / per_shard], cur, code);
+                    }
+                }
+                // 预留新节点的条目，构造节点之后追加条目不会再分配内存
+                part._entries.reserve(part._entries.size() + input * (t + 1) / threads - input * t / threads);
+                part._olds = part._entries.size();
+                _entry_list * news = &new_lists[t * threads];
+                for (ForwardIt it = starts[t]; it != starts[t + 1]; ++it) {
+                    node_pointer p = _create_node(*it);
+                    size_type code = 0;
+                    try {
+                        code = _hash_of(_get_key(p->_data));
+                    } catch (...) {
+                        _destroy_node(p);
+                        throw;
+                    }
+                    _store_hash(p, code, _cache_tag());
+                    _append_entry(part, news[new_policy.index(code) / per_shard], p, code);
+                }
+            } catch (...) {
+                part._error = std::current_exception();
+            }
+        });
+
+        for (size_type t = 0; t < threads; ++t) {
+            if (parts[t]._error == nullptr) {
+                continue;
+            }
+            // 任一线程失败时销毁所有线程构造的新节点，旧桶和旧节点都没有改动
+            for (_relink_part & part : parts) {
+                for (size_type i = part._olds; i < part._entries.size(); ++i) {
+                    _destroy_node(part._entries[i]._node);
+                }
+            }
+            std::rethrow_exception(parts[t]._error);
+        }
+
+        _parallel_for(threads, [&](size_type s) {
+            size_type kept = 0;
+            for (size_type t = 0; t < threads; ++t) {
+                const wwstl::vector<_relink_entry> & entries = parts[t]._entries;
+                for (size_type i = old_lists[t * threads + s]._head; i != _entry_end(); i = entries[i]._next, ++kept) {
+                    node_pointer cur = entries[i]._node;
+                    const size_type n = new_policy.index(entries[i]._code);
+                    cur->_next = static_cast<node_pointer>(new_buckets[n]);
+                    new_buckets[n] = cur;
+                }
+            }
+            for (size_type t = 0; t < threads; ++t) {
+                const wwstl::vector<_relink_entry> & entries = parts[t]._entries;
+                for (size_type i = new_lists[t * threads + s]._head; i != _entry_end(); i = entries[i]._next) {
+                    node_pointer cur = entries[i]._node;
+                    const size_type code = entries[i]._code;
+                    const size_type n = new_policy.index(code);
+                    node_pointer found = static_cast<node_pointer>(new_buckets[n]);
+                    while (found != nullptr && !_node_equals(found, _get_key(cur->_data), code)) {
+                        found = found->_next;
+                    }
+                    if (found == nullptr) {
+                        cur->_next = static_cast<node_pointer>(new_buckets[n]);
+                        new_buckets[n] = cur;
+                        ++kept;
+                    } else if (Unique) {
+                        _destroy_node(cur);
+                    } else {
+                        // 插入到相等的节点后面，使相等的节点保持相邻
+                        cur->_next = found->_next;
+                        found->_next = cur;
+                        ++kept;
+                    }
+                }
+            }
+            // 桶中暂存的是首个节点，改为前驱，分片第一个桶的前驱在第3步修正
+            node_base head;
+            base_pointer tail = &head;
+            size_type first_bucket = count;
+            const size_type lo = std::min(s * per_shard, count);
+            const size_type hi = std::min(lo + per_shard, count);
+            for (size_type n = lo; n < hi; ++n) {
+                node_pointer chain = static_cast<node_pointer>(new_buckets[n]);
+                if (chain == nullptr) {
+                    continue;
+                }
+                if (first_bucket == count) {
+                    first_bucket = n;
+                }
+                new_buckets[n] = tail;
+                tail->_next = chain;
+                tail = chain;
+                while (tail->_next != nullptr) {
+                    tail = tail->_next;
+                }
+            }
+            chains[s] = _shard_chain{head._next, first_bucket, tail, kept};
+        });
+
+        base_pointer prev = &_before_begin;
+        size_type total = 0;
+        for (size_type s = 0; s < threads; ++s) {
+            total += chains[s]._count;
+            if (chains[s]._first == nullptr) {
+                continue;
+            }
+            new_buckets[chains[s]._first_bucket] = prev;
+            prev->_next = chains[s]._first;
+            prev = chains[s]._tail;
+        }
+        prev->_next = nullptr;
+        _buckets.swap(new_buckets);
+        _policy = new_policy;
+        _num_elements = total;
+    }
+
+    /**
+     * @brief 清空所有桶，释放增量重建中的旧桶
+     */
+    void _reset_buckets()
+    {
+        std::fill(_buckets.begin(), _buckets.end(), nullptr);
+        wwstl::vector<base_pointer>().swap(_old_buckets);
+        _rehash_index = 0;
+    }
+
+    /**
+     * @brief find_many和count_many每批处理的键数
+     */
+    enum { _lookup_batch = 16 };
+
+    /**
+     * @brief 批量查找的实现，Iterator决定写入iterator还是const_iterator
+     */
+    template <class Iterator, class ForwardIt, class OutputIt>
+    OutputIt _find_many(ForwardIt first, ForwardIt last, OutputIt out) const
+    {
+        hashtable * self = const_cast<hashtable *>(this);
+        node_pointer heads[_lookup_batch];
+        size_type codes[_lookup_batch];
+        while (first != last) {
+            ForwardIt batch_first = first;
+            const size_type n = _bucket_heads_many(first, last, heads, codes);
+            for (size_type i = 0; i < n; ++i, ++batch_first) {
+                const size_type bucket = _bucket_index(codes[i]);
+                node_pointer cur = heads[i];
+                while (cur != nullptr && !_node_equals(cur, *batch_first, codes[i])) {
+                    cur = _bucket_next(cur, bucket);
+                }
+                *out = Iterator(cur, self);
+                ++out;
+            }
+        }
+        return out;
+    }
+
+    /**
+     * @brief 取得从first开始的至多_lookup_batch个键所在桶的首个节点，写入heads，哈希值写入codes
+     * @details 先计算全部哈希值并预取桶，再读取桶中的前驱并预取，最后读取首个节点并预取
+     * @return 本批处理的键数，first移动到下一批的开始
+     */
+    template <class ForwardIt>
+    size_type _bucket_heads_many(ForwardIt & first, ForwardIt last, node_pointer * heads, size_type * codes) const
+    {
+        base_pointer prevs[_lookup_batch];
+        size_type n = 0;
+        for (; n < _lookup_batch && first != last; ++n, ++first) {
+            codes[n] = _hash_of(*first);
+            _prefetch(&_slot(_bucket_index(codes[n])));
+        }
+        for (size_type i = 0; i < n; ++i) {
+            prevs[i] = _slot(_bucket_index(codes[i]));
+            if (prevs[i] != nullptr) {
+                _prefetch(prevs[i]);
+            }
+        }
+        for (size_type i = 0; i < n; ++i) {
+            heads[i] = prevs[i] == nullptr ? nullptr : prevs[i]->_next;
+            if (heads[i] != nullptr) {
+                _prefetch(heads[i]);
+            }
+        }
+        return n;
+    }
+
+    /**
+     * @brief 查找特定键的节点，不存在时返回nullptr
+     */
+    template <class K>
+    node_pointer _find(const K & key) const
+    {
+        const size_type code = _hash_of(key);
+        base_pointer prev = _find_before(_bucket_index(code), key, code);
+        return prev == nullptr ? nullptr : prev->_next;
+    }
+
+    /**
+     * @brief 计算与key相等的节点个数
+     * @details 相等的节点在链表中连续
+     */
+    template <class K>
+    size_type _count_equal(const K & key) const
+    {
+        const size_type code = _hash_of(key);
+        base_pointer prev = _find_before(_bucket_index(code), key, code);
+        if (prev == nullptr) {
+            return 0;
+        }
+        size_type result = 0;
+        for (node_pointer cur = prev->_next; cur != nullptr && _node_equals(cur, key, code); cur = cur->_next) {
+            ++result;
+        }
+        return result;
+    }
+
+    /**
+     * @brief 返回与key相等的节点范围
+     * @details 相等的节点在链表中连续，范围的末尾就是最后一个相等节点的下一个节点
+     */
+    template <class Iterator, class K>
+    std::pair<Iterator, Iterator> _equal_range(const K & key) const
+    {
+        // 返回的元素是否可修改由Iterator决定，与const_iterator的构造方式相同
+        hashtable * self = const_cast<hashtable *>(this);
+        const size_type code = _hash_of(key);
+        base_pointer prev = _find_before(_bucket_index(code), key, code);
+        if (prev == nullptr) {
+            return std::make_pair(Iterator(nullptr, self), Iterator(nullptr, self));
+        }
+        node_pointer first = prev->_next;
+        node_pointer last = first->_next;
+        while (last != nullptr && _node_equals(last, key, code)) {
+            last = last->_next;
+        }
+        return std::make_pair(Iterator(first, self), Iterator(last, self));
     }
 };
 
@@ -1230,9 +2373,11 @@ template <
     class Hash,
     class KeyEqual,
     class ExtractKey,
-    class Allocator
-> void swap(hashtable<Key, T, Value, Hash, KeyEqual, ExtractKey, Allocator> & lhs,
-            hashtable<Key, T, Value, Hash, KeyEqual, ExtractKey, Allocator> & rhs)
+    class Allocator,
+    bool CacheHash,
+    class RehashPolicy
+> void swap(hashtable<Key, T, Value, Hash, KeyEqual, ExtractKey, Allocator, CacheHash, RehashPolicy> & lhs,
+            hashtable<Key, T, Value, Hash, KeyEqual, ExtractKey, Allocator, CacheHash, RehashPolicy> & rhs)
 {
     lhs.swap(rhs);
 }
@@ -0,0 +1,790 @@
+#ifndef __WW_INTERVAL_MAP_H__
+#define __WW_INTERVAL_MAP_H__
+
+#include "ww_rb_tree.h"
+
+namespace wwstl
+{
+
+/**
+ * @brief 区间映射
+ * @details 键为左闭右开区间std::pair<Bound, Bound>，按下界、上界的顺序排列，键唯一
+ * @details 每个节点额外记录子树中区间上界的最大值，支持O(log n)的overlaps，
+ *          以及跳过不相交子树的find_overlapping和find_containing
+ * @details 要求区间的下界不大于上界
+ */
+template <
+    class Bound,
+    class T,
+    class Compare = std::less<Bound>,
+    class Allocator = wwstl::allocator<std::pair<const std::pair<Bound, Bound>, T>>
+> class interval_map
+{
+public:
+    using bound_type = Bound;
+    using key_type = std::pair<Bound, Bound>;
+    using mapped_type = T;
+    using value_type = std::pair<const key_type, T>;
+    using size_type = std::size_t;
+    using difference_type = std::ptrdiff_t;
+    using key_compare = _interval_compare<Bound, Compare>;
+    using allocator_type = Allocator;
+    using reference = value_type &;
+    using const_reference = const value_type &;
+    using pointer = value_type *;
+    using const_pointer = const value_type *;
+    using iterator = typename wwstl::rb_tree<key_type, mapped_type, value_type, keyExtractor<value_type>, key_compare, Allocator, false, true>::iterator;
+    using const_iterator = typename wwstl::rb_tree<key_type, mapped_type, value_type, keyExtractor<value_type>, key_compare, Allocator, false, true>::const_iterator;
+    using reverse_iterator = typename wwstl::reverse_iterator<iterator>;
+    using const_reverse_iterator = typename wwstl::reverse_iterator<const_iterator>;
+
+public:
+    wwstl::rb_tree<key_type, mapped_type, value_type, keyExtractor<value_type>, key_compare, Allocator, false, true> _tree;   // 红黑树
+
+public:
+    interval_map()
+        : interval_map(Compare())
+    {
+    }
+
+    explicit interval_map(const Compare & comp, const Allocator & alloc = Allocator())
+        : _tree(key_compare(comp), alloc)
+    {
+    }
+
+    template <class InputIt>
+    interval_map(InputIt first, InputIt last, const Compare & comp = Compare(), const Allocator & alloc = Allocator())
+        : _tree(key_compare(comp), alloc)
+    {
+        _tree.insert_range_unique(first, last);
+    }
+
+    interval_map(const interval_map & other)
+        : _tree(other._tree)
+    {
+    }
+
+    interval_map(interval_map && other)
+        : _tree(std::move(other._tree))
+    {
+    }
+
+    interval_map(std::initializer_list<value_type> init, const Compare & comp = Compare(), const Allocator & alloc = Allocator())
+        : _tree(key_compare(comp), alloc)
+    {
+        insert(init);
+    }
+
+public:
+    /**
+     * @brief 将值赋给容器
+     */
+    interval_map & operator=(const interval_map & other)
+    {
+        if (this != &other) {
+            _tree = other._tree;
+        }
+        return *this;
+    }
+
+    /**
+     * @brief 将值赋给容器
+     */
+    interval_map & operator=(interval_map && other)
+    {
+        if (this != &other) {
+            _tree = std::move(other._tree);
+        }
+        return *this;
+    }
+
+    /**
+     * @brief 返回关联的分配器
+     */
+    allocator_type get_allocator() const
+    {
+        return _tree.get_allocator();
+    }
+
+    // 元素访问
+
+    /**
+     * @brief 带越界检查访问指定的元素
+     */
+    mapped_type & at(const key_type & key)
+    {
+        return _tree.at(key);
+    }
+
+    /**
+     * @brief 带越界检查访问指定的元素
+     */
+    const mapped_type & at(const key_type & key) const
+    {
+        return _tree.at(key);
+    }
+
+    /**
+     * @brief 访问或插入指定的元素
+     */
+    mapped_type & operator[](const key_type & key)
+    {
+        return _tree[key];
+    }
+
+    // 迭代器
+
+    /**
+     * @brief 返回指向起始的迭代器
+     */
+    iterator begin() noexcept
+    {
+        return _tree.begin();
+    }
+
+    /**
+     * @brief 返回指向起始的迭代器
+     */
+    const_iterator begin() const noexcept
+    {
+        return _tree.begin();
+    }
+
+    /**
+     * @brief 返回指向末尾的迭代器
+     */
+    iterator end() noexcept
+    {
+        return _tree.end();
+    }
+
+    /**
+     * @brief 返回指向末尾的迭代器
+     */
+    const_iterator end() const noexcept
+    {
+        return _tree.end();
+    }
+
+    /**
+     * @brief 返回指向起始的逆向迭代器
+     */
+    reverse_iterator rbegin() noexcept
+    {
+        return _tree.rbegin();
+    }
+
+    /**
+     * @brief 返回指向末尾的逆向迭代器
+     */
+    reverse_iterator rend() noexcept
+    {
+        return _tree.rend();
+    }
+
+    // 容量
+
+    /**
+     * @brief 检查容器是否为空
+     */
+    bool empty() const noexcept
+    {
+        return _tree.empty();
+    }
+
+    /**
+     * @brief 返回元素数
+     */
+    size_type size() const noexcept
+    {
+        return _tree.size();
+    }
+
+    // 修改器
+
+    /**
+     * @brief 清除内容
+     */
+    void clear() noexcept
+    {
+        _tree.clear();
+    }
+
+    /**
+     * @brief 插入元素
+     */
+    std::pair<iterator, bool> insert(const value_type & value)
+    {
+        return _tree.emplace_unique(value);
+    }
+
+    /**
+     * @brief 插入元素
+     */
+    template <class P>
+    std::pair<iterator, bool> insert(P && value)
+    {
+        return _tree.emplace_unique(std::forward<P>(value));
+    }
+
+    /**
+     * @brief 插入范围内的元素
+     */
+    template <class InputIt>
+    void insert(InputIt first, InputIt last)
+    {
+        _tree.insert_range_unique(first, last);
+    }
+
+    /**
+     * @brief 插入初始化列表中的元素
+     */
+    void insert(std::initializer_list<value_type> ilist)
+    {
+        insert(ilist.begin(), ilist.end());
+    }
+
+    /**
+     * @brief 原位构造元素
+     */
+    template <class... Args>
+    std::pair<iterator, bool> emplace(Args&&... args)
+    {
+        return _tree.emplace_unique(std::forward<Args>(args)...);
+    }
+
+    /**
+     * @brief 键不存在时原位构造元素
+     */
+    template <class... Args>
+    std::pair<iterator, bool> try_emplace(const key_type & key, Args&&... args)
+    {
+        return _tree.try_emplace_unique(key, std::forward<Args>(args)...);
+    }
+
+    /**
+     * @brief 插入元素，键已存在时赋值
+     */
+    template <class M>
+    std::pair<iterator, bool> insert_or_assign(const key_type & key, M && obj)
+    {
+        return _tree.insert_or_assign_unique(key, std::forward<M>(obj));
+    }
+
+    /**
+     * @brief 擦除元素
+     */
+    iterator erase(const_iterator pos)
+    {
+        return _tree.erase(pos);
+    }
+
+    /**
+     * @brief 擦除元素
+     */
+    iterator erase(const_iterator first, const_iterator last)
+    {
+        return _tree.erase(first, last);
+    }
+
+    /**
+     * @brief 擦除元素
+     */
+    size_type erase(const key_type & key)
+    {
+        return _tree.erase(key);
+    }
+
+    /**
+     * @brief 交换内容
+     */
+    void swap(interval_map & other) noexcept
+    {
+        _tree.swap(other._tree);
+    }
+
+    // 查找
+
+    /**
+     * @brief 返回匹配特定键的元素数量
+     */
+    size_type count(const key_type & key) const
+    {
+        return _tree.count(key);
+    }
+
+    /**
+     * @brief 寻找带有特定键的元素
+     */
+    iterator find(const key_type & key)
+    {
+        return _tree.find(key);
+    }
+
+    /**
+     * @brief 寻找带有特定键的元素
+     */
+    const_iterator find(const key_type & key) const
+    {
+        return _tree.find(key);
+    }
+
+    /**
+     * @brief 返回指向首个不小于给定键的元素的迭代器
+     */
+    iterator lower_bound(const key_type & key)
+    {
+        return _tree.lower_bound(key);
+    }
+
+    /**
+     * @brief 返回指向首个不小于给定键的元素的迭代器
+     */
+    const_iterator lower_bound(const key_type & key) const
+    {
+        return _tree.lower_bound(key);
+    }
+
+    /**
+     * @brief 返回指向首个大于给定键的元素的迭代器
+     */
+    iterator upper_bound(const key_type & key)
+    {
+        return _tree.upper_bound(key);
+    }
+
+    /**
+     * @brief 返回指向首个大于给定键的元素的迭代器
+     */
+    const_iterator upper_bound(const key_type & key) const
+    {
+        return _tree.upper_bound(key);
+    }
+
+    // 区间查询
+
+    /**
+     * @brief 检查是否有区间与[lo, hi)重叠
+     * @details 复杂度O(log n)
+     */
+    bool overlaps(const bound_type & lo, const bound_type & hi) const
+    {
+        return _tree.overlaps(lo, hi);
+    }
+
+    /**
+     * @brief 将与[lo, hi)重叠的元素的迭代器按顺序写入out
+     * @details 复杂度O(min(n, (k + 1) log n))，k为结果个数
+     */
+    template <class OutputIt>
+    OutputIt find_overlapping(const bound_type & lo, const bound_type & hi, OutputIt out)
+    {
+        return _tree.find_overlapping(lo, hi, out);
+    }
+
+    /**
+     * @brief 将与[lo, hi)重叠的元素的迭代器按顺序写入out
+     */
+    template <class OutputIt>
+    OutputIt find_overlapping(const bound_type & lo, const bound_type & hi, OutputIt out) const
+    {
+        return _tree.find_overlapping(lo, hi, out);
+    }
+
+    /**
+     * @brief 将包含点point的元素的迭代器按顺序写入out
+     */
+    template <class OutputIt>
+    OutputIt find_containing(const bound_type & point, OutputIt out)
+    {
+        return _tree.find_containing(point, out);
+    }
+
+    /**
+     * @brief 将包含点point的元素的迭代器按顺序写入out
+     */
+    template <class OutputIt>
+    OutputIt find_containing(const bound_type & point, OutputIt out) const
+    {
+        return _tree.find_containing(point, out);
+    }
+
+    // 观察器
+
+    /**
+     * @brief 返回用于比较键的函数
+     */
+    key_compare key_comp() const
+    {
+        return _tree._comp;
+    }
+};
+
+/**
+ * @brief 区间多重映射
+ * @details 与interval_map相同，但允许相同的区间
+ */
+template <
+    class Bound,
+    class T,
+    class Compare = std::less<Bound>,
+    class Allocator = wwstl::allocator<std::pair<const std::pair<Bound, Bound>, T>>
+> class interval_multimap
+{
+public:
+    using bound_type = Bound;
+    using key_type = std::pair<Bound, Bound>;
+    using mapped_type = T;
+    using value_type = std::pair<const key_type, T>;
+    using size_type = std::size_t;
+    using difference_type = std::ptrdiff_t;
+    using key_compare = _interval_compare<Bound, Compare>;
+    using allocator_type = Allocator;
+    using reference = value_type &;
+    using const_reference = const value_type &;
+    using pointer = value_type *;
+    using const_pointer = const value_type *;
+    using iterator = typename wwstl::rb_tree<key_type, mapped_type, value_type, keyExtractor<value_type>, key_compare, Allocator, false, true>::iterator;
+    using const_iterator = typename wwstl::rb_tree<key_type, mapped_type, value_type, keyExtractor<value_type>, key_compare, Allocator, false, true>::const_iterator;
+    using reverse_iterator = typename wwstl::reverse_iterator<iterator>;
+    using const_reverse_iterator = typename wwstl::reverse_iterator<const_iterator>;
+
+public:
+    wwstl::rb_tree<key_type, mapped_type, value_type, keyExtractor<value_type>, key_compare, Allocator, false, true> _tree;   // 红黑树
+
+public:
+    interval_multimap()
+        : interval_multimap(Compare())
+    {
+    }
+
+    explicit interval_multimap(const Compare & comp, const Allocator & alloc = Allocator())
+        : _tree(key_compare(comp), alloc)
+    {
+    }
+
+    template <class InputIt>
+    interval_multimap(InputIt first, InputIt last, const Compare & comp = Compare(), const Allocator & alloc = Allocator())
+        : _tree(key_compare(comp), alloc)
+    {
+        _tree.insert_range_equal(first, last);
+    }
+
+    interval_multimap(const interval_multimap & other)
+        : _tree(other._tree)
+    {
+    }
+
+    interval_multimap(interval_multimap && other)
+        : _tree(std::move(other._tree))
+    {
+    }
+
+    interval_multimap(std::initializer_list<value_type> init, const Compare & comp = Compare(), const Allocator & alloc = Allocator())
+        : _tree(key_compare(comp), alloc)
+    {
+        insert(init);
+    }
+
+public:
+    /**
+     * @brief 将值赋给容器
+     */
+    interval_multimap & operator=(const interval_multimap & other)
+    {
+        if (this != &other) {
+            _tree = other._tree;
+        }
+        return *this;
+    }
+
+    /**
+     * @brief 将值赋给容器
+     */
+    interval_multimap & operator=(interval_multimap && other)
+    {
+        if (this != &other) {
+            _tree = std::move(other._tree);
+        }
+        return *this;
+    }
+
+    /**
+     * @brief 返回关联的分配器
+     */
+    allocator_type get_allocator() const
+    {
+        return _tree.get_allocator();
+    }
+
+    // 迭代器
+
+    /**
+     * @brief 返回指向起始的迭代器
+     */
+    iterator begin() noexcept
+    {
+        return _tree.begin();
+    }
+
+    /**
+     * @brief 返回指向起始的迭代器
+     */
+    const_iterator begin() const noexcept
+    {
+        return _tree.begin();
+    }
+
+    /**
+     * @brief 返回指向末尾的迭代器
+     */
+    iterator end() noexcept
+    {
+        return _tree.end();
+    }
+
+    /**
+     * @brief 返回指向末尾的迭代器
+     */
+    const_iterator end() const noexcept
+    {
+        return _tree.end();
+    }
+
+    /**
+     * @brief 返回指向起始的逆向迭代器
+     */
+    reverse_iterator rbegin() noexcept
+    {
+        return _tree.rbegin();
+    }
+
+    /**
+     * @brief 返回指向末尾的逆向迭代器
+     */
+    reverse_iterator rend() noexcept
+    {
+        return _tree.rend();
+    }
+
+    // 容量
+
+    /**
+     * @brief 检查容器是否为空
+     */
+    bool empty() const noexcept
+    {
+        return _tree.empty();
+    }
+
+    /**
+     * @brief 返回元素数
+     */
+    size_type size() const noexcept
+    {
+        return _tree.size();
+    }
+
+    // 修改器
+
+    /**
+     * @brief 清除内容
+     */
+    void clear() noexcept
+    {
+        _tree.clear();
+    }
+
+    /**
+     * @brief 插入元素
+     */
+    iterator insert(const value_type & value)
+    {
+        return _tree.emplace_equal(value);
+    }
+
+    /**
+     * @brief 插入元素
+     */
+    template <class P>
+    iterator insert(P && value)
+    {
+        return _tree.emplace_equal(std::forward<P>(value));
+    }
+
+    /**
+     * @brief 插入范围内的元素
+     */
+    template <class InputIt>
+    void insert(InputIt first, InputIt last)
+    {
+        _tree.insert_range_equal(first, last);
+    }
+
+    /**
+     * @brief 插入初始化列表中的元素
+     */
+    void insert(std::initializer_list<value_type> ilist)
+    {
+        insert(ilist.begin(), ilist.end());
+    }
+
+    /**
+     * @brief 原位构造元素
+     */
+    template <class... Args>
+    iterator emplace(Args&&... args)
+    {
+        return _tree.emplace_equal(std::forward<Args>(args)...);
+    }
+
+    /**
+     * @brief 擦除元素
+     */
+    iterator erase(const_iterator pos)
+    {
+        return _tree.erase(pos);
+    }
+
+    /**
+     * @brief 擦除元素
+     */
+    iterator erase(const_iterator first, const_iterator last)
+    {
+        return _tree.erase(first, last);
+    }
+
+    /**
+     * @brief 擦除元素
+     */
+    size_type erase(const key_type & key)
+    {
+        return _tree.erase(key);
+    }
+
+    /**
+     * @brief 交换内容
+     */
+    void swap(interval_multimap & other) noexcept
+    {
+        _tree.swap(other._tree);
+    }
+
+    // 查找
+
+    /**
+     * @brief 返回匹配特定键的元素数量
+     */
+    size_type count(const key_type & key) const
+    {
+        return _tree.count(key);
+    }
+
+    /**
+     * @brief 寻找带有特定键的元素
+     */
+    iterator find(const key_type & key)
+    {
+        return _tree.find(key);
+    }
+
+    /**
+     * @brief 寻找带有特定键的元素
+     */
+    const_iterator find(const key_type & key) const
+    {
+        return _tree.find(key);
+    }
+
+    /**
+     * @brief 返回匹配特定键的元素范围
+     */
+    std::pair<iterator, iterator> equal_range(const key_type & key)
+    {
+        return _tree.equal_range(key);
+    }
+
+    /**
+     * @brief 返回匹配特定键的元素范围
+     */
+    std::pair<const_iterator, const_iterator> equal_range(const key_type & key) const
+    {
+        return _tree.equal_range(key);
+    }
+
+    // 区间查询
+
+    /**
+     * @brief 检查是否有区间与[lo, hi)重叠
+     * @details 复杂度O(log n)
+     */
+    bool overlaps(const bound_type & lo, const bound_type & hi) const
+    {
+        return _tree.overlaps(lo, hi);
+    }
+
+    /**
+     * @brief 将与[lo, hi)重叠的元素的迭代器按顺序写入out
+     * @details 复杂度O(min(n, (k + 1) log n))，k为结果个数
+     */
+    template <class OutputIt>
+    OutputIt find_overlapping(const bound_type & lo, const bound_type & hi, OutputIt out)
+    {
+        return _tree.find_overlapping(lo, hi, out);
+    }
+
+    /**
+     * @brief 将与[lo, hi)重叠的元素的迭代器按顺序写入out
+     */
+    template <class OutputIt>
+    OutputIt find_overlapping(const bound_type & lo, const bound_type & hi, OutputIt out) const
+    {
+        return _tree.find_overlapping(lo, hi, out);
+    }
+
+    /**
+     * @brief 将包含点point的元素的迭代器按顺序写入out
+     */
+    template <class OutputIt>
+    OutputIt find_containing(const bound_type & point, OutputIt out)
+    {
+        return _tree.find_containing(point, out);
+    }
+
+    /**
+     * @brief 将包含点point的元素的迭代器按顺序写入out
+     */
+    template <class OutputIt>
+    OutputIt find_containing(const bound_type & point, OutputIt out) const
+    {
+        return _tree.find_containing(point, out);
+    }
+
+    // 观察器
+
+    /**
+     * @brief 返回用于比较键的函数
+     */
+    key_compare key_comp() const
+    {
+        return _tree._comp;
+    }
+};
+
+// 非成员函数
+
+template <class Bound, class T, class Compare, class Allocator>
+void swap(interval_map<Bound, T, Compare, Allocator> & lhs, interval_map<Bound, T, Compare, Allocator> & rhs) noexcept
+{
+    lhs.swap(rhs);
+}
+
+template <class Bound, class T, class Compare, class Allocator>
+void swap(interval_multimap<Bound, T, Compare, Allocator> & lhs, interval_multimap<Bound, T, Compare, Allocator> & rhs) noexcept
+{
+    lhs.swap(rhs);
+}
+
+} // namespace wwstl
+
+#endif // __WW_INTERVAL_MAP_H__
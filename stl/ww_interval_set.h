@@ -0,0 +1,353 @@
+#ifndef __WW_INTERVAL_SET_H__
+#define __WW_INTERVAL_SET_H__
+
+#include "ww_rb_tree.h"
+
+namespace wwstl
+{
+
+/**
+ * @brief 区间集合
+ * @details 元素为左闭右开区间std::pair<Bound, Bound>，按下界、上界的顺序排列，元素唯一
+ * @details 每个节点额外记录子树中区间上界的最大值，支持O(log n)的overlaps，
+ *          以及跳过不相交子树的find_overlapping和find_containing
+ * @details 要求区间的下界不大于上界
+ */
+template <
+    class Bound,
+    class Compare = std::less<Bound>,
+    class Allocator = wwstl::allocator<std::pair<Bound, Bound>>
+> class interval_set
+{
+public:
+    using bound_type = Bound;
+    using key_type = std::pair<Bound, Bound>;
+    using value_type = key_type;
+    using size_type = std::size_t;
+    using difference_type = std::ptrdiff_t;
+    using key_compare = _interval_compare<Bound, Compare>;
+    using value_compare = key_compare;
+    using allocator_type = Allocator;
+    using reference = value_type &;
+    using const_reference = const value_type &;
+    using pointer = value_type *;
+    using const_pointer = const value_type *;
+    using iterator = typename wwstl::rb_tree<key_type, void, value_type, keyExtractor<value_type>, key_compare, Allocator, false, true>::iterator;
+    using const_iterator = typename wwstl::rb_tree<key_type, void, value_type, keyExtractor<value_type>, key_compare, Allocator, false, true>::const_iterator;
+    using reverse_iterator = typename wwstl::reverse_iterator<iterator>;
+    using const_reverse_iterator = typename wwstl::reverse_iterator<const_iterator>;
+
+public:
+    wwstl::rb_tree<key_type, void, value_type, keyExtractor<value_type>, key_compare, Allocator, false, true> _tree;  // 红黑树
+
+public:
+    interval_set()
+        : interval_set(Compare())
+    {
+    }
+
+    explicit interval_set(const Compare & comp, const Allocator & alloc = Allocator())
+        : _tree(key_compare(comp), alloc)
+    {
+    }
+
+    template <class InputIt>
+    interval_set(InputIt first, InputIt last, const Compare & comp = Compare(), const Allocator & alloc = Allocator())
+        : _tree(key_compare(comp), alloc)
+    {
+        _tree.insert_range_unique(first, last);
+    }
+
+    interval_set(const interval_set & other)
+        : _tree(other._tree)
+    {
+    }
+
+    interval_set(interval_set && other)
+        : _tree(std::move(other._tree))
+    {
+    }
+
+    interval_set(std::initializer_list<value_type> init, const Compare & comp = Compare(), const Allocator & alloc = Allocator())
+        : _tree(key_compare(comp), alloc)
+    {
+        insert(init);
+    }
+
+public:
+    /**
+     * @brief 将值赋给容器
+     */
+    interval_set & operator=(const interval_set & other)
+    {
+        if (this != &other) {
+            _tree = other._tree;
+        }
+        return *this;
+    }
+
+    /**
+     * @brief 将值赋给容器
+     */
+    interval_set & operator=(interval_set && other)
+    {
+        if (this != &other) {
+            _tree = std::move(other._tree);
+        }
+        return *this;
+    }
+
+    /**
+     * @brief 返回关联的分配器
+     */
+    allocator_type get_allocator() const
+    {
+        return _tree.get_allocator();
+    }
+
+    // 迭代器
+
+    /**
+     * @brief 返回指向起始的迭代器
+     */
+    iterator begin() noexcept
+    {
+        return _tree.begin();
+    }
+
+    /**
+     * @brief 返回指向起始的迭代器
+     */
+    const_iterator begin() const noexcept
+    {
+        return _tree.begin();
+    }
+
+    /**
+     * @brief 返回指向末尾的迭代器
+     */
+    iterator end() noexcept
+    {
+        return _tree.end();
+    }
+
+    /**
+     * @brief 返回指向末尾的迭代器
+     */
+    const_iterator end() const noexcept
+    {
+        return _tree.end();
+    }
+
+    /**
+     * @brief 返回指向起始的逆向迭代器
+     */
+    reverse_iterator rbegin() noexcept
+    {
+        return _tree.rbegin();
+    }
+
+    /**
+     * @brief 返回指向末尾的逆向迭代器
+     */
+    reverse_iterator rend() noexcept
+    {
+        return _tree.rend();
+    }
+
+    // 容量
+
+    /**
+     * @brief 检查容器是否为空
+     */
+    bool empty() const noexcept
+    {
+        return _tree.empty();
+    }
+
+    /**
+     * @brief 返回元素数
+     */
+    size_type size() const noexcept
+    {
+        return _tree.size();
+    }
+
+    // 修改器
+
+    /**
+     * @brief 清除内容
+     */
+    void clear() noexcept
+    {
+        _tree.clear();
+    }
+
+    /**
+     * @brief 插入元素
+     */
+    std::pair<iterator, bool> insert(const value_type & value)
+    {
+        return _tree.emplace_unique(value);
+    }
+
+    /**
+     * @brief 插入范围内的元素
+     */
+    template <class InputIt>
+    void insert(InputIt first, InputIt last)
+    {
+        _tree.insert_range_unique(first, last);
+    }
+
+    /**
+     * @brief 插入初始化列表中的元素
+     */
+    void insert(std::initializer_list<value_type> ilist)
+    {
+        insert(ilist.begin(), ilist.end());
+    }
+
+    /**
+     * @brief 原位构造元素
+     */
+    template <class... Args>
+    std::pair<iterator, bool> emplace(Args&&... args)
+    {
+        return _tree.emplace_unique(std::forward<Args>(args)...);
+    }
+
+    /**
+     * @brief 擦除元素
+     */
+    iterator erase(const_iterator pos)
+    {
+        return _tree.erase(pos);
+    }
+
+    /**
+     * @brief 擦除元素
+     */
+    iterator erase(const_iterator first, const_iterator last)
+    {
+        return _tree.erase(first, last);
+    }
+
+    /**
+     * @brief 擦除元素
+     */
+    size_type erase(const key_type & key)
+    {
+        return _tree.erase(key);
+    }
+
+    /**
+     * @brief 交换内容
+     */
+    void swap(interval_set & other) noexcept
+    {
+        _tree.swap(other._tree);
+    }
+
+    // 查找
+
+    /**
+     * @brief 返回匹配特定键的元素数量
+     */
+    size_type count(const key_type & key) const
+    {
+        return _tree.count(key);
+    }
+
+    /**
+     * @brief 寻找带有特定键的元素
+     */
+    iterator find(const key_type & key)
+    {
+        return _tree.find(key);
+    }
+
+    /**
+     * @brief 寻找带有特定键的元素
+     */
+    const_iterator find(const key_type & key) const
+    {
+        return _tree.find(key);
+    }
+
+    /**
+     * @brief 返回指向首个不小于给定键的元素的迭代器
+     */
+    iterator lower_bound(const key_type & key)
+    {
+        return _tree.lower_bound(key);
+    }
+
+    /**
+     * @brief 返回指向首个不小于给定键的元素的迭代器
+     */
+    const_iterator lower_bound(const key_type & key) const
+    {
+        return _tree.lower_bound(key);
+    }
+
+    // 区间查询
+
+    /**
+     * @brief 检查是否有区间与[lo, hi)重叠
+     * @details 复杂度O(log n)
+     */
+    bool overlaps(const bound_type & lo, const bound_type & hi) const
+    {
+        return _tree.overlaps(lo, hi);
+    }
+
+    /**
+     * @brief 将与[lo, hi)重叠的元素的迭代器按顺序写入out
+     * @details 复杂度O(min(n, (k + 1) log n))，k为结果个数
+     */
+    template <class OutputIt>
+    OutputIt find_overlapping(const bound_type & lo, const bound_type & hi, OutputIt out) const
+    {
+        return _tree.find_overlapping(lo, hi, out);
+    }
+
+    /**
+     * @brief 将包含点point的元素的迭代器按顺序写入out
+     */
+    template <class OutputIt>
+    OutputIt find_containing(const bound_type & point, OutputIt out) const
+    {
+        return _tree.find_containing(point, out);
+    }
+
+    // 观察器
+
+    /**
+     * @brief 返回用于比较键的函数
+     */
+    key_compare key_comp() const
+    {
+        return _tree._comp;
+    }
+
+    /**
+     * @brief 返回用于比较值的函数
+     */
+    value_compare value_comp() const
+    {
+        return _tree._comp;
+    }
+};
+
+// 非成员函数
+
+template <class Bound, class Compare, class Allocator>
+void swap(interval_set<Bound, Compare, Allocator> & lhs, interval_set<Bound, Compare, Allocator> & rhs) noexcept
+{
+    lhs.swap(rhs);
+}
+
+} // namespace wwstl
+
+#endif // __WW_INTERVAL_SET_H__
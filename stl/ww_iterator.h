@@ -157,7 +157,9 @@ public:
 
     pointer operator->() const
     {
-        return &(operator*());
+        // 交给底层迭代器取指针，底层迭代器返回代理引用时也能使用
+        iterator_type tmp = _current;
+        return _to_pointer(--tmp);
     }
 
     reference operator[](difference_type n) const
@@ -165,6 +167,18 @@ public:
         return _current[-n - 1];
     }
 
+    template <class T>
+    static T * _to_pointer(T * ptr)
+    {
+        return ptr;
+    }
+
+    template <class It>
+    static pointer _to_pointer(It it)
+    {
+        return it.operator->();
+    }
+
     self & operator++()
     {
         --_current;
@@ -6,15 +6,29 @@
 namespace wwstl
 {
 
+template <
+    class Key,
+    class T,
+    class Compare,
+    class Allocator,
+    bool OrderStatistic,
+    class Balance
+> class multimap;
+
 /**
  * @brief map
  * @link https://zh.cppreference.com/w/cpp/container/map
+ * @details OrderStatistic为true时支持rank、nth和count_range，每个节点额外记录子树大小
+ * @details Balance为平衡策略，可选red_black_balance、avl_balance、treap_balance和splay_balance，
+ *          split、join、unite、intersect和subtract只支持默认的red_black_balance
  */
 template <
     class Key,
     class T,
     class Compare = std::less<Key>,
-    class Allocator = wwstl::allocator<std::pair<const Key, T>>
+    class Allocator = wwstl::allocator<std::pair<const Key, T>>,
+    bool OrderStatistic = false,
+    class Balance = red_black_balance
 > class map
 {
 public:
@@ -29,13 +43,16 @@ public:
     using const_reference = const value_type &;
     using pointer = value_type *;
     using const_pointer = const value_type *;
-    using iterator = typename wwstl::rb_tree<key_type, mapped_type, value_type, keyExtractor<value_type>, key_compare, Allocator>::iterator;
-    using const_iterator = typename wwstl::rb_tree<key_type, mapped_type, value_type, keyExtractor<value_type>, key_compare, Allocator>::const_iterator;
+    using iterator = typename wwstl::rb_tree<key_type, mapped_type, value_type, keyExtractor<value_type>, key_compare, Allocator, OrderStatistic, false, Balance>::iterator;
+    using const_iterator = typename wwstl::rb_tree<key_type, mapped_type, value_type, keyExtractor<value_type>, key_compare, Allocator, OrderStatistic, false, Balance>::const_iterator;
     using reverse_iterator = typename wwstl::reverse_iterator<iterator>;
     using const_reverse_iterator = typename wwstl::reverse_iterator<const_iterator>;
-    
+
+    using node_type = typename wwstl::rb_tree<key_type, mapped_type, value_type, keyExtractor<value_type>, key_compare, Allocator, OrderStatistic, false, Balance>::node_type;
+    using insert_return_type = typename wwstl::rb_tree<key_type, mapped_type, value_type, keyExtractor<value_type>, key_compare, Allocator, OrderStatistic, false, Balance>::insert_return_type;
+
 public:
-    wwstl::rb_tree<key_type, mapped_type, value_type, keyExtractor<value_type>, key_compare, Allocator> _tree;  // 红黑树
+    wwstl::rb_tree<key_type, mapped_type, value_type, keyExtractor<value_type>, key_compare, Allocator, OrderStatistic, false, Balance> _tree;  // 红黑树
 
 public:
     map()
@@ -55,8 +72,9 @@ public:
 
     template <class InputIt>
     map(InputIt first, InputIt last, const Compare & comp = Compare(), const Allocator & alloc = Allocator())
-        : _tree(first, last, comp, alloc)
+        : _tree(comp, alloc)
     {
+        _tree.insert_range_unique(first, last);
     }
 
     map(const map & other)
@@ -152,6 +170,14 @@ public:
         return _tree[key];
     }
 
+    /**
+     * @brief 访问或插入指定的元素
+     */
+    mapped_type & operator[](key_type && key)
+    {
+        return _tree[std::move(key)];
+    }
+
     /**
      * @brief 访问或插入指定的元素
      */
@@ -314,7 +340,7 @@ public:
     /**
      * @brief 插入元素
      */
-    std::pair<iterator, bool> insert(const_iterator hint, const value_type & value)
+    iterator insert(const_iterator hint, const value_type & value)
     {
         return _tree.emplace_hint_unique(hint, value);
     }
@@ -323,9 +349,9 @@ public:
      * @brief 插入元素
      */
     template <class P>
-    std::pair<iterator, bool> insert(const_iterator hint, P && value)
+    iterator insert(const_iterator hint, P && value)
     {
-        return _tree.emplace_hint_unique(std::forward<P>(value));
+        return _tree.emplace_hint_unique(hint, std::forward<P>(value));
     }
 
     /**
@@ -334,10 +360,7 @@ public:
     template <class InputIt>
     void insert(InputIt first, InputIt last)
     {
-        for (; first != last; ++first)
-        {
-            _tree.emplace_unique(*first);
-        }
+        _tree.insert_range_unique(first, last);
     }
 
     /**
@@ -367,6 +390,82 @@ public:
         return _tree.emplace_hint_unique(hint, std::forward<Args>(args)...);
     }
 
+    /**
+     * @brief 键不存在时原位构造元素，键已存在时不做任何事
+     * @details 键已存在时不会分配节点，也不会移动key和args
+     */
+    template <class... Args>
+    std::pair<iterator, bool> try_emplace(const key_type & key, Args&&... args)
+    {
+        return _tree.try_emplace_unique(key, std::forward<Args>(args)...);
+    }
+
+    /**
+     * @brief 键不存在时原位构造元素，键已存在时不做任何事
+     */
+    template <class... Args>
+    std::pair<iterator, bool> try_emplace(key_type && key, Args&&... args)
+    {
+        return _tree.try_emplace_unique(std::move(key), std::forward<Args>(args)...);
+    }
+
+    /**
+     * @brief 使用提示原位构造元素，键已存在时不做任何事
+     * @details 先借助hint查找再构造，键紧邻hint之前时均摊O(1)
+     */
+    template <class... Args>
+    iterator try_emplace(const_iterator hint, const key_type & key, Args&&... args)
+    {
+        return _tree.try_emplace_hint_unique(hint, key, std::forward<Args>(args)...);
+    }
+
+    /**
+     * @brief 使用提示原位构造元素，键已存在时不做任何事
+     */
+    template <class... Args>
+    iterator try_emplace(const_iterator hint, key_type && key, Args&&... args)
+    {
+        return _tree.try_emplace_hint_unique(hint, std::move(key), std::forward<Args>(args)...);
+    }
+
+    /**
+     * @brief 键不存在时插入元素，键已存在时赋值
+     * @details 发生插入时返回true，赋值时返回false
+     */
+    template <class M>
+    std::pair<iterator, bool> insert_or_assign(const key_type & key, M && obj)
+    {
+        return _tree.insert_or_assign_unique(key, std::forward<M>(obj));
+    }
+
+    /**
+     * @brief 键不存在时插入元素，键已存在时赋值
+     */
+    template <class M>
+    std::pair<iterator, bool> insert_or_assign(key_type && key, M && obj)
+    {
+        return _tree.insert_or_assign_unique(std::move(key), std::forward<M>(obj));
+    }
+
+    /**
+     * @brief 使用提示插入或赋值
+     * @details 先借助hint查找，键紧邻hint之前时均摊O(1)
+     */
+    template <class M>
+    iterator insert_or_assign(const_iterator hint, const key_type & key, M && obj)
+    {
+        return _tree.insert_or_assign_hint_unique(hint, key, std::forward<M>(obj));
+    }
+
+    /**
+     * @brief 使用提示插入或赋值
+     */
+    template <class M>
+    iterator insert_or_assign(const_iterator hint, key_type && key, M && obj)
+    {
+        return _tree.insert_or_assign_hint_unique(hint, std::move(key), std::forward<M>(obj));
+    }
+
     /**
      * @brief 擦除元素
      */
@@ -399,8 +498,130 @@ public:
         _tree.swap(other._tree);
     }
 
+    /**
+     * @brief 摘下pos指向的节点，不销毁元素
+     */
+    node_type extract(const_iterator pos)
+    {
+        return _tree.extract(pos);
+    }
+
+    /**
+     * @brief 摘下首个键等于key的节点，不存在时返回空句柄
+     */
+    node_type extract(const key_type & key)
+    {
+        return _tree.extract(key);
+    }
+
+    /**
+     * @brief 插入节点句柄
+     */
+    insert_return_type insert(node_type && nh)
+    {
+        return _tree.insert_unique(std::move(nh));
+    }
+
+    /**
+     * @brief 根据提示插入节点句柄
+     */
+    iterator insert(const_iterator hint, node_type && nh)
+    {
+        return _tree.insert_hint_unique(hint, std::move(nh));
+    }
+
+    /**
+     * @brief 从source中拼接节点，键已存在的节点留在source中
+     */
+    template <class C2>
+    void merge(map<Key, T, C2, Allocator, OrderStatistic, Balance> & source)
+    {
+        _tree.merge_unique(source._tree);
+    }
+
+    /**
+     * @brief 从source中拼接节点，键已存在的节点留在source中
+     */
+    template <class C2>
+    void merge(multimap<Key, T, C2, Allocator, OrderStatistic, Balance> & source)
+    {
+        _tree.merge_unique(source._tree);
+    }
+
+    /**
+     * @brief 在key处拆分，自身保留小于key的元素，返回不小于key的元素
+     * @details 启用顺序统计时为O(log n)，否则需要遍历计数，为O(min(k, n - k))
+     */
+    map split(const key_type & key)
+    {
+        map right(_tree._comp, get_allocator());
+        auto tail = _tree.split(key);
+        right._tree.swap(tail);
+        return right;
+    }
+
+    /**
+     * @brief 将other连接到自身之后，要求自身的所有键不大于other的所有键
+     */
+    void join(map & other)
+    {
+        _tree.join(other._tree);
+    }
+
+    /**
+     * @brief 并入other的所有元素，键相同时保留自身的元素，操作后other为空
+     */
+    void unite(map & other)
+    {
+        _tree.union_unique(other._tree);
+    }
+
+    /**
+     * @brief 只保留键也存在于other的元素，操作后other为空
+     */
+    void intersect(map & other)
+    {
+        _tree.intersection_unique(other._tree);
+    }
+
+    /**
+     * @brief 移除键存在于other的元素，操作后other为空
+     */
+    void subtract(map & other)
+    {
+        _tree.difference_unique(other._tree);
+    }
+
     // 查找
 
+    /**
+     * @brief 批量查找，依次将每个键的查找结果写入out，不存在时写入end()
+     * @details 多个键的访存交错进行，适合一次查找大量键
+     */
+    template <class ForwardIt, class OutputIt>
+    OutputIt find_many(ForwardIt first, ForwardIt last, OutputIt out)
+    {
+        return _tree.find_many(first, last, out);
+    }
+
+    /**
+     * @brief 批量查找，依次将每个键的查找结果写入out，不存在时写入end()
+     */
+    template <class ForwardIt, class OutputIt>
+    OutputIt find_many(ForwardIt first, ForwardIt last, OutputIt out) const
+    {
+        return _tree.find_many(first, last, out);
+    }
+
+    /**
+     * @brief 批量计数，依次将匹配每个键的元素数量写入out
+     */
+    template <class ForwardIt, class OutputIt>
+    OutputIt count_many(ForwardIt first, ForwardIt last, OutputIt out) const
+    {
+        return _tree.count_many(first, last, out);
+    }
+
     /**
      * @brief 返回匹配特定键的元素数量
      */
@@ -409,6 +630,16 @@ public:
         return _tree.count(key);
     }
 
+    /**
+     * @brief 返回匹配特定键的元素数量
+     * @details 异构查找，要求比较器定义is_transparent
+     */
+    template <class K, class C = key_compare, class = typename C::is_transparent>
+    size_type count(const K & key) const
+    {
+        return _tree.count(key);
+    }
+
     /**
      * @brief 寻找带有特定键的元素
      */
@@ -417,6 +648,16 @@ public:
         return _tree.find(key);
     }
 
+    /**
+     * @brief 寻找带有特定键的元素
+     * @details 异构查找，要求比较器定义is_transparent
+     */
+    template <class K, class C = key_compare, class = typename C::is_transparent>
+    iterator find(const K & key)
+    {
+        return _tree.find(key);
+    }
+
     /**
      * @brief 寻找带有特定键的元素
      */
@@ -425,6 +666,16 @@ public:
         return _tree.find(key);
     }
 
+    /**
+     * @brief 寻找带有特定键的元素
+     * @details 异构查找，要求比较器定义is_transparent
+     */
+    template <class K, class C = key_compare, class = typename C::is_transparent>
+    const_iterator find(const K & key) const
+    {
+        return _tree.find(key);
+    }
+
     /**
      * @brief 返回匹配特定键的元素范围
      */
@@ -433,6 +684,16 @@ public:
         return _tree.equal_range(key);
     }
 
+    /**
+     * @brief 返回匹配特定键的元素范围
+     * @details 异构查找，要求比较器定义is_transparent
+     */
+    template <class K, class C = key_compare, class = typename C::is_transparent>
+    std::pair<iterator, iterator> equal_range(const K & key)
+    {
+        return _tree.equal_range(key);
+    }
+
     /**
      * @brief 返回匹配特定键的元素范围
      */
@@ -441,6 +702,16 @@ public:
         return _tree.equal_range(key);
     }
 
+    /**
+     * @brief 返回匹配特定键的元素范围
+     * @details 异构查找，要求比较器定义is_transparent
+     */
+    template <class K, class C = key_compare, class = typename C::is_transparent>
+    std::pair<const_iterator, const_iterator> equal_range(const K & key) const
+    {
+        return _tree.equal_range(key);
+    }
+
     /**
      * @brief 返回指向首个不小于给定键的元素的迭代器
      */
@@ -449,6 +720,16 @@ public:
         return _tree.lower_bound(key);
     }
 
+    /**
+     * @brief 返回指向首个不小于给定键的元素的迭代器
+     * @details 异构查找，要求比较器定义is_transparent
+     */
+    template <class K, class C = key_compare, class = typename C::is_transparent>
+    iterator lower_bound(const K & key)
+    {
+        return _tree.lower_bound(key);
+    }
+
     /**
      * @brief 返回指向首个不小于给定键的元素的迭代器
      */
@@ -457,6 +738,16 @@ public:
         return _tree.lower_bound(key);
     }
 
+    /**
+     * @brief 返回指向首个不小于给定键的元素的迭代器
+     * @details 异构查找，要求比较器定义is_transparent
+     */
+    template <class K, class C = key_compare, class = typename C::is_transparent>
+    const_iterator lower_bound(const K & key) const
+    {
+        return _tree.lower_bound(key);
+    }
+
     /**
      * @brief 返回指向首个大于给定键的元素的迭代器
      */
@@ -465,6 +756,16 @@ public:
         return _tree.upper_bound(key);
     }
 
+    /**
+     * @brief 返回指向首个大于给定键的元素的迭代器
+     * @details 异构查找，要求比较器定义is_transparent
+     */
+    template <class K, class C = key_compare, class = typename C::is_transparent>
+    iterator upper_bound(const K & key)
+    {
+        return _tree.upper_bound(key);
+    }
+
     /**
      * @brief 返回指向首个大于给定键的元素的迭代器
      */
@@ -473,6 +774,72 @@ public:
         return _tree.upper_bound(key);
     }
 
+    /**
+     * @brief 返回指向首个大于给定键的元素的迭代器
+     * @details 异构查找，要求比较器定义is_transparent
+     */
+    template <class K, class C = key_compare, class = typename C::is_transparent>
+    const_iterator upper_bound(const K & key) const
+    {
+        return _tree.upper_bound(key);
+    }
+
+    /**
+     * @brief 从pos向后查找首个不小于给定键的元素，结果与lower_bound(key)相同
+     * @details 要求pos不在lower_bound(key)之后，复杂度O(log d)，d为pos与结果之间的元素数，
+     *          按顺序查找有序的键序列时用上一次的结果作为pos
+     */
+    iterator seek_forward(const_iterator pos, const key_type & key)
+    {
+        return _tree.seek_forward(pos, key);
+    }
+
+    /**
+     * @brief 从pos向后查找首个不小于给定键的元素，结果与lower_bound(key)相同
+     * @details 要求pos不在lower_bound(key)之后，复杂度O(log d)，d为pos与结果之间的元素数
+     */
+    const_iterator seek_forward(const_iterator pos, const key_type & key) const
+    {
+        return _tree.seek_forward(pos, key);
+    }
+
+    // 顺序统计
+    /**
+     * 以下操作要求OrderStatistic为true
+     */
+
+    /**
+     * @brief 返回小于给定键的元素个数，复杂度O(log n)
+     */
+    size_type rank(const key_type & key) const
+    {
+        return _tree.rank(key);
+    }
+
+    /**
+     * @brief 返回下标为n的元素的迭代器，n不小于size()时返回end()，复杂度O(log n)
+     */
+    iterator nth(size_type n)
+    {
+        return _tree.nth(n);
+    }
+
+    /**
+     * @brief 返回下标为n的元素的迭代器，n不小于size()时返回end()，复杂度O(log n)
+     */
+    const_iterator nth(size_type n) const
+    {
+        return _tree.nth(n);
+    }
+
+    /**
+     * @brief 返回键在[lo, hi)范围内的元素个数，复杂度O(log n)
+     */
+    size_type count_range(const key_type & lo, const key_type & hi) const
+    {
+        return _tree.count_range(lo, hi);
+    }
+
     // 观察器
 
     /**
@@ -490,8 +857,10 @@ template <
     class Key,
     class T,
     class Compare,
-    class Allocator
-> bool operator==(const map<Key, T, Compare, Allocator> & lhs, const map<Key, T, Compare, Allocator> & rhs)
+    class Allocator,
+    bool OrderStatistic,
+    class Balance
+> bool operator==(const map<Key, T, Compare, Allocator, OrderStatistic, Balance> & lhs, const map<Key, T, Compare, Allocator, OrderStatistic, Balance> & rhs)
 {
     if (lhs.size() != rhs.size())
         return false;
@@ -509,8 +878,10 @@ template <
     class Key,
     class T,
     class Compare,
-    class Allocator
-> bool operator!=(const map<Key, T, Compare, Allocator> & lhs, const map<Key, T, Compare, Allocator> & rhs)
+    class Allocator,
+    bool OrderStatistic,
+    class Balance
+> bool operator!=(const map<Key, T, Compare, Allocator, OrderStatistic, Balance> & lhs, const map<Key, T, Compare, Allocator, OrderStatistic, Balance> & rhs)
 {
     return !(lhs == rhs);
 }
@@ -519,8 +890,10 @@ template <
     class Key,
     class T,
     class Compare,
-    class Allocator
-> bool operator<(const map<Key, T, Compare, Allocator> & lhs, const map<Key, T, Compare, Allocator> & rhs)
+    class Allocator,
+    bool OrderStatistic,
+    class Balance
+> bool operator<(const map<Key, T, Compare, Allocator, OrderStatistic, Balance> & lhs, const map<Key, T, Compare, Allocator, OrderStatistic, Balance> & rhs)
 {
     return std::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
 }
@@ -529,8 +902,10 @@ template <
     class Key,
     class T,
     class Compare,
-    class Allocator
-> bool operator>(const map<Key, T, Compare, Allocator> & lhs, const map<Key, T, Compare, Allocator> & rhs)
+    class Allocator,
+    bool OrderStatistic,
+    class Balance
+> bool operator>(const map<Key, T, Compare, Allocator, OrderStatistic, Balance> & lhs, const map<Key, T, Compare, Allocator, OrderStatistic, Balance> & rhs)
 {
     return rhs < lhs;
 }
@@ -539,8 +914,10 @@ template <
     class Key,
     class T,
     class Compare,
-    class Allocator
-> bool operator<=(const map<Key, T, Compare, Allocator> & lhs, const map<Key, T, Compare, Allocator> & rhs)
+    class Allocator,
+    bool OrderStatistic,
+    class Balance
+> bool operator<=(const map<Key, T, Compare, Allocator, OrderStatistic, Balance> & lhs, const map<Key, T, Compare, Allocator, OrderStatistic, Balance> & rhs)
 {
     return !(rhs < lhs);
 }
@@ -549,8 +926,10 @@ template <
     class Key,
     class T,
     class Compare,
-    class Allocator
-> bool operator>=(const map<Key, T, Compare, Allocator> & lhs, const map<Key, T, Compare, Allocator> & rhs)
+    class Allocator,
+    bool OrderStatistic,
+    class Balance
+> bool operator>=(const map<Key, T, Compare, Allocator, OrderStatistic, Balance> & lhs, const map<Key, T, Compare, Allocator, OrderStatistic, Balance> & rhs)
 {
     return !(lhs < rhs);
 }
@@ -559,8 +938,10 @@ template <
     class Key,
     class T,
     class Compare,
-    class Allocator
-> void swap(map<Key, T, Compare, Allocator> & lhs, map<Key, T, Compare, Allocator> & rhs)
+    class Allocator,
+    bool OrderStatistic,
+    class Balance
+> void swap(map<Key, T, Compare, Allocator, OrderStatistic, Balance> & lhs, map<Key, T, Compare, Allocator, OrderStatistic, Balance> & rhs)
 {
     lhs.swap(rhs);
 }
@@ -568,12 +949,17 @@ template <
 /**
  * @brief multimap
  * @link https://zh.cppreference.com/w/cpp/container/multimap
+ * @details OrderStatistic为true时支持rank、nth和count_range，每个节点额外记录子树大小
+ * @details Balance为平衡策略，可选red_black_balance、avl_balance、treap_balance和splay_balance，
+ *          split、join、unite、intersect和subtract只支持默认的red_black_balance
  */
 template <
     class Key,
     class T,
     class Compare = std::less<Key>,
-    class Allocator = wwstl::allocator<std::pair<const Key, T>>
+    class Allocator = wwstl::allocator<std::pair<const Key, T>>,
+    bool OrderStatistic = false,
+    class Balance = red_black_balance
 > class multimap
 {
 public:
@@ -588,13 +974,15 @@ public:
     using const_reference = const value_type &;
     using pointer = value_type *;
     using const_pointer = const value_type *;
-    using iterator = typename wwstl::rb_tree<key_type, mapped_type, value_type, keyExtractor<value_type>, key_compare, Allocator>::iterator;
-    using const_iterator = typename wwstl::rb_tree<key_type, mapped_type, value_type, keyExtractor<value_type>, key_compare, Allocator>::const_iterator;
+    using iterator = typename wwstl::rb_tree<key_type, mapped_type, value_type, keyExtractor<value_type>, key_compare, Allocator, OrderStatistic, false, Balance>::iterator;
+    using const_iterator = typename wwstl::rb_tree<key_type, mapped_type, value_type, keyExtractor<value_type>, key_compare, Allocator, OrderStatistic, false, Balance>::const_iterator;
     using reverse_iterator = typename wwstl::reverse_iterator<iterator>;
     using const_reverse_iterator = typename wwstl::reverse_iterator<const_iterator>;
-    
+
+    using node_type = typename wwstl::rb_tree<key_type, mapped_type, value_type, keyExtractor<value_type>, key_compare, Allocator, OrderStatistic, false, Balance>::node_type;
+
 public:
-    wwstl::rb_tree<key_type, mapped_type, value_type, keyExtractor<value_type>, key_compare, Allocator> _tree;  // 红黑树
+    wwstl::rb_tree<key_type, mapped_type, value_type, keyExtractor<value_type>, key_compare, Allocator, OrderStatistic, false, Balance> _tree;  // 红黑树
 
 public:
     multimap()
@@ -614,8 +1002,9 @@ public:
 
     template <class InputIt>
     multimap(InputIt first, InputIt last, const Compare & comp = Compare(), const Allocator & alloc = Allocator())
-        : _tree(first, last, comp, alloc)
+        : _tree(comp, alloc)
     {
+        _tree.insert_range_equal(first, last);
     }
 
     multimap(const multimap & other)
@@ -884,7 +1273,7 @@ public:
     template <class P>
     iterator insert(const_iterator hint, P && value)
     {
-        return _tree.emplace_hint_equal(std::forward<P>(value));
+        return _tree.emplace_hint_equal(hint, std::forward<P>(value));
     }
 
     /**
@@ -893,10 +1282,7 @@ public:
     template <class InputIt>
     void insert(InputIt first, InputIt last)
     {
-        for (; first != last; ++first)
-        {
-            _tree.emplace_equal(*first);
-        }
+        _tree.insert_range_equal(first, last);
     }
 
     /**
@@ -909,10 +1295,10 @@ public:
 
     /**
      * @brief 原位构造元素
-     * @details 调用emplace_equal，不允许重复
+     * @details 调用emplace_equal，允许重复
      */
     template <class... Args>
-    std::pair<iterator, bool> emplace(Args&&... args)
+    iterator emplace(Args&&... args)
     {
         return _tree.emplace_equal(std::forward<Args>(args)...);
     }
@@ -958,8 +1344,130 @@ public:
         _tree.swap(other._tree);
     }
 
+    /**
+     * @brief 摘下pos指向的节点，不销毁元素
+     */
+    node_type extract(const_iterator pos)
+    {
+        return _tree.extract(pos);
+    }
+
+    /**
+     * @brief 摘下首个键等于key的节点，不存在时返回空句柄
+     */
+    node_type extract(const key_type & key)
+    {
+        return _tree.extract(key);
+    }
+
+    /**
+     * @brief 插入节点句柄
+     */
+    iterator insert(node_type && nh)
+    {
+        return _tree.insert_equal(std::move(nh));
+    }
+
+    /**
+     * @brief 根据提示插入节点句柄
+     */
+    iterator insert(const_iterator hint, node_type && nh)
+    {
+        return _tree.insert_hint_equal(hint, std::move(nh));
+    }
+
+    /**
+     * @brief 从source中拼接所有节点
+     */
+    template <class C2>
+    void merge(multimap<Key, T, C2, Allocator, OrderStatistic, Balance> & source)
+    {
+        _tree.merge_equal(source._tree);
+    }
+
+    /**
+     * @brief 从source中拼接所有节点
+     */
+    template <class C2>
+    void merge(map<Key, T, C2, Allocator, OrderStatistic, Balance> & source)
+    {
+        _tree.merge_equal(source._tree);
+    }
+
+    /**
+     * @brief 在key处拆分，自身保留小于key的元素，返回不小于key的元素
+     * @details 启用顺序统计时为O(log n)，否则需要遍历计数，为O(min(k, n - k))
+     */
+    multimap split(const key_type & key)
+    {
+        multimap right(_tree._comp, get_allocator());
+        auto tail = _tree.split(key);
+        right._tree.swap(tail);
+        return right;
+    }
+
+    /**
+     * @brief 将other连接到自身之后，要求自身的所有键不大于other的所有键
+     */
+    void join(multimap & other)
+    {
+        _tree.join(other._tree);
+    }
+
+    /**
+     * @brief 并入other的所有元素，保留所有元素，操作后other为空
+     */
+    void unite(multimap & other)
+    {
+        _tree.union_equal(other._tree);
+    }
+
+    /**
+     * @brief 只保留共同的元素，按重复次数取较小值，操作后other为空
+     */
+    void intersect(multimap & other)
+    {
+        _tree.intersection_equal(other._tree);
+    }
+
+    /**
+     * @brief 移除与other共同的元素，按重复次数相减，操作后other为空
+     */
+    void subtract(multimap & other)
+    {
+        _tree.difference_equal(other._tree);
+    }
+
     // 查找
 
+    /**
+     * @brief 批量查找，依次将每个键的查找结果写入out，不存在时写入end()
+     * @details 多个键的访存交错进行，适合一次查找大量键
+     */
+    template <class ForwardIt, class OutputIt>
+    OutputIt find_many(ForwardIt first, ForwardIt last, OutputIt out)
+    {
+        return _tree.find_many(first, last, out);
+    }
+
+    /**
+     * @brief 批量查找，依次将每个键的查找结果写入out，不存在时写入end()
+     */
+    template <class ForwardIt, class OutputIt>
+    OutputIt find_many(ForwardIt first, ForwardIt last, OutputIt out) const
+    {
+        return _tree.find_many(first, last, out);
+    }
+
+    /**
+     * @brief 批量计数，依次将匹配每个键的元素数量写入out
+     */
+    template <class ForwardIt, class OutputIt>
+    OutputIt count_many(ForwardIt first, ForwardIt last, OutputIt out) const
+    {
+        return _tree.count_many(first, last, out);
+    }
+
     /**
      * @brief 返回匹配特定键的元素数量
      */
@@ -968,6 +1476,16 @@ public:
         return _tree.count(key);
     }
 
+    /**
+     * @brief 返回匹配特定键的元素数量
+     * @details 异构查找，要求比较器定义is_transparent
+     */
+    template <class K, class C = key_compare, class = typename C::is_transparent>
+    size_type count(const K & key) const
+    {
+        return _tree.count(key);
+    }
+
     /**
      * @brief 寻找带有特定键的元素
      */
@@ -976,6 +1494,16 @@ public:
         return _tree.find(key);
     }
 
+    /**
+     * @brief 寻找带有特定键的元素
+     * @details 异构查找，要求比较器定义is_transparent
+     */
+    template <class K, class C = key_compare, class = typename C::is_transparent>
+    iterator find(const K & key)
+    {
+        return _tree.find(key);
+    }
+
     /**
      * @brief 寻找带有特定键的元素
      */
@@ -984,6 +1512,16 @@ public:
         return _tree.find(key);
     }
 
+    /**
+     * @brief 寻找带有特定键的元素
+     * @details 异构查找，要求比较器定义is_transparent
+     */
+    template <class K, class C = key_compare, class = typename C::is_transparent>
+    const_iterator find(const K & key) const
+    {
+        return _tree.find(key);
+    }
+
     /**
      * @brief 返回匹配特定键的元素范围
      */
@@ -992,6 +1530,16 @@ public:
         return _tree.equal_range(key);
     }
 
+    /**
+     * @brief 返回匹配特定键的元素范围
+     * @details 异构查找，要求比较器定义is_transparent
+     */
+    template <class K, class C = key_compare, class = typename C::is_transparent>
+    std::pair<iterator, iterator> equal_range(const K & key)
+    {
+        return _tree.equal_range(key);
+    }
+
     /**
      * @brief 返回匹配特定键的元素范围
      */
@@ -1000,6 +1548,16 @@ public:
         return _tree.equal_range(key);
     }
 
+    /**
+     * @brief 返回匹配特定键的元素范围
+     * @details 异构查找，要求比较器定义is_transparent
+     */
+    template <class K, class C = key_compare, class = typename C::is_transparent>
+    std::pair<const_iterator, const_iterator> equal_range(const K & key) const
+    {
+        return _tree.equal_range(key);
+    }
+
     /**
      * @brief 返回指向首个不小于给定键的元素的迭代器
      */
@@ -1008,6 +1566,16 @@ public:
         return _tree.lower_bound(key);
     }
 
+    /**
+     * @brief 返回指向首个不小于给定键的元素的迭代器
+     * @details 异构查找，要求比较器定义is_transparent
+     */
+    template <class K, class C = key_compare, class = typename C::is_transparent>
+    iterator lower_bound(const K & key)
+    {
+        return _tree.lower_bound(key);
+    }
+
     /**
      * @brief 返回指向首个不小于给定键的元素的迭代器
      */
@@ -1016,6 +1584,16 @@ public:
         return _tree.lower_bound(key);
     }
 
+    /**
+     * @brief 返回指向首个不小于给定键的元素的迭代器
+     * @details 异构查找，要求比较器定义is_transparent
+     */
+    template <class K, class C = key_compare, class = typename C::is_transparent>
+    const_iterator lower_bound(const K & key) const
+    {
+        return _tree.lower_bound(key);
+    }
+
     /**
      * @brief 返回指向首个大于给定键的元素的迭代器
      */
@@ -1024,6 +1602,16 @@ public:
         return _tree.upper_bound(key);
     }
 
+    /**
+     * @brief 返回指向首个大于给定键的元素的迭代器
+     * @details 异构查找，要求比较器定义is_transparent
+     */
+    template <class K, class C = key_compare, class = typename C::is_transparent>
+    iterator upper_bound(const K & key)
+    {
+        return _tree.upper_bound(key);
+    }
+
     /**
      * @brief 返回指向首个大于给定键的元素的迭代器
      */
@@ -1032,6 +1620,72 @@ public:
         return _tree.upper_bound(key);
     }
 
+    /**
+     * @brief 返回指向首个大于给定键的元素的迭代器
+     * @details 异构查找，要求比较器定义is_transparent
+     */
+    template <class K, class C = key_compare, class = typename C::is_transparent>
+    const_iterator upper_bound(const K & key) const
+    {
+        return _tree.upper_bound(key);
+    }
+
+    /**
+     * @brief 从pos向后查找首个不小于给定键的元素，结果与lower_bound(key)相同
+     * @details 要求pos不在lower_bound(key)之后，复杂度O(log d)，d为pos与结果之间的元素数，
+     *          按顺序查找有序的键序列时用上一次的结果作为pos
+     */
+    iterator seek_forward(const_iterator pos, const key_type & key)
+    {
+        return _tree.seek_forward(pos, key);
+    }
+
+    /**
+     * @brief 从pos向后查找首个不小于给定键的元素，结果与lower_bound(key)相同
+     * @details 要求pos不在lower_bound(key)之后，复杂度O(log d)，d为pos与结果之间的元素数
+     */
+    const_iterator seek_forward(const_iterator pos, const key_type & key) const
+    {
+        return _tree.seek_forward(pos, key);
+    }
+
+    // 顺序统计
+    /**
+     * 以下操作要求OrderStatistic为true
+     */
+
+    /**
+     * @brief 返回小于给定键的元素个数，复杂度O(log n)
+     */
+    size_type rank(const key_type & key) const
+    {
+        return _tree.rank(key);
+    }
+
+    /**
+     * @brief 返回下标为n的元素的迭代器，n不小于size()时返回end()，复杂度O(log n)
+     */
+    iterator nth(size_type n)
+    {
+        return _tree.nth(n);
+    }
+
+    /**
+     * @brief 返回下标为n的元素的迭代器，n不小于size()时返回end()，复杂度O(log n)
+     */
+    const_iterator nth(size_type n) const
+    {
+        return _tree.nth(n);
+    }
+
+    /**
+     * @brief 返回键在[lo, hi)范围内的元素个数，复杂度O(log n)
+     */
+    size_type count_range(const key_type & lo, const key_type & hi) const
+    {
+        return _tree.count_range(lo, hi);
+    }
+
     // 观察器
 
     /**
@@ -1049,8 +1703,10 @@ template <
     class Key,
     class T,
     class Compare,
-    class Allocator
-> bool operator==(const multimap<Key, T, Compare, Allocator> & lhs, const multimap<Key, T, Compare, Allocator> & rhs)
+    class Allocator,
+    bool OrderStatistic,
+    class Balance
+> bool operator==(const multimap<Key, T, Compare, Allocator, OrderStatistic, Balance> & lhs, const multimap<Key, T, Compare, Allocator, OrderStatistic, Balance> & rhs)
 {
     if (lhs.size() != rhs.size())
         return false;
@@ -1071,8 +1727,10 @@ template <
     class Key,
     class T,
     class Compare,
-    class Allocator
-> bool operator!=(const multimap<Key, T, Compare, Allocator> & lhs, const multimap<Key, T, Compare, Allocator> & rhs)
+    class Allocator,
+    bool OrderStatistic,
+    class Balance
+> bool operator!=(const multimap<Key, T, Compare, Allocator, OrderStatistic, Balance> & lhs, const multimap<Key, T, Compare, Allocator, OrderStatistic, Balance> & rhs)
 {
     return !(lhs == rhs);
 }
@@ -1081,8 +1739,10 @@ template <
     class Key,
     class T,
     class Compare,
-    class Allocator
-> bool operator<(const multimap<Key, T, Compare, Allocator> & lhs, const multimap<Key, T, Compare, Allocator> & rhs)
+    class Allocator,
+    bool OrderStatistic,
+    class Balance
+> bool operator<(const multimap<Key, T, Compare, Allocator, OrderStatistic, Balance> & lhs, const multimap<Key, T, Compare, Allocator, OrderStatistic, Balance> & rhs)
 {
     return std::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
 }
@@ -1091,8 +1751,10 @@ template <
     class Key,
     class T,
     class Compare,
-    class Allocator
-> bool operator>(const multimap<Key, T, Compare, Allocator> & lhs, const multimap<Key, T, Compare, Allocator> & rhs)
+    class Allocator,
+    bool OrderStatistic,
+    class Balance
+> bool operator>(const multimap<Key, T, Compare, Allocator, OrderStatistic, Balance> & lhs, const multimap<Key, T, Compare, Allocator, OrderStatistic, Balance> & rhs)
 {
     return rhs < lhs;
 }
@@ -1101,8 +1763,10 @@ template <
     class Key,
     class T,
     class Compare,
-    class Allocator
-> bool operator<=(const multimap<Key, T, Compare, Allocator> & lhs, const multimap<Key, T, Compare, Allocator> & rhs)
+    class Allocator,
+    bool OrderStatistic,
+    class Balance
+> bool operator<=(const multimap<Key, T, Compare, Allocator, OrderStatistic, Balance> & lhs, const multimap<Key, T, Compare, Allocator, OrderStatistic, Balance> & rhs)
 {
     return !(rhs < lhs);
 }
@@ -1111,8 +1775,10 @@ template <
     class Key,
     class T,
     class Compare,
-    class Allocator
-> bool operator>=(const multimap<Key, T, Compare, Allocator> & lhs, const multimap<Key, T, Compare, Allocator> & rhs)
+    class Allocator,
+    bool OrderStatistic,
+    class Balance
+> bool operator>=(const multimap<Key, T, Compare, Allocator, OrderStatistic, Balance> & lhs, const multimap<Key, T, Compare, Allocator, OrderStatistic, Balance> & rhs)
 {
     return !(lhs < rhs);
 }
@@ -1121,12 +1787,34 @@ template <
     class Key,
     class T,
     class Compare,
-    class Allocator
-> void swap(multimap<Key, T, Compare, Allocator> & lhs, multimap<Key, T, Compare, Allocator> & rhs)
+    class Allocator,
+    bool OrderStatistic,
+    class Balance
+> void swap(multimap<Key, T, Compare, Allocator, OrderStatistic, Balance> & lhs, multimap<Key, T, Compare, Allocator, OrderStatistic, Balance> & rhs)
 {
     lhs.swap(rhs);
 }
 
+/**
+ * @brief 支持顺序统计的map
+ */
+template <
+    class Key,
+    class T,
+    class Compare = std::less<Key>,
+    class Allocator = wwstl::allocator<std::pair<const Key, T>>
+> using ranked_map = map<Key, T, Compare, Allocator, true>;
+
+/**
+ * @brief 支持顺序统计的multimap
+ */
+template <
+    class Key,
+    class T,
+    class Compare = std::less<Key>,
+    class Allocator = wwstl::allocator<std::pair<const Key, T>>
+> using ranked_multimap = multimap<Key, T, Compare, Allocator, true>;
+
 } // namespace wwstl
 
 #endif // __WW_MAP_H__
\ No newline at end of file
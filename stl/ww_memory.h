@@ -626,6 +626,19 @@ public:
     }
 };
 
+/**
+ * @brief 提示处理器预取p所在的缓存行
+ * @details 只是提示，不影响程序语义，编译器不支持时为空操作
+ */
+inline void _prefetch(const void * p) noexcept
+{
+#if defined(__GNUC__) || defined(__clang__)
+    __builtin_prefetch(p);
+#else
+    (void)p;
+#endif
+}
+
 } // namespace wwstl
 
 #endif // __WW_MEMORY_H__
\ No newline at end of file
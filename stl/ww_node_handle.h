@@ -0,0 +1,190 @@
+#ifndef __WW_NODE_HANDLE_H__
+#define __WW_NODE_HANDLE_H__
+
+#include <type_traits>
+#include <utility>
+#include "ww_memory.h"
+
+namespace wwstl
+{
+
+/**
+ * @brief 节点句柄
+ * @details 持有从容器中摘下的节点，可以插入到分配器兼容的同类容器中，不需要重新分配和构造元素
+ * @details T为void时用于集合，通过value访问元素；否则用于映射，通过key和mapped访问元素
+ * @link https://zh.cppreference.com/w/cpp/container/node_handle
+ */
+template <
+    class Key,
+    class T,
+    class Value,
+    class Node,
+    class Allocator
+> class _node_handle
+{
+public:
+    using key_type = Key;
+    using mapped_type = T;
+    using value_type = Value;
+    using allocator_type = Allocator;
+
+    using node_pointer = Node*;
+    using node_allocator_type = typename allocator_type::template rebind<Node>::other;
+
+public:
+    node_pointer _node;                     // 持有的节点，为空时句柄为空
+    node_allocator_type _node_allocator;    // 用于销毁节点的分配器
+
+public:
+    _node_handle() noexcept
+        : _node(nullptr)
+        , _node_allocator()
+    { // 空句柄
+    }
+
+    _node_handle(node_pointer node, const node_allocator_type & alloc) noexcept
+        : _node(node)
+        , _node_allocator(alloc)
+    { // 接管已经从容器中摘下的节点
+    }
+
+    _node_handle(_node_handle && other) noexcept
+        : _node(other._node)
+        , _node_allocator(std::move(other._node_allocator))
+    {
+        other._node = nullptr;
+    }
+
+    _node_handle(const _node_handle &) = delete;
+
+    ~_node_handle()
+    {
+        _destroy();
+    }
+
+public:
+    _node_handle & operator=(_node_handle && other) noexcept
+    {
+        if (this != &other) {
+            _destroy();
+            _node = other._node;
+            _node_allocator = std::move(other._node_allocator);
+            other._node = nullptr;
+        }
+        return *this;
+    }
+
+    _node_handle & operator=(const _node_handle &) = delete;
+
+    /**
+     * @brief 检查句柄是否为空
+     */
+    bool empty() const noexcept
+    {
+        return _node == nullptr;
+    }
+
+    /**
+     * @brief 检查句柄是否非空
+     */
+    explicit operator bool() const noexcept
+    {
+        return _node != nullptr;
+    }
+
+    /**
+     * @brief 返回关联的分配器
+     */
+    allocator_type get_allocator() const
+    {
+        return allocator_type(_node_allocator);
+    }
+
+    /**
+     * @brief 访问集合节点中的元素
+     */
+    template <typename U = mapped_type, typename = typename std::enable_if<std::is_void<U>::value>::type>
+    value_type & value() const
+    {
+        return _node->_data;
+    }
+
+    /**
+     * @brief 访问映射节点中的键
+     * @details 节点不在容器中，可以修改键后重新插入
+     */
+    template <typename U = mapped_type, typename = typename std::enable_if<!std::is_void<U>::value>::type>
+    key_type & key() const
+    {
+        return const_cast<key_type &>(_node->_data.first);
+    }
+
+    /**
+     * @brief 访问映射节点中的值
+     */
+    template <typename U = mapped_type, typename = typename std::enable_if<!std::is_void<U>::value>::type>
+    U & mapped() const
+    {
+        return _node->_data.second;
+    }
+
+    /**
+     * @brief 交换内容
+     */
+    void swap(_node_handle & other) noexcept
+    {
+        std::swap(_node, other._node);
+        std::swap(_node_allocator, other._node_allocator);
+    }
+
+public:
+    /**
+     * @brief 交出节点的所有权，句柄变为空
+     */
+    node_pointer _release() noexcept
+    {
+        node_pointer node = _node;
+        _node = nullptr;
+        return node;
+    }
+
+    /**
+     * @brief 销毁持有的节点
+     */
+    void _destroy()
+    {
+        if (_node != nullptr) {
+            allocator_traits<node_allocator_type>::destroy(_node_allocator, _node);
+            allocator_traits<node_allocator_type>::deallocate(_node_allocator, _node, 1);
+            _node = nullptr;
+        }
+    }
+};
+
+template <
+    class Key,
+    class T,
+    class Value,
+    class Node,
+    class Allocator
+> void swap(_node_handle<Key, T, Value, Node, Allocator> & lhs, _node_handle<Key, T, Value, Node, Allocator> & rhs) noexcept
+{
+    lhs.swap(rhs);
+}
+
+/**
+ * @brief 插入节点句柄的结果
+ * @details inserted为false时，node持有插入失败的节点，position指向阻碍插入的元素
+ */
+template <class Iterator, class NodeType>
+class _node_insert_return
+{
+public:
+    Iterator position;
+    bool inserted;
+    NodeType node;
+};
+
+} // namespace wwstl
+
+#endif // __WW_NODE_HANDLE_H__
@@ -0,0 +1,774 @@
+#ifndef __WW_PERSISTENT_MAP_H__
+#define __WW_PERSISTENT_MAP_H__
+
+#include <atomic>
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <stdexcept>
+#include <thread>
+#include "ww_memory.h"
+
+namespace wwstl
+{
+
+/**
+ * @brief 持久化树节点
+ * @details 节点创建后不再修改，可以被多个版本共享，由引用计数管理生命周期
+ */
+template <class Value>
+class _persistent_tree_node
+{
+public:
+    using value_type = Value;
+    using node_pointer = _persistent_tree_node<Value>*;
+
+public:
+    value_type _data;                   // 值
+    node_pointer _left;                 // 左子节点
+    node_pointer _right;                // 右子节点
+    int _height;                        // 子树高度，叶节点为1
+    std::atomic<std::size_t> _refs;     // 引用计数，来自父节点和各个版本的根
+
+public:
+    template <class... Args>
+    _persistent_tree_node(node_pointer left, node_pointer right, Args&&... args)
+        : _data(std::forward<Args>(args)...)
+        , _left(left)
+        , _right(right)
+        , _height(1 + (height(left) > height(right) ? height(left) : height(right)))
+        , _refs(1)
+    { // 以子树和值构造节点，接管两个子树的引用
+    }
+
+public:
+    /**
+     * @brief 返回子树高度，空树为0
+     */
+    static int height(node_pointer x)
+    {
+        return x == nullptr ? 0 : x->_height;
+    }
+};
+
+/**
+ * @brief 持久化映射的迭代器
+ * @details 节点没有父指针，迭代器用栈记录尚未访问的祖先，只能向前移动
+ * @details 迭代器不持有节点，只在取得它的版本存活期间有效
+ */
+template <class Value>
+class _persistent_map_iterator
+{
+public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = Value;
+    using difference_type = std::ptrdiff_t;
+    using pointer = const value_type*;
+    using reference = const value_type&;
+
+    using self = _persistent_map_iterator<Value>;
+    using node_pointer = _persistent_tree_node<Value>*;
+
+public:
+    /**
+     * @brief 栈的容量，高度为64的AVL树至少有约1.7e13个节点
+     */
+    enum { _max_depth = 64 };
+
+public:
+    node_pointer _stack[_max_depth];    // 栈顶为当前节点，其余为待访问的祖先
+    int _depth;                         // 栈中节点数，为0时表示末尾
+
+public:
+    _persistent_map_iterator()
+        : _depth(0)
+    { // 构造末尾迭代器
+    }
+
+public:
+    reference operator*() const
+    {
+        return _stack[_depth - 1]->_data;
+    }
+
+    pointer operator->() const
+    {
+        return &operator*();
+    }
+
+    self & operator++()
+    {
+        node_pointer x = _stack[--_depth]->_right;
+        _push_left(x);
+        return *this;
+    }
+
+    self operator++(int)
+    {
+        self tmp = *this;
+        ++*this;
+        return tmp;
+    }
+
+    bool operator==(const self & other) const
+    {
+        return _current() == other._current();
+    }
+
+    bool operator!=(const self & other) const
+    {
+        return !(*this == other);
+    }
+
+public:
+    /**
+     * @brief 返回当前节点，末尾为nullptr
+     */
+    node_pointer _current() const
+    {
+        return _depth == 0 ? nullptr : _stack[_depth - 1];
+    }
+
+    /**
+     * @brief 将x及其左侧链压栈，栈顶成为x子树的最小节点
+     */
+    void _push_left(node_pointer x)
+    {
+        while (x != nullptr) {
+            _stack[_depth++] = x;
+            x = x->_left;
+        }
+    }
+};
+
+/**
+ * @brief 持久化有序映射
+ * @details 修改不改变原有版本，而是复制从根到修改位置的路径并返回新版本，新旧版本共享其余节点
+ * @details 复制一个版本只增加根节点的引用计数，复杂度O(1)，可以作为快照交给其他线程只读访问
+ * @details 以AVL树平衡，节点不可变且没有父指针，旋转时复制参与旋转的节点
+ */
+template <
+    class Key,
+    class T,
+    class Compare = std::less<Key>,
+    class Allocator = wwstl::allocator<std::pair<const Key, T>>
+> class persistent_map
+{
+public:
+    using key_type = Key;
+    using mapped_type = T;
+    using value_type = std::pair<const Key, T>;
+    using size_type = std::size_t;
+    using difference_type = std::ptrdiff_t;
+    using key_compare = Compare;
+    using allocator_type = Allocator;
+    using reference = const value_type&;
+    using const_reference = const value_type&;
+    using iterator = _persistent_map_iterator<value_type>;
+    using const_iterator = _persistent_map_iterator<value_type>;
+
+    using node = _persistent_tree_node<value_type>;
+    using node_pointer = node*;
+    using node_allocator_type = typename allocator_type::template rebind<node>::other;
+
+public:
+    node_pointer _root;                     // 根节点，本版本持有一个引用
+    size_type _size;                        // 元素个数
+    key_compare _comp;                      // 键比较器
+    node_allocator_type _node_allocator;    // 节点分配器
+
+public:
+    persistent_map()
+        : persistent_map(Compare())
+    {
+    }
+
+    explicit persistent_map(const Compare & comp, const Allocator & alloc = Allocator())
+        : _root(nullptr)
+        , _size(0)
+        , _comp(comp)
+        , _node_allocator(alloc)
+    {
+    }
+
+    template <class InputIt>
+    persistent_map(InputIt first, InputIt last, const Compare & comp = Compare(), const Allocator & alloc = Allocator())
+        : persistent_map(comp, alloc)
+    {
+        for (; first != last; ++first) {
+            _insert_or_assign(*first, false);
+        }
+    }
+
+    persistent_map(std::initializer_list<value_type> init, const Compare & comp = Compare(), const Allocator & alloc = Allocator())
+        : persistent_map(init.begin(), init.end(), comp, alloc)
+    {
+    }
+
+    persistent_map(const persistent_map & other)
+        : _root(_retain(other._root))
+        , _size(other._size)
+        , _comp(other._comp)
+        , _node_allocator(other._node_allocator)
+    { // 共享other的全部节点，O(1)
+    }
+
+    persistent_map(persistent_map && other) noexcept
+        : _root(other._root)
+        , _size(other._size)
+        , _comp(std::move(other._comp))
+        , _node_allocator(std::move(other._node_allocator))
+    {
+        other._root = nullptr;
+        other._size = 0;
+    }
+
+    ~persistent_map()
+    {
+        _release(_root);
+    }
+
+public:
+    /**
+     * @brief 将值赋给容器
+     */
+    persistent_map & operator=(const persistent_map & other)
+    {
+        if (this != &other) {
+            node_pointer old = _root;
+            _root = _retain(other._root);
+            _size = other._size;
+            _comp = other._comp;
+            _node_allocator = other._node_allocator;
+            _release(old);
+        }
+        return *this;
+    }
+
+    /**
+     * @brief 将值赋给容器
+     */
+    persistent_map & operator=(persistent_map && other) noexcept
+    {
+        if (this != &other) {
+            swap(other);
+            other._release(other._root);
+            other._root = nullptr;
+            other._size = 0;
+        }
+        return *this;
+    }
+
+    /**
+     * @brief 返回关联的分配器
+     */
+    allocator_type get_allocator() const
+    {
+        return allocator_type(_node_allocator);
+    }
+
+    // 元素访问
+
+    /**
+     * @brief 带越界检查访问指定的元素
+     */
+    const mapped_type & at(const key_type & key) const
+    {
+        node_pointer x = _find(key);
+        if (x == nullptr) {
+            throw std::out_of_range("persistent_map at out of range");
+        }
+        return x->_data.second;
+    }
+
+    // 迭代器
+
+    /**
+     * @brief 返回指向起始的迭代器
+     */
+    const_iterator begin() const
+    {
+        const_iterator it;
+        it._push_left(_root);
+        return it;
+    }
+
+    /**
+     * @brief 返回指向起始的迭代器
+     */
+    const_iterator cbegin() const
+    {
+        return begin();
+    }
+
+    /**
+     * @brief 返回指向末尾的迭代器
+     */
+    const_iterator end() const
+    {
+        return const_iterator();
+    }
+
+    /**
+     * @brief 返回指向末尾的迭代器
+     */
+    const_iterator cend() const
+    {
+        return end();
+    }
+
+    // 容量
+
+    /**
+     * @brief 检查容器是否为空
+     */
+    bool empty() const noexcept
+    {
+        return _size == 0;
+    }
+
+    /**
+     * @brief 返回元素数
+     */
+    size_type size() const noexcept
+    {
+        return _size;
+    }
+
+    // 修改器
+
+    /**
+     * 修改器不改变当前版本，而是返回修改后的新版本
+     * 新版本与当前版本共享未被修改的节点，每次修改复制O(log n)个节点
+     */
+
+    /**
+     * @brief 返回插入元素后的新版本
+     * @details 键已存在时返回与当前版本相同的映射
+     */
+    persistent_map insert(const value_type & value) const
+    {
+        persistent_map result(*this);
+        result._insert_or_assign(value, false);
+        return result;
+    }
+
+    /**
+     * @brief 返回插入元素后的新版本，键已存在时替换对应的值
+     */
+    template <class M>
+    persistent_map insert_or_assign(const key_type & key, M && obj) const
+    {
+        persistent_map result(*this);
+        result._insert_or_assign(value_type(key, std::forward<M>(obj)), true);
+        return result;
+    }
+
+    /**
+     * @brief 返回擦除键为key的元素后的新版本
+     * @details 键不存在时返回与当前版本相同的映射
+     */
+    persistent_map erase(const key_type & key) const
+    {
+        persistent_map result(*this);
+        result._erase(key);
+        return result;
+    }
+
+    /**
+     * @brief 返回空的新版本
+     */
+    persistent_map clear() const
+    {
+        return persistent_map(_comp, get_allocator());
+    }
+
+    /**
+     * @brief 交换内容
+     */
+    void swap(persistent_map & other) noexcept
+    {
+        std::swap(_root, other._root);
+        std::swap(_size, other._size);
+        std::swap(_comp, other._comp);
+        std::swap(_node_allocator, other._node_allocator);
+    }
+
+    // 查找
+
+    /**
+     * @brief 返回匹配特定键的元素数量
+     */
+    size_type count(const key_type & key) const
+    {
+        return _find(key) == nullptr ? 0 : 1;
+    }
+
+    /**
+     * @brief 寻找带有特定键的元素
+     */
+    const_iterator find(const key_type & key) const
+    {
+        const_iterator it = lower_bound(key);
+        if (it._depth != 0 && _comp(key, it->first)) {
+            return end();
+        }
+        return it;
+    }
+
+    /**
+     * @brief 返回指向首个不小于给定键的元素的迭代器
+     * @details 向左下降时经过的节点就是之后要访问的祖先
+     */
+    const_iterator lower_bound(const key_type & key) const
+    {
+        const_iterator it;
+        for (node_pointer x = _root; x != nullptr; ) {
+            if (_comp(x->_data.first, key)) {
+                x = x->_right;
+            } else {
+                it._stack[it._depth++] = x;
+                x = x->_left;
+            }
+        }
+        return it;
+    }
+
+    /**
+     * @brief 返回指向首个大于给定键的元素的迭代器
+     */
+    const_iterator upper_bound(const key_type & key) const
+    {
+        const_iterator it;
+        for (node_pointer x = _root; x != nullptr; ) {
+            if (_comp(key, x->_data.first)) {
+                it._stack[it._depth++] = x;
+                x = x->_left;
+            } else {
+                x = x->_right;
+            }
+        }
+        return it;
+    }
+
+    // 观察器
+
+    /**
+     * @brief 返回用于比较键的函数
+     */
+    key_compare key_comp() const
+    {
+        return _comp;
+    }
+
+public:
+    /**
+     * @brief 增加节点的引用计数
+     */
+    static node_pointer _retain(node_pointer x) noexcept
+    {
+        if (x != nullptr) {
+            x->_refs.fetch_add(1, std::memory_order_relaxed);
+        }
+        return x;
+    }
+
+    /**
+     * @brief 减少节点的引用计数，降为0时销毁节点并释放其子树
+     */
+    void _release(node_pointer x)
+    {
+        while (x != nullptr && x->_refs.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+            node_pointer right = x->_right;
+            _release(x->_left);
+            _destroy_node(x);
+            x = right;      // 右子树迭代处理
+        }
+    }
+
+    /**
+     * @brief 创建节点，接管left和right的引用
+     */
+    template <class... Args>
+    node_pointer _create_node(node_pointer left, node_pointer right, Args&&... args)
+    {
+        node_pointer p = allocator_traits<node_allocator_type>::allocate(_node_allocator, 1);
+        allocator_traits<node_allocator_type>::construct(_node_allocator, p, left, right, std::forward<Args>(args)...);
+        return p;
+    }
+
+    /**
+     * @brief 销毁一个节点，不处理子节点
+     */
+    void _destroy_node(node_pointer p)
+    {
+        allocator_traits<node_allocator_type>::destroy(_node_allocator, p);
+        allocator_traits<node_allocator_type>::deallocate(_node_allocator, p, 1);
+    }
+
+    /**
+     * @brief 以值value和子树left、right构造平衡的新子树
+     * @details left和right的高度差不超过2，接管它们的引用；需要旋转时复制较高一侧的子树根
+     */
+    node_pointer _balance(const value_type & value, node_pointer left, node_pointer right)
+    {
+        const int hl = node::height(left);
+        const int hr = node::height(right);
+        if (hl > hr + 1) {
+            node_pointer result;
+            if (node::height(left->_left) >= node::height(left->_right)) {
+                // 右旋
+                result = _create_node(_retain(left->_left),
+                    _create_node(_retain(left->_right), right, value),
+                    left->_data);
+            } else {
+                // 先左旋再右旋
+                node_pointer lr = left->_right;
+                result = _create_node(_create_node(_retain(left->_left), _retain(lr->_left), left->_data),
+                    _create_node(_retain(lr->_right), right, value),
+                    lr->_data);
+            }
+            _release(left);
+            return result;
+        }
+        if (hr > hl + 1) {
+            node_pointer result;
+            if (node::height(right->_right) >= node::height(right->_left)) {
+                // 左旋
+                result = _create_node(_create_node(left, _retain(right->_left), value),
+                    _retain(right->_right),
+                    right->_data);
+            } else {
+                // 先右旋再左旋
+                node_pointer rl = right->_left;
+                result = _create_node(_create_node(left, _retain(rl->_left), value),
+                    _create_node(_retain(rl->_right), _retain(right->_right), right->_data),
+                    rl->_data);
+            }
+            _release(right);
+            return result;
+        }
+        return _create_node(left, right, value);
+    }
+
+    /**
+     * @brief 在当前版本中插入value，替换当前版本的根
+     * @details 只创建新节点，不修改任何已有节点，其他版本不受影响
+     */
+    void _insert_or_assign(const value_type & value, bool assign)
+    {
+        bool inserted = false;
+        node_pointer new_root = _insert(_root, value, assign, inserted);
+        if (new_root != nullptr) {
+            _release(_root);
+            _root = new_root;
+            if (inserted) {
+                ++_size;
+            }
+        }
+    }
+
+    /**
+     * @brief 在子树x中插入value，返回复制路径后的新子树
+     * @details 键已存在且不替换时返回nullptr，表示子树没有变化
+     */
+    node_pointer _insert(node_pointer x, const value_type & value, bool assign, bool & inserted)
+    {
+        if (x == nullptr) {
+            inserted = true;
+            return _create_node(nullptr, nullptr, value);
+        }
+        if (_comp(value.first, x->_data.first)) {
+            node_pointer left = _insert(x->_left, value, assign, inserted);
+            return left == nullptr ? nullptr : _balance(x->_data, left, _retain(x->_right));
+        }
+        if (_comp(x->_data.first, value.first)) {
+            node_pointer right = _insert(x->_right, value, assign, inserted);
+            return right == nullptr ? nullptr : _balance(x->_data, _retain(x->_left), right);
+        }
+        if (assign) {
+            // 替换值，高度不变
+            return _create_node(_retain(x->_left), _retain(x->_right), value);
+        }
+        return nullptr;
+    }
+
+    /**
+     * @brief 在当前版本中擦除key，替换当前版本的根
+     */
+    void _erase(const key_type & key)
+    {
+        bool erased = false;
+        node_pointer new_root = _erase(_root, key, erased);
+        if (erased) {
+            _release(_root);
+            _root = new_root;
+            --_size;
+        }
+    }
+
+    /**
+     * @brief 在子树x中擦除key，返回复制路径后的新子树
+     * @details 新子树可能为空，是否擦除由erased表示
+     */
+    node_pointer _erase(node_pointer x, const key_type & key, bool & erased)
+    {
+        if (x == nullptr) {
+            return nullptr;
+        }
+        if (_comp(key, x->_data.first)) {
+            node_pointer left = _erase(x->_left, key, erased);
+            return erased ? _balance(x->_data, left, _retain(x->_right)) : nullptr;
+        }
+        if (_comp(x->_data.first, key)) {
+            node_pointer right = _erase(x->_right, key, erased);
+            return erased ? _balance(x->_data, _retain(x->_left), right) : nullptr;
+        }
+        erased = true;
+        if (x->_left == nullptr) {
+            return _retain(x->_right);
+        }
+        if (x->_right == nullptr) {
+            return _retain(x->_left);
+        }
+        // 用右子树的最小节点代替x
+        node_pointer successor = x->_right;
+        while (successor->_left != nullptr) {
+            successor = successor->_left;
+        }
+        return _balance(successor->_data, _retain(x->_left), _erase_min(x->_right));
+    }
+
+    /**
+     * @brief 返回擦除子树x的最小节点后的新子树
+     */
+    node_pointer _erase_min(node_pointer x)
+    {
+        if (x->_left == nullptr) {
+            return _retain(x->_right);
+        }
+        return _balance(x->_data, _erase_min(x->_left), _retain(x->_right));
+    }
+
+    /**
+     * @brief 查找特定键的节点，不存在时返回nullptr
+     */
+    node_pointer _find(const key_type & key) const
+    {
+        node_pointer x = _root;
+        while (x != nullptr) {
+            if (_comp(key, x->_data.first)) {
+                x = x->_left;
+            } else if (_comp(x->_data.first, key)) {
+                x = x->_right;
+            } else {
+                return x;
+            }
+        }
+        return nullptr;
+    }
+};
+
+// 非成员函数
+
+/**
+ * @brief 交换两个版本
+ */
+template <
+    class Key,
+    class T,
+    class Compare,
+    class Allocator
+> void swap(persistent_map<Key, T, Compare, Allocator> & lhs, persistent_map<Key, T, Compare, Allocator> & rhs) noexcept
+{
+    lhs.swap(rhs);
+}
+
+/**
+ * @brief 发布persistent_map版本的原子单元
+ * @details 写者用store发布新版本，读者用load取得当前版本的快照，读者无锁且不会阻塞写者发布
+ * @details 读者在两个计数槽之一登记后才读取当前版本，写者替换版本后依次等待两个槽清空再释放旧版本，
+ *          等待期间新到的读者进入另一个槽，因此写者不会被持续到来的读者饿死
+ * @details store应由单个写者调用，多个写者需要在外部串行化
+ */
+template <
+    class Key,
+    class T,
+    class Compare = std::less<Key>,
+    class Allocator = wwstl::allocator<std::pair<const Key, T>>
+> class atomic_persistent_map
+{
+public:
+    using map_type = persistent_map<Key, T, Compare, Allocator>;
+
+public:
+    std::atomic<map_type *> _current;       // 当前发布的版本
+    std::atomic<std::size_t> _epoch;        // 最低位决定新读者登记的槽
+    mutable std::atomic<std::size_t> _readers[2];   // 正在读取_current的读者数
+
+public:
+    atomic_persistent_map()
+        : atomic_persistent_map(map_type())
+    {
+    }
+
+    explicit atomic_persistent_map(const map_type & map)
+        : _current(new map_type(map))
+        , _epoch(0)
+    {
+        _readers[0].store(0);
+        _readers[1].store(0);
+    }
+
+    atomic_persistent_map(const atomic_persistent_map &) = delete;
+
+    ~atomic_persistent_map()
+    {
+        delete _current.load();
+    }
+
+public:
+    atomic_persistent_map & operator=(const atomic_persistent_map &) = delete;
+
+    /**
+     * @brief 取得当前版本的快照
+     * @details 只增加一次根节点的引用计数，快照在之后的发布中保持不变
+     */
+    map_type load() const
+    {
+        std::atomic<std::size_t> & readers = _readers[_epoch.load() & 1];
+        readers.fetch_add(1);
+        map_type snapshot(*_current.load());
+        readers.fetch_sub(1);
+        return snapshot;
+    }
+
+    /**
+     * @brief 发布新版本
+     * @details 等待可能仍在复制旧版本的读者离开后才释放旧版本
+     */
+    void store(const map_type & map)
+    {
+        map_type * old = _current.exchange(new map_type(map));
+        const std::size_t epoch = _epoch.fetch_add(1);
+        _wait_readers(epoch & 1);
+        _epoch.fetch_add(1);
+        _wait_readers((epoch + 1) & 1);
+        delete old;
+    }
+
+public:
+    /**
+     * @brief 等待槽中的读者全部离开
+     */
+    void _wait_readers(std::size_t slot) const
+    {
+        while (_readers[slot].load() != 0) {
+            std::this_thread::yield();
+        }
+    }
+};
+
+} // namespace wwstl
+
+#endif // __WW_PERSISTENT_MAP_H__
@@ -2,10 +2,14 @@
 #define __WW_RB_TREE_H__
 
 #include <initializer_list>
+#include <cstdint>
+#include <tuple>
 #include "ww_memory.h"
 #include "ww_iterator.h"
 #include "ww_functional.h"
 #include "ww_algorithm.h"
+#include "ww_node_handle.h"
+#include "ww_tree_balance.h"
 
 namespace wwstl
 {
@@ -18,51 +22,229 @@ constexpr color_type _red = true;        // 红色true
 constexpr color_type _black = false;     // 黑色false
 
 /**
- * @brief 红黑树节点
- * @details 节点默认为红色
+ * @brief 红黑树节点的链接部分
+ * @details Compact为true时使用紧凑布局，颜色存储在父节点指针的最低位
+ */
+template <class Node, bool Compact>
+class _rb_tree_node_links;
+
+/**
+ * @brief 紧凑布局的链接部分
+ * @details 节点中含有指针成员，地址至少按指针对齐，最低位恒为0，可以用来存储颜色
  */
-template <class Value>
-class _rb_tree_node
+template <class Node>
+class _rb_tree_node_links<Node, true>
 {
 public:
-    using value_type = Value;
-    using node_pointer = _rb_tree_node<Value>*;
+    using node_pointer = Node*;
+
+public:
+    std::uintptr_t _parent_color;   // 父节点指针，最低位存储颜色
+    node_pointer _left;             // 左子节点
+    node_pointer _right;            // 右子节点
+
+public:
+    _rb_tree_node_links()
+        : _parent_color(static_cast<std::uintptr_t>(_red))
+        , _left(nullptr)
+        , _right(nullptr)
+    { // 默认为红色
+    }
+
+public:
+    node_pointer parent() const
+    {
+        return reinterpret_cast<node_pointer>(_parent_color & ~static_cast<std::uintptr_t>(1));
+    }
+
+    void set_parent(node_pointer p)
+    {
+        _parent_color = reinterpret_cast<std::uintptr_t>(p) | (_parent_color & static_cast<std::uintptr_t>(1));
+    }
+
+    color_type color() const
+    {
+        return static_cast<color_type>(_parent_color & static_cast<std::uintptr_t>(1));
+    }
+
+    void set_color(color_type color)
+    {
+        _parent_color = (_parent_color & ~static_cast<std::uintptr_t>(1)) | static_cast<std::uintptr_t>(color);
+    }
+};
+
+/**
+ * @brief 普通布局的链接部分
+ * @details 颜色单独存储，用于无法保证指针最低位为0的平台
+ */
+template <class Node>
+class _rb_tree_node_links<Node, false>
+{
+public:
+    using node_pointer = Node*;
 
 public:
     node_pointer _parent;       // 父节点
     node_pointer _left;         // 左子节点
     node_pointer _right;        // 右子节点
     color_type _color;          // 颜色
-    value_type _data;           // 值
 
 public:
-    _rb_tree_node()
-        : _data()
-        , _parent(nullptr)
+    _rb_tree_node_links()
+        : _parent(nullptr)
         , _left(nullptr)
         , _right(nullptr)
         , _color(_red)
+    { // 默认为红色
+    }
+
+public:
+    node_pointer parent() const
+    {
+        return _parent;
+    }
+
+    void set_parent(node_pointer p)
+    {
+        _parent = p;
+    }
+
+    color_type color() const
+    {
+        return _color;
+    }
+
+    void set_color(color_type color)
+    {
+        _color = color;
+    }
+};
+
+/**
+ * @brief 红黑树节点的子树大小部分
+ * @details Counted为true时记录以该节点为根的子树的节点个数，用于顺序统计
+ */
+template <bool Counted>
+class _rb_tree_node_count
+{
+public:
+    std::size_t _count;         // 子树的节点个数
+
+public:
+    _rb_tree_node_count()
+        : _count(1)
+    { // 新节点的子树只有自身
+    }
+
+public:
+    std::size_t count() const
+    {
+        return _count;
+    }
+
+    void set_count(std::size_t count)
+    {
+        _count = count;
+    }
+};
+
+/**
+ * @brief 不记录子树大小
+ * @details 空类，作为基类时不占用空间
+ */
+template <>
+class _rb_tree_node_count<false>
+{
+public:
+    std::size_t count() const
+    {
+        return 0;
+    }
+
+    void set_count(std::size_t)
+    {
+    }
+};
+
+/**
+ * @brief 红黑树节点的区间上界部分
+ * @details 记录以该节点为根的子树中所有区间上界的最大值，用于区间查询
+ */
+template <class Bound>
+class _rb_tree_node_high
+{
+public:
+    Bound _high;                // 子树中区间上界的最大值
+
+public:
+    void copy_high(const _rb_tree_node_high & other)
+    {
+        _high = other._high;
+    }
+};
+
+/**
+ * @brief 不记录区间上界
+ * @details 空类，作为基类时不占用空间
+ */
+template <>
+class _rb_tree_node_high<void>
+{
+public:
+    void copy_high(const _rb_tree_node_high &)
+    {
+    }
+};
+
+/**
+ * @brief 红黑树节点
+ * @details 节点默认为红色
+ * @details 指针对齐允许时默认使用紧凑布局，每个节点节省一个颜色字段及其填充
+ * @details Counted为true时额外记录子树大小
+ * @details High不为void时额外记录子树中区间上界的最大值，High为区间端点的类型
+ * @details Balance为平衡策略，节点包含策略自己的字段
+ */
+template <
+    class Value,
+    bool Compact = (alignof(void *) > 1),
+    bool Counted = false,
+    class High = void,
+    class Balance = red_black_balance
+> class _rb_tree_node
+    : public _rb_tree_node_links<_rb_tree_node<Value, Compact, Counted, High, Balance>, Compact>
+    , public _rb_tree_node_count<Counted>
+    , public _rb_tree_node_high<High>
+    , public Balance::node_data
+{
+public:
+    using value_type = Value;
+    using node_pointer = _rb_tree_node<Value, Compact, Counted, High, Balance>*;
+
+public:
+    value_type _data;           // 值
+
+public:
+    _rb_tree_node()
+        : _data()
     { // 构造空节点
     }
 
     _rb_tree_node(const value_type & value)
         : _data(value)
-        , _parent(nullptr)
-        , _left(nullptr)
-        , _right(nullptr)
-        , _color(_red)
     { // 以值构造一个节点
     }
 
     _rb_tree_node(value_type && value)
         : _data(std::move(value))
-        , _parent(nullptr)
-        , _left(nullptr)
-        , _right(nullptr)
-        , _color(_red)
     { // 以值构造一个节点
     }
 
+    template <class... Args>
+    explicit _rb_tree_node(Args&&... args)
+        : _data(std::forward<Args>(args)...)
+    { // 以参数原位构造节点的值
+    }
+
 public:
     /**
      * @brief 返回最小节点
@@ -88,8 +270,10 @@ public:
 /**
  * @brief 红黑树常量迭代器
  */
-template <class Value>
-class _rb_tree_const_iterator
+template <
+    class Value,
+    class Node = _rb_tree_node<Value>
+> class _rb_tree_const_iterator
 {
 public:
     using iterator_category = std::bidirectional_iterator_tag;
@@ -99,14 +283,19 @@ public:
     using pointer = const value_type*;
     using reference = const value_type&;
 
-    using self = _rb_tree_const_iterator<Value>;
-    using node = _rb_tree_node<Value>;
-    using node_pointer = _rb_tree_node<Value>*;
+    using self = _rb_tree_const_iterator<Value, Node>;
+    using node = Node;
+    using node_pointer = Node*;
 
 public:
     node_pointer _node;         // 指向当前节点
 
 public:
+    _rb_tree_const_iterator()
+        : _node(nullptr)
+    { // 构造不指向任何节点的迭代器
+    }
+
     _rb_tree_const_iterator(const node_pointer node)
         : _node(const_cast<node_pointer>(node))
     { // 以节点构造迭代器
@@ -131,11 +320,11 @@ public:
             _node = node::minimum(_node->_right);
         } else {
             // 找到父节点
-            node_pointer p = _node->_parent;
+            node_pointer p = _node->parent();
             while (_node == p->_right) {
                 // 如果是父节点的右子节点，则继续向上找父节点，直到找到该节点是父节点的左子节点
                 _node = p;
-                p = p->_parent;
+                p = p->parent();
             }
             if (_node->_right != p) {
                 // 如果右子节点不是父节点，则返回父节点，否则返回当前节点
@@ -154,17 +343,18 @@ public:
 
     self & operator--()
     {
-        if (_node->_color == _red && _node->_parent->_parent == _node) {
+        if (_node->color() == _red && _node->parent()->parent() == _node) {
             // 如果当前节点是红色，且它的父节点是根节点，此时当前节点为head
+            // 红黑策略的根节点总是黑色，其他策略的所有节点都是黑色，见ww_tree_balance.h
             _node = _node->_right;
         } else if (_node->_left != nullptr) {
             // 如果存在左子节点，返回左子节点的最大节点
             _node = node::maximum(_node->_left);
         } else {
-            node_pointer p = _node->_parent;
+            node_pointer p = _node->parent();
             while (_node == p->_left) {
                 _node = p;
-                p = p->_parent;
+                p = p->parent();
             }
             _node = p;
         }
@@ -192,12 +382,14 @@ public:
 /**
  * @brief 红黑树迭代器
  */
-template <class Value>
-class _rb_tree_iterator
-    : public _rb_tree_const_iterator<Value>
+template <
+    class Value,
+    class Node = _rb_tree_node<Value>
+> class _rb_tree_iterator
+    : public _rb_tree_const_iterator<Value, Node>
 {
 public:
-    using base = _rb_tree_const_iterator<Value>;
+    using base = _rb_tree_const_iterator<Value, Node>;
     using iterator_category = std::bidirectional_iterator_tag;
     using value_type = Value;
     using size_type = std::size_t;
@@ -205,11 +397,16 @@ public:
     using pointer = value_type*;
     using reference = value_type&;
 
-    using self = _rb_tree_iterator<Value>;
-    using node = _rb_tree_node<Value>;
-    using node_pointer = _rb_tree_node<Value>*;
+    using self = _rb_tree_iterator<Value, Node>;
+    using node = Node;
+    using node_pointer = Node*;
 
 public:
+    _rb_tree_iterator()
+        : base()
+    { // 构造不指向任何节点的迭代器
+    }
+
     _rb_tree_iterator(node_pointer node)
         : base(node)
     { // 以节点构造迭代器
@@ -253,8 +450,70 @@ public:
     }
 };
 
+/**
+ * @brief 区间端点的类型
+ * @details 启用区间增强时键为std::pair<Bound, Bound>，端点类型为Bound，否则为void
+ */
+template <class Key, bool Interval>
+class _rb_tree_interval_bound
+{
+public:
+    using type = void;
+};
+
+template <class Key>
+class _rb_tree_interval_bound<Key, true>
+{
+public:
+    using type = typename Key::second_type;
+};
+
+/**
+ * @brief 区间的比较函数
+ * @details 区间为左闭右开的std::pair<Bound, Bound>，先比较下界，下界相同时比较上界
+ * @details bound_less比较单个端点，供区间树维护子树的最大上界
+ */
+template <class Bound, class Compare = std::less<Bound>>
+class _interval_compare
+{
+public:
+    Compare _bound_comp;    // 端点的比较函数
+
+public:
+    _interval_compare()
+        : _bound_comp()
+    {
+    }
+
+    explicit _interval_compare(const Compare & comp)
+        : _bound_comp(comp)
+    {
+    }
+
+public:
+    bool operator()(const std::pair<Bound, Bound> & lhs, const std::pair<Bound, Bound> & rhs) const
+    {
+        if (_bound_comp(lhs.first, rhs.first)) {
+            return true;
+        }
+        if (_bound_comp(rhs.first, lhs.first)) {
+            return false;
+        }
+        return _bound_comp(lhs.second, rhs.second);
+    }
+
+    bool bound_less(const Bound & lhs, const Bound & rhs) const
+    {
+        return _bound_comp(lhs, rhs);
+    }
+};
+
 /**
  * @brief 红黑树
+ * @details OrderStatistic为true时每个节点记录子树大小，支持O(log n)的rank和nth
+ * @details Interval为true时键为左闭右开区间std::pair<Bound, Bound>，key_compare需要提供bound_less，
+ *          每个节点记录子树中的最大上界，支持find_overlapping和find_containing
+ * @details Balance为平衡策略，见ww_tree_balance.h，默认为红黑树
  */
 template <
     class Key,
@@ -262,7 +521,10 @@ template <
     class Value,
     class ExtractKey,
     class Compare = std::less<Key>,
-    class Allocator = wwstl::allocator<Value>
+    class Allocator = wwstl::allocator<Value>,
+    bool OrderStatistic = false,
+    bool Interval = false,
+    class Balance = red_black_balance
 > class rb_tree
 {
 public:
@@ -278,15 +540,20 @@ public:
     using const_reference = const value_type&;
     using pointer = value_type*;
     using const_pointer = const value_type*;
-    using iterator = _rb_tree_iterator<value_type>;
-    using const_iterator = _rb_tree_const_iterator<value_type>;
+    using bound_type = typename _rb_tree_interval_bound<key_type, Interval>::type;
+    using balance_type = Balance;
+    using node = _rb_tree_node<value_type, (alignof(void *) > 1), OrderStatistic, bound_type, Balance>;
+    using iterator = _rb_tree_iterator<value_type, node>;
+    using const_iterator = _rb_tree_const_iterator<value_type, node>;
     using reverse_iterator = wwstl::reverse_iterator<iterator>;
     using const_reverse_iterator = wwstl::reverse_iterator<const_iterator>;
 
-    using node = _rb_tree_node<value_type>;
     using node_pointer = node*;
     using node_allocator_type = typename allocator_type::template rebind<node>::other;
 
+    using node_type = _node_handle<key_type, mapped_type, value_type, node, allocator_type>;
+    using insert_return_type = _node_insert_return<iterator, node_type>;
+
 public:
     node_pointer _head;                     // 红黑树的头节点
     size_type _size;                        // 节点个数
@@ -329,9 +596,7 @@ public:
         , _node_allocator(alloc)
     {
         _init_rb_tree();
-        for (; first != last; ++first) {
-            emplace_equal(*first);
-        }
+        insert_range_equal(first, last);
     }
 
     rb_tree(const rb_tree & other)
@@ -342,9 +607,7 @@ public:
         , _node_allocator(other._node_allocator)
     {
         _init_rb_tree();
-        for (auto it = other.begin(); it != other.end(); ++it) {
-            emplace_equal(*it);
-        }
+        _copy_from(other);
     }
 
     rb_tree(const rb_tree & other, const allocator_type & alloc)
@@ -355,9 +618,7 @@ public:
         , _node_allocator(alloc)
     {
         _init_rb_tree();
-        for (auto it = other.begin(); it != other.end(); ++it) {
-            emplace_equal(*it);
-        }
+        _copy_from(other);
     }
 
     rb_tree(rb_tree && other)
@@ -397,15 +658,13 @@ public:
         if (this != &other) {
             // 清空自身红黑树
             clear();
-            // 拷贝
-            for (auto it = other.begin(); it != other.end(); ++it) {
-                emplace_equal(*it); // 选择信任other，不会用重复数据传入不应该重复的数据结构中
-            }
             _comp = other._comp;
             _get_key = other._get_key;
             if (std::allocator_traits<allocator_type>::propagate_on_container_copy_assignment::value) {
                 _node_allocator = other._node_allocator;
             }
+            // 按结构拷贝，不需要重新比较和平衡
+            _copy_from(other);
         }
         return *this;
     }
@@ -581,26 +840,77 @@ public:
     template <class... Args>
     std::pair<iterator, bool> emplace_unique(Args&&... args)
     {
-        node_pointer new_node = _create_node(std::forward<Args>(args)...);
-        key_type key = _get_key(new_node->_data);
-        node_pointer parent = nullptr;      // 记录cur的父节点
-        node_pointer cur = _root();
-        while (cur != nullptr) {
-            parent = cur;
-            if (_comp(_get_key(cur->_data), key)) {
-                // 当前节点的键小于目标key，向右寻找
-                cur = _right(cur);
-            } else if (_comp(key, _get_key(cur->_data))) {
-                // 当前节点的键大于目标key，向左寻找
-                cur = _left(cur);
-            } else {
-                // 重复，插入失败
-                _destroy_node(new_node);
-                return std::make_pair<iterator, bool>(iterator(cur), false);
-            }
+        return _emplace_unique(_emplace_key_extractable<key_type, mapped_type, Args...>(), std::forward<Args>(args)...);
+    }
+
+    /**
+     * @brief 键不存在时以key和args原位构造元素，键已存在时不做任何事
+     * @details 先查找再分配节点，键已存在时不会移动key和args
+     * @details 用于map
+     */
+    template <class K, class... Args>
+    std::pair<iterator, bool> try_emplace_unique(K && key, Args&&... args)
+    {
+        return _emplace_unique_key(key,
+            std::piecewise_construct,
+            std::forward_as_tuple(std::forward<K>(key)),
+            std::forward_as_tuple(std::forward<Args>(args)...));
+    }
+
+    /**
+     * @brief 键不存在时插入元素，键已存在时将obj赋值给对应的值
+     * @details 查找与插入共用一次下降，赋值时不分配节点
+     * @details 用于map
+     */
+    template <class K, class M>
+    std::pair<iterator, bool> insert_or_assign_unique(K && key, M && obj)
+    {
+        bool insert_left = true;
+        std::pair<node_pointer, bool> pos = _find_insert_unique_pos(key, insert_left);
+        if (!pos.second) {
+            pos.first->_data.second = std::forward<M>(obj);
+            return std::pair<iterator, bool>(iterator(pos.first), false);
         }
-        // 查找结束，在parent的位置插入
-        return std::make_pair<iterator, bool>(_emplace(parent, std::move(new_node)), true);
+        node_pointer new_node = _create_node(std::forward<K>(key), std::forward<M>(obj));
+        return std::pair<iterator, bool>(_link_node(pos.first, new_node, insert_left), true);
+    }
+
+    /**
+     * @brief 使用提示，键不存在时以key和args原位构造元素，键已存在时不做任何事
+     * @details 先借助hint查找插入位置，键紧邻hint之前或之后时均摊O(1)，否则退化为从根查找
+     * @details 用于map
+     */
+    template <class K, class... Args>
+    iterator try_emplace_hint_unique(const_iterator hint, K && key, Args&&... args)
+    {
+        bool insert_left = true;
+        std::pair<node_pointer, bool> pos = _find_hint_unique_pos(hint, key, insert_left);
+        if (!pos.second) {
+            // 键已存在，不分配节点
+            return iterator(pos.first);
+        }
+        node_pointer new_node = _create_node(std::piecewise_construct,
+            std::forward_as_tuple(std::forward<K>(key)),
+            std::forward_as_tuple(std::forward<Args>(args)...));
+        return _link_node(pos.first, new_node, insert_left);
+    }
+
+    /**
+     * @brief 使用提示，键不存在时插入元素，键已存在时将obj赋值给对应的值
+     * @details 查找方式与try_emplace_hint_unique相同
+     * @details 用于map
+     */
+    template <class K, class M>
+    iterator insert_or_assign_hint_unique(const_iterator hint, K && key, M && obj)
+    {
+        bool insert_left = true;
+        std::pair<node_pointer, bool> pos = _find_hint_unique_pos(hint, key, insert_left);
+        if (!pos.second) {
+            pos.first->_data.second = std::forward<M>(obj);
+            return iterator(pos.first);
+        }
+        node_pointer new_node = _create_node(std::forward<K>(key), std::forward<M>(obj));
+        return _link_node(pos.first, new_node, insert_left);
     }
 
     /**
@@ -610,43 +920,54 @@ public:
     template <class... Args>
     iterator emplace_equal(Args&&... args)
     {
-        node_pointer new_node = _create_node(std::forward<Args>(args)...);
-        key_type key = _get_key(new_node->_data);
-        node_pointer parent = nullptr;      // 记录cur的父节点
-        node_pointer cur = _root();
-        // 查找插入位置
-        while (cur != nullptr) {
-            parent = cur;
-            if (_comp(key, _get_key(cur->_data))) {
-                // 目标key小于当前节点的键，向左寻找
-                cur = _left(cur);
-            } else {
-                // 目标key大于等于当前节点，向右寻找
-                cur = _right(cur);
-            }
-        }
-        // 查找结束，在parent的位置插入
-        return _emplace(parent, std::move(new_node));
+        return _insert_node_equal(_create_node(std::forward<Args>(args)...));
     }
 
     /**
      * @brief 根据提示插入元素，不允许重复
+     * @details 新元素紧邻hint之前或之后时直接链接，均摊O(1)，否则退化为普通插入
      */
     template <class... Args>
-    iterator emplace_hint_unique(const_iterator, Args&&... args)
+    iterator emplace_hint_unique(const_iterator hint, Args&&... args)
     {
-        // 忽略hint
-        return emplace_unique(std::forward<Args>(args)...).first;
+        node_pointer new_node = _create_node(std::forward<Args>(args)...);
+        std::pair<iterator, bool> result = _insert_node_hint_unique(hint, new_node);
+        if (!result.second) {
+            // 重复，插入失败
+            _destroy_node(new_node);
+        }
+        return result.first;
     }
 
     /**
      * @brief 根据提示插入元素，允许重复
+     * @details 新元素紧邻hint之前或之后时直接链接，均摊O(1)，否则退化为普通插入
      */
     template <class... Args>
-    iterator emplace_hint_equal(const_iterator, Args&&... args)
+    iterator emplace_hint_equal(const_iterator hint, Args&&... args)
+    {
+        return _insert_node_hint_equal(hint, _create_node(std::forward<Args>(args)...));
+    }
+
+    /**
+     * @brief 插入范围内的元素，不允许重复
+     * @details 树为空且输入有序时，一次遍历直接构建红黑树，复杂度O(n)
+     * @details 输入无序时，有序的前缀仍然批量构建，剩余元素逐个插入
+     */
+    template <class InputIt>
+    void insert_range_unique(InputIt first, InputIt last)
+    {
+        _insert_range<true>(first, last);
+    }
+
+    /**
+     * @brief 插入范围内的元素，允许重复
+     * @details 同insert_range_unique，有序输入允许相等的键
+     */
+    template <class InputIt>
+    void insert_range_equal(InputIt first, InputIt last)
     {
-        // 忽略hint
-        return emplace_equal(std::forward<Args>(args)...);
+        _insert_range<false>(first, last);
     }
 
     /**
@@ -654,334 +975,339 @@ public:
      */
     iterator erase(const_iterator pos)
     {
-        const_iterator next = std::next(pos);   // 下一个节点
         node_pointer node = pos._node;          // 要擦除的节点
-        node_pointer parent = node->_parent;    // 要擦除的节点的父节点
-        
-        /**
-         * 在红黑树的删除中，可以分为三大类情况
-         * 1. 删除的节点只有一个子节点，此时子节点一定是红色，且节点一定是黑色，否则违反红黑树的性质
-         * 2. 删除的节点没有子节点，需要根据兄弟节点的颜色和兄弟节点的孩子情况进行调整
-         * 3. 删除的节点有两个子节点，选择它的直接后继节点进行替换，并转为删除它的后继节点
-         */
+        iterator next(node);                    // 下一个节点
+        ++next;
 
-        // 在删除之前，修改leftmost和rightmost
-        // 先调整rightmost再调整leftmost
-        if (_rightmost() == node) {
-            if (_leftmost() == node) {
-                // 删除的是最后一个节点，pos无法向前移动了，直接设置
-                _rightmost() = _head;
-            } else {
-                // 向前移动
-                const_iterator prev = std::prev(pos);
-                _rightmost() = prev._node;
-            }
-        }
-        
-        if (_leftmost() == node) {
-            if (next._node == _head) {
-            }
-            _leftmost() = next._node;
-        }
-
-        // 1. 有两个子节点
-        // 可以采用节点的直接前驱或者直接后继来替代它，然后转化为删除该前驱或者后继的情况，最后一定会变为情况2或情况3
-        // 这里使用直接后继，因为erase()接口的语义需要返回下一个迭代器
-        if (_left(node) != nullptr && _right(node) != nullptr) {
-            // 这里可以直接递归，因为有两个子节点的情况下，不可能出现next为head的情况
-            // 将两个节点互换，这里不构造新节点替换node，而是要交换
-            // 因为如果替换node，删除next，会导致next迭代器失效，在范围删除中会出bug
-            node_pointer node_left_child = _left(node);
-            node_pointer node_right_child = _right(node);
-            // 没有next_left_child，因为直接后继一定没有左子树
-            node_pointer next_right_child = _right(next._node);
-            node_pointer next_parent = _parent(next._node);
-            // 开始交换位置
-            
-            if (_right(node) == next._node) {
-                // 1. next就是node的右子节点
-                _parent(node) = next._node;    // node->parent
-                std::swap(_left(node), _left(next._node));  // node->left, next->left
-                _right(node) = next_right_child;    // node->right
-                std::swap(_color(node), _color(next._node));    // node->color, next->color
-                _parent(next._node) = parent;   // next->parent
-                _right(next._node) = node;      // next->right
-                // 设置子节点的父节点和父节点的子节点
-                _parent(node_left_child) = next._node;
-                if (next_right_child != nullptr) {
-                    _parent(next_right_child) = node;
-                }
-            } else {
-                // 2. next不是右子节点，只是直接后继
-                std::swap(_left(node), _left(next._node));
-                std::swap(_right(node), _right(next._node));
-                std::swap(_parent(node), _parent(next._node));
-                std::swap(_color(node), _color(next._node));
-                // 更新node子节点的父指针
-                _parent(node_right_child) = next._node;
-                _parent(node_left_child) = next._node;
-                // 更新next子节点的父指针，注意没有左子节点
-                if (next_right_child != nullptr) {
-                    _parent(next_right_child) = node;
-                }
-                // 更新父节点
-                if (_left(next_parent) == next._node) {
-                    _left(next_parent) = node;
-                } else {
-                    _right(next_parent) = node;
-                }
-            }
+        // 先将节点从树中摘下并完成平衡调整，再销毁节点
+        // 调整过程只交换节点的位置而不交换值，不会使其他迭代器失效
+        _rebalance_for_erase(node);
+        _destroy_node(node);
+        --_size;
+        return next;
+    }
 
-            if (parent == _head) {
-                _root() = next._node;
-            } else if (_left(parent) == node) {
-                _left(parent) = next._node;
-            } else {
-                _right(parent) = next._node;
-            }
-            erase(const_iterator(node));
-            return iterator(next._node);
+    /**
+     * @brief 擦除元素
+     */
+    iterator erase(const_iterator first, const_iterator last)
+    {
+        for (const_iterator it = first; it != last; ) {
+            it = erase(it);
         }
+        return iterator(last._node);
+    }
 
-        // 2. 没有子节点
-        if (node->_left == nullptr && node->_right == nullptr) {
-            if (_color(node) == _red) {
-                // 2.1 是红节点，直接删除节点即可，不会破坏红黑树的性质
-                // 置空父节点的指针
-                if (_left(parent) == node) {
-                    _left(parent) = nullptr;
-                } else {
-                    _right(parent) = nullptr;
-                }
-                // 销毁当前节点
-                _destroy_node(node);
-                --_size;
-                return iterator(next._node);
-            } else {
-                // 2.2 是黑节点，需要查看兄弟节点的情况
-                node_pointer sibling = nullptr;
-
-                // 这里使用循环是因为双黑节点上移后需要继续调整，使用is_first来控制在第一次循环中销毁节点
-                for (bool is_first = true; ; is_first = false) {
-                    // 找到兄弟节点
-                    if (parent == _head) {
-                        sibling = node;
-                    } else
-                    if (_right(parent) == node) {
-                        sibling = _left(parent);
-                    } else {
-                        sibling = _right(parent);
-                    }
+    /**
+     * @brief 擦除元素
+     */
+    size_type erase(const key_type & key) {
+        size_type result = 0;
+        auto it = lower_bound(key);  // 查找第一个符合条件的元素
 
-                    if (_color(sibling) == _black) {
-                        // 2.2.1 兄弟节点是黑色，需要查看兄弟节点的孩子的情况
-                        // 这种情况下，兄弟节点的孩子如果存在一定是红色，否则是黑色空节点
-                        // 此时可能存在node是根节点的情况，也就是说node是红黑树中最后一个节点，删除后head恢复初始化
-                        node_pointer left_child = _left(sibling);
-                        node_pointer right_child = _right(sibling);
-
-                        if (_left(parent) == sibling && left_child != nullptr && _color(left_child) == _red) {
-                            // 2.2.1.1 兄弟节点的左孩子是红色，则全都归为LL情况，无论右孩子是什么
-                            // LL情况中，需要先变色：r变s，s变p，p变黑
-                            _color(left_child) = _color(sibling);
-                            _color(sibling) = _color(parent);
-                            _color(parent) = _black;
-                            // 右旋parent节点
-                            _right_rotate(parent);
-                            // 销毁当前节点
-                            if (is_first) {
-                                // 只有第一次循环可以销毁节点，后续要调整只要变色旋转即可
-                                // 后续调整来自于情况2.2.1.5.*和情况2.2.2，会继续循环
-                                _right(parent) = nullptr;
-                                _destroy_node(node);
-                                --_size;
-                            }
-                            return iterator(next._node);
-                        }
-
-                        if (_left(parent) == sibling && right_child != nullptr && _color(right_child) == _red && left_child == nullptr) {
-                            // 2.2.1.2 兄弟节点的右孩子是红色，且左孩子是黑色，LR情况
-                            // LR情况中，需要先变色：r变p，p变黑
-                            _color(right_child) = _color(parent);
-                            _color(parent) = _black;
-                            // 先左旋sibling节点，再右旋parent节点
-                            _left_rotate(sibling);
-                            _right_rotate(parent);
-                            // 销毁当前节点
-                            if (is_first) {
-                                _right(parent) = nullptr;
-                                _destroy_node(node);
-                                --_size;
-                            }
-                            return iterator(next._node);
-                        }
-
-                        if (_right(parent) == sibling && right_child != nullptr && _color(right_child) == _red) {
-                            // 2.2.1.3 兄弟节点的右孩子是红色，且全部归为RR情况，无论左孩子是什么
-                            // RR情况中，需要先变色：r变s，s变p，p变黑
-                            _color(right_child) = _color(sibling);
-                            _color(sibling) = _color(parent);
-                            _color(parent) = _black;
-                            // 左旋parent节点
-                            _left_rotate(parent);
-                            // 销毁当前节点
-                            if (is_first) {
-                                _left(parent) = nullptr;
-                                _destroy_node(node);
-                                --_size;
-                            }
-                            return iterator(next._node);
-                        }
-
-                        if (_right(parent) == sibling && left_child != nullptr && _color(left_child) == _red && right_child == nullptr) {
-                            // 2.2.1.4 兄弟节点的左孩子是红色，且右孩子是黑色，RL情况
-                            // RL情况中，需要先变色：r变p，p变黑
-                            _color(left_child) = _color(parent);
-                            _color(parent) = _black;
-                            // 先右旋sibling节点，再左旋parent节点
-                            _right_rotate(sibling);
-                            _left_rotate(parent);
-                            // 销毁当前节点
-                            if (is_first) {
-                                _left(parent) = nullptr;
-                                _destroy_node(node);
-                                --_size;
-                            }
-                            return iterator(next._node);
-                        }
-
-                        // 2.2.1.5 兄弟节点的左右孩子都是黑色，即没有孩子
-                        // 这种情况下，兄弟变红，双黑上移
-                        _color(sibling) = _red;
-
-                        // 此时已经不需要当前节点了，在第一次循环中直接销毁，后面还要更新node指针
-                        if (is_first) {
-                            if (parent == _head) {
-                                // 删除根节点，并恢复head
-                                // 一开始已经恢复过leftmost和rightmost了
-                                _root() = nullptr;
-                            } else if (_left(parent) == node) {
-                                _left(parent) = nullptr;
-                            } else {
-                                _right(parent) = nullptr;
-                            }
-                            _destroy_node(node);
-                            --_size;
-                        }
-
-                        // 考虑父节点的情况
-                        if (parent == _root() || _color(parent) == _red) {
-                            // 2.2.1.5.1 父节点是根节点，或者父节点是红色
-                            // 不需要进行额外操作，将红色父节点变黑即可
-                            _color(parent) = _black;
-                            return iterator(next._node);
-                        } else {
-                            // 2.2.1.5.2 父节点是黑色，且不是根节点
-                            // 父节点变为新的双黑节点，更新指针继续循环
-                            node = parent;
-                            parent = _parent(node);
-                        }
-                        // 继续循环调整
-                    } else {
-                        // 2.2.2 兄弟节点是红色
-                        // 先将s和p变色
-                        _color(sibling) = !_color(sibling);
-                        _color(parent) = !_color(parent);
-                        // 再将父节点向双黑节点的方向旋转
-                        if (node == _left(parent)) {
-                            // 左旋父节点
-                            _left_rotate(parent);
-                        } else {
-                            // 右旋父节点
-                            _right_rotate(parent);
-                        }
-                        
-                        // 在第一次循环中直接销毁
-                        if (is_first) {
-                            if (_left(parent) == node) {
-                                _left(parent) = nullptr;
-                            } else {
-                                _right(parent) = nullptr;
-                            }
-                            _destroy_node(node);
-                            --_size;
-                        }
-                    }
+        while (it != end() && !_comp(key, _get_key(it._node->_data))) {
+            // 找到与key等价的元素，进行删除
+            it = erase(it);  // 更新迭代器
+            ++result;
+        }
+
+        return result;
+    }
+
+
+    /**
+     * @brief 交换内容
+     */
+    void swap(rb_tree & other)
+    {
+        std::swap(_head, other._head);
+        std::swap(_size, other._size);
+        std::swap(_comp, other._comp);
+        std::swap(_get_key, other._get_key);
+        if (std::allocator_traits<allocator_type>::propagate_on_container_swap::value) {
+            std::swap(_node_allocator, other._node_allocator);
+        }
+    }
+
+    // 合并与拆分
+    /**
+     * 以下操作基于join实现，直接移动节点，不分配新节点
+     * 要求两棵树的分配器相等，操作后other为空
+     */
+
+    /**
+     * @brief 在key处拆分
+     * @details 自身保留小于key的元素，返回不小于key的元素
+     * @details 拆分本身为O(log n)，但两侧的元素个数需要另外求出：
+     *          启用顺序统计时由排名得到，整体为O(log n)；
+     *          未启用时从拆分点向两侧交替遍历计数，为O(min(k, n - k))，最坏为线性，需要对数复杂度时应启用顺序统计
+     * @details 集合操作不经过split，拆开的子树不计数，元素个数由被销毁的节点数得到
+     */
+    rb_tree split(const key_type & key)
+    {
+        rb_tree right(_comp, _node_allocator);
+        if (_root() == nullptr) {
+            return right;
+        }
+
+        size_type right_count = 0;
+        if (OrderStatistic) {
+            right_count = _size - _rank(key);
+        } else {
+            // 从拆分点向两侧交替计数，较短的一侧先到达端点
+            const_iterator forward = lower_bound(key);
+            const_iterator backward = forward;
+            const_iterator first = begin();
+            const_iterator last = end();
+            while (true) {
+                if (forward == last) {
+                    break;
                 }
+                if (backward == first) {
+                    right_count = _size - right_count;
+                    break;
+                }
+                ++forward;
+                --backward;
+                ++right_count;
             }
         }
 
-        // 3. 只有一个子节点
-        // node一定是黑色，子节点一定是红色，此时node可能是根节点
-        node_pointer child = nullptr;
-        if (node->_left != nullptr) {
-            child = node->_left;
-        } else {
-            child = node->_right;
+        node_pointer root = _root();
+        size_type bh = _black_height(root);
+        _init_head();
+
+        node_pointer l = nullptr;
+        node_pointer r = nullptr;
+        node_pointer mid = nullptr;
+        size_type lbh = 0;
+        size_type rbh = 0;
+        _split(root, bh, key, false, l, lbh, mid, r, rbh);
+
+        right._install(r, right_count);
+        _install(l, _size - right_count);
+        return right;
+    }
+
+    /**
+     * @brief 将right连接到自身之后
+     * @details 要求自身的所有键不大于right的所有键，复杂度O(log n)
+     */
+    void join(rb_tree & right)
+    {
+        if (this == &right || right._root() == nullptr) {
+            return;
+        }
+        if (_root() == nullptr) {
+            swap(right);
+            return;
         }
 
-        // 直接替代并变色
-        if (parent == _head) {
-            // 删除的是根节点，需要移动root()
-            _root() = child;
-        } else if (_left(parent) == node) {
-            _left(parent) = child;
-        } else {
-            _right(parent) = child;
+        // 取出right的最小节点作为连接点
+        node_pointer k = right._leftmost();
+        right._rebalance_for_erase(k);
+        node_pointer r = right._root();
+        const size_type total = _size + right._size;
+        right._init_head();
+        right._size = 0;
+
+        node_pointer l = _root();
+        _init_head();
+        size_type bh = 0;
+        node_pointer root = _join(l, _black_height(l), k, r, _black_height(r), bh);
+        _install(root, total);
+    }
+
+    /**
+     * @brief 求并集，不允许重复
+     * @details 键相同时保留自身的元素，复杂度O(m log(n / m + 1))
+     */
+    void union_unique(rb_tree & other)
+    {
+        if (other._size * 32 < _size) {
+            // other很小时，拆分和连接访问的节点比逐个插入更多
+            _absorb_nodes<true>(other);
+            return;
+        }
+        _set_operation(other, &rb_tree::_union_unique);
+    }
+
+    /**
+     * @brief 求并集，允许重复
+     * @details 保留两棵树的所有元素
+     */
+    void union_equal(rb_tree & other)
+    {
+        if (other._size * 32 < _size) {
+            // other很小时，拆分和连接访问的节点比逐个插入更多
+            _absorb_nodes<false>(other);
+            return;
         }
+        _set_operation(other, &rb_tree::_union_equal);
+    }
 
-        _parent(child) = parent;
-        _color(child) = _black;         // 子节点一定是红变黑
+    /**
+     * @brief 求交集，不允许重复
+     * @details 保留自身中键也存在于other的元素，复杂度O(m log(n / m + 1))
+     */
+    void intersection_unique(rb_tree & other)
+    {
+        _set_operation(other, &rb_tree::_intersection_unique);
+    }
 
-        // 销毁当前节点
-        _destroy_node(node);
+    /**
+     * @brief 求交集，允许重复
+     * @details 按重复次数取较小值，与std::set_intersection一致，线性归并后重建，复杂度O(n + m)
+     */
+    void intersection_equal(rb_tree & other)
+    {
+        _merge_operation(other, true);
+    }
+
+    /**
+     * @brief 求差集，不允许重复
+     * @details 移除自身中键存在于other的元素，复杂度O(m log(n / m + 1))
+     */
+    void difference_unique(rb_tree & other)
+    {
+        _set_operation(other, &rb_tree::_difference_unique);
+    }
+
+    /**
+     * @brief 求差集，允许重复
+     * @details 按重复次数相减，与std::set_difference一致，线性归并后重建，复杂度O(n + m)
+     */
+    void difference_equal(rb_tree & other)
+    {
+        _merge_operation(other, false);
+    }
+
+    // 节点句柄
+    /**
+     * 以下操作直接摘下或链接节点，不分配、不构造也不销毁元素
+     * 节点只能在分配器相等的树之间移动
+     */
+
+    /**
+     * @brief 摘下pos指向的节点
+     */
+    node_type extract(const_iterator pos)
+    {
+        node_pointer node = pos._node;
+        _rebalance_for_erase(node);
         --_size;
-        return iterator(next._node);
+        return node_type(node, _node_allocator);
     }
 
     /**
-     * @brief 擦除元素
+     * @brief 摘下首个键等于key的节点，不存在时返回空句柄
      */
-    iterator erase(const_iterator first, const_iterator last)
+    node_type extract(const key_type & key)
     {
-        for (const_iterator it = first; it != last; ) {
-            it = erase(it);
+        node_pointer node = _find(key);
+        if (node == _head) {
+            return node_type();
         }
-        return iterator(last._node);
+        return extract(const_iterator(node));
     }
 
     /**
-     * @brief 擦除元素
+     * @brief 插入节点句柄，不允许重复
+     * @details 插入失败时节点仍由返回值中的node持有
      */
-    size_type erase(const key_type & key) {
-        size_type result = 0;
-        auto it = lower_bound(key);  // 查找第一个符合条件的元素
+    insert_return_type insert_unique(node_type && nh)
+    {
+        if (nh.empty()) {
+            return insert_return_type{end(), false, node_type()};
+        }
+        std::pair<iterator, bool> result = _insert_node_unique(nh._node);
+        if (!result.second) {
+            return insert_return_type{result.first, false, std::move(nh)};
+        }
+        nh._release();
+        return insert_return_type{result.first, true, node_type()};
+    }
 
-        while (it != end()) {
-            if (key == _get_key(it._node->_data)) {
-                // 找到匹配的元素，进行删除
-                it = erase(it);;  // 更新迭代器
-                ++result;
-            } else {
-                break;
-            }
+    /**
+     * @brief 插入节点句柄，允许重复
+     */
+    iterator insert_equal(node_type && nh)
+    {
+        if (nh.empty()) {
+            return end();
         }
+        return _insert_node_equal(nh._release());
+    }
 
-        return result;
+    /**
+     * @brief 根据提示插入节点句柄，不允许重复
+     * @details 插入失败时nh保持不变
+     */
+    iterator insert_hint_unique(const_iterator hint, node_type && nh)
+    {
+        if (nh.empty()) {
+            return end();
+        }
+        std::pair<iterator, bool> result = _insert_node_hint_unique(hint, nh._node);
+        if (result.second) {
+            nh._release();
+        }
+        return result.first;
+    }
+
+    /**
+     * @brief 根据提示插入节点句柄，允许重复
+     */
+    iterator insert_hint_equal(const_iterator hint, node_type && nh)
+    {
+        if (nh.empty()) {
+            return end();
+        }
+        return _insert_node_hint_equal(hint, nh._release());
     }
 
+    /**
+     * @brief 将other中键不存在于自身的节点移动到自身，不允许重复
+     * @details 键已存在的节点留在other中，比较器可以不同
+     */
+    template <class OtherCompare>
+    void merge_unique(rb_tree<Key, T, Value, ExtractKey, OtherCompare, Allocator, OrderStatistic, Interval, Balance> & other)
+    {
+        const_iterator it = other.begin();
+        while (it != other.end()) {
+            node_pointer cur = it._node;
+            ++it;
+            if (_find(_get_key(cur->_data)) == _head) {
+                other._rebalance_for_erase(cur);
+                --other._size;
+                _insert_node_unique(cur);
+            }
+        }
+    }
 
     /**
-     * @brief 交换内容
+     * @brief 将other的所有节点移动到自身，允许重复
      */
-    void swap(rb_tree & other)
+    template <class OtherCompare>
+    void merge_equal(rb_tree<Key, T, Value, ExtractKey, OtherCompare, Allocator, OrderStatistic, Interval, Balance> & other)
     {
-        std::swap(_head, other._head);
-        std::swap(_size, other._size);
-        std::swap(_comp, other._comp);
-        std::swap(_get_key, other._get_key);
-        if (std::allocator_traits<allocator_type>::propagate_on_container_swap::value) {
-            std::swap(_node_allocator, other._node_allocator);
+        if (static_cast<void *>(&other) == static_cast<void *>(this)) {
+            return;
+        }
+        node_pointer list = nullptr;
+        node_pointer tail = nullptr;
+        _flatten(other._root(), list, tail);
+        if (tail != nullptr) {
+            _right(tail) = nullptr;
+        }
+        other._init_head();
+        other._size = 0;
+
+        // 按顺序插入，相同键的节点保持在other中的先后顺序
+        while (list != nullptr) {
+            node_pointer next = _right(list);
+            _insert_node_hint_equal(end(), list);
+            list = next;
         }
     }
 
@@ -1019,8 +1345,7 @@ public:
     template <typename U = mapped_type, typename = typename std::enable_if<!std::is_void<U>::value>::type>
     U & operator[](const key_type & key)
     {
-        auto it = emplace_unique(std::make_pair(key, mapped_type()));
-        return it.first->second;
+        return try_emplace_unique(key).first->second;
     }
 
     /**
@@ -1029,32 +1354,79 @@ public:
     template <typename U = mapped_type, typename = typename std::enable_if<!std::is_void<U>::value>::type>
     U & operator[](key_type && key)
     {
-        auto it = emplace_unique(std::make_pair(std::move(key), mapped_type()));
-        return it.first->second;
+        return try_emplace_unique(std::move(key)).first->second;
     }
 
     /**
-     * @brief 返回匹配特定键的元素数量
+     * @brief 批量查找，依次将每个键的查找结果写入out，不存在时写入end()
+     * @details 每批交错地在树中下降，预取下一层的节点，使多个键的缓存缺失重叠
+     * @return 写入结束后的输出迭代器
      */
-    size_type count(const key_type & key) const
+    template <class ForwardIt, class OutputIt>
+    OutputIt find_many(ForwardIt first, ForwardIt last, OutputIt out)
     {
-        size_type result = 0;
-        auto lower = lower_bound(key);
-        auto upper = upper_bound(key);
-        for (auto it = lower; it != end() && it != upper; ++it) {
-            if (_get_key(it._node->_data) == key) {
-                ++result;
+        return _find_many<iterator>(first, last, out);
+    }
+
+    /**
+     * @brief 批量查找，依次将每个键的查找结果写入out，不存在时写入end()
+     */
+    template <class ForwardIt, class OutputIt>
+    OutputIt find_many(ForwardIt first, ForwardIt last, OutputIt out) const
+    {
+        return _find_many<const_iterator>(first, last, out);
+    }
+
+    /**
+     * @brief 批量计数，依次将匹配每个键的元素数量写入out
+     * @details 与find_many相同，交错下降找到每个键的lower_bound后再向后计数
+     * @return 写入结束后的输出迭代器
+     */
+    template <class ForwardIt, class OutputIt>
+    OutputIt count_many(ForwardIt first, ForwardIt last, OutputIt out) const
+    {
+        node_pointer lower[_lookup_batch];
+        while (first != last) {
+            ForwardIt batch_first = first;
+            const size_type n = _find_lower_many(first, last, lower);
+            for (size_type i = 0; i < n; ++i, ++batch_first) {
+                size_type result = 0;
+                const_iterator end_it(_head);
+                for (const_iterator it(lower[i]); it != end_it && !_comp(*batch_first, _get_key(*it)); ++it) {
+                    ++result;
+                }
+                *out = result;
+                ++out;
             }
         }
-        return result;
+        return out;
+    }
+
+    /**
+     * @brief 返回匹配特定键的元素数量
+     */
+    size_type count(const key_type & key) const
+    {
+        return _count_equal(key);
+    }
+
+    /**
+     * @brief 返回匹配特定键的元素数量
+     * @details 异构查找，要求比较器定义is_transparent，不需要构造临时的key_type
+     */
+    template <class K, class C = key_compare, class = typename C::is_transparent>
+    size_type count(const K & key) const
+    {
+        return _count_equal(key);
     }
 
     /**
      * @brief 寻找带有特定键的元素
+     * @details 找到时通知平衡策略，伸展树会把元素伸展到根
      */
     iterator find(const key_type & key)
     {
-        return iterator(_find(key));
+        return iterator(_access(_find(key)));
     }
 
     /**
@@ -1065,6 +1437,26 @@ public:
         return const_iterator(_find(key));
     }
 
+    /**
+     * @brief 寻找带有特定键的元素
+     * @details 异构查找，要求比较器定义is_transparent，不需要构造临时的key_type
+     */
+    template <class K, class C = key_compare, class = typename C::is_transparent>
+    iterator find(const K & key)
+    {
+        return iterator(_access(_find(key)));
+    }
+
+    /**
+     * @brief 寻找带有特定键的元素
+     * @details 异构查找，要求比较器定义is_transparent，不需要构造临时的key_type
+     */
+    template <class K, class C = key_compare, class = typename C::is_transparent>
+    const_iterator find(const K & key) const
+    {
+        return const_iterator(_find(key));
+    }
+
     /**
      * @brief 返回匹配特定键的元素范围
      */
@@ -1081,6 +1473,26 @@ public:
         return std::make_pair<const_iterator, const_iterator>(lower_bound(key), upper_bound(key));
     }
 
+    /**
+     * @brief 返回匹配特定键的元素范围
+     * @details 异构查找，要求比较器定义is_transparent，不需要构造临时的key_type
+     */
+    template <class K, class C = key_compare, class = typename C::is_transparent>
+    std::pair<iterator, iterator> equal_range(const K & key)
+    {
+        return std::make_pair<iterator, iterator>(iterator(_find_lower(key)), iterator(_find_upper(key)));
+    }
+
+    /**
+     * @brief 返回匹配特定键的元素范围
+     * @details 异构查找，要求比较器定义is_transparent，不需要构造临时的key_type
+     */
+    template <class K, class C = key_compare, class = typename C::is_transparent>
+    std::pair<const_iterator, const_iterator> equal_range(const K & key) const
+    {
+        return std::make_pair<const_iterator, const_iterator>(const_iterator(_find_lower(key)), const_iterator(_find_upper(key)));
+    }
+
     /**
      * @brief 返回指向首个不小于给定键的元素的迭代器
      */
@@ -1097,6 +1509,26 @@ public:
         return const_iterator(_find_lower(key));
     }
 
+    /**
+     * @brief 返回指向首个不小于给定键的元素的迭代器
+     * @details 异构查找，要求比较器定义is_transparent，不需要构造临时的key_type
+     */
+    template <class K, class C = key_compare, class = typename C::is_transparent>
+    iterator lower_bound(const K & key)
+    {
+        return iterator(_find_lower(key));
+    }
+
+    /**
+     * @brief 返回指向首个不小于给定键的元素的迭代器
+     * @details 异构查找，要求比较器定义is_transparent，不需要构造临时的key_type
+     */
+    template <class K, class C = key_compare, class = typename C::is_transparent>
+    const_iterator lower_bound(const K & key) const
+    {
+        return const_iterator(_find_lower(key));
+    }
+
     /**
      * @brief 返回指向首个大于给定键的元素的迭代器
      */
@@ -1113,101 +1545,366 @@ public:
         return const_iterator(_find_upper(key));
     }
 
-public:
     /**
-     * @brief 获取根节点
+     * @brief 返回指向首个大于给定键的元素的迭代器
+     * @details 异构查找，要求比较器定义is_transparent，不需要构造临时的key_type
      */
-    node_pointer & _root() const
+    template <class K, class C = key_compare, class = typename C::is_transparent>
+    iterator upper_bound(const K & key)
     {
-        return _head->_parent;
+        return iterator(_find_upper(key));
     }
 
     /**
-     * @brief 获取最小的节点
+     * @brief 返回指向首个大于给定键的元素的迭代器
+     * @details 异构查找，要求比较器定义is_transparent，不需要构造临时的key_type
      */
-    node_pointer & _leftmost() const
+    template <class K, class C = key_compare, class = typename C::is_transparent>
+    const_iterator upper_bound(const K & key) const
     {
-        return _head->_left;
+        return const_iterator(_find_upper(key));
     }
 
     /**
-     * @brief 获取最大的节点
+     * @brief 从pos向后查找首个不小于给定键的元素，结果与lower_bound(key)相同
+     * @details 要求pos不在lower_bound(key)之后，从pos所在节点向上走到覆盖key的子树再向下，
+     *          复杂度O(log d)，d为pos与结果之间的元素数，适合按顺序查找有序的键序列
      */
-    node_pointer & _rightmost() const
+    iterator seek_forward(const_iterator pos, const key_type & key)
     {
-        return _head->_right;
+        return iterator(_seek_lower(pos._node, key));
     }
 
     /**
-     * @brief 获取节点x的父节点
+     * @brief 从pos向后查找首个不小于给定键的元素，结果与lower_bound(key)相同
+     * @details 要求pos不在lower_bound(key)之后，复杂度O(log d)，d为pos与结果之间的元素数
      */
-    static node_pointer & _parent(const node_pointer x)
+    const_iterator seek_forward(const_iterator pos, const key_type & key) const
     {
-        return x->_parent;
+        return const_iterator(_seek_lower(pos._node, key));
     }
 
+    // 顺序统计
     /**
-     * @brief 获取节点x的左子节点
+     * 以下操作要求OrderStatistic为true
      */
-    static node_pointer & _left(const node_pointer x)
-    {
-        return x->_left;
-    }
 
     /**
-     * @brief 获取节点x的右子节点
+     * @brief 返回小于给定键的元素个数，即lower_bound(key)的下标
+     * @details 复杂度O(log n)
      */
-    static node_pointer & _right(const node_pointer x)
+    size_type rank(const key_type & key) const
     {
-        return x->_right;
+        static_assert(OrderStatistic, "rank requires OrderStatistic");
+        return _rank(key);
     }
 
     /**
-     * @brief 获取节点x的值
+     * @brief 返回下标为n的元素的迭代器，n不小于size()时返回end()
+     * @details 复杂度O(log n)
      */
-    static reference _data(const node_pointer x)    
+    iterator nth(size_type n)
     {
-        return x->_data;
+        return iterator(_find_nth(n));
     }
 
     /**
-     * @brief 获取节点x的键
+     * @brief 返回下标为n的元素的迭代器，n不小于size()时返回end()
+     * @details 复杂度O(log n)
      */
-    static const key_type & _key(const node_pointer x)
+    const_iterator nth(size_type n) const
     {
-        return key_extractor()(_data(x));
+        return const_iterator(_find_nth(n));
     }
 
     /**
-     * @brief 获取节点x的颜色
+     * @brief 返回键在[lo, hi)范围内的元素个数
+     * @details 复杂度O(log n)
      */
-    static color_type & _color(const node_pointer x)
+    size_type count_range(const key_type & lo, const key_type & hi) const
     {
-        return x->_color;
+        static_assert(OrderStatistic, "count_range requires OrderStatistic");
+        if (!_comp(lo, hi)) {
+            return 0;
+        }
+        return _rank(hi) - _rank(lo);
     }
 
+    // 区间查询
     /**
-     * @brief 获取节点x子节点中的最小节点
+     * 以下操作要求Interval为true，区间都是左闭右开的
      */
-    static node_pointer _minimum(node_pointer x)
+
+    /**
+     * @brief 检查是否有元素与[lo, hi)重叠
+     * @details 复杂度O(log n)
+     */
+    template <class B>
+    bool overlaps(const B & lo, const B & hi) const
     {
-        return node::minimum(x);
+        static_assert(Interval, "overlaps requires Interval");
+        return _find_any_overlapping(lo, hi) != _head;
     }
 
     /**
-     * @brief 获取节点x子节点中的最大节点
+     * @brief 将与[lo, hi)重叠的元素的迭代器按顺序写入out
+     * @details 子树的最大上界不大于lo时整棵子树被跳过，复杂度O(min(n, (k + 1) log n))，k为结果个数
      */
-    static node_pointer _maximum(node_pointer x)
+    template <class B, class OutputIt>
+    OutputIt find_overlapping(const B & lo, const B & hi, OutputIt out)
     {
-        return node::maximum(x);
+        static_assert(Interval, "find_overlapping requires Interval");
+        return _find_overlapping<iterator>(_root(), lo, hi, false, out);
     }
 
     /**
-     * @brief 申请一个节点的空间
+     * @brief 将与[lo, hi)重叠的元素的迭代器按顺序写入out
      */
-    node_pointer _get_node()
+    template <class B, class OutputIt>
+    OutputIt find_overlapping(const B & lo, const B & hi, OutputIt out) const
     {
-        return _node_allocator.allocate(1);
+        static_assert(Interval, "find_overlapping requires Interval");
+        return _find_overlapping<const_iterator>(_root(), lo, hi, false, out);
+    }
+
+    /**
+     * @brief 将包含点point的元素的迭代器按顺序写入out
+     * @details 即下界不大于point且上界大于point的区间
+     */
+    template <class B, class OutputIt>
+    OutputIt find_containing(const B & point, OutputIt out)
+    {
+        static_assert(Interval, "find_containing requires Interval");
+        return _find_overlapping<iterator>(_root(), point, point, true, out);
+    }
+
+    /**
+     * @brief 将包含点point的元素的迭代器按顺序写入out
+     */
+    template <class B, class OutputIt>
+    OutputIt find_containing(const B & point, OutputIt out) const
+    {
+        static_assert(Interval, "find_containing requires Interval");
+        return _find_overlapping<const_iterator>(_root(), point, point, true, out);
+    }
+
+public:
+    /**
+     * @brief 获取根节点
+     */
+    node_pointer _root() const
+    {
+        return _head->parent();
+    }
+
+    /**
+     * @brief 设置根节点
+     */
+    void _set_root(node_pointer x)
+    {
+        _head->set_parent(x);
+    }
+
+    /**
+     * @brief 获取最小的节点
+     */
+    node_pointer & _leftmost() const
+    {
+        return _head->_left;
+    }
+
+    /**
+     * @brief 获取最大的节点
+     */
+    node_pointer & _rightmost() const
+    {
+        return _head->_right;
+    }
+
+    /**
+     * @brief 获取节点x的父节点
+     */
+    static node_pointer _parent(const node_pointer x)
+    {
+        return x->parent();
+    }
+
+    /**
+     * @brief 设置节点x的父节点
+     */
+    static void _set_parent(const node_pointer x, node_pointer p)
+    {
+        x->set_parent(p);
+    }
+
+    /**
+     * @brief 获取节点x的左子节点
+     */
+    static node_pointer & _left(const node_pointer x)
+    {
+        return x->_left;
+    }
+
+    /**
+     * @brief 获取节点x的右子节点
+     */
+    static node_pointer & _right(const node_pointer x)
+    {
+        return x->_right;
+    }
+
+    /**
+     * @brief 获取节点x的值
+     */
+    static reference _data(const node_pointer x)    
+    {
+        return x->_data;
+    }
+
+    /**
+     * @brief 获取节点x的键
+     */
+    static const key_type & _key(const node_pointer x)
+    {
+        return key_extractor()(_data(x));
+    }
+
+    /**
+     * @brief 获取节点x的颜色
+     */
+    static color_type _color(const node_pointer x)
+    {
+        return x->color();
+    }
+
+    /**
+     * @brief 设置节点x的颜色
+     */
+    static void _set_color(const node_pointer x, color_type color)
+    {
+        x->set_color(color);
+    }
+
+    /**
+     * @brief 判断节点x是否为黑色，空节点视为黑色
+     */
+    static bool _is_black(const node_pointer x)
+    {
+        return x == nullptr || x->color() == _black;
+    }
+
+    /**
+     * @brief 获取以x为根的子树大小，空节点为0
+     * @details 只在启用顺序统计时有意义
+     */
+    static size_type _count(const node_pointer x)
+    {
+        return x == nullptr ? 0 : x->count();
+    }
+
+    /**
+     * @brief 根据子节点重新计算x的子树大小
+     */
+    static void _update_count(node_pointer x)
+    {
+        if (OrderStatistic) {
+            x->set_count(_count(_left(x)) + _count(_right(x)) + 1);
+        }
+    }
+
+    /**
+     * @brief 将从x到根节点路径上的子树大小加上n
+     */
+    void _increase_count(node_pointer x, size_type n)
+    {
+        if (OrderStatistic) {
+            for (; x != _head; x = _parent(x)) {
+                x->set_count(x->count() + n);
+            }
+        }
+    }
+
+    /**
+     * @brief 将从x到根节点路径上的子树大小减去n
+     */
+    void _decrease_count(node_pointer x, size_type n)
+    {
+        if (OrderStatistic) {
+            for (; x != _head; x = _parent(x)) {
+                x->set_count(x->count() - n);
+            }
+        }
+    }
+
+    /**
+     * @brief 根据x的区间和子节点重新计算x的子树最大上界
+     * @details 只在启用区间增强时有效
+     */
+    void _update_high(node_pointer x)
+    {
+        _update_high(x, std::integral_constant<bool, Interval>());
+    }
+
+    void _update_high(node_pointer, std::false_type)
+    {
+    }
+
+    void _update_high(node_pointer x, std::true_type)
+    {
+        x->_high = _get_key(x->_data).second;
+        if (_left(x) != nullptr && _comp.bound_less(x->_high, _left(x)->_high)) {
+            x->_high = _left(x)->_high;
+        }
+        if (_right(x) != nullptr && _comp.bound_less(x->_high, _right(x)->_high)) {
+            x->_high = _right(x)->_high;
+        }
+    }
+
+    /**
+     * @brief 重新计算从x到根节点路径上的子树最大上界
+     */
+    void _update_high_path(node_pointer x)
+    {
+        if (Interval) {
+            for (; x != _head; x = _parent(x)) {
+                _update_high(x);
+            }
+        }
+    }
+
+    /**
+     * @brief 查找到节点x后通知平衡策略，x为head时不做处理
+     */
+    node_pointer _access(node_pointer x)
+    {
+        if (x != _head) {
+            Balance::access(*this, x);
+        }
+        return x;
+    }
+
+    /**
+     * @brief 获取节点x子节点中的最小节点
+     */
+    static node_pointer _minimum(node_pointer x)
+    {
+        return node::minimum(x);
+    }
+
+    /**
+     * @brief 获取节点x子节点中的最大节点
+     */
+    static node_pointer _maximum(node_pointer x)
+    {
+        return node::maximum(x);
+    }
+
+    /**
+     * @brief 申请一个节点的空间
+     */
+    node_pointer _get_node()
+    {
+        return _node_allocator.allocate(1);
     }
 
     /**
@@ -1244,7 +1941,7 @@ public:
      */
     void _init_head()
     {
-        _root() = nullptr;          // 初始根节点为空，直到插入第一个节点
+        _set_root(nullptr);         // 初始根节点为空，直到插入第一个节点
         _leftmost() = _head;
         _rightmost() = _head;
     }
@@ -1259,16 +1956,24 @@ public:
     }
 
     /**
-     * @brief 后序遍历销毁二叉树
+     * @brief 销毁二叉树
      */
     void _destroy_rb_tree(node_pointer p)
     {
-        if (p == nullptr)
-            return;
-        
-        _destroy_rb_tree(p->_left);
-        _destroy_rb_tree(p->_right);
-        _destroy_node(p);
+        // 有左子节点时右旋，把左子树转到右侧，否则销毁当前节点并进入右子树
+        // 不需要递归，伸展树等可能很深的树也不会耗尽栈空间
+        while (p != nullptr) {
+            node_pointer left = _left(p);
+            if (left != nullptr) {
+                _left(p) = _right(left);
+                _right(left) = p;
+                p = left;
+            } else {
+                node_pointer right = _right(p);
+                _destroy_node(p);
+                p = right;
+            }
+        }
     }
 
     /**
@@ -1276,29 +1981,37 @@ public:
      */
     void _left_rotate(node_pointer x)
     {
-        node_pointer parent = x->_parent;           // 父节点
-        node_pointer right = x->_right;             // 右子节点
-        node_pointer right_left = right->_left;     // 右子节点的左子节点
+        node_pointer parent = _parent(x);           // 父节点
+        node_pointer right = _right(x);             // 右子节点
+        node_pointer right_left = _left(right);     // 右子节点的左子节点
 
         // 右子节点的左子树成为x的右子树
-        x->_right = right_left;
+        _right(x) = right_left;
         if (right_left != nullptr) {
-            right_left->_parent = x;
+            _set_parent(right_left, x);
         }
 
         // x成为右子节点的左子节点
-        right->_left = x;
-        x->_parent = right;
+        _left(right) = x;
+        _set_parent(x, right);
+
+        // 右子节点接替x的位置，子树大小和最大上界不变，x的重新计算
+        if (OrderStatistic) {
+            right->set_count(x->count());
+            _update_count(x);
+        }
+        right->copy_high(*x);
+        _update_high(x);
 
         // 更新父节点
-        right->_parent = parent;
+        _set_parent(right, parent);
         if (parent == _head) {
             // 说明x原来是根节点
-            _root() = right;
-        } else if (parent->_left == x) {
-            parent->_left = right;
+            _set_root(right);
+        } else if (_left(parent) == x) {
+            _left(parent) = right;
         } else {
-            parent->_right = right;
+            _right(parent) = right;
         }
     }
 
@@ -1307,36 +2020,45 @@ public:
      */
     void _right_rotate(node_pointer x)
     {
-        node_pointer parent = x->_parent;           // 父节点
-        node_pointer left = x->_left;               // 左子节点
-        node_pointer left_right = left->_right;     // 左子节点的右子节点
+        node_pointer parent = _parent(x);           // 父节点
+        node_pointer left = _left(x);               // 左子节点
+        node_pointer left_right = _right(left);     // 左子节点的右子节点
 
         // 左子节点的右子树成为x的左子树
-        x->_left = left_right;
+        _left(x) = left_right;
         if (left_right != nullptr) {
-            left_right->_parent = x;
+            _set_parent(left_right, x);
         }
 
         // x成为左子节点的右子节点
-        left->_right = x;
-        x->_parent = left;
+        _right(left) = x;
+        _set_parent(x, left);
+
+        // 左子节点接替x的位置，子树大小和最大上界不变，x的重新计算
+        if (OrderStatistic) {
+            left->set_count(x->count());
+            _update_count(x);
+        }
+        left->copy_high(*x);
+        _update_high(x);
 
         // 更新父节点
-        left->_parent = parent;
+        _set_parent(left, parent);
         if (parent == _head) {
             // 说明x原来是根节点
-            _root() = left;
-        } else if (parent->_left == x) {
-            parent->_left = left;
+            _set_root(left);
+        } else if (_left(parent) == x) {
+            _left(parent) = left;
         } else {
-            parent->_right = left;
+            _right(parent) = left;
         }
     }
 
     /**
      * @brief 在插入节点p后重新平衡
+     * @return 根节点是否由红变黑，即树的黑高是否增加
      */
-    void _rebalance(node_pointer new_node)
+    bool _rebalance(node_pointer new_node)
     {
         /** 
          * 当红黑树的性质被破坏时，需要调整，共有两种情况
@@ -1346,61 +2068,63 @@ public:
 
         if (new_node == _root()) {
             // 违反了根节点为黑色的性质
-            _color(new_node) = _black;
-            return;
+            _set_color(new_node, _black);
+            return true;
         }
 
-        if (new_node->_parent->_color == _black) {
+        if (_color(_parent(new_node)) == _black) {
             // 不违反性质
-            return;
+            return false;
         }
 
         // 违反了红黑树的不红红性质，需要调整
         node_pointer cur = new_node;
         node_pointer uncle = nullptr;
-        while (cur != _root() && cur->_parent->_color == _red) {
+        while (cur != _root() && _color(_parent(cur)) == _red) {
+            node_pointer parent = _parent(cur);
+            node_pointer grandparent = _parent(parent);
             // 找到叔叔节点
-            if (cur->_parent == cur->_parent->_parent->_left) {
-                uncle = cur->_parent->_parent->_right;
+            if (parent == _left(grandparent)) {
+                uncle = _right(grandparent);
             } else {
-                uncle = cur->_parent->_parent->_left;
+                uncle = _left(grandparent);
             }
             // 查看叔叔节点的颜色
-            if (uncle != nullptr && uncle->_color == _red) {
+            if (uncle != nullptr && _color(uncle) == _red) {
                 // 叔叔是红色，需要修改父亲、叔叔、爷爷的颜色，然后移动cur到爷爷，继续循环
                 // 因为如果new_node违反了性质，那么父亲一定是红色，爷爷一定是黑色，变色后爷爷变成了红色，while判断条件还是一样的
-                uncle->_color = _black;                 // 叔叔变成黑色
-                cur->_parent->_color = _black;          // 父亲变成黑色
-                cur->_parent->_parent->_color = _red;   // 爷爷变成红色
-                cur = cur->_parent->_parent;            // 移动到爷爷
+                _set_color(uncle, _black);              // 叔叔变成黑色
+                _set_color(parent, _black);             // 父亲变成黑色
+                _set_color(grandparent, _red);          // 爷爷变成红色
+                cur = grandparent;                      // 移动到爷爷
                 // 爷爷由黑变红，可能违反性质，继续循环
             } else {
                 // 不存在叔叔节点或叔叔是黑色，需要根据形状判断是LL，RR，LR还是RL
-                if (cur->_parent->_left == cur) {
-                    if (cur->_parent->_parent->_left == cur->_parent) {
+                if (_left(parent) == cur) {
+                    if (_left(grandparent) == parent) {
                         // LL情况，直接将爷爷节点右旋
-                        cur->_parent->_color = _black;          // 父亲节点变为黑色
-                        cur->_parent->_parent->_color = _red;   // 爷爷节点变为红色
-                        _right_rotate(cur->_parent->_parent);   // 右旋爷爷节点
+                        _set_color(parent, _black);     // 父亲节点变为黑色
+                        _set_color(grandparent, _red);  // 爷爷节点变为红色
+                        _right_rotate(grandparent);     // 右旋爷爷节点
                     } else {
-                        // RL情况，先左旋父亲节点，再右旋爷爷节点
-                        cur->_color = _black;                   // cur节点变为黑色
-                        cur->_parent->_parent->_color = _red;   // 爷爷节点变为红色
-                        _right_rotate(cur->_parent);            // 右旋父亲节点，变成RR情况
-                        _left_rotate(cur->_parent);             // 左旋爷爷节点，此时cur已经旋转成为了爷爷节点的右子节点
+                        // RL情况，先右旋父亲节点，再左旋爷爷节点
+                        _set_color(cur, _black);        // cur节点变为黑色
+                        _set_color(grandparent, _red);  // 爷爷节点变为红色
+                        _right_rotate(parent);          // 右旋父亲节点，变成RR情况
+                        _left_rotate(grandparent);      // 左旋爷爷节点，此时cur已经旋转成为了爷爷节点的父节点
                     }
                 } else {
-                    if (cur->_parent->_parent->_right == cur->_parent) {
+                    if (_right(grandparent) == parent) {
                         // RR情况，直接将爷爷节点左旋
-                        cur->_parent->_color = _black;          // 父亲节点变为黑色
-                        cur->_parent->_parent->_color = _red;   // 爷爷节点变为红色
-                        _left_rotate(cur->_parent->_parent);    // 左旋爷爷节点
+                        _set_color(parent, _black);     // 父亲节点变为黑色
+                        _set_color(grandparent, _red);  // 爷爷节点变为红色
+                        _left_rotate(grandparent);      // 左旋爷爷节点
                     } else {
-                        // LR情况，先右旋父亲节点，再左旋爷爷节点
-                        cur->_color = _black;                   // cur节点变为黑色
-                        cur->_parent->_parent->_color = _red;   // 爷爷节点变为红色
-                        _left_rotate(cur->_parent);             // 左旋父亲节点，变成LL情况
-                        _right_rotate(cur->_parent);            // 右旋爷爷节点，此时cur已经旋转成为了爷爷节点的左子节点
+                        // LR情况，先左旋父亲节点，再右旋爷爷节点
+                        _set_color(cur, _black);        // cur节点变为黑色
+                        _set_color(grandparent, _red);  // 爷爷节点变为红色
+                        _left_rotate(parent);           // 左旋父亲节点，变成LL情况
+                        _right_rotate(grandparent);     // 右旋爷爷节点，此时cur已经旋转成为了爷爷节点的父节点
                     }
                 }
                 break;  // 旋转后一定会满足性质，不需要再循环了
@@ -1408,28 +2132,193 @@ public:
         }
 
         // 保证根节点是黑色的，保护了违反性质且叔叔为红的情况下，移动到根节点后的变化
-        _color(_root()) = _black;
+        const bool grew = _color(_root()) == _red;
+        _set_color(_root(), _black);
+        return grew;
+    }
+
+    /**
+     * @brief 将节点z从树中摘下并重新平衡
+     * @details 不销毁节点，也不修改节点个数
+     */
+    void _rebalance_for_erase(node_pointer z)
+    {
+        /**
+         * 在红黑树的删除中，可以分为两大类情况
+         * 1. 删除的节点有两个子节点，用它的直接后继y替换z的位置和颜色，转化为摘下y原来的位置
+         * 2. 删除的节点至多有一个子节点，直接用子节点x替代它
+         * 被摘下的位置如果是黑色，x所在的路径少了一个黑节点，需要通过变色和旋转修复
+         */
+        node_pointer y = z;             // 实际从原位置摘下的节点
+        node_pointer x = nullptr;       // 替代y位置的子节点，可能为空
+        node_pointer x_parent = nullptr;
+
+        if (_left(y) == nullptr) {
+            x = _right(y);
+        } else if (_right(y) == nullptr) {
+            x = _left(y);
+        } else {
+            y = _minimum(_right(y));
+            x = _right(y);
+        }
+
+        // y从原位置摘下，其祖先的子树大小都减一，包括y != z时的z
+        _decrease_count(_parent(y), 1);
+
+        if (y != z) {
+            // 1. 有两个子节点，交换节点而不是交换值，保证其他迭代器不失效
+            _set_parent(_left(z), y);
+            _left(y) = _left(z);
+            if (y != _right(z)) {
+                x_parent = _parent(y);
+                if (x != nullptr) {
+                    _set_parent(x, x_parent);
+                }
+                _left(x_parent) = x;    // 直接后继一定是其父节点的左子节点
+                _right(y) = _right(z);
+                _set_parent(_right(z), y);
+            } else {
+                x_parent = y;
+            }
+
+            if (_root() == z) {
+                _set_root(y);
+            } else if (_left(_parent(z)) == z) {
+                _left(_parent(z)) = y;
+            } else {
+                _right(_parent(z)) = y;
+            }
+            _set_parent(y, _parent(z));
+
+            // y继承z的子树大小，平衡信息的交接由平衡策略决定
+            if (OrderStatistic) {
+                y->set_count(z->count());
+            }
+            Balance::replace(y, z);
+            // z有两个子节点，一定不是最小或最大节点
+        } else {
+            // 2. 至多有一个子节点
+            x_parent = _parent(z);
+            if (x != nullptr) {
+                _set_parent(x, x_parent);
+            }
+
+            if (_root() == z) {
+                _set_root(x);
+            } else if (_left(x_parent) == z) {
+                _left(x_parent) = x;
+            } else {
+                _right(x_parent) = x;
+            }
+
+            // 调整leftmost和rightmost，删除最后一个节点时恢复为head
+            if (_leftmost() == z) {
+                _leftmost() = _right(z) == nullptr ? x_parent : _minimum(x);
+            }
+            if (_rightmost() == z) {
+                _rightmost() = _left(z) == nullptr ? x_parent : _maximum(x);
+            }
+        }
+
+        // 摘下位置以上的最大上界可能变小，x_parent到根节点的路径覆盖了所有受影响的节点
+        _update_high_path(x_parent);
+
+        Balance::erase_fixup(*this, z, x, x_parent);
+    }
+
+    /**
+     * @brief 红黑树摘下节点后的修复
+     * @param z 被摘下的节点，颜色为被摘下位置的颜色
+     * @param x 替代被摘下位置的子节点，可能为空
+     * @param x_parent x的父节点
+     */
+    void _rebalance_after_erase(node_pointer z, node_pointer x, node_pointer x_parent)
+    {
+        if (_color(z) == _red) {
+            // 摘下的是红色，不破坏红黑树的性质
+            return;
+        }
+
+        // 摘下的是黑色，x成为双黑节点，向上调整直到x为红色或者到达根节点
+        while (x != _root() && _is_black(x)) {
+            if (x == _left(x_parent)) {
+                node_pointer sibling = _right(x_parent);
+                if (_color(sibling) == _red) {
+                    // 兄弟节点是红色，将父节点向双黑节点方向旋转，转化为兄弟节点为黑色的情况
+                    _set_color(sibling, _black);
+                    _set_color(x_parent, _red);
+                    _left_rotate(x_parent);
+                    sibling = _right(x_parent);
+                }
+                if (_is_black(_left(sibling)) && _is_black(_right(sibling))) {
+                    // 兄弟节点的孩子都是黑色，兄弟变红，双黑上移
+                    _set_color(sibling, _red);
+                    x = x_parent;
+                    x_parent = _parent(x_parent);
+                } else {
+                    if (_is_black(_right(sibling))) {
+                        // RL情况，先右旋兄弟节点，转化为RR情况
+                        _set_color(_left(sibling), _black);
+                        _set_color(sibling, _red);
+                        _right_rotate(sibling);
+                        sibling = _right(x_parent);
+                    }
+                    // RR情况，兄弟继承父节点的颜色，左旋父节点
+                    _set_color(sibling, _color(x_parent));
+                    _set_color(x_parent, _black);
+                    _set_color(_right(sibling), _black);
+                    _left_rotate(x_parent);
+                    break;
+                }
+            } else {
+                node_pointer sibling = _left(x_parent);
+                if (_color(sibling) == _red) {
+                    _set_color(sibling, _black);
+                    _set_color(x_parent, _red);
+                    _right_rotate(x_parent);
+                    sibling = _left(x_parent);
+                }
+                if (_is_black(_right(sibling)) && _is_black(_left(sibling))) {
+                    _set_color(sibling, _red);
+                    x = x_parent;
+                    x_parent = _parent(x_parent);
+                } else {
+                    if (_is_black(_left(sibling))) {
+                        // LR情况，先左旋兄弟节点，转化为LL情况
+                        _set_color(_right(sibling), _black);
+                        _set_color(sibling, _red);
+                        _left_rotate(sibling);
+                        sibling = _left(x_parent);
+                    }
+                    // LL情况，兄弟继承父节点的颜色，右旋父节点
+                    _set_color(sibling, _color(x_parent));
+                    _set_color(x_parent, _black);
+                    _set_color(_left(sibling), _black);
+                    _right_rotate(x_parent);
+                    break;
+                }
+            }
+        }
+        if (x != nullptr) {
+            _set_color(x, _black);
+        }
     }
 
     /**
-     * @brief 在parent处插入节点
-     * @details new_node于emplace_xxx中临时创建，直接移动
+     * @brief 将节点链接为parent的左子节点或右子节点，并重新平衡
+     * @param parent 父节点，为nullptr时表示插入根节点
+     * @param insert_left 是否插入为左子节点
      */
-    iterator _emplace(node_pointer parent, node_pointer && new_node)
+    iterator _link_node(node_pointer parent, node_pointer new_node, bool insert_left)
     {
-        // 由于已经找到了插入位置，只需要处理边界情况
         if (parent == nullptr) {
             // 说明还没有根节点，new_node将成为根节点
             parent = _head;
-            _root() = new_node;
-        }
-
-        // 处理需要修改最小和最大节点的情况
-        if (parent == _head) {
+            _set_root(new_node);
             // 根节点，直接设置最小和最大节点，相当于设置了head的左右子节点
             _leftmost() = new_node;
             _rightmost() = new_node;
-        } else if (_comp(_get_key(new_node->_data), _get_key(parent->_data))) {
+        } else if (insert_left) {
             // 新节点小于原父节点
             _left(parent) = new_node;
             if (parent == _leftmost()) {
@@ -1446,53 +2335,533 @@ public:
         }
 
         // 设置新节点
-        _parent(new_node) = parent;
+        _set_parent(new_node, parent);
         _left(new_node) = nullptr;
         _right(new_node) = nullptr;
-        // 注意新节点默认已经为红色
+        // 不使用颜色的平衡策略下新节点为黑色，根节点经旋转更替后也不会被误认为头节点
+        _set_color(new_node, Balance::colored ? _red : _black);
+        _update_count(new_node);
+        _increase_count(parent, 1);
+        _update_high_path(new_node);
 
-        // 重新平衡红黑树
-        _rebalance(new_node);
+        // 按平衡策略重新平衡
+        Balance::insert_fixup(*this, new_node);
 
         ++_size;
         return iterator(new_node);
     }
 
     /**
-     * @brief 查找特定键的元素
+     * @brief 插入已创建的节点，不允许重复
+     * @details 插入失败时不销毁节点，由调用者处理
+     */
+    std::pair<iterator, bool> _insert_node_unique(node_pointer new_node)
+    {
+        bool insert_left = true;
+        std::pair<node_pointer, bool> pos = _find_insert_unique_pos(_get_key(new_node->_data), insert_left);
+        if (!pos.second) {
+            // 重复，插入失败
+            return std::pair<iterator, bool>(iterator(pos.first), false);
+        }
+        // 查找结束，在parent的位置插入
+        return std::pair<iterator, bool>(_link_node(pos.first, new_node, insert_left), true);
+    }
+
+    /**
+     * @brief 查找不允许重复时key的插入位置
+     * @details 键已存在时返回该节点和false；否则返回父节点和true，insert_left记录插入到父节点的哪一侧
      */
-    node_pointer _find(const key_type & key) const
+    template <class K>
+    std::pair<node_pointer, bool> _find_insert_unique_pos(const K & key, bool & insert_left) const
     {
+        node_pointer parent = nullptr;      // 记录cur的父节点
         node_pointer cur = _root();
-        // 从根节点开始查找
+        insert_left = true;
         while (cur != nullptr) {
+            parent = cur;
             if (_comp(_get_key(cur->_data), key)) {
                 // 当前节点的键小于目标key，向右寻找
                 cur = _right(cur);
+                insert_left = false;
             } else if (_comp(key, _get_key(cur->_data))) {
                 // 当前节点的键大于目标key，向左寻找
                 cur = _left(cur);
+                insert_left = true;
             } else {
-                // 返回找到的节点
-                return cur;
+                // 重复
+                return std::pair<node_pointer, bool>(cur, false);
             }
         }
-        // 如果是nullptr，则返回_head表示末尾
-        return _head;
+        return std::pair<node_pointer, bool>(parent, true);
     }
 
     /**
-     * @brief 查找不小于特定键的最大节点
+     * @brief 从参数中可以直接取得键，先查找再构造
      */
-    node_pointer _find_lower(const key_type & key) const
+    template <class... Args>
+    std::pair<iterator, bool> _emplace_unique(std::true_type, Args&&... args)
     {
-        node_pointer cur = _root();
-        node_pointer result = _head;
-        while (cur != nullptr) {
-            if (_comp(_get_key(cur->_data), key)) {
-                // key小于当前节点，向右查找
-                cur = _right(cur);
-            } else {
+        return _emplace_unique_key(_emplace_key_of<key_type>(std::is_void<mapped_type>(), args...), std::forward<Args>(args)...);
+    }
+
+    /**
+     * @brief 无法直接取得键，先构造节点再插入，重复时销毁节点
+     */
+    template <class... Args>
+    std::pair<iterator, bool> _emplace_unique(std::false_type, Args&&... args)
+    {
+        node_pointer new_node = _create_node(std::forward<Args>(args)...);
+        std::pair<iterator, bool> result = _insert_node_unique(new_node);
+        if (!result.second) {
+            // 重复，插入失败
+            _destroy_node(new_node);
+        }
+        return result;
+    }
+
+    /**
+     * @brief 以键查找插入位置，不存在时才以args构造节点并链接
+     * @details key可能引用args中的对象，构造节点之后不能再使用key
+     */
+    template <class K, class... Args>
+    std::pair<iterator, bool> _emplace_unique_key(const K & key, Args&&... args)
+    {
+        bool insert_left = true;
+        std::pair<node_pointer, bool> pos = _find_insert_unique_pos(key, insert_left);
+        if (!pos.second) {
+            // 键已存在，不分配节点
+            return std::pair<iterator, bool>(iterator(pos.first), false);
+        }
+        node_pointer new_node = _create_node(std::forward<Args>(args)...);
+        return std::pair<iterator, bool>(_link_node(pos.first, new_node, insert_left), true);
+    }
+
+    /**
+     * @brief 插入已创建的节点，允许重复
+     */
+    iterator _insert_node_equal(node_pointer new_node)
+    {
+        const key_type & key = _get_key(new_node->_data);
+        node_pointer parent = nullptr;      // 记录cur的父节点
+        node_pointer cur = _root();
+        bool insert_left = true;            // 记录插入到parent的哪一侧
+        // 查找插入位置
+        while (cur != nullptr) {
+            parent = cur;
+            insert_left = _comp(key, _get_key(cur->_data));
+            // 目标key小于当前节点的键，向左寻找，否则向右寻找
+            cur = insert_left ? _left(cur) : _right(cur);
+        }
+        // 查找结束，在parent的位置插入
+        return _link_node(parent, new_node, insert_left);
+    }
+
+    /**
+     * @brief 根据提示插入已创建的节点，不允许重复
+     * @details 插入失败时不销毁节点，返回阻碍插入的节点
+     */
+    std::pair<iterator, bool> _insert_node_hint_unique(const_iterator hint, node_pointer new_node)
+    {
+        bool insert_left = true;
+        std::pair<node_pointer, bool> pos = _find_hint_unique_pos(hint, _get_key(new_node->_data), insert_left);
+        if (!pos.second) {
+            // 重复，插入失败
+            return std::pair<iterator, bool>(iterator(pos.first), false);
+        }
+        return std::pair<iterator, bool>(_link_node(pos.first, new_node, insert_left), true);
+    }
+
+    /**
+     * @brief 借助提示查找不允许重复时key的插入位置
+     * @details 返回值与_find_insert_unique_pos相同
+     * @details key紧邻hint之前或之后时只比较hint及其前驱或后继，否则退化为从根查找
+     */
+    template <class K>
+    std::pair<node_pointer, bool> _find_hint_unique_pos(const_iterator hint, const K & key, bool & insert_left) const
+    {
+        node_pointer pos = hint._node;
+
+        if (pos == _head) {
+            // hint为end()，检查是否追加到最大节点之后
+            if (_size > 0 && _comp(_get_key(_rightmost()->_data), key)) {
+                insert_left = false;
+                return std::pair<node_pointer, bool>(_rightmost(), true);
+            }
+            return _find_insert_unique_pos(key, insert_left);
+        }
+
+        if (_comp(key, _get_key(pos->_data))) {
+            // key在hint之前，检查是否位于hint和它的前驱之间
+            if (pos == _leftmost()) {
+                insert_left = true;
+                return std::pair<node_pointer, bool>(pos, true);
+            }
+            const_iterator before = hint;
+            --before;
+            if (_comp(_get_key(before._node->_data), key)) {
+                // 前驱没有右子节点时挂在前驱右侧，否则hint一定没有左子节点
+                insert_left = _right(before._node) != nullptr;
+                return std::pair<node_pointer, bool>(insert_left ? pos : before._node, true);
+            }
+            return _find_insert_unique_pos(key, insert_left);
+        }
+
+        if (_comp(_get_key(pos->_data), key)) {
+            // key在hint之后，检查是否位于hint和它的后继之间
+            if (pos == _rightmost()) {
+                insert_left = false;
+                return std::pair<node_pointer, bool>(pos, true);
+            }
+            const_iterator after = hint;
+            ++after;
+            if (_comp(key, _get_key(after._node->_data))) {
+                // hint没有右子节点时挂在hint右侧，否则后继一定没有左子节点
+                insert_left = _right(pos) != nullptr;
+                return std::pair<node_pointer, bool>(insert_left ? after._node : pos, true);
+            }
+            return _find_insert_unique_pos(key, insert_left);
+        }
+
+        // 与hint相等
+        return std::pair<node_pointer, bool>(pos, false);
+    }
+
+    /**
+     * @brief 根据提示插入已创建的节点，允许重复
+     * @details 相等的键尽量插入到hint之前
+     */
+    iterator _insert_node_hint_equal(const_iterator hint, node_pointer new_node)
+    {
+        const key_type & key = _get_key(new_node->_data);
+        node_pointer pos = hint._node;
+
+        if (pos == _head) {
+            // hint为end()，检查是否追加到最大节点之后
+            if (_size > 0 && !_comp(key, _get_key(_rightmost()->_data))) {
+                return _link_node(_rightmost(), new_node, false);
+            }
+            return _insert_node_equal(new_node);
+        }
+
+        if (!_comp(_get_key(pos->_data), key)) {
+            // key不大于hint，检查是否不小于hint的前驱
+            if (pos == _leftmost()) {
+                return _link_node(pos, new_node, true);
+            }
+            const_iterator before = hint;
+            --before;
+            if (!_comp(key, _get_key(before._node->_data))) {
+                if (_right(before._node) == nullptr) {
+                    return _link_node(before._node, new_node, false);
+                }
+                return _link_node(pos, new_node, true);
+            }
+            return _insert_node_equal(new_node);
+        }
+
+        // key大于hint，检查是否不大于hint的后继
+        if (pos == _rightmost()) {
+            return _link_node(pos, new_node, false);
+        }
+        const_iterator after = hint;
+        ++after;
+        if (!_comp(_get_key(after._node->_data), key)) {
+            if (_right(pos) == nullptr) {
+                return _link_node(pos, new_node, false);
+            }
+            return _link_node(after._node, new_node, true);
+        }
+        return _insert_node_equal(new_node);
+    }
+
+    /**
+     * @brief 复制一个节点的值、颜色、子树大小、最大上界和平衡信息
+     */
+    node_pointer _clone_node(node_pointer x)
+    {
+        node_pointer p = _create_node(x->_data);
+        _set_color(p, _color(x));
+        p->set_count(x->count());
+        p->copy_high(*x);
+        p->copy_balance(*x);
+        return p;
+    }
+
+    /**
+     * @brief 按结构复制以x为根的子树，挂在parent下
+     * @details 借助父节点指针先序遍历，不需要递归，伸展树等可能很深的树也不会耗尽栈空间
+     */
+    node_pointer _copy_tree(node_pointer x, node_pointer parent)
+    {
+        node_pointer top = _clone_node(x);
+        _set_parent(top, parent);
+
+        // src和dst同步移动，dst的子节点为空说明对应的子树还没有复制
+        node_pointer src = x;
+        node_pointer dst = top;
+        while (true) {
+            if (_left(src) != nullptr && _left(dst) == nullptr) {
+                node_pointer y = _clone_node(_left(src));
+                _left(dst) = y;
+                _set_parent(y, dst);
+                src = _left(src);
+                dst = y;
+            } else if (_right(src) != nullptr && _right(dst) == nullptr) {
+                node_pointer y = _clone_node(_right(src));
+                _right(dst) = y;
+                _set_parent(y, dst);
+                src = _right(src);
+                dst = y;
+            } else if (src == x) {
+                break;
+            } else {
+                src = _parent(src);
+                dst = _parent(dst);
+            }
+        }
+        return top;
+    }
+
+    /**
+     * @brief 按结构复制other的所有节点，要求自身为空
+     * @details 直接复制形状和颜色，复杂度O(n)，不需要比较和旋转
+     */
+    void _copy_from(const rb_tree & other)
+    {
+        if (other._root() == nullptr) {
+            return;
+        }
+        _set_root(_copy_tree(other._root(), _head));
+        _leftmost() = _minimum(_root());
+        _rightmost() = _maximum(_root());
+        _size = other._size;
+    }
+
+    /**
+     * @brief 将以_right串联的有序节点链表构建为平衡的红黑树
+     * @param list 链表头，构建过程中依次消耗
+     * @param n 本子树的节点个数
+     * @param depth 本子树根节点的深度
+     * @param red_depth 染为红色的深度，即最深一层
+     * @details 按中序消耗链表，左右子树大小至多相差1，只有最深一层的节点可能没有兄弟，
+     * 将最深一层染红即可保证所有路径的黑色节点数相同
+     */
+    node_pointer _build_balanced(node_pointer & list, size_type n, size_type depth, size_type red_depth)
+    {
+        if (n == 0) {
+            return nullptr;
+        }
+
+        const size_type left_n = (n - 1) / 2;
+        node_pointer left = _build_balanced(list, left_n, depth + 1, red_depth);
+        node_pointer root = list;
+        list = _right(list);
+
+        _left(root) = left;
+        if (left != nullptr) {
+            _set_parent(left, root);
+        }
+        node_pointer right = _build_balanced(list, n - 1 - left_n, depth + 1, red_depth);
+        _right(root) = right;
+        if (right != nullptr) {
+            _set_parent(right, root);
+        }
+        _set_color(root, Balance::colored && depth != 0 && depth == red_depth ? _red : _black);
+        _update_count(root);
+        _update_high(root);
+        Balance::build_node(*this, root);
+        return root;
+    }
+
+    /**
+     * @brief 用有序节点链表构建整棵树，要求自身为空
+     */
+    void _build_from_list(node_pointer list, size_type n)
+    {
+        if (n == 0) {
+            return;
+        }
+        size_type red_depth = 0;    // floor(log2(n))
+        for (size_type m = n; m > 1; m >>= 1) {
+            ++red_depth;
+        }
+        node_pointer root = _build_balanced(list, n, 0, red_depth);
+        _set_root(root);
+        _set_parent(root, _head);
+        _leftmost() = _minimum(root);
+        _rightmost() = _maximum(root);
+        _size = n;
+    }
+
+    /**
+     * @brief 插入范围内的元素
+     * @tparam Unique 是否不允许重复
+     */
+    template <bool Unique, class InputIt>
+    void _insert_range(InputIt first, InputIt last)
+    {
+        if (!empty()) {
+            // 已有元素，逐个插入，以end()为提示，有序追加时均摊O(1)
+            for (; first != last; ++first) {
+                _insert_node<Unique>(_create_node(*first));
+            }
+            return;
+        }
+
+        // 将有序前缀用_right串联成链表
+        node_pointer list = nullptr;
+        node_pointer tail = nullptr;
+        size_type n = 0;
+        for (; first != last; ++first) {
+            node_pointer new_node = _create_node(*first);
+            if (tail != nullptr) {
+                const key_type & key = _get_key(new_node->_data);
+                if (_comp(key, _get_key(tail->_data))) {
+                    // 输入无序，先构建有序前缀，再插入当前节点
+                    _right(tail) = nullptr;
+                    _build_from_list(list, n);
+                    _insert_node<Unique>(new_node);
+                    ++first;
+                    break;
+                }
+                if (Unique && !_comp(_get_key(tail->_data), key)) {
+                    // 与前一个相等，保留第一个
+                    _destroy_node(new_node);
+                    continue;
+                }
+                _right(tail) = new_node;
+            } else {
+                list = new_node;
+            }
+            tail = new_node;
+            ++n;
+        }
+
+        if (empty()) {
+            // 全部有序
+            if (tail != nullptr) {
+                _right(tail) = nullptr;
+            }
+            _build_from_list(list, n);
+            return;
+        }
+
+        for (; first != last; ++first) {
+            _insert_node<Unique>(_create_node(*first));
+        }
+    }
+
+    /**
+     * @brief 以end()为提示插入已创建的节点，插入失败时销毁节点
+     */
+    template <bool Unique>
+    void _insert_node(node_pointer new_node)
+    {
+        if (Unique) {
+            if (!_insert_node_hint_unique(end(), new_node).second) {
+                _destroy_node(new_node);
+            }
+        } else {
+            _insert_node_hint_equal(end(), new_node);
+        }
+    }
+
+    /**
+     * @brief 查找特定键的元素
+     */
+    template <class K>
+    node_pointer _find(const K & key) const
+    {
+        // 每层只比较一次找到lower_bound，最后再判断是否等价
+        node_pointer result = _find_lower(key);
+        if (result != _head && _comp(key, _get_key(result->_data))) {
+            // lower_bound大于key，不存在等价的节点，返回_head表示末尾
+            return _head;
+        }
+        return result;
+    }
+
+    /**
+     * @brief find_many和count_many每批交错处理的键数
+     */
+    enum { _lookup_batch = 16 };
+
+    /**
+     * @brief 批量查找的实现，Iterator决定写入iterator还是const_iterator
+     */
+    template <class Iterator, class ForwardIt, class OutputIt>
+    OutputIt _find_many(ForwardIt first, ForwardIt last, OutputIt out) const
+    {
+        node_pointer lower[_lookup_batch];
+        while (first != last) {
+            ForwardIt batch_first = first;
+            const size_type n = _find_lower_many(first, last, lower);
+            for (size_type i = 0; i < n; ++i, ++batch_first) {
+                node_pointer result = lower[i];
+                if (result != _head && _comp(*batch_first, _get_key(result->_data))) {
+                    // lower_bound大于key，不存在等价的节点
+                    result = _head;
+                }
+                *out = Iterator(result);
+                ++out;
+            }
+        }
+        return out;
+    }
+
+    /**
+     * @brief 对从first开始的至多_lookup_batch个键交错地查找lower_bound，结果写入lower
+     * @details 每轮让每个未结束的键下降一层并预取其下一个节点，各个键的访存相互重叠
+     * @return 本批处理的键数，first移动到下一批的开始
+     */
+    template <class ForwardIt>
+    size_type _find_lower_many(ForwardIt & first, ForwardIt last, node_pointer * lower) const
+    {
+        ForwardIt keys[_lookup_batch];
+        node_pointer cur[_lookup_batch];
+        size_type n = 0;
+        for (; n < _lookup_batch && first != last; ++n, ++first) {
+            keys[n] = first;
+            cur[n] = _root();
+            lower[n] = _head;
+        }
+        bool active = true;
+        while (active) {
+            active = false;
+            for (size_type i = 0; i < n; ++i) {
+                node_pointer x = cur[i];
+                if (x == nullptr) {
+                    continue;
+                }
+                if (_comp(_get_key(x->_data), *keys[i])) {
+                    x = _right(x);
+                } else {
+                    lower[i] = x;
+                    x = _left(x);
+                }
+                cur[i] = x;
+                if (x != nullptr) {
+                    _prefetch(x);
+                    active = true;
+                }
+            }
+        }
+        return n;
+    }
+
+    /**
+     * @brief 查找不小于特定键的最大节点
+     */
+    template <class K>
+    node_pointer _find_lower(const K & key) const
+    {
+        node_pointer cur = _root();
+        node_pointer result = _head;
+        while (cur != nullptr) {
+            if (_comp(_get_key(cur->_data), key)) {
+                // key小于当前节点，向右查找
+                cur = _right(cur);
+            } else {
                 // key大于等于当前节点，更新，并向左查找
                 result = cur;
                 cur = _left(cur);
@@ -1501,10 +2870,148 @@ public:
         return result;
     }
 
+    /**
+     * @brief 从finger开始查找不小于特定键的最小节点，finger不能在结果之后
+     * @details 向上时经过的节点都小于key：从右子节点上升时父节点更小，不需要比较；
+     *          从左子节点上升时比较父节点，父节点不小于key时它就是候选结果，
+     *          结果在候选和当前节点的右子树之间，再向下查找
+     */
+    node_pointer _seek_lower(node_pointer finger, const key_type & key) const
+    {
+        if (finger == _head || !_comp(_get_key(finger->_data), key)) {
+            return finger;
+        }
+        node_pointer cur = finger;
+        node_pointer result = _head;
+        while (cur != _root()) {
+            node_pointer parent = _parent(cur);
+            if (_left(parent) == cur && !_comp(_get_key(parent->_data), key)) {
+                result = parent;
+                break;
+            }
+            cur = parent;
+        }
+        cur = _right(cur);
+        while (cur != nullptr) {
+            if (_comp(_get_key(cur->_data), key)) {
+                cur = _right(cur);
+            } else {
+                result = cur;
+                cur = _left(cur);
+            }
+        }
+        return result;
+    }
+
+    /**
+     * @brief 计算小于key的节点个数
+     */
+    size_type _rank(const key_type & key) const
+    {
+        size_type result = 0;
+        node_pointer cur = _root();
+        while (cur != nullptr) {
+            if (_comp(_get_key(cur->_data), key)) {
+                // 左子树和当前节点都小于key
+                result += _count(_left(cur)) + 1;
+                cur = _right(cur);
+            } else {
+                cur = _left(cur);
+            }
+        }
+        return result;
+    }
+
+    /**
+     * @brief 按下标查找节点，越界时返回head
+     */
+    node_pointer _find_nth(size_type n) const
+    {
+        static_assert(OrderStatistic, "nth requires OrderStatistic");
+        if (n >= _size) {
+            return _head;
+        }
+        node_pointer cur = _root();
+        while (true) {
+            const size_type left_count = _count(_left(cur));
+            if (n < left_count) {
+                cur = _left(cur);
+            } else if (n == left_count) {
+                return cur;
+            } else {
+                n -= left_count + 1;
+                cur = _right(cur);
+            }
+        }
+    }
+
+    /**
+     * @brief 查找任意一个与[lo, hi)重叠的节点，不存在时返回head
+     * @details 左子树的最大上界大于lo时，若左子树中没有重叠的区间，则该区间的下界不小于hi，
+     * 右子树的下界更大，也不会重叠，所以每层只需要进入一侧
+     */
+    template <class B>
+    node_pointer _find_any_overlapping(const B & lo, const B & hi) const
+    {
+        node_pointer cur = _root();
+        while (cur != nullptr) {
+            const key_type & key = _get_key(cur->_data);
+            if (_comp.bound_less(key.first, hi) && _comp.bound_less(lo, key.second)) {
+                return cur;
+            }
+            if (_left(cur) != nullptr && _comp.bound_less(lo, _left(cur)->_high)) {
+                cur = _left(cur);
+            } else {
+                cur = _right(cur);
+            }
+        }
+        return _head;
+    }
+
+    /**
+     * @brief 按中序将以x为根的子树中与[lo, hi)重叠的节点写入out
+     * @param closed 为true时查询区间为闭区间[lo, hi]，用于查找包含某点的区间
+     * @details 沿右链迭代，只对左子树递归；子树的最大上界不大于lo时整棵子树都不重叠，
+     * 节点的下界超出查询区间时其右子树也都超出
+     */
+    template <class Iterator, class B, class OutputIt>
+    OutputIt _find_overlapping(node_pointer x, const B & lo, const B & hi, bool closed, OutputIt out) const
+    {
+        while (x != nullptr && _comp.bound_less(lo, x->_high)) {
+            out = _find_overlapping<Iterator>(_left(x), lo, hi, closed, out);
+            const key_type & key = _get_key(x->_data);
+            if (closed ? _comp.bound_less(hi, key.first) : !_comp.bound_less(key.first, hi)) {
+                break;
+            }
+            if (_comp.bound_less(lo, key.second)) {
+                *out = Iterator(x);
+                ++out;
+            }
+            x = _right(x);
+        }
+        return out;
+    }
+
+    /**
+     * @brief 计算与key等价的节点个数
+     * @details 等价的节点在中序上连续，从lower_bound开始向后计数
+     */
+    template <class K>
+    size_type _count_equal(const K & key) const
+    {
+        size_type result = 0;
+        const_iterator last(_head);
+        for (const_iterator it(_find_lower(key)); it != last && !_comp(key, _get_key(*it)); ++it) {
+            ++result;
+        }
+        return result;
+    }
+
     /**
      * @brief 查找大于特定键的最小节点
      */
-    node_pointer _find_upper(const key_type & key) const
+    template <class K>
+    node_pointer _find_upper(const K & key) const
     {
         node_pointer cur = _root();
         node_pointer result = _head;
@@ -1520,6 +3027,507 @@ public:
         }
         return result;
     }
+
+    /**
+     * 以下为基于join的辅助函数，操作的对象是从树上摘下的子树
+     * 子树用根节点和黑高表示，黑高为从根节点到叶子路径上的黑色节点数，包括黑色的根节点
+     * 调整过程借用_head记录子树的根节点，因此执行期间自身的head不可用
+     */
+
+    /**
+     * @brief 计算子树的黑高
+     */
+    static size_type _black_height(node_pointer x)
+    {
+        static_assert(std::is_same<Balance, red_black_balance>::value, "split, join and set operations require red_black_balance");
+        size_type bh = 0;
+        for (; x != nullptr; x = _left(x)) {
+            if (_color(x) == _black) {
+                ++bh;
+            }
+        }
+        return bh;
+    }
+
+    /**
+     * @brief 将子树安装为整棵树
+     */
+    void _install(node_pointer root, size_type n)
+    {
+        _set_root(root);
+        _size = n;
+        if (root == nullptr) {
+            _init_head();
+            return;
+        }
+        _set_parent(root, _head);
+        _set_color(root, _black);
+        _leftmost() = _minimum(root);
+        _rightmost() = _maximum(root);
+    }
+
+    /**
+     * @brief 以k连接两棵子树
+     * @details 要求l的键不大于k，r的键不小于k，复杂度O(|lbh - rbh| + 1)
+     * @param bh 返回连接后的黑高
+     */
+    node_pointer _join(node_pointer l, size_type lbh, node_pointer k, node_pointer r, size_type rbh, size_type & bh)
+    {
+        // 将红色的根节点染黑，黑高加一
+        if (l != nullptr && _color(l) == _red) {
+            _set_color(l, _black);
+            ++lbh;
+        }
+        if (r != nullptr && _color(r) == _red) {
+            _set_color(r, _black);
+            ++rbh;
+        }
+
+        _set_color(k, _red);
+        if (lbh == rbh) {
+            // 黑高相同，k直接成为根节点，红色的根节点留给上层处理
+            _left(k) = l;
+            _right(k) = r;
+            if (l != nullptr) {
+                _set_parent(l, k);
+            }
+            if (r != nullptr) {
+                _set_parent(r, k);
+            }
+            _update_count(k);
+            _update_high(k);
+            bh = lbh;
+            return k;
+        }
+
+        if (lbh > rbh) {
+            // 沿l的右链向下，找到黑高等于rbh的黑色节点x，用k替换x
+            _set_root(l);
+            _set_parent(l, _head);
+            node_pointer p = nullptr;
+            node_pointer x = l;
+            size_type h = lbh;
+            while (h > rbh || !_is_black(x)) {
+                if (_is_black(x)) {
+                    --h;
+                }
+                p = x;
+                x = _right(x);
+            }
+            _left(k) = x;
+            if (x != nullptr) {
+                _set_parent(x, k);
+            }
+            _right(k) = r;
+            if (r != nullptr) {
+                _set_parent(r, k);
+            }
+            _right(p) = k;
+            _set_parent(k, p);
+            _update_count(k);
+            _increase_count(p, 1 + _count(r));
+            _update_high_path(k);
+            // k为红色，按插入的方式修复
+            bh = lbh + (_rebalance(k) ? 1 : 0);
+        } else {
+            // 沿r的左链向下，找到黑高等于lbh的黑色节点x，用k替换x
+            _set_root(r);
+            _set_parent(r, _head);
+            node_pointer p = nullptr;
+            node_pointer x = r;
+            size_type h = rbh;
+            while (h > lbh || !_is_black(x)) {
+                if (_is_black(x)) {
+                    --h;
+                }
+                p = x;
+                x = _left(x);
+            }
+            _right(k) = x;
+            if (x != nullptr) {
+                _set_parent(x, k);
+            }
+            _left(k) = l;
+            if (l != nullptr) {
+                _set_parent(l, k);
+            }
+            _left(p) = k;
+            _set_parent(k, p);
+            _update_count(k);
+            _increase_count(p, 1 + _count(l));
+            _update_high_path(k);
+            bh = rbh + (_rebalance(k) ? 1 : 0);
+        }
+        node_pointer root = _root();
+        _set_root(nullptr);
+        return root;
+    }
+
+    /**
+     * @brief 连接两棵子树
+     * @details 要求l的键不大于r的键，取出l的最大节点作为连接点
+     */
+    node_pointer _join2(node_pointer l, size_type lbh, node_pointer r, size_type rbh, size_type & bh)
+    {
+        if (l == nullptr) {
+            bh = rbh;
+            return r;
+        }
+        if (r == nullptr) {
+            bh = lbh;
+            return l;
+        }
+
+        node_pointer k = _maximum(l);
+        _set_root(l);
+        _set_parent(l, _head);
+        _leftmost() = nullptr;
+        _rightmost() = nullptr;
+        _rebalance_for_erase(k);
+        l = _root();
+        _set_root(nullptr);
+        return _join(l, _black_height(l), k, r, rbh, bh);
+    }
+
+    /**
+     * @brief 在key处拆分子树
+     * @param take_equal 为true时，将第一个遇到的等于key的节点放入mid；否则等于key的节点都放入r
+     */
+    void _split(node_pointer x, size_type xbh, const key_type & key, bool take_equal,
+                node_pointer & l, size_type & lbh, node_pointer & mid, node_pointer & r, size_type & rbh)
+    {
+        if (x == nullptr) {
+            l = nullptr;
+            r = nullptr;
+            mid = nullptr;
+            lbh = 0;
+            rbh = 0;
+            return;
+        }
+
+        const size_type child_bh = xbh - (_color(x) == _black ? 1 : 0);
+        node_pointer left = _left(x);
+        node_pointer right = _right(x);
+        if (_comp(_get_key(x->_data), key)) {
+            // x小于key，x和左子树属于l
+            node_pointer rl = nullptr;
+            size_type rlbh = 0;
+            _split(right, child_bh, key, take_equal, rl, rlbh, mid, r, rbh);
+            l = _join(left, child_bh, x, rl, rlbh, lbh);
+        } else if (take_equal && !_comp(key, _get_key(x->_data))) {
+            // x等于key
+            l = left;
+            lbh = child_bh;
+            mid = x;
+            r = right;
+            rbh = child_bh;
+        } else {
+            // x大于key，或者不取出相等节点，x和右子树属于r
+            node_pointer lr = nullptr;
+            size_type lrbh = 0;
+            _split(left, child_bh, key, take_equal, l, lbh, mid, lr, lrbh);
+            r = _join(lr, lrbh, x, right, child_bh, rbh);
+        }
+    }
+
+    /**
+     * @brief 销毁子树并计数
+     */
+    void _destroy_subtree(node_pointer x, size_type & destroyed)
+    {
+        while (x != nullptr) {
+            _destroy_subtree(_right(x), destroyed);
+            node_pointer left = _left(x);
+            _destroy_node(x);
+            ++destroyed;
+            x = left;
+        }
+    }
+
+    /**
+     * @brief 子树并集，不允许重复
+     */
+    node_pointer _union_unique(node_pointer t1, size_type b1, node_pointer t2, size_type b2, size_type & bh, size_type & destroyed)
+    {
+        if (t1 == nullptr) {
+            bh = b2;
+            return t2;
+        }
+        if (t2 == nullptr) {
+            bh = b1;
+            return t1;
+        }
+
+        // 以t1的根节点拆分t2，分别递归合并左右两侧
+        const size_type child_bh = b1 - (_color(t1) == _black ? 1 : 0);
+        node_pointer l2 = nullptr;
+        node_pointer r2 = nullptr;
+        node_pointer mid = nullptr;
+        size_type l2bh = 0;
+        size_type r2bh = 0;
+        _split(t2, b2, _get_key(t1->_data), true, l2, l2bh, mid, r2, r2bh);
+        if (mid != nullptr) {
+            // 键相同，保留自身的元素
+            _destroy_node(mid);
+            ++destroyed;
+        }
+
+        size_type lbh = 0;
+        size_type rbh = 0;
+        node_pointer l = _union_unique(_left(t1), child_bh, l2, l2bh, lbh, destroyed);
+        node_pointer r = _union_unique(_right(t1), child_bh, r2, r2bh, rbh, destroyed);
+        return _join(l, lbh, t1, r, rbh, bh);
+    }
+
+    /**
+     * @brief 子树并集，允许重复
+     */
+    node_pointer _union_equal(node_pointer t1, size_type b1, node_pointer t2, size_type b2, size_type & bh, size_type & destroyed)
+    {
+        if (t1 == nullptr) {
+            bh = b2;
+            return t2;
+        }
+        if (t2 == nullptr) {
+            bh = b1;
+            return t1;
+        }
+
+        // t2中等于t1根节点的元素都放入右侧
+        const size_type child_bh = b1 - (_color(t1) == _black ? 1 : 0);
+        node_pointer l2 = nullptr;
+        node_pointer r2 = nullptr;
+        node_pointer mid = nullptr;
+        size_type l2bh = 0;
+        size_type r2bh = 0;
+        _split(t2, b2, _get_key(t1->_data), false, l2, l2bh, mid, r2, r2bh);
+
+        size_type lbh = 0;
+        size_type rbh = 0;
+        node_pointer l = _union_equal(_left(t1), child_bh, l2, l2bh, lbh, destroyed);
+        node_pointer r = _union_equal(_right(t1), child_bh, r2, r2bh, rbh, destroyed);
+        return _join(l, lbh, t1, r, rbh, bh);
+    }
+
+    /**
+     * @brief 子树交集，不允许重复
+     */
+    node_pointer _intersection_unique(node_pointer t1, size_type b1, node_pointer t2, size_type b2, size_type & bh, size_type & destroyed)
+    {
+        if (t1 == nullptr || t2 == nullptr) {
+            _destroy_subtree(t1, destroyed);
+            _destroy_subtree(t2, destroyed);
+            bh = 0;
+            return nullptr;
+        }
+
+        const size_type child_bh = b1 - (_color(t1) == _black ? 1 : 0);
+        node_pointer l2 = nullptr;
+        node_pointer r2 = nullptr;
+        node_pointer mid = nullptr;
+        size_type l2bh = 0;
+        size_type r2bh = 0;
+        _split(t2, b2, _get_key(t1->_data), true, l2, l2bh, mid, r2, r2bh);
+
+        size_type lbh = 0;
+        size_type rbh = 0;
+        node_pointer l = _intersection_unique(_left(t1), child_bh, l2, l2bh, lbh, destroyed);
+        node_pointer r = _intersection_unique(_right(t1), child_bh, r2, r2bh, rbh, destroyed);
+        if (mid != nullptr) {
+            // 两侧都存在，保留自身的元素
+            _destroy_node(mid);
+            ++destroyed;
+            return _join(l, lbh, t1, r, rbh, bh);
+        }
+        _destroy_node(t1);
+        ++destroyed;
+        return _join2(l, lbh, r, rbh, bh);
+    }
+
+    /**
+     * @brief 子树差集，不允许重复
+     */
+    node_pointer _difference_unique(node_pointer t1, size_type b1, node_pointer t2, size_type b2, size_type & bh, size_type & destroyed)
+    {
+        if (t1 == nullptr || t2 == nullptr) {
+            _destroy_subtree(t2, destroyed);
+            bh = b1;
+            return t1;
+        }
+
+        const size_type child_bh = b1 - (_color(t1) == _black ? 1 : 0);
+        node_pointer l2 = nullptr;
+        node_pointer r2 = nullptr;
+        node_pointer mid = nullptr;
+        size_type l2bh = 0;
+        size_type r2bh = 0;
+        _split(t2, b2, _get_key(t1->_data), true, l2, l2bh, mid, r2, r2bh);
+
+        size_type lbh = 0;
+        size_type rbh = 0;
+        node_pointer l = _difference_unique(_left(t1), child_bh, l2, l2bh, lbh, destroyed);
+        node_pointer r = _difference_unique(_right(t1), child_bh, r2, r2bh, rbh, destroyed);
+        if (mid != nullptr) {
+            // other中存在，移除自身的元素
+            _destroy_node(mid);
+            _destroy_node(t1);
+            destroyed += 2;
+            return _join2(l, lbh, r, rbh, bh);
+        }
+        return _join(l, lbh, t1, r, rbh, bh);
+    }
+
+    /**
+     * @brief 执行基于join的集合操作
+     * @details 结果的元素个数为两树之和减去op销毁的节点数，不需要遍历计数
+     */
+    void _set_operation(rb_tree & other, node_pointer (rb_tree::*op)(node_pointer, size_type, node_pointer, size_type, size_type &, size_type &))
+    {
+        if (this == &other) {
+            return;
+        }
+
+        node_pointer t1 = _root();
+        node_pointer t2 = other._root();
+        const size_type b1 = _black_height(t1);
+        const size_type b2 = _black_height(t2);
+        const size_type total = _size + other._size;
+        _init_head();
+        other._init_head();
+        other._size = 0;
+
+        size_type bh = 0;
+        size_type destroyed = 0;
+        node_pointer root = (this->*op)(t1, b1, t2, b2, bh, destroyed);
+        _install(root, total - destroyed);
+    }
+
+    /**
+     * @brief 将other的节点逐个插入自身，不分配新节点
+     */
+    template <bool Unique>
+    void _absorb_nodes(rb_tree & other)
+    {
+        node_pointer list = nullptr;
+        node_pointer tail = nullptr;
+        _flatten(other._root(), list, tail);
+        if (tail != nullptr) {
+            _right(tail) = nullptr;
+        }
+        other._init_head();
+        other._size = 0;
+
+        while (list != nullptr) {
+            node_pointer next = _right(list);
+            if (Unique) {
+                if (!_insert_node_unique(list).second) {
+                    _destroy_node(list);
+                }
+            } else {
+                _insert_node_equal(list);
+            }
+            list = next;
+        }
+    }
+
+    /**
+     * @brief 将子树按中序用_right串联到链表尾部
+     * @details 有左子节点时右旋，否则将当前节点接到链表尾部，不需要递归
+     */
+    static void _flatten(node_pointer x, node_pointer & head, node_pointer & tail)
+    {
+        while (x != nullptr) {
+            node_pointer left = _left(x);
+            if (left != nullptr) {
+                _left(x) = _right(left);
+                _right(left) = x;
+                x = left;
+                continue;
+            }
+            node_pointer right = _right(x);
+            if (tail == nullptr) {
+                head = x;
+            } else {
+                _right(tail) = x;
+            }
+            tail = x;
+            x = right;
+        }
+    }
+
+    /**
+     * @brief 线性归并两棵树，用于允许重复的交集和差集
+     * @param intersection 为true时求交集，否则求差集
+     */
+    void _merge_operation(rb_tree & other, bool intersection)
+    {
+        if (this == &other) {
+            if (!intersection) {
+                clear();
+            }
+            return;
+        }
+
+        node_pointer a = nullptr;
+        node_pointer a_tail = nullptr;
+        node_pointer b = nullptr;
+        node_pointer b_tail = nullptr;
+        _flatten(_root(), a, a_tail);
+        _flatten(other._root(), b, b_tail);
+        if (a_tail != nullptr) {
+            _right(a_tail) = nullptr;
+        }
+        if (b_tail != nullptr) {
+            _right(b_tail) = nullptr;
+        }
+        _init_head();
+        _size = 0;
+        other._init_head();
+        other._size = 0;
+
+        node_pointer kept = nullptr;
+        node_pointer kept_tail = nullptr;
+        size_type n = 0;
+        while (a != nullptr) {
+            bool keep = !intersection;
+            if (b != nullptr && !_comp(_get_key(a->_data), _get_key(b->_data))) {
+                if (_comp(_get_key(b->_data), _get_key(a->_data))) {
+                    // b较小，丢弃b
+                    node_pointer next = _right(b);
+                    _destroy_node(b);
+                    b = next;
+                    continue;
+                }
+                // 相等，交集保留a，差集丢弃a，两侧同时前进
+                keep = intersection;
+                node_pointer next = _right(b);
+                _destroy_node(b);
+                b = next;
+            }
+            node_pointer next = _right(a);
+            if (keep) {
+                if (kept_tail == nullptr) {
+                    kept = a;
+                } else {
+                    _right(kept_tail) = a;
+                }
+                kept_tail = a;
+                ++n;
+            } else {
+                _destroy_node(a);
+            }
+            a = next;
+        }
+        while (b != nullptr) {
+            node_pointer next = _right(b);
+            _destroy_node(b);
+            b = next;
+        }
+        if (kept_tail != nullptr) {
+            _right(kept_tail) = nullptr;
+        }
+        _build_from_list(kept, n);
+    }
 };
 
 // 非成员函数
@@ -1530,9 +3538,12 @@ template <
     class Value,
     class ExtractKey,
     class Compare,
-    class Allocator
-> void swap(rb_tree<Key, T, Value, ExtractKey, Compare, Allocator> & lhs,
-            rb_tree<Key, T, Value, ExtractKey, Compare, Allocator> & rhs)
+    class Allocator,
+    bool OrderStatistic,
+    bool Interval,
+    class Balance
+> void swap(rb_tree<Key, T, Value, ExtractKey, Compare, Allocator, OrderStatistic, Interval, Balance> & lhs,
+            rb_tree<Key, T, Value, ExtractKey, Compare, Allocator, OrderStatistic, Interval, Balance> & rhs)
 {
     lhs.swap(rhs);
 }
@@ -6,14 +6,27 @@
 namespace wwstl
 {
 
+template <
+    class Key,
+    class Compare,
+    class Allocator,
+    bool OrderStatistic,
+    class Balance
+> class multiset;
+
 /**
  * @brief set
  * @link https://zh.cppreference.com/w/cpp/container/set
+ * @details OrderStatistic为true时支持rank、nth和count_range，每个节点额外记录子树大小
+ * @details Balance为平衡策略，可选red_black_balance、avl_balance、treap_balance和splay_balance，
+ *          split、join、unite、intersect和subtract只支持默认的red_black_balance
  */
 template <
     class Key,
     class Compare = std::less<Key>,
-    class Allocator = wwstl::allocator<Key>
+    class Allocator = wwstl::allocator<Key>,
+    bool OrderStatistic = false,
+    class Balance = red_black_balance
 > class set
 {
 public:
@@ -28,13 +41,16 @@ public:
     using const_reference = const value_type&;
     using pointer = value_type*;
     using const_pointer = const value_type*;
-    using iterator = typename wwstl::rb_tree<key_type, void, value_type, keyExtractor<value_type>, value_compare, Allocator>::iterator;
-    using const_iterator = typename wwstl::rb_tree<key_type, void, value_type, keyExtractor<value_type>, value_compare, Allocator>::const_iterator;
+    using iterator = typename wwstl::rb_tree<key_type, void, value_type, keyExtractor<value_type>, value_compare, Allocator, OrderStatistic, false, Balance>::iterator;
+    using const_iterator = typename wwstl::rb_tree<key_type, void, value_type, keyExtractor<value_type>, value_compare, Allocator, OrderStatistic, false, Balance>::const_iterator;
     using reverse_iterator = typename wwstl::reverse_iterator<iterator>;
     using const_reverse_iterator = typename wwstl::reverse_iterator<const_iterator>;
 
+    using node_type = typename wwstl::rb_tree<key_type, void, value_type, keyExtractor<value_type>, value_compare, Allocator, OrderStatistic, false, Balance>::node_type;
+    using insert_return_type = typename wwstl::rb_tree<key_type, void, value_type, keyExtractor<value_type>, value_compare, Allocator, OrderStatistic, false, Balance>::insert_return_type;
+
 public:
-    wwstl::rb_tree<key_type, void, value_type, keyExtractor<value_type>, value_compare, Allocator> _tree;     // 红黑树
+    wwstl::rb_tree<key_type, void, value_type, keyExtractor<value_type>, value_compare, Allocator, OrderStatistic, false, Balance> _tree;     // 红黑树
 
 public:
     set()
@@ -54,8 +70,9 @@ public:
 
     template <class InputIt>
     set(InputIt first, InputIt last, const Compare & comp = Compare(), const Allocator & alloc = Allocator())
-        : _tree(first, last, comp, alloc)
+        : _tree(comp, alloc)
     {
+        _tree.insert_range_unique(first, last);
     }
 
     set(const set & other)
@@ -297,10 +314,7 @@ public:
     template <class InputIt>
     void insert(InputIt first, InputIt last)
     {
-        for (; first != last; ++first)
-        {
-            _tree.emplace_unique(*first);
-        }
+        _tree.insert_range_unique(first, last);
     }
 
     /**
@@ -361,8 +375,130 @@ public:
         _tree.swap(other._tree);
     }
 
+    /**
+     * @brief 摘下pos指向的节点，不销毁元素
+     */
+    node_type extract(const_iterator pos)
+    {
+        return _tree.extract(pos);
+    }
+
+    /**
+     * @brief 摘下首个键等于key的节点，不存在时返回空句柄
+     */
+    node_type extract(const key_type & key)
+    {
+        return _tree.extract(key);
+    }
+
+    /**
+     * @brief 插入节点句柄
+     */
+    insert_return_type insert(node_type && nh)
+    {
+        return _tree.insert_unique(std::move(nh));
+    }
+
+    /**
+     * @brief 根据提示插入节点句柄
+     */
+    iterator insert(const_iterator hint, node_type && nh)
+    {
+        return _tree.insert_hint_unique(hint, std::move(nh));
+    }
+
+    /**
+     * @brief 从source中拼接节点，键已存在的节点留在source中
+     */
+    template <class C2>
+    void merge(set<Key, C2, Allocator, OrderStatistic, Balance> & source)
+    {
+        _tree.merge_unique(source._tree);
+    }
+
+    /**
+     * @brief 从source中拼接节点，键已存在的节点留在source中
+     */
+    template <class C2>
+    void merge(multiset<Key, C2, Allocator, OrderStatistic, Balance> & source)
+    {
+        _tree.merge_unique(source._tree);
+    }
+
+    /**
+     * @brief 在key处拆分，自身保留小于key的元素，返回不小于key的元素
+     * @details 启用顺序统计时为O(log n)，否则需要遍历计数，为O(min(k, n - k))
+     */
+    set split(const key_type & key)
+    {
+        set right(_tree._comp, get_allocator());
+        auto tail = _tree.split(key);
+        right._tree.swap(tail);
+        return right;
+    }
+
+    /**
+     * @brief 将other连接到自身之后，要求自身的所有键不大于other的所有键
+     */
+    void join(set & other)
+    {
+        _tree.join(other._tree);
+    }
+
+    /**
+     * @brief 并入other的所有元素，键相同时保留自身的元素，操作后other为空
+     */
+    void unite(set & other)
+    {
+        _tree.union_unique(other._tree);
+    }
+
+    /**
+     * @brief 只保留键也存在于other的元素，操作后other为空
+     */
+    void intersect(set & other)
+    {
+        _tree.intersection_unique(other._tree);
+    }
+
+    /**
+     * @brief 移除键存在于other的元素，操作后other为空
+     */
+    void subtract(set & other)
+    {
+        _tree.difference_unique(other._tree);
+    }
+
     // 查找
 
+    /**
+     * @brief 批量查找，依次将每个键的查找结果写入out，不存在时写入end()
+     * @details 多个键的访存交错进行，适合一次查找大量键
+     */
+    template <class ForwardIt, class OutputIt>
+    OutputIt find_many(ForwardIt first, ForwardIt last, OutputIt out)
+    {
+        return _tree.find_many(first, last, out);
+    }
+
+    /**
+     * @brief 批量查找，依次将每个键的查找结果写入out，不存在时写入end()
+     */
+    template <class ForwardIt, class OutputIt>
+    OutputIt find_many(ForwardIt first, ForwardIt last, OutputIt out) const
+    {
+        return _tree.find_many(first, last, out);
+    }
+
+    /**
+     * @brief 批量计数，依次将匹配每个键的元素数量写入out
+     */
+    template <class ForwardIt, class OutputIt>
+    OutputIt count_many(ForwardIt first, ForwardIt last, OutputIt out) const
+    {
+        return _tree.count_many(first, last, out);
+    }
+
     /**
      * @brief 返回匹配特定键的元素数量
      */
@@ -371,6 +507,16 @@ public:
         return _tree.count(key);
     }
 
+    /**
+     * @brief 返回匹配特定键的元素数量
+     * @details 异构查找，要求比较器定义is_transparent
+     */
+    template <class K, class C = key_compare, class = typename C::is_transparent>
+    size_type count(const K & key) const
+    {
+        return _tree.count(key);
+    }
+
     /**
      * @brief 寻找带有特定键的元素
      */
@@ -379,6 +525,16 @@ public:
         return _tree.find(key);
     }
 
+    /**
+     * @brief 寻找带有特定键的元素
+     * @details 异构查找，要求比较器定义is_transparent
+     */
+    template <class K, class C = key_compare, class = typename C::is_transparent>
+    iterator find(const K & key)
+    {
+        return _tree.find(key);
+    }
+
     /**
      * @brief 寻找带有特定键的元素
      */
@@ -387,6 +543,16 @@ public:
         return _tree.find(key);
     }
 
+    /**
+     * @brief 寻找带有特定键的元素
+     * @details 异构查找，要求比较器定义is_transparent
+     */
+    template <class K, class C = key_compare, class = typename C::is_transparent>
+    const_iterator find(const K & key) const
+    {
+        return _tree.find(key);
+    }
+
     /**
      * @brief 返回匹配特定键的元素范围
      */
@@ -395,6 +561,16 @@ public:
         return _tree.equal_range(key);
     }
 
+    /**
+     * @brief 返回匹配特定键的元素范围
+     * @details 异构查找，要求比较器定义is_transparent
+     */
+    template <class K, class C = key_compare, class = typename C::is_transparent>
+    std::pair<iterator, iterator> equal_range(const K & key)
+    {
+        return _tree.equal_range(key);
+    }
+
     /**
      * @brief 返回匹配特定键的元素范围
      */
@@ -403,6 +579,16 @@ public:
         return _tree.equal_range(key);
     }
 
+    /**
+     * @brief 返回匹配特定键的元素范围
+     * @details 异构查找，要求比较器定义is_transparent
+     */
+    template <class K, class C = key_compare, class = typename C::is_transparent>
+    std::pair<const_iterator, const_iterator> equal_range(const K & key) const
+    {
+        return _tree.equal_range(key);
+    }
+
     /**
      * @brief 返回指向首个不小于给定键的元素的迭代器
      */
@@ -411,6 +597,16 @@ public:
         return _tree.lower_bound(key);
     }
 
+    /**
+     * @brief 返回指向首个不小于给定键的元素的迭代器
+     * @details 异构查找，要求比较器定义is_transparent
+     */
+    template <class K, class C = key_compare, class = typename C::is_transparent>
+    iterator lower_bound(const K & key)
+    {
+        return _tree.lower_bound(key);
+    }
+
     /**
      * @brief 返回指向首个不小于给定键的元素的迭代器
      */
@@ -419,6 +615,16 @@ public:
         return _tree.lower_bound(key);
     }
 
+    /**
+     * @brief 返回指向首个不小于给定键的元素的迭代器
+     * @details 异构查找，要求比较器定义is_transparent
+     */
+    template <class K, class C = key_compare, class = typename C::is_transparent>
+    const_iterator lower_bound(const K & key) const
+    {
+        return _tree.lower_bound(key);
+    }
+
     /**
      * @brief 返回指向首个大于给定键的元素的迭代器
      */
@@ -427,6 +633,16 @@ public:
         return _tree.upper_bound(key);
     }
 
+    /**
+     * @brief 返回指向首个大于给定键的元素的迭代器
+     * @details 异构查找，要求比较器定义is_transparent
+     */
+    template <class K, class C = key_compare, class = typename C::is_transparent>
+    iterator upper_bound(const K & key)
+    {
+        return _tree.upper_bound(key);
+    }
+
     /**
      * @brief 返回指向首个大于给定键的元素的迭代器
      */
@@ -435,6 +651,72 @@ public:
         return _tree.upper_bound(key);
     }
 
+    /**
+     * @brief 返回指向首个大于给定键的元素的迭代器
+     * @details 异构查找，要求比较器定义is_transparent
+     */
+    template <class K, class C = key_compare, class = typename C::is_transparent>
+    const_iterator upper_bound(const K & key) const
+    {
+        return _tree.upper_bound(key);
+    }
+
+    /**
+     * @brief 从pos向后查找首个不小于给定键的元素，结果与lower_bound(key)相同
+     * @details 要求pos不在lower_bound(key)之后，复杂度O(log d)，d为pos与结果之间的元素数，
+     *          按顺序查找有序的键序列时用上一次的结果作为pos
+     */
+    iterator seek_forward(const_iterator pos, const key_type & key)
+    {
+        return _tree.seek_forward(pos, key);
+    }
+
+    /**
+     * @brief 从pos向后查找首个不小于给定键的元素，结果与lower_bound(key)相同
+     * @details 要求pos不在lower_bound(key)之后，复杂度O(log d)，d为pos与结果之间的元素数
+     */
+    const_iterator seek_forward(const_iterator pos, const key_type & key) const
+    {
+        return _tree.seek_forward(pos, key);
+    }
+
+    // 顺序统计
+    /**
+     * 以下操作要求OrderStatistic为true
+     */
+
+    /**
+     * @brief 返回小于给定键的元素个数，复杂度O(log n)
+     */
+    size_type rank(const key_type & key) const
+    {
+        return _tree.rank(key);
+    }
+
+    /**
+     * @brief 返回下标为n的元素的迭代器，n不小于size()时返回end()，复杂度O(log n)
+     */
+    iterator nth(size_type n)
+    {
+        return _tree.nth(n);
+    }
+
+    /**
+     * @brief 返回下标为n的元素的迭代器，n不小于size()时返回end()，复杂度O(log n)
+     */
+    const_iterator nth(size_type n) const
+    {
+        return _tree.nth(n);
+    }
+
+    /**
+     * @brief 返回键在[lo, hi)范围内的元素个数，复杂度O(log n)
+     */
+    size_type count_range(const key_type & lo, const key_type & hi) const
+    {
+        return _tree.count_range(lo, hi);
+    }
+
     // 观察器
 
     /**
@@ -459,8 +741,10 @@ public:
 template <
     class Key,
     class Compare,
-    class Allocator
-> bool operator==(const set<Key, Compare, Allocator> & lhs, const set<Key, Compare, Allocator> & rhs)
+    class Allocator,
+    bool OrderStatistic,
+    class Balance
+> bool operator==(const set<Key, Compare, Allocator, OrderStatistic, Balance> & lhs, const set<Key, Compare, Allocator, OrderStatistic, Balance> & rhs)
 {
     if (lhs.size() != rhs.size())
         return false;
@@ -477,8 +761,10 @@ template <
 template <
     class Key,
     class Compare,
-    class Allocator
-> bool operator!=(const set<Key, Compare, Allocator> & lhs, const set<Key, Compare, Allocator> & rhs)
+    class Allocator,
+    bool OrderStatistic,
+    class Balance
+> bool operator!=(const set<Key, Compare, Allocator, OrderStatistic, Balance> & lhs, const set<Key, Compare, Allocator, OrderStatistic, Balance> & rhs)
 {
     return !(lhs == rhs);
 }
@@ -486,8 +772,10 @@ template <
 template <
     class Key,
     class Compare,
-    class Allocator
-> bool operator<(const set<Key, Compare, Allocator> & lhs, const set<Key, Compare, Allocator> & rhs)
+    class Allocator,
+    bool OrderStatistic,
+    class Balance
+> bool operator<(const set<Key, Compare, Allocator, OrderStatistic, Balance> & lhs, const set<Key, Compare, Allocator, OrderStatistic, Balance> & rhs)
 {
     return std::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
 }
@@ -495,8 +783,10 @@ template <
 template <
     class Key,
     class Compare,
-    class Allocator
-> bool operator>(const set<Key, Compare, Allocator> & lhs, const set<Key, Compare, Allocator> & rhs)
+    class Allocator,
+    bool OrderStatistic,
+    class Balance
+> bool operator>(const set<Key, Compare, Allocator, OrderStatistic, Balance> & lhs, const set<Key, Compare, Allocator, OrderStatistic, Balance> & rhs)
 {
     return rhs < lhs;
 }
@@ -504,8 +794,10 @@ template <
 template <
     class Key,
     class Compare,
-    class Allocator
-> bool operator<=(const set<Key, Compare, Allocator> & lhs, const set<Key, Compare, Allocator> & rhs)
+    class Allocator,
+    bool OrderStatistic,
+    class Balance
+> bool operator<=(const set<Key, Compare, Allocator, OrderStatistic, Balance> & lhs, const set<Key, Compare, Allocator, OrderStatistic, Balance> & rhs)
 {
     return !(rhs < lhs);
 }
@@ -513,8 +805,10 @@ template <
 template <
     class Key,
     class Compare,
-    class Allocator
-> bool operator>=(const set<Key, Compare, Allocator> & lhs, const set<Key, Compare, Allocator> & rhs)
+    class Allocator,
+    bool OrderStatistic,
+    class Balance
+> bool operator>=(const set<Key, Compare, Allocator, OrderStatistic, Balance> & lhs, const set<Key, Compare, Allocator, OrderStatistic, Balance> & rhs)
 {
     return !(lhs < rhs);
 }
@@ -522,8 +816,10 @@ template <
 template <
     class Key,
     class Compare,
-    class Allocator
-> void swap(set<Key, Compare, Allocator> & lhs, set<Key, Compare, Allocator> & rhs)
+    class Allocator,
+    bool OrderStatistic,
+    class Balance
+> void swap(set<Key, Compare, Allocator, OrderStatistic, Balance> & lhs, set<Key, Compare, Allocator, OrderStatistic, Balance> & rhs)
 {
     lhs.swap(rhs);
 }
@@ -531,11 +827,16 @@ template <
 /**
  * @brief multiset
  * @link https://zh.cppreference.com/w/cpp/container/multiset
+ * @details OrderStatistic为true时支持rank、nth和count_range，每个节点额外记录子树大小
+ * @details Balance为平衡策略，可选red_black_balance、avl_balance、treap_balance和splay_balance，
+ *          split、join、unite、intersect和subtract只支持默认的red_black_balance
  */
 template <
     class Key,
     class Compare = std::less<Key>,
-    class Allocator = wwstl::allocator<Key>
+    class Allocator = wwstl::allocator<Key>,
+    bool OrderStatistic = false,
+    class Balance = red_black_balance
 > class multiset
 {
 public:
@@ -550,13 +851,15 @@ public:
     using const_reference = const value_type&;
     using pointer = value_type*;
     using const_pointer = const value_type*;
-    using iterator = typename wwstl::rb_tree<key_type, void, value_type, keyExtractor<value_type>, value_compare, Allocator>::iterator;
-    using const_iterator = typename wwstl::rb_tree<key_type, void, value_type, keyExtractor<value_type>, value_compare, Allocator>::const_iterator;
+    using iterator = typename wwstl::rb_tree<key_type, void, value_type, keyExtractor<value_type>, value_compare, Allocator, OrderStatistic, false, Balance>::iterator;
+    using const_iterator = typename wwstl::rb_tree<key_type, void, value_type, keyExtractor<value_type>, value_compare, Allocator, OrderStatistic, false, Balance>::const_iterator;
     using reverse_iterator = typename wwstl::reverse_iterator<iterator>;
     using const_reverse_iterator = typename wwstl::reverse_iterator<const_iterator>;
 
+    using node_type = typename wwstl::rb_tree<key_type, void, value_type, keyExtractor<value_type>, value_compare, Allocator, OrderStatistic, false, Balance>::node_type;
+
 public:
-    wwstl::rb_tree<key_type, void, value_type, keyExtractor<value_type>, value_compare, Allocator> _tree;     // 红黑树
+    wwstl::rb_tree<key_type, void, value_type, keyExtractor<value_type>, value_compare, Allocator, OrderStatistic, false, Balance> _tree;     // 红黑树
 
 public:
     multiset()
@@ -576,8 +879,9 @@ public:
 
     template <class InputIt>
     multiset(InputIt first, InputIt last, const Compare & comp = Compare(), const Allocator & alloc = Allocator())
-        : _tree(first, last, comp, alloc)
+        : _tree(comp, alloc)
     {
+        _tree.insert_range_equal(first, last);
     }
 
     multiset(const multiset & other)
@@ -819,10 +1123,7 @@ public:
     template <class InputIt>
     void insert(InputIt first, InputIt last)
     {
-        for (; first != last; ++first)
-        {
-            _tree.emplace_equal(*first);
-        }
+        _tree.insert_range_equal(first, last);
     }
 
     /**
@@ -883,8 +1184,130 @@ public:
         _tree.swap(other._tree);
     }
 
+    /**
+     * @brief 摘下pos指向的节点，不销毁元素
+     */
+    node_type extract(const_iterator pos)
+    {
+        return _tree.extract(pos);
+    }
+
+    /**
+     * @brief 摘下首个键等于key的节点，不存在时返回空句柄
+     */
+    node_type extract(const key_type & key)
+    {
+        return _tree.extract(key);
+    }
+
+    /**
+     * @brief 插入节点句柄
+     */
+    iterator insert(node_type && nh)
+    {
+        return _tree.insert_equal(std::move(nh));
+    }
+
+    /**
+     * @brief 根据提示插入节点句柄
+     */
+    iterator insert(const_iterator hint, node_type && nh)
+    {
+        return _tree.insert_hint_equal(hint, std::move(nh));
+    }
+
+    /**
+     * @brief 从source中拼接所有节点
+     */
+    template <class C2>
+    void merge(multiset<Key, C2, Allocator, OrderStatistic, Balance> & source)
+    {
+        _tree.merge_equal(source._tree);
+    }
+
+    /**
+     * @brief 从source中拼接所有节点
+     */
+    template <class C2>
+    void merge(set<Key, C2, Allocator, OrderStatistic, Balance> & source)
+    {
+        _tree.merge_equal(source._tree);
+    }
+
+    /**
+     * @brief 在key处拆分，自身保留小于key的元素，返回不小于key的元素
+     * @details 启用顺序统计时为O(log n)，否则需要遍历计数，为O(min(k, n - k))
+     */
+    multiset split(const key_type & key)
+    {
+        multiset right(_tree._comp, get_allocator());
+        auto tail = _tree.split(key);
+        right._tree.swap(tail);
+        return right;
+    }
+
+    /**
+     * @brief 将other连接到自身之后，要求自身的所有键不大于other的所有键
+     */
+    void join(multiset & other)
+    {
+        _tree.join(other._tree);
+    }
+
+    /**
+     * @brief 并入other的所有元素，保留所有元素，操作后other为空
+     */
+    void unite(multiset & other)
+    {
+        _tree.union_equal(other._tree);
+    }
+
+    /**
+     * @brief 只保留共同的元素，按重复次数取较小值，操作后other为空
+     */
+    void intersect(multiset & other)
+    {
+        _tree.intersection_equal(other._tree);
+    }
+
+    /**
+     * @brief 移除与other共同的元素，按重复次数相减，操作后other为空
+     */
+    void subtract(multiset & other)
+    {
+        _tree.difference_equal(other._tree);
+    }
+
     // 查找
 
+    /**
+     * @brief 批量查找，依次将每个键的查找结果写入out，不存在时写入end()
+     * @details 多个键的访存交错进行，适合一次查找大量键
+     */
+    template <class ForwardIt, class OutputIt>
+    OutputIt find_many(ForwardIt first, ForwardIt last, OutputIt out)
+    {
+        return _tree.find_many(first, last, out);
+    }
+
+    /**
+     * @brief 批量查找，依次将每个键的查找结果写入out，不存在时写入end()
+     */
+    template <class ForwardIt, class OutputIt>
+    OutputIt find_many(ForwardIt first, ForwardIt last, OutputIt out) const
+    {
+        return _tree.find_many(first, last, out);
+    }
+
+    /**
+     * @brief 批量计数，依次将匹配每个键的元素数量写入out
+     */
+    template <class ForwardIt, class OutputIt>
+    OutputIt count_many(ForwardIt first, ForwardIt last, OutputIt out) const
+    {
+        return _tree.count_many(first, last, out);
+    }
+
     /**
      * @brief 返回匹配特定键的元素数量
      */
@@ -893,6 +1316,16 @@ public:
         return _tree.count(key);
     }
 
+    /**
+     * @brief 返回匹配特定键的元素数量
+     * @details 异构查找，要求比较器定义is_transparent
+     */
+    template <class K, class C = key_compare, class = typename C::is_transparent>
+    size_type count(const K & key) const
+    {
+        return _tree.count(key);
+    }
+
     /**
      * @brief 寻找带有特定键的元素
      */
@@ -901,6 +1334,16 @@ public:
         return _tree.find(key);
     }
 
+    /**
+     * @brief 寻找带有特定键的元素
+     * @details 异构查找，要求比较器定义is_transparent
+     */
+    template <class K, class C = key_compare, class = typename C::is_transparent>
+    iterator find(const K & key)
+    {
+        return _tree.find(key);
+    }
+
     /**
      * @brief 寻找带有特定键的元素
      */
@@ -909,6 +1352,16 @@ public:
         return _tree.find(key);
     }
 
+    /**
+     * @brief 寻找带有特定键的元素
+     * @details 异构查找，要求比较器定义is_transparent
+     */
+    template <class K, class C = key_compare, class = typename C::is_transparent>
+    const_iterator find(const K & key) const
+    {
+        return _tree.find(key);
+    }
+
     /**
      * @brief 返回匹配特定键的元素范围
      */
@@ -917,6 +1370,16 @@ public:
         return _tree.equal_range(key);
     }
 
+    /**
+     * @brief 返回匹配特定键的元素范围
+     * @details 异构查找，要求比较器定义is_transparent
+     */
+    template <class K, class C = key_compare, class = typename C::is_transparent>
+    std::pair<iterator, iterator> equal_range(const K & key)
+    {
+        return _tree.equal_range(key);
+    }
+
     /**
      * @brief 返回匹配特定键的元素范围
      */
@@ -925,6 +1388,16 @@ public:
         return _tree.equal_range(key);
     }
 
+    /**
+     * @brief 返回匹配特定键的元素范围
+     * @details 异构查找，要求比较器定义is_transparent
+     */
+    template <class K, class C = key_compare, class = typename C::is_transparent>
+    std::pair<const_iterator, const_iterator> equal_range(const K & key) const
+    {
+        return _tree.equal_range(key);
+    }
+
     /**
      * @brief 返回指向首个不小于给定键的元素的迭代器
      */
@@ -933,6 +1406,16 @@ public:
         return _tree.lower_bound(key);
     }
 
+    /**
+     * @brief 返回指向首个不小于给定键的元素的迭代器
+     * @details 异构查找，要求比较器定义is_transparent
+     */
+    template <class K, class C = key_compare, class = typename C::is_transparent>
+    iterator lower_bound(const K & key)
+    {
+        return _tree.lower_bound(key);
+    }
+
     /**
      * @brief 返回指向首个不小于给定键的元素的迭代器
      */
@@ -941,6 +1424,16 @@ public:
         return _tree.lower_bound(key);
     }
 
+    /**
+     * @brief 返回指向首个不小于给定键的元素的迭代器
+     * @details 异构查找，要求比较器定义is_transparent
+     */
+    template <class K, class C = key_compare, class = typename C::is_transparent>
+    const_iterator lower_bound(const K & key) const
+    {
+        return _tree.lower_bound(key);
+    }
+
     /**
      * @brief 返回指向首个大于给定键的元素的迭代器
      */
@@ -949,6 +1442,16 @@ public:
         return _tree.upper_bound(key);
     }
 
+    /**
+     * @brief 返回指向首个大于给定键的元素的迭代器
+     * @details 异构查找，要求比较器定义is_transparent
+     */
+    template <class K, class C = key_compare, class = typename C::is_transparent>
+    iterator upper_bound(const K & key)
+    {
+        return _tree.upper_bound(key);
+    }
+
     /**
      * @brief 返回指向首个大于给定键的元素的迭代器
      */
@@ -957,6 +1460,72 @@ public:
         return _tree.upper_bound(key);
     }
 
+    /**
+     * @brief 返回指向首个大于给定键的元素的迭代器
+     * @details 异构查找，要求比较器定义is_transparent
+     */
+    template <class K, class C = key_compare, class = typename C::is_transparent>
+    const_iterator upper_bound(const K & key) const
+    {
+        return _tree.upper_bound(key);
+    }
+
+    /**
+     * @brief 从pos向后查找首个不小于给定键的元素，结果与lower_bound(key)相同
+     * @details 要求pos不在lower_bound(key)之后，复杂度O(log d)，d为pos与结果之间的元素数，
+     *          按顺序查找有序的键序列时用上一次的结果作为pos
+     */
+    iterator seek_forward(const_iterator pos, const key_type & key)
+    {
+        return _tree.seek_forward(pos, key);
+    }
+
+    /**
+     * @brief 从pos向后查找首个不小于给定键的元素，结果与lower_bound(key)相同
+     * @details 要求pos不在lower_bound(key)之后，复杂度O(log d)，d为pos与结果之间的元素数
+     */
+    const_iterator seek_forward(const_iterator pos, const key_type & key) const
+    {
+        return _tree.seek_forward(pos, key);
+    }
+
+    // 顺序统计
+    /**
+     * 以下操作要求OrderStatistic为true
+     */
+
+    /**
+     * @brief 返回小于给定键的元素个数，复杂度O(log n)
+     */
+    size_type rank(const key_type & key) const
+    {
+        return _tree.rank(key);
+    }
+
+    /**
+     * @brief 返回下标为n的元素的迭代器，n不小于size()时返回end()，复杂度O(log n)
+     */
+    iterator nth(size_type n)
+    {
+        return _tree.nth(n);
+    }
+
+    /**
+     * @brief 返回下标为n的元素的迭代器，n不小于size()时返回end()，复杂度O(log n)
+     */
+    const_iterator nth(size_type n) const
+    {
+        return _tree.nth(n);
+    }
+
+    /**
+     * @brief 返回键在[lo, hi)范围内的元素个数，复杂度O(log n)
+     */
+    size_type count_range(const key_type & lo, const key_type & hi) const
+    {
+        return _tree.count_range(lo, hi);
+    }
+
     // 观察器
 
     /**
@@ -964,7 +1533,7 @@ public:
      */
     key_compare key_comp() const
     {
-        return _tree.key_comp();
+        return _tree._comp;
     }
 };
 
@@ -973,8 +1542,10 @@ public:
 template <
     class Key,
     class Compare,
-    class Allocator
-> bool operator==(const multiset<Key, Compare, Allocator> & lhs, const multiset<Key, Compare, Allocator> & rhs)
+    class Allocator,
+    bool OrderStatistic,
+    class Balance
+> bool operator==(const multiset<Key, Compare, Allocator, OrderStatistic, Balance> & lhs, const multiset<Key, Compare, Allocator, OrderStatistic, Balance> & rhs)
 {
     if (lhs.size() != rhs.size())
         return false;
@@ -994,8 +1565,10 @@ template <
 template <
     class Key,
     class Compare,
-    class Allocator
-> bool operator!=(const multiset<Key, Compare, Allocator> & lhs, const multiset<Key, Compare, Allocator> & rhs)
+    class Allocator,
+    bool OrderStatistic,
+    class Balance
+> bool operator!=(const multiset<Key, Compare, Allocator, OrderStatistic, Balance> & lhs, const multiset<Key, Compare, Allocator, OrderStatistic, Balance> & rhs)
 {
     return !(lhs == rhs);
 }
@@ -1003,8 +1576,10 @@ template <
 template <
     class Key,
     class Compare,
-    class Allocator
-> bool operator<(const multiset<Key, Compare, Allocator> & lhs, const multiset<Key, Compare, Allocator> & rhs)
+    class Allocator,
+    bool OrderStatistic,
+    class Balance
+> bool operator<(const multiset<Key, Compare, Allocator, OrderStatistic, Balance> & lhs, const multiset<Key, Compare, Allocator, OrderStatistic, Balance> & rhs)
 {
     return std::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
 }
@@ -1012,8 +1587,10 @@ template <
 template <
     class Key,
     class Compare,
-    class Allocator
-> bool operator>(const multiset<Key, Compare, Allocator> & lhs, const multiset<Key, Compare, Allocator> & rhs)
+    class Allocator,
+    bool OrderStatistic,
+    class Balance
+> bool operator>(const multiset<Key, Compare, Allocator, OrderStatistic, Balance> & lhs, const multiset<Key, Compare, Allocator, OrderStatistic, Balance> & rhs)
 {
     return rhs < lhs;
 }
@@ -1021,8 +1598,10 @@ template <
 template <
     class Key,
     class Compare,
-    class Allocator
-> bool operator<=(const multiset<Key, Compare, Allocator> & lhs, const multiset<Key, Compare, Allocator> & rhs)
+    class Allocator,
+    bool OrderStatistic,
+    class Balance
+> bool operator<=(const multiset<Key, Compare, Allocator, OrderStatistic, Balance> & lhs, const multiset<Key, Compare, Allocator, OrderStatistic, Balance> & rhs)
 {
     return !(rhs < lhs);
 }
@@ -1030,8 +1609,10 @@ template <
 template <
     class Key,
     class Compare,
-    class Allocator
-> bool operator>=(const multiset<Key, Compare, Allocator> & lhs, const multiset<Key, Compare, Allocator> & rhs)
+    class Allocator,
+    bool OrderStatistic,
+    class Balance
+> bool operator>=(const multiset<Key, Compare, Allocator, OrderStatistic, Balance> & lhs, const multiset<Key, Compare, Allocator, OrderStatistic, Balance> & rhs)
 {
     return !(lhs < rhs);
 }
@@ -1039,12 +1620,32 @@ template <
 template <
     class Key,
     class Compare,
-    class Allocator
-> void swap(multiset<Key, Compare, Allocator> & lhs, multiset<Key, Compare, Allocator> & rhs)
+    class Allocator,
+    bool OrderStatistic,
+    class Balance
+> void swap(multiset<Key, Compare, Allocator, OrderStatistic, Balance> & lhs, multiset<Key, Compare, Allocator, OrderStatistic, Balance> & rhs)
 {
     lhs.swap(rhs);
 }
 
+/**
+ * @brief 支持顺序统计的set
+ */
+template <
+    class Key,
+    class Compare = std::less<Key>,
+    class Allocator = wwstl::allocator<Key>
+> using ranked_set = set<Key, Compare, Allocator, true>;
+
+/**
+ * @brief 支持顺序统计的multiset
+ */
+template <
+    class Key,
+    class Compare = std::less<Key>,
+    class Allocator = wwstl::allocator<Key>
+> using ranked_multiset = multiset<Key, Compare, Allocator, true>;
+
 } // namespace wwstl
 
 #endif // __WW_SET_H__
\ No newline at end of file
@@ -0,0 +1,611 @@
+#ifndef __WW_SKIP_LIST_H__
+#define __WW_SKIP_LIST_H__
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <new>
+#include <thread>
+#include <type_traits>
+#include "ww_memory.h"
+
+namespace wwstl
+{
+
+/**
+ * @brief 跳表节点
+ * @details 节点之后紧跟_level个next指针，按层数分配不同大小的内存
+ * @details next指针的最低位为删除标记，标记后该层的next不再改变
+ */
+template <class Value>
+class _skip_list_node
+{
+public:
+    using value_type = Value;
+    using node_pointer = _skip_list_node<Value>*;
+
+public:
+    typename std::aligned_storage<sizeof(value_type), alignof(value_type)>::type _storage;  // 值，头节点不构造
+    node_pointer _retired_next;             // 等待回收时的链表指针
+    int _level;                             // 层数
+    std::atomic<int> _owners;               // 插入者和删除者，都完成后才能回收
+    std::atomic<std::uintptr_t> _next[1];   // 每层的后继，实际长度为_level
+
+public:
+    value_type & _value()
+    {
+        return *reinterpret_cast<value_type *>(&_storage);
+    }
+
+    const value_type & _value() const
+    {
+        return *reinterpret_cast<const value_type *>(&_storage);
+    }
+};
+
+/**
+ * @brief 无锁跳表
+ * @details 按Herlihy和Shavit的无锁跳表实现，先逐层标记next指针逻辑删除节点，再由查找过程物理摘除
+ * @details 节点用基于纪元的方式回收：线程在操作期间登记当前纪元，节点摘除后放入对应纪元的回收链表，
+ *          全局纪元前进两次后不再有线程持有该节点，才真正释放
+ * @details 插入、删除和查找可以在多个线程中并发调用；clear、析构不能与其他操作并发
+ */
+template <
+    class Key,
+    class T,
+    class Value,
+    class ExtractKey,
+    class Compare,
+    class Allocator
+> class skip_list
+{
+public:
+    using key_type = Key;
+    using mapped_type = T;
+    using value_type = Value;
+    using size_type = std::size_t;
+    using key_compare = Compare;
+    using allocator_type = Allocator;
+
+    using node = _skip_list_node<value_type>;
+    using node_pointer = node*;
+    using node_allocator_type = typename allocator_type::template rebind<node>::other;
+
+public:
+    enum
+    {
+        _max_level = 32,        // 最大层数
+        _max_threads = 128,     // 可同时操作的线程数
+        _retire_batch = 64      // 每回收多少个节点尝试推进一次纪元
+    };
+
+    /**
+     * @brief 线程登记槽，填充到缓存行大小，避免相邻槽的伪共享
+     * @details 0表示空闲，否则为(纪元 << 1) | 1
+     */
+    class _epoch_slot
+    {
+    public:
+        std::atomic<std::size_t> _state;
+        char _padding[64 - sizeof(std::atomic<std::size_t>)];
+    };
+
+    /**
+     * @brief 操作期间占用一个登记槽
+     */
+    class _epoch_guard
+    {
+    public:
+        const skip_list * _list;
+        std::size_t _slot;
+
+    public:
+        explicit _epoch_guard(const skip_list * list)
+            : _list(list)
+            , _slot(list->_enter())
+        {
+        }
+
+        _epoch_guard(const _epoch_guard &) = delete;
+
+        ~_epoch_guard()
+        {
+            _list->_slots[_slot]._state.store(0);
+        }
+
+        _epoch_guard & operator=(const _epoch_guard &) = delete;
+    };
+
+public:
+    node_pointer _head;                             // 头节点，具有全部层数
+    std::atomic<int> _top;                          // 当前使用的最高层数
+    std::atomic<size_type> _size;                   // 元素个数
+    key_compare _comp;                              // 键比较器
+    ExtractKey _get_key;                            // 从值中取得键
+    node_allocator_type _node_allocator;            // 节点分配器
+    std::atomic<std::size_t> _epoch;                // 全局纪元
+    mutable _epoch_slot _slots[_max_threads];       // 线程登记槽
+    std::atomic<node_pointer> _retired[3];          // 按纪元模3存放等待回收的节点
+    std::atomic<std::size_t> _retired_count;        // 累计回收的节点数
+
+public:
+    explicit skip_list(const Compare & comp = Compare(), const Allocator & alloc = Allocator())
+        : _top(1)
+        , _size(0)
+        , _comp(comp)
+        , _get_key()
+        , _node_allocator(alloc)
+        , _epoch(0)
+        , _retired_count(0)
+    {
+        for (auto & slot : _slots) {
+            slot._state.store(0);
+        }
+        for (auto & list : _retired) {
+            list.store(nullptr);
+        }
+        _head = _allocate_node(_max_level);
+    }
+
+    skip_list(const skip_list &) = delete;
+
+    ~skip_list()
+    {
+        clear();
+        _deallocate_node(_head);
+    }
+
+public:
+    skip_list & operator=(const skip_list &) = delete;
+
+    // 容量
+
+    /**
+     * @brief 检查容器是否为空
+     */
+    bool empty() const noexcept
+    {
+        return size() == 0;
+    }
+
+    /**
+     * @brief 返回元素数
+     * @details 并发修改时只是近似值
+     */
+    size_type size() const noexcept
+    {
+        return _size.load(std::memory_order_relaxed);
+    }
+
+    // 修改器
+
+    /**
+     * @brief 擦除所有元素，不能与其他操作并发
+     */
+    void clear()
+    {
+        for (auto & list : _retired) {
+            _free_retired(list.exchange(nullptr));
+        }
+        node_pointer cur = _ptr(_head->_next[0].load());
+        while (cur != nullptr) {
+            node_pointer next = _ptr(cur->_next[0].load());
+            _destroy_node(cur);
+            cur = next;
+        }
+        for (int level = 0; level < _max_level; ++level) {
+            _head->_next[level].store(0);
+        }
+        _top.store(1);
+        _size.store(0);
+    }
+
+    /**
+     * @brief 原位构造元素，不允许重复
+     * @details 键已存在时销毁新节点并返回false
+     */
+    template <class... Args>
+    bool emplace_unique(Args&&... args)
+    {
+        _epoch_guard guard(this);
+        node_pointer preds[_max_level];
+        node_pointer succs[_max_level];
+        node_pointer new_node = _create_node(_random_level(), std::forward<Args>(args)...);
+        const key_type & key = _get_key(new_node->_value());
+        const int level = new_node->_level;
+        _raise_top(level);
+
+        // 在第0层链接，成功后元素可见
+        while (true) {
+            if (_find(key, preds, succs)) {
+                _destroy_node(new_node);
+                return false;
+            }
+            for (int i = 0; i < level; ++i) {
+                new_node->_next[i].store(reinterpret_cast<std::uintptr_t>(succs[i]), std::memory_order_relaxed);
+            }
+            std::uintptr_t expected = reinterpret_cast<std::uintptr_t>(succs[0]);
+            if (preds[0]->_next[0].compare_exchange_strong(expected, reinterpret_cast<std::uintptr_t>(new_node))) {
+                break;
+            }
+        }
+        _size.fetch_add(1, std::memory_order_relaxed);
+
+        // 逐层向上链接，节点被删除时停止
+        for (int i = 1; i < level; ++i) {
+            while (true) {
+                std::uintptr_t next = new_node->_next[i].load();
+                if (_marked(next)) {
+                    break;
+                }
+                if (_ptr(next) != succs[i] && !new_node->_next[i].compare_exchange_strong(next, reinterpret_cast<std::uintptr_t>(succs[i]))) {
+                    continue;
+                }
+                std::uintptr_t expected = reinterpret_cast<std::uintptr_t>(succs[i]);
+                if (preds[i]->_next[i].compare_exchange_strong(expected, reinterpret_cast<std::uintptr_t>(new_node))) {
+                    if (_marked(new_node->_next[i].load())) {
+                        // 链接的同时被删除，删除者可能已经完成摘除，由插入者再摘除一次
+                        _find(key, preds, succs);
+                    }
+                    break;
+                }
+                _find(key, preds, succs);
+                if (succs[0] != new_node) {
+                    // 已被删除
+                    break;
+                }
+            }
+            if (_marked(new_node->_next[i].load())) {
+                break;
+            }
+        }
+        _release_owner(new_node);
+        return true;
+    }
+
+    /**
+     * @brief 擦除键为key的元素
+     * @return 擦除的元素个数
+     */
+    template <class K>
+    size_type erase_unique(const K & key)
+    {
+        _epoch_guard guard(this);
+        node_pointer preds[_max_level];
+        node_pointer succs[_max_level];
+        if (!_find(key, preds, succs)) {
+            return 0;
+        }
+        node_pointer victim = succs[0];
+        // 从高层到低层标记
+        for (int i = victim->_level - 1; i > 0; --i) {
+            std::uintptr_t next = victim->_next[i].load();
+            while (!_marked(next) && !victim->_next[i].compare_exchange_weak(next, next | 1)) {
+            }
+        }
+        // 标记第0层即完成逻辑删除，只有一个线程能成功
+        std::uintptr_t next = victim->_next[0].load();
+        while (true) {
+            if (_marked(next)) {
+                return 0;
+            }
+            if (victim->_next[0].compare_exchange_weak(next, next | 1)) {
+                break;
+            }
+        }
+        _size.fetch_sub(1, std::memory_order_relaxed);
+        // 物理摘除
+        _find(key, preds, succs);
+        _release_owner(victim);
+        return 1;
+    }
+
+    // 查找
+
+    /**
+     * @brief 查找key，找到时以节点中的值调用f
+     * @details f在登记期间调用，可以安全地读取值
+     * @return 是否找到
+     */
+    template <class K, class F>
+    bool visit(const K & key, F && f) const
+    {
+        _epoch_guard guard(this);
+        node_pointer x = _find_node(key);
+        if (x == nullptr) {
+            return false;
+        }
+        f(static_cast<const value_type &>(x->_value()));
+        return true;
+    }
+
+    /**
+     * @brief 返回匹配特定键的元素数量
+     */
+    template <class K>
+    size_type count(const K & key) const
+    {
+        _epoch_guard guard(this);
+        return _find_node(key) == nullptr ? 0 : 1;
+    }
+
+    /**
+     * @brief 按键的顺序访问[first_key, last_key)中的元素
+     * @details 弱一致：不会重复访问，并发插入或删除的元素可能访问到也可能访问不到
+     */
+    template <class K, class F>
+    void scan(const K & first_key, const K & last_key, F && f) const
+    {
+        _epoch_guard guard(this);
+        for (node_pointer x = _lower_node(first_key); x != nullptr && _comp(_get_key(x->_value()), last_key); x = _next_live(x)) {
+            f(static_cast<const value_type &>(x->_value()));
+        }
+    }
+
+    /**
+     * @brief 按键的顺序访问所有元素
+     */
+    template <class F>
+    void for_each(F && f) const
+    {
+        _epoch_guard guard(this);
+        for (node_pointer x = _next_live(_head); x != nullptr; x = _next_live(x)) {
+            f(static_cast<const value_type &>(x->_value()));
+        }
+    }
+
+    // 观察器
+
+    /**
+     * @brief 返回用于比较键的函数
+     */
+    key_compare key_comp() const
+    {
+        return _comp;
+    }
+
+public:
+    static bool _marked(std::uintptr_t p) noexcept
+    {
+        return (p & 1) != 0;
+    }
+
+    static node_pointer _ptr(std::uintptr_t p) noexcept
+    {
+        return reinterpret_cast<node_pointer>(p & ~static_cast<std::uintptr_t>(1));
+    }
+
+    /**
+     * @brief 随机层数，每层以1/2的概率继续向上
+     */
+    static int _random_level()
+    {
+        static thread_local std::uint64_t state = 0x9e3779b97f4a7c15ull ^ std::hash<std::thread::id>()(std::this_thread::get_id());
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+        int level = 1;
+        for (std::uint64_t bits = state; (bits & 1) != 0 && level < _max_level; bits >>= 1) {
+            ++level;
+        }
+        return level;
+    }
+
+    /**
+     * @brief 分配具有level层的节点，只构造next指针
+     */
+    node_pointer _allocate_node(int level)
+    {
+        const size_type bytes = sizeof(node) + (level - 1) * sizeof(std::atomic<std::uintptr_t>);
+        const size_type n = (bytes + sizeof(node) - 1) / sizeof(node);
+        node_pointer p = allocator_traits<node_allocator_type>::allocate(_node_allocator, n);
+        p->_retired_next = nullptr;
+        p->_level = level;
+        new (&p->_owners) std::atomic<int>(2);
+        for (int i = 0; i < level; ++i) {
+            new (&p->_next[i]) std::atomic<std::uintptr_t>(0);
+        }
+        return p;
+    }
+
+    void _deallocate_node(node_pointer p)
+    {
+        const size_type bytes = sizeof(node) + (p->_level - 1) * sizeof(std::atomic<std::uintptr_t>);
+        allocator_traits<node_allocator_type>::deallocate(_node_allocator, p, (bytes + sizeof(node) - 1) / sizeof(node));
+    }
+
+    template <class... Args>
+    node_pointer _create_node(int level, Args&&... args)
+    {
+        node_pointer p = _allocate_node(level);
+        allocator_type alloc(_node_allocator);
+        allocator_traits<allocator_type>::construct(alloc, &p->_value(), std::forward<Args>(args)...);
+        return p;
+    }
+
+    void _destroy_node(node_pointer p)
+    {
+        allocator_type alloc(_node_allocator);
+        allocator_traits<allocator_type>::destroy(alloc, &p->_value());
+        _deallocate_node(p);
+    }
+
+    /**
+     * @brief 提高当前最高层数
+     */
+    void _raise_top(int level)
+    {
+        int top = _top.load(std::memory_order_relaxed);
+        while (top < level && !_top.compare_exchange_weak(top, level, std::memory_order_relaxed)) {
+        }
+    }
+
+    /**
+     * @brief 查找key在每层的前驱和后继，途中摘除已标记的节点
+     * @return 第0层的后继是否等于key
+     */
+    template <class K>
+    bool _find(const K & key, node_pointer * preds, node_pointer * succs)
+    {
+    retry:
+        node_pointer pred = _head;
+        const int top = _top.load(std::memory_order_relaxed);
+        for (int level = _max_level - 1; level >= top; --level) {
+            preds[level] = _head;
+            succs[level] = nullptr;
+        }
+        node_pointer cur = nullptr;
+        for (int level = top - 1; level >= 0; --level) {
+            cur = _ptr(pred->_next[level].load());
+            while (cur != nullptr) {
+                std::uintptr_t next = cur->_next[level].load();
+                while (_marked(next)) {
+                    // cur已被删除，从本层摘除
+                    std::uintptr_t expected = reinterpret_cast<std::uintptr_t>(cur);
+                    if (!pred->_next[level].compare_exchange_strong(expected, next & ~static_cast<std::uintptr_t>(1))) {
+                        goto retry;
+                    }
+                    cur = _ptr(next);
+                    if (cur == nullptr) {
+                        break;
+                    }
+                    next = cur->_next[level].load();
+                }
+                if (cur == nullptr || !_comp(_get_key(cur->_value()), key)) {
+                    break;
+                }
+                pred = cur;
+                cur = _ptr(next);
+            }
+            preds[level] = pred;
+            succs[level] = cur;
+        }
+        return cur != nullptr && !_comp(key, _get_key(cur->_value()));
+    }
+
+    /**
+     * @brief 返回不小于key的第一个未删除节点，只读不摘除
+     */
+    template <class K>
+    node_pointer _lower_node(const K & key) const
+    {
+        node_pointer pred = _head;
+        node_pointer cur = nullptr;
+        for (int level = _top.load(std::memory_order_relaxed) - 1; level >= 0; --level) {
+            cur = _ptr(pred->_next[level].load());
+            while (cur != nullptr) {
+                std::uintptr_t next = cur->_next[level].load();
+                if (!_marked(next) && !_comp(_get_key(cur->_value()), key)) {
+                    break;
+                }
+                if (!_marked(next)) {
+                    pred = cur;
+                }
+                cur = _ptr(next);
+            }
+        }
+        return cur;
+    }
+
+    /**
+     * @brief 查找键为key的未删除节点，不存在时返回nullptr
+     */
+    template <class K>
+    node_pointer _find_node(const K & key) const
+    {
+        node_pointer x = _lower_node(key);
+        if (x == nullptr || _comp(key, _get_key(x->_value()))) {
+            return nullptr;
+        }
+        return x;
+    }
+
+    /**
+     * @brief 返回第0层中x之后的第一个未删除节点
+     */
+    static node_pointer _next_live(node_pointer x)
+    {
+        node_pointer cur = _ptr(x->_next[0].load());
+        while (cur != nullptr && _marked(cur->_next[0].load())) {
+            cur = _ptr(cur->_next[0].load());
+        }
+        return cur;
+    }
+
+    /**
+     * @brief 插入者或删除者完成对节点的处理，两者都完成后回收节点
+     * @details 插入者可能在删除者摘除之后才链接到高层，只有两者都结束后节点才确定不可达
+     */
+    void _release_owner(node_pointer x)
+    {
+        if (x->_owners.fetch_sub(1) == 1) {
+            _retire(x);
+        }
+    }
+
+    /**
+     * @brief 登记当前线程，返回占用的槽
+     */
+    std::size_t _enter() const
+    {
+        std::size_t slot = std::hash<std::thread::id>()(std::this_thread::get_id()) % _max_threads;
+        while (true) {
+            std::size_t epoch = _epoch.load();
+            std::size_t expected = 0;
+            if (_slots[slot]._state.compare_exchange_strong(expected, (epoch << 1) | 1)) {
+                // 登记后纪元可能已经前进，更新到最新纪元
+                for (std::size_t now = _epoch.load(); now != epoch; now = _epoch.load()) {
+                    epoch = now;
+                    _slots[slot]._state.store((epoch << 1) | 1);
+                }
+                return slot;
+            }
+            slot = (slot + 1) % _max_threads;
+        }
+    }
+
+    /**
+     * @brief 将已摘除的节点放入当前纪元的回收链表
+     */
+    void _retire(node_pointer x)
+    {
+        std::atomic<node_pointer> & list = _retired[_epoch.load() % 3];
+        node_pointer head = list.load();
+        do {
+            x->_retired_next = head;
+        } while (!list.compare_exchange_weak(head, x));
+        if (_retired_count.fetch_add(1, std::memory_order_relaxed) % _retire_batch == _retire_batch - 1) {
+            _try_advance();
+        }
+    }
+
+    /**
+     * @brief 所有登记的线程都处于当前纪元时推进纪元，并释放两个纪元之前回收的节点
+     */
+    void _try_advance()
+    {
+        std::size_t epoch = _epoch.load();
+        for (auto & slot : _slots) {
+            const std::size_t state = slot._state.load();
+            if (state != 0 && (state >> 1) != epoch) {
+                return;
+            }
+        }
+        if (_epoch.compare_exchange_strong(epoch, epoch + 1)) {
+            _free_retired(_retired[(epoch + 2) % 3].exchange(nullptr));
+        }
+    }
+
+    void _free_retired(node_pointer x)
+    {
+        while (x != nullptr) {
+            node_pointer next = x->_retired_next;
+            _destroy_node(x);
+            x = next;
+        }
+    }
+};
+
+} // namespace wwstl
+
+#endif // __WW_SKIP_LIST_H__
@@ -0,0 +1,308 @@
+#ifndef __WW_STATIC_MAP_H__
+#define __WW_STATIC_MAP_H__
+
+#include <initializer_list>
+#include <stdexcept>
+#include "ww_flat_table.h"
+#include "ww_static_table.h"
+
+namespace wwstl
+{
+
+/**
+ * @brief 只读有序映射
+ * @details 构建后不能修改，键和值分别存放在两个有序数组中，另按Layout为键建立只用于查找的索引
+ * @details 迭代器与flat_map相同，解引用得到std::pair<const Key &, const T &>
+ * @details 从map、有序数组等按键严格有序的范围构建时为O(n)，否则先按键排序，重复的键保留第一个
+ */
+template <
+    class Key,
+    class T,
+    class Compare = std::less<Key>,
+    class Layout = eytzinger_layout
+> class static_map
+{
+public:
+    using key_type = Key;
+    using mapped_type = T;
+    using value_type = std::pair<Key, T>;
+    using key_compare = Compare;
+    using reference = std::pair<const Key &, const T &>;
+    using const_reference = std::pair<const Key &, const T &>;
+    using size_type = std::size_t;
+    using difference_type = std::ptrdiff_t;
+    using layout_type = Layout;
+    using key_container_type = wwstl::vector<Key>;
+    using mapped_container_type = wwstl::vector<T>;
+    using iterator = _flat_table_iterator<typename wwstl::vector<Key>::const_iterator, typename wwstl::vector<T>::const_iterator>;
+    using const_iterator = iterator;
+    using reverse_iterator = typename wwstl::reverse_iterator<iterator>;
+    using const_reverse_iterator = typename wwstl::reverse_iterator<const_iterator>;
+
+public:
+    wwstl::vector<Key> _keys;                                       // 有序的键
+    wwstl::vector<T> _values;                                       // 与键下标对应的值
+    typename Layout::template index<Key, Compare> _index;           // 查找索引
+    Compare _comp;                                                  // 比较器
+
+public:
+    static_map()
+        : static_map(Compare())
+    {
+    }
+
+    explicit static_map(const Compare & comp)
+        : _keys()
+        , _values()
+        , _index()
+        , _comp(comp)
+    {
+    }
+
+    template <class InputIt>
+    static_map(InputIt first, InputIt last, const Compare & comp = Compare())
+        : _keys()
+        , _values()
+        , _index()
+        , _comp(comp)
+    {
+        wwstl::vector<value_type> values(first, last);
+        auto key_less = [this](const value_type & lhs, const value_type & rhs) {
+            return _comp(lhs.first, rhs.first);
+        };
+        values.erase(_sort_unique(values.begin(), values.end(), key_less), values.end());
+        _keys.reserve(values.size());
+        _values.reserve(values.size());
+        for (auto & value : values) {
+            _keys.push_back(std::move(value.first));
+            _values.push_back(std::move(value.second));
+        }
+        _index.build(_keys.data(), _keys.size());
+    }
+
+    static_map(std::initializer_list<value_type> init, const Compare & comp = Compare())
+        : static_map(init.begin(), init.end(), comp)
+    {
+    }
+
+    static_map(const static_map & other) = default;
+
+    static_map(static_map && other) = default;
+
+public:
+    static_map & operator=(const static_map & other) = default;
+
+    static_map & operator=(static_map && other) = default;
+
+    // 元素访问
+
+    /**
+     * @brief 带越界检查访问指定的元素
+     */
+    const mapped_type & at(const key_type & key) const
+    {
+        size_type index = _find_index(key);
+        if (index == size()) {
+            throw std::out_of_range("static_map at out of range");
+        }
+        return _values[index];
+    }
+
+    // 迭代器
+
+    /**
+     * @brief 返回指向起始的迭代器
+     */
+    iterator begin() const noexcept
+    {
+        return _make_iterator(0);
+    }
+
+    /**
+     * @brief 返回指向起始的迭代器
+     */
+    const_iterator cbegin() const noexcept
+    {
+        return begin();
+    }
+
+    /**
+     * @brief 返回指向末尾的迭代器
+     */
+    iterator end() const noexcept
+    {
+        return _make_iterator(size());
+    }
+
+    /**
+     * @brief 返回指向末尾的迭代器
+     */
+    const_iterator cend() const noexcept
+    {
+        return end();
+    }
+
+    /**
+     * @brief 返回指向起始的逆向迭代器
+     */
+    reverse_iterator rbegin() const noexcept
+    {
+        return reverse_iterator(end());
+    }
+
+    /**
+     * @brief 返回指向末尾的逆向迭代器
+     */
+    reverse_iterator rend() const noexcept
+    {
+        return reverse_iterator(begin());
+    }
+
+    // 容量
+
+    /**
+     * @brief 检查容器是否为空
+     */
+    bool empty() const noexcept
+    {
+        return _keys.empty();
+    }
+
+    /**
+     * @brief 返回元素数
+     */
+    size_type size() const noexcept
+    {
+        return _keys.size();
+    }
+
+    // 修改器
+
+    /**
+     * @brief 交换内容
+     */
+    void swap(static_map & other) noexcept
+    {
+        std::swap(_keys, other._keys);
+        std::swap(_values, other._values);
+        std::swap(_index, other._index);
+        std::swap(_comp, other._comp);
+    }
+
+    // 查找
+
+    /**
+     * @brief 返回匹配特定键的元素数量
+     */
+    size_type count(const key_type & key) const
+    {
+        return _find_index(key) == size() ? 0 : 1;
+    }
+
+    /**
+     * @brief 寻找带有特定键的元素
+     */
+    iterator find(const key_type & key) const
+    {
+        return _make_iterator(_find_index(key));
+    }
+
+    /**
+     * @brief 返回匹配特定键的元素范围
+     */
+    std::pair<iterator, iterator> equal_range(const key_type & key) const
+    {
+        size_type lower = _lower_index(key);
+        size_type upper = lower != size() && !_comp(key, _keys[lower]) ? lower + 1 : lower;
+        return std::pair<iterator, iterator>(_make_iterator(lower), _make_iterator(upper));
+    }
+
+    /**
+     * @brief 返回指向首个不小于给定键的元素的迭代器
+     */
+    iterator lower_bound(const key_type & key) const
+    {
+        return _make_iterator(_lower_index(key));
+    }
+
+    /**
+     * @brief 返回指向首个大于给定键的元素的迭代器
+     */
+    iterator upper_bound(const key_type & key) const
+    {
+        return equal_range(key).second;
+    }
+
+    // 观察器
+
+    /**
+     * @brief 返回用于比较键的函数
+     */
+    key_compare key_comp() const
+    {
+        return _comp;
+    }
+
+    /**
+     * @brief 返回有序的键数组
+     */
+    const key_container_type & keys() const noexcept
+    {
+        return _keys;
+    }
+
+    /**
+     * @brief 返回与键对应的值数组
+     */
+    const mapped_container_type & values() const noexcept
+    {
+        return _values;
+    }
+
+public:
+    iterator _make_iterator(size_type index) const
+    {
+        return iterator(_keys.cbegin() + index, _values.cbegin() + index);
+    }
+
+    /**
+     * @brief 首个不小于key的下标
+     */
+    size_type _lower_index(const key_type & key) const
+    {
+        return _index.lower_bound(_keys.data(), _keys.size(), key, _comp);
+    }
+
+    /**
+     * @brief 与key等价的下标，不存在时返回size()
+     */
+    size_type _find_index(const key_type & key) const
+    {
+        size_type index = _lower_index(key);
+        return index == size() || _comp(key, _keys[index]) ? size() : index;
+    }
+};
+
+// 非成员函数
+
+template <class Key, class T, class Compare, class Layout>
+bool operator==(const static_map<Key, T, Compare, Layout> & lhs, const static_map<Key, T, Compare, Layout> & rhs)
+{
+    return lhs.keys() == rhs.keys() && lhs.values() == rhs.values();
+}
+
+template <class Key, class T, class Compare, class Layout>
+bool operator!=(const static_map<Key, T, Compare, Layout> & lhs, const static_map<Key, T, Compare, Layout> & rhs)
+{
+    return !(lhs == rhs);
+}
+
+template <class Key, class T, class Compare, class Layout>
+void swap(static_map<Key, T, Compare, Layout> & lhs, static_map<Key, T, Compare, Layout> & rhs) noexcept
+{
+    lhs.swap(rhs);
+}
+
+} // namespace wwstl
+
+#endif // __WW_STATIC_MAP_H__
@@ -0,0 +1,267 @@
+#ifndef __WW_STATIC_SET_H__
+#define __WW_STATIC_SET_H__
+
+#include <initializer_list>
+#include "ww_static_table.h"
+
+namespace wwstl
+{
+
+/**
+ * @brief 只读有序集合
+ * @details 构建后不能修改，键存放在有序数组中用于遍历，另按Layout建立只用于查找的索引
+ * @details Layout为eytzinger_layout（默认）或btree_layout，
+ *          大表中lower_bound访问的缓存行远少于在有序数组上二分
+ * @details 从set、有序数组等严格有序的范围构建时为O(n)，否则先排序并去重
+ */
+template <
+    class Key,
+    class Compare = std::less<Key>,
+    class Layout = eytzinger_layout
+> class static_set
+{
+public:
+    using key_type = Key;
+    using value_type = Key;
+    using key_compare = Compare;
+    using value_compare = Compare;
+    using reference = const value_type &;
+    using const_reference = const value_type &;
+    using size_type = std::size_t;
+    using difference_type = std::ptrdiff_t;
+    using layout_type = Layout;
+    using iterator = typename wwstl::vector<Key>::const_iterator;
+    using const_iterator = typename wwstl::vector<Key>::const_iterator;
+    using reverse_iterator = typename wwstl::reverse_iterator<iterator>;
+    using const_reverse_iterator = typename wwstl::reverse_iterator<const_iterator>;
+
+public:
+    wwstl::vector<Key> _keys;                                       // 有序的键
+    typename Layout::template index<Key, Compare> _index;           // 查找索引
+    Compare _comp;                                                  // 比较器
+
+public:
+    static_set()
+        : static_set(Compare())
+    {
+    }
+
+    explicit static_set(const Compare & comp)
+        : _keys()
+        , _index()
+        , _comp(comp)
+    {
+    }
+
+    template <class InputIt>
+    static_set(InputIt first, InputIt last, const Compare & comp = Compare())
+        : _keys(first, last)
+        , _index()
+        , _comp(comp)
+    {
+        _build();
+    }
+
+    static_set(std::initializer_list<value_type> init, const Compare & comp = Compare())
+        : static_set(init.begin(), init.end(), comp)
+    {
+    }
+
+    static_set(const static_set & other) = default;
+
+    static_set(static_set && other) = default;
+
+public:
+    static_set & operator=(const static_set & other) = default;
+
+    static_set & operator=(static_set && other) = default;
+
+    // 迭代器
+
+    /**
+     * @brief 返回指向起始的迭代器
+     */
+    iterator begin() const noexcept
+    {
+        return _keys.cbegin();
+    }
+
+    /**
+     * @brief 返回指向起始的迭代器
+     */
+    const_iterator cbegin() const noexcept
+    {
+        return _keys.cbegin();
+    }
+
+    /**
+     * @brief 返回指向末尾的迭代器
+     */
+    iterator end() const noexcept
+    {
+        return _keys.cend();
+    }
+
+    /**
+     * @brief 返回指向末尾的迭代器
+     */
+    const_iterator cend() const noexcept
+    {
+        return _keys.cend();
+    }
+
+    /**
+     * @brief 返回指向起始的逆向迭代器
+     */
+    reverse_iterator rbegin() const noexcept
+    {
+        return reverse_iterator(end());
+    }
+
+    /**
+     * @brief 返回指向末尾的逆向迭代器
+     */
+    reverse_iterator rend() const noexcept
+    {
+        return reverse_iterator(begin());
+    }
+
+    // 容量
+
+    /**
+     * @brief 检查容器是否为空
+     */
+    bool empty() const noexcept
+    {
+        return _keys.empty();
+    }
+
+    /**
+     * @brief 返回元素数
+     */
+    size_type size() const noexcept
+    {
+        return _keys.size();
+    }
+
+    // 修改器
+
+    /**
+     * @brief 交换内容
+     */
+    void swap(static_set & other) noexcept
+    {
+        std::swap(_keys, other._keys);
+        std::swap(_index, other._index);
+        std::swap(_comp, other._comp);
+    }
+
+    // 查找
+
+    /**
+     * @brief 返回匹配特定键的元素数量
+     */
+    size_type count(const key_type & key) const
+    {
+        return find(key) == end() ? 0 : 1;
+    }
+
+    /**
+     * @brief 寻找带有特定键的元素
+     */
+    iterator find(const key_type & key) const
+    {
+        size_type index = _lower_index(key);
+        if (index == size() || _comp(key, _keys[index])) {
+            return end();
+        }
+        return begin() + index;
+    }
+
+    /**
+     * @brief 返回匹配特定键的元素范围
+     */
+    std::pair<iterator, iterator> equal_range(const key_type & key) const
+    {
+        iterator lower = lower_bound(key);
+        iterator upper = lower != end() && !_comp(key, *lower) ? lower + 1 : lower;
+        return std::pair<iterator, iterator>(lower, upper);
+    }
+
+    /**
+     * @brief 返回指向首个不小于给定键的元素的迭代器
+     */
+    iterator lower_bound(const key_type & key) const
+    {
+        return begin() + _lower_index(key);
+    }
+
+    /**
+     * @brief 返回指向首个大于给定键的元素的迭代器
+     */
+    iterator upper_bound(const key_type & key) const
+    {
+        return equal_range(key).second;
+    }
+
+    // 观察器
+
+    /**
+     * @brief 返回用于比较键的函数
+     */
+    key_compare key_comp() const
+    {
+        return _comp;
+    }
+
+    /**
+     * @brief 返回用于比较值的函数
+     */
+    value_compare value_comp() const
+    {
+        return _comp;
+    }
+
+public:
+    /**
+     * @brief 排序去重后建立索引
+     */
+    void _build()
+    {
+        _keys.erase(_sort_unique(_keys.begin(), _keys.end(), _comp), _keys.end());
+        _keys.shrink_to_fit();
+        _index.build(_keys.data(), _keys.size());
+    }
+
+    /**
+     * @brief 首个不小于key的下标
+     */
+    size_type _lower_index(const key_type & key) const
+    {
+        return _index.lower_bound(_keys.data(), _keys.size(), key, _comp);
+    }
+};
+
+// 非成员函数
+
+template <class Key, class Compare, class Layout>
+bool operator==(const static_set<Key, Compare, Layout> & lhs, const static_set<Key, Compare, Layout> & rhs)
+{
+    return lhs.size() == rhs.size() && std::equal(lhs.begin(), lhs.end(), rhs.begin());
+}
+
+template <class Key, class Compare, class Layout>
+bool operator!=(const static_set<Key, Compare, Layout> & lhs, const static_set<Key, Compare, Layout> & rhs)
+{
+    return !(lhs == rhs);
+}
+
+template <class Key, class Compare, class Layout>
+void swap(static_set<Key, Compare, Layout> & lhs, static_set<Key, Compare, Layout> & rhs) noexcept
+{
+    lhs.swap(rhs);
+}
+
+} // namespace wwstl
+
+#endif // __WW_STATIC_SET_H__
@@ -0,0 +1,245 @@
+#ifndef __WW_STATIC_TABLE_H__
+#define __WW_STATIC_TABLE_H__
+
+#include <algorithm>
+#include <cstddef>
+#include "ww_iterator.h"
+#include "ww_memory.h"
+#include "ww_vector.h"
+
+namespace wwstl
+{
+
+/**
+ * 只读有序表的查找布局
+ *
+ * 有序数组本身用于遍历和存放值，布局在其上建立一份只用于查找的索引，
+ * lower_bound的结果是有序数组中的下标
+ * 每个布局提供：
+ *   index<Key, Compare>                                 索引类型
+ *   index::build(sorted, n)                             由有序且不重复的n个键建立索引
+ *   index::lower_bound(sorted, n, key, comp)            返回首个不小于key的下标，不存在时返回n
+ */
+
+/**
+ * @brief 返回x的二进制最高位的位置，要求x不为0
+ */
+inline std::size_t _floor_log2(std::size_t x) noexcept
+{
+#if defined(__GNUC__) || defined(__clang__)
+    return sizeof(unsigned long long) * 8 - 1 - __builtin_clzll(x);
+#else
+    std::size_t result = 0;
+    while (x >>= 1) {
+        ++result;
+    }
+    return result;
+#endif
+}
+
+/**
+ * @brief 返回x的二进制末尾连续的1的个数
+ */
+inline std::size_t _count_trailing_ones(std::size_t x) noexcept
+{
+#if defined(__GNUC__) || defined(__clang__)
+    return ~x == 0 ? sizeof(std::size_t) * 8 : __builtin_ctzll(~x);
+#else
+    std::size_t result = 0;
+    while (x & 1) {
+        x >>= 1;
+        ++result;
+    }
+    return result;
+#endif
+}
+
+/**
+ * @brief Eytzinger布局的索引
+ * @details 键按完全二叉树的层序存放，节点k的子节点为2k和2k + 1（下标从1开始），
+ *          前几层集中在数组开头，常驻缓存；查找每层只做一次比较并用结果计算下一个下标，没有分支
+ * @details 每轮预取4层之后的16个后代，它们在数组中连续，int键恰好占一个缓存行
+ */
+template <class Key, class Compare>
+class _eytzinger_index
+{
+public:
+    using size_type = std::size_t;
+
+public:
+    wwstl::vector<Key> _keys;   // 层序的键，_keys[k - 1]为节点k
+
+public:
+    void build(const Key * sorted, size_type n)
+    {
+        _keys.clear();
+        _keys.reserve(n);
+        for (size_type k = 1; k <= n; ++k) {
+            _keys.push_back(sorted[_rank(k, n)]);
+        }
+    }
+
+    template <class K>
+    size_type lower_bound(const Key *, size_type n, const K & key, const Compare & comp) const
+    {
+        const Key * keys = _keys.data();
+        size_type k = 1;
+        while (k <= n) {
+            _prefetch(keys + (std::min)(k * 16, n) - 1);
+            k = 2 * k + static_cast<size_type>(comp(keys[k - 1], key));
+        }
+        // 最后一次向左走的节点即为结果，去掉末尾向右走的步数；一直向右时k变为0
+        k >>= _count_trailing_ones(k) + 1;
+        return k == 0 ? n : _rank(k, n);
+    }
+
+    /**
+     * @brief 计算n个节点的完全二叉树中节点k的中序下标
+     * @details 先按高度相同的满二叉树计算中序下标r，再减去最后一层中缺失且排在它之前的叶子，
+     *          最后一层的第i个位置在满二叉树中的中序下标为2i
+     */
+    static size_type _rank(size_type k, size_type n)
+    {
+        const size_type height = _floor_log2(n);
+        const size_type depth = _floor_log2(k);
+        const size_type r = ((2 * (k - (size_type(1) << depth)) + 1) << (height - depth)) - 1;
+        const size_type last_level = n - ((size_type(1) << height) - 1);
+        const size_type half = (r + 1) / 2;
+        return half > last_level ? r - (half - last_level) : r;
+    }
+};
+
+/**
+ * @brief B+树分块布局的索引
+ * @details 每块存放一个缓存行的键，块内B个键把查找范围分为B + 1个子块，
+ *          最底层直接使用有序数组，上面的各层只保存分隔键，额外空间约为n / B
+ * @details 块内不做二分，而是统计小于key的键的个数，比较次数固定且没有分支，
+ *          对算术类型和std::less编译器可以向量化
+ */
+template <class Key, class Compare>
+class _btree_index
+{
+public:
+    using size_type = std::size_t;
+
+public:
+    static constexpr size_type _block = sizeof(Key) < 32 ? 64 / sizeof(Key) : 2;   // 每块的键数
+
+public:
+    wwstl::vector<Key> _keys;               // 各层的分隔键，从最上层开始
+    wwstl::vector<size_type> _offsets;      // 每层在_keys中的起点，从最上层开始
+
+public:
+    void build(const Key * sorted, size_type n)
+    {
+        _keys.clear();
+        _offsets.clear();
+        if (n == 0) {
+            return;
+        }
+        // 自底向上计算每层的块数，span为该层一块覆盖的有序数组长度
+        wwstl::vector<size_type> blocks;
+        wwstl::vector<size_type> spans;
+        size_type count = (n + _block - 1) / _block;
+        size_type span = _block;
+        while (count > 1) {
+            count = (count + _block) / (_block + 1);
+            span *= _block + 1;
+            blocks.push_back(count);
+            spans.push_back(span);
+        }
+        // 分隔键i为第i + 1个子块的最小键，不存在的子块用最大键填充
+        for (size_type level = blocks.size(); level-- > 0; ) {
+            _offsets.push_back(_keys.size());
+            const size_type child_span = spans[level] / (_block + 1);
+            for (size_type j = 0; j < blocks[level]; ++j) {
+                for (size_type i = 0; i < _block; ++i) {
+                    const size_type first = (j * (_block + 1) + i + 1) * child_span;
+                    _keys.push_back(sorted[first < n ? first : n - 1]);
+                }
+            }
+        }
+    }
+
+    template <class K>
+    size_type lower_bound(const Key * sorted, size_type n, const K & key, const Compare & comp) const
+    {
+        // 大于最大键时直接返回，此后填充的分隔键都不小于key，不会走到不存在的子块
+        if (n == 0 || comp(sorted[n - 1], key)) {
+            return n;
+        }
+        size_type j = 0;
+        for (size_type level = 0; level < _offsets.size(); ++level) {
+            j = j * (_block + 1) + _count_less(_keys.data() + _offsets[level] + j * _block, _block, key, comp);
+        }
+        const size_type first = j * _block;
+        const size_type length = n - first < _block ? n - first : _block;
+        return first + _count_less(sorted + first, length, key, comp);
+    }
+
+    /**
+     * @brief 统计块中小于key的键的个数
+     */
+    template <class K>
+    static size_type _count_less(const Key * block, size_type length, const K & key, const Compare & comp)
+    {
+        size_type result = 0;
+        if (length == _block) {
+            for (size_type i = 0; i < _block; ++i) {
+                result += static_cast<size_type>(comp(block[i], key));
+            }
+        } else {
+            for (size_type i = 0; i < length; ++i) {
+                result += static_cast<size_type>(comp(block[i], key));
+            }
+        }
+        return result;
+    }
+};
+
+template <class Key, class Compare>
+constexpr std::size_t _btree_index<Key, Compare>::_block;
+
+/**
+ * @brief Eytzinger（层序）查找布局，默认布局
+ * @details 额外空间为一份键的拷贝
+ */
+class eytzinger_layout
+{
+public:
+    template <class Key, class Compare>
+    using index = _eytzinger_index<Key, Compare>;
+};
+
+/**
+ * @brief B+树分块查找布局
+ * @details 每层一个缓存行，访问的缓存行数约为log(n) / log(B + 1)，额外空间约为n / B
+ */
+class btree_layout
+{
+public:
+    template <class Key, class Compare>
+    using index = _btree_index<Key, Compare>;
+};
+
+/**
+ * @brief 对[first, last)中的元素排序并去掉等价的重复元素，每组只保留第一个
+ * @details 已经严格有序时只做一次检查，从set、map或有序数组构建时为O(n)
+ */
+template <class RandomIt, class Compare>
+RandomIt _sort_unique(RandomIt first, RandomIt last, Compare comp)
+{
+    auto not_less = [&comp](const typename wwstl::iterator_traits<RandomIt>::value_type & lhs,
+                            const typename wwstl::iterator_traits<RandomIt>::value_type & rhs) {
+        return !comp(lhs, rhs);
+    };
+    if (std::adjacent_find(first, last, not_less) == last) {
+        return last;
+    }
+    std::stable_sort(first, last, comp);
+    return std::unique(first, last, not_less);
+}
+
+} // namespace wwstl
+
+#endif // __WW_STATIC_TABLE_H__
@@ -0,0 +1,393 @@
+#ifndef __WW_TREE_BALANCE_H__
+#define __WW_TREE_BALANCE_H__
+
+#include <cstdint>
+#include <utility>
+
+namespace wwstl
+{
+
+/**
+ * 二叉搜索树的平衡策略
+ *
+ * rb_tree负责查找、链接、摘下节点和维护子树大小等附加信息，平衡策略只负责在结构变化后恢复平衡
+ * 每个策略提供：
+ *   colored                        是否使用节点颜色；为false时所有节点保持黑色，
+ *                                  头节点是树中唯一的红色节点，迭代器的operator--据此识别头节点
+ *   node_data                      节点中策略自己的字段，作为节点的基类，copy_balance用于复制节点
+ *   insert_fixup(tree, x)          x作为叶子链接到树中后调用
+ *   replace(y, z)                  擦除有两个子节点的z时，y接替z的位置后调用
+ *   erase_fixup(tree, z, x, x_parent)
+ *                                  节点z摘下后调用，x为替代被摘下位置的子节点，x_parent为其父节点
+ *   build_node(tree, x)            按中序批量构建时，x的左右子树都构建完成后调用
+ *   access(tree, x)                非const的find找到x后调用
+ * 旋转统一使用rb_tree的_left_rotate和_right_rotate，子树大小和区间上界随之维护
+ */
+
+/**
+ * @brief 红黑树平衡策略，默认策略
+ * @details 颜色存储在节点的链接部分，紧凑布局下不占用额外空间
+ * @details split、join以及基于它们的集合运算依赖黑高，只支持本策略
+ */
+class red_black_balance
+{
+public:
+    static constexpr bool colored = true;
+
+public:
+    class node_data
+    {
+    public:
+        void copy_balance(const node_data &)
+        { // 颜色由rb_tree复制
+        }
+    };
+
+public:
+    template <class Tree>
+    static void insert_fixup(Tree & tree, typename Tree::node_pointer x)
+    {
+        tree._rebalance(x);
+    }
+
+    template <class NodePointer>
+    static void replace(NodePointer y, NodePointer z)
+    {
+        // y继承z的颜色，被摘下的颜色记录在z上
+        const auto y_color = y->color();
+        y->set_color(z->color());
+        z->set_color(y_color);
+    }
+
+    template <class Tree>
+    static void erase_fixup(Tree & tree, typename Tree::node_pointer z, typename Tree::node_pointer x, typename Tree::node_pointer x_parent)
+    {
+        tree._rebalance_after_erase(z, x, x_parent);
+    }
+
+    template <class Tree>
+    static void build_node(Tree &, typename Tree::node_pointer)
+    { // 颜色由rb_tree按深度设置
+    }
+
+    template <class Tree>
+    static void access(Tree &, typename Tree::node_pointer)
+    {
+    }
+};
+
+/**
+ * @brief AVL树平衡策略
+ * @details 每个节点记录子树高度，左右子树高度至多相差1，树高不超过约1.44log(n)，比红黑树更矮，适合读多写少
+ */
+class avl_balance
+{
+public:
+    static constexpr bool colored = false;
+
+public:
+    class node_data
+    {
+    public:
+        unsigned char _height;      // 子树高度，叶子为1
+
+    public:
+        node_data()
+            : _height(1)
+        {
+        }
+
+    public:
+        void copy_balance(const node_data & other)
+        {
+            _height = other._height;
+        }
+    };
+
+public:
+    template <class Tree>
+    static void insert_fixup(Tree & tree, typename Tree::node_pointer x)
+    {
+        x->_height = 1;
+        _rebalance_path(tree, Tree::_parent(x));
+    }
+
+    template <class NodePointer>
+    static void replace(NodePointer y, NodePointer z)
+    {
+        y->_height = z->_height;
+    }
+
+    template <class Tree>
+    static void erase_fixup(Tree & tree, typename Tree::node_pointer, typename Tree::node_pointer, typename Tree::node_pointer x_parent)
+    {
+        _rebalance_path(tree, x_parent);
+    }
+
+    template <class Tree>
+    static void build_node(Tree &, typename Tree::node_pointer x)
+    {
+        _update(x);
+    }
+
+    template <class Tree>
+    static void access(Tree &, typename Tree::node_pointer)
+    {
+    }
+
+public:
+    template <class NodePointer>
+    static int _height_of(NodePointer x)
+    {
+        return x == nullptr ? 0 : x->_height;
+    }
+
+    template <class NodePointer>
+    static void _update(NodePointer x)
+    {
+        const int left = _height_of(x->_left);
+        const int right = _height_of(x->_right);
+        x->_height = static_cast<unsigned char>((left > right ? left : right) + 1);
+    }
+
+    /**
+     * @brief 左旋x并更新x和新子树根的高度
+     */
+    template <class Tree>
+    static void _rotate_left(Tree & tree, typename Tree::node_pointer x)
+    {
+        tree._left_rotate(x);
+        _update(x);
+        _update(Tree::_parent(x));
+    }
+
+    /**
+     * @brief 右旋x并更新x和新子树根的高度
+     */
+    template <class Tree>
+    static void _rotate_right(Tree & tree, typename Tree::node_pointer x)
+    {
+        tree._right_rotate(x);
+        _update(x);
+        _update(Tree::_parent(x));
+    }
+
+    /**
+     * @brief 从x向上到根节点逐个更新高度，高度差为2时旋转
+     */
+    template <class Tree>
+    static void _rebalance_path(Tree & tree, typename Tree::node_pointer x)
+    {
+        while (x != tree._head) {
+            auto parent = Tree::_parent(x);
+            const int balance = _height_of(x->_left) - _height_of(x->_right);
+            if (balance > 1) {
+                if (_height_of(x->_left->_left) < _height_of(x->_left->_right)) {
+                    // LR情况，先左旋左子节点
+                    _rotate_left(tree, x->_left);
+                }
+                _rotate_right(tree, x);
+            } else if (balance < -1) {
+                if (_height_of(x->_right->_right) < _height_of(x->_right->_left)) {
+                    // RL情况，先右旋右子节点
+                    _rotate_right(tree, x->_right);
+                }
+                _rotate_left(tree, x);
+            } else {
+                _update(x);
+            }
+            x = parent;
+        }
+    }
+};
+
+/**
+ * @brief 树堆平衡策略
+ * @details 每个节点有一个随机优先级，树按键有序、按优先级成堆，期望高度O(log n)
+ * @details 擦除有两个子节点的节点时交换两者的优先级，接替者继承原位置的优先级，堆序不变，不需要旋转
+ */
+class treap_balance
+{
+public:
+    static constexpr bool colored = false;
+
+public:
+    class node_data
+    {
+    public:
+        std::uint32_t _priority;    // 优先级，父节点不小于子节点
+
+    public:
+        node_data()
+            : _priority(0)
+        {
+        }
+
+    public:
+        void copy_balance(const node_data & other)
+        {
+            _priority = other._priority;
+        }
+    };
+
+public:
+    template <class Tree>
+    static void insert_fixup(Tree & tree, typename Tree::node_pointer x)
+    {
+        // 优先级大于父节点时上旋
+        x->_priority = _random();
+        while (Tree::_parent(x) != tree._head && Tree::_parent(x)->_priority < x->_priority) {
+            auto parent = Tree::_parent(x);
+            if (parent->_left == x) {
+                tree._right_rotate(parent);
+            } else {
+                tree._left_rotate(parent);
+            }
+        }
+    }
+
+    template <class NodePointer>
+    static void replace(NodePointer y, NodePointer z)
+    {
+        std::swap(y->_priority, z->_priority);
+    }
+
+    template <class Tree>
+    static void erase_fixup(Tree &, typename Tree::node_pointer, typename Tree::node_pointer, typename Tree::node_pointer)
+    { // 摘下的位置至多有一个子节点，子节点直接上移不破坏堆序
+    }
+
+    template <class Tree>
+    static void build_node(Tree &, typename Tree::node_pointer x)
+    {
+        // 形状已经平衡，只需在优先级之间做一次堆化，把较大的优先级换到上面
+        x->_priority = _random();
+        auto cur = x;
+        while (true) {
+            auto larger = cur;
+            if (cur->_left != nullptr && larger->_priority < cur->_left->_priority) {
+                larger = cur->_left;
+            }
+            if (cur->_right != nullptr && larger->_priority < cur->_right->_priority) {
+                larger = cur->_right;
+            }
+            if (larger == cur) {
+                break;
+            }
+            std::swap(cur->_priority, larger->_priority);
+            cur = larger;
+        }
+    }
+
+    template <class Tree>
+    static void access(Tree &, typename Tree::node_pointer)
+    {
+    }
+
+public:
+    /**
+     * @brief 线程局部的xorshift随机数
+     */
+    static std::uint32_t _random()
+    {
+        thread_local std::uint32_t state = 2463534242u;
+        state ^= state << 13;
+        state ^= state >> 17;
+        state ^= state << 5;
+        return state;
+    }
+};
+
+/**
+ * @brief 伸展树平衡策略
+ * @details 插入和非const的find把节点伸展到根，访问集中的键停留在树顶附近，均摊O(log n)
+ * @details 单次操作可能达到O(n)，树的形状随查找改变，const的查找不伸展
+ */
+class splay_balance
+{
+public:
+    static constexpr bool colored = false;
+
+public:
+    class node_data
+    {
+    public:
+        void copy_balance(const node_data &)
+        {
+        }
+    };
+
+public:
+    template <class Tree>
+    static void insert_fixup(Tree & tree, typename Tree::node_pointer x)
+    {
+        _splay(tree, x);
+    }
+
+    template <class NodePointer>
+    static void replace(NodePointer, NodePointer)
+    {
+    }
+
+    template <class Tree>
+    static void erase_fixup(Tree & tree, typename Tree::node_pointer, typename Tree::node_pointer, typename Tree::node_pointer x_parent)
+    {
+        if (x_parent != tree._head) {
+            _splay(tree, x_parent);
+        }
+    }
+
+    template <class Tree>
+    static void build_node(Tree &, typename Tree::node_pointer)
+    {
+    }
+
+    template <class Tree>
+    static void access(Tree & tree, typename Tree::node_pointer x)
+    {
+        _splay(tree, x);
+    }
+
+public:
+    /**
+     * @brief 将x旋转到父节点的位置
+     */
+    template <class Tree>
+    static void _rotate_up(Tree & tree, typename Tree::node_pointer x)
+    {
+        auto parent = Tree::_parent(x);
+        if (parent->_left == x) {
+            tree._right_rotate(parent);
+        } else {
+            tree._left_rotate(parent);
+        }
+    }
+
+    /**
+     * @brief 将x伸展到根节点
+     */
+    template <class Tree>
+    static void _splay(Tree & tree, typename Tree::node_pointer x)
+    {
+        while (Tree::_parent(x) != tree._head) {
+            auto parent = Tree::_parent(x);
+            auto grandparent = Tree::_parent(parent);
+            if (grandparent == tree._head) {
+                // zig
+                _rotate_up(tree, x);
+            } else if ((grandparent->_left == parent) == (parent->_left == x)) {
+                // zig-zig，先旋转父节点
+                _rotate_up(tree, parent);
+                _rotate_up(tree, x);
+            } else {
+                // zig-zag
+                _rotate_up(tree, x);
+                _rotate_up(tree, x);
+            }
+        }
+    }
+};
+
+} // namespace wwstl
+
+#endif // __WW_TREE_BALANCE_H__
@@ -6,16 +6,30 @@
 namespace wwstl
 {
 
+template <
+    class Key,
+    class T,
+    class Hash,
+    class KeyEqual,
+    class Allocator,
+    bool CacheHash,
+    class RehashPolicy
+> class unordered_multimap;
+
 /**
  * @brief unordered_map
  * @link https://zh.cppreference.com/w/cpp/container/unordered_map
+ * @details CacheHash为true时节点缓存键的哈希值，默认只对非平凡的键（如std::string）开启
+ * @details RehashPolicy为桶数策略，可选power_of_two_rehash_policy（默认）和prime_rehash_policy
  */
 template <
     class Key,
     class T,
     class Hash = wwstl::hash<Key>,
     class KeyEqual = std::equal_to<Key>,
-    class Allocator = wwstl::allocator<std::pair<const Key, T>>
+    class Allocator = wwstl::allocator<std::pair<const Key, T>>,
+    bool CacheHash = !std::is_trivial<Key>::value,
+    class RehashPolicy = power_of_two_rehash_policy
 > class unordered_map
 {
 public:
@@ -32,12 +46,15 @@ public:
     using const_reference = const value_type&;
     using pointer = value_type*;
     using const_pointer = const value_type*;
-    using hashtable_type = wwstl::hashtable<key_type, mapped_type, value_type, hasher, key_equal, wwstl::keyExtractor<value_type>, allocator_type>;
+    using hashtable_type = wwstl::hashtable<key_type, mapped_type, value_type, hasher, key_equal, wwstl::keyExtractor<value_type>, allocator_type, CacheHash, RehashPolicy>;
     using iterator = typename hashtable_type::iterator;
     using const_iterator = typename hashtable_type::const_iterator;
     using local_iterator = typename hashtable_type::local_iterator;
     using const_local_iterator = typename hashtable_type::const_local_iterator;
 
+    using node_type = typename hashtable_type::node_type;
+    using insert_return_type = typename hashtable_type::insert_return_type;
+
 public:
     hashtable_type _ht;    // 哈希表
 
@@ -262,6 +279,16 @@ public:
         }
     }
 
+    /**
+     * @brief 以threads个线程插入元素，用于一次性插入大量元素
+     * @details 元素的构造、哈希函数和判等函数会在多个线程中同时调用，需要线程安全且不抛出异常
+     */
+    template <class ForwardIt>
+    void insert(ForwardIt first, ForwardIt last, size_type threads)
+    {
+        _ht.insert_unique(first, last, threads);
+    }
+
     /**
      * @brief 插入元素
      */
@@ -289,6 +316,82 @@ public:
         return _ht.emplace_hint_unique(hint, std::forward<Args>(args)...);
     }
 
+    /**
+     * @brief 键不存在时原位构造元素，键已存在时不做任何事
+     * @details 键已存在时不会分配节点，也不会移动key和args
+     */
+    template <class... Args>
+    std::pair<iterator, bool> try_emplace(const key_type & key, Args&&... args)
+    {
+        return _ht.try_emplace_unique(key, std::forward<Args>(args)...);
+    }
+
+    /**
+     * @brief 键不存在时原位构造元素，键已存在时不做任何事
+     */
+    template <class... Args>
+    std::pair<iterator, bool> try_emplace(key_type && key, Args&&... args)
+    {
+        return _ht.try_emplace_unique(std::move(key), std::forward<Args>(args)...);
+    }
+
+    /**
+     * @brief 使用提示原位构造元素，键已存在时不做任何事
+     * @details 先查找再构造，忽略hint
+     */
+    template <class... Args>
+    iterator try_emplace(const_iterator, const key_type & key, Args&&... args)
+    {
+        return _ht.try_emplace_unique(key, std::forward<Args>(args)...).first;
+    }
+
+    /**
+     * @brief 使用提示原位构造元素，键已存在时不做任何事
+     */
+    template <class... Args>
+    iterator try_emplace(const_iterator, key_type && key, Args&&... args)
+    {
+        return _ht.try_emplace_unique(std::move(key), std::forward<Args>(args)...).first;
+    }
+
+    /**
+     * @brief 键不存在时插入元素，键已存在时赋值
+     * @details 发生插入时返回true，赋值时返回false
+     */
+    template <class M>
+    std::pair<iterator, bool> insert_or_assign(const key_type & key, M && obj)
+    {
+        return _ht.insert_or_assign_unique(key, std::forward<M>(obj));
+    }
+
+    /**
+     * @brief 键不存在时插入元素，键已存在时赋值
+     */
+    template <class M>
+    std::pair<iterator, bool> insert_or_assign(key_type && key, M && obj)
+    {
+        return _ht.insert_or_assign_unique(std::move(key), std::forward<M>(obj));
+    }
+
+    /**
+     * @brief 使用提示插入或赋值
+     * @details 忽略hint
+     */
+    template <class M>
+    iterator insert_or_assign(const_iterator, const key_type & key, M && obj)
+    {
+        return _ht.insert_or_assign_unique(key, std::forward<M>(obj)).first;
+    }
+
+    /**
+     * @brief 使用提示插入或赋值
+     */
+    template <class M>
+    iterator insert_or_assign(const_iterator, key_type && key, M && obj)
+    {
+        return _ht.insert_or_assign_unique(std::move(key), std::forward<M>(obj)).first;
+    }
+
     /**
      * @brief 擦除元素
      */
@@ -320,6 +423,57 @@ public:
     { _ht.swap(other._ht);
     }
 
+    /**
+     * @brief 摘下pos指向的节点，不销毁元素
+     */
+    node_type extract(const_iterator pos)
+    {
+        return _ht.extract(pos);
+    }
+
+    /**
+     * @brief 摘下首个键等于key的节点，不存在时返回空句柄
+     */
+    node_type extract(const key_type & key)
+    {
+        return _ht.extract(key);
+    }
+
+    /**
+     * @brief 插入节点句柄
+     */
+    insert_return_type insert(node_type && nh)
+    {
+        return _ht.insert_unique(std::move(nh));
+    }
+
+    /**
+     * @brief 根据提示插入节点句柄
+     */
+    iterator insert(const_iterator hint, node_type && nh)
+    {
+        // 忽略hint
+        return _ht.insert_unique(std::move(nh)).position;
+    }
+
+    /**
+     * @brief 从source中拼接节点，键已存在的节点留在source中
+     */
+    template <class H2, class E2>
+    void merge(unordered_map<Key, T, H2, E2, Allocator, CacheHash, RehashPolicy> & source)
+    {
+        _ht.merge_unique(source._ht);
+    }
+
+    /**
+     * @brief 从source中拼接节点，键已存在的节点留在source中
+     */
+    template <class H2, class E2>
+    void merge(unordered_multimap<Key, T, H2, E2, Allocator, CacheHash, RehashPolicy> & source)
+    {
+        _ht.merge_unique(source._ht);
+    }
+
     // 查找
 
     /**
@@ -351,7 +505,35 @@ public:
      */
     mapped_type & operator[](key_type && key)
     {
-        return _ht[key];
+        return _ht[std::move(key)];
+    }
+
+    /**
+     * @brief 批量查找，依次将每个键的查找结果写入out，不存在时写入end()
+     * @details 多个键的访存交错进行，适合一次查找大量键
+     */
+    template <class ForwardIt, class OutputIt>
+    OutputIt find_many(ForwardIt first, ForwardIt last, OutputIt out)
+    {
+        return _ht.find_many(first, last, out);
+    }
+
+    /**
+     * @brief 批量查找，依次将每个键的查找结果写入out，不存在时写入end()
+     */
+    template <class ForwardIt, class OutputIt>
+    OutputIt find_many(ForwardIt first, ForwardIt last, OutputIt out) const
+    {
+        return _ht.find_many(first, last, out);
+    }
+
+    /**
+     * @brief 批量计数，依次将匹配每个键的元素数量写入out
+     */
+    template <class ForwardIt, class OutputIt>
+    OutputIt count_many(ForwardIt first, ForwardIt last, OutputIt out) const
+    {
+        return _ht.count_many(first, last, out);
     }
 
     /**
@@ -362,6 +544,16 @@ public:
         return _ht.count(key);
     }
 
+    /**
+     * @brief 返回匹配特定键的元素数量
+     * @details 异构查找，要求哈希函数和键比较函数都定义is_transparent
+     */
+    template <class K, class H = hasher, class E = key_equal, class = typename H::is_transparent, class = typename E::is_transparent>
+    size_type count(const K & key) const
+    {
+        return _ht.count(key);
+    }
+
     /**
      * @brief 返回匹配特定键的元素
      */
@@ -370,6 +562,16 @@ public:
         return _ht.find(key);
     }
 
+    /**
+     * @brief 返回匹配特定键的元素
+     * @details 异构查找，要求哈希函数和键比较函数都定义is_transparent
+     */
+    template <class K, class H = hasher, class E = key_equal, class = typename H::is_transparent, class = typename E::is_transparent>
+    iterator find(const K & key)
+    {
+        return _ht.find(key);
+    }
+
     /**
      * @brief 返回匹配特定键的元素
      */
@@ -378,6 +580,16 @@ public:
         return _ht.find(key);
     }
 
+    /**
+     * @brief 返回匹配特定键的元素
+     * @details 异构查找，要求哈希函数和键比较函数都定义is_transparent
+     */
+    template <class K, class H = hasher, class E = key_equal, class = typename H::is_transparent, class = typename E::is_transparent>
+    const_iterator find(const K & key) const
+    {
+        return _ht.find(key);
+    }
+
     /**
      * @brief 返回匹配特定键的元素范围
      */
@@ -386,6 +598,16 @@ public:
         return _ht.equal_range(key);
     }
 
+    /**
+     * @brief 返回匹配特定键的元素范围
+     * @details 异构查找，要求哈希函数和键比较函数都定义is_transparent
+     */
+    template <class K, class H = hasher, class E = key_equal, class = typename H::is_transparent, class = typename E::is_transparent>
+    std::pair<iterator, iterator> equal_range(const K & key)
+    {
+        return _ht.equal_range(key);
+    }
+
     /**
      * @brief 返回匹配特定键的元素范围
      */
@@ -394,6 +616,16 @@ public:
         return _ht.equal_range(key);
     }
 
+    /**
+     * @brief 返回匹配特定键的元素范围
+     * @details 异构查找，要求哈希函数和键比较函数都定义is_transparent
+     */
+    template <class K, class H = hasher, class E = key_equal, class = typename H::is_transparent, class = typename E::is_transparent>
+    std::pair<const_iterator, const_iterator> equal_range(const K & key) const
+    {
+        return _ht.equal_range(key);
+    }
+
     // 桶接口
 
     /**
@@ -502,6 +734,23 @@ public:
         _ht.max_load_factor(ml);
     }
 
+    /**
+     * @brief 扩容时是否增量重建
+     */
+    bool incremental_rehash() const
+    {
+        return _ht.incremental_rehash();
+    }
+
+    /**
+     * @brief 设置扩容时是否增量重建
+     * @details 开启后扩容时节点在之后的插入中分批迁移到新桶，避免单次插入重建整个表
+     */
+    void incremental_rehash(bool enable)
+    {
+        _ht.incremental_rehash(enable);
+    }
+
     /**
      * @brief 预留至少指定数量的桶并重新生成散列表
      */
@@ -510,6 +759,14 @@ public:
         _ht.rehash(count);
     }
 
+    /**
+     * @brief 以threads个线程重新生成散列表
+     */
+    void rehash(size_type count, size_type threads)
+    {
+        _ht.rehash(count, threads);
+    }
+
     /**
      * @brief 为至少指定数量的元素预留空间并重新生成散列表
      */
@@ -544,9 +801,11 @@ template <
     class T,
     class Hash,
     class KeyEqual,
-    class Allocator
-> bool operator==(const unordered_map<Key, T, Hash, KeyEqual, Allocator> & lhs,
-                  const unordered_map<Key, T, Hash, KeyEqual, Allocator> & rhs)
+    class Allocator,
+    bool CacheHash,
+    class RehashPolicy
+> bool operator==(const unordered_map<Key, T, Hash, KeyEqual, Allocator, CacheHash, RehashPolicy> & lhs,
+                  const unordered_map<Key, T, Hash, KeyEqual, Allocator, CacheHash, RehashPolicy> & rhs)
 {
     if (lhs.size() != rhs.size())
         return false;
@@ -565,9 +824,11 @@ template <
     class T,
     class Hash,
     class KeyEqual,
-    class Allocator
-> bool operator!=(const unordered_map<Key, T, Hash, KeyEqual, Allocator> & lhs,
-                  const unordered_map<Key, T, Hash, KeyEqual, Allocator> & rhs)
+    class Allocator,
+    bool CacheHash,
+    class RehashPolicy
+> bool operator!=(const unordered_map<Key, T, Hash, KeyEqual, Allocator, CacheHash, RehashPolicy> & lhs,
+                  const unordered_map<Key, T, Hash, KeyEqual, Allocator, CacheHash, RehashPolicy> & rhs)
 {
     return !(lhs == rhs);
 }
@@ -577,9 +838,11 @@ template <
     class T,
     class Hash,
     class KeyEqual,
-    class Allocator
-> void swap(unordered_map<Key, T, Hash, KeyEqual, Allocator> & lhs,
-            unordered_map<Key, T, Hash, KeyEqual, Allocator> & rhs)
+    class Allocator,
+    bool CacheHash,
+    class RehashPolicy
+> void swap(unordered_map<Key, T, Hash, KeyEqual, Allocator, CacheHash, RehashPolicy> & lhs,
+            unordered_map<Key, T, Hash, KeyEqual, Allocator, CacheHash, RehashPolicy> & rhs)
 {
     lhs.swap(rhs);
 }
@@ -587,13 +850,17 @@ template <
 /**
  * @brief unordered_multimap
  * @link https://zh.cppreference.com/w/cpp/container/unordered_multimap
+ * @details CacheHash为true时节点缓存键的哈希值，默认只对非平凡的键（如std::string）开启
+ * @details RehashPolicy为桶数策略，可选power_of_two_rehash_policy（默认）和prime_rehash_policy
  */
 template <
     class Key,
     class T,
     class Hash = wwstl::hash<Key>,
     class KeyEqual = std::equal_to<Key>,
-    class Allocator = wwstl::allocator<std::pair<const Key, T>>
+    class Allocator = wwstl::allocator<std::pair<const Key, T>>,
+    bool CacheHash = !std::is_trivial<Key>::value,
+    class RehashPolicy = power_of_two_rehash_policy
 > class unordered_multimap
 {
 public:
@@ -610,12 +877,14 @@ public:
     using const_reference = const value_type&;
     using pointer = value_type*;
     using const_pointer = const value_type*;
-    using hashtable_type = wwstl::hashtable<key_type, mapped_type, value_type, hasher, key_equal, wwstl::keyExtractor<value_type>, allocator_type>;
+    using hashtable_type = wwstl::hashtable<key_type, mapped_type, value_type, hasher, key_equal, wwstl::keyExtractor<value_type>, allocator_type, CacheHash, RehashPolicy>;
     using iterator = typename hashtable_type::iterator;
     using const_iterator = typename hashtable_type::const_iterator;
     using local_iterator = typename hashtable_type::local_iterator;
     using const_local_iterator = typename hashtable_type::const_local_iterator;
 
+    using node_type = typename hashtable_type::node_type;
+
 public:
     hashtable_type _ht;    // 哈希表
 
@@ -840,6 +1109,16 @@ public:
         }
     }
 
+    /**
+     * @brief 以threads个线程插入元素，用于一次性插入大量元素
+     * @details 元素的构造、哈希函数和判等函数会在多个线程中同时调用，需要线程安全且不抛出异常
+     */
+    template <class ForwardIt>
+    void insert(ForwardIt first, ForwardIt last, size_type threads)
+    {
+        _ht.insert_equal(first, last, threads);
+    }
+
     /**
      * @brief 插入元素
      */
@@ -898,8 +1177,87 @@ public:
         _ht.swap(other._ht);
     }
 
+    /**
+     * @brief 摘下pos指向的节点，不销毁元素
+     */
+    node_type extract(const_iterator pos)
+    {
+        return _ht.extract(pos);
+    }
+
+    /**
+     * @brief 摘下首个键等于key的节点，不存在时返回空句柄
+     */
+    node_type extract(const key_type & key)
+    {
+        return _ht.extract(key);
+    }
+
+    /**
+     * @brief 插入节点句柄
+     */
+    iterator insert(node_type && nh)
+    {
+        return _ht.insert_equal(std::move(nh));
+    }
+
+    /**
+     * @brief 根据提示插入节点句柄
+     */
+    iterator insert(const_iterator hint, node_type && nh)
+    {
+        // 忽略hint
+        return _ht.insert_equal(std::move(nh));
+    }
+
+    /**
+     * @brief 从source中拼接所有节点
+     */
+    template <class H2, class E2>
+    void merge(unordered_multimap<Key, T, H2, E2, Allocator, CacheHash, RehashPolicy> & source)
+    {
+        _ht.merge_equal(source._ht);
+    }
+
+    /**
+     * @brief 从source中拼接所有节点
+     */
+    template <class H2, class E2>
+    void merge(unordered_map<Key, T, H2, E2, Allocator, CacheHash, RehashPolicy> & source)
+    {
+        _ht.merge_equal(source._ht);
+    }
+
     // 查找
 
+    /**
+     * @brief 批量查找，依次将每个键的查找结果写入out，不存在时写入end()
+     * @details 多个键的访存交错进行，适合一次查找大量键
+     */
+    template <class ForwardIt, class OutputIt>
+    OutputIt find_many(ForwardIt first, ForwardIt last, OutputIt out)
+    {
+        return _ht.find_many(first, last, out);
+    }
+
+    /**
+     * @brief 批量查找，依次将每个键的查找结果写入out，不存在时写入end()
+     */
+    template <class ForwardIt, class OutputIt>
+    OutputIt find_many(ForwardIt first, ForwardIt last, OutputIt out) const
+    {
+        return _ht.find_many(first, last, out);
+    }
+
+    /**
+     * @brief 批量计数，依次将匹配每个键的元素数量写入out
+     */
+    template <class ForwardIt, class OutputIt>
+    OutputIt count_many(ForwardIt first, ForwardIt last, OutputIt out) const
+    {
+        return _ht.count_many(first, last, out);
+    }
+
     /**
      * @brief 返回匹配特定键的元素数量
      */
@@ -908,6 +1266,16 @@ public:
         return _ht.count(key);
     }
 
+    /**
+     * @brief 返回匹配特定键的元素数量
+     * @details 异构查找，要求哈希函数和键比较函数都定义is_transparent
+     */
+    template <class K, class H = hasher, class E = key_equal, class = typename H::is_transparent, class = typename E::is_transparent>
+    size_type count(const K & key) const
+    {
+        return _ht.count(key);
+    }
+
     /**
      * @brief 返回匹配特定键的元素
      */
@@ -916,6 +1284,16 @@ public:
         return _ht.find(key);
     }
 
+    /**
+     * @brief 返回匹配特定键的元素
+     * @details 异构查找，要求哈希函数和键比较函数都定义is_transparent
+     */
+    template <class K, class H = hasher, class E = key_equal, class = typename H::is_transparent, class = typename E::is_transparent>
+    iterator find(const K & key)
+    {
+        return _ht.find(key);
+    }
+
     /**
      * @brief 返回匹配特定键的元素
      */
@@ -924,6 +1302,16 @@ public:
         return _ht.find(key);
     }
 
+    /**
+     * @brief 返回匹配特定键的元素
+     * @details 异构查找，要求哈希函数和键比较函数都定义is_transparent
+     */
+    template <class K, class H = hasher, class E = key_equal, class = typename H::is_transparent, class = typename E::is_transparent>
+    const_iterator find(const K & key) const
+    {
+        return _ht.find(key);
+    }
+
     /**
      * @brief 返回匹配特定键的元素范围
      */
@@ -932,6 +1320,16 @@ public:
         return _ht.equal_range(key);
     }
 
+    /**
+     * @brief 返回匹配特定键的元素范围
+     * @details 异构查找，要求哈希函数和键比较函数都定义is_transparent
+     */
+    template <class K, class H = hasher, class E = key_equal, class = typename H::is_transparent, class = typename E::is_transparent>
+    std::pair<iterator, iterator> equal_range(const K & key)
+    {
+        return _ht.equal_range(key);
+    }
+
     /**
      * @brief 返回匹配特定键的元素范围
      */
@@ -940,6 +1338,16 @@ public:
         return _ht.equal_range(key);
     }
 
+    /**
+     * @brief 返回匹配特定键的元素范围
+     * @details 异构查找，要求哈希函数和键比较函数都定义is_transparent
+     */
+    template <class K, class H = hasher, class E = key_equal, class = typename H::is_transparent, class = typename E::is_transparent>
+    std::pair<const_iterator, const_iterator> equal_range(const K & key) const
+    {
+        return _ht.equal_range(key);
+    }
+
     // 桶接口
 
     /**
@@ -1048,6 +1456,23 @@ public:
         _ht.max_load_factor(ml);
     }
 
+    /**
+     * @brief 扩容时是否增量重建
+     */
+    bool incremental_rehash() const
+    {
+        return _ht.incremental_rehash();
+    }
+
+    /**
+     * @brief 设置扩容时是否增量重建
+     * @details 开启后扩容时节点在之后的插入中分批迁移到新桶，避免单次插入重建整个表
+     */
+    void incremental_rehash(bool enable)
+    {
+        _ht.incremental_rehash(enable);
+    }
+
     /**
      * @brief 预留至少指定数量的桶并重新生成散列表
      */
@@ -1056,6 +1481,14 @@ public:
         _ht.rehash(count);
     }
 
+    /**
+     * @brief 以threads个线程重新生成散列表
+     */
+    void rehash(size_type count, size_type threads)
+    {
+        _ht.rehash(count, threads);
+    }
+
     /**
      * @brief 为至少指定数量的元素预留空间并重新生成散列表
      */
@@ -1090,9 +1523,11 @@ template <
     class T,
     class Hash,
     class KeyEqual,
-    class Allocator
-> bool operator==(const unordered_multimap<Key, T, Hash, KeyEqual, Allocator> & lhs,
-                  const unordered_multimap<Key, T, Hash, KeyEqual, Allocator> & rhs)
+    class Allocator,
+    bool CacheHash,
+    class RehashPolicy
+> bool operator==(const unordered_multimap<Key, T, Hash, KeyEqual, Allocator, CacheHash, RehashPolicy> & lhs,
+                  const unordered_multimap<Key, T, Hash, KeyEqual, Allocator, CacheHash, RehashPolicy> & rhs)
 {
     if (lhs.size() != rhs.size())
         return false;
@@ -1114,9 +1549,11 @@ template <
     class T,
     class Hash,
     class KeyEqual,
-    class Allocator
-> bool operator!=(const unordered_multimap<Key, T, Hash, KeyEqual, Allocator> & lhs,
-                  const unordered_multimap<Key, T, Hash, KeyEqual, Allocator> & rhs)
+    class Allocator,
+    bool CacheHash,
+    class RehashPolicy
+> bool operator!=(const unordered_multimap<Key, T, Hash, KeyEqual, Allocator, CacheHash, RehashPolicy> & lhs,
+                  const unordered_multimap<Key, T, Hash, KeyEqual, Allocator, CacheHash, RehashPolicy> & rhs)
 {
     return !(lhs == rhs);
 }
@@ -1126,9 +1563,11 @@ template <
     class T,
     class Hash,
     class KeyEqual,
-    class Allocator
-> void swap(unordered_multimap<Key, T, Hash, KeyEqual, Allocator> & lhs,
-            unordered_multimap<Key, T, Hash, KeyEqual, Allocator> & rhs)
+    class Allocator,
+    bool CacheHash,
+    class RehashPolicy
+> void swap(unordered_multimap<Key, T, Hash, KeyEqual, Allocator, CacheHash, RehashPolicy> & lhs,
+            unordered_multimap<Key, T, Hash, KeyEqual, Allocator, CacheHash, RehashPolicy> & rhs)
 {
     lhs.swap(rhs);
 }
@@ -6,15 +6,28 @@
 namespace wwstl
 {
 
+template <
+    class Key,
+    class Hash,
+    class KeyEqual,
+    class Allocator,
+    bool CacheHash,
+    class RehashPolicy
+> class unordered_multiset;
+
 /**
  * @brief unordered_set
  * @link https://zh.cppreference.com/w/cpp/container/unordered_set
+ * @details CacheHash为true时节点缓存键的哈希值，默认只对非平凡的键（如std::string）开启
+ * @details RehashPolicy为桶数策略，可选power_of_two_rehash_policy（默认）和prime_rehash_policy
  */
 template <
     class Key,
     class Hash = wwstl::hash<Key>,
     class KeyEqual = std::equal_to<Key>,
-    class Allocator = wwstl::allocator<Key>
+    class Allocator = wwstl::allocator<Key>,
+    bool CacheHash = !std::is_trivial<Key>::value,
+    class RehashPolicy = power_of_two_rehash_policy
 > class unordered_set
 {
 public:
@@ -29,12 +42,15 @@ public:
     using const_reference = const value_type&;
     using pointer = value_type*;
     using const_pointer = const value_type*;
-    using hashtable_type = wwstl::hashtable<key_type, void, value_type, hasher, key_equal, wwstl::keyExtractor<value_type>, allocator_type>;
+    using hashtable_type = wwstl::hashtable<key_type, void, value_type, hasher, key_equal, wwstl::keyExtractor<value_type>, allocator_type, CacheHash, RehashPolicy>;
     using iterator = typename hashtable_type::iterator;
     using const_iterator = typename hashtable_type::const_iterator;
     using local_iterator = typename hashtable_type::local_iterator;
     using const_local_iterator = typename hashtable_type::const_local_iterator;
 
+    using node_type = typename hashtable_type::node_type;
+    using insert_return_type = typename hashtable_type::insert_return_type;
+
 public:
     hashtable_type _ht;     // 哈希表
 
@@ -256,6 +272,16 @@ public:
         }
     }
 
+    /**
+     * @brief 以threads个线程插入元素，用于一次性插入大量元素
+     * @details 元素的构造、哈希函数和判等函数会在多个线程中同时调用，需要线程安全且不抛出异常
+     */
+    template <class ForwardIt>
+    void insert(ForwardIt first, ForwardIt last, size_type threads)
+    {
+        _ht.insert_unique(first, last, threads);
+    }
+
     /**
      * @brief 插入元素
      */
@@ -315,8 +341,87 @@ public:
         _ht.swap(other._ht);
     }
 
+    /**
+     * @brief 摘下pos指向的节点，不销毁元素
+     */
+    node_type extract(const_iterator pos)
+    {
+        return _ht.extract(pos);
+    }
+
+    /**
+     * @brief 摘下首个键等于key的节点，不存在时返回空句柄
+     */
+    node_type extract(const key_type & key)
+    {
+        return _ht.extract(key);
+    }
+
+    /**
+     * @brief 插入节点句柄
+     */
+    insert_return_type insert(node_type && nh)
+    {
+        return _ht.insert_unique(std::move(nh));
+    }
+
+    /**
+     * @brief 根据提示插入节点句柄
+     */
+    iterator insert(const_iterator hint, node_type && nh)
+    {
+        // 忽略hint
+        return _ht.insert_unique(std::move(nh)).position;
+    }
+
+    /**
+     * @brief 从source中拼接节点，键已存在的节点留在source中
+     */
+    template <class H2, class E2>
+    void merge(unordered_set<Key, H2, E2, Allocator, CacheHash, RehashPolicy> & source)
+    {
+        _ht.merge_unique(source._ht);
+    }
+
+    /**
+     * @brief 从source中拼接节点，键已存在的节点留在source中
+     */
+    template <class H2, class E2>
+    void merge(unordered_multiset<Key, H2, E2, Allocator, CacheHash, RehashPolicy> & source)
+    {
+        _ht.merge_unique(source._ht);
+    }
+
     // 查找
 
+    /**
+     * @brief 批量查找，依次将每个键的查找结果写入out，不存在时写入end()
+     * @details 多个键的访存交错进行，适合一次查找大量键
+     */
+    template <class ForwardIt, class OutputIt>
+    OutputIt find_many(ForwardIt first, ForwardIt last, OutputIt out)
+    {
+        return _ht.find_many(first, last, out);
+    }
+
+    /**
+     * @brief 批量查找，依次将每个键的查找结果写入out，不存在时写入end()
+     */
+    template <class ForwardIt, class OutputIt>
+    OutputIt find_many(ForwardIt first, ForwardIt last, OutputIt out) const
+    {
+        return _ht.find_many(first, last, out);
+    }
+
+    /**
+     * @brief 批量计数，依次将匹配每个键的元素数量写入out
+     */
+    template <class ForwardIt, class OutputIt>
+    OutputIt count_many(ForwardIt first, ForwardIt last, OutputIt out) const
+    {
+        return _ht.count_many(first, last, out);
+    }
+
     /**
      * @brief 返回匹配特定键的元素数量
      */
@@ -325,6 +430,16 @@ public:
         return _ht.count(key);
     }
 
+    /**
+     * @brief 返回匹配特定键的元素数量
+     * @details 异构查找，要求哈希函数和键比较函数都定义is_transparent
+     */
+    template <class K, class H = hasher, class E = key_equal, class = typename H::is_transparent, class = typename E::is_transparent>
+    size_type count(const K & key) const
+    {
+        return _ht.count(key);
+    }
+
     /**
      * @brief 返回匹配特定键的元素
      */
@@ -333,6 +448,16 @@ public:
         return _ht.find(key);
     }
 
+    /**
+     * @brief 返回匹配特定键的元素
+     * @details 异构查找，要求哈希函数和键比较函数都定义is_transparent
+     */
+    template <class K, class H = hasher, class E = key_equal, class = typename H::is_transparent, class = typename E::is_transparent>
+    iterator find(const K & key)
+    {
+        return _ht.find(key);
+    }
+
     /**
      * @brief 返回匹配特定键的元素
      */
@@ -341,6 +466,16 @@ public:
         return _ht.find(key);
     }
 
+    /**
+     * @brief 返回匹配特定键的元素
+     * @details 异构查找，要求哈希函数和键比较函数都定义is_transparent
+     */
+    template <class K, class H = hasher, class E = key_equal, class = typename H::is_transparent, class = typename E::is_transparent>
+    const_iterator find(const K & key) const
+    {
+        return _ht.find(key);
+    }
+
     /**
      * @brief 返回匹配特定键的元素范围
      */
@@ -349,6 +484,16 @@ public:
         return _ht.equal_range(key);
     }
 
+    /**
+     * @brief 返回匹配特定键的元素范围
+     * @details 异构查找，要求哈希函数和键比较函数都定义is_transparent
+     */
+    template <class K, class H = hasher, class E = key_equal, class = typename H::is_transparent, class = typename E::is_transparent>
+    std::pair<iterator, iterator> equal_range(const K & key)
+    {
+        return _ht.equal_range(key);
+    }
+
     /**
      * @brief 返回匹配特定键的元素范围
      */
@@ -357,6 +502,16 @@ public:
         return _ht.equal_range(key);
     }
 
+    /**
+     * @brief 返回匹配特定键的元素范围
+     * @details 异构查找，要求哈希函数和键比较函数都定义is_transparent
+     */
+    template <class K, class H = hasher, class E = key_equal, class = typename H::is_transparent, class = typename E::is_transparent>
+    std::pair<const_iterator, const_iterator> equal_range(const K & key) const
+    {
+        return _ht.equal_range(key);
+    }
+
     // 桶接口
 
     /**
@@ -465,6 +620,23 @@ public:
         _ht.max_load_factor(ml);
     }
 
+    /**
+     * @brief 扩容时是否增量重建
+     */
+    bool incremental_rehash() const
+    {
+        return _ht.incremental_rehash();
+    }
+
+    /**
+     * @brief 设置扩容时是否增量重建
+     * @details 开启后扩容时节点在之后的插入中分批迁移到新桶，避免单次插入重建整个表
+     */
+    void incremental_rehash(bool enable)
+    {
+        _ht.incremental_rehash(enable);
+    }
+
     /**
      * @brief 预留至少指定数量的桶并重新生成散列表
      */
@@ -473,6 +645,14 @@ public:
         _ht.rehash(count);
     }
 
+    /**
+     * @brief 以threads个线程重新生成散列表
+     */
+    void rehash(size_type count, size_type threads)
+    {
+        _ht.rehash(count, threads);
+    }
+
     /**
      * @brief 为至少指定数量的元素预留空间并重新生成散列表
      */
@@ -506,9 +686,11 @@ template <
     class Key,
     class Hash,
     class KeyEqual,
-    class Allocator
-> bool operator==(const unordered_set<Key, Hash, KeyEqual, Allocator> & lhs,
-                  const unordered_set<Key, Hash, KeyEqual, Allocator> & rhs)
+    class Allocator,
+    bool CacheHash,
+    class RehashPolicy
+> bool operator==(const unordered_set<Key, Hash, KeyEqual, Allocator, CacheHash, RehashPolicy> & lhs,
+                  const unordered_set<Key, Hash, KeyEqual, Allocator, CacheHash, RehashPolicy> & rhs)
 {
     if (lhs.size() != rhs.size())
         return false;
@@ -526,9 +708,11 @@ template <
     class Key,
     class Hash,
     class KeyEqual,
-    class Allocator
-> bool operator!=(const unordered_set<Key, Hash, KeyEqual, Allocator> & lhs,
-                  const unordered_set<Key, Hash, KeyEqual, Allocator> & rhs)
+    class Allocator,
+    bool CacheHash,
+    class RehashPolicy
+> bool operator!=(const unordered_set<Key, Hash, KeyEqual, Allocator, CacheHash, RehashPolicy> & lhs,
+                  const unordered_set<Key, Hash, KeyEqual, Allocator, CacheHash, RehashPolicy> & rhs)
 {
     return !(lhs == rhs);
 }
@@ -537,9 +721,11 @@ template <
     class Key,
     class Hash,
     class KeyEqual,
-    class Allocator
-> void swap(unordered_set<Key, Hash, KeyEqual, Allocator> & lhs,
-            unordered_set<Key, Hash, KeyEqual, Allocator> & rhs)
+    class Allocator,
+    bool CacheHash,
+    class RehashPolicy
+> void swap(unordered_set<Key, Hash, KeyEqual, Allocator, CacheHash, RehashPolicy> & lhs,
+            unordered_set<Key, Hash, KeyEqual, Allocator, CacheHash, RehashPolicy> & rhs)
 {
     lhs.swap(rhs);
 }
@@ -547,12 +733,16 @@ template <
 /**
  * @brief unordered_multiset
  * @link https://zh.cppreference.com/w/cpp/container/unordered_multiset
+ * @details CacheHash为true时节点缓存键的哈希值，默认只对非平凡的键（如std::string）开启
+ * @details RehashPolicy为桶数策略，可选power_of_two_rehash_policy（默认）和prime_rehash_policy
  */
 template <
     class Key,
     class Hash = wwstl::hash<Key>,
     class KeyEqual = std::equal_to<Key>,
-    class Allocator = wwstl::allocator<Key>
+    class Allocator = wwstl::allocator<Key>,
+    bool CacheHash = !std::is_trivial<Key>::value,
+    class RehashPolicy = power_of_two_rehash_policy
 > class unordered_multiset
 {
 public:
@@ -567,12 +757,14 @@ public:
     using const_reference = const value_type&;
     using pointer = value_type*;
     using const_pointer = const value_type*;
-    using hashtable_type = wwstl::hashtable<key_type, void, value_type, hasher, key_equal, wwstl::keyExtractor<value_type>, allocator_type>;
+    using hashtable_type = wwstl::hashtable<key_type, void, value_type, hasher, key_equal, wwstl::keyExtractor<value_type>, allocator_type, CacheHash, RehashPolicy>;
     using iterator = typename hashtable_type::iterator;
     using const_iterator = typename hashtable_type::const_iterator;
     using local_iterator = typename hashtable_type::local_iterator;
     using const_local_iterator = typename hashtable_type::const_local_iterator;
 
+    using node_type = typename hashtable_type::node_type;
+
 public:
     hashtable_type _ht;     // 哈希表
 
@@ -794,6 +986,16 @@ public:
         }
     }
 
+    /**
+     * @brief 以threads个线程插入元素，用于一次性插入大量元素
+     * @details 元素的构造、哈希函数和判等函数会在多个线程中同时调用，需要线程安全且不抛出异常
+     */
+    template <class ForwardIt>
+    void insert(ForwardIt first, ForwardIt last, size_type threads)
+    {
+        _ht.insert_equal(first, last, threads);
+    }
+
     /**
      * @brief 插入元素
      */
@@ -853,8 +1055,87 @@ public:
         _ht.swap(other._ht);
     }
 
+    /**
+     * @brief 摘下pos指向的节点，不销毁元素
+     */
+    node_type extract(const_iterator pos)
+    {
+        return _ht.extract(pos);
+    }
+
+    /**
+     * @brief 摘下首个键等于key的节点，不存在时返回空句柄
+     */
+    node_type extract(const key_type & key)
+    {
+        return _ht.extract(key);
+    }
+
+    /**
+     * @brief 插入节点句柄
+     */
+    iterator insert(node_type && nh)
+    {
+        return _ht.insert_equal(std::move(nh));
+    }
+
+    /**
+     * @brief 根据提示插入节点句柄
+     */
+    iterator insert(const_iterator hint, node_type && nh)
+    {
+        // 忽略hint
+        return _ht.insert_equal(std::move(nh));
+    }
+
+    /**
+     * @brief 从source中拼接所有节点
+     */
+    template <class H2, class E2>
+    void merge(unordered_multiset<Key, H2, E2, Allocator, CacheHash, RehashPolicy> & source)
+    {
+        _ht.merge_equal(source._ht);
+    }
+
+    /**
+     * @brief 从source中拼接所有节点
+     */
+    template <class H2, class E2>
+    void merge(unordered_set<Key, H2, E2, Allocator, CacheHash, RehashPolicy> & source)
+    {
+        _ht.merge_equal(source._ht);
+    }
+
     // 查找
 
+    /**
+     * @brief 批量查找，依次将每个键的查找结果写入out，不存在时写入end()
+     * @details 多个键的访存交错进行，适合一次查找大量键
+     */
+    template <class ForwardIt, class OutputIt>
+    OutputIt find_many(ForwardIt first, ForwardIt last, OutputIt out)
+    {
+        return _ht.find_many(first, last, out);
+    }
+
+    /**
+     * @brief 批量查找，依次将每个键的查找结果写入out，不存在时写入end()
+     */
+    template <class ForwardIt, class OutputIt>
+    OutputIt find_many(ForwardIt first, ForwardIt last, OutputIt out) const
+    {
+        return _ht.find_many(first, last, out);
+    }
+
+    /**
+     * @brief 批量计数，依次将匹配每个键的元素数量写入out
+     */
+    template <class ForwardIt, class OutputIt>
+    OutputIt count_many(ForwardIt first, ForwardIt last, OutputIt out) const
+    {
+        return _ht.count_many(first, last, out);
+    }
+
     /**
      * @brief 返回匹配特定键的元素数量
      */
@@ -863,6 +1144,16 @@ public:
         return _ht.count(key);
     }
 
+    /**
+     * @brief 返回匹配特定键的元素数量
+     * @details 异构查找，要求哈希函数和键比较函数都定义is_transparent
+     */
+    template <class K, class H = hasher, class E = key_equal, class = typename H::is_transparent, class = typename E::is_transparent>
+    size_type count(const K & key) const
+    {
+        return _ht.count(key);
+    }
+
     /**
      * @brief 返回匹配特定键的元素
      */
@@ -871,6 +1162,16 @@ public:
         return _ht.find(key);
     }
 
+    /**
+     * @brief 返回匹配特定键的元素
+     * @details 异构查找，要求哈希函数和键比较函数都定义is_transparent
+     */
+    template <class K, class H = hasher, class E = key_equal, class = typename H::is_transparent, class = typename E::is_transparent>
+    iterator find(const K & key)
+    {
+        return _ht.find(key);
+    }
+
     /**
      * @brief 返回匹配特定键的元素
      */
@@ -879,6 +1180,16 @@ public:
         return _ht.find(key);
     }
 
+    /**
+     * @brief 返回匹配特定键的元素
+     * @details 异构查找，要求哈希函数和键比较函数都定义is_transparent
+     */
+    template <class K, class H = hasher, class E = key_equal, class = typename H::is_transparent, class = typename E::is_transparent>
+    const_iterator find(const K & key) const
+    {
+        return _ht.find(key);
+    }
+
     /**
      * @brief 返回匹配特定键的元素范围
      */
@@ -887,6 +1198,16 @@ public:
         return _ht.equal_range(key);
     }
 
+    /**
+     * @brief 返回匹配特定键的元素范围
+     * @details 异构查找，要求哈希函数和键比较函数都定义is_transparent
+     */
+    template <class K, class H = hasher, class E = key_equal, class = typename H::is_transparent, class = typename E::is_transparent>
+    std::pair<iterator, iterator> equal_range(const K & key)
+    {
+        return _ht.equal_range(key);
+    }
+
     /**
      * @brief 返回匹配特定键的元素范围
      */
@@ -895,6 +1216,16 @@ public:
         return _ht.equal_range(key);
     }
 
+    /**
+     * @brief 返回匹配特定键的元素范围
+     * @details 异构查找，要求哈希函数和键比较函数都定义is_transparent
+     */
+    template <class K, class H = hasher, class E = key_equal, class = typename H::is_transparent, class = typename E::is_transparent>
+    std::pair<const_iterator, const_iterator> equal_range(const K & key) const
+    {
+        return _ht.equal_range(key);
+    }
+
     // 桶接口
 
     /**
@@ -1003,6 +1334,23 @@ public:
         _ht.max_load_factor(ml);
     }
 
+    /**
+     * @brief 扩容时是否增量重建
+     */
+    bool incremental_rehash() const
+    {
+        return _ht.incremental_rehash();
+    }
+
+    /**
+     * @brief 设置扩容时是否增量重建
+     * @details 开启后扩容时节点在之后的插入中分批迁移到新桶，避免单次插入重建整个表
+     */
+    void incremental_rehash(bool enable)
+    {
+        _ht.incremental_rehash(enable);
+    }
+
     /**
      * @brief 预留至少指定数量的桶并重新生成散列表
      */
@@ -1011,6 +1359,14 @@ public:
         _ht.rehash(count);
     }
 
+    /**
+     * @brief 以threads个线程重新生成散列表
+     */
+    void rehash(size_type count, size_type threads)
+    {
+        _ht.rehash(count, threads);
+    }
+
     /**
      * @brief 为至少指定数量的元素预留空间并重新生成散列表
      */
@@ -1044,9 +1400,11 @@ template <
     class Key,
     class Hash,
     class KeyEqual,
-    class Allocator
-> bool operator==(const unordered_multiset<Key, Hash, KeyEqual, Allocator> & lhs,
-                  const unordered_multiset<Key, Hash, KeyEqual, Allocator> & rhs)
+    class Allocator,
+    bool CacheHash,
+    class RehashPolicy
+> bool operator==(const unordered_multiset<Key, Hash, KeyEqual, Allocator, CacheHash, RehashPolicy> & lhs,
+                  const unordered_multiset<Key, Hash, KeyEqual, Allocator, CacheHash, RehashPolicy> & rhs)
 {
     if (lhs.size() != rhs.size())
         return false;
@@ -1067,9 +1425,11 @@ template <
     class Key,
     class Hash,
     class KeyEqual,
-    class Allocator
-> bool operator!=(const unordered_multiset<Key, Hash, KeyEqual, Allocator> & lhs,
-                  const unordered_multiset<Key, Hash, KeyEqual, Allocator> & rhs)
+    class Allocator,
+    bool CacheHash,
+    class RehashPolicy
+> bool operator!=(const unordered_multiset<Key, Hash, KeyEqual, Allocator, CacheHash, RehashPolicy> & lhs,
+                  const unordered_multiset<Key, Hash, KeyEqual, Allocator, CacheHash, RehashPolicy> & rhs)
 {
     return !(lhs == rhs);
 }
@@ -1078,9 +1438,11 @@ template <
     class Key,
     class Hash,
     class KeyEqual,
-    class Allocator
-> void swap(unordered_multiset<Key, Hash, KeyEqual, Allocator> & lhs,
-            unordered_multiset<Key, Hash, KeyEqual, Allocator> & rhs)
+    class Allocator,
+    bool CacheHash,
+    class RehashPolicy
+> void swap(unordered_multiset<Key, Hash, KeyEqual, Allocator, CacheHash, RehashPolicy> & lhs,
+            unordered_multiset<Key, Hash, KeyEqual, Allocator, CacheHash, RehashPolicy> & rhs)
 {
     lhs.swap(rhs);
 }
@@ -752,7 +752,7 @@ public:
      */
     iterator insert(const_iterator pos, value_type && value)
     {
-        return insert(pos, 1, value);
+        return _emplace_n(pos, 1, std::move(value));
     }
 
     /**
@@ -774,10 +774,30 @@ public:
         size_type n = std::distance(cbegin(), pos);
         size_type count = std::distance(first, last);
         _check_newsize(count);
-        std::move_backward(_start + n, _finish, _finish + count);
-        std::copy(first, last, _start + n);
+        pointer position = _start + n;
+        const size_type elems_after = _finish - position;
+        if (elems_after > count) {
+            // 末尾的count个元素移动到未初始化空间，其余元素向后移动赋值
+            for (size_type i = 0; i < count; ++i) {
+                wwstl::allocator_traits<allocator_type>::construct(_allocator, _finish + i, std::move(*(_finish - count + i)));
+            }
+            std::move_backward(position, _finish - count, _finish);
+            std::copy(first, last, position);
+        } else {
+            // 插入位置之后的元素全部移动到未初始化空间，超出原末尾的新元素直接构造
+            InputIterator mid = first;
+            std::advance(mid, elems_after);
+            pointer p = _finish;
+            for (InputIterator it = mid; it != last; ++it, ++p) {
+                wwstl::allocator_traits<allocator_type>::construct(_allocator, p, *it);
+            }
+            for (size_type i = 0; i < elems_after; ++i) {
+                wwstl::allocator_traits<allocator_type>::construct(_allocator, p + i, std::move(*(position + i)));
+            }
+            std::copy(first, mid, position);
+        }
         _finish += count;
-        return iterator(_start + n);
+        return iterator(position);
     }
 
     /**
@@ -804,8 +824,8 @@ public:
     {
         pointer p = pos._ptr;
         std::move(p + 1, _finish, p);
-        wwstl::allocator_traits<allocator_type>::destroy(_allocator, _finish);
         --_finish;
+        wwstl::allocator_traits<allocator_type>::destroy(_allocator, _finish);
         return iterator(p);
     }
 
@@ -818,12 +838,12 @@ public:
             return iterator(last._ptr);
 
         pointer p = first._ptr;
-        size_type count = last._ptr - first._ptr;
-        std::move(last._ptr, _finish, p);
-        for (pointer q = last._ptr; q != _finish; ++q) {
+        pointer new_finish = std::move(last._ptr, _finish, p);
+        // 销毁移动后末尾多出的元素
+        for (pointer q = new_finish; q != _finish; ++q) {
             wwstl::allocator_traits<allocator_type>::destroy(_allocator, q);
         }
-        _finish = _finish - count;
+        _finish = new_finish;
         return iterator(p);
     }
 
@@ -993,16 +1013,45 @@ public:
 
     /**
      * @brief 在pos位置插入count个元素
-     * @details TODO 其逻辑仍需完善
+     * @details 先构造临时值，参数引用容器内的元素时不受扩容和移动的影响
+     * @details 原末尾之后是未初始化的空间，只能构造；原末尾之前的位置已有元素，只能赋值
      */
     template <class... Args>
     iterator _emplace_n(const_iterator pos, size_type count, Args&&... args)
     {
         difference_type offset = pos - begin();
+        if (count == 0) {
+            return begin() + offset;
+        }
+        value_type value(std::forward<Args>(args)...);
         _check_newsize(count);     // 判断是否需要扩容
-        std::move_backward(begin() + offset, end(), end() + count);
-        for (size_type i = 0; i < count; ++i) {
-            wwstl::allocator_traits<allocator_type>::construct(_allocator, _start + offset + i, std::forward<Args>(args)...);
+        pointer position = _start + offset;
+        const size_type elems_after = _finish - position;
+        if (count == 1) {
+            // 单个元素，临时值可以直接移动
+            if (elems_after == 0) {
+                wwstl::allocator_traits<allocator_type>::construct(_allocator, _finish, std::move(value));
+            } else {
+                wwstl::allocator_traits<allocator_type>::construct(_allocator, _finish, std::move(*(_finish - 1)));
+                std::move_backward(position, _finish - 1, _finish);
+                *position = std::move(value);
+            }
+        } else if (elems_after > count) {
+            // 末尾的count个元素移动到未初始化空间，其余元素向后移动赋值
+            for (size_type i = 0; i < count; ++i) {
+                wwstl::allocator_traits<allocator_type>::construct(_allocator, _finish + i, std::move(*(_finish - count + i)));
+            }
+            std::move_backward(position, _finish - count, _finish);
+            std::fill_n(position, count, value);
+        } else {
+            // 插入位置之后的元素全部移动到未初始化空间，超出原末尾的新元素直接构造
+            for (size_type i = elems_after; i < count; ++i) {
+                wwstl::allocator_traits<allocator_type>::construct(_allocator, position + i, value);
+            }
+            for (size_type i = 0; i < elems_after; ++i) {
+                wwstl::allocator_traits<allocator_type>::construct(_allocator, position + count + i, std::move(*(position + i)));
+            }
+            std::fill_n(position, elems_after, value);
         }
         _finish += count;
         return begin() + offset;
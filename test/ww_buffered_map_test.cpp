@@ -0,0 +1,125 @@
+#include <gtest/gtest.h>
+#include <ww_buffered_map.h>
+#include <map>
+#include <string>
+#include <vector>
+
+using namespace wwstl;
+
+class WWBufferedMapTest : public testing::Test
+{
+public:
+    buffered_map<int, std::string> m = buffered_map<int, std::string>(4);
+
+protected:
+    void SetUp() override
+    {
+        m.insert({3, "3"});
+        m.insert({1, "1"});
+        m.emplace(4, "4");
+        m.emplace(2, "2");
+    }
+};
+
+// 修改器
+
+TEST_F(WWBufferedMapTest, insert)
+{
+    EXPECT_EQ(m.size(), 4);
+    EXPECT_FALSE(m.insert({1, "x"}));
+    EXPECT_TRUE(m.insert({0, "0"}));
+
+    std::string value;
+    EXPECT_TRUE(m.find(1, value));
+    EXPECT_EQ(value, "1");
+    EXPECT_FALSE(m.find(9, value));
+
+    // 盲写覆盖旧值
+    m.insert_or_assign(1, "one");
+    EXPECT_TRUE(m.find(1, value));
+    EXPECT_EQ(value, "one");
+    EXPECT_EQ(m.size(), 5);
+}
+
+TEST_F(WWBufferedMapTest, erase)
+{
+    m.erase(2);
+    m.erase(9);
+    EXPECT_FALSE(m.contains(2));
+    EXPECT_EQ(m.count(3), 1);
+    EXPECT_EQ(m.size(), 3);
+
+    // 擦除后可以重新插入
+    EXPECT_TRUE(m.emplace(2, "two"));
+    std::string value;
+    EXPECT_TRUE(m.find(2, value));
+    EXPECT_EQ(value, "two");
+
+    m.clear();
+    EXPECT_TRUE(m.empty());
+}
+
+// 查找
+
+TEST_F(WWBufferedMapTest, scan)
+{
+    m.insert_or_assign(5, "5");
+    m.erase(3);
+    std::vector<int> keys;
+    m.scan(2, 5, [&keys](const std::pair<int, std::string> & kv) {
+        keys.push_back(kv.first);
+    });
+    EXPECT_EQ(keys, (std::vector<int>{2, 4}));
+
+    keys.clear();
+    m.for_each([&keys](const std::pair<int, std::string> & kv) {
+        keys.push_back(kv.first);
+    });
+    EXPECT_EQ(keys, (std::vector<int>{1, 2, 4, 5}));
+}
+
+TEST_F(WWBufferedMapTest, random_against_std_map)
+{
+    // 小缓冲区产生多层，随机写入与std::map比较，过程中穿插查找、扫描和合并
+    buffered_map<int, int> bm(8);
+    std::map<int, int> expected;
+    unsigned int seed = 1;
+    for (int i = 0; i < 20000; ++i) {
+        seed = seed * 1103515245 + 12345;
+        int key = static_cast<int>((seed >> 16) % 512);
+        switch ((seed >> 8) % 4) {
+        case 0:
+            EXPECT_EQ(bm.insert({key, i}), expected.insert({key, i}).second);
+            break;
+        case 1:
+            bm.insert_or_assign(key, i);
+            expected[key] = i;
+            break;
+        case 2:
+            bm.erase(key);
+            expected.erase(key);
+            break;
+        default: {
+            int value = -1;
+            auto it = expected.find(key);
+            ASSERT_EQ(bm.find(key, value), it != expected.end());
+            if (it != expected.end()) {
+                ASSERT_EQ(value, it->second);
+            }
+            break;
+        }
+        }
+        if (i % 2500 == 0) {
+            std::vector<std::pair<int, int>> items;
+            bm.for_each([&items](const std::pair<int, int> & kv) {
+                items.push_back(kv);
+            });
+            ASSERT_EQ(items, (std::vector<std::pair<int, int>>(expected.begin(), expected.end())));
+        }
+        if (i % 7000 == 0) {
+            bm.compact();
+            ASSERT_LE(bm._levels.size(), 1);
+        }
+    }
+    EXPECT_EQ(bm.size(), expected.size());
+}
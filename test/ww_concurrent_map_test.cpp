@@ -0,0 +1,167 @@
+#include <gtest/gtest.h>
+#include <ww_concurrent_map.h>
+#include <ww_concurrent_set.h>
+#include <atomic>
+#include <set>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace wwstl;
+
+class WWConcurrentMapTest : public testing::Test
+{
+public:
+    concurrent_map<int, std::string> m;
+
+protected:
+    void SetUp() override
+    {
+        m.insert({3, "3"});
+        m.insert({1, "1"});
+        m.emplace(4, "4");
+        m.emplace(2, "2");
+    }
+};
+
+// 修改器
+
+TEST_F(WWConcurrentMapTest, insert)
+{
+    EXPECT_EQ(m.size(), 4);
+    EXPECT_FALSE(m.insert({1, "x"}));
+    EXPECT_TRUE(m.insert({0, "0"}));
+    EXPECT_EQ(m.size(), 5);
+
+    std::string value;
+    EXPECT_TRUE(m.find(1, value));
+    EXPECT_EQ(value, "1");
+    EXPECT_FALSE(m.find(9, value));
+}
+
+TEST_F(WWConcurrentMapTest, erase)
+{
+    EXPECT_EQ(m.erase(2), 1);
+    EXPECT_EQ(m.erase(2), 0);
+    EXPECT_FALSE(m.contains(2));
+    EXPECT_EQ(m.size(), 3);
+
+    // 擦除后可以重新插入
+    EXPECT_TRUE(m.emplace(2, "two"));
+    std::string value;
+    EXPECT_TRUE(m.find(2, value));
+    EXPECT_EQ(value, "two");
+
+    m.clear();
+    EXPECT_TRUE(m.empty());
+    EXPECT_TRUE(m.insert({7, "7"}));
+}
+
+// 查找
+
+TEST_F(WWConcurrentMapTest, scan)
+{
+    std::vector<int> keys;
+    m.scan(2, 4, [&keys](const std::pair<const int, std::string> & kv) {
+        keys.push_back(kv.first);
+    });
+    EXPECT_EQ(keys, (std::vector<int>{2, 3}));
+
+    keys.clear();
+    m.for_each([&keys](const std::pair<const int, std::string> & kv) {
+        keys.push_back(kv.first);
+    });
+    EXPECT_EQ(keys, (std::vector<int>{1, 2, 3, 4}));
+
+    concurrent_set<int> s = {5, 1, 3};
+    keys.clear();
+    s.for_each([&keys](int key) {
+        keys.push_back(key);
+    });
+    EXPECT_EQ(keys, (std::vector<int>{1, 3, 5}));
+}
+
+// 并发
+
+TEST_F(WWConcurrentMapTest, concurrent_insert_erase)
+{
+    // 每个线程在自己的键段上插入并擦除一半，与单线程的期望结果比较
+    concurrent_set<int> s;
+    const int threads = 4;
+    const int per_thread = 2000;
+    std::vector<std::thread> workers;
+    for (int t = 0; t < threads; ++t) {
+        workers.emplace_back([&s, t]() {
+            for (int i = 0; i < per_thread; ++i) {
+                s.insert(i * threads + t);
+            }
+            for (int i = 0; i < per_thread; i += 2) {
+                s.erase(i * threads + t);
+            }
+        });
+    }
+    for (auto & w : workers) {
+        w.join();
+    }
+    EXPECT_EQ(s.size(), threads * per_thread / 2);
+    int previous = -1;
+    std::size_t visited = 0;
+    s.for_each([&](int key) {
+        EXPECT_LT(previous, key);
+        EXPECT_EQ(key / threads % 2, 1);
+        previous = key;
+        ++visited;
+    });
+    EXPECT_EQ(visited, s.size());
+}
+
+TEST_F(WWConcurrentMapTest, concurrent_contended)
+{
+    // 多个线程竞争同一小段键，每个键最终的存在性由成功次数决定
+    concurrent_set<int> s;
+    const int keys = 64;
+    std::atomic<int> balance[keys];
+    for (auto & b : balance) {
+        b.store(0);
+    }
+    std::atomic<bool> scanning(true);
+    std::atomic<int> unordered(0);
+    std::thread scanner([&]() {
+        while (scanning.load()) {
+            int previous = -1;
+            s.scan(0, keys, [&](int key) {
+                if (key <= previous) {
+                    ++unordered;
+                }
+                previous = key;
+            });
+        }
+    });
+    std::vector<std::thread> workers;
+    for (int t = 0; t < 4; ++t) {
+        workers.emplace_back([&, t]() {
+            unsigned int seed = t + 1;
+            for (int i = 0; i < 20000; ++i) {
+                seed = seed * 1103515245 + 12345;
+                int key = static_cast<int>((seed >> 16) % keys);
+                if (seed & 0x100) {
+                    balance[key] += s.insert(key) ? 1 : 0;
+                } else {
+                    balance[key] -= static_cast<int>(s.erase(key));
+                }
+            }
+        });
+    }
+    for (auto & w : workers) {
+        w.join();
+    }
+    scanning.store(false);
+    scanner.join();
+    EXPECT_EQ(unordered.load(), 0);
+    std::size_t expected = 0;
+    for (int key = 0; key < keys; ++key) {
+        ASSERT_EQ(static_cast<int>(s.count(key)), balance[key].load());
+        expected += balance[key].load();
+    }
+    EXPECT_EQ(s.size(), expected);
+}
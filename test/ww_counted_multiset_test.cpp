@@ -0,0 +1,82 @@
+#include <gtest/gtest.h>
+#include <ww_counted_multiset.h>
+#include <iterator>
+#include <set>
+#include <vector>
+
+using namespace wwstl;
+
+class WWCountedMultisetTest : public testing::Test
+{
+public:
+    counted_multiset<int> s = {3, 1, 3, 2, 3, 1};
+};
+
+// 修改器
+
+TEST_F(WWCountedMultisetTest, insert)
+{
+    EXPECT_EQ(s.size(), 6);
+    EXPECT_EQ(s.distinct_size(), 3);
+    EXPECT_EQ(std::vector<int>(s.begin(), s.end()), (std::vector<int>{1, 1, 2, 3, 3, 3}));
+    EXPECT_EQ(std::vector<int>(s.rbegin(), s.rend()), (std::vector<int>{3, 3, 3, 2, 1, 1}));
+
+    // 新副本位于相同键的最后
+    auto it = s.insert(2);
+    EXPECT_EQ(std::distance(s.begin(), it), 3);
+    it = s.insert(5, 1000000);
+    EXPECT_EQ(*it, 5);
+    EXPECT_EQ(s.count(5), 1000000);
+    EXPECT_EQ(s.size(), 1000007);
+    EXPECT_EQ(s.distinct_size(), 4);
+}
+
+TEST_F(WWCountedMultisetTest, erase)
+{
+    // 擦除一个副本
+    auto it = s.erase(s.find(3));
+    EXPECT_EQ(*it, 3);
+    EXPECT_EQ(s.count(3), 2);
+    it = s.erase(std::next(s.find(1)));
+    EXPECT_EQ(*it, 2);
+    EXPECT_EQ(s.count(1), 1);
+    EXPECT_EQ(std::vector<int>(s.begin(), s.end()), (std::vector<int>{1, 2, 3, 3}));
+
+    // 跨节点的范围
+    it = s.erase(s.begin(), std::next(s.find(3)));
+    EXPECT_EQ(std::vector<int>(s.begin(), s.end()), (std::vector<int>{3}));
+    EXPECT_EQ(it, s.begin());
+
+    EXPECT_EQ(s.erase(3), 1);
+    EXPECT_EQ(s.erase(3), 0);
+    EXPECT_TRUE(s.empty());
+    EXPECT_EQ(s.distinct_size(), 0);
+}
+
+TEST_F(WWCountedMultisetTest, erase_range_against_multiset)
+{
+    // 各种范围擦除与std::multiset的结果一致
+    for (int first = 0; first <= 6; ++first) {
+        for (int last = first; last <= 6; ++last) {
+            counted_multiset<int> counted = s;
+            std::multiset<int> expected(s.begin(), s.end());
+            counted.erase(std::next(counted.begin(), first), std::next(counted.begin(), last));
+            expected.erase(std::next(expected.begin(), first), std::next(expected.begin(), last));
+            ASSERT_EQ(std::vector<int>(counted.begin(), counted.end()), std::vector<int>(expected.begin(), expected.end()));
+            ASSERT_EQ(counted.size(), expected.size());
+        }
+    }
+}
+
+// 查找
+
+TEST_F(WWCountedMultisetTest, equal_range)
+{
+    EXPECT_EQ(s.count(3), 3);
+    EXPECT_EQ(s.count(4), 0);
+    auto range = s.equal_range(1);
+    EXPECT_EQ(std::distance(range.first, range.second), 2);
+    EXPECT_EQ(*s.upper_bound(2), 3);
+    EXPECT_EQ(s.lower_bound(4), s.end());
+    EXPECT_EQ(s.find(4), s.end());
+}
@@ -0,0 +1,295 @@
+#include <gtest/gtest.h>
+#include <ww_flat_hash_map.h>
+#include <iterator>
+#include <random>
+#include <string>
+#include <unordered_map>
+
+using namespace wwstl;
+
+class WWFlatHashMapTest : public testing::Test
+{
+public:
+    flat_hash_map<int, std::string> fmap;
+
+protected:
+    void SetUp() override
+    {
+        fmap.insert({1, "1"});
+        fmap.insert({2, "2"});
+        fmap.insert({3, "3"});
+        fmap.insert({4, "4"});
+    }
+};
+
+// 容量
+
+TEST_F(WWFlatHashMapTest, empty)
+{
+    EXPECT_FALSE(fmap.empty());
+
+    // 默认构造不分配槽
+    flat_hash_map<int, int> empty;
+    EXPECT_TRUE(empty.empty());
+    EXPECT_EQ(empty.bucket_count(), 0);
+    EXPECT_EQ(empty.begin(), empty.end());
+    EXPECT_EQ(empty.find(1), empty.end());
+    EXPECT_EQ(empty.erase(1), 0);
+}
+
+TEST_F(WWFlatHashMapTest, size)
+{
+    EXPECT_EQ(fmap.size(), 4);
+}
+
+// 修改器
+
+TEST_F(WWFlatHashMapTest, clear)
+{
+    const std::size_t buckets = fmap.bucket_count();
+    fmap.clear();
+    EXPECT_TRUE(fmap.empty());
+    EXPECT_EQ(fmap.begin(), fmap.end());
+    EXPECT_EQ(fmap.bucket_count(), buckets);
+}
+
+TEST_F(WWFlatHashMapTest, insert)
+{
+    auto it = fmap.insert(std::pair<const int, std::string>(5, "5"));
+    EXPECT_TRUE(it.second);
+    EXPECT_EQ(it.first->first, 5);
+    EXPECT_EQ(it.first->second, "5");
+    it = fmap.insert({5, "7"});
+    EXPECT_FALSE(it.second);
+    EXPECT_EQ(it.first->second, "5");
+
+    // 插入导致多次扩容
+    for (int i = 0; i < 1000; ++i) {
+        fmap.insert({i, std::to_string(i)});
+    }
+    EXPECT_EQ(fmap.size(), 1000);
+    EXPECT_EQ(std::distance(fmap.begin(), fmap.end()), 1000);
+    EXPECT_LE(fmap.load_factor(), fmap.max_load_factor());
+    for (int i = 5; i < 1000; ++i) {
+        EXPECT_EQ(fmap.at(i), std::to_string(i));
+    }
+}
+
+TEST_F(WWFlatHashMapTest, erase)
+{
+    fmap.insert({
+        {5, "5"},
+        {6, "6"},
+        {7, "7"},
+        {8, "8"},
+    });
+
+    fmap.erase(fmap.begin());
+
+    auto it = fmap.begin();
+    std::advance(it, 3);
+    it = fmap.erase(fmap.begin(), it);
+    EXPECT_EQ(it, fmap.begin());
+    EXPECT_EQ(fmap.size(), 4);
+
+    int key = fmap.begin()->first;
+    EXPECT_EQ(fmap.erase(key), 1);
+    EXPECT_EQ(fmap.erase(key), 0);
+    EXPECT_EQ(fmap.size(), 3);
+}
+
+TEST_F(WWFlatHashMapTest, try_emplace)
+{
+    // 键已存在时不移动参数
+    std::string value = "x";
+    auto res = fmap.try_emplace(1, std::move(value));
+    EXPECT_FALSE(res.second);
+    EXPECT_EQ(res.first->second, "1");
+    EXPECT_EQ(value, "x");
+
+    res = fmap.try_emplace(5, std::move(value));
+    EXPECT_TRUE(res.second);
+    EXPECT_EQ(fmap.at(5), "x");
+
+    // 以多个参数构造值
+    auto it = fmap.try_emplace(fmap.end(), 6, 3, 'a');
+    EXPECT_EQ(it->second, "aaa");
+    EXPECT_EQ(fmap.size(), 6);
+
+    // emplace可以取得键时同样先查找
+    std::string other = "y";
+    EXPECT_FALSE(fmap.emplace(2, std::move(other)).second);
+    EXPECT_EQ(other, "y");
+
+    // 无法直接取得键
+    res = fmap.emplace(std::piecewise_construct, std::forward_as_tuple(7), std::forward_as_tuple(2, 'b'));
+    EXPECT_TRUE(res.second);
+    EXPECT_EQ(res.first->second, "bb");
+}
+
+TEST_F(WWFlatHashMapTest, insert_or_assign)
+{
+    auto res = fmap.insert_or_assign(1, "one");
+    EXPECT_FALSE(res.second);
+    EXPECT_EQ(fmap.at(1), "one");
+
+    res = fmap.insert_or_assign(5, "5");
+    EXPECT_TRUE(res.second);
+    EXPECT_EQ(res.first->second, "5");
+
+    auto it = fmap.insert_or_assign(fmap.begin(), 5, "five");
+    EXPECT_EQ(it->second, "five");
+    EXPECT_EQ(fmap.size(), 5);
+}
+
+TEST_F(WWFlatHashMapTest, random_operations)
+{
+    // 与std::unordered_map对照，大量擦除后墓碑与空槽交错
+    flat_hash_map<int, int> map;
+    std::unordered_map<int, int> expected;
+    std::mt19937 gen(42);
+    for (int i = 0; i < 20000; ++i) {
+        const int key = static_cast<int>(gen() % 2000);
+        switch (gen() % 4) {
+        case 0:
+        case 1:
+            EXPECT_EQ(map.insert({key, i}).second, expected.insert({key, i}).second);
+            break;
+        case 2:
+            EXPECT_EQ(map.erase(key), expected.erase(key));
+            break;
+        default:
+            EXPECT_EQ(map.count(key), expected.count(key));
+            break;
+        }
+    }
+    EXPECT_EQ(map.size(), expected.size());
+    std::size_t visited = 0;
+    for (auto it = map.begin(); it != map.end(); ++it, ++visited) {
+        EXPECT_EQ(expected.at(it->first), it->second);
+    }
+    EXPECT_EQ(visited, expected.size());
+}
+
+TEST_F(WWFlatHashMapTest, node_storage)
+{
+    // 扩容时元素地址不变
+    node_hash_map<int, std::string> nmap;
+    nmap[0] = "0";
+    const std::string * address = &nmap[0];
+    for (int i = 1; i < 1000; ++i) {
+        nmap[i] = std::to_string(i);
+    }
+    EXPECT_EQ(&nmap.at(0), address);
+    EXPECT_EQ(nmap.size(), 1000);
+
+    node_hash_map<int, std::string> copy = nmap;
+    EXPECT_TRUE(copy == nmap);
+    copy.erase(0);
+    EXPECT_FALSE(copy == nmap);
+}
+
+TEST_F(WWFlatHashMapTest, copy_and_move)
+{
+    flat_hash_map<int, std::string> copy(fmap);
+    EXPECT_TRUE(copy == fmap);
+
+    flat_hash_map<int, std::string> moved(std::move(copy));
+    EXPECT_TRUE(moved == fmap);
+    EXPECT_TRUE(copy.empty());
+    copy[9] = "9";
+    EXPECT_EQ(copy.size(), 1);
+
+    moved = copy;
+    EXPECT_TRUE(moved == copy);
+    moved = std::move(fmap);
+    EXPECT_EQ(moved.size(), 4);
+
+    moved.swap(copy);
+    EXPECT_EQ(moved.size(), 1);
+    EXPECT_EQ(copy.size(), 4);
+}
+
+// 查找
+
+TEST_F(WWFlatHashMapTest, at)
+{
+    EXPECT_EQ(fmap.at(1), "1");
+    EXPECT_EQ(fmap.at(4), "4");
+    EXPECT_THROW(fmap.at(5), std::out_of_range);
+}
+
+TEST_F(WWFlatHashMapTest, operator_access)
+{
+    EXPECT_EQ(fmap[1], "1");
+    fmap[5] = "5";
+    EXPECT_EQ(fmap[5], "5");
+    EXPECT_EQ(fmap.size(), 5);
+}
+
+TEST_F(WWFlatHashMapTest, find)
+{
+    EXPECT_EQ(fmap.find(1)->second, "1");
+    EXPECT_EQ(fmap.find(4)->second, "4");
+    EXPECT_EQ(fmap.find(5), fmap.end());
+    EXPECT_EQ(fmap.count(3), 1);
+    EXPECT_EQ(fmap.count(5), 0);
+
+    auto range = fmap.equal_range(2);
+    EXPECT_EQ(range.first->second, "2");
+    EXPECT_EQ(std::next(range.first), range.second);
+    range = fmap.equal_range(5);
+    EXPECT_EQ(range.first, range.second);
+}
+
+TEST_F(WWFlatHashMapTest, heterogeneous_lookup)
+{
+    flat_hash_map<std::string, int, hash<std::string>, std::equal_to<>> smap;
+    smap.insert({"apple", 1});
+    smap.insert({"a long key that does not fit in the small string buffer", 2});
+
+    EXPECT_EQ(smap.find("apple")->second, 1);
+    EXPECT_EQ(smap.count("a long key that does not fit in the small string buffer"), 1);
+    EXPECT_EQ(smap.find("cherry"), smap.end());
+}
+
+// 散列策略
+
+TEST_F(WWFlatHashMapTest, rehash)
+{
+    fmap.rehash(100);
+    EXPECT_EQ(fmap.bucket_count(), 127);
+    EXPECT_EQ(fmap.at(3), "3");
+
+    // 不会缩小到放不下现有元素
+    fmap.rehash(1);
+    EXPECT_EQ(fmap.bucket_count(), 127);
+    fmap.rehash(0);
+    EXPECT_EQ(fmap.bucket_count(), 15);
+    EXPECT_EQ(fmap.size(), 4);
+}
+
+TEST_F(WWFlatHashMapTest, reserve)
+{
+    fmap.reserve(1000);
+    const std::size_t buckets = fmap.bucket_count();
+    EXPECT_GE(buckets * fmap.max_load_factor(), 1000);
+    for (int i = 0; i < 1000; ++i) {
+        fmap[i];
+    }
+    EXPECT_EQ(fmap.bucket_count(), buckets);
+}
+
+// 比较
+
+TEST_F(WWFlatHashMapTest, compare)
+{
+    flat_hash_map<int, std::string> fmap2 = {{1, "1"}, {2, "2"}, {3, "3"}, {4, "4"}};
+    EXPECT_TRUE(fmap == fmap2);
+
+    flat_hash_map<int, std::string> fmap3 = {{1, "1"}, {2, "2"}, {3, "3"}, {4, "4"}, {5, "5"}};
+    EXPECT_FALSE(fmap == fmap3);
+
+    flat_hash_map<int, std::string> fmap4 = {{1, "1"}, {2, "2"}, {3, "3"}, {4, "444"}};
+    EXPECT_TRUE(fmap != fmap4);
+}
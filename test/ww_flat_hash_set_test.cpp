@@ -0,0 +1,126 @@
+#include <gtest/gtest.h>
+#include <ww_flat_hash_set.h>
+#include <iterator>
+#include <random>
+#include <string>
+#include <unordered_set>
+
+using namespace wwstl;
+
+class WWFlatHashSetTest : public testing::Test
+{
+public:
+    flat_hash_set<int> fset;
+
+protected:
+    void SetUp() override
+    {
+        fset.insert({1, 2, 3, 4});
+    }
+};
+
+// 修改器
+
+TEST_F(WWFlatHashSetTest, insert)
+{
+    EXPECT_TRUE(fset.insert(5).second);
+    EXPECT_FALSE(fset.insert(5).second);
+    EXPECT_EQ(*fset.emplace(6).first, 6);
+    EXPECT_EQ(fset.size(), 6);
+}
+
+TEST_F(WWFlatHashSetTest, erase)
+{
+    EXPECT_EQ(fset.erase(1), 1);
+    EXPECT_EQ(fset.erase(1), 0);
+    fset.erase(fset.find(2));
+    EXPECT_EQ(fset.size(), 2);
+    EXPECT_EQ(fset.erase(fset.begin(), fset.end()), fset.end());
+    EXPECT_TRUE(fset.empty());
+}
+
+TEST_F(WWFlatHashSetTest, erase_while_iterating)
+{
+    // 擦除不移动其他元素，erase返回的迭代器可以继续遍历
+    for (int i = 0; i < 1000; ++i) {
+        fset.insert(i);
+    }
+    for (auto it = fset.begin(); it != fset.end(); ) {
+        it = *it % 2 == 0 ? fset.erase(it) : std::next(it);
+    }
+    EXPECT_EQ(fset.size(), 500);
+    for (int i = 0; i < 1000; ++i) {
+        EXPECT_EQ(fset.count(i), static_cast<std::size_t>(i % 2));
+    }
+}
+
+TEST_F(WWFlatHashSetTest, tombstones)
+{
+    // 同一容量下反复插入擦除，墓碑被复用或在重建时清除，容量不会一直增长
+    flat_hash_set<int> set;
+    set.reserve(64);
+    const std::size_t buckets = set.bucket_count();
+    for (int i = 0; i < 100000; ++i) {
+        set.insert(i);
+        if (i >= 32) {
+            set.erase(i - 32);
+        }
+    }
+    EXPECT_EQ(set.size(), 32);
+    EXPECT_EQ(set.bucket_count(), buckets);
+    for (int i = 100000 - 32; i < 100000; ++i) {
+        EXPECT_EQ(set.count(i), 1);
+    }
+}
+
+TEST_F(WWFlatHashSetTest, random_operations)
+{
+    flat_hash_set<std::string> set;
+    std::unordered_set<std::string> expected;
+    std::mt19937 gen(7);
+    for (int i = 0; i < 20000; ++i) {
+        const std::string key = std::to_string(gen() % 3000);
+        if (gen() % 3 == 0) {
+            EXPECT_EQ(set.erase(key), expected.erase(key));
+        } else {
+            EXPECT_EQ(set.insert(key).second, expected.insert(key).second);
+        }
+    }
+    EXPECT_EQ(set.size(), expected.size());
+    EXPECT_EQ(static_cast<std::size_t>(std::distance(set.begin(), set.end())), expected.size());
+    for (const auto & key : expected) {
+        EXPECT_EQ(set.count(key), 1);
+    }
+}
+
+TEST_F(WWFlatHashSetTest, node_storage)
+{
+    node_hash_set<std::string> set = {"a", "b"};
+    const std::string * address = &*set.find("a");
+    for (int i = 0; i < 1000; ++i) {
+        set.insert(std::to_string(i));
+    }
+    EXPECT_EQ(&*set.find("a"), address);
+    EXPECT_EQ(set.size(), 1002);
+}
+
+// 查找
+
+TEST_F(WWFlatHashSetTest, find)
+{
+    EXPECT_EQ(*fset.find(3), 3);
+    EXPECT_EQ(fset.find(5), fset.end());
+    EXPECT_EQ(fset.count(4), 1);
+    auto range = fset.equal_range(1);
+    EXPECT_EQ(std::distance(range.first, range.second), 1);
+}
+
+// 比较
+
+TEST_F(WWFlatHashSetTest, compare)
+{
+    flat_hash_set<int> fset2 = {4, 3, 2, 1};
+    EXPECT_TRUE(fset == fset2);
+    fset2.insert(5);
+    EXPECT_TRUE(fset != fset2);
+}
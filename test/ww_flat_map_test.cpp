@@ -0,0 +1,242 @@
+#include <gtest/gtest.h>
+#include <ww_flat_map.h>
+#include <map>
+#include <string>
+#include <vector>
+
+using namespace wwstl;
+
+class WWFlatMapTest : public testing::Test
+{
+public:
+    flat_map<int, std::string> m;
+
+protected:
+    void SetUp() override
+    {
+        m.insert({3, "3"});
+        m.insert({1, "1"});
+        m.insert({4, "4"});
+        m.insert({2, "2"});
+    }
+};
+
+// 构造
+
+TEST_F(WWFlatMapTest, copy)
+{
+    flat_map<int, std::string> m2(m);
+    EXPECT_TRUE(m == m2);
+
+    flat_map<int, std::string> m3;
+    m3[7] = "7";
+    m3 = m2;
+    EXPECT_TRUE(m == m3);
+    EXPECT_EQ(m3.count(7), 0);
+}
+
+TEST_F(WWFlatMapTest, range_constructor)
+{
+    // 无序输入，重复的键保留第一个
+    std::vector<std::pair<int, std::string>> input = {{3, "3"}, {1, "1"}, {2, "2"}, {1, "x"}, {4, "4"}};
+    flat_map<int, std::string> m2(input.begin(), input.end());
+    EXPECT_TRUE(m == m2);
+    EXPECT_EQ(m2.at(1), "1");
+}
+
+// 元素访问
+
+TEST_F(WWFlatMapTest, at)
+{
+    EXPECT_EQ(m.at(1), "1");
+    EXPECT_EQ(m.at(4), "4");
+    EXPECT_THROW(m.at(5), std::out_of_range);
+}
+
+TEST_F(WWFlatMapTest, operator_brackets)
+{
+    EXPECT_EQ(m[2], "2");
+    m[0] = "0";
+    EXPECT_EQ(m.size(), 5);
+    EXPECT_EQ(m.begin()->first, 0);
+    EXPECT_EQ(m.begin()->second, "0");
+}
+
+// 迭代器
+
+TEST_F(WWFlatMapTest, iterator)
+{
+    int expected = 1;
+    for (auto && kv : m) {
+        EXPECT_EQ(kv.first, expected);
+        EXPECT_EQ(kv.second, std::to_string(expected));
+        ++expected;
+    }
+    EXPECT_EQ(m.end() - m.begin(), 4);
+    EXPECT_EQ(m.begin()[2].first, 3);
+
+    // 通过迭代器修改值
+    m.begin()->second = "one";
+    EXPECT_EQ(m.at(1), "one");
+
+    flat_map<int, std::string>::const_iterator it = m.begin();
+    EXPECT_TRUE(it == m.begin());
+}
+
+TEST_F(WWFlatMapTest, reverse_iterator)
+{
+    EXPECT_EQ(m.rbegin()->first, 4);
+    EXPECT_EQ((*m.rbegin()).second, "4");
+    EXPECT_EQ((--m.rend())->first, 1);
+}
+
+// 修改器
+
+TEST_F(WWFlatMapTest, insert)
+{
+    auto res = m.insert({1, "x"});
+    EXPECT_FALSE(res.second);
+    EXPECT_EQ(res.first->second, "1");
+
+    res = m.insert(std::make_pair(0, std::string("0")));
+    EXPECT_TRUE(res.second);
+    EXPECT_EQ(res.first, m.begin());
+
+    auto it = m.insert(m.end(), {9, "9"});
+    EXPECT_EQ(it->first, 9);
+    it = m.insert(m.begin(), {5, "5"});
+    EXPECT_EQ(it->first, 5);
+    EXPECT_EQ(m.size(), 7);
+}
+
+TEST_F(WWFlatMapTest, insert_range)
+{
+    // 与已有元素交错的批量插入，与std::map比较
+    std::map<int, int> ref;
+    flat_map<int, int> fm;
+    unsigned int seed = 5;
+    for (int round = 0; round < 30; ++round) {
+        std::vector<std::pair<int, int>> batch;
+        int n = round * 11 % 70;
+        for (int i = 0; i < n; ++i) {
+            seed = seed * 1103515245 + 12345;
+            batch.push_back(std::make_pair(static_cast<int>((seed >> 16) % 400), round));
+        }
+        if (round % 5 == 0) {
+            // 全部位于末尾时直接追加
+            for (auto & kv : batch) {
+                kv.first += 1000 * round;
+            }
+        }
+        fm.insert(batch.begin(), batch.end());
+        ref.insert(batch.begin(), batch.end());
+        ASSERT_EQ(fm.size(), ref.size());
+    }
+    auto it = fm.begin();
+    for (auto rit = ref.begin(); rit != ref.end(); ++rit, ++it) {
+        EXPECT_EQ(it->first, rit->first);
+        EXPECT_EQ(it->second, rit->second);
+    }
+}
+
+TEST_F(WWFlatMapTest, emplace)
+{
+    auto res = m.emplace(5, "5");
+    EXPECT_TRUE(res.second);
+    EXPECT_EQ(res.first->second, "5");
+    res = m.emplace(5, "x");
+    EXPECT_FALSE(res.second);
+    auto it = m.emplace_hint(m.end(), 6, "6");
+    EXPECT_EQ(it->first, 6);
+}
+
+TEST_F(WWFlatMapTest, erase)
+{
+    EXPECT_EQ(m.erase(1), 1);
+    EXPECT_EQ(m.erase(1), 0);
+    EXPECT_EQ(m.begin()->first, 2);
+
+    auto it = m.erase(m.begin());
+    EXPECT_EQ(it->first, 3);
+
+    m.erase(m.begin(), m.end());
+    EXPECT_TRUE(m.empty());
+}
+
+TEST_F(WWFlatMapTest, swap)
+{
+    flat_map<int, std::string> m2 = {{7, "7"}};
+    m.swap(m2);
+    EXPECT_EQ(m.size(), 1);
+    EXPECT_EQ(m2.size(), 4);
+}
+
+// 查找
+
+TEST_F(WWFlatMapTest, find)
+{
+    for (int i = 1; i <= 4; ++i) {
+        EXPECT_EQ(m.find(i)->second, std::to_string(i));
+        EXPECT_EQ(m.count(i), 1);
+    }
+    EXPECT_EQ(m.find(0), m.end());
+    EXPECT_EQ(m.find(5), m.end());
+    EXPECT_EQ(m.count(5), 0);
+}
+
+TEST_F(WWFlatMapTest, bounds)
+{
+    EXPECT_EQ(m.lower_bound(2)->first, 2);
+    EXPECT_EQ(m.upper_bound(2)->first, 3);
+    EXPECT_EQ(m.lower_bound(5), m.end());
+    EXPECT_EQ(m.upper_bound(0), m.begin());
+    auto range = m.equal_range(3);
+    EXPECT_EQ(range.first->first, 3);
+    EXPECT_EQ(range.second->first, 4);
+}
+
+TEST_F(WWFlatMapTest, lower_bound_all_sizes)
+{
+    // 覆盖无分支二分在各种长度下的边界
+    for (int n = 0; n < 40; ++n) {
+        flat_map<int, int> fm;
+        for (int i = 0; i < n; ++i) {
+            fm.emplace(i * 2, i);
+        }
+        for (int key = -1; key <= 2 * n; ++key) {
+            int expected = (key + 1) / 2;
+            if (key < 0) {
+                expected = 0;
+            }
+            EXPECT_EQ(fm.lower_bound(key) - fm.begin(), expected);
+            EXPECT_EQ(fm.upper_bound(key) - fm.begin(), key < 0 ? 0 : key / 2 + 1 > n ? n : key / 2 + 1);
+        }
+    }
+}
+
+TEST_F(WWFlatMapTest, heterogeneous_lookup)
+{
+    flat_map<std::string, int, std::less<>> sm = {{"apple", 1}, {"banana", 2}};
+    EXPECT_EQ(sm.find("banana")->second, 2);
+    EXPECT_EQ(sm.count("cherry"), 0);
+    EXPECT_EQ(sm.lower_bound("b")->first, "banana");
+}
+
+// 观察器
+
+TEST_F(WWFlatMapTest, keys_values)
+{
+    EXPECT_EQ(m.keys(), vector<int>({1, 2, 3, 4}));
+    EXPECT_EQ(m.values()[3], "4");
+}
+
+// 比较
+
+TEST_F(WWFlatMapTest, compare)
+{
+    flat_map<int, std::string> m2 = {{1, "1"}, {2, "2"}, {3, "3"}, {4, "4"}};
+    EXPECT_TRUE(m == m2);
+    m2[4] = "5";
+    EXPECT_TRUE(m != m2);
+    EXPECT_TRUE(m < m2);
+}
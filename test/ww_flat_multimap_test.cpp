@@ -0,0 +1,118 @@
+#include <gtest/gtest.h>
+#include <ww_flat_map.h>
+#include <map>
+#include <string>
+#include <vector>
+
+using namespace wwstl;
+
+class WWFlatMultiMapTest : public testing::Test
+{
+public:
+    flat_multimap<int, std::string> mmap;
+
+protected:
+    void SetUp() override
+    {
+        mmap.insert({1, "1"});
+        mmap.insert({2, "2"});
+        mmap.insert({3, "3"});
+        mmap.insert({4, "4"});
+        mmap.insert({1, "11"});
+        mmap.insert({2, "22"});
+        mmap.insert({2, "222"});
+    }
+};
+
+// 迭代器
+
+TEST_F(WWFlatMultiMapTest, begin)
+{
+    EXPECT_EQ(mmap.begin()->second, "1");
+    EXPECT_EQ((mmap.begin() + 1)->second, "11");
+}
+
+TEST_F(WWFlatMultiMapTest, rbegin)
+{
+    EXPECT_EQ(mmap.rbegin()->second, "4");
+    EXPECT_EQ((--mmap.rend())->second, "1");
+}
+
+// 容量
+
+TEST_F(WWFlatMultiMapTest, size)
+{
+    EXPECT_EQ(mmap.size(), 7);
+}
+
+// 修改器
+
+TEST_F(WWFlatMultiMapTest, insert_hint)
+{
+    // 相同键的新元素位于最后
+    auto it = mmap.insert(mmap.begin(), {2, "2222"});
+    EXPECT_EQ(it->second, "2222");
+    EXPECT_EQ((it + 1)->first, 3);
+    it = mmap.insert(mmap.end(), {5, "5"});
+    EXPECT_EQ(it, mmap.end() - 1);
+}
+
+TEST_F(WWFlatMultiMapTest, insert_range)
+{
+    // 批量插入保持相同键的插入顺序，与std::multimap比较
+    std::multimap<int, int> ref;
+    flat_multimap<int, int> fm;
+    unsigned int seed = 9;
+    for (int round = 0; round < 20; ++round) {
+        std::vector<std::pair<int, int>> batch;
+        for (int i = 0; i < round * 7 % 50; ++i) {
+            seed = seed * 1103515245 + 12345;
+            batch.push_back(std::make_pair(static_cast<int>((seed >> 16) % 60), round * 100 + i));
+        }
+        fm.insert(batch.begin(), batch.end());
+        ref.insert(batch.begin(), batch.end());
+    }
+    ASSERT_EQ(fm.size(), ref.size());
+    auto it = fm.begin();
+    for (auto rit = ref.begin(); rit != ref.end(); ++rit, ++it) {
+        EXPECT_EQ(it->first, rit->first);
+        EXPECT_EQ(it->second, rit->second);
+    }
+}
+
+TEST_F(WWFlatMultiMapTest, erase)
+{
+    EXPECT_EQ(mmap.erase(2), 3);
+    EXPECT_EQ(mmap.size(), 4);
+    EXPECT_EQ(mmap.count(2), 0);
+}
+
+// 查找
+
+TEST_F(WWFlatMultiMapTest, count)
+{
+    EXPECT_EQ(mmap.count(1), 2);
+    EXPECT_EQ(mmap.count(2), 3);
+    EXPECT_EQ(mmap.count(4), 1);
+    EXPECT_EQ(mmap.count(5), 0);
+}
+
+TEST_F(WWFlatMultiMapTest, equal_range)
+{
+    auto range = mmap.equal_range(2);
+    EXPECT_EQ(range.second - range.first, 3);
+    EXPECT_EQ(range.first->second, "2");
+    EXPECT_EQ((range.second - 1)->second, "222");
+    EXPECT_EQ(mmap.find(2), range.first);
+}
+
+// 比较
+
+TEST_F(WWFlatMultiMapTest, compare)
+{
+    flat_multimap<int, std::string> m2(mmap);
+    EXPECT_TRUE(mmap == m2);
+    m2.emplace(0, "0");
+    EXPECT_TRUE(mmap != m2);
+    EXPECT_TRUE(m2 < mmap);
+}
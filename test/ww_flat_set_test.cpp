@@ -0,0 +1,144 @@
+#include <gtest/gtest.h>
+#include <ww_flat_set.h>
+#include <set>
+#include <string>
+#include <vector>
+
+using namespace wwstl;
+
+class WWFlatSetTest : public testing::Test
+{
+public:
+    flat_set<int> s = {3, 1, 4, 2};
+};
+
+// 迭代器
+
+TEST_F(WWFlatSetTest, iterator)
+{
+    EXPECT_EQ(*s.begin(), 1);
+    EXPECT_EQ(*--s.end(), 4);
+    EXPECT_EQ(*s.rbegin(), 4);
+    EXPECT_EQ(s.end() - s.begin(), 4);
+}
+
+// 修改器
+
+TEST_F(WWFlatSetTest, insert)
+{
+    EXPECT_FALSE(s.insert(1).second);
+    auto res = s.insert(0);
+    EXPECT_TRUE(res.second);
+    EXPECT_EQ(res.first, s.begin());
+    EXPECT_EQ(*s.insert(s.end(), 9), 9);
+    EXPECT_EQ(*s.insert(s.begin(), 6), 6);
+    EXPECT_EQ(s.size(), 7);
+    EXPECT_TRUE(std::is_sorted(s.begin(), s.end()));
+}
+
+TEST_F(WWFlatSetTest, insert_range)
+{
+    // 批量插入后去重，与std::set比较
+    std::set<int> ref(s.begin(), s.end());
+    unsigned int seed = 11;
+    for (int round = 0; round < 30; ++round) {
+        std::vector<int> batch;
+        for (int i = 0; i < round * 13 % 80; ++i) {
+            seed = seed * 1103515245 + 12345;
+            batch.push_back(static_cast<int>((seed >> 16) % 500));
+        }
+        s.insert(batch.begin(), batch.end());
+        ref.insert(batch.begin(), batch.end());
+        ASSERT_EQ(s.size(), ref.size());
+    }
+    EXPECT_TRUE(std::equal(s.begin(), s.end(), ref.begin()));
+}
+
+TEST_F(WWFlatSetTest, erase)
+{
+    EXPECT_EQ(s.erase(1), 1);
+    EXPECT_EQ(s.erase(1), 0);
+    EXPECT_EQ(*s.erase(s.begin()), 3);
+    s.erase(s.begin(), s.end());
+    EXPECT_TRUE(s.empty());
+}
+
+// 查找
+
+TEST_F(WWFlatSetTest, find)
+{
+    for (int i = 1; i <= 4; ++i) {
+        EXPECT_EQ(*s.find(i), i);
+        EXPECT_EQ(s.count(i), 1);
+    }
+    EXPECT_EQ(s.find(5), s.end());
+    EXPECT_EQ(*s.lower_bound(2), 2);
+    EXPECT_EQ(*s.upper_bound(2), 3);
+    EXPECT_EQ(s.upper_bound(4), s.end());
+}
+
+TEST_F(WWFlatSetTest, heterogeneous_lookup)
+{
+    flat_set<std::string, std::less<>> ss = {"pear", "apple"};
+    EXPECT_EQ(*ss.find("pear"), "pear");
+    EXPECT_EQ(ss.count("plum"), 0);
+}
+
+// 比较
+
+TEST_F(WWFlatSetTest, compare)
+{
+    flat_set<int> s2 = {1, 2, 3, 4};
+    EXPECT_TRUE(s == s2);
+    flat_set<int> s3 = {1, 2, 4, 7};
+    EXPECT_TRUE(s < s3);
+}
+
+class WWFlatMultiSetTest : public testing::Test
+{
+public:
+    flat_multiset<int> s = {3, 1, 2, 1, 2, 2};
+};
+
+TEST_F(WWFlatMultiSetTest, insert)
+{
+    s.insert(2);
+    s.insert(s.begin(), 0);
+    std::vector<int> batch = {5, 1, 5};
+    s.insert(batch.begin(), batch.end());
+    EXPECT_EQ(s.size(), 11);
+    EXPECT_TRUE(std::is_sorted(s.begin(), s.end()));
+}
+
+TEST_F(WWFlatMultiSetTest, count)
+{
+    EXPECT_EQ(s.count(1), 2);
+    EXPECT_EQ(s.count(2), 3);
+    EXPECT_EQ(s.count(4), 0);
+    auto range = s.equal_range(2);
+    EXPECT_EQ(range.second - range.first, 3);
+    EXPECT_EQ(s.erase(2), 3);
+    EXPECT_EQ(s.size(), 3);
+}
+
+TEST_F(WWFlatMultiSetTest, insert_range)
+{
+    // 批量插入与已有元素归并，结果与std::multiset相同
+    flat_multiset<std::string> strs = {"m", "c", "m"};
+    std::multiset<std::string> ref = {"m", "c", "m"};
+    std::vector<std::vector<std::string>> batches = {
+        {"z", "y", "z"},
+        {"a", "m", "b", "m"},
+        {"zz", "zz"},
+        {},
+    };
+    for (const auto & batch : batches) {
+        strs.insert(batch.begin(), batch.end());
+        ref.insert(batch.begin(), batch.end());
+        ASSERT_EQ(strs.size(), ref.size());
+        EXPECT_TRUE(std::equal(strs.begin(), strs.end(), ref.begin()));
+    }
+    EXPECT_EQ(strs.count("m"), 4);
+    EXPECT_EQ(strs.erase("m"), 4);
+    EXPECT_EQ(strs.count("m"), 0);
+}
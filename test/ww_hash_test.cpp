@@ -0,0 +1,183 @@
+#include <gtest/gtest.h>
+#include <ww_hash.h>
+#include <ww_unordered_map.h>
+#include <ww_unordered_set.h>
+#include <algorithm>
+#include <functional>
+#include <string>
+#include <tuple>
+#include <type_traits>
+#include <unordered_set>
+#include <vector>
+
+using namespace wwstl;
+
+class WWHashTest : public testing::Test
+{
+public:
+    /**
+     * @brief 按hash值的低bits位分桶，返回最大的桶大小
+     */
+    template <class Iterator, class Hasher>
+    static std::size_t max_bucket(Iterator first, Iterator last, Hasher hasher, unsigned bits)
+    {
+        std::vector<std::size_t> buckets(std::size_t(1) << bits);
+        for (; first != last; ++first) {
+            ++buckets[hasher(*first) & (buckets.size() - 1)];
+        }
+        return *std::max_element(buckets.begin(), buckets.end());
+    }
+};
+
+enum class color { red, green, blue };
+
+struct no_hash
+{
+};
+
+// 整数
+
+TEST_F(WWHashTest, integral)
+{
+    EXPECT_EQ(hash<int>()(42), hash<int>()(42));
+    EXPECT_NE(hash<int>()(1), hash<int>()(2));
+    EXPECT_EQ(hash<char>()('a'), hash<int>()('a'));
+    EXPECT_EQ(hash<char32_t>()(U'a'), hash<unsigned>()(97));
+    EXPECT_EQ(hash<wchar_t>()(L'a'), hash<char16_t>()(u'a'));
+
+    // 连续的键和低位全为0的键都应均匀落在低位上
+    std::vector<unsigned long long> keys(1 << 16);
+    for (std::size_t i = 0; i < keys.size(); ++i) {
+        keys[i] = i;
+    }
+    EXPECT_LE(max_bucket(keys.begin(), keys.end(), hash<unsigned long long>(), 12), 40);
+    for (auto & key : keys) {
+        key <<= 20;
+    }
+    EXPECT_LE(max_bucket(keys.begin(), keys.end(), hash<unsigned long long>(), 12), 40);
+}
+
+TEST_F(WWHashTest, enum_and_disabled)
+{
+    EXPECT_EQ(hash<color>()(color::green), hash<int>()(1));
+    unordered_set<color> colors = {color::red, color::blue};
+    EXPECT_EQ(colors.count(color::blue), 1);
+
+    // 没有特化的类型不能构造hash，在编译期报错
+    static_assert(!std::is_default_constructible<hash<no_hash>>::value, "hash<no_hash> must be disabled");
+    static_assert(std::is_default_constructible<hash<color>>::value, "enum hash must be enabled");
+}
+
+TEST_F(WWHashTest, is_mixed)
+{
+    // hash特化的结果已打散，按位取桶时不再重复打散；其他哈希函数需要自行声明
+    static_assert(hash_is_mixed<hash<int>>::value, "integer hash is mixed");
+    static_assert(hash_is_mixed<hash<std::string>>::value, "string hash is mixed");
+    static_assert(hash_is_mixed<hash<color>>::value, "enum hash is mixed");
+    static_assert(hash_is_mixed<hash<std::pair<int, int>>>::value, "pair hash is mixed");
+    static_assert(!hash_is_mixed<std::hash<int>>::value, "std::hash is not known to be mixed");
+}
+
+// 浮点数
+
+TEST_F(WWHashTest, floating_point)
+{
+    EXPECT_EQ(hash<double>()(0.0), hash<double>()(-0.0));
+    EXPECT_EQ(hash<float>()(0.0f), hash<float>()(-0.0f));
+    EXPECT_EQ(hash<long double>()(0.0L), hash<long double>()(-0.0L));
+    EXPECT_NE(hash<double>()(1.0), hash<double>()(-1.0));
+    EXPECT_NE(hash<long double>()(1.0L), hash<long double>()(-1.0L));
+    EXPECT_NE(hash<long double>()(1.0L), hash<long double>()(2.0L));
+    EXPECT_EQ(hash<long double>()(1.5L), hash<long double>()(3.0L / 2));
+
+    unordered_map<double, int> map;
+    map[-0.0] = 1;
+    map[0.5] = 2;
+    EXPECT_EQ(map.at(0.0), 1);
+    EXPECT_EQ(map.size(), 2);
+}
+
+// 字符串
+
+TEST_F(WWHashTest, bytes)
+{
+    // 所有长度都读到每一个字节：任意一位翻转都改变hash值
+    std::string text;
+    for (int i = 0; i < 200; ++i) {
+        text.push_back(static_cast<char>('a' + i % 26));
+    }
+    std::unordered_set<std::size_t> seen;
+    for (std::size_t size = 0; size <= text.size(); ++size) {
+        const std::string key = text.substr(0, size);
+        const std::size_t code = hash<std::string>()(key);
+        EXPECT_TRUE(seen.insert(code).second) << size;
+        for (std::size_t i = 0; i < size; ++i) {
+            std::string flipped = key;
+            flipped[i] ^= 1;
+            EXPECT_NE(hash<std::string>()(flipped), code) << size << ' ' << i;
+        }
+    }
+
+    // 与起始地址的对齐无关
+    const std::string padded = "xyz" + text;
+    EXPECT_EQ(_hash_bytes(padded.data() + 3, 100), hash<std::string>()(text.substr(0, 100)));
+    EXPECT_EQ(hash<const char *>()(text.c_str()), hash<std::string>()(text));
+}
+
+TEST_F(WWHashTest, realistic_keys)
+{
+    // 只差一两个字符的URL和数字字符串
+    std::vector<std::string> keys;
+    for (int i = 0; i < 1 << 15; ++i) {
+        keys.push_back("https://example.com/api/v1/users/" + std::to_string(i) + "/profile");
+        keys.push_back(std::to_string(i));
+    }
+    std::unordered_set<std::size_t> codes;
+    for (const auto & key : keys) {
+        codes.insert(hash<std::string>()(key));
+    }
+    EXPECT_EQ(codes.size(), keys.size());
+    EXPECT_LE(max_bucket(keys.begin(), keys.end(), hash<std::string>(), 12), 40);
+}
+
+// 组合键
+
+TEST_F(WWHashTest, pair_and_tuple)
+{
+    using key_pair = std::pair<int, int>;
+    using key_tuple2 = std::tuple<int, int>;
+    using key_tuple3 = std::tuple<int, int, int>;
+    EXPECT_NE(hash<key_pair>()(key_pair(1, 2)), hash<key_pair>()(key_pair(2, 1)));
+    EXPECT_EQ(hash<key_tuple2>()(key_tuple2(1, 2)), hash<key_pair>()(key_pair(1, 2)));
+    EXPECT_NE(hash<key_tuple3>()(key_tuple3(0, 0, 0)), hash<key_tuple2>()(key_tuple2(0, 0)));
+    hash<std::tuple<>>()(std::tuple<>());
+
+    unordered_map<std::pair<std::string, int>, int> map;
+    map[{"a", 1}] = 1;
+    map[{"a", 2}] = 2;
+    map[{"b", 1}] = 3;
+    EXPECT_EQ(map.size(), 3);
+    EXPECT_EQ(map.at({"a", 2}), 2);
+
+    // 网格坐标不应集中在少数桶
+    std::vector<key_pair> grid;
+    for (int x = 0; x < 256; ++x) {
+        for (int y = 0; y < 256; ++y) {
+            grid.emplace_back(x, y);
+        }
+    }
+    EXPECT_LE(max_bucket(grid.begin(), grid.end(), hash<key_pair>(), 12), 40);
+}
+
+TEST_F(WWHashTest, hash_combine_and_state)
+{
+    std::size_t seed = 0;
+    hash_combine(seed, 7);
+    hash_combine(seed, std::string("key"));
+
+    const std::string key = "key";
+    EXPECT_EQ(hash_state().update(7).update(key).finish(), seed);
+    EXPECT_EQ(hash_state().update(7).update_bytes(key.data(), key.size()).finish(), seed);
+    EXPECT_NE(hash_state().update(key).update(7).finish(), seed);
+    EXPECT_NE(hash_state(1).update(7).update(key).finish(), seed);
+}
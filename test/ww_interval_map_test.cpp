@@ -0,0 +1,114 @@
+#include <gtest/gtest.h>
+#include <ww_interval_map.h>
+#include <iterator>
+#include <string>
+#include <vector>
+
+using namespace wwstl;
+
+class WWIntervalMapTest : public testing::Test
+{
+public:
+    interval_map<int, std::string> m;
+
+protected:
+    void SetUp() override
+    {
+        m.insert({{10, 20}, "a"});
+        m.insert({{15, 25}, "b"});
+        m.insert({{30, 40}, "c"});
+        m.insert({{0, 5}, "d"});
+    }
+};
+
+// 修改器
+
+TEST_F(WWIntervalMapTest, insert)
+{
+    EXPECT_EQ(m.size(), 4);
+    EXPECT_FALSE(m.insert({{10, 20}, "x"}).second);
+    EXPECT_TRUE(m.emplace(std::make_pair(10, 12), "e").second);
+    EXPECT_EQ(m.at({10, 12}), "e");
+    m[{50, 60}] = "f";
+    EXPECT_EQ(m.size(), 6);
+
+    // 按下界、上界的顺序排列
+    std::vector<std::pair<int, int>> keys;
+    for (auto & kv : m) {
+        keys.push_back(kv.first);
+    }
+    EXPECT_EQ(keys, (std::vector<std::pair<int, int>>{{0, 5}, {10, 12}, {10, 20}, {15, 25}, {30, 40}, {50, 60}}));
+}
+
+// 区间查询
+
+TEST_F(WWIntervalMapTest, find_overlapping)
+{
+    std::vector<interval_map<int, std::string>::iterator> result;
+    m.find_overlapping(18, 31, std::back_inserter(result));
+    ASSERT_EQ(result.size(), 3);
+    EXPECT_EQ(result[0]->second, "a");
+    EXPECT_EQ(result[1]->second, "b");
+    EXPECT_EQ(result[2]->second, "c");
+
+    // 左闭右开，端点相接不算重叠
+    result.clear();
+    m.find_overlapping(5, 10, std::back_inserter(result));
+    EXPECT_TRUE(result.empty());
+    EXPECT_FALSE(m.overlaps(5, 10));
+    EXPECT_TRUE(m.overlaps(4, 10));
+
+    // 擦除后最大上界随之更新
+    m.erase({30, 40});
+    EXPECT_FALSE(m.overlaps(26, 100));
+}
+
+TEST_F(WWIntervalMapTest, find_containing)
+{
+    std::vector<interval_map<int, std::string>::const_iterator> result;
+    const interval_map<int, std::string> & cm = m;
+    cm.find_containing(15, std::back_inserter(result));
+    ASSERT_EQ(result.size(), 2);
+    EXPECT_EQ(result[0]->second, "a");
+    EXPECT_EQ(result[1]->second, "b");
+
+    result.clear();
+    cm.find_containing(20, std::back_inserter(result));
+    ASSERT_EQ(result.size(), 1);
+    EXPECT_EQ(result[0]->second, "b");
+
+    result.clear();
+    cm.find_containing(25, std::back_inserter(result));
+    EXPECT_TRUE(result.empty());
+}
+
+TEST_F(WWIntervalMapTest, random_queries)
+{
+    // 随机插入和擦除，与线性扫描的结果比较
+    interval_multimap<int, int> mm;
+    unsigned int seed = 11;
+    for (int i = 0; i < 2000; ++i) {
+        seed = seed * 1103515245 + 12345;
+        int lo = static_cast<int>((seed >> 16) % 1000);
+        int len = static_cast<int>((seed >> 8) % 40);
+        if (seed % 5 == 0 && !mm.empty()) {
+            mm.erase(mm.begin());
+        } else {
+            mm.emplace(std::make_pair(lo, lo + len), i);
+        }
+        if (i % 20 == 0) {
+            int qlo = static_cast<int>((seed >> 4) % 1000);
+            int qhi = qlo + 15;
+            std::vector<interval_multimap<int, int>::iterator> result;
+            mm.find_overlapping(qlo, qhi, std::back_inserter(result));
+            std::vector<interval_multimap<int, int>::iterator> expected;
+            for (auto it = mm.begin(); it != mm.end(); ++it) {
+                if (it->first.first < qhi && qlo < it->first.second) {
+                    expected.push_back(it);
+                }
+            }
+            ASSERT_TRUE(result == expected);
+            EXPECT_EQ(mm.overlaps(qlo, qhi), !expected.empty());
+        }
+    }
+}
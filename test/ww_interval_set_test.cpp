@@ -0,0 +1,42 @@
+#include <gtest/gtest.h>
+#include <ww_interval_set.h>
+#include <iterator>
+#include <vector>
+
+using namespace wwstl;
+
+class WWIntervalSetTest : public testing::Test
+{
+public:
+    interval_set<int> s = {{1, 5}, {3, 9}, {10, 12}, {3, 4}};
+};
+
+// 修改器
+
+TEST_F(WWIntervalSetTest, insert)
+{
+    EXPECT_EQ(s.size(), 4);
+    EXPECT_FALSE(s.insert({3, 9}).second);
+    EXPECT_TRUE(s.emplace(20, 30).second);
+    EXPECT_EQ(s.count({20, 30}), 1);
+    EXPECT_EQ(s.erase({1, 5}), 1);
+    EXPECT_EQ(s.size(), 4);
+}
+
+// 区间查询
+
+TEST_F(WWIntervalSetTest, find_containing)
+{
+    std::vector<interval_set<int>::const_iterator> result;
+    s.find_containing(3, std::back_inserter(result));
+    std::vector<std::pair<int, int>> found;
+    for (auto it : result) {
+        found.push_back(*it);
+    }
+    EXPECT_EQ(found, (std::vector<std::pair<int, int>>{{1, 5}, {3, 4}, {3, 9}}));
+
+    result.clear();
+    s.find_overlapping(9, 10, std::back_inserter(result));
+    EXPECT_TRUE(result.empty());
+    EXPECT_TRUE(s.overlaps(8, 11));
+}
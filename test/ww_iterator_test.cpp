@@ -0,0 +1,133 @@
+#include <gtest/gtest.h>
+#include <string>
+#include <vector>
+#include <ww_iterator.h>
+
+using namespace wwstl;
+
+/**
+ * @brief 代理迭代器
+ * @details 解引用返回一对引用，operator->返回持有该代理的对象，
+ * 与flat_map的迭代器相同，无法对operator*的结果取地址
+ */
+class ProxyIterator
+{
+public:
+    struct proxy_reference
+    {
+        int & key;
+        std::string & value;
+    };
+
+    struct arrow_proxy
+    {
+        proxy_reference ref;
+
+        proxy_reference * operator->()
+        {
+            return &ref;
+        }
+    };
+
+    using iterator_category = bidirectional_iterator_tag;
+    using value_type = proxy_reference;
+    using difference_type = std::ptrdiff_t;
+    using pointer = arrow_proxy;
+    using reference = proxy_reference;
+
+public:
+    int * _key;
+    std::string * _value;
+
+public:
+    ProxyIterator(int * key, std::string * value)
+        : _key(key), _value(value)
+    {
+    }
+
+    reference operator*() const
+    {
+        return reference{*_key, *_value};
+    }
+
+    pointer operator->() const
+    {
+        return pointer{operator*()};
+    }
+
+    ProxyIterator & operator++()
+    {
+        ++_key;
+        ++_value;
+        return *this;
+    }
+
+    ProxyIterator & operator--()
+    {
+        --_key;
+        --_value;
+        return *this;
+    }
+
+    bool operator==(const ProxyIterator & other) const
+    {
+        return _key == other._key;
+    }
+
+    bool operator!=(const ProxyIterator & other) const
+    {
+        return !(*this == other);
+    }
+};
+
+// 原生指针
+TEST(WWIteratorTest, ReverseIteratorArrowPointer)
+{
+    std::string values[] = {"a", "b", "c"};
+    reverse_iterator<std::string *> rit(values + 3);
+    EXPECT_EQ(rit->size(), 1);
+    EXPECT_EQ(rit.operator->(), values + 2);
+    ++rit;
+    EXPECT_EQ(rit.operator->(), values + 1);
+    rit->append("x");
+    EXPECT_EQ(values[1], "bx");
+}
+
+// 类类型迭代器
+TEST(WWIteratorTest, ReverseIteratorArrowClassIterator)
+{
+    std::vector<std::string> values = {"a", "b", "c"};
+    reverse_iterator<std::vector<std::string>::iterator> rit(values.end());
+    EXPECT_EQ(&*rit.operator->(), &values[2]);
+    ++rit;
+    rit->append("x");
+    EXPECT_EQ(values[1], "bx");
+}
+
+// 代理迭代器，operator->交给底层迭代器
+TEST(WWIteratorTest, ReverseIteratorArrowProxy)
+{
+    int keys[] = {1, 2, 3};
+    std::string values[] = {"1", "2", "3"};
+    ProxyIterator first(keys, values);
+    ProxyIterator last(keys + 3, values + 3);
+
+    reverse_iterator<ProxyIterator> rit(last);
+    reverse_iterator<ProxyIterator> rend(first);
+    EXPECT_EQ(rit->key, 3);
+    EXPECT_EQ(rit->value, "3");
+
+    ++rit;
+    EXPECT_EQ(&rit->key, keys + 1);
+    rit->value = "two";
+    EXPECT_EQ(values[1], "two");
+
+    // operator->不移动迭代器本身
+    EXPECT_EQ(rit->key, 2);
+
+    std::vector<int> seen;
+    for (rit = reverse_iterator<ProxyIterator>(last); rit != rend; ++rit) {
+        seen.push_back(rit->key);
+    }
+    EXPECT_EQ(seen, std::vector<int>({3, 2, 1}));
+}
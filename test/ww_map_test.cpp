@@ -1,5 +1,7 @@
 #include <gtest/gtest.h>
 #include <ww_map.h>
+#include <iterator>
+#include <vector>
 
 using namespace wwstl;
 
@@ -18,6 +20,34 @@ protected:
     }
 };
 
+// 构造
+
+TEST_F(WWMapTest, copy)
+{
+    map<int, std::string> m2(m);
+    EXPECT_TRUE(m == m2);
+
+    map<int, std::string> m3;
+    m3[7] = "7";
+    m3 = m2;
+    EXPECT_TRUE(m == m3);
+    EXPECT_EQ(m3.count(7), 0);
+    EXPECT_EQ((--m3.end())->second, "4");
+}
+
+TEST_F(WWMapTest, range_constructor)
+{
+    // 有序输入，重复的键保留第一个
+    std::vector<std::pair<int, std::string>> sorted = {{1, "1"}, {2, "2"}, {2, "x"}, {3, "3"}, {4, "4"}};
+    map<int, std::string> m2(sorted.begin(), sorted.end());
+    EXPECT_TRUE(m == m2);
+
+    // 无序输入
+    std::vector<std::pair<int, std::string>> unsorted = {{3, "3"}, {1, "1"}, {4, "4"}, {1, "x"}, {2, "2"}};
+    map<int, std::string> m3(unsorted.begin(), unsorted.end());
+    EXPECT_TRUE(m == m3);
+}
+
 // 元素访问
 
 TEST_F(WWMapTest, at)
@@ -100,6 +130,28 @@ TEST_F(WWMapTest, insert)
     EXPECT_EQ(m.size(), 9);
 }
 
+TEST_F(WWMapTest, insert_hint)
+{
+    // 有序追加，提示为end()
+    for (int i = 5; i < 100; ++i) {
+        auto it = m.insert(m.end(), {i, std::to_string(i)});
+        EXPECT_EQ(it->first, i);
+    }
+    EXPECT_EQ(m.size(), 99);
+
+    // 重复的键返回已有元素
+    auto it = m.insert(m.find(3), {2, "x"});
+    EXPECT_EQ(it->second, "2");
+
+    // 错误的提示仍然正确插入
+    m.erase(50);
+    it = m.emplace_hint(m.begin(), std::make_pair(50, "50"));
+    EXPECT_EQ(it->first, 50);
+    EXPECT_EQ(std::prev(it)->first, 49);
+    EXPECT_EQ(std::next(it)->first, 51);
+    EXPECT_EQ(m.size(), 99);
+}
+
 TEST_F(WWMapTest, erase)
 {
     m.erase(1);
@@ -109,6 +161,158 @@ TEST_F(WWMapTest, erase)
     EXPECT_TRUE(m.empty());
 }
 
+TEST_F(WWMapTest, try_emplace)
+{
+    // 键已存在时不移动参数
+    std::string value = "x";
+    auto res = m.try_emplace(1, std::move(value));
+    EXPECT_FALSE(res.second);
+    EXPECT_EQ(res.first->second, "1");
+    EXPECT_EQ(value, "x");
+
+    res = m.try_emplace(5, std::move(value));
+    EXPECT_TRUE(res.second);
+    EXPECT_EQ(m.at(5), "x");
+
+    // 以多个参数构造值
+    auto it = m.try_emplace(m.end(), 6, 3, 'a');
+    EXPECT_EQ(it->second, "aaa");
+    EXPECT_EQ(m.size(), 6);
+
+    // emplace可以取得键时同样先查找
+    std::string other = "y";
+    EXPECT_FALSE(m.emplace(2, std::move(other)).second);
+    EXPECT_EQ(other, "y");
+
+    // 提示命中和未命中时都先查找，键已存在时不移动参数
+    it = m.try_emplace(m.find(2), 2, std::move(other));
+    EXPECT_EQ(it->second, "2");
+    EXPECT_EQ(other, "y");
+    map<int, std::string> hm;
+    for (int i = 0; i < 100; i += 2) {
+        EXPECT_EQ(hm.try_emplace(hm.end(), i, 1, 'a')->first, i);
+    }
+    for (int i = 1; i < 100; i += 2) {
+        EXPECT_EQ(hm.try_emplace(hm.find(i + 1), i, 1, 'b')->first, i);
+    }
+    EXPECT_EQ(hm.try_emplace(hm.begin(), 50, 1, 'c')->second, "a");
+    EXPECT_EQ(hm.try_emplace(hm.begin(), -1, 1, 'c')->second, "c");
+    ASSERT_EQ(hm.size(), 101);
+    int expected = -1;
+    for (auto & p : hm) {
+        EXPECT_EQ(p.first, expected++);
+    }
+}
+
+TEST_F(WWMapTest, insert_or_assign)
+{
+    auto res = m.insert_or_assign(1, "one");
+    EXPECT_FALSE(res.second);
+    EXPECT_EQ(m.at(1), "one");
+
+    res = m.insert_or_assign(5, "5");
+    EXPECT_TRUE(res.second);
+    EXPECT_EQ(res.first->second, "5");
+
+    auto it = m.insert_or_assign(m.begin(), 5, "five");
+    EXPECT_EQ(it->second, "five");
+    EXPECT_EQ(m.size(), 5);
+
+    // 提示位于开头、中间和末尾
+    it = m.insert_or_assign(m.find(5), 4, "four");
+    EXPECT_EQ(it->second, "four");
+    it = m.insert_or_assign(m.begin(), 0, "zero");
+    EXPECT_EQ(it, m.begin());
+    it = m.insert_or_assign(m.end(), 9, "nine");
+    EXPECT_EQ(it->first, 9);
+    it = m.insert_or_assign(m.find(3), 7, "seven");
+    EXPECT_EQ(it->second, "seven");
+    it = m.insert_or_assign(m.find(3), 3, "three");
+    EXPECT_EQ(m.at(3), "three");
+    EXPECT_EQ(m.size(), 8);
+    const int keys[] = {0, 1, 2, 3, 4, 5, 7, 9};
+    EXPECT_TRUE(std::equal(m.begin(), m.end(), std::begin(keys), [](const std::pair<const int, std::string> & p, int key) {
+        return p.first == key;
+    }));
+}
+
+TEST_F(WWMapTest, node_handle)
+{
+    // 摘下节点修改键后重新插入，元素地址不变
+    const std::string * address = &m.find(2)->second;
+    auto nh = m.extract(2);
+    ASSERT_FALSE(nh.empty());
+    EXPECT_EQ(m.size(), 3);
+    EXPECT_EQ(m.count(2), 0);
+    nh.key() = 7;
+    nh.mapped() = "7";
+    auto result = m.insert(std::move(nh));
+    EXPECT_TRUE(result.inserted);
+    EXPECT_TRUE(nh.empty());
+    EXPECT_EQ(result.position->first, 7);
+    EXPECT_EQ(&result.position->second, address);
+    EXPECT_EQ((--m.end())->second, "7");
+
+    // 键已存在时插入失败，节点留在返回值中
+    auto dup = m.extract(m.begin());
+    EXPECT_EQ(dup.key(), 1);
+    map<int, std::string> other = {{1, "one"}};
+    auto failed = other.insert(std::move(dup));
+    EXPECT_FALSE(failed.inserted);
+    EXPECT_EQ(failed.position->second, "one");
+    EXPECT_EQ(failed.node.mapped(), "1");
+    m.insert(m.begin(), std::move(failed.node));
+    EXPECT_EQ(m.begin()->second, "1");
+
+    EXPECT_TRUE(m.extract(100).empty());
+    EXPECT_EQ(m.insert(map<int, std::string>::node_type()).position, m.end());
+}
+
+TEST_F(WWMapTest, merge)
+{
+    map<int, std::string> other = {{0, "0"}, {2, "x"}, {5, "5"}};
+    m.merge(other);
+    EXPECT_EQ(m.size(), 6);
+    EXPECT_EQ(m[2], "2");
+    ASSERT_EQ(other.size(), 1);
+    EXPECT_EQ(other.begin()->second, "x");
+
+    multimap<int, std::string, std::greater<int>> multi = {{9, "9"}, {9, "99"}, {1, "x"}};
+    m.merge(multi);
+    EXPECT_EQ(m.size(), 7);
+    EXPECT_EQ(m[9], "9");
+    EXPECT_EQ(multi.size(), 2);
+}
+
+TEST_F(WWMapTest, set_operations)
+{
+    map<int, std::string> other = {{3, "x"}, {4, "x"}, {5, "5"}};
+    map<int, std::string> u = m;
+    map<int, std::string> o = other;
+    u.unite(o);
+    EXPECT_EQ(u.size(), 5);
+    EXPECT_EQ(u[3], "3");
+    EXPECT_EQ(u[5], "5");
+
+    map<int, std::string> i = m;
+    o = other;
+    i.intersect(o);
+    EXPECT_EQ(i.size(), 2);
+    EXPECT_EQ(i.begin()->second, "3");
+
+    map<int, std::string> d = m;
+    o = other;
+    d.subtract(o);
+    EXPECT_EQ(d.size(), 2);
+    EXPECT_EQ((--d.end())->first, 2);
+
+    map<int, std::string> right = m.split(3);
+    EXPECT_EQ(m.size(), 2);
+    EXPECT_EQ(right.begin()->first, 3);
+    m.join(right);
+    EXPECT_EQ(m.size(), 4);
+}
+
 // 查找
 
 TEST_F(WWMapTest, count)
@@ -154,6 +358,168 @@ TEST_F(WWMapTest, upper_bound)
     EXPECT_EQ(m.upper_bound(5), m.end());
 }
 
+TEST_F(WWMapTest, seek_forward)
+{
+    EXPECT_EQ(m.seek_forward(m.begin(), 3)->second, "3");
+    EXPECT_EQ(m.seek_forward(m.find(2), 2)->second, "2");
+    EXPECT_EQ(m.seek_forward(m.find(2), 5), m.end());
+    EXPECT_EQ(m.seek_forward(m.end(), 5), m.end());
+
+    // 偶数键，从每个起点向后查找所有不早于它的键，结果与lower_bound一致
+    map<int, int> big;
+    for (int i = 0; i < 300; i += 2) {
+        big.emplace(i, i);
+    }
+    for (int from = 0; from < 300; from += 7) {
+        auto finger = big.lower_bound(from);
+        for (int key = from; key <= 301; ++key) {
+            ASSERT_EQ(big.seek_forward(finger, key), big.lower_bound(key));
+        }
+    }
+
+    // 合并有序的键序列，每次从上一次的结果出发
+    std::vector<int> matched;
+    auto it = big.begin();
+    for (int key = 1; key < 310; key += 3) {
+        it = big.seek_forward(it, key);
+        if (it != big.end() && it->first == key) {
+            matched.push_back(key);
+        }
+    }
+    EXPECT_EQ(matched.size(), 50);
+    EXPECT_EQ(matched.front(), 4);
+    EXPECT_EQ(matched.back(), 298);
+}
+
+TEST_F(WWMapTest, find_many)
+{
+    // 键数超过一批，命中与未命中交替
+    std::vector<int> keys;
+    for (int i = 0; i < 40; ++i) {
+        keys.push_back(i % 6);
+    }
+    std::vector<map<int, std::string>::iterator> found;
+    m.find_many(keys.begin(), keys.end(), std::back_inserter(found));
+    ASSERT_EQ(found.size(), keys.size());
+    for (std::size_t i = 0; i < keys.size(); ++i) {
+        EXPECT_EQ(found[i], m.find(keys[i]));
+    }
+
+    std::vector<std::size_t> counts(keys.size());
+    const map<int, std::string> & cm = m;
+    cm.count_many(keys.begin(), keys.end(), counts.begin());
+    for (std::size_t i = 0; i < keys.size(); ++i) {
+        EXPECT_EQ(counts[i], m.count(keys[i]));
+    }
+
+    map<int, std::string> empty;
+    EXPECT_EQ(empty.find_many(keys.begin(), keys.end(), found.begin()), found.end());
+    EXPECT_EQ(found[0], empty.end());
+}
+
+TEST_F(WWMapTest, heterogeneous_lookup)
+{
+    map<std::string, int, std::less<>> smap;
+    smap.insert({"apple", 1});
+    smap.insert({"banana", 2});
+    smap.insert({"cherry", 3});
+
+    const char * key = "banana";
+    EXPECT_EQ(smap.find(key)->second, 2);
+    EXPECT_EQ(smap.find("durian"), smap.end());
+    EXPECT_EQ(smap.count("apple"), 1);
+    EXPECT_EQ(smap.lower_bound("b")->first, "banana");
+    EXPECT_EQ(smap.upper_bound("banana")->first, "cherry");
+
+    auto range = smap.equal_range("cherry");
+    EXPECT_EQ(range.first->second, 3);
+    EXPECT_EQ(range.second, smap.end());
+}
+
+// 平衡策略
+
+template <class Balance>
+void check_balance_policy()
+{
+    using map_type = map<int, int, std::less<int>, allocator<std::pair<const int, int>>, false, Balance>;
+
+    // 乱序插入、查找和擦除后，与默认策略的结果一致
+    map_type bm;
+    map<int, int> expected;
+    unsigned int seed = 7;
+    for (int i = 0; i < 2000; ++i) {
+        seed = seed * 1103515245 + 12345;
+        int key = static_cast<int>((seed >> 16) % 500);
+        if (seed % 3 == 0) {
+            EXPECT_EQ(bm.erase(key), expected.erase(key));
+        } else {
+            bm[key] = i;
+            expected[key] = i;
+        }
+        EXPECT_EQ(bm.find(key) == bm.end(), expected.find(key) == expected.end());
+    }
+    ASSERT_EQ(bm.size(), expected.size());
+    EXPECT_TRUE(std::equal(bm.begin(), bm.end(), expected.begin()));
+
+    // 反向遍历，根节点经旋转更替后不能被误认为头节点
+    EXPECT_TRUE(std::equal(bm.rbegin(), bm.rend(), expected.rbegin()));
+    EXPECT_EQ((--bm.end())->first, expected.rbegin()->first);
+    typename map_type::iterator root(bm._tree._root());
+    if (root != bm.begin()) {
+        auto before = root;
+        --before;
+        auto expected_before = expected.find(root->first);
+        --expected_before;
+        EXPECT_EQ(before->first, expected_before->first);
+    }
+
+    // 提示分别位于开头、中间和末尾
+    map_type hm;
+    map<int, int> hexpected;
+    for (int i = 0; i < 300; i += 3) {
+        hm.emplace_hint(hm.end(), i, i);
+        hexpected.emplace(i, i);
+    }
+    for (int i = -1; i > -100; --i) {
+        hm.insert(hm.begin(), std::make_pair(i, i));
+        hexpected.emplace(i, i);
+    }
+    for (int i = 1; i < 300; i += 3) {
+        hm.insert(hm.lower_bound(i), std::make_pair(i, i));
+        hm.emplace_hint(hm.find(i), i + 1, i + 1);
+        hexpected.emplace(i, i);
+        hexpected.emplace(i + 1, i + 1);
+    }
+    EXPECT_EQ(hm.emplace_hint(hm.find(150), 150, 0)->second, 150);
+    ASSERT_EQ(hm.size(), hexpected.size());
+    EXPECT_TRUE(std::equal(hm.begin(), hm.end(), hexpected.begin()));
+    EXPECT_TRUE(std::equal(hm.rbegin(), hm.rend(), hexpected.rbegin()));
+
+    auto copy = bm;
+    EXPECT_TRUE(copy == bm);
+    copy.clear();
+    EXPECT_TRUE(copy.empty());
+}
+
+TEST_F(WWMapTest, balance_policy)
+{
+    check_balance_policy<avl_balance>();
+    check_balance_policy<treap_balance>();
+    check_balance_policy<splay_balance>();
+
+    // 伸展树的find把元素伸展到根
+    map<int, int, std::less<int>, allocator<std::pair<const int, int>>, false, splay_balance> sm = {{1, 1}, {2, 2}, {3, 3}, {4, 4}};
+    auto it = sm.find(2);
+    EXPECT_EQ(sm._tree._root(), it._node);
+
+    // AVL顺序插入后高度不超过1.44log(n)
+    map<int, int, std::less<int>, allocator<std::pair<const int, int>>, false, avl_balance> am;
+    for (int i = 0; i < 1023; ++i) {
+        am.emplace(i, i);
+    }
+    EXPECT_LE(am._tree._root()->_height, 11);
+}
+
 // 比较
 
 TEST_F(WWMapTest, compare)
@@ -77,6 +77,21 @@ TEST_F(WWMultiMapTest, insert)
     EXPECT_EQ(mmap.size(), 12);
 }
 
+TEST_F(WWMultiMapTest, insert_hint)
+{
+    auto size = mmap.size();
+    auto range = mmap.equal_range(2);
+    // 相等的键插入到提示之前
+    auto it = mmap.insert(range.second, {2, "x"});
+    EXPECT_EQ(it->second, "x");
+    EXPECT_EQ(std::next(it), range.second);
+    EXPECT_EQ(mmap.count(2), 4);
+
+    it = mmap.insert(mmap.end(), {100, "100"});
+    EXPECT_EQ(std::next(it), mmap.end());
+    EXPECT_EQ(mmap.size(), size + 2);
+}
+
 TEST_F(WWMultiMapTest, erase)
 {
     mmap.erase(mmap.find(3));
@@ -98,6 +113,14 @@ TEST_F(WWMultiMapTest, count)
     EXPECT_EQ(mmap.count(3), 1);
     EXPECT_EQ(mmap.count(4), 1);
     EXPECT_EQ(mmap.count(5), 0);
+
+    int keys[] = {2, 5, 1, 4};
+    std::size_t counts[4] = {};
+    mmap.count_many(keys, keys + 4, counts);
+    EXPECT_EQ(counts[0], 3);
+    EXPECT_EQ(counts[1], 0);
+    EXPECT_EQ(counts[2], 2);
+    EXPECT_EQ(counts[3], 1);
 }
 
 TEST_F(WWMultiMapTest, find)
@@ -134,6 +157,22 @@ TEST_F(WWMultiMapTest, upper_bound)
     EXPECT_EQ(mmap.upper_bound(5), mmap.end());
 }
 
+TEST_F(WWMultiMapTest, order_statistic)
+{
+    ranked_multimap<int, std::string> rmap(mmap.begin(), mmap.end());
+    EXPECT_EQ(rmap.rank(1), 0);
+    EXPECT_EQ(rmap.rank(2), 2);
+    EXPECT_EQ(rmap.rank(3), 5);
+    EXPECT_EQ(rmap.rank(5), 7);
+    EXPECT_EQ(rmap.count_range(2, 4), 4);
+    EXPECT_EQ(rmap.nth(4)->second, "222");
+    EXPECT_EQ(rmap.nth(6)->first, 4);
+
+    rmap.erase(rmap.nth(2));
+    EXPECT_EQ(rmap.rank(3), 4);
+    EXPECT_EQ(rmap.nth(2)->second, "22");
+}
+
 // 比较
 
 TEST_F(WWMultiMapTest, compare)
@@ -21,6 +21,22 @@ protected:
     }
 };
 
+// 构造
+
+TEST_F(WWMultiSetTest, range_constructor)
+{
+    int sorted[] = {1, 1, 2, 2, 2, 3, 4};
+    multiset<int> mset2(sorted, sorted + 7);
+    EXPECT_TRUE(mset == mset2);
+
+    int unsorted[] = {2, 1, 4, 2, 3, 1, 2};
+    multiset<int> mset3(unsorted, unsorted + 7);
+    EXPECT_TRUE(mset == mset3);
+
+    multiset<int> mset4(mset3);
+    EXPECT_TRUE(mset == mset4);
+}
+
 // 迭代器
 
 TEST_F(WWMultiSetTest, begin)
@@ -79,6 +95,43 @@ TEST_F(WWMultiSetTest, erase)
     EXPECT_TRUE(mset.empty());
 }
 
+TEST_F(WWMultiSetTest, split_join)
+{
+    // 相等的键都进入右侧
+    multiset<int> right = mset.split(2);
+    EXPECT_EQ(mset.size(), 2);
+    EXPECT_EQ(right.size(), 5);
+    EXPECT_EQ(right.count(2), 3);
+
+    mset.join(right);
+    EXPECT_TRUE(right.empty());
+    multiset<int> expected = {1, 1, 2, 2, 2, 3, 4};
+    EXPECT_TRUE(mset == expected);
+}
+
+TEST_F(WWMultiSetTest, set_operations)
+{
+    multiset<int> other = {1, 2, 2, 2, 2, 5};
+    multiset<int> u = mset;
+    multiset<int> o = other;
+    u.unite(o);
+    EXPECT_EQ(u.size(), 13);
+    EXPECT_EQ(u.count(2), 7);
+    EXPECT_TRUE(o.empty());
+
+    multiset<int> i = mset;
+    o = other;
+    i.intersect(o);
+    multiset<int> expected_i = {1, 2, 2, 2};
+    EXPECT_TRUE(i == expected_i);
+
+    multiset<int> d = mset;
+    o = other;
+    d.subtract(o);
+    multiset<int> expected_d = {1, 3, 4};
+    EXPECT_TRUE(d == expected_d);
+}
+
 // 查找
 
 TEST_F(WWMultiSetTest, count)
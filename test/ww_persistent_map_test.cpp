@@ -0,0 +1,169 @@
+#include <gtest/gtest.h>
+#include <ww_persistent_map.h>
+#include <atomic>
+#include <map>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace wwstl;
+
+class WWPersistentMapTest : public testing::Test
+{
+public:
+    persistent_map<int, std::string> m;
+
+protected:
+    void SetUp() override
+    {
+        m = m.insert({3, "3"}).insert({1, "1"}).insert({4, "4"}).insert({2, "2"});
+    }
+};
+
+// 构造
+
+TEST_F(WWPersistentMapTest, copy)
+{
+    // 复制只共享根节点
+    persistent_map<int, std::string> m2(m);
+    EXPECT_EQ(m2._root, m._root);
+    EXPECT_EQ(m2.size(), 4);
+
+    persistent_map<int, std::string> m3 = {{2, "2"}, {1, "1"}};
+    EXPECT_EQ(m3.size(), 2);
+    m3 = m2;
+    EXPECT_EQ(m3.at(4), "4");
+}
+
+// 元素访问
+
+TEST_F(WWPersistentMapTest, at)
+{
+    EXPECT_EQ(m.at(1), "1");
+    EXPECT_THROW(m.at(5), std::out_of_range);
+}
+
+// 迭代器
+
+TEST_F(WWPersistentMapTest, iterator)
+{
+    int expected = 1;
+    for (auto & kv : m) {
+        EXPECT_EQ(kv.first, expected);
+        ++expected;
+    }
+    EXPECT_EQ(expected, 5);
+    persistent_map<int, int> empty;
+    EXPECT_TRUE(empty.begin() == empty.end());
+}
+
+// 修改器
+
+TEST_F(WWPersistentMapTest, versions)
+{
+    // 修改返回新版本，旧版本不变
+    auto v1 = m.insert({5, "5"});
+    auto v2 = v1.erase(1);
+    auto v3 = v2.insert_or_assign(2, "two");
+    EXPECT_EQ(m.size(), 4);
+    EXPECT_EQ(m.count(5), 0);
+    EXPECT_EQ(v1.size(), 5);
+    EXPECT_EQ(v1.count(1), 1);
+    EXPECT_EQ(v2.size(), 4);
+    EXPECT_EQ(v2.count(1), 0);
+    EXPECT_EQ(v2.at(2), "2");
+    EXPECT_EQ(v3.at(2), "two");
+
+    // 键已存在时insert不产生新节点
+    auto v4 = v3.insert({2, "x"});
+    EXPECT_EQ(v4._root, v3._root);
+    EXPECT_EQ(v3.erase(100)._root, v3._root);
+    EXPECT_TRUE(v3.clear().empty());
+}
+
+TEST_F(WWPersistentMapTest, random_versions)
+{
+    // 保留全部历史版本，与std::map逐版本比较
+    std::vector<persistent_map<int, int>> versions(1);
+    std::vector<std::map<int, int>> expected(1);
+    unsigned int seed = 3;
+    for (int i = 0; i < 600; ++i) {
+        seed = seed * 1103515245 + 12345;
+        int key = static_cast<int>((seed >> 16) % 200);
+        std::map<int, int> next = expected.back();
+        if (seed % 3 == 0) {
+            versions.push_back(versions.back().erase(key));
+            next.erase(key);
+        } else {
+            versions.push_back(versions.back().insert_or_assign(key, i));
+            next[key] = i;
+        }
+        expected.push_back(next);
+    }
+    for (std::size_t v = 0; v < versions.size(); ++v) {
+        ASSERT_EQ(versions[v].size(), expected[v].size());
+        auto it = versions[v].begin();
+        for (auto & kv : expected[v]) {
+            ASSERT_EQ(it->first, kv.first);
+            ASSERT_EQ(it->second, kv.second);
+            ++it;
+        }
+        EXPECT_TRUE(it == versions[v].end());
+    }
+}
+
+// 查找
+
+TEST_F(WWPersistentMapTest, find)
+{
+    EXPECT_EQ(m.find(3)->second, "3");
+    EXPECT_TRUE(m.find(0) == m.end());
+    EXPECT_EQ(m.lower_bound(2)->first, 2);
+    EXPECT_EQ(m.upper_bound(2)->first, 3);
+    EXPECT_TRUE(m.upper_bound(4) == m.end());
+
+    // 从lower_bound开始继续遍历
+    auto it = m.lower_bound(2);
+    ++it;
+    EXPECT_EQ(it->first, 3);
+    ++it;
+    EXPECT_EQ(it->first, 4);
+}
+
+// 发布
+
+TEST_F(WWPersistentMapTest, atomic_publish)
+{
+    // 写者不断发布新版本，读者取得的快照始终自洽
+    atomic_persistent_map<int, int> cell;
+    std::atomic<bool> done(false);
+    std::vector<std::thread> readers;
+    std::atomic<int> bad(0);
+    for (int r = 0; r < 3; ++r) {
+        readers.emplace_back([&]() {
+            while (!done.load()) {
+                persistent_map<int, int> snapshot = cell.load();
+                // 每个版本中所有值都等于版本号
+                int version = snapshot.empty() ? 0 : snapshot.begin()->second;
+                for (auto & kv : snapshot) {
+                    if (kv.second != version) {
+                        ++bad;
+                    }
+                }
+            }
+        });
+    }
+    persistent_map<int, int> current;
+    for (int version = 1; version <= 300; ++version) {
+        for (int key = 0; key < 16; ++key) {
+            current = current.insert_or_assign(key, version);
+        }
+        cell.store(current);
+    }
+    done.store(true);
+    for (auto & t : readers) {
+        t.join();
+    }
+    EXPECT_EQ(bad.load(), 0);
+    EXPECT_EQ(cell.load().at(7), 300);
+}
@@ -1,5 +1,8 @@
 #include <gtest/gtest.h>
 #include <ww_set.h>
+#include <set>
+#include <algorithm>
+#include <iterator>
 
 using namespace wwstl;
 
@@ -83,6 +86,130 @@ TEST_F(WWSetTest, erase)
     EXPECT_TRUE(s.empty());
 }
 
+TEST_F(WWSetTest, erase_interleaved)
+{
+    // 交替插入和删除，覆盖删除黑色节点后的各种调整情况
+    std::set<int> ref(s.begin(), s.end());
+    unsigned int seed = 1;
+    for (int i = 0; i < 5000; ++i) {
+        seed = seed * 1103515245 + 12345;
+        int key = static_cast<int>((seed >> 16) % 256);
+        if ((seed >> 8) & 1) {
+            s.insert(key);
+            ref.insert(key);
+        } else {
+            EXPECT_EQ(s.erase(key), ref.erase(key));
+        }
+    }
+    EXPECT_EQ(s.size(), ref.size());
+    EXPECT_TRUE(std::equal(s.begin(), s.end(), ref.begin()));
+    EXPECT_TRUE(std::equal(s.rbegin(), s.rend(), ref.rbegin()));
+}
+
+TEST_F(WWSetTest, split_join)
+{
+    for (int i = 5; i <= 100; ++i) {
+        s.insert(i);
+    }
+    set<int> right = s.split(40);
+    EXPECT_EQ(s.size(), 39);
+    EXPECT_EQ(right.size(), 61);
+    EXPECT_EQ(*--s.end(), 39);
+    EXPECT_EQ(*right.begin(), 40);
+    EXPECT_EQ(*--right.end(), 100);
+
+    set<int> empty = right.split(1000);
+    EXPECT_TRUE(empty.empty());
+    EXPECT_EQ(right.size(), 61);
+
+    s.join(right);
+    EXPECT_TRUE(right.empty());
+    EXPECT_EQ(s.size(), 100);
+    int expected = 1;
+    for (auto it = s.begin(); it != s.end(); ++it) {
+        EXPECT_EQ(*it, expected++);
+    }
+    EXPECT_EQ(*s.rbegin(), 100);
+}
+
+TEST_F(WWSetTest, set_operations)
+{
+    // 随机比较并集、交集、差集与std算法的结果
+    unsigned int seed = 7;
+    for (int round = 0; round < 50; ++round) {
+        set<int> a;
+        set<int> b;
+        std::set<int> ra;
+        std::set<int> rb;
+        int na = round * 7 % 60;
+        int nb = round * 13 % 200;
+        for (int i = 0; i < na + nb; ++i) {
+            seed = seed * 1103515245 + 12345;
+            int key = static_cast<int>((seed >> 16) % 300);
+            if (i < na) {
+                a.insert(key);
+                ra.insert(key);
+            } else {
+                b.insert(key);
+                rb.insert(key);
+            }
+        }
+
+        std::set<int> expected;
+        set<int> x = a;
+        set<int> y = b;
+        switch (round % 3) {
+        case 0:
+            std::set_union(ra.begin(), ra.end(), rb.begin(), rb.end(), std::inserter(expected, expected.end()));
+            x.unite(y);
+            break;
+        case 1:
+            std::set_intersection(ra.begin(), ra.end(), rb.begin(), rb.end(), std::inserter(expected, expected.end()));
+            x.intersect(y);
+            break;
+        default:
+            std::set_difference(ra.begin(), ra.end(), rb.begin(), rb.end(), std::inserter(expected, expected.end()));
+            x.subtract(y);
+            break;
+        }
+        EXPECT_TRUE(y.empty());
+        EXPECT_EQ(x.size(), expected.size());
+        EXPECT_TRUE(std::equal(x.begin(), x.end(), expected.begin()));
+        EXPECT_TRUE(std::equal(x.rbegin(), x.rend(), expected.rbegin()));
+
+        // 操作后的树仍然可以正常插入删除
+        for (int key = 0; key < 300; key += 3) {
+            x.insert(key);
+            expected.insert(key);
+        }
+        for (int key = 0; key < 300; key += 5) {
+            EXPECT_EQ(x.erase(key), expected.erase(key));
+        }
+        EXPECT_TRUE(std::equal(x.begin(), x.end(), expected.begin()));
+    }
+}
+
+TEST_F(WWSetTest, merge)
+{
+    multiset<int> multi = {0, 2, 2, 5, 5};
+    s.merge(multi);
+    EXPECT_EQ(s.size(), 6);
+    EXPECT_EQ(multi.size(), 3);
+    EXPECT_EQ(multi.count(2), 2);
+
+    multiset<int> target = {2};
+    target.merge(s);
+    EXPECT_TRUE(s.empty());
+    EXPECT_EQ(target.size(), 7);
+    EXPECT_EQ(target.count(2), 2);
+
+    auto nh = target.extract(2);
+    EXPECT_EQ(nh.value(), 2);
+    s.insert(std::move(nh));
+    EXPECT_EQ(s.count(2), 1);
+    EXPECT_EQ(target.count(2), 1);
+}
+
 // 查找
 
 TEST_F(WWSetTest, count)
@@ -128,6 +255,164 @@ TEST_F(WWSetTest, upper_bound)
     EXPECT_EQ(s.upper_bound(5), s.end());
 }
 
+TEST_F(WWSetTest, seek_forward)
+{
+    EXPECT_EQ(*s.seek_forward(s.begin(), 3), 3);
+    EXPECT_EQ(s.seek_forward(s.find(4), 5), s.end());
+
+    // 重复的键返回第一个
+    multiset<int> ms = {1, 2, 2, 2, 3, 5, 5, 8};
+    auto it = ms.seek_forward(ms.begin(), 2);
+    EXPECT_EQ(it, ms.lower_bound(2));
+    it = ms.seek_forward(it, 5);
+    EXPECT_EQ(it, ms.lower_bound(5));
+    EXPECT_EQ(*ms.seek_forward(it, 6), 8);
+    EXPECT_EQ(ms.seek_forward(it, 9), ms.end());
+}
+
+TEST_F(WWSetTest, order_statistic)
+{
+    ranked_set<int> rs;
+    std::set<int> ref;
+    unsigned int seed = 3;
+    for (int i = 0; i < 3000; ++i) {
+        seed = seed * 1103515245 + 12345;
+        int key = static_cast<int>((seed >> 16) % 500);
+        if ((seed >> 8) % 3 != 0) {
+            rs.insert(key);
+            ref.insert(key);
+        } else {
+            rs.erase(key);
+            ref.erase(key);
+        }
+    }
+    ASSERT_EQ(rs.size(), ref.size());
+
+    size_t index = 0;
+    for (auto it = ref.begin(); it != ref.end(); ++it, ++index) {
+        EXPECT_EQ(rs.rank(*it), index);
+        EXPECT_EQ(*rs.nth(index), *it);
+    }
+    EXPECT_EQ(rs.nth(ref.size()), rs.end());
+    EXPECT_EQ(rs.rank(-1), 0);
+    EXPECT_EQ(rs.rank(1000), ref.size());
+
+    EXPECT_EQ(rs.count_range(100, 200),
+              static_cast<size_t>(std::distance(ref.lower_bound(100), ref.lower_bound(200))));
+    EXPECT_EQ(rs.count_range(200, 100), 0);
+
+    // 拷贝、拆分和连接后子树大小仍然正确
+    ranked_set<int> copy = rs;
+    ranked_set<int> right = copy.split(250);
+    EXPECT_EQ(copy.size(), rs.rank(250));
+    EXPECT_EQ(*right.nth(0), *rs.lower_bound(250));
+    copy.join(right);
+    EXPECT_EQ(*copy.nth(copy.size() - 1), *ref.rbegin());
+    EXPECT_EQ(copy.rank(250), rs.rank(250));
+}
+
+// 平衡策略
+
+/**
+ * @brief 逐个插入、提示插入和批量构建后插入的树都能正确地双向遍历
+ */
+template <class Balance>
+void check_balance_iteration()
+{
+    using set_type = set<int, std::less<int>, allocator<int>, false, Balance>;
+    std::set<int> ref;
+    set_type bs;
+    unsigned int seed = 11;
+    for (int i = 0; i < 1000; ++i) {
+        seed = seed * 1103515245 + 12345;
+        int key = static_cast<int>((seed >> 16) % 600);
+        bs.insert(key);
+        ref.insert(key);
+        if (i % 4 == 0) {
+            bs.erase(key + 1);
+            ref.erase(key + 1);
+        }
+    }
+    ASSERT_EQ(bs.size(), ref.size());
+    EXPECT_TRUE(std::equal(bs.rbegin(), bs.rend(), ref.rbegin(), ref.rend()));
+    EXPECT_EQ(*--bs.end(), *ref.rbegin());
+    typename set_type::iterator root(bs._tree._root());
+    if (root != bs.begin()) {
+        auto before = root;
+        --before;
+        EXPECT_EQ(*before, *std::prev(ref.find(*root)));
+    }
+
+    // 提示分别位于开头、中间和末尾
+    set_type hs;
+    std::set<int> href;
+    for (int i = 0; i < 200; i += 2) {
+        hs.emplace_hint(hs.end(), i);
+        hs.insert(hs.begin(), -i - 1);
+        href.insert(i);
+        href.insert(-i - 1);
+    }
+    for (int i = 1; i < 200; i += 4) {
+        hs.insert(hs.find(i + 1), i);
+        hs.emplace_hint(hs.find(i - 1), i + 2);
+        href.insert(i);
+        href.insert(i + 2);
+    }
+    EXPECT_EQ(*hs.insert(hs.find(100), 100), 100);
+    ASSERT_EQ(hs.size(), href.size());
+    EXPECT_TRUE(std::equal(hs.begin(), hs.end(), href.begin(), href.end()));
+    EXPECT_TRUE(std::equal(hs.rbegin(), hs.rend(), href.rbegin(), href.rend()));
+
+    // 批量构建后继续插入，旋转可能把深层节点换到根
+    set_type as(ref.begin(), ref.end());
+    for (int i = 600; i < 700; ++i) {
+        as.insert(i);
+        ref.insert(i);
+    }
+    EXPECT_TRUE(std::equal(as.rbegin(), as.rend(), ref.rbegin(), ref.rend()));
+}
+
+TEST_F(WWSetTest, balance_iteration)
+{
+    check_balance_iteration<red_black_balance>();
+    check_balance_iteration<avl_balance>();
+    check_balance_iteration<treap_balance>();
+    check_balance_iteration<splay_balance>();
+}
+
+TEST_F(WWSetTest, balance_policy)
+{
+    // 其他平衡策略的旋转同样维护子树大小
+    set<int, std::less<int>, allocator<int>, true, treap_balance> ts;
+    set<int, std::less<int>, allocator<int>, true, splay_balance> ss;
+    std::set<int> ref;
+    unsigned int seed = 5;
+    for (int i = 0; i < 2000; ++i) {
+        seed = seed * 1103515245 + 12345;
+        int key = static_cast<int>((seed >> 16) % 400);
+        if ((seed >> 8) % 3 != 0) {
+            ts.insert(key);
+            ss.insert(key);
+            ref.insert(key);
+        } else {
+            ts.erase(key);
+            ss.erase(key);
+            ref.erase(key);
+        }
+    }
+    ASSERT_EQ(ts.size(), ref.size());
+    ASSERT_EQ(ss.size(), ref.size());
+    size_t index = 0;
+    for (auto it = ref.begin(); it != ref.end(); ++it, ++index) {
+        EXPECT_EQ(*ts.nth(index), *it);
+        EXPECT_EQ(ss.rank(*it), index);
+    }
+
+    // 有序范围批量构建
+    set<int, std::less<int>, allocator<int>, false, avl_balance> as(ref.begin(), ref.end());
+    EXPECT_TRUE(std::equal(as.begin(), as.end(), ref.begin(), ref.end()));
+}
+
 // 比较
 
 TEST_F(WWSetTest, compare)
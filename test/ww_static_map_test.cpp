@@ -0,0 +1,47 @@
+#include <gtest/gtest.h>
+#include <ww_static_map.h>
+#include <ww_map.h>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using namespace wwstl;
+
+class WWStaticMapTest : public testing::Test
+{
+public:
+    static_map<int, std::string> m = {{3, "3"}, {1, "1"}, {4, "4"}, {2, "2"}, {1, "x"}};
+};
+
+// 构造
+
+TEST_F(WWStaticMapTest, construct)
+{
+    // 重复的键保留第一个
+    EXPECT_EQ(m.size(), 4);
+    EXPECT_EQ(m.at(1), "1");
+    EXPECT_EQ(m.keys(), (vector<int>{1, 2, 3, 4}));
+
+    map<std::string, int> source = {{"b", 2}, {"a", 1}, {"c", 3}};
+    static_map<std::string, int, std::less<std::string>, btree_layout> from_map(source.begin(), source.end());
+    std::vector<std::string> keys;
+    for (const auto & kv : from_map) {
+        keys.push_back(kv.first);
+    }
+    EXPECT_EQ(keys, (std::vector<std::string>{"a", "b", "c"}));
+    EXPECT_EQ(from_map.find("b")->second, 2);
+    EXPECT_EQ(from_map.find("d"), from_map.end());
+}
+
+// 查找
+
+TEST_F(WWStaticMapTest, find)
+{
+    EXPECT_EQ(m.find(3)->second, "3");
+    EXPECT_EQ(m.find(5), m.end());
+    EXPECT_EQ(m.count(2), 1);
+    EXPECT_EQ(m.lower_bound(0)->first, 1);
+    EXPECT_EQ(m.upper_bound(2)->first, 3);
+    EXPECT_EQ(m.upper_bound(4), m.end());
+    EXPECT_THROW(m.at(5), std::out_of_range);
+}
@@ -0,0 +1,75 @@
+#include <gtest/gtest.h>
+#include <ww_static_set.h>
+#include <ww_set.h>
+#include <algorithm>
+#include <vector>
+
+using namespace wwstl;
+
+class WWStaticSetTest : public testing::Test
+{
+public:
+    static_set<int> s = {5, 1, 9, 3, 7, 3};
+};
+
+// 构造
+
+TEST_F(WWStaticSetTest, construct)
+{
+    // 无序输入先排序去重
+    EXPECT_EQ(s.size(), 5);
+    EXPECT_EQ(std::vector<int>(s.begin(), s.end()), (std::vector<int>{1, 3, 5, 7, 9}));
+    EXPECT_EQ(*s.rbegin(), 9);
+
+    // 从set构建
+    set<int> source = {4, 2, 8};
+    static_set<int> from_set(source.begin(), source.end());
+    EXPECT_EQ(std::vector<int>(from_set.begin(), from_set.end()), (std::vector<int>{2, 4, 8}));
+
+    static_set<int> empty;
+    EXPECT_TRUE(empty.empty());
+    EXPECT_EQ(empty.lower_bound(1), empty.end());
+    EXPECT_EQ(empty.find(1), empty.end());
+}
+
+// 查找
+
+TEST_F(WWStaticSetTest, find)
+{
+    EXPECT_EQ(*s.find(7), 7);
+    EXPECT_EQ(s.find(4), s.end());
+    EXPECT_EQ(s.count(1), 1);
+    EXPECT_EQ(s.count(2), 0);
+    EXPECT_EQ(*s.lower_bound(4), 5);
+    EXPECT_EQ(*s.upper_bound(5), 7);
+    EXPECT_EQ(s.lower_bound(10), s.end());
+    auto range = s.equal_range(3);
+    EXPECT_EQ(range.second - range.first, 1);
+}
+
+template <class Layout>
+static void check_layout()
+{
+    // 各种大小下lower_bound与有序数组上的std::lower_bound一致，覆盖不满的最后一层和最后一块
+    for (int n : {1, 2, 3, 7, 15, 16, 17, 100, 272, 289, 1000, 5000}) {
+        std::vector<int> keys;
+        for (int i = 0; i < n; ++i) {
+            keys.push_back(i * 3 + 1);
+        }
+        static_set<int, std::less<int>, Layout> table(keys.begin(), keys.end());
+        for (int key = -1; key <= n * 3 + 1; ++key) {
+            auto expected = std::lower_bound(keys.begin(), keys.end(), key) - keys.begin();
+            ASSERT_EQ(table.lower_bound(key) - table.begin(), expected) << "n = " << n << ", key = " << key;
+        }
+    }
+}
+
+TEST_F(WWStaticSetTest, layout)
+{
+    check_layout<eytzinger_layout>();
+    check_layout<btree_layout>();
+
+    static_set<int, std::greater<int>, btree_layout> desc = {1, 2, 3};
+    EXPECT_EQ(*desc.begin(), 3);
+    EXPECT_EQ(*desc.lower_bound(2), 2);
+}
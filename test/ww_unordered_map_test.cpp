@@ -1,5 +1,12 @@
 #include <gtest/gtest.h>
+#include <algorithm>
+#include <atomic>
 #include <ww_unordered_map.h>
+#include <iterator>
+#include <random>
+#include <stdexcept>
+#include <unordered_map>
+#include <vector>
 
 using namespace wwstl;
 
@@ -65,9 +72,130 @@ TEST_F(WWUnorderedMapTest, erase)
     auto it = umap.begin();
     std::advance(it, 3);
     umap.erase(umap.begin(), it);
+    EXPECT_EQ(umap.size(), 4);
+
+    // 遍历顺序由实现决定，擦除一个仍然存在的键
+    int key = umap.begin()->first;
+    EXPECT_EQ(umap.erase(key), 1);
+    EXPECT_EQ(umap.erase(key), 0);
+    EXPECT_EQ(umap.size(), 3);
+}
+
+TEST_F(WWUnorderedMapTest, erase_range)
+{
+    unordered_map<int, std::string> m;
+    for (int i = 0; i < 100; ++i) {
+        m.insert({i, std::to_string(i)});
+    }
+    std::vector<int> order;
+    for (auto it = m.begin(); it != m.end(); ++it) {
+        order.push_back(it->first);
+    }
+
+    // 跨越多个桶擦除中间一段
+    auto first = std::next(m.begin(), 10);
+    auto last = std::next(m.begin(), 60);
+    EXPECT_NE(m.bucket(first->first), m.bucket(last->first));
+    auto it = m.erase(first, last);
+    EXPECT_EQ(it->first, order[60]);
+    EXPECT_EQ(m.size(), 50);
+    std::vector<int> rest;
+    for (auto & kv : m) {
+        rest.push_back(kv.first);
+        EXPECT_EQ(kv.second, std::to_string(kv.first));
+    }
+    std::vector<int> expected(order.begin(), order.begin() + 10);
+    expected.insert(expected.end(), order.begin() + 60, order.end());
+    EXPECT_EQ(rest, expected);
+    for (int i = 10; i < 60; ++i) {
+        EXPECT_EQ(m.count(order[i]), 0);
+    }
+
+    // 擦除到end()
+    it = m.erase(std::next(m.begin(), 5), m.end());
+    EXPECT_TRUE(it == m.end());
+    EXPECT_EQ(m.size(), 5);
+    EXPECT_EQ(std::distance(m.begin(), m.end()), 5);
+    for (int i = 0; i < 5; ++i) {
+        EXPECT_EQ(m.at(order[i]), std::to_string(order[i]));
+    }
 
-    int count = umap.erase(7);
-    EXPECT_EQ(count, 1);
+    // 擦除全部后仍可插入
+    it = m.erase(m.begin(), m.end());
+    EXPECT_TRUE(it == m.end());
+    EXPECT_TRUE(m.empty());
+    m.insert({order[70], "x"});
+    EXPECT_EQ(m.size(), 1);
+    EXPECT_EQ(m.at(order[70]), "x");
+}
+
+TEST_F(WWUnorderedMapTest, try_emplace)
+{
+    // 键已存在时不移动参数
+    std::string value = "x";
+    auto res = umap.try_emplace(1, std::move(value));
+    EXPECT_FALSE(res.second);
+    EXPECT_EQ(res.first->second, "1");
+    EXPECT_EQ(value, "x");
+
+    res = umap.try_emplace(5, std::move(value));
+    EXPECT_TRUE(res.second);
+    EXPECT_EQ(umap.at(5), "x");
+
+    // 以多个参数构造值
+    auto it = umap.try_emplace(umap.end(), 6, 3, 'a');
+    EXPECT_EQ(it->second, "aaa");
+    EXPECT_EQ(umap.size(), 6);
+
+    // emplace可以取得键时同样先查找
+    std::string other = "y";
+    EXPECT_FALSE(umap.emplace(2, std::move(other)).second);
+    EXPECT_EQ(other, "y");
+}
+
+TEST_F(WWUnorderedMapTest, insert_or_assign)
+{
+    auto res = umap.insert_or_assign(1, "one");
+    EXPECT_FALSE(res.second);
+    EXPECT_EQ(umap.at(1), "one");
+
+    res = umap.insert_or_assign(5, "5");
+    EXPECT_TRUE(res.second);
+    EXPECT_EQ(res.first->second, "5");
+
+    auto it = umap.insert_or_assign(umap.begin(), 5, "five");
+    EXPECT_EQ(it->second, "five");
+    EXPECT_EQ(umap.size(), 5);
+}
+
+TEST_F(WWUnorderedMapTest, node_handle)
+{
+    auto nh = umap.extract(1);
+    ASSERT_FALSE(nh.empty());
+    EXPECT_EQ(umap.count(1), 0);
+    nh.key() = 10;
+    auto result = umap.insert(std::move(nh));
+    EXPECT_TRUE(result.inserted);
+    EXPECT_EQ(umap.at(10), result.position->second);
+
+    unordered_map<int, std::string> other;
+    for (int i = 0; i < 100; ++i) {
+        other.insert({i, std::to_string(i)});
+    }
+    size_t before = umap.size();
+    umap.merge(other);
+    EXPECT_EQ(umap.size() + other.size(), before + 100);
+    for (auto it = other.begin(); it != other.end(); ++it) {
+        EXPECT_EQ(umap.count(it->first), 1);
+    }
+
+    unordered_multimap<int, std::string> multi;
+    multi.merge(umap);
+    EXPECT_TRUE(umap.empty());
+    multi.merge(other);
+    EXPECT_TRUE(other.empty());
+    EXPECT_EQ(multi.size(), before + 100);
+    EXPECT_EQ(multi.extract(multi.begin()).empty(), false);
 }
 
 // 查找
@@ -129,11 +257,194 @@ TEST_F(WWUnorderedMapTest, equal_range)
     EXPECT_EQ(it.first, umap.end());
 }
 
+TEST_F(WWUnorderedMapTest, find_many)
+{
+    // 键数超过一批，命中与未命中交替
+    std::vector<int> keys;
+    for (int i = 0; i < 40; ++i) {
+        keys.push_back(i % 6);
+    }
+    std::vector<unordered_map<int, std::string>::iterator> found;
+    umap.find_many(keys.begin(), keys.end(), std::back_inserter(found));
+    ASSERT_EQ(found.size(), keys.size());
+    for (std::size_t i = 0; i < keys.size(); ++i) {
+        EXPECT_EQ(found[i], umap.find(keys[i]));
+    }
+
+    std::vector<std::size_t> counts(keys.size());
+    const unordered_map<int, std::string> & cm = umap;
+    cm.count_many(keys.begin(), keys.end(), counts.begin());
+    for (std::size_t i = 0; i < keys.size(); ++i) {
+        EXPECT_EQ(counts[i], umap.count(keys[i]));
+    }
+
+    unordered_map<int, std::string> empty;
+    EXPECT_EQ(empty.find_many(keys.begin(), keys.end(), found.begin()), found.end());
+    EXPECT_EQ(found[0], empty.end());
+}
+
+TEST_F(WWUnorderedMapTest, heterogeneous_lookup)
+{
+    unordered_map<std::string, int, hash<std::string>, std::equal_to<>> smap;
+    smap.insert({"apple", 1});
+    smap.insert({"banana", 2});
+    smap.insert({"a long key that does not fit in the small string buffer", 3});
+
+    const char * key = "banana";
+    EXPECT_EQ(smap.find(key)->second, 2);
+    EXPECT_EQ(smap.count("apple"), 1);
+    EXPECT_EQ(smap.count("cherry"), 0);
+    EXPECT_EQ(smap.find("cherry"), smap.end());
+    EXPECT_EQ(smap.find("a long key that does not fit in the small string buffer")->second, 3);
+
+    auto range = smap.equal_range("apple");
+    EXPECT_EQ(range.first->second, 1);
+    EXPECT_EQ(std::next(range.first), range.second);
+
+    // 同一内容的std::string和const char*的hash值相同
+    EXPECT_EQ(hash<std::string>()(std::string("banana")), hash<std::string>()("banana"));
+    EXPECT_EQ(hash<const char *>()("banana"), hash<std::string>()("banana"));
+}
+
+// 记录调用次数的哈希函数
+struct counting_string_hash
+{
+    static int calls;
+
+    std::size_t operator()(const std::string & key) const
+    {
+        ++calls;
+        return hash<std::string>()(key);
+    }
+};
+
+int counting_string_hash::calls = 0;
+
+TEST_F(WWUnorderedMapTest, cache_hash)
+{
+    // 非平凡的键默认缓存哈希值，遍历、重建和按位置擦除不再调用哈希函数
+    static_assert(sizeof(unordered_map<std::string, int>::hashtable_type::node)
+                  > sizeof(unordered_map<std::string, int, hash<std::string>, std::equal_to<std::string>, allocator<std::pair<const std::string, int>>, false>::hashtable_type::node),
+                  "string keys cache the hash code");
+    static_assert(sizeof(unordered_map<int, int>::hashtable_type::node)
+                  == sizeof(unordered_map<int, int, hash<int>, std::equal_to<int>, allocator<std::pair<const int, int>>, false>::hashtable_type::node),
+                  "trivial keys do not cache the hash code");
+
+    unordered_map<std::string, int, counting_string_hash> cached;
+    for (int i = 0; i < 100; ++i) {
+        cached.insert({std::to_string(i), i});
+    }
+    counting_string_hash::calls = 0;
+    int sum = 0;
+    for (auto it = cached.begin(); it != cached.end(); ++it) {
+        sum += it->second;
+    }
+    cached.rehash(1024);
+    for (auto it = cached.begin(); it != cached.end(); ) {
+        it = it->second % 2 == 0 ? cached.erase(it) : std::next(it);
+    }
+    EXPECT_EQ(counting_string_hash::calls, 0);
+    EXPECT_EQ(sum, 4950);
+    EXPECT_EQ(cached.size(), 50);
+    EXPECT_EQ(cached.at("99"), 99);
+    EXPECT_EQ(cached.count("98"), 0);
+
+    // 关闭缓存时行为不变
+    unordered_map<std::string, int, counting_string_hash, std::equal_to<std::string>, allocator<std::pair<const std::string, int>>, false> uncached;
+    for (int i = 0; i < 100; ++i) {
+        uncached.insert({std::to_string(i), i});
+    }
+    uncached.rehash(1024);
+    EXPECT_EQ(uncached.erase("7"), 1);
+    EXPECT_EQ(uncached.size(), 99);
+    EXPECT_EQ(uncached.at("99"), 99);
+}
+
+TEST_F(WWUnorderedMapTest, insert_or_assign_hash_once)
+{
+    // 插入和赋值都只计算一次哈希值，包括插入时触发扩容的情况
+    unordered_map<std::string, int, counting_string_hash> m;
+    for (int i = 0; i < 100; ++i) {
+        counting_string_hash::calls = 0;
+        EXPECT_TRUE(m.insert_or_assign(std::to_string(i), i).second);
+        EXPECT_EQ(counting_string_hash::calls, 1);
+    }
+    counting_string_hash::calls = 0;
+    EXPECT_FALSE(m.insert_or_assign("42", -42).second);
+    EXPECT_EQ(counting_string_hash::calls, 1);
+    EXPECT_EQ(m.at("42"), -42);
+    EXPECT_EQ(m.size(), 100);
+}
+
+TEST_F(WWUnorderedMapTest, rehash_policy)
+{
+    // 两种策略下等步长的整数键都均匀分布，不会集中在少数桶中
+    using pow2_map = unordered_map<int, int>;
+    using prime_map = unordered_map<int, int, hash<int>, std::equal_to<int>, allocator<std::pair<const int, int>>, false, prime_rehash_policy>;
+    pow2_map pmap;
+    prime_map qmap;
+    for (int i = 0; i < 10000; ++i) {
+        pmap.insert({i * 1024, i});
+        qmap.insert({i * 1024, i});
+    }
+    std::size_t pmax = 0;
+    for (std::size_t n = 0; n < pmap.bucket_count(); ++n) {
+        pmax = std::max(pmax, pmap.bucket_size(n));
+    }
+    std::size_t qmax = 0;
+    for (std::size_t n = 0; n < qmap.bucket_count(); ++n) {
+        qmax = std::max(qmax, qmap.bucket_size(n));
+    }
+    EXPECT_LE(pmax, 10);
+    EXPECT_LE(qmax, 10);
+    EXPECT_EQ(pmap.bucket_count() & (pmap.bucket_count() - 1), 0);
+    for (int i = 0; i < 10000; ++i) {
+        EXPECT_EQ(pmap.at(i * 1024), i);
+        EXPECT_EQ(qmap.at(i * 1024), i);
+    }
+
+    // 没有声明is_mixed的哈希函数由hashtable先打散，恒等映射下等步长的键同样均匀分布
+    struct identity_hash
+    {
+        std::size_t operator()(int key) const
+        {
+            return static_cast<std::size_t>(key);
+        }
+    };
+    unordered_map<int, int, identity_hash> imap;
+    for (int i = 0; i < 10000; ++i) {
+        imap.insert({i * 1024, i});
+    }
+    std::size_t imax = 0;
+    for (std::size_t n = 0; n < imap.bucket_count(); ++n) {
+        imax = std::max(imax, imap.bucket_size(n));
+    }
+    EXPECT_LE(imax, 10);
+    EXPECT_EQ(imap.at(1024 * 77), 77);
+
+    // 桶数向上取整到策略的合法值，且不少于size() / max_load_factor()
+    pmap.rehash(3000);
+    EXPECT_EQ(pmap.bucket_count(), 16384);
+    qmap.rehash(100000);
+    EXPECT_EQ(qmap.bucket_count(), 196613);
+    prime_map small;
+    EXPECT_EQ(small.bucket_count(), 13);
+    small.rehash(0);
+    EXPECT_EQ(small.bucket_count(), 2);
+}
+
 // 桶接口
 
 TEST_F(WWUnorderedMapTest, bucket_begin)
 {
-    EXPECT_EQ(umap.begin(1)->second, "1");
+    // 桶由桶数策略决定，键1的元素在bucket(1)中
+    const std::size_t n = umap.bucket(1);
+    auto it = umap.begin(n);
+    while (it != umap.end(n) && it->first != 1) {
+        ++it;
+    }
+    ASSERT_NE(it, umap.end(n));
+    EXPECT_EQ(it->second, "1");
 }
 
 TEST_F(WWUnorderedMapTest, bucket_count)
@@ -143,14 +454,21 @@ TEST_F(WWUnorderedMapTest, bucket_count)
 
 TEST_F(WWUnorderedMapTest, bucket_size)
 {
-    EXPECT_EQ(umap.bucket_size(1), 1);
+    EXPECT_GE(umap.bucket_size(umap.bucket(1)), 1);
+    std::size_t total = 0;
+    for (std::size_t n = 0; n < umap.bucket_count(); ++n) {
+        total += umap.bucket_size(n);
+    }
+    EXPECT_EQ(total, umap.size());
 }
 
 TEST_F(WWUnorderedMapTest, bucket)
 {
-    EXPECT_EQ(umap.bucket(1), 1);
-    EXPECT_EQ(umap.bucket(2), 2);
-    EXPECT_EQ(umap.bucket(3), 3);
+    for (const auto & value : umap) {
+        const std::size_t n = umap.bucket(value.first);
+        EXPECT_LT(n, umap.bucket_count());
+        EXPECT_NE(std::find(umap.begin(n), umap.end(n), value), umap.end(n));
+    }
 }
 
 // 散列策略
@@ -183,8 +501,221 @@ TEST_F(WWUnorderedMapTest, reserve)
     EXPECT_EQ(umap.load_factor(), 0.25);
 }
 
+TEST_F(WWUnorderedMapTest, incremental_rehash)
+{
+    unordered_map<int, int> map;
+    map.incremental_rehash(true);
+    EXPECT_TRUE(map.incremental_rehash());
+    std::size_t checked = 0;
+    for (int i = 0; i < 5000; ++i) {
+        map[i] = i;
+        if (!map._ht._old_buckets.empty() && i % 7 == 0) {
+            // 迁移中途：查找、遍历都覆盖新旧两个桶数组
+            ++checked;
+            EXPECT_EQ(map.size(), static_cast<std::size_t>(i + 1));
+            EXPECT_EQ(static_cast<std::size_t>(std::distance(map.begin(), map.end())), map.size());
+            EXPECT_EQ(map.at(i / 2), i / 2);
+            EXPECT_EQ(map.find(i + 1), map.end());
+        }
+    }
+    EXPECT_GT(checked, 0);
+
+    // 迁移中途边遍历边擦除
+    while (map._ht._old_buckets.empty()) {
+        map[static_cast<int>(map.size())] = 0;
+    }
+    const std::size_t total = map.size();
+    std::size_t erased = 0;
+    for (auto it = map.begin(); it != map.end(); ) {
+        if (it->first % 2 == 0) {
+            it = map.erase(it);
+            ++erased;
+        } else {
+            ++it;
+        }
+    }
+    EXPECT_EQ(map.size(), total - erased);
+    for (int i = 0; i < static_cast<int>(total); ++i) {
+        EXPECT_EQ(map.count(i), static_cast<std::size_t>(i % 2));
+    }
+
+    // 桶接口先完成迁移
+    std::size_t in_buckets = 0;
+    for (std::size_t n = 0; n < map.bucket_count(); ++n) {
+        in_buckets += map.bucket_size(n);
+    }
+    EXPECT_TRUE(map._ht._old_buckets.empty());
+    EXPECT_EQ(in_buckets, map.size());
+    EXPECT_EQ(map.bucket(1), map.bucket(1));
+}
+
+TEST_F(WWUnorderedMapTest, parallel_build)
+{
+    // 已有的元素优先，重复的新元素中先出现的被保留，与逐个插入的结果相同
+    std::vector<std::pair<int, int>> values;
+    std::mt19937 gen(11);
+    for (int i = 0; i < 30000; ++i) {
+        values.emplace_back(static_cast<int>(gen() % 20000), i);
+    }
+    for (std::size_t threads : {1, 2, 3, 8}) {
+        unordered_map<int, int> map = {{5, -1}};
+        std::unordered_map<int, int> expected = {{5, -1}};
+        map.insert(values.begin(), values.end(), threads);
+        expected.insert(values.begin(), values.end());
+        EXPECT_EQ(map.size(), expected.size());
+        EXPECT_EQ(static_cast<std::size_t>(std::distance(map.begin(), map.end())), expected.size());
+        EXPECT_LE(map.load_factor(), map.max_load_factor());
+        for (const auto & value : expected) {
+            EXPECT_EQ(map.at(value.first), value.second);
+        }
+
+        map.rehash(map.bucket_count() * 4, threads);
+        std::size_t in_buckets = 0;
+        for (std::size_t n = 0; n < map.bucket_count(); ++n) {
+            for (auto it = map.begin(n); it != map.end(n); ++it) {
+                EXPECT_EQ(map.bucket(it->first), n);
+                ++in_buckets;
+            }
+        }
+        EXPECT_EQ(in_buckets, expected.size());
+        map.insert({-1, 0});
+        EXPECT_EQ(map.erase(5), 1);
+        EXPECT_EQ(map.size(), expected.size());
+    }
+}
+
 // 比较
 
+// 第budget + 1次拷贝时抛出异常，budget小于0时不抛出，live记录存活的对象数
+struct throwing_copy
+{
+    static std::atomic<int> budget;
+    static std::atomic<int> live;
+
+    int value;
+
+    explicit throwing_copy(int v)
+        : value(v)
+    {
+        ++live;
+    }
+
+    throwing_copy(const throwing_copy & other)
+        : value(other.value)
+    {
+        if (budget.load() >= 0 && budget.fetch_sub(1) == 0) {
+            throw std::runtime_error("copy");
+        }
+        ++live;
+    }
+
+    ~throwing_copy()
+    {
+        --live;
+    }
+};
+
+std::atomic<int> throwing_copy::budget(-1);
+std::atomic<int> throwing_copy::live(0);
+
+// 第budget + 1次调用时抛出异常，budget小于0时不抛出
+struct throwing_hash
+{
+    static std::atomic<int> budget;
+
+    std::size_t operator()(int key) const
+    {
+        if (budget.load() >= 0 && budget.fetch_sub(1) == 0) {
+            throw std::runtime_error("hash");
+        }
+        return hash<int>()(key);
+    }
+};
+
+std::atomic<int> throwing_hash::budget(-1);
+
+// 检查表中恰好是[0, n)的键，且每个节点都在自己的桶中
+template <class Map>
+static void expect_keys_below(const Map & map, int n)
+{
+    EXPECT_EQ(map.size(), static_cast<std::size_t>(n));
+    EXPECT_EQ(std::distance(map.begin(), map.end()), n);
+    std::size_t in_buckets = 0;
+    for (std::size_t b = 0; b < map.bucket_count(); ++b) {
+        for (auto it = map.begin(b); it != map.end(b); ++it) {
+            EXPECT_EQ(map.bucket(it->first), b);
+            ++in_buckets;
+        }
+    }
+    EXPECT_EQ(in_buckets, static_cast<std::size_t>(n));
+    for (int i = 0; i < n; ++i) {
+        EXPECT_EQ(map.count(i), 1);
+    }
+}
+
+TEST_F(WWUnorderedMapTest, parallel_build_exception)
+{
+    // 拷贝构造抛出异常时，异常传给调用者，表不变，已构造的新节点被销毁
+    {
+        unordered_map<int, throwing_copy> map;
+        for (int i = 0; i < 100; ++i) {
+            map.emplace(i, throwing_copy(i));
+        }
+        std::vector<std::pair<const int, throwing_copy>> values;
+        for (int i = 0; i < 5000; ++i) {
+            values.emplace_back(1000 + i, throwing_copy(i));
+        }
+        const int live = throwing_copy::live.load();
+        const std::size_t buckets = map.bucket_count();
+        for (int budget : {0, 2000, 4999}) {
+            throwing_copy::budget = budget;
+            EXPECT_THROW(map.insert(values.begin(), values.end(), 4), std::runtime_error);
+            throwing_copy::budget = -1;
+            EXPECT_EQ(throwing_copy::live.load(), live);
+            EXPECT_EQ(map.bucket_count(), buckets);
+            expect_keys_below(map, 100);
+            for (int i = 0; i < 100; ++i) {
+                EXPECT_EQ(map.at(i).value, i);
+            }
+        }
+
+        // 重建不拷贝元素
+        throwing_copy::budget = 0;
+        map.rehash(buckets * 4, 4);
+        throwing_copy::budget = -1;
+        EXPECT_EQ(map.bucket_count(), buckets * 4);
+        expect_keys_below(map, 100);
+
+        map.insert(values.begin(), values.end(), 4);
+        EXPECT_EQ(map.size(), 5100);
+        EXPECT_EQ(map.at(5999).value, 4999);
+    }
+    EXPECT_EQ(throwing_copy::live.load(), 0);
+
+    // 不缓存哈希值时哈希函数抛出异常，插入和重建都不改变表
+    unordered_map<int, int, throwing_hash, std::equal_to<int>, allocator<std::pair<const int, int>>, false> map;
+    for (int i = 0; i < 1000; ++i) {
+        map.insert({i, i});
+    }
+    std::vector<std::pair<int, int>> values;
+    for (int i = 0; i < 5000; ++i) {
+        values.emplace_back(1000 + i, i);
+    }
+    const std::size_t buckets = map.bucket_count();
+    for (int budget : {0, 500, 999}) {
+        throwing_hash::budget = budget;
+        EXPECT_THROW(map.insert(values.begin(), values.end(), 4), std::runtime_error);
+        throwing_hash::budget = budget;
+        EXPECT_THROW(map.rehash(buckets * 4, 4), std::runtime_error);
+        throwing_hash::budget = -1;
+        EXPECT_EQ(map.bucket_count(), buckets);
+        expect_keys_below(map, 1000);
+    }
+    map.rehash(buckets * 4, 4);
+    EXPECT_EQ(map.bucket_count(), buckets * 4);
+    expect_keys_below(map, 1000);
+}
+
 TEST_F(WWUnorderedMapTest, compare)
 {
     unordered_map<int, std::string> umap2 = {{1, "1"}, {2, "2"}, {3, "3"}, {4, "4"}};
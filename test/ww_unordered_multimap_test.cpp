@@ -1,5 +1,9 @@
 #include <gtest/gtest.h>
+#include <algorithm>
 #include <ww_unordered_map.h>
+#include <iterator>
+#include <map>
+#include <random>
 
 using namespace wwstl;
 
@@ -50,14 +54,124 @@ TEST_F(WWUnorderedMultiMapTest, erase)
     ummap.erase(2);
     EXPECT_EQ(ummap.count(2), 0);
 
-    ummap.erase(ummap.begin());
+    // find返回第一个相等的元素，擦除后下一个相等的元素仍然相邻
+    auto it = ummap.erase(ummap.find(1));
     EXPECT_EQ(ummap.count(1), 1);
-    EXPECT_EQ(ummap.begin()->second, "11");
+    EXPECT_EQ(it->second, "11");
+    EXPECT_EQ(ummap.find(1), it);
 
     ummap.erase(ummap.begin(), ummap.end());
     EXPECT_TRUE(ummap.empty());
 }
 
+TEST_F(WWUnorderedMultiMapTest, random_operations)
+{
+    // 所有节点在一条链表上，桶指向前驱；随机插入、擦除和重建后与std::multimap的计数对照
+    unordered_multimap<int, int> map;
+    std::multimap<int, int> expected;
+    std::mt19937 gen(3);
+    for (int i = 0; i < 20000; ++i) {
+        const int key = static_cast<int>(gen() % 500);
+        switch (gen() % 8) {
+        case 0:
+            EXPECT_EQ(map.erase(key), expected.erase(key));
+            break;
+        case 1: {
+            auto it = map.find(key);
+            if (it != map.end()) {
+                auto next = std::next(it);
+                EXPECT_EQ(map.erase(it), next);
+                expected.erase(expected.find(key));
+            }
+            break;
+        }
+        case 2:
+            if (i % 50 == 0) {
+                map.rehash(gen() % 4096 + 1);
+            }
+            break;
+        default:
+            map.insert({key, i});
+            expected.insert({key, i});
+            break;
+        }
+    }
+    EXPECT_EQ(map.size(), expected.size());
+    EXPECT_EQ(static_cast<std::size_t>(std::distance(map.begin(), map.end())), expected.size());
+    std::size_t in_buckets = 0;
+    for (std::size_t n = 0; n < map.bucket_count(); ++n) {
+        EXPECT_EQ(static_cast<std::size_t>(std::distance(map.begin(n), map.end(n))), map.bucket_size(n));
+        for (auto it = map.begin(n); it != map.end(n); ++it) {
+            EXPECT_EQ(map.bucket(it->first), n);
+        }
+        in_buckets += map.bucket_size(n);
+    }
+    EXPECT_EQ(in_buckets, map.size());
+    for (int key = 0; key < 500; ++key) {
+        auto range = map.equal_range(key);
+        EXPECT_EQ(static_cast<std::size_t>(std::distance(range.first, range.second)), expected.count(key));
+    }
+
+    // 擦除除第一个元素外的所有元素，之后在大量空桶中begin()和遍历仍然正确
+    map.reserve(100000);
+    map.erase(std::next(map.begin()), map.end());
+    EXPECT_EQ(map.size(), 1);
+    EXPECT_EQ(std::next(map.begin()), map.end());
+}
+
+TEST_F(WWUnorderedMultiMapTest, incremental_rehash)
+{
+    // 增量重建中途相等的元素仍然相邻，擦除和计数覆盖新旧两个桶数组
+    unordered_multimap<int, int> map;
+    std::multimap<int, int> expected;
+    map.incremental_rehash(true);
+    std::mt19937 gen(5);
+    std::size_t checked = 0;
+    for (int i = 0; i < 20000; ++i) {
+        const int key = static_cast<int>(gen() % 3000);
+        if (gen() % 5 == 0) {
+            EXPECT_EQ(map.erase(key), expected.erase(key));
+        } else {
+            map.insert({key, i});
+            expected.insert({key, i});
+        }
+        if (!map._ht._old_buckets.empty() && i % 13 == 0) {
+            ++checked;
+            auto range = map.equal_range(key);
+            EXPECT_EQ(static_cast<std::size_t>(std::distance(range.first, range.second)), expected.count(key));
+            for (auto it = range.first; it != range.second; ++it) {
+                EXPECT_EQ(it->first, key);
+            }
+            EXPECT_EQ(static_cast<std::size_t>(std::distance(map.begin(), map.end())), expected.size());
+        }
+    }
+    EXPECT_GT(checked, 0);
+    EXPECT_EQ(map.size(), expected.size());
+    for (int key = 0; key < 3000; ++key) {
+        EXPECT_EQ(map.count(key), expected.count(key));
+    }
+}
+
+TEST_F(WWUnorderedMultiMapTest, parallel_build)
+{
+    std::vector<std::pair<int, int>> values;
+    for (int i = 0; i < 20000; ++i) {
+        values.emplace_back(i % 1500, i);
+    }
+    unordered_multimap<int, int> map = {{7, 0}};
+    map.insert(values.begin(), values.end(), 4);
+    EXPECT_EQ(map.size(), values.size() + 1);
+    map.rehash(map.bucket_count() * 2, 3);
+    for (int key = 0; key < 1500; ++key) {
+        // 相等的元素在链表中相邻
+        auto range = map.equal_range(key);
+        const std::size_t expected = key == 7 ? 15 : 14 - (key >= 20000 % 1500 ? 1 : 0);
+        EXPECT_EQ(static_cast<std::size_t>(std::distance(range.first, range.second)), expected);
+        EXPECT_EQ(map.count(key), expected);
+    }
+    EXPECT_EQ(static_cast<std::size_t>(std::distance(map.begin(), map.end())), map.size());
+}
+
 // 查找
 
 TEST_F(WWUnorderedMultiMapTest, count)
@@ -65,6 +179,14 @@ TEST_F(WWUnorderedMultiMapTest, count)
     EXPECT_EQ(ummap.count(1), 2);
     EXPECT_EQ(ummap.count(2), 3);
     EXPECT_EQ(ummap.count(3), 1);
+
+    int keys[] = {2, 5, 1, 3};
+    std::size_t counts[4] = {};
+    ummap.count_many(keys, keys + 4, counts);
+    EXPECT_EQ(counts[0], 3);
+    EXPECT_EQ(counts[1], 0);
+    EXPECT_EQ(counts[2], 2);
+    EXPECT_EQ(counts[3], 1);
 }
 
 TEST_F(WWUnorderedMultiMapTest, find)
@@ -90,7 +212,14 @@ TEST_F(WWUnorderedMultiMapTest, equal_range)
 
 TEST_F(WWUnorderedMultiMapTest, bucket_begin)
 {
-    EXPECT_EQ(ummap.begin(1)->second, "1");
+    // 桶由桶数策略决定，键1的元素在bucket(1)中
+    const std::size_t n = ummap.bucket(1);
+    auto it = ummap.begin(n);
+    while (it != ummap.end(n) && it->first != 1) {
+        ++it;
+    }
+    ASSERT_NE(it, ummap.end(n));
+    EXPECT_EQ(it->second, "1");
 }
 
 TEST_F(WWUnorderedMultiMapTest, bucket_count)
@@ -100,14 +229,21 @@ TEST_F(WWUnorderedMultiMapTest, bucket_count)
 
 TEST_F(WWUnorderedMultiMapTest, bucket_size)
 {
-    EXPECT_EQ(ummap.bucket_size(1), 2);
+    EXPECT_GE(ummap.bucket_size(ummap.bucket(1)), 2);
+    std::size_t total = 0;
+    for (std::size_t n = 0; n < ummap.bucket_count(); ++n) {
+        total += ummap.bucket_size(n);
+    }
+    EXPECT_EQ(total, ummap.size());
 }
 
 TEST_F(WWUnorderedMultiMapTest, bucket)
 {
-    EXPECT_EQ(ummap.bucket(1), 1);
-    EXPECT_EQ(ummap.bucket(2), 2);
-    EXPECT_EQ(ummap.bucket(3), 3);
+    for (const auto & value : ummap) {
+        const std::size_t n = ummap.bucket(value.first);
+        EXPECT_LT(n, ummap.bucket_count());
+        EXPECT_NE(std::find(ummap.begin(n), ummap.end(n), value), ummap.end(n));
+    }
 }
 
 // 散列策略
@@ -1,4 +1,5 @@
 #include <gtest/gtest.h>
+#include <algorithm>
 #include <ww_unordered_set.h>
 
 using namespace wwstl;
@@ -92,7 +93,13 @@ TEST_F(WWUnorderedMultiSetTest, equal_range)
 
 TEST_F(WWUnorderedMultiSetTest, bucket_begin)
 {
-    EXPECT_EQ(*umset.begin(1), "1");
+    // 桶由桶数策略决定，"1"在bucket("1")中
+    const std::size_t n = umset.bucket("1");
+    auto it = umset.begin(n);
+    while (it != umset.end(n) && *it != "1") {
+        ++it;
+    }
+    EXPECT_NE(it, umset.end(n));
 }
 
 TEST_F(WWUnorderedMultiSetTest, bucket_count)
@@ -102,14 +109,21 @@ TEST_F(WWUnorderedMultiSetTest, bucket_count)
 
 TEST_F(WWUnorderedMultiSetTest, bucket_size)
 {
-    EXPECT_EQ(umset.bucket_size(1), 2);
+    EXPECT_GE(umset.bucket_size(umset.bucket("1")), 2);
+    std::size_t total = 0;
+    for (std::size_t n = 0; n < umset.bucket_count(); ++n) {
+        total += umset.bucket_size(n);
+    }
+    EXPECT_EQ(total, umset.size());
 }
 
 TEST_F(WWUnorderedMultiSetTest, bucket)
 {
-    EXPECT_EQ(umset.bucket("1"), 1);
-    EXPECT_EQ(umset.bucket("2"), 2);
-    EXPECT_EQ(umset.bucket("3"), 3);
+    for (const auto & value : umset) {
+        const std::size_t n = umset.bucket(value);
+        EXPECT_LT(n, umset.bucket_count());
+        EXPECT_NE(std::find(umset.begin(n), umset.end(n), value), umset.end(n));
+    }
 }
 
 // 散列策略
@@ -1,5 +1,9 @@
 #include <gtest/gtest.h>
+#include <algorithm>
 #include <ww_unordered_set.h>
+#include <iterator>
+#include <string>
+#include <vector>
 
 using namespace wwstl;
 
@@ -42,15 +46,66 @@ TEST_F(WWUnorderedSetTest, insert)
 
 TEST_F(WWUnorderedSetTest, erase)
 {
+    // 遍历顺序由实现决定，erase返回被擦除元素在遍历中的下一个元素
+    std::string next = *std::next(uset.begin());
     auto it = uset.erase(uset.begin());
-    EXPECT_EQ(*it, "2");
+    EXPECT_EQ(*it, next);
+    EXPECT_EQ(uset.size(), 3);
     uset.insert({"6", "7", "8"});
     auto it1 = uset.begin();
     std::advance(it1, 2);
+    next = *it1;
     it = uset.erase(uset.begin(), it1);
-    EXPECT_EQ(*it, "3");
-    int count = uset.erase("6");
-    EXPECT_EQ(count, 1);
+    EXPECT_EQ(*it, next);
+    EXPECT_EQ(uset.size(), 4);
+    // 前面擦除的元素由遍历顺序决定，按擦除前的count检查返回值
+    std::size_t size = uset.size();
+    for (const char * key : {"6", "7", "8"}) {
+        std::size_t count = uset.count(key);
+        EXPECT_EQ(uset.erase(key), count);
+        EXPECT_EQ(uset.count(key), 0);
+        size -= count;
+        EXPECT_EQ(uset.size(), size);
+    }
+    EXPECT_EQ(std::distance(uset.begin(), uset.end()), static_cast<std::ptrdiff_t>(size));
+    EXPECT_EQ(uset.erase("6"), 0);
+    uset.insert("6");
+    EXPECT_EQ(uset.erase("6"), 1);
+    EXPECT_EQ(uset.count("6"), 0);
+    EXPECT_EQ(uset.size(), size);
+}
+
+TEST_F(WWUnorderedSetTest, erase_range)
+{
+    unordered_set<std::string> s;
+    for (int i = 0; i < 100; ++i) {
+        s.insert(std::to_string(i));
+    }
+    std::vector<std::string> order(s.begin(), s.end());
+
+    // 跨越多个桶擦除中间一段
+    auto first = std::next(s.begin(), 20);
+    auto last = std::next(s.begin(), 75);
+    EXPECT_NE(s.bucket(*first), s.bucket(*last));
+    auto it = s.erase(first, last);
+    EXPECT_EQ(*it, order[75]);
+    EXPECT_EQ(s.size(), 45);
+    std::vector<std::string> expected(order.begin(), order.begin() + 20);
+    expected.insert(expected.end(), order.begin() + 75, order.end());
+    EXPECT_EQ(std::vector<std::string>(s.begin(), s.end()), expected);
+    for (int i = 20; i < 75; ++i) {
+        EXPECT_EQ(s.count(order[i]), 0);
+    }
+
+    // 擦除到end()
+    it = s.erase(std::next(s.begin(), 3), s.end());
+    EXPECT_TRUE(it == s.end());
+    EXPECT_EQ(s.size(), 3);
+    EXPECT_EQ(std::distance(s.begin(), s.end()), 3);
+    for (int i = 0; i < 3; ++i) {
+        EXPECT_EQ(s.count(order[i]), 1);
+    }
+    EXPECT_EQ(s.count(order[3]), 0);
 }
 
 // 容量
@@ -89,14 +144,20 @@ TEST_F(WWUnorderedSetTest, equal_range)
 {
     auto range = uset.equal_range("1");
     EXPECT_EQ(*range.first, "1");
-    EXPECT_EQ(*range.second, "2");
+    EXPECT_EQ(range.second, std::next(range.first));
 }
 
 // 桶接口
 
 TEST_F(WWUnorderedSetTest, bucket_begin)
 {
-    EXPECT_EQ(*uset.begin(1), "1");
+    // 桶由桶数策略决定，"1"在bucket("1")中
+    const std::size_t n = uset.bucket("1");
+    auto it = uset.begin(n);
+    while (it != uset.end(n) && *it != "1") {
+        ++it;
+    }
+    EXPECT_NE(it, uset.end(n));
 }
 
 TEST_F(WWUnorderedSetTest, bucket_count)
@@ -106,14 +167,21 @@ TEST_F(WWUnorderedSetTest, bucket_count)
 
 TEST_F(WWUnorderedSetTest, bucket_size)
 {
-    EXPECT_EQ(uset.bucket_size(1), 1);
+    EXPECT_GE(uset.bucket_size(uset.bucket("1")), 1);
+    std::size_t total = 0;
+    for (std::size_t n = 0; n < uset.bucket_count(); ++n) {
+        total += uset.bucket_size(n);
+    }
+    EXPECT_EQ(total, uset.size());
 }
 
 TEST_F(WWUnorderedSetTest, bucket)
 {
-    EXPECT_EQ(uset.bucket("1"), 1);
-    EXPECT_EQ(uset.bucket("2"), 2);
-    EXPECT_EQ(uset.bucket("3"), 3);
+    for (const auto & value : uset) {
+        const std::size_t n = uset.bucket(value);
+        EXPECT_LT(n, uset.bucket_count());
+        EXPECT_NE(std::find(uset.begin(n), uset.end(n), value), uset.end(n));
+    }
 }
 
 // 散列策略
@@ -1,5 +1,7 @@
 #include <gtest/gtest.h>
 #include <ww_vector.h>
+#include <string>
+#include <vector>
 
 using namespace wwstl;
 
@@ -107,6 +109,46 @@ TEST_F(WWVectorTest, Insert)
     EXPECT_EQ(vec, vector<int>({9, 8, 7, 1, 7, 8, 2, 3, 666, 666, 666}));
 }
 
+TEST_F(WWVectorTest, InsertString)
+{
+    // 非平凡类型在中间插入，覆盖插入个数大于和不大于后续元素个数的情况
+    vector<std::string> v;
+    std::vector<std::string> ref;
+    for (int i = 0; i < 6; ++i) {
+        v.push_back(std::to_string(i));
+        ref.push_back(std::to_string(i));
+    }
+    v.insert(v.begin() + 2, std::string("a"));
+    ref.insert(ref.begin() + 2, std::string("a"));
+    v.insert(v.begin() + 1, 2, std::string("b"));
+    ref.insert(ref.begin() + 1, 2, std::string("b"));
+    v.insert(v.end() - 1, 4, std::string("c"));
+    ref.insert(ref.end() - 1, 4, std::string("c"));
+    v.emplace(v.begin(), 3, 'd');
+    ref.emplace(ref.begin(), 3, 'd');
+    v.insert(v.begin() + 3, v[0]);
+    ref.insert(ref.begin() + 3, ref[0]);
+    std::vector<std::string> more = {"x", "y", "z"};
+    v.insert(v.begin() + 4, more.begin(), more.end());
+    ref.insert(ref.begin() + 4, more.begin(), more.end());
+    v.insert(v.end() - 2, more.begin(), more.end());
+    ref.insert(ref.end() - 2, more.begin(), more.end());
+    ASSERT_EQ(v.size(), ref.size());
+    for (std::size_t i = 0; i < ref.size(); ++i) {
+        EXPECT_EQ(v[i], ref[i]);
+    }
+
+    // 擦除后末尾被移走的元素需要正确销毁
+    v.erase(v.begin() + 1);
+    ref.erase(ref.begin() + 1);
+    v.erase(v.begin() + 2, v.begin() + 7);
+    ref.erase(ref.begin() + 2, ref.begin() + 7);
+    ASSERT_EQ(v.size(), ref.size());
+    for (std::size_t i = 0; i < ref.size(); ++i) {
+        EXPECT_EQ(v[i], ref[i]);
+    }
+}
+
 TEST_F(WWVectorTest, Erase)
 {
     vec.erase(vec.begin() + 1);